@@ -84,6 +84,27 @@ enum OptimizationLevel {
 	OPTIMIZATION_LEVEL_O3,	// MSVC has no /O3 equivalent; Builder will throw a warning telling you this and fall back to /O2.
 };
 
+// Limits how many of a certain kind of job Builder runs at once, without limiting everything else.
+// Useful for things like links or a few really heavy source files that need a lot more memory than everything else.
+struct ResourcePool {
+	// What BuildConfig::compilePool, BuildConfig::linkPool, and SourceFilePool::pool use to refer to this pool.
+	std::string					name;
+
+	// The most jobs in this pool that Builder will run at once.
+	// Must be at least 1.
+	unsigned int				depth;
+};
+
+struct SourceFilePool {
+	// The name of the ResourcePool that these source files compile in.
+	std::string					pool;
+
+	// The source files that go in this pool.
+	// These work the same as BuildConfig::sourceFiles, including wildcards.
+	// Files in here that aren't also in BuildConfig::sourceFiles are ignored.
+	std::vector<std::string>	sourceFiles;
+};
+
 struct BuildConfig {
 	// The other BuildConfigs that this build needs to have happened first.
 	std::vector<BuildConfig>	dependsOn;
@@ -128,6 +149,21 @@ struct BuildConfig {
 	// These will get added to the end of all the other linker arguments.
 	std::vector<std::string>	additionalLinkerArguments;
 
+	// Puts some of this config's source files in a different ResourcePool to 'compilePool'.
+	// If a source file is in more than one of these then the first one wins.
+	std::vector<SourceFilePool>	sourceFilePools;
+
+	// Source files that always compile on their own, even if 'unityBuild' is on.
+	// These work the same as 'sourceFiles', including wildcards.
+	// Source files in 'sourceFilePools' always compile on their own too.
+	std::vector<std::string>	unityExcludedFiles;
+
+	// A header that gets precompiled once and then included at the start of every source file in this config.
+	// This path is relative to the file you pass into Builder.
+	// The precompiled header only gets rebuilt when it or anything it includes changes, and the source files only get rebuilt when it does.
+	// Only works with Clang and GCC.
+	std::string					precompiledHeader;
+
 	// The name that the built binary is going to have.
 	// It's not necessary to include the file extension unless 'removeFileExtension' is false.
 	// This will be placed inside binaryFolder, if you set that.
@@ -152,6 +188,13 @@ struct BuildConfig {
 	// Where 'name' is whatever you set this to.
 	std::string					name;
 
+	// The name of the ResourcePool (from BuilderOptions::resourcePools) that this config's source files compile in.
+	// If you leave this empty then they aren't in a pool, so Builder compiles as many of them at once as it can.
+	std::string					compilePool;
+
+	// Same as 'compilePool', but for linking this config.
+	std::string					linkPool;
+
 	// What version of C or C++ do you want to build with?
 	// For Clang: This sets the -std argument.
 	// For MSVC: This sets the /std argument.
@@ -173,6 +216,40 @@ struct BuildConfig {
 	// Do you want warnings to count as errors?
 	bool						warningsAsErrors;
 
+	// Do you want Builder to pick what goes in this config's precompiled header for you?
+	// Builder picks from the headers this config's source files included the last time they compiled, generates the precompiled header in 'intermediateFolder', and keeps it up to date.
+	// Headers that change often (going by the git history) get left out, so changing them doesn't rebuild everything, and the headers it picked stay in from one build to the next unless that happens.
+	// Headers that changed in the last week don't get added either, since you're probably still working on them.
+	// Run Builder with --pch-report to see which headers it would pick, and how much time it expects that to save, before you turn this on.
+	// Does nothing if 'precompiledHeader' is set.  Only works with Clang and GCC.
+	bool						automaticPrecompiledHeader;
+
+	// Do you want Builder to compile this config's source files in batches, by generating a source file for each batch that #includes all of them (a "unity" or "jumbo" build)?
+	// The headers the source files in a batch share only get parsed once per batch, and the compiler only has to start once per batch, which makes full builds of lots of small source files a lot faster.
+	// Source files that include similar things go in the same batch, and stay in that batch from one build to the next.
+	// Source files you edited recently get compiled on their own, so that editing one doesn't compile its whole batch every time.
+	// If a batch fails to compile but its source files compile fine on their own (like when two of them have a static function with the same name), Builder compiles those on their own from then on.
+	bool						unityBuild;
+
+	// How many source files go in each batch when 'unityBuild' is on.
+	// Defaults to 8.
+	unsigned int				unityBatchSize;
+
+	// Do you want Builder to compile source files that only take a moment to compile several at a time, in one run of the compiler?
+	// When a config has lots of tiny source files, starting the compiler for each one can take longer than actually compiling them.
+	// Builder uses how long each source file took to compile last time to decide which ones are small enough and how many go in each run, and still reports errors against the right source file.
+	// The compiler runs inside 'intermediateFolder' when it does this, so Builder makes relative paths in Clang and GCC arguments like -include and -isystem in 'additionalCompilerArguments' relative to the folder your build source file is in, same as 'additionalIncludes'.
+	// Only works with Clang and GCC.
+	bool						batchSmallSourceFiles;
+
+	// Do any of this config's source files use C++20 named modules (export module, import)?
+	// Builder scans every source file for the modules it exports and imports, and compiles each module interface before anything that imports it, as many at once as the imports allow.
+	// Source files that import a module get told where its compiled interface is, so you don't need to pass any module flags yourself.
+	// Module interface files can have whatever extension you like (.cppm and .ixx count as source files too), but modules can only be imported by source files in the same config.
+	// Source files that export or import a module never go in a unity build batch or the compile cache.
+	// Only works with Clang and GCC.
+	bool						cppModules;
+
 	// This function runs just before this BuildConfig gets built.
 	void						( *OnPreBuild )( BuildConfig *config );
 
@@ -419,6 +496,27 @@ struct BuilderOptions {
 	// If all you're doing is generating Visual Studio Solutions then you don't need to fill this out.
 	std::vector<BuildConfig>	configs;
 
+	// Pools that BuildConfigs can put their jobs in to limit how many of those run at once.
+	// For example a "link" pool with a depth of 2 means that no matter how many configs are building, only 2 of them will ever link at the same time.
+	std::vector<ResourcePool>	resourcePools;
+
+	// An absolute path to a compile cache folder that can be shared between several checkouts of the same code (e.g. worktrees).
+	// If you leave this empty then each checkout gets its own cache inside its .builder folder.
+	// Builder swaps the folder your build source file is in for a placeholder in everything it puts in here, and passes -ffile-prefix-map so that the object files don't have it in them either.
+	// Clang and GCC only.
+	std::string					compileCacheFolder;
+
+	// If the compile cache gets bigger than this then the least recently used entries get deleted (in the background, while the build runs).
+	// If you leave this at 0 then the compile cache can get as big as it likes.
+	unsigned int				compileCacheMaxSizeMB;
+
+	// Where to share compile cache entries with other machines (e.g. every agent in a CI farm), on top of the local compile cache.
+	// Either a folder (e.g. on a network drive) or an HTTP server, as in "http://host:port/prefix".  Run builder --serve-cache for a simple server.
+	// Builder never waits for the remote cache during the build, only at the end to finish uploading what it compiled.
+	// The --remote-cache= command line argument overrides this.
+	// Clang and GCC only.
+	std::string					remoteCache;
+
 	// If you don't use Visual Studio then ignore this.
 	VisualStudioSolution		solution;
 
@@ -569,11 +667,13 @@ static unsigned int BuilderGetConfigHash( BuildConfig *config, const unsigned in
 	hash = BuilderHashStringArray( hash, config->ignoreWarnings );
 	hash = BuilderHashStringArray( hash, config->additionalCompilerArguments );
 	hash = BuilderHashStringArray( hash, config->additionalLinkerArguments );
+	hash = BuilderHashStringArray( hash, config->unityExcludedFiles );
 
 	hash = BuilderHashCString( hash, config->binaryName.c_str(), config->binaryName.length() );
 	hash = BuilderHashCString( hash, config->binaryFolder.c_str(), config->binaryFolder.length() );
 	hash = BuilderHashCString( hash, config->intermediateFolder.c_str(), config->intermediateFolder.length() );
 	hash = BuilderHashCString( hash, config->name.c_str(), config->name.length() );
+	hash = BuilderHashCString( hash, config->precompiledHeader.c_str(), config->precompiledHeader.length() );
 
 	hash = BuilderHashSDBM( &config->languageVersion, hash, sizeof( LanguageVersion ) );
 	hash = BuilderHashSDBM( &config->binaryType, hash, sizeof( BinaryType ) );
@@ -582,6 +682,11 @@ static unsigned int BuilderGetConfigHash( BuildConfig *config, const unsigned in
 	hash = BuilderHashSDBM( &config->removeSymbols, hash, sizeof( bool ) );
 	hash = BuilderHashSDBM( &config->removeFileExtension, hash, sizeof( bool ) );
 	hash = BuilderHashSDBM( &config->warningsAsErrors, hash, sizeof( bool ) );
+	hash = BuilderHashSDBM( &config->automaticPrecompiledHeader, hash, sizeof( bool ) );
+	hash = BuilderHashSDBM( &config->unityBuild, hash, sizeof( bool ) );
+	hash = BuilderHashSDBM( &config->unityBatchSize, hash, sizeof( unsigned int ) );
+	hash = BuilderHashSDBM( &config->batchSmallSourceFiles, hash, sizeof( bool ) );
+	hash = BuilderHashSDBM( &config->cppModules, hash, sizeof( bool ) );
 
 	// TODO(DM): do we hash OnPreBuild() and OnPostBuild() too?
 
@@ -46,7 +46,7 @@ if /I [%config%] == [debug] (
 	set optimisation=-O0
 	set programName=builder_debug
 	set defines=-D_CRT_SECURE_NO_WARNINGS -DHLML_NAMESPACE -D_DEBUG -DBUILDER_PROGRAM_NAME=\"builder_debug\" -DHASHMAP_HIDE_MISSING_KEY_WARNING
-	set libraries=-luser32.lib -lShlwapi.lib -lDbgHelp.lib -lOle32.lib -lAdvapi32.lib -lOleAut32.lib -llibclang.lib -lkernel32.lib^
+	set libraries=-luser32.lib -lShlwapi.lib -lDbgHelp.lib -lOle32.lib -lAdvapi32.lib -lOleAut32.lib -lWs2_32.lib -llibclang.lib -lkernel32.lib^
  -lmsvcrtd.lib -lmsvcprtd.lib -lvcruntimed.lib -lucrtd.lib
 )
 
@@ -55,7 +55,7 @@ if /I [%config%] == [release]  (
 	set optimisation=-O3
 	set programName=builder
 	set defines=-D_CRT_SECURE_NO_WARNINGS -DHLML_NAMESPACE -DNDEBUG -DBUILDER_PROGRAM_NAME=\"builder\" -DHASHMAP_HIDE_MISSING_KEY_WARNING
-	set libraries=-luser32.lib -lShlwapi.lib -lDbgHelp.lib -lOle32.lib -lAdvapi32.lib -lOleAut32.lib -llibclang.lib -lkernel32.lib^
+	set libraries=-luser32.lib -lShlwapi.lib -lDbgHelp.lib -lOle32.lib -lAdvapi32.lib -lOleAut32.lib -lWs2_32.lib -llibclang.lib -lkernel32.lib^
  -lmsvcrt.lib -lmsvcprt.lib -lvcruntime.lib -lucrt.lib
 )
 
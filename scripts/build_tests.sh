@@ -15,7 +15,7 @@ if [[ "$config" != "release" ]]; then
 fi
 
 sourceFiles="tests/tests_main.cpp src/builder.cpp src/visual_studio.cpp src/vs_code.cpp src/zed_editor.cpp src/backend_clang.cpp src/backend_msvc.cpp src/win_support.cpp\
-	src/debug.cpp src/file.cpp src/hash.cpp src/hashmap.cpp src/linear_allocator.cpp src/math.cpp src/paths.cpp src/stb_impl.cpp src/string.cpp src/string_builder.cpp src/temp_storage.cpp\
+	src/build_history.cpp src/build_trace.cpp src/cache_server.cpp src/compile_cache.cpp src/compression.cpp src/critical_path.cpp src/debug.cpp src/file.cpp src/file_hash_cache.cpp src/file_stat_memo.cpp src/hash.cpp src/hashmap.cpp src/header_impact.cpp src/http.cpp src/include_dependency_db.cpp src/job_pool.cpp src/jobserver.cpp src/linear_allocator.cpp src/math.cpp src/memory_throttle.cpp src/module_scanner.cpp src/paths.cpp src/pch_advisor.cpp src/remote_cache.cpp src/stb_impl.cpp src/string.cpp src/string_builder.cpp src/temp_storage.cpp src/time_trace.cpp src/unity_build.cpp\
 	src/linux/*.cpp"
 
 args="${clangDir}/bin/clang ${symbols} ${optimisation} -std=c++20 -fexceptions -ferror-limit=0 -o ${binFolder}/builder_tests_${config} ${sourceFiles} ${defines} ${includes} ${libPaths} ${libraries} ${warningLevels} ${ignoreWarnings} -Wl,-rpath=$binFolder"
@@ -42,6 +42,9 @@ SOFTWARE.
 #include "string_builder.h"
 #include "defer.h"
 #include "library.h"
+#include "compile_cache.h"
+#include "hash.h"
+#include "hashmap.h"
 
 #include <clang-c/Index.h>
 
@@ -83,81 +86,113 @@ static void ReadDependencyFile( const char *depFilename, std::vector<std::string
 
 	outIncludeDependencies.clear();
 
-	char *current = depFileBuffer.data;
-
-	// .d files start with the name of the binary followed by a colon
-	// so skip past that first
-	current = strchr( depFileBuffer.data, ':' );
+	// .d files start with the name of the binary followed by a colon and a space
+	// look for both because on windows the path has a drive letter in it
+	char *current = strstr( depFileBuffer.data, ": " );
 	Assert( current );
-	current += 1;	// skip past the colon
-	current += 1;	// skip past the following whitespace
+	current += 2;
 
-	// skip past the newline after
-	current = strchr( current, '\n' );
-	Assert( current );
-	current += 1;
+	// after that its every file the binary depends on, separated by whitespace
+	// clang puts each one on its own line, but gcc puts as many on a line as will fit, so go by the whitespace rather than the lines
+	// the first one is always the source file itself, which isnt an include dependency
+	// the list ends at the first line that doesnt end in a backslash, gcc puts rules about C++20 modules after that which arent files
+	bool8 foundSourceFile = false;
 
 	while ( *current ) {
-		// get start of the filename
-		char *dependencyStart = current;
-
-		while ( *dependencyStart == ' ' ) {
-			dependencyStart += 1;
-		}
-
-		// get end of the filename
-		char *dependencyEnd = NULL;
-		// filenames are separated by either new line or space
-		if ( !dependencyEnd ) dependencyEnd = strchr( dependencyStart, ' ' );
-		if ( !dependencyEnd ) dependencyEnd = strchr( dependencyStart, '\n' );
-		Assert( dependencyEnd );
-		// paths can have spaces in them, but they are preceded by a single backslash (\)
-		// so if we find a space but it has a single backslash just before it then keep searching for a space
-		while ( dependencyEnd && ( *( dependencyEnd - 1 ) == '\\' ) ) {
-			dependencyEnd = strchr( dependencyEnd + 1, ' ' );
+		if ( *current == '\n' ) {
+			break;
 		}
 
-		if ( !dependencyEnd ) {
-			break;
+		// skip whitespace, and the backslashes that continue the list onto the next line
+		if ( *current == ' ' || *current == '\t' || *current == '\r' ) {
+			current += 1;
+			continue;
 		}
 
-		if ( *( dependencyEnd - 1 ) == '\r' ) {
-			dependencyEnd -= 1;
+		if ( current[0] == '\\' && ( current[1] == '\n' || current[1] == '\r' ) ) {
+			current += ( current[1] == '\r' && current[2] == '\n' ) ? 3 : 2;
+			continue;
 		}
 
-		u64 dependencyFilenameLength = Cast( u64, dependencyEnd ) - Cast( u64, dependencyStart );
+		// paths can have spaces in them, but they are preceded by a single backslash (\)
+		std::string dependencyFilename;
 
-		// get the substring we actually need
-		std::string dependencyFilename( dependencyStart, dependencyFilenameLength );
-		For ( u64, i, 0, dependencyFilename.size() ) {
-			if ( dependencyFilename[i] == '\\' && dependencyFilename[i + 1] == ' ' ) {
-				dependencyFilename.erase( i, 1 );
+		while ( *current && *current != ' ' && *current != '\t' && *current != '\r' && *current != '\n' ) {
+			if ( current[0] == '\\' && current[1] == ' ' ) {
+				current += 1;
 			}
+
+			dependencyFilename += *current;
+			current += 1;
 		}
 
-		{
+		if ( !foundSourceFile ) {
+			foundSourceFile = true;
+			continue;
+		}
+
+		// only pay for the stat if were actually going to print it
+		if ( g_verbose ) {
 			u64 lastWriteTime = GetLastFileWriteTime( dependencyFilename.c_str() );
 			LogVerbose( " - Found dependency %s, last write time = %llu\n", dependencyFilename.c_str(), lastWriteTime );
 		}
 
-		outIncludeDependencies.push_back( dependencyFilename.c_str() );
+		outIncludeDependencies.push_back( dependencyFilename );
+	}
 
-		current = dependencyEnd + 1;
+	LogVerbose( "Finished parsing dependency file \"%s\"...\n", depFilename );
+}
 
-		while ( *current == '\\' ) {
-			current += 1;
-		}
+// NULL if the source file doesnt export or import a C++20 module
+static const std::vector<std::string> *GetModuleArgs( const compilationCommandArchetype_t &cmdArchetype, const char *sourceFile ) {
+	if ( !cmdArchetype.moduleArgsIndices ) {
+		return NULL;
+	}
 
-		if ( *current == '\r' ) {
-			current += 1;
-		}
+	u32 moduleArgsIndex = HM_GetValue( cmdArchetype.moduleArgsIndices, HashString( sourceFile, 0 ) );
 
-		if ( *current == '\n' ) {
-			current += 1;
+	if ( moduleArgsIndex == HASHMAP_INVALID_VALUE ) {
+		return NULL;
+	}
+
+	return &cmdArchetype.moduleArgs[moduleArgsIndex];
+}
+
+// ':' cant go in a filename on windows, so partitions get a '-' instead
+static std::string GetModuleInterfaceFilename( const BuildConfig *config, const char *moduleName, const char *extension ) {
+	std::string filename = TempPrintf( "%s%c%s%s", config->intermediateFolder.c_str(), PATH_SEPARATOR, moduleName, extension );
+
+	For ( u64, charIndex, config->intermediateFolder.size() + 1, filename.size() ) {
+		if ( filename[charIndex] == ':' ) {
+			filename[charIndex] = '-';
 		}
 	}
 
-	LogVerbose( "Finished parsing dependency file \"%s\"...\n", depFilename );
+	return filename;
+}
+
+// the compiler doesnt put the files that came from the precompiled header in the dependency file, so add them ourselves
+// a header that the source file included itself can end up in there twice, which doesnt hurt
+static void AddPrecompiledHeaderDependencies( const compilationCommandArchetype_t &cmdArchetype, std::vector<std::string> &includeDependencies ) {
+	includeDependencies.insert( includeDependencies.end(), cmdArchetype.precompiledHeaderDependencies.begin(), cmdArchetype.precompiledHeaderDependencies.end() );
+}
+
+static bool8 BuildConfig_IsC( const BuildConfig *config ) {
+	switch ( config->languageVersion ) {
+		case LANGUAGE_VERSION_C89:
+		case LANGUAGE_VERSION_C99:
+		case LANGUAGE_VERSION_C11:
+		case LANGUAGE_VERSION_C17:
+		case LANGUAGE_VERSION_C23:
+			return true;
+
+		case LANGUAGE_VERSION_UNSET:
+			// the compiler goes by the file extension, so do the same
+			return !config->sourceFiles.empty() && String_EndsWith( config->sourceFiles[0].c_str(), ".c" );
+
+		default:
+			return false;
+	}
 }
 
 static void ResolveCompilerAndLinkerPaths( clangState_t *clangState, linearAllocator_t *allocator, const char *compilerPath, const char *compilerName, const char *linkerName ) {
@@ -245,6 +280,60 @@ static void Clang_Shutdown( compilerBackend_t *backend ) {
 	backend->data = NULL;
 }
 
+static bool8 Clang_GetCompileCommand( compilerBackend_t *backend, const buildContext_t *buildContext, const BuildConfig *config, const compilationCommandArchetype_t &cmdArchetype, const char *sourceFile, array_t<const char *> *outArgs ) {
+	UNUSED( backend );
+
+	Assert( sourceFile );
+	Assert( outArgs );
+
+	string_t sourceFileNoPath = String_Set( sourceFile );
+	sourceFileNoPath = Path_RemovePathFromFile( &sourceFileNoPath );
+
+	outArgs->AddRange( &cmdArchetype.baseArgs );
+	outArgs->AddRange( &cmdArchetype.precompiledHeaderArgs );
+
+	const std::vector<std::string> *moduleArgs = GetModuleArgs( cmdArchetype, sourceFile );
+
+	if ( moduleArgs ) {
+		For ( u64, argIndex, 0, moduleArgs->size() ) {
+			outArgs->Add( ( *moduleArgs )[argIndex].c_str() );
+		}
+	}
+
+	string_t sourceFileNoPathAndExtension = Path_RemoveFileExtension( &sourceFileNoPath );
+
+	const char *intermediateFile = TempPrintf( "%s%c%s.o", config->intermediateFolder.c_str(), PATH_SEPARATOR, String_Cstr( &sourceFileNoPathAndExtension ) );
+
+	// Fill up remaining arguments
+
+	// a compile cache thats shared between checkouts needs the object files to not have the checkout's path in them
+	// this covers the debug info and __FILE__ (it implies -fdebug-prefix-map and -fmacro-prefix-map)
+	if ( buildContext->compileCache && buildContext->compileCache->rootFolder ) {
+		outArgs->Add( TempPrintf( "-ffile-prefix-map=%s=.", buildContext->compileCache->rootFolder ) );
+	}
+
+	// the trace goes next to the object file, see time_trace.h
+	// this doesnt change what gets compiled, so it stays out of the archetype, otherwise the next normal build would think every source file needs compiling again
+	if ( buildContext->timeTrace ) {
+		outArgs->Add( "-ftime-trace" );
+	}
+
+	// Dependency Flags/File
+	For ( u64, flagIndex, 0, cmdArchetype.dependencyFlags.count ) {
+		outArgs->Add( cmdArchetype.dependencyFlags[flagIndex] );
+	}
+	outArgs->Add( TempPrintf( "%s%c%s.d", config->intermediateFolder.c_str(), PATH_SEPARATOR, sourceFileNoPath.data ) );
+
+	// Output Flag/File
+	outArgs->Add( cmdArchetype.outputFlag );
+	outArgs->Add( intermediateFile );
+
+	// Source File
+	outArgs->Add( sourceFile );
+
+	return true;
+}
+
 static bool8 Clang_CompileSourceFile(
 	compilerBackend_t *backend,
 	buildContext_t *buildContext,
@@ -253,7 +342,9 @@ static bool8 Clang_CompileSourceFile(
 	const char *sourceFile,
 	bool recordCompilation,
 	u64 sourceFileIndex,
-	std::vector<std::string> *outIncludeDependencies )
+	std::vector<std::string> *outIncludeDependencies,
+	u64 *outPeakMemoryBytes,
+	bool8 *outCacheHit )
 {
 	Assert( backend );
 	Assert( sourceFile );
@@ -265,47 +356,364 @@ static bool8 Clang_CompileSourceFile(
 
 	const char *depFilename = TempPrintf( "%s%c%s.d", config->intermediateFolder.c_str(), PATH_SEPARATOR, String_Cstr( &sourceFileNoPath ) );
 
+	string_t sourceFileNoPathAndExtension = Path_RemoveFileExtension( &sourceFileNoPath );
+
+	const char *intermediateFile = TempPrintf( "%s%c%s.o", config->intermediateFolder.c_str(), PATH_SEPARATOR, String_Cstr( &sourceFileNoPathAndExtension ) );
+
 	array_t<const char *> finalArgs;
 	finalArgs.Init( Mem_GetTempStorage() );
-	finalArgs.AddRange( &cmdArchetype.baseArgs );
+	Clang_GetCompileCommand( backend, buildContext, config, cmdArchetype, sourceFile, &finalArgs );
 
-	string_t sourceFileNoPathAndExtension = Path_RemoveFileExtension( &sourceFileNoPath );
+	procFlags_t procFlags = PROC_FLAG_SHOW_STDOUT;
+	if ( buildContext->consolidateCompilerArgs ) {
+		printf( "%s -> %s\n", sourceFile, intermediateFile );
+	} else {
+		procFlags |= PROC_FLAG_SHOW_ARGS;
+	}
 
-	const char *intermediateFile = TempPrintf( "%s%c%s.o", config->intermediateFolder.c_str(), PATH_SEPARATOR, String_Cstr( &sourceFileNoPathAndExtension ) );
+	// the compile cache only knows about the object file and not the compiled module interface that comes with it, or the ones it read
+	// so anything that exports or imports a module always gets compiled for real
+	compileCache_t *compileCache = GetModuleArgs( cmdArchetype, sourceFile ) ? NULL : buildContext->compileCache;
+	u64 commandHash = 0;
 
-	// Fill up remaining arguments
+	if ( compileCache ) {
+		commandHash = CompileCache_HashCommand( compileCache, &finalArgs );
+
+		// a forced rebuild still refreshes the cache, it just doesnt take anything out of it
+		string_t compilerOutput = {};
+		if ( !buildContext->forceRebuild && CompileCache_Restore( compileCache, commandHash, sourceFile, intermediateFile, depFilename, &compilerOutput ) ) {
+			LogVerbose( "Restored \"%s\" from the compile cache.\n", intermediateFile );
+
+			if ( procFlags & PROC_FLAG_SHOW_ARGS ) {
+				For ( u64, argIndex, 0, finalArgs.count ) {
+					printf( "%s ", finalArgs[argIndex] );
+				}
+				printf( "\n" );
+			}
+
+			// replay whatever the compiler said the first time, so warnings dont disappear just because the file came out of the cache
+			if ( compilerOutput.count > 0 ) {
+				printf( "%.*s", TruncCast( int, compilerOutput.count ), compilerOutput.data );
+			}
+
+			if ( outIncludeDependencies ) {
+				ReadDependencyFile( depFilename, *outIncludeDependencies );
+				AddPrecompiledHeaderDependencies( cmdArchetype, *outIncludeDependencies );
+			}
+
+			if ( recordCompilation ) {
+				RecordCompilationDatabaseEntry( buildContext, sourceFile, finalArgs, sourceFileIndex );
+			}
+
+			*outCacheHit = true;
+
+			return true;
+		}
+
+		// the object file might be a hard link into the cache, and the compiler would write straight through it and into the cache entry
+		if ( FS_FileExists( intermediateFile ) ) {
+			FS_DeleteFile( intermediateFile );
+		}
+	}
+
+	string_t compilerOutput = {};
+	s32 exitCode = RunProc( &finalArgs, NULL, procFlags, compileCache ? &compilerOutput : NULL, outPeakMemoryBytes );
+
+	std::vector<std::string> includeDependencies;
+	if ( exitCode == 0 && ( outIncludeDependencies || compileCache ) ) {
+		ReadDependencyFile( depFilename, outIncludeDependencies ? *outIncludeDependencies : includeDependencies );
+		AddPrecompiledHeaderDependencies( cmdArchetype, outIncludeDependencies ? *outIncludeDependencies : includeDependencies );
+	}
+
+	if ( exitCode == 0 && compileCache ) {
+		const std::vector<std::string> &dependencies = outIncludeDependencies ? *outIncludeDependencies : includeDependencies;
+
+		const char **dependencyFilenames = Cast( const char **, Mem_TempAlloc( ( dependencies.size() + 1 ) * sizeof( const char * ) ) );
+		For ( u64, dependencyIndex, 0, dependencies.size() ) {
+			dependencyFilenames[dependencyIndex] = dependencies[dependencyIndex].c_str();
+		}
+
+		if ( !CompileCache_Store( compileCache, commandHash, sourceFile, dependencyFilenames, dependencies.size(), intermediateFile, depFilename, &compilerOutput ) ) {
+			LogVerbose( "Failed to add \"%s\" to the compile cache.\n", intermediateFile );
+		}
+	}
+
+	if ( recordCompilation ) {
+		RecordCompilationDatabaseEntry( buildContext, sourceFile, finalArgs, sourceFileIndex );
+	}
+
+	return exitCode == 0;
+}
+
+// compiles all of them in one run of the compiler, so we only pay for starting it once
+// the compiler only takes one -o and one -MF, so instead it runs inside the intermediate folder with neither of them
+// that way each object file gets named after its source file and ends up in exactly the same place it would have anyway
+// the exit code doesnt say which source files failed, so if it failed then every source file in it gets compiled again on its own
+static bool8 Clang_CompileSourceFiles(
+	compilerBackend_t *backend,
+	buildContext_t *buildContext,
+	BuildConfig *config,
+	compilationCommandArchetype_t &cmdArchetype,
+	const char * const *sourceFiles,
+	const u32 numSourceFiles,
+	bool recordCompilation,
+	const u64 *sourceFileIndices,
+	std::vector<std::string> *outIncludeDependencies,
+	bool8 *outSucceeded,
+	bool8 *outCacheHits,
+	u64 *outPeakMemoryBytes )
+{
+	Assert( backend );
+	Assert( sourceFiles );
+	Assert( numSourceFiles > 0 );
+	Assert( outIncludeDependencies );
+	Assert( outSucceeded );
+	Assert( outCacheHits );
+
+	compileCache_t *compileCache = buildContext->compileCache;
+
+	const char *intermediateFolder = config->intermediateFolder.c_str();
+
+	const char **intermediateFiles = Cast( const char **, Mem_TempAlloc( numSourceFiles * sizeof( const char * ) ) );
+	const char **depFilenames = Cast( const char **, Mem_TempAlloc( numSourceFiles * sizeof( const char * ) ) );
+	const char **compilerDepFilenames = Cast( const char **, Mem_TempAlloc( numSourceFiles * sizeof( const char * ) ) );
+	u64 *commandHashes = Cast( u64 *, Mem_TempAlloc( numSourceFiles * sizeof( u64 ) ) );
+	bool8 *compiling = Cast( bool8 *, Mem_TempAlloc( numSourceFiles * sizeof( bool8 ) ) );
+
+	array_t<const char *> args;
+	args.Init( Mem_GetTempStorage() );
+	args.AddRange( &cmdArchetype.baseArgs );
+	args.AddRange( &cmdArchetype.precompiledHeaderArgs );
+
+	// same as Clang_GetCompileCommand()
+	if ( compileCache && compileCache->rootFolder ) {
+		args.Add( TempPrintf( "-ffile-prefix-map=%s=.", compileCache->rootFolder ) );
+	}
+
+	if ( buildContext->timeTrace ) {
+		args.Add( "-ftime-trace" );
+	}
+
+	// without -MF the compiler names each dependency file after the object file
+	args.Add( "-MMD" );
+
+	u32 numCompiling = 0;
+
+	For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+		const char *sourceFile = sourceFiles[sourceFileIndex];
+
+		outSucceeded[sourceFileIndex] = false;
+		outCacheHits[sourceFileIndex] = false;
+		compiling[sourceFileIndex] = false;
+
+		string_t sourceFileNoPath = String_Set( sourceFile );
+		sourceFileNoPath = Path_RemovePathFromFile( &sourceFileNoPath );
+
+		string_t sourceFileNoPathAndExtension = Path_RemoveFileExtension( &sourceFileNoPath );
+
+		intermediateFiles[sourceFileIndex] = TempPrintf( "%s%c%s.o", intermediateFolder, PATH_SEPARATOR, String_Cstr( &sourceFileNoPathAndExtension ) );
+		depFilenames[sourceFileIndex] = TempPrintf( "%s%c%s.d", intermediateFolder, PATH_SEPARATOR, String_Cstr( &sourceFileNoPath ) );
+		compilerDepFilenames[sourceFileIndex] = TempPrintf( "%s%c%s.d", intermediateFolder, PATH_SEPARATOR, String_Cstr( &sourceFileNoPathAndExtension ) );
+
+		// the compile cache and the compilation database get the command line the source file would have had on its own
+		// so neither of them cares whether it got compiled with other source files or not
+		array_t<const char *> sourceFileArgs;
+		sourceFileArgs.Init( Mem_GetTempStorage() );
+		Clang_GetCompileCommand( backend, buildContext, config, cmdArchetype, sourceFile, &sourceFileArgs );
+
+		if ( recordCompilation ) {
+			RecordCompilationDatabaseEntry( buildContext, sourceFile, sourceFileArgs, sourceFileIndices[sourceFileIndex] );
+		}
+
+		if ( compileCache ) {
+			commandHashes[sourceFileIndex] = CompileCache_HashCommand( compileCache, &sourceFileArgs );
+
+			string_t compilerOutput = {};
+			if ( !buildContext->forceRebuild && CompileCache_Restore( compileCache, commandHashes[sourceFileIndex], sourceFile, intermediateFiles[sourceFileIndex], depFilenames[sourceFileIndex], &compilerOutput ) ) {
+				LogVerbose( "Restored \"%s\" from the compile cache.\n", intermediateFiles[sourceFileIndex] );
+
+				if ( compilerOutput.count > 0 ) {
+					printf( "%.*s", TruncCast( int, compilerOutput.count ), compilerOutput.data );
+				}
+
+				ReadDependencyFile( depFilenames[sourceFileIndex], outIncludeDependencies[sourceFileIndex] );
+				AddPrecompiledHeaderDependencies( cmdArchetype, outIncludeDependencies[sourceFileIndex] );
+
+				outSucceeded[sourceFileIndex] = true;
+				outCacheHits[sourceFileIndex] = true;
+
+				continue;
+			}
+		}
+
+		// an object file left over from before would look like the compiler just made it
+		// it could also be a hard link into the compile cache, and the compiler would write straight through it and into the cache entry
+		if ( FS_FileExists( intermediateFiles[sourceFileIndex] ) ) {
+			FS_DeleteFile( intermediateFiles[sourceFileIndex] );
+		}
+
+		if ( buildContext->consolidateCompilerArgs ) {
+			printf( "%s -> %s\n", sourceFile, intermediateFiles[sourceFileIndex] );
+		}
+
+		args.Add( sourceFile );
+
+		compiling[sourceFileIndex] = true;
+		numCompiling++;
+	}
+
+	if ( numCompiling == 0 ) {
+		return true;
+	}
+
+	// dont show what the compiler says yet, if it failed then every source file prints it all again when it gets compiled on its own
+	procFlags_t procFlags = buildContext->consolidateCompilerArgs ? 0 : PROC_FLAG_SHOW_ARGS;
+
+	string_t compilerOutput = {};
+	s32 exitCode = RunProc( &args, NULL, procFlags, &compilerOutput, outPeakMemoryBytes, intermediateFolder );
+
+	bool8 allSucceeded = true;
+
+	For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+		if ( !compiling[sourceFileIndex] ) {
+			continue;
+		}
+
+		// going by which object files came out would lose any warnings for the source files that did compile
+		// so if anything went wrong then this one gets compiled again on its own, even if it looks like its fine
+		bool8 compiled = exitCode == 0 && FS_FileExists( intermediateFiles[sourceFileIndex] ) && FS_RenameFile( compilerDepFilenames[sourceFileIndex], depFilenames[sourceFileIndex] );
+
+		if ( !compiled ) {
+			if ( FS_FileExists( compilerDepFilenames[sourceFileIndex] ) ) {
+				FS_DeleteFile( compilerDepFilenames[sourceFileIndex] );
+			}
+
+			u64 peakMemoryBytes = 0;
+			outSucceeded[sourceFileIndex] = Clang_CompileSourceFile( backend, buildContext, config, cmdArchetype, sourceFiles[sourceFileIndex], false, sourceFileIndices[sourceFileIndex], &outIncludeDependencies[sourceFileIndex], &peakMemoryBytes, &outCacheHits[sourceFileIndex] );
+
+			if ( outPeakMemoryBytes ) {
+				*outPeakMemoryBytes = Max( *outPeakMemoryBytes, peakMemoryBytes );
+			}
+
+			if ( !outSucceeded[sourceFileIndex] ) {
+				allSucceeded = false;
+			}
+
+			compiling[sourceFileIndex] = false;
+
+			continue;
+		}
+
+		ReadDependencyFile( depFilenames[sourceFileIndex], outIncludeDependencies[sourceFileIndex] );
+		AddPrecompiledHeaderDependencies( cmdArchetype, outIncludeDependencies[sourceFileIndex] );
+
+		outSucceeded[sourceFileIndex] = true;
+	}
+
+	if ( exitCode != 0 ) {
+		return allSucceeded;
+	}
+
+	if ( compilerOutput.count > 0 ) {
+		printf( "%.*s", TruncCast( int, compilerOutput.count ), compilerOutput.data );
+	}
+
+	// theres no telling which of what the compiler said was about which source file
+	// so if it said anything then none of them go in the compile cache, otherwise the next cache hit wouldnt show it again
+	if ( compileCache && compilerOutput.count == 0 ) {
+		For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+			if ( !compiling[sourceFileIndex] ) {
+				continue;
+			}
+
+			const std::vector<std::string> &dependencies = outIncludeDependencies[sourceFileIndex];
+
+			const char **dependencyFilenames = Cast( const char **, Mem_TempAlloc( ( dependencies.size() + 1 ) * sizeof( const char * ) ) );
+			For ( u64, dependencyIndex, 0, dependencies.size() ) {
+				dependencyFilenames[dependencyIndex] = dependencies[dependencyIndex].c_str();
+			}
+
+			if ( !CompileCache_Store( compileCache, commandHashes[sourceFileIndex], sourceFiles[sourceFileIndex], dependencyFilenames, dependencies.size(), intermediateFiles[sourceFileIndex], depFilenames[sourceFileIndex], &compilerOutput ) ) {
+				LogVerbose( "Failed to add \"%s\" to the compile cache.\n", intermediateFiles[sourceFileIndex] );
+			}
+		}
+	}
+
+	return allSucceeded;
+}
+
+static bool8 Clang_CompilePrecompiledHeader( compilerBackend_t *backend, buildContext_t *buildContext, BuildConfig *config, compilationCommandArchetype_t &cmdArchetype, std::vector<std::string> *outIncludeDependencies, u64 *outPeakMemoryBytes ) {
+	Assert( backend );
+	Assert( cmdArchetype.precompiledHeaderFile );
+
+	UNUSED( backend );
+
+	// the header that actually gets precompiled is one next to the precompiled header that just includes the real one
+	// source files get that one on their command line, so if the compiler ever decides it cant use the precompiled header it just includes the real header instead
+	string_t wrapperHeader = String_Set( cmdArchetype.precompiledHeaderFile );
+	wrapperHeader = Path_RemoveFileExtension( &wrapperHeader );
+	const char *wrapperHeaderFilename = String_Cstr( &wrapperHeader );
+
+	{
+		const char *wrapperContents = TempPrintf( "#include \"%s\"\n", config->precompiledHeader.c_str() );
+
+		// clang checks the timestamps of everything that went into a precompiled header, so only touch this when it actually changes
+		string_t oldWrapperContents = {};
+		bool8 upToDate = false;
+		if ( FS_ReadEntireFile( wrapperHeaderFilename, &oldWrapperContents ) ) {
+			upToDate = String_Equals( oldWrapperContents.data, wrapperContents );
+			FS_FreeFileBuffer( &oldWrapperContents );
+		}
+
+		if ( !upToDate && !FS_WriteEntireFile( wrapperHeaderFilename, wrapperContents, strlen( wrapperContents ) ) ) {
+			s32 errorCode = GetLastErrorCode();
+			Error( "Failed to write \"%s\".  Error code: " ERROR_CODE_FORMAT "\n", wrapperHeaderFilename, errorCode );
+			return false;
+		}
+	}
+
+	const char *depFilename = TempPrintf( "%s.d", cmdArchetype.precompiledHeaderFile );
+
+	array_t<const char *> args;
+	args.Init( Mem_GetTempStorage() );
+	args.AddRange( &cmdArchetype.baseArgs );
+
+	// same as Clang_GetCompileCommand(), the precompiled header has to be built the same way as the source files that use it
+	if ( buildContext->compileCache && buildContext->compileCache->rootFolder ) {
+		args.Add( TempPrintf( "-ffile-prefix-map=%s=.", buildContext->compileCache->rootFolder ) );
+	}
+
+	args.Add( "-x" );
+	args.Add( BuildConfig_IsC( config ) ? "c-header" : "c++-header" );
 
-	// Dependency Flags/File
 	For ( u64, flagIndex, 0, cmdArchetype.dependencyFlags.count ) {
-		finalArgs.Add( cmdArchetype.dependencyFlags[flagIndex] );
+		args.Add( cmdArchetype.dependencyFlags[flagIndex] );
 	}
-	finalArgs.Add( TempPrintf( "%s%c%s.d", config->intermediateFolder.c_str(), PATH_SEPARATOR, sourceFileNoPath.data ) );
+	args.Add( depFilename );
 
-	// Output Flag/File
-	finalArgs.Add( cmdArchetype.outputFlag );
-	finalArgs.Add( intermediateFile );
+	args.Add( cmdArchetype.outputFlag );
+	args.Add( cmdArchetype.precompiledHeaderFile );
 
-	// Source File
-	finalArgs.Add( sourceFile );
+	args.Add( wrapperHeaderFilename );
 
 	procFlags_t procFlags = PROC_FLAG_SHOW_STDOUT;
 	if ( buildContext->consolidateCompilerArgs ) {
-		printf( "%s -> %s\n", sourceFile, intermediateFile );
+		printf( "%s -> %s\n", config->precompiledHeader.c_str(), cmdArchetype.precompiledHeaderFile );
 	} else {
 		procFlags |= PROC_FLAG_SHOW_ARGS;
 	}
 
-	s32 exitCode = RunProc( &finalArgs, NULL, procFlags );
+	s32 exitCode = RunProc( &args, NULL, procFlags, NULL, outPeakMemoryBytes );
 
-	if ( exitCode == 0 && outIncludeDependencies ) {
-		ReadDependencyFile( depFilename, *outIncludeDependencies );
+	if ( exitCode != 0 ) {
+		return false;
 	}
 
-	if ( recordCompilation ) {
-		RecordCompilationDatabaseEntry( buildContext, sourceFile, finalArgs, sourceFileIndex );
+	if ( outIncludeDependencies ) {
+		ReadDependencyFile( depFilename, *outIncludeDependencies );
 	}
 
-	return exitCode == 0;
+	return true;
 }
 
 static bool8 Clang_LinkIntermediateFiles( compilerBackend_t *backend, const std::vector<std::string> &intermediateFiles, BuildConfig *config, const BuilderOptions *options ) {
@@ -722,9 +1130,109 @@ static bool8 Clang_GetCompilationCommandArchetype( const compilerBackend_t *back
 	// Output Flag
 	outCmdArchetype.outputFlag = "-o";
 
+	// Precompiled Header
+	// clang and gcc both look for "<header>.gch" next to any header given to -include and use that instead if they can
+	outCmdArchetype.precompiledHeaderArgs.Init( Mem_GetTempStorage() );
+
+	if ( !config->precompiledHeader.empty() ) {
+		string_t precompiledHeader = String_Set( config->precompiledHeader.c_str() );
+		precompiledHeader = Path_RemovePathFromFile( &precompiledHeader );
+
+		const char *wrapperHeader = TempPrintf( "%s%c%s", config->intermediateFolder.c_str(), PATH_SEPARATOR, String_Cstr( &precompiledHeader ) );
+
+		outCmdArchetype.precompiledHeaderFile = TempPrintf( "%s.gch", wrapperHeader );
+
+		outCmdArchetype.precompiledHeaderArgs.Add( "-include" );
+		outCmdArchetype.precompiledHeaderArgs.Add( wrapperHeader );
+
+		// clang refuses to use a precompiled header if anything that went into it has a newer timestamp, even if it didnt actually change (like after switching branches)
+		// we already know it didnt change, so tell clang to check the contents too
+		if ( isClang ) {
+			outCmdArchetype.precompiledHeaderArgs.Add( "-fpch-validate-input-files-content" );
+		}
+	}
+
 	return true;
 }
 
+// clang 16 and newer can make the compiled module interface at the same time as the object file
+// clang only knows that .cppm files are module interfaces, anything else has to be told
+static bool8 Clang_GetModuleArgs( compilerBackend_t *backend, const BuildConfig *config, const moduleUnit_t *units, const u32 numUnits, compilationCommandArchetype_t &cmdArchetype ) {
+	UNUSED( backend );
+
+	cmdArchetype.moduleArgs.resize( numUnits );
+	cmdArchetype.moduleInterfaceFiles.resize( numUnits );
+
+	For ( u32, unitIndex, 0, numUnits ) {
+		const moduleUnit_t *unit = &units[unitIndex];
+
+		std::vector<std::string> &args = cmdArchetype.moduleArgs[unitIndex];
+		args.clear();
+
+		if ( unit->exportedModule ) {
+			cmdArchetype.moduleInterfaceFiles[unitIndex] = GetModuleInterfaceFilename( config, unit->exportedModule, ".pcm" );
+
+			if ( !String_EndsWith( unit->sourceFile, ".cppm" ) ) {
+				args.push_back( "-x" );
+				args.push_back( "c++-module" );
+			}
+
+			args.push_back( TempPrintf( "-fmodule-output=%s", cmdArchetype.moduleInterfaceFiles[unitIndex].c_str() ) );
+		} else {
+			cmdArchetype.moduleInterfaceFiles[unitIndex].clear();
+		}
+
+		For ( u32, importIndex, 0, unit->numImportedModules ) {
+			const char *importedModule = unit->importedModules[importIndex];
+
+			args.push_back( TempPrintf( "-fmodule-file=%s=%s", importedModule, GetModuleInterfaceFilename( config, importedModule, ".pcm" ).c_str() ) );
+		}
+	}
+
+	return true;
+}
+
+// gcc doesnt take the path of each compiled module interface on the command line, it asks a "module mapper" instead
+// the simplest one is a file with the name of each module and where its compiled interface goes, one per line
+// gcc writes the compiled interface of a module it exports and reads the ones it imports from wherever that says
+static bool8 GCC_GetModuleArgs( compilerBackend_t *backend, const BuildConfig *config, const moduleUnit_t *units, const u32 numUnits, compilationCommandArchetype_t &cmdArchetype ) {
+	UNUSED( backend );
+
+	cmdArchetype.moduleArgs.resize( numUnits );
+	cmdArchetype.moduleInterfaceFiles.resize( numUnits );
+
+	const char *mapperFilename = TempPrintf( "%s%cmodules.map", config->intermediateFolder.c_str(), PATH_SEPARATOR );
+
+	stringBuilder_t mapper = SB_Create( Mem_GetTempStorage() );
+	SB_Appendf( &mapper, "# Generated by Builder, where the compiled interface of each module in this config goes (see BuildConfig::cppModules).\n" );
+
+	For ( u32, unitIndex, 0, numUnits ) {
+		const moduleUnit_t *unit = &units[unitIndex];
+
+		std::vector<std::string> &args = cmdArchetype.moduleArgs[unitIndex];
+		args.clear();
+
+		args.push_back( "-fmodules-ts" );
+		args.push_back( TempPrintf( "-fmodule-mapper=%s", mapperFilename ) );
+
+		if ( unit->exportedModule ) {
+			cmdArchetype.moduleInterfaceFiles[unitIndex] = GetModuleInterfaceFilename( config, unit->exportedModule, ".gcm" );
+
+			SB_Appendf( &mapper, "%s %s\n", unit->exportedModule, cmdArchetype.moduleInterfaceFiles[unitIndex].c_str() );
+
+			// gcc thinks anything with an extension it doesnt know about is something to link
+			if ( !String_EndsWith( unit->sourceFile, ".cpp" ) && !String_EndsWith( unit->sourceFile, ".cxx" ) && !String_EndsWith( unit->sourceFile, ".cc" ) ) {
+				args.push_back( "-x" );
+				args.push_back( "c++" );
+			}
+		} else {
+			cmdArchetype.moduleInterfaceFiles[unitIndex].clear();
+		}
+	}
+
+	return WriteStringBuilderToFile( &mapper, mapperFilename );
+}
+
 static string_t Clang_GetCompilerPath( compilerBackend_t *backend ) {
 	clangState_t *clangState = Cast( clangState_t *, backend->data );
 
@@ -796,7 +1304,11 @@ void CreateCompilerBackend_Clang( compilerBackend_t *outBackend ) {
 		.data							= NULL,
 		.Init							= Clang_Init,
 		.Shutdown						= Clang_Shutdown,
+		.GetCompileCommand				= Clang_GetCompileCommand,
 		.CompileSourceFile				= Clang_CompileSourceFile,
+		.CompileSourceFiles				= Clang_CompileSourceFiles,
+		.CompilePrecompiledHeader		= Clang_CompilePrecompiledHeader,
+		.GetModuleArgs					= Clang_GetModuleArgs,
 		.LinkIntermediateFiles			= Clang_LinkIntermediateFiles,
 		.GetCompilationCommandArchetype	= Clang_GetCompilationCommandArchetype,
 		.GetCompilerPath				= Clang_GetCompilerPath,
@@ -809,7 +1321,11 @@ void CreateCompilerBackend_GCC( compilerBackend_t *outBackend ) {
 		.data							= NULL,
 		.Init							= GCC_Init,
 		.Shutdown						= Clang_Shutdown,
+		.GetCompileCommand				= Clang_GetCompileCommand,
 		.CompileSourceFile				= Clang_CompileSourceFile,
+		.CompileSourceFiles				= Clang_CompileSourceFiles,
+		.CompilePrecompiledHeader		= Clang_CompilePrecompiledHeader,
+		.GetModuleArgs					= GCC_GetModuleArgs,
 		.LinkIntermediateFiles			= GCC_LinkIntermediateFiles,
 		.GetCompilationCommandArchetype	= Clang_GetCompilationCommandArchetype,
 		.GetCompilerPath				= Clang_GetCompilerPath,
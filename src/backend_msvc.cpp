@@ -39,6 +39,8 @@ SOFTWARE.
 #include "subprocess.h"
 #include "file.h"
 #include "temp_storage.h"
+#include "defer.h"
+#include "compile_cache.h"
 
 struct msvcState_t {
 	string_t				compilerPath;
@@ -116,6 +118,60 @@ static void MSVC_Shutdown( compilerBackend_t *backend ) {
 	backend->data = NULL;
 }
 
+// MSVC doesnt make .d files, so the compile cache gets one of our own instead with an include dependency on each line
+static bool8 MSVC_WriteDependencyFile( const char *depFilename, const std::vector<std::string> &includeDependencies ) {
+	std::string contents;
+
+	For ( u64, dependencyIndex, 0, includeDependencies.size() ) {
+		contents += includeDependencies[dependencyIndex];
+		contents += '\n';
+	}
+
+	return FS_WriteEntireFile( depFilename, contents.data(), contents.size() );
+}
+
+static void MSVC_ReadDependencyFile( const char *depFilename, std::vector<std::string> &outIncludeDependencies ) {
+	string_t depFileBuffer = {};
+
+	if ( !FS_ReadEntireFile( depFilename, &depFileBuffer ) ) {
+		s32 errorCode = GetLastErrorCode();
+		FatalError( "Failed to read \"%s\".  This should never happen! Error code: " ERROR_CODE_FORMAT "\n", depFilename, errorCode );
+		return;
+	}
+
+	defer { FS_FreeFileBuffer( &depFileBuffer ); };
+
+	const char *lineStart = depFileBuffer.data;
+	const char *bufferEnd = depFileBuffer.data + depFileBuffer.count;
+
+	while ( lineStart < bufferEnd ) {
+		const char *lineEnd = Cast( const char *, memchr( lineStart, '\n', Cast( size_t, bufferEnd - lineStart ) ) );
+
+		if ( !lineEnd ) {
+			lineEnd = bufferEnd;
+		}
+
+		if ( lineEnd > lineStart ) {
+			outIncludeDependencies.push_back( std::string( lineStart, Cast( size_t, lineEnd - lineStart ) ) );
+		}
+
+		lineStart = lineEnd + 1;
+	}
+}
+
+// /Zi and /ZI put the debug info in a PDB next to the object files that every source file in the config writes into, and the compile cache only knows about the object file
+static bool8 MSVC_UsesSharedPDB( const array_t<const char *> *args ) {
+	For ( u64, argIndex, 0, args->count ) {
+		const char *arg = args->data[argIndex];
+
+		if ( ( arg[0] == '/' || arg[0] == '-' ) && ( String_Equals( arg + 1, "Zi" ) || String_Equals( arg + 1, "ZI" ) ) ) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 static bool8 MSVC_CompileSourceFile(
 	compilerBackend_t *backend,
 	buildContext_t *buildContext,
@@ -124,7 +180,9 @@ static bool8 MSVC_CompileSourceFile(
 	const char *sourceFile,
 	bool recordCompilation,
 	u64 sourceFileIndex,
-	std::vector<std::string> *outIncludeDependencies )
+	std::vector<std::string> *outIncludeDependencies,
+	u64 *outPeakMemoryBytes,
+	bool8 *outCacheHit )
 {
 	Assert( backend );
 	Assert( sourceFile );
@@ -142,6 +200,7 @@ static bool8 MSVC_CompileSourceFile(
 	finalArgs.AddRange( &cmdArchetype.baseArgs );
 
 	const char *intermediateFile = TempPrintf( "%s%c%s.o", config->intermediateFolder.c_str(), PATH_SEPARATOR, String_Cstr( &sourceFileNoPathAndExtension ) );
+	const char *depFilename = TempPrintf( "%s%c%s.d", config->intermediateFolder.c_str(), PATH_SEPARATOR, String_Cstr( &sourceFileNoPathAndExtension ) );
 
 	// Fill up remaining arguments
 
@@ -161,28 +220,73 @@ static bool8 MSVC_CompileSourceFile(
 		procFlags = PROC_FLAG_SHOW_ARGS;
 	}
 
+	// so anything compiled with those always gets compiled for real
+	compileCache_t *compileCache = MSVC_UsesSharedPDB( &finalArgs ) ? NULL : buildContext->compileCache;
+	u64 commandHash = 0;
+
+	if ( compileCache ) {
+		commandHash = CompileCache_HashCommand( compileCache, &finalArgs );
+
+		// a forced rebuild still refreshes the cache, it just doesnt take anything out of it
+		string_t compilerOutput = {};
+		if ( !buildContext->forceRebuild && CompileCache_Restore( compileCache, commandHash, sourceFile, intermediateFile, depFilename, &compilerOutput ) ) {
+			LogVerbose( "Restored \"%s\" from the compile cache.\n", intermediateFile );
+
+			if ( procFlags & PROC_FLAG_SHOW_ARGS ) {
+				For ( u64, argIndex, 0, finalArgs.count ) {
+					printf( "%s ", finalArgs[argIndex] );
+				}
+				printf( "\n" );
+			}
+
+			// replay whatever the compiler said the first time, so warnings dont disappear just because the file came out of the cache
+			if ( compilerOutput.count > 0 ) {
+				printf( "%.*s", TruncCast( int, compilerOutput.count ), compilerOutput.data );
+			}
+
+			if ( outIncludeDependencies ) {
+				MSVC_ReadDependencyFile( depFilename, *outIncludeDependencies );
+			}
+
+			if ( recordCompilation ) {
+				RecordCompilationDatabaseEntry( buildContext, sourceFile, finalArgs, sourceFileIndex );
+			}
+
+			*outCacheHit = true;
+
+			return true;
+		}
+
+		// the object file might be a hard link into the cache, and the compiler would write straight through it and into the cache entry
+		if ( FS_FileExists( intermediateFile ) ) {
+			FS_DeleteFile( intermediateFile );
+		}
+	}
+
 	string_t processStdout = {};
-	s32 exitCode = RunProc( &finalArgs, NULL, procFlags, &processStdout );
+	s32 exitCode = RunProc( &finalArgs, NULL, procFlags, &processStdout, outPeakMemoryBytes );
 
 	// now parse the stdout
 	// all include dependencies are on their own line
 	// the line always starts with a specific prefix
+	// everything else is what the compiler actually had to say, which the compile cache keeps so it can be shown again
+	std::vector<std::string> includeDependencies;
+	std::string compilerOutput;
+
 	{
 		const char *buffer = processStdout.data;
 
 		const char *includeDependencyPrefix = "Note: including file: ";
 		const u64 includeDependencyPrefixLength = strlen( includeDependencyPrefix );
 
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wcast-qual"
-		char *lineStart = Cast( char *, buffer );
-#pragma clang diagnostic pop
+		const char *lineStart = buffer;
 
 		while ( *lineStart ) {
-			char *lineEnd = strchr( lineStart, '\n' );
+			const char *lineEnd = strchr( lineStart, '\n' );
 
+			// the last line might not end in a newline
 			if ( !lineEnd ) {
-				continue;
+				lineEnd = lineStart + strlen( lineStart );
 			}
 
 			u64 lineLength = Cast( u64, lineEnd ) - Cast( u64, lineStart );
@@ -199,14 +303,35 @@ static bool8 MSVC_CompileSourceFile(
 					bufferLine.erase( 0, 1 );
 				}
 
-				if ( outIncludeDependencies ) {
-					outIncludeDependencies->push_back( bufferLine );
-				}
+				includeDependencies.push_back( bufferLine );
 			} else {
 				printf( "%s\n", bufferLine.c_str() );
+
+				compilerOutput += bufferLine;
+				compilerOutput += '\n';
 			}
 
-			lineStart = lineEnd + 1;
+			lineStart = *lineEnd ? lineEnd + 1 : lineEnd;
+		}
+	}
+
+	if ( outIncludeDependencies ) {
+		outIncludeDependencies->insert( outIncludeDependencies->end(), includeDependencies.begin(), includeDependencies.end() );
+	}
+
+	if ( exitCode == 0 && compileCache ) {
+		const char **dependencyFilenames = Cast( const char **, Mem_TempAlloc( ( includeDependencies.size() + 1 ) * sizeof( const char * ) ) );
+		For ( u64, dependencyIndex, 0, includeDependencies.size() ) {
+			dependencyFilenames[dependencyIndex] = includeDependencies[dependencyIndex].c_str();
+		}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wcast-qual"
+		string_t compilerOutputString = { Cast( char *, compilerOutput.data() ), compilerOutput.size() };
+#pragma clang diagnostic pop
+
+		if ( !MSVC_WriteDependencyFile( depFilename, includeDependencies ) || !CompileCache_Store( compileCache, commandHash, sourceFile, dependencyFilenames, includeDependencies.size(), intermediateFile, depFilename, &compilerOutputString ) ) {
+			LogVerbose( "Failed to add \"%s\" to the compile cache.\n", intermediateFile );
 		}
 	}
 
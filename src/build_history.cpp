@@ -0,0 +1,603 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "build_history.h"
+
+#include "array.inl"
+#include "hashmap.h"
+#include "hash.h"
+#include "file.h"
+#include "string.h"
+#include "linear_allocator.h"
+#include "math.h"
+#include "debug.h"
+#include "typecast.h"
+#include "defer.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <vector>
+
+/*
+================================================================================================
+
+	Build History
+
+================================================================================================
+*/
+
+#define BUILD_HISTORY_MAGIC		0x48424642	// "BFBH"
+#define BUILD_HISTORY_VERSION	1
+
+// how many of the newest builds to compare against the ones before them when showing the trend
+#define BUILD_HISTORY_TREND_BUILDS			10
+
+// the most regressions PrintStats shows
+#define BUILD_HISTORY_MAX_REGRESSIONS_SHOWN	20
+
+struct buildHistoryHeader_t {
+	u32		magic;
+	u32		version;
+};
+
+// every build in the file starts with one of these
+// then come 'numNewNames' null terminated names ('newNamesSizeBytes' in total), which get the next name indices
+// then 'numSourceFiles' buildHistorySourceFile_t
+struct buildHistoryBuildRecord_t {
+	u64		timestamp;
+	float64	wallTimeMS;
+	float64	cpuTimeMS;
+	u64		peakMemoryBytes;
+	u32		numSourceFilesCompiled;
+	u32		numCacheHits;
+	u32		numSourceFiles;
+	u32		numNewNames;
+	u32		newNamesSizeBytes;
+	u32		succeeded;
+};
+
+static const char *CopyName( linearAllocator_t *allocator, const char *name, const u64 length ) {
+	char *copy = Cast( char *, Mem_Alloc( allocator, length + 1 ) );
+	memcpy( copy, name, length );
+	copy[length] = 0;
+
+	return copy;
+}
+
+static u32 BuildHistory_AddName( buildHistory_t *history, const char *name ) {
+	u64 nameHash = HashString( name, 0 );
+
+	u32 nameIndex = HM_GetValue( history->nameIndices, nameHash );
+
+	if ( nameIndex == HASHMAP_INVALID_VALUE ) {
+		nameIndex = TruncCast( u32, history->names.count );
+
+		history->names.Add( CopyName( history->allocator, name, strlen( name ) ) );
+		HM_SetValue( history->nameIndices, nameHash, nameIndex );
+	}
+
+	return nameIndex;
+}
+
+// drops all but the newest BUILD_HISTORY_KEEP_BUILDS builds, and any names only they used
+static void BuildHistory_DropOldBuilds( buildHistory_t *history ) {
+	Assert( history->builds.count > BUILD_HISTORY_KEEP_BUILDS );
+
+	u64 firstKeptBuild = history->builds.count - BUILD_HISTORY_KEEP_BUILDS;
+
+	array_t<const char *> oldNames = history->names;
+	array_t<buildHistoryBuild_t> oldBuilds = history->builds;
+	array_t<buildHistorySourceFile_t> oldSourceFiles = history->sourceFiles;
+
+	history->names.Init( history->allocator );
+	history->builds.Init( history->allocator );
+	history->sourceFiles.Init( history->allocator );
+	history->nameIndices = HM_Create( history->allocator, TruncCast( u32, Max( oldNames.count, Cast( u64, 64 ) ) ) );
+
+	history->builds.Reserve( BUILD_HISTORY_KEEP_BUILDS );
+
+	// names get their new indices in the order they first get used, the file relies on that
+	For ( u64, buildIndex, firstKeptBuild, oldBuilds.count ) {
+		buildHistoryBuild_t build = oldBuilds[buildIndex];
+
+		u32 firstSourceFile = build.firstSourceFile;
+
+		build.firstSourceFile = TruncCast( u32, history->sourceFiles.count );
+
+		For ( u32, sourceFileIndex, 0, build.numSourceFiles ) {
+			buildHistorySourceFile_t sourceFile = oldSourceFiles[firstSourceFile + sourceFileIndex];
+			sourceFile.nameIndex = BuildHistory_AddName( history, oldNames[sourceFile.nameIndex] );
+
+			history->sourceFiles.Add( sourceFile );
+		}
+
+		history->builds.Add( build );
+	}
+
+	history->rewrite = true;
+}
+
+void BuildHistory_Init( buildHistory_t *history, linearAllocator_t *allocator ) {
+	Assert( history );
+	Assert( allocator );
+
+	*history = {};
+
+	history->allocator = allocator;
+	history->names.Init( allocator );
+	history->nameIndices = HM_Create( allocator, 64 );
+	history->builds.Init( allocator );
+	history->sourceFiles.Init( allocator );
+}
+
+bool8 BuildHistory_Load( buildHistory_t *history, const char *filename ) {
+	Assert( history );
+	Assert( filename );
+	Assert( history->builds.count == 0 );
+
+	string_t fileBuffer = {};
+	if ( !FS_ReadEntireFile( filename, &fileBuffer ) ) {
+		return false;
+	}
+
+	defer { FS_FreeFileBuffer( &fileBuffer ); };
+
+	if ( fileBuffer.count < sizeof( buildHistoryHeader_t ) ) {
+		history->rewrite = true;
+		return false;
+	}
+
+	buildHistoryHeader_t header;
+	memcpy( &header, fileBuffer.data, sizeof( buildHistoryHeader_t ) );
+
+	// if the format changed then start again, its only history
+	if ( header.magic != BUILD_HISTORY_MAGIC || header.version != BUILD_HISTORY_VERSION ) {
+		history->rewrite = true;
+		return false;
+	}
+
+	u64 offset = sizeof( buildHistoryHeader_t );
+
+	while ( offset < fileBuffer.count ) {
+		u64 bytesLeft = fileBuffer.count - offset;
+
+		// anything thats cut short (like if Builder got killed while it was writing) gets dropped and the file gets written again without it
+		if ( bytesLeft < sizeof( buildHistoryBuildRecord_t ) ) {
+			break;
+		}
+
+		buildHistoryBuildRecord_t record;
+		memcpy( &record, fileBuffer.data + offset, sizeof( buildHistoryBuildRecord_t ) );
+
+		bytesLeft -= sizeof( buildHistoryBuildRecord_t );
+
+		u64 sourceFilesSizeBytes = Cast( u64, record.numSourceFiles ) * sizeof( buildHistorySourceFile_t );
+
+		if ( bytesLeft < Cast( u64, record.newNamesSizeBytes ) + sourceFilesSizeBytes ) {
+			break;
+		}
+
+		const char *newNames = fileBuffer.data + offset + sizeof( buildHistoryBuildRecord_t );
+		const char *newNamesEnd = newNames + record.newNamesSizeBytes;
+
+		// check everything before adding any of it
+		u32 numNewNames = 0;
+		for ( const char *name = newNames; name < newNamesEnd; name += strnlen( name, Cast( size_t, newNamesEnd - name ) ) + 1 ) {
+			numNewNames++;
+		}
+
+		if ( numNewNames != record.numNewNames || ( record.newNamesSizeBytes > 0 && newNamesEnd[-1] != 0 ) ) {
+			break;
+		}
+
+		const buildHistorySourceFile_t *sourceFiles = Cast( const buildHistorySourceFile_t *, Cast( const void *, newNamesEnd ) );
+
+		bool8 valid = true;
+		For ( u32, sourceFileIndex, 0, record.numSourceFiles ) {
+			buildHistorySourceFile_t sourceFile;
+			memcpy( &sourceFile, &sourceFiles[sourceFileIndex], sizeof( buildHistorySourceFile_t ) );
+
+			if ( sourceFile.nameIndex >= history->names.count + numNewNames ) {
+				valid = false;
+				break;
+			}
+		}
+
+		if ( !valid ) {
+			break;
+		}
+
+		for ( const char *name = newNames; name < newNamesEnd; ) {
+			u64 length = strlen( name );
+
+			HM_SetValue( history->nameIndices, HashString( name, 0 ), TruncCast( u32, history->names.count ) );
+			history->names.Add( CopyName( history->allocator, name, length ) );
+
+			name += length + 1;
+		}
+
+		buildHistoryBuild_t build = {
+			.timestamp				= record.timestamp,
+			.wallTimeMS				= record.wallTimeMS,
+			.cpuTimeMS				= record.cpuTimeMS,
+			.peakMemoryBytes		= record.peakMemoryBytes,
+			.numSourceFilesCompiled	= record.numSourceFilesCompiled,
+			.numCacheHits			= record.numCacheHits,
+			.succeeded				= record.succeeded != 0,
+			.firstSourceFile		= TruncCast( u32, history->sourceFiles.count ),
+			.numSourceFiles			= record.numSourceFiles,
+		};
+
+		history->builds.Add( build );
+
+		if ( record.numSourceFiles > 0 ) {
+			history->sourceFiles.Resize( history->sourceFiles.count + record.numSourceFiles );
+			memcpy( &history->sourceFiles[build.firstSourceFile], sourceFiles, sourceFilesSizeBytes );
+		}
+
+		offset += sizeof( buildHistoryBuildRecord_t ) + record.newNamesSizeBytes + sourceFilesSizeBytes;
+	}
+
+	if ( offset != fileBuffer.count ) {
+		Warning( "The end of the build history \"%s\" is broken, so it'll get dropped.\n", filename );
+		history->rewrite = true;
+	}
+
+	history->numBuildsSaved = TruncCast( u32, history->builds.count );
+	history->numNamesSaved = TruncCast( u32, history->names.count );
+	history->savedSizeBytes = offset;
+
+	return true;
+}
+
+void BuildHistory_AddBuild( buildHistory_t *history, const buildHistoryBuild_t *build ) {
+	Assert( history );
+	Assert( build );
+
+	buildHistoryBuild_t newBuild = *build;
+	newBuild.firstSourceFile = TruncCast( u32, history->sourceFiles.count );
+	newBuild.numSourceFiles = 0;
+
+	history->builds.Add( newBuild );
+}
+
+void BuildHistory_AddSourceFile( buildHistory_t *history, const char *name, const float64 compileTimeMS, const float64 cpuTimeMS, const u32 peakMemoryMB, const bool8 cacheHit ) {
+	Assert( history );
+	Assert( name );
+	Assert( history->builds.count > 0 );
+
+	buildHistorySourceFile_t sourceFile = {
+		.nameIndex		= BuildHistory_AddName( history, name ),
+		.compileTimeMS	= Cast( float32, compileTimeMS ),
+		.cpuTimeMS		= Cast( float32, cpuTimeMS ),
+		.peakMemoryMB	= peakMemoryMB,
+		.cacheHit		= cacheHit ? 1U : 0U,
+	};
+
+	history->sourceFiles.Add( sourceFile );
+
+	history->builds[history->builds.count - 1].numSourceFiles++;
+}
+
+bool8 BuildHistory_Save( buildHistory_t *history, const char *filename ) {
+	Assert( history );
+	Assert( filename );
+
+	if ( history->builds.count > BUILD_HISTORY_MAX_BUILDS ) {
+		BuildHistory_DropOldBuilds( history );
+	}
+
+	if ( history->numBuildsSaved == 0 ) {
+		history->rewrite = true;
+	}
+
+	if ( history->rewrite ) {
+		history->numBuildsSaved = 0;
+		history->numNamesSaved = 0;
+		history->savedSizeBytes = 0;
+	}
+
+	if ( history->numBuildsSaved == history->builds.count ) {
+		return true;
+	}
+
+	std::vector<u8> buffer;
+
+	if ( history->rewrite ) {
+		buildHistoryHeader_t header = {
+			.magic		= BUILD_HISTORY_MAGIC,
+			.version	= BUILD_HISTORY_VERSION,
+		};
+
+		buffer.insert( buffer.end(), Cast( const u8 *, Cast( const void *, &header ) ), Cast( const u8 *, Cast( const void *, &header ) ) + sizeof( header ) );
+	}
+
+	u32 numNamesWritten = history->numNamesSaved;
+
+	For ( u64, buildIndex, history->numBuildsSaved, history->builds.count ) {
+		const buildHistoryBuild_t *build = &history->builds[buildIndex];
+		const buildHistorySourceFile_t *sourceFiles = history->sourceFiles.data + build->firstSourceFile;
+
+		// names get their indices in the order they first get used, so any this build uses that arent in the file yet come straight after the ones that are
+		u32 numNames = numNamesWritten;
+		For ( u32, sourceFileIndex, 0, build->numSourceFiles ) {
+			numNames = Max( numNames, sourceFiles[sourceFileIndex].nameIndex + 1 );
+		}
+
+		u64 newNamesSizeBytes = 0;
+		For ( u32, nameIndex, numNamesWritten, numNames ) {
+			newNamesSizeBytes += strlen( history->names[nameIndex] ) + 1;
+		}
+
+		buildHistoryBuildRecord_t record = {
+			.timestamp				= build->timestamp,
+			.wallTimeMS				= build->wallTimeMS,
+			.cpuTimeMS				= build->cpuTimeMS,
+			.peakMemoryBytes		= build->peakMemoryBytes,
+			.numSourceFilesCompiled	= build->numSourceFilesCompiled,
+			.numCacheHits			= build->numCacheHits,
+			.numSourceFiles			= build->numSourceFiles,
+			.numNewNames			= numNames - numNamesWritten,
+			.newNamesSizeBytes		= TruncCast( u32, newNamesSizeBytes ),
+			.succeeded				= build->succeeded ? 1U : 0U,
+		};
+
+		buffer.insert( buffer.end(), Cast( const u8 *, Cast( const void *, &record ) ), Cast( const u8 *, Cast( const void *, &record ) ) + sizeof( record ) );
+
+		For ( u32, nameIndex, numNamesWritten, numNames ) {
+			const char *name = history->names[nameIndex];
+			buffer.insert( buffer.end(), Cast( const u8 *, Cast( const void *, name ) ), Cast( const u8 *, Cast( const void *, name ) ) + strlen( name ) + 1 );
+		}
+
+		if ( build->numSourceFiles > 0 ) {
+			buffer.insert( buffer.end(), Cast( const u8 *, Cast( const void *, sourceFiles ) ), Cast( const u8 *, Cast( const void *, sourceFiles ) ) + build->numSourceFiles * sizeof( buildHistorySourceFile_t ) );
+		}
+
+		numNamesWritten = numNames;
+	}
+
+	file_t file = FS_OpenOrCreateFile( filename, !history->rewrite );
+
+	if ( file.handle == INVALID_FILE_HANDLE ) {
+		s32 errorCode = GetLastErrorCode();
+		Error( "Failed to open file \"%s\" for writing.  Error code: " ERROR_CODE_FORMAT ".\n", filename, errorCode );
+		return false;
+	}
+
+	defer { FS_CloseFile( &file ); };
+
+	if ( !FS_WriteFile( &file, buffer.data(), history->savedSizeBytes, buffer.size() ) ) {
+		s32 errorCode = GetLastErrorCode();
+		Error( "Failed to write file \"%s\".  Error code: " ERROR_CODE_FORMAT ".\n", filename, errorCode );
+		return false;
+	}
+
+	history->numBuildsSaved = TruncCast( u32, history->builds.count );
+	history->numNamesSaved = numNamesWritten;
+	history->savedSizeBytes += buffer.size();
+	history->rewrite = false;
+
+	return true;
+}
+
+static int CompareFloats( const void *a, const void *b ) {
+	float32 floatA = *Cast( const float32 *, a );
+	float32 floatB = *Cast( const float32 *, b );
+
+	if ( floatA != floatB ) return ( floatA < floatB ) ? -1 : 1;
+
+	return 0;
+}
+
+static int CompareRegressions( const void *a, const void *b ) {
+	const buildHistoryRegression_t *regressionA = Cast( const buildHistoryRegression_t *, a );
+	const buildHistoryRegression_t *regressionB = Cast( const buildHistoryRegression_t *, b );
+
+	float64 growthA = regressionA->compileTimeMS - regressionA->medianMS;
+	float64 growthB = regressionB->compileTimeMS - regressionB->medianMS;
+
+	if ( growthA != growthB ) return ( growthA > growthB ) ? -1 : 1;
+
+	return Cast( int, regressionA->nameIndex ) - Cast( int, regressionB->nameIndex );
+}
+
+void BuildHistory_FindRegressions( const buildHistory_t *history, const float64 thresholdPercent, array_t<buildHistoryRegression_t> *outRegressions ) {
+	Assert( history );
+	Assert( outRegressions );
+
+	// every time each source file actually compiled, oldest first
+	std::vector<std::vector<float32>> compileTimes;
+	compileTimes.resize( history->names.count );
+
+	For ( u64, sourceFileIndex, 0, history->sourceFiles.count ) {
+		const buildHistorySourceFile_t *sourceFile = &history->sourceFiles[sourceFileIndex];
+
+		if ( !sourceFile->cacheHit ) {
+			compileTimes[sourceFile->nameIndex].push_back( sourceFile->compileTimeMS );
+		}
+	}
+
+	For ( u64, nameIndex, 0, compileTimes.size() ) {
+		std::vector<float32> &times = compileTimes[nameIndex];
+
+		if ( times.size() < BUILD_HISTORY_MIN_SAMPLES + 1 ) {
+			continue;
+		}
+
+		float32 newestMS = times.back();
+
+		// only the ones just before the newest one, so whats normal can change over time
+		u64 numSamples = Min( Cast( u64, times.size() - 1 ), Cast( u64, BUILD_HISTORY_MEDIAN_WINDOW ) );
+
+		float32 *samples = &times[times.size() - 1 - numSamples];
+		qsort( samples, numSamples, sizeof( float32 ), CompareFloats );
+
+		float64 medianMS = ( numSamples % 2 == 1 ) ? samples[numSamples / 2] : ( samples[numSamples / 2 - 1] + samples[numSamples / 2] ) * 0.5;
+
+		if ( newestMS - medianMS <= BUILD_HISTORY_MIN_REGRESSION_MS || newestMS <= medianMS * ( 1.0 + thresholdPercent / 100.0 ) ) {
+			continue;
+		}
+
+		outRegressions->Add( {
+			.nameIndex		= TruncCast( u32, nameIndex ),
+			.compileTimeMS	= newestMS,
+			.medianMS		= medianMS,
+			.numSamples		= TruncCast( u32, numSamples ),
+		} );
+	}
+
+	if ( outRegressions->count > 1 ) {
+		qsort( outRegressions->data, outRegressions->count, sizeof( buildHistoryRegression_t ), CompareRegressions );
+	}
+}
+
+// the average compile time of every source file that actually compiled in the given builds
+// returns false if none did
+static bool8 GetAverageCompileTime( const buildHistory_t *history, const u64 firstBuild, const u64 lastBuild, float64 *outAverageMS, u32 *outNumBuilds ) {
+	float64 totalMS = 0.0;
+	u64 numCompiled = 0;
+	u32 numBuilds = 0;
+
+	For ( u64, buildIndex, firstBuild, lastBuild ) {
+		const buildHistoryBuild_t *build = &history->builds[buildIndex];
+
+		bool8 compiledAny = false;
+
+		For ( u32, sourceFileIndex, 0, build->numSourceFiles ) {
+			const buildHistorySourceFile_t *sourceFile = &history->sourceFiles[build->firstSourceFile + sourceFileIndex];
+
+			if ( sourceFile->cacheHit ) {
+				continue;
+			}
+
+			totalMS += sourceFile->compileTimeMS;
+			numCompiled++;
+			compiledAny = true;
+		}
+
+		if ( compiledAny ) {
+			numBuilds++;
+		}
+	}
+
+	if ( numCompiled == 0 ) {
+		return false;
+	}
+
+	*outAverageMS = totalMS / Cast( float64, numCompiled );
+	*outNumBuilds = numBuilds;
+
+	return true;
+}
+
+void BuildHistory_PrintStats( const buildHistory_t *history, const u32 maxBuilds, const float64 thresholdPercent ) {
+	Assert( history );
+
+	printf( "Build history:\n" );
+
+	if ( history->builds.count == 0 ) {
+		printf( "    No builds have been recorded yet.\n\n" );
+		return;
+	}
+
+	u64 firstShownBuild = history->builds.count - Min( history->builds.count, Cast( u64, maxBuilds ) );
+
+	printf( "    The last %" PRIu64 " of %" PRIu64 " builds:\n", history->builds.count - firstShownBuild, history->builds.count );
+	printf( "        %-16s  %-6s  %12s  %12s  %5s  %9s  %8s  %10s\n", "date", "result", "wall time", "CPU time", "cores", "peak mem", "compiled", "cache hits" );
+
+	For ( u64, buildIndex, firstShownBuild, history->builds.count ) {
+		const buildHistoryBuild_t *build = &history->builds[buildIndex];
+
+		char date[32] = "?";
+
+		time_t timestamp = Cast( time_t, build->timestamp );
+		const struct tm *localTime = localtime( &timestamp );
+		if ( localTime ) {
+			strftime( date, sizeof( date ), "%Y-%m-%d %H:%M", localTime );
+		}
+
+		// how many cores were busy on average
+		float64 cores = ( build->wallTimeMS > 0.0 ) ? build->cpuTimeMS / build->wallTimeMS : 0.0;
+
+		printf( "        %-16s  %-6s  %9.0f ms  %9.0f ms  %5.1f  %6" PRIu64 " MB  %8u  %10u\n", date, build->succeeded ? "ok" : "failed", build->wallTimeMS, build->cpuTimeMS, cores, build->peakMemoryBytes / ( 1024 * 1024 ), build->numSourceFilesCompiled, build->numCacheHits );
+	}
+
+	// how long a source file takes to compile doesnt depend on how many of them needed compiling, so thats the trend worth showing
+	u64 trendStart = history->builds.count - Min( history->builds.count, Cast( u64, BUILD_HISTORY_TREND_BUILDS ) );
+	u64 previousTrendStart = trendStart - Min( trendStart, Cast( u64, BUILD_HISTORY_TREND_BUILDS ) );
+
+	float64 recentAverageMS = 0.0;
+	float64 previousAverageMS = 0.0;
+	u32 numRecentBuilds = 0;
+	u32 numPreviousBuilds = 0;
+
+	if ( GetAverageCompileTime( history, trendStart, history->builds.count, &recentAverageMS, &numRecentBuilds ) ) {
+		printf( "\n    Each source file took %.0f ms to compile on average over the last %" PRIu64 " builds", recentAverageMS, history->builds.count - trendStart );
+
+		if ( GetAverageCompileTime( history, previousTrendStart, trendStart, &previousAverageMS, &numPreviousBuilds ) ) {
+			float64 changePercent = ( ( recentAverageMS - previousAverageMS ) / previousAverageMS ) * 100.0;
+
+			printf( ", compared to %.0f ms over the %" PRIu64 " before that (%+.0f%%).\n", previousAverageMS, trendStart - previousTrendStart, changePercent );
+		} else {
+			printf( ".\n" );
+		}
+	}
+
+	array_t<buildHistoryRegression_t> regressions;
+	regressions.Init( history->allocator );
+
+	BuildHistory_FindRegressions( history, thresholdPercent, &regressions );
+
+	if ( regressions.count == 0 ) {
+		printf( "\n    No source files have got more than %.0f%% slower to compile than they normally are.\n\n", thresholdPercent );
+		return;
+	}
+
+	printf( "\n    Source files that took more than %.0f%% longer to compile last time than they normally do:\n", thresholdPercent );
+	printf( "        %12s  %12s  %7s\n", "last time", "normally", "change" );
+
+	u64 numShown = Min( regressions.count, Cast( u64, BUILD_HISTORY_MAX_REGRESSIONS_SHOWN ) );
+
+	For ( u64, regressionIndex, 0, numShown ) {
+		const buildHistoryRegression_t *regression = &regressions[regressionIndex];
+
+		float64 changePercent = ( ( regression->compileTimeMS - regression->medianMS ) / regression->medianMS ) * 100.0;
+
+		printf( "        %9.0f ms  %9.0f ms  %+6.0f%%  %s\n", regression->compileTimeMS, regression->medianMS, changePercent, history->names[regression->nameIndex] );
+	}
+
+	if ( regressions.count > numShown ) {
+		printf( "        ... and %" PRIu64 " more.\n", regressions.count - numShown );
+	}
+
+	printf( "\n    \"Normally\" is the median of up to %u of the times each one compiled before that, not counting cache hits.\n\n", BUILD_HISTORY_MEDIAN_WINDOW );
+}
@@ -0,0 +1,148 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "array.h"
+
+struct hashmap_t;
+struct linearAllocator_t;
+
+/*
+================================================================================================
+
+	Build History
+
+	Remembers how long every build took, how much CPU time and memory it used, and how long
+	each source file it compiled took, so that a source file (or the whole build) slowly
+	getting slower doesn't go unnoticed.
+
+	On disk it's a log that only ever gets appended to.  Every build is one fixed size record,
+	then the names of any source files the log hasn't seen before, then one small record for
+	each source file that compiled.  Source files refer to their names by index, so each name
+	is only stored once.  Builds where nothing needed compiling only cost one record.
+
+	Once the log has more than BUILD_HISTORY_MAX_BUILDS builds in it, the oldest ones get
+	dropped and the whole thing gets written again.
+
+	Not thread-safe.
+
+================================================================================================
+*/
+
+// how many builds the log can hold before the oldest ones get dropped
+#define BUILD_HISTORY_MAX_BUILDS			512
+
+// how many of the newest builds are kept when that happens
+#define BUILD_HISTORY_KEEP_BUILDS			256
+
+// how many of a source file's previous compile times its newest one gets compared against
+#define BUILD_HISTORY_MEDIAN_WINDOW			10
+
+// a source file needs to have compiled at least this many times before to know what's normal for it
+#define BUILD_HISTORY_MIN_SAMPLES			3
+
+// source files that only got this much slower (or less) don't count as getting slower, no matter the percentage
+// otherwise every tiny source file that took 2 ms instead of 1 ms would get flagged
+#define BUILD_HISTORY_MIN_REGRESSION_MS		50.0
+
+// Stored on disk exactly like this.
+struct buildHistorySourceFile_t {
+	u32		nameIndex;		// index into buildHistory_t::names
+	float32	compileTimeMS;
+	float32	cpuTimeMS;
+	u32		peakMemoryMB;
+	u32		cacheHit;		// the outputs came out of the compile cache, so the times and memory are meaningless
+};
+
+struct buildHistoryBuild_t {
+	u64		timestamp;		// seconds since 1970
+	float64	wallTimeMS;
+	float64	cpuTimeMS;		// Builder itself and every process it ran
+	u64		peakMemoryBytes;	// the most any one compile used
+	u32		numSourceFilesCompiled;	// not counting cache hits
+	u32		numCacheHits;
+	bool8	succeeded;
+
+	// this build's source files, filled out by BuildHistory_AddSourceFile()
+	u32		firstSourceFile;	// index into buildHistory_t::sourceFiles
+	u32		numSourceFiles;
+};
+
+struct buildHistory_t {
+	linearAllocator_t					*allocator;
+
+	array_t<const char *>				names;
+	hashmap_t							*nameIndices;	// keyed by HashString() of the name
+
+	// oldest first
+	array_t<buildHistoryBuild_t>		builds;
+	array_t<buildHistorySourceFile_t>	sourceFiles;
+
+	// how much of the history is in the file already
+	u32									numBuildsSaved;
+	u32									numNamesSaved;
+	u64									savedSizeBytes;
+
+	// the file needs writing again from scratch, instead of just adding the new builds to the end
+	bool8								rewrite;
+};
+
+// A source file that took quite a bit longer to compile the last time it compiled than it normally does.
+struct buildHistoryRegression_t {
+	u32		nameIndex;
+	float64	compileTimeMS;	// the newest one
+	float64	medianMS;		// of the ones before that
+	u32		numSamples;		// how many went into the median
+};
+
+void	BuildHistory_Init( buildHistory_t *history, linearAllocator_t *allocator );
+
+// Reads the history from the given file.
+// Returns true if there was a history to read, otherwise returns false and leaves the history empty.
+// It's fine for this to fail (first build, after you nuke the .builder folder, or if the file was written by a different version of Builder).
+bool8	BuildHistory_Load( buildHistory_t *history, const char *filename );
+
+// Adds a new build to the end of the history.  'build->firstSourceFile' and 'build->numSourceFiles' get ignored.
+void	BuildHistory_AddBuild( buildHistory_t *history, const buildHistoryBuild_t *build );
+
+// Adds a source file that compiled to the newest build.
+void	BuildHistory_AddSourceFile( buildHistory_t *history, const char *name, const float64 compileTimeMS, const float64 cpuTimeMS, const u32 peakMemoryMB, const bool8 cacheHit );
+
+// Writes any builds that have been added since loading to the end of the given file.
+// Rewrites the whole file instead if it was broken, or if there are too many builds in it now.
+// Returns true if successful, otherwise returns false.
+bool8	BuildHistory_Save( buildHistory_t *history, const char *filename );
+
+// Finds every source file whose newest compile time (not counting cache hits) is more than 'thresholdPercent' percent slower than the median of the ones before it.
+// The ones that got the most slower come first.
+void	BuildHistory_FindRegressions( const buildHistory_t *history, const float64 thresholdPercent, array_t<buildHistoryRegression_t> *outRegressions );
+
+// Prints the newest 'maxBuilds' builds, how the time each source file takes to compile is trending, and any regressions (see BuildHistory_FindRegressions()).
+void	BuildHistory_PrintStats( const buildHistory_t *history, const u32 maxBuilds, const float64 thresholdPercent );
@@ -0,0 +1,304 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "build_trace.h"
+
+#include "job_pool.h"
+#include "thread.h"
+#include "timer.h"
+#include "string.h"
+#include "string_builder.h"
+#include "debug.h"
+#include "typecast.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+================================================================================================
+
+	Build trace
+
+================================================================================================
+*/
+
+enum buildTraceEventType_t {
+	BUILD_TRACE_EVENT_TYPE_SPAN	= 0,
+	BUILD_TRACE_EVENT_TYPE_COUNTER,
+};
+
+// the strings are offsets into buildTrace_t::strings, because that moves whenever it grows
+// BUILD_TRACE_NO_STRING if theres no string
+struct buildTraceEvent_t {
+	buildTraceEventType_t	type;
+	u32						threadID;
+	float64					timestampUS;
+	float64					durationUS;
+	u64						category;
+	u64						name;
+	u64						detail;
+	u32						numJobsQueued;
+	u32						numJobsRunning;
+};
+
+#define BUILD_TRACE_NO_STRING	U64_MAX
+
+struct buildTrace_t {
+	mutex_t				mutex;
+
+	float64				startUS;
+
+	buildTraceEvent_t	*events;
+	u64					numEvents;
+	u64					maxEvents;
+
+	char				*strings;
+	u64					stringsLength;
+	u64					maxStringsLength;
+
+	atomic32_t			numThreads;
+};
+
+static buildTrace_t				*g_buildTrace = NULL;
+
+// 0 if this thread hasnt recorded anything yet
+// the thread that started the trace is always 1
+static THREAD_LOCAL u32			g_buildTraceThreadID = 0;
+
+static u32 BuildTrace_GetThreadID( buildTrace_t *trace ) {
+	if ( g_buildTraceThreadID == 0 ) {
+		g_buildTraceThreadID = Thread_AtomicIncrement( &trace->numThreads );
+	}
+
+	return g_buildTraceThreadID;
+}
+
+// only call this while holding the mutex
+static u64 BuildTrace_AddString( buildTrace_t *trace, const char *string ) {
+	if ( !string ) {
+		return BUILD_TRACE_NO_STRING;
+	}
+
+	u64 length = strlen( string ) + 1;
+
+	if ( trace->stringsLength + length > trace->maxStringsLength ) {
+		while ( trace->stringsLength + length > trace->maxStringsLength ) {
+			trace->maxStringsLength *= 2;
+		}
+
+		trace->strings = Cast( char *, realloc( trace->strings, trace->maxStringsLength ) );
+	}
+
+	u64 offset = trace->stringsLength;
+
+	memcpy( trace->strings + offset, string, length );
+	trace->stringsLength += length;
+
+	return offset;
+}
+
+// only call this while holding the mutex
+static buildTraceEvent_t *BuildTrace_AddEvent( buildTrace_t *trace ) {
+	if ( trace->numEvents == trace->maxEvents ) {
+		trace->maxEvents *= 2;
+		trace->events = Cast( buildTraceEvent_t *, realloc( trace->events, trace->maxEvents * sizeof( buildTraceEvent_t ) ) );
+	}
+
+	return &trace->events[trace->numEvents++];
+}
+
+static int CompareEventsByTimestamp( const void *a, const void *b ) {
+	const buildTraceEvent_t *eventA = Cast( const buildTraceEvent_t *, a );
+	const buildTraceEvent_t *eventB = Cast( const buildTraceEvent_t *, b );
+
+	if ( eventA->timestampUS != eventB->timestampUS ) return ( eventA->timestampUS < eventB->timestampUS ) ? -1 : 1;
+
+	// spans that start at the same time as each other need the outer one first, otherwise they wont nest
+	if ( eventA->durationUS != eventB->durationUS ) return ( eventA->durationUS > eventB->durationUS ) ? -1 : 1;
+
+	return 0;
+}
+
+void BuildTrace_Init() {
+	Assert( !g_buildTrace );
+
+	buildTrace_t *trace = Cast( buildTrace_t *, malloc( sizeof( buildTrace_t ) ) );
+	memset( trace, 0, sizeof( buildTrace_t ) );
+
+	trace->mutex = Mutex_Create();
+	trace->startUS = Time_US();
+
+	trace->maxEvents = 1024;
+	trace->events = Cast( buildTraceEvent_t *, malloc( trace->maxEvents * sizeof( buildTraceEvent_t ) ) );
+
+	trace->maxStringsLength = 64 * 1024;
+	trace->strings = Cast( char *, malloc( trace->maxStringsLength ) );
+
+	g_buildTrace = trace;
+
+	// so the thread that started the trace is the first one
+	g_buildTraceThreadID = 0;
+	BuildTrace_GetThreadID( trace );
+}
+
+void BuildTrace_Shutdown() {
+	buildTrace_t *trace = g_buildTrace;
+
+	if ( !trace ) {
+		return;
+	}
+
+	Mutex_Destroy( &trace->mutex );
+
+	free( trace->strings );
+	free( trace->events );
+	free( trace );
+
+	g_buildTrace = NULL;
+}
+
+bool8 BuildTrace_IsRunning() {
+	return g_buildTrace != NULL;
+}
+
+buildTraceSpan_t BuildTrace_BeginSpan( const char *category, const char *name ) {
+	buildTrace_t *trace = g_buildTrace;
+
+	if ( !trace ) {
+		return {};
+	}
+
+	Assert( category );
+	Assert( name );
+
+	return {
+		.category		= category,
+		.name			= name,
+		.startUS		= Time_US() - trace->startUS,
+		.numJobsQueued	= JobPool_GetNumJobsQueued(),
+		.numJobsRunning	= JobPool_GetNumJobsRunning(),
+	};
+}
+
+void BuildTrace_EndSpan( const buildTraceSpan_t *span, const char *detail ) {
+	Assert( span );
+
+	buildTrace_t *trace = g_buildTrace;
+
+	if ( !trace || !span->category ) {
+		return;
+	}
+
+	float64 endUS = Time_US() - trace->startUS;
+
+	u32 numJobsQueued = JobPool_GetNumJobsQueued();
+	u32 numJobsRunning = JobPool_GetNumJobsRunning();
+
+	u32 threadID = BuildTrace_GetThreadID( trace );
+
+	Mutex_Lock( &trace->mutex );
+
+	buildTraceEvent_t *event = BuildTrace_AddEvent( trace );
+	event->type = BUILD_TRACE_EVENT_TYPE_SPAN;
+	event->threadID = threadID;
+	event->timestampUS = span->startUS;
+	event->durationUS = endUS - span->startUS;
+	event->category = BuildTrace_AddString( trace, span->category );
+	event->name = BuildTrace_AddString( trace, span->name );
+	event->detail = BuildTrace_AddString( trace, detail );
+	event->numJobsQueued = span->numJobsQueued;
+	event->numJobsRunning = span->numJobsRunning;
+
+	// the counters at both ends of the span, so the counter track changes at the same time the spans do
+	event = BuildTrace_AddEvent( trace );
+	*event = { .type = BUILD_TRACE_EVENT_TYPE_COUNTER, .timestampUS = span->startUS, .numJobsQueued = span->numJobsQueued, .numJobsRunning = span->numJobsRunning };
+
+	event = BuildTrace_AddEvent( trace );
+	*event = { .type = BUILD_TRACE_EVENT_TYPE_COUNTER, .timestampUS = endUS, .numJobsQueued = numJobsQueued, .numJobsRunning = numJobsRunning };
+
+	Mutex_Unlock( &trace->mutex );
+}
+
+void BuildTrace_WriteJSON( stringBuilder_t *sb ) {
+	Assert( sb );
+
+	buildTrace_t *trace = g_buildTrace;
+
+	SB_Appendf( sb, "{\n\t\"displayTimeUnit\": \"ms\",\n\t\"traceEvents\": [\n" );
+
+	if ( trace ) {
+		Mutex_Lock( &trace->mutex );
+
+		u32 numThreads = Thread_AtomicLoad( &trace->numThreads );
+
+		For ( u32, threadID, 1, numThreads + 1 ) {
+			SB_Appendf( sb, "\t\t{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": { \"name\": ", threadID );
+			SB_AppendJSONString( sb, ( threadID == 1 ) ? "Main thread" : TempPrintf( "Worker thread %u", threadID - 1 ) );
+			SB_Appendf( sb, " } },\n" );
+
+			// keep the main thread at the top
+			SB_Appendf( sb, "\t\t{ \"name\": \"thread_sort_index\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": { \"sort_index\": %u } },\n", threadID, threadID );
+		}
+
+		qsort( trace->events, trace->numEvents, sizeof( buildTraceEvent_t ), CompareEventsByTimestamp );
+
+		For ( u64, eventIndex, 0, trace->numEvents ) {
+			const buildTraceEvent_t *event = &trace->events[eventIndex];
+
+			switch ( event->type ) {
+				case BUILD_TRACE_EVENT_TYPE_SPAN: {
+					SB_Appendf( sb, "\t\t{ \"name\": " );
+					SB_AppendJSONString( sb, trace->strings + event->name );
+					SB_Appendf( sb, ", \"cat\": " );
+					SB_AppendJSONString( sb, trace->strings + event->category );
+					SB_Appendf( sb, ", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %u, \"args\": { ", event->timestampUS, event->durationUS, event->threadID );
+
+					if ( event->detail != BUILD_TRACE_NO_STRING ) {
+						SB_Appendf( sb, "\"detail\": " );
+						SB_AppendJSONString( sb, trace->strings + event->detail );
+						SB_Appendf( sb, ", " );
+					}
+
+					SB_Appendf( sb, "\"jobs queued\": %u, \"jobs running\": %u } },\n", event->numJobsQueued, event->numJobsRunning );
+				} break;
+
+				case BUILD_TRACE_EVENT_TYPE_COUNTER: {
+					SB_Appendf( sb, "\t\t{ \"name\": \"Jobs\", \"ph\": \"C\", \"ts\": %.3f, \"pid\": 1, \"args\": { \"queued\": %u, \"running\": %u } },\n", event->timestampUS, event->numJobsQueued, event->numJobsRunning );
+				} break;
+			}
+		}
+
+		Mutex_Unlock( &trace->mutex );
+	}
+
+	// JSON doesnt allow a comma after the last element, so finish with one that doesnt need one
+	SB_Appendf( sb, "\t\t{ \"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": { \"name\": \"Builder\" } }\n" );
+
+	SB_Appendf( sb, "\t]\n}\n" );
+}
@@ -0,0 +1,84 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+
+struct stringBuilder_t;
+
+/*
+================================================================================================
+
+	Build trace
+
+	Records where the time went across the whole build (the user config build, running
+	SetBuilderOptions, globbing, every compile and link, and so on) so it can be written out
+	in Chrome's trace event format and opened in Perfetto or chrome://tracing.  That makes it
+	easy to see when cores were sitting idle and what the rest of the build was waiting on.
+
+	Every span goes on the thread that ran it.  Each span also remembers how many jobs were
+	waiting in the job pool and how many were running when it started, and those get written
+	as a counter track too.
+
+	Nothing gets recorded unless BuildTrace_Init() has been called, so the spans can stay in
+	the code for every build and cost next to nothing.
+
+================================================================================================
+*/
+
+struct buildTraceSpan_t {
+	const char	*category;	// NULL if the trace isnt running
+	const char	*name;
+	float64		startUS;
+
+	// what the job pool was doing when the span started
+	u32			numJobsQueued;
+	u32			numJobsRunning;
+};
+
+// Starts recording.  Timestamps in the trace are relative to when this gets called.
+void				BuildTrace_Init();
+
+// Stops recording and frees everything that got recorded.
+void				BuildTrace_Shutdown();
+
+// Returns true if BuildTrace_Init() has been called and BuildTrace_Shutdown() hasn't been yet.
+bool8				BuildTrace_IsRunning();
+
+// Starts a span on the calling thread.  'category' and 'name' must stay valid until BuildTrace_EndSpan().
+// Thread-safe.
+buildTraceSpan_t	BuildTrace_BeginSpan( const char *category, const char *name );
+
+// Ends a span from BuildTrace_BeginSpan() and adds it to the trace.
+// 'detail' is optional and gets shown alongside the span if it isn't NULL.
+// Must be called on the same thread that started the span.  Thread-safe.
+void				BuildTrace_EndSpan( const buildTraceSpan_t *span, const char *detail = NULL );
+
+// Appends everything recorded so far to 'sb' in Chrome's trace event format.
+void				BuildTrace_WriteJSON( stringBuilder_t *sb );
@@ -47,6 +47,22 @@ SOFTWARE.
 #include "defer.h"
 #include "thread.h"
 #include "os.h"
+#include "file_hash_cache.h"
+#include "file_stat_memo.h"
+#include "include_dependency_db.h"
+#include "job_pool.h"
+#include "jobserver.h"
+#include "memory_throttle.h"
+#include "compile_cache.h"
+#include "cache_server.h"
+#include "pch_advisor.h"
+#include "unity_build.h"
+#include "module_scanner.h"
+#include "time_trace.h"
+#include "header_impact.h"
+#include "build_history.h"
+#include "build_trace.h"
+#include "critical_path.h"
 
 #ifdef _WIN64
 #include <Shlwapi.h>
@@ -57,6 +73,7 @@ SOFTWARE.
 #include <stdio.h>
 #include <stdarg.h>
 #include <inttypes.h>
+#include <time.h>
 
 /*
 =============================================================================
@@ -133,6 +150,8 @@ bool8 FileIsSourceFile( const char *filename ) {
 		".cxx",
 		".cc",
 		".c",
+		".cppm",
+		".ixx",
 	};
 
 	For ( u64, extensionIndex, 0, COUNT_OF( fileExtensions ) ) {
@@ -246,7 +265,9 @@ static const char *BuildConfig_ToString( const BuildConfig *config, linearAlloca
 	PrintSTDStringArray( "ignoreWarnings", config->ignoreWarnings );
 	PrintSTDStringArray( "additionalCompilerArguments", config->additionalCompilerArguments );
 	PrintSTDStringArray( "additionalLinkerArguments", config->additionalLinkerArguments );
+	PrintSTDStringArray( "unityExcludedFiles", config->unityExcludedFiles );
 
+	PrintField( "precompiledHeader", config->precompiledHeader.c_str() );
 	PrintField( "binaryName", config->binaryName.c_str() );
 	PrintField( "binaryFolder", config->binaryFolder.c_str() );
 	PrintField( "intermediateFolder", config->intermediateFolder.c_str() );
@@ -256,6 +277,11 @@ static const char *BuildConfig_ToString( const BuildConfig *config, linearAlloca
 	PrintField( "removeSymbols", config->removeSymbols ? "true" : "false" );
 	PrintField( "removeFileExtension", config->removeFileExtension ? "true" : "false" );
 	PrintField( "warningsAsErrors", config->warningsAsErrors ? "true" : "false" );
+	PrintField( "automaticPrecompiledHeader", config->automaticPrecompiledHeader ? "true" : "false" );
+	PrintField( "unityBuild", config->unityBuild ? "true" : "false" );
+	PrintField( "unityBatchSize", TempPrintf( "%u", config->unityBatchSize ) );
+	PrintField( "batchSmallSourceFiles", config->batchSmallSourceFiles ? "true" : "false" );
+	PrintField( "cppModules", config->cppModules ? "true" : "false" );
 
 	// TODO(DM): 30/03/2026: how do we log OnPreBuild()/OnPostBuild() func ptrs?
 
@@ -296,7 +322,21 @@ void LogVerbose( const char *fmt, ... ) {
 	va_end( args );
 }
 
-s32 RunProc( array_t<const char *> *args, array_t<const char *> *environmentVariables, const procFlags_t procFlags, string_t *outStdout ) {
+// how much CPU time every process that RunProc() ran has used, in microseconds so it can be an atomic
+static atomic64_t				g_childProcessCPUTimeUS;
+
+// same again, but only the processes the calling thread ran
+static THREAD_LOCAL float64		g_threadChildProcessCPUTimeMS = 0.0;
+
+float64 GetChildProcessCPUTimeMS() {
+	return Cast( float64, Thread_AtomicLoad( &g_childProcessCPUTimeUS ) ) / 1000.0;
+}
+
+float64 GetThreadChildProcessCPUTimeMS() {
+	return g_threadChildProcessCPUTimeMS;
+}
+
+s32 RunProc( array_t<const char *> *args, array_t<const char *> *environmentVariables, const procFlags_t procFlags, string_t *outStdout, u64 *outPeakMemoryBytes, const char *workingDirectory ) {
 	Assert( args );
 	Assert( args->data );
 	Assert( args->count >= 1 );
@@ -312,14 +352,17 @@ s32 RunProc( array_t<const char *> *args, array_t<const char *> *environmentVari
 		printf( "\n" );
 	}
 
-	process_t *process = Proc_Create( Mem_GetTempStorage(), args, environmentVariables, PROCESS_FLAG_COMBINE_STDOUT_AND_STDERR );
+	process_t *process = Proc_Create( Mem_GetTempStorage(), args, environmentVariables, PROCESS_FLAG_COMBINE_STDOUT_AND_STDERR, workingDirectory );
 
 	if ( !process ) {
-		Error(
-			"Failed to run process \"%s\".\n"
-			"Is it definitely installed? Is it meant to be added to your PATH? Did you type the path correctly?\n"
-			, ( *args )[0]
-		);
+		// if it couldnt use the working directory then Proc_Create() already said so
+		if ( !workingDirectory ) {
+			Error(
+				"Failed to run process \"%s\".\n"
+				"Is it definitely installed? Is it meant to be added to your PATH? Did you type the path correctly?\n"
+				, ( *args )[0]
+			);
+		}
 
 		// DM: 20/07/2025: I'm not 100% sure that its totally ok to have -1 as our own special exit code to mean that the process couldnt be found
 		// its totally possible for other processes to return -1 and have it mean something else
@@ -347,11 +390,22 @@ s32 RunProc( array_t<const char *> *args, array_t<const char *> *environmentVari
 		}
 	}
 
-	if ( outStdout ) {
-		*outStdout = String_Set( SB_ToString( &sb ) );
+	// the string builder gives back NULL if the process didnt print anything
+	const char *stdoutString = SB_ToString( &sb );
+	if ( outStdout && stdoutString ) {
+		*outStdout = String_Set( stdoutString );
 	}
 
-	s32 exitCode = Proc_Join( process );
+	float64 cpuTimeMS = 0.0;
+	s32 exitCode = Proc_Join( process, outPeakMemoryBytes, &cpuTimeMS );
+
+	g_threadChildProcessCPUTimeMS += cpuTimeMS;
+
+	u64 cpuTimeUS = Cast( u64, cpuTimeMS * 1000.0 );
+	u64 oldCPUTimeUS = Thread_AtomicLoad( &g_childProcessCPUTimeUS );
+	while ( Thread_AtomicCompareExchange( &g_childProcessCPUTimeUS, oldCPUTimeUS, oldCPUTimeUS + cpuTimeUS ) != oldCPUTimeUS ) {
+		oldCPUTimeUS = Thread_AtomicLoad( &g_childProcessCPUTimeUS );
+	}
 
 	return exitCode;
 }
@@ -396,6 +450,47 @@ static s32 ShowUsage( const s32 exitCode ) {
 		"    " ARG_NUKE " <folder> (optional):\n"
 		"        Deletes every file in <folder> and all subfolders, but does not delete <folder>.\n"
 		"\n"
+		"    " ARG_JOBS "<N> (optional):\n"
+		"        Compile and link at most <N> things at once.  Defaults to the number of CPU cores minus one.\n"
+		"        If MAKEFLAGS says there's a GNU make jobserver (for example, when make runs Builder) then Builder also shares slots with that.\n"
+		"        Otherwise Builder makes its own jobserver with <N> slots, so anything it runs (like -flto=jobserver) shares them too.\n"
+		"\n"
+		"    " ARG_NO_CACHE " (optional):\n"
+		"        Don't use the compile cache, so every source file that needs compiling actually gets compiled.\n"
+		"        By default, Builder remembers the output of every compile in .builder/cache and puts it back if the same file gets compiled the same way again (e.g. after switching branches).\n"
+		"\n"
+		"    " ARG_REMOTE_CACHE "<location> (optional):\n"
+		"        Shares the compile cache with other machines through <location>, which is either a folder or an http://host:port/prefix URL.\n"
+		"        Overrides BuilderOptions::remoteCache.\n"
+		"\n"
+		"    " ARG_SERVE_CACHE " <folder> <port> (optional):\n"
+		"        Runs a remote cache server that keeps everything in <folder>, for builds to use with " ARG_REMOTE_CACHE "http://<this machine>:<port>.\n"
+		"        Runs until you stop it.  Port 0 means any free port.\n"
+		"        Only builds on this machine can use it unless you also pass " ARG_ALL_INTERFACES ", because anyone who can reach it can put whatever object files they like in the cache.\n"
+		"\n"
+		"    " ARG_PCH_REPORT " (optional):\n"
+		"        Instead of building, shows which headers Builder would put in each config's precompiled header if BuildConfig::automaticPrecompiledHeader was on, and how much time it expects that to save.\n"
+		"        This goes off what each config's source files included the last time they compiled, so build first.\n"
+		"\n"
+		"    " ARG_HEADER_IMPACT " (optional):\n"
+		"        Instead of building, shows which headers cost the most to change (how long it takes to compile everything that includes them again), and which headers source files include without seeming to need them.\n"
+		"        If the code is in a git repository then how often each header changed in the last 90 days counts too.\n"
+		"        This goes off what each config's source files included the last time they compiled, so build first.\n"
+		"\n"
+		"    " ARG_TIME_REPORT " (optional):\n"
+		"        Rebuilds everything with Clang's -ftime-trace, then shows which headers, template instantiations, and backend passes took the most time across all of each config's source files.\n"
+		"        Each report also gets written to the config's intermediate folder as <binary name>_time_report.txt and <binary name>_time_report.json.\n"
+		"        Only works with Clang.  The compile cache doesn't get used, so everything actually compiles.\n"
+		"\n"
+		"    " ARG_TRACE "<file> (optional):\n"
+		"        Writes a trace of the whole build to <file> in Chrome's trace event format, so you can open it in Perfetto (ui.perfetto.dev) or chrome://tracing.\n"
+		"        Shows when every stage of the build ran and every compile and link on the thread that ran it, plus how many jobs were queued and running over time.\n"
+		"\n"
+		"    " ARG_STATS "[=<percent>] (optional):\n"
+		"        Instead of building, shows how long the last builds took, how much CPU time and memory they used, how many source files they compiled, and how many came out of the compile cache.\n"
+		"        Also lists the source files that took more than <percent>%% (25%% by default) longer to compile the last time they compiled than the median of the times before that.\n"
+		"        Every build gets added to this history, in the .builder folder.\n"
+		"\n"
 		"    " ARG_VISUAL_STUDIO_BUILD " (optional):\n"
 		"        Specifies that the build is being done from Visual Studio.\n"
 		"        So even if BuilderOptions::generateSolution is set to true in the build settings source file we shouldn't generate Visual Studio project files and instead should just do a build using the specified config.\n"
@@ -409,259 +504,2919 @@ static s32 ShowUsage( const s32 exitCode ) {
 	return exitCode;
 }
 
-static bool8 ShouldRebuildSourceFile( const buildContext_t *context, const char *sourceFile, const char *intermediateFilename, const u32 sourceFileHashmapIndex ) {
+// returns a hash of the contents of the source file and all of the files it includes
+// returns 0 if any of those files couldnt be hashed (e.g. a header got deleted), which always means we want to rebuild
+// thread-safe, every file only gets stat'd and hashed once per build no matter how many source files include it
+static u64 GetSourceFileInputsHash( buildContext_t *context, const char *sourceFile, const char * const *includeDependencies, const u64 numIncludeDependencies ) {
+	u64 contentHash = 0;
+	if ( !FileStatMemo_GetFileHash( context->fileStatMemo, sourceFile, &contentHash ) ) {
+		return 0;
+	}
+
+	u64 inputsHash = Hash64( &contentHash, sizeof( u64 ), 0 );
+
+	For ( u64, dependencyIndex, 0, numIncludeDependencies ) {
+		const char *dependencyFilename = includeDependencies[dependencyIndex];
+
+		if ( !FileStatMemo_GetFileHash( context->fileStatMemo, dependencyFilename, &contentHash ) ) {
+			LogVerbose( "Include dependency \"%s\" of \"%s\" no longer exists.\n", dependencyFilename, sourceFile );
+			return 0;
+		}
+
+		// fold the path in too, so that swapping which header gets included counts as a change
+		inputsHash = HashString( dependencyFilename, inputsHash );
+		inputsHash = Hash64( &contentHash, sizeof( u64 ), inputsHash );
+	}
+
+	return inputsHash;
+}
+
+// returns a hash of the compiler binary that lives at the given path
+// so that if the compiler gets upgraded in-place we still know to rebuild everything that it built
+static u64 GetCompilerIdentityHash( compilerBackend_t *compilerBackend ) {
+	string_t compilerPath = compilerBackend->GetCompilerPath( compilerBackend );
+
+	u64 hash = Hash64( compilerPath.data, compilerPath.count, 0 );
+
+	// this can fail if the compiler path is just a name that gets resolved via PATH (e.g. "gcc")
+	// in that case the path is all we've got
+	fileStat_t compilerStat = {};
+	if ( FS_GetFileStat( compilerPath.data, &compilerStat ) ) {
+		hash = Hash64( &compilerStat.sizeBytes, sizeof( u64 ), hash );
+		hash = Hash64( &compilerStat.lastWriteTime, sizeof( u64 ), hash );
+	}
+
+	return hash;
+}
+
+// returns a hash of everything that goes into the command line for compiling a source file in this config, minus the parts that are unique to each source file
+// the parts that are unique to each source file are all derived from the intermediate filename, which is what we key each source file's build state by anyway
+static u64 GetCompilationCommandHash( compilerBackend_t *compilerBackend, const compileCache_t *compileCache, const compilationCommandArchetype_t *cmdArchetype ) {
+	u64 hash = GetCompilerIdentityHash( compilerBackend );
+
+	// the backends add the file prefix map for a shared compile cache on top of the archetype, and it changes what goes in the object files
+	// so turning the shared cache on or off (or moving the checkout) has to rebuild them
+	if ( compileCache && compileCache->rootFolder ) {
+		hash = HashString( compileCache->rootFolder, hash );
+	}
+
+	For ( u64, argIndex, 0, cmdArchetype->baseArgs.count ) {
+		const char *arg = cmdArchetype->baseArgs[argIndex];
+
+		// turning on verbose logging doesnt change what the compiler outputs
+		if ( strcmp( arg, "-v" ) == 0 ) {
+			continue;
+		}
+
+		hash = HashString( arg, hash );
+	}
+
+	For ( u64, argIndex, 0, cmdArchetype->dependencyFlags.count ) {
+		hash = HashString( cmdArchetype->dependencyFlags[argIndex], hash );
+	}
+
+	For ( u64, argIndex, 0, cmdArchetype->precompiledHeaderArgs.count ) {
+		hash = HashString( cmdArchetype->precompiledHeaderArgs[argIndex], hash );
+	}
+
+	if ( cmdArchetype->outputFlag ) {
+		hash = HashString( cmdArchetype->outputFlag, hash );
+	}
+
+	return hash;
+}
+
+// returns a hash of everything that goes into linking the binary for this config
+static u64 GetLinkCommandHash( const BuildConfig *config, const BuilderOptions *options, const u64 compilationCommandHash, const std::vector<std::string> &intermediateFiles ) {
+	// the compilation command covers the compiler and things like defines, which the MSVC link step looks at to pick which CRT to link against
+	u64 hash = compilationCommandHash;
+
+	u32 binaryType = Cast( u32, config->binaryType );
+	hash = Hash64( &binaryType, sizeof( u32 ), hash );
+
+	bool8 removeSymbols = config->removeSymbols;
+	hash = Hash64( &removeSymbols, sizeof( bool8 ), hash );
+
+	bool8 noDefaultLibs = options && options->noDefaultLibs;
+	hash = Hash64( &noDefaultLibs, sizeof( bool8 ), hash );
+
+	For ( u64, i, 0, intermediateFiles.size() ) {
+		hash = HashString( intermediateFiles[i].c_str(), hash );
+	}
+
+	For ( u64, i, 0, config->additionalLibPaths.size() ) {
+		hash = HashString( config->additionalLibPaths[i].c_str(), hash );
+	}
+
+	For ( u64, i, 0, config->additionalLibs.size() ) {
+		hash = HashString( config->additionalLibs[i].c_str(), hash );
+	}
+
+	For ( u64, i, 0, config->additionalLinkerArguments.size() ) {
+		hash = HashString( config->additionalLinkerArguments[i].c_str(), hash );
+	}
+
+	return hash;
+}
+
+static bool8 ShouldRebuildSourceFile( buildContext_t *context, const char *sourceFile, const bool8 intermediateFileExists, const u32 recordIndex, const u64 commandHash ) {
 	if ( context->forceRebuild ) {
 		return true;
 	}
 
-	// if source file doesnt exist in hashmap then its a new file and we havent built this one before
-	if ( sourceFileHashmapIndex == HASHMAP_INVALID_VALUE ) {
+	// if the .o file doesnt exist then assume we havent built this file yet
+	if ( !intermediateFileExists ) {
 		return true;
 	}
 
-	// if the source file is newer than the intermediate file then we want to rebuild
-	u64 intermediateFileLastWriteTime = 0;
-	{
-		// if the .o file doesnt exist then assume we havent built this file yet
-		if ( !FS_GetFileLastWriteTime( intermediateFilename, &intermediateFileLastWriteTime ) ) {
-			return true;
-		}
+	const includeDependencyDB_t *db = context->includeDependencyDB;
+	const includeDependencyRecord_t *record = IncludeDependencyDB_GetRecord( db, recordIndex );
 
-		// if the .o file does exist but the source file was written to it more recently then we know we want to rebuild
-		if ( GetLastFileWriteTime( sourceFile ) > intermediateFileLastWriteTime ) {
-			return true;
-		}
+	// either this file has never compiled successfully (including brand new files) or the last time we tried it failed
+	if ( record->inputsHash == 0 ) {
+		return true;
+	}
+
+	// a different source file used to write to this .o (two source files with the same name, or the file got moved)
+	if ( strcmp( IncludeDependencyDB_GetString( db, record->filenameID ), sourceFile ) != 0 ) {
+		return true;
+	}
+
+	// something about the compiler command line changed since we last compiled this file (a define, the optimization level, the compiler itself, etc.)
+	if ( record->commandHash != commandHash ) {
+		LogVerbose( "Compiler command line for \"%s\" changed since it was last compiled.\n", sourceFile );
+		return true;
 	}
 
-	// if the source file wasnt newer than the .o file then do the same timestamp check for all the files that this source file depends on
+	// timestamps cant be trusted to tell us whether a file actually changed
+	// a git checkout or a touch will bump them without changing a single byte, and on some filesystems two writes in quick succession get the same timestamp
+	// so instead compare what the source file and everything it includes actually contain against what they contained the last time we compiled it
 	// just because the source file didnt change doesnt mean we dont want to recompile it
 	// what if one of the header files it relies on changed? we still want to recompile that file!
-	{
-		const std::vector<std::string> &includeDependencies = context->sourceFileIncludeDependencies[sourceFileHashmapIndex].includeDependencies;
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
 
-		For ( u64, dependencyIndex, 0, includeDependencies.size() ) {
-			if ( GetLastFileWriteTime( includeDependencies[dependencyIndex].c_str() ) > intermediateFileLastWriteTime ) {
-				return true;
-			}
-		}
+	const char **includeDependencies = Cast( const char **, Mem_TempAlloc( Max( record->numDependencies, 1U ) * sizeof( const char * ) ) );
+	For ( u32, dependencyIndex, 0, record->numDependencies ) {
+		includeDependencies[dependencyIndex] = IncludeDependencyDB_GetString( db, IncludeDependencyDB_GetDependency( db, record, dependencyIndex ) );
 	}
 
-	return false;
+	u64 inputsHash = GetSourceFileInputsHash( context, sourceFile, includeDependencies, record->numDependencies );
+
+	return inputsHash != record->inputsHash;
 }
 
-struct compileJobPool_t {
-	compilerBackend_t				*compilerBackend;
-	buildContext_t					*context;
+// see compileJob_t::numModulesWaitingFor
+#define MODULE_IMPORTER_SKIPPED	U32_MAX
+
+struct compileJob_t {
+	u32							sourceFileIndex;
+	u32							recordIndex;
+
+	// how long we think this file will take to compile and how much memory the compiler will need, see BuildBinary_PredictCompileCosts()
+	float64						predictedTimeMS;
+	u64							predictedPeakMemoryBytes;
+
+	// how many compile jobs, starting with this one, get compiled together in one run of the compiler (see BuildBinary_BatchSmallCompileJobs())
+	// 1 if this one compiles on its own, 0 if its part of a batch that started with an earlier job
+	u32							numJobsInBatch;
+
+	// only used if the config uses C++20 modules (see BuildBinary_OrderModuleCompileJobs())
+	// how many of the compile jobs that make the modules this one imports havent finished yet, it cant start until none of them are left
+	// MODULE_IMPORTER_SKIPPED if one of them failed, so this one never starts
+	u32							numModulesWaitingFor;
+
+	// indices into configBuild_t::compileJobs of the jobs waiting on the module this one exports
+	std::vector<u32>			moduleImporterJobIndices;
+
+	// the longest chain of compile jobs that cant start until this one finishes, in how long we think they take
+	float64						moduleImportersTimeMS;
+
+	// filled out by the compile thread
+	// the include dependency database isnt thread-safe, so the main thread writes these into it once the job finishes
+	bool8						succeeded;
+	u64							inputsHash;
+	float64						compileTimeMS;
+	float64						cpuTimeMS;
+	u64							peakMemoryBytes;
+	bool8						cacheHit;	// the outputs came out of the compile cache, so compileTimeMS and peakMemoryBytes are meaningless
+	std::vector<std::string>	includeDependencies;
+
+	// when the job actually ran, 0 if it never did (see BuildConfigs_PrintCriticalPath())
+	// every job in a batch gets the times of the whole batch
+	float64						startTimeMS;
+	float64						endTimeMS;
+};
+
+enum configBuildState_t {
+	CONFIG_BUILD_STATE_WAITING	= 0,	// not started yet
+	CONFIG_BUILD_STATE_COMPILING,		// its compile jobs are queued up or running
+	CONFIG_BUILD_STATE_LINKING,			// its link job is queued up or running
+	CONFIG_BUILD_STATE_LINKED,			// the binary is up to date, but OnPostBuild (if it has one) hasnt run yet
+	CONFIG_BUILD_STATE_DONE,
+};
+
+// everything about one config thats being built
+// configs build alongside each other, so this has to live for as long as the whole build does
+struct configBuild_t {
 	BuildConfig						*config;
-	compilationCommandArchetype_t	*cmdArchetype;
-	std::vector<std::string>		*intermediateFiles;
-	bool8							generateCompilationDatabase;
-	u32								numSourceFiles;
-	atomic32_t						nextSourceFileIndex;
-	atomic32_t						numFailed;
+	configBuildState_t				state;
+	buildResult_t					result;
+
+	compilationCommandArchetype_t	cmdArchetype;
+	u64								commandHash;
+	u64								linkHash;
+
+	std::vector<std::string>		intermediateFiles;
+	std::vector<compileJob_t>		compileJobs;
+	u32								numCompileJobsLeft;
+	u32								numCompileJobsFailed;
+
+	// indices into BuildConfig::sourceFiles of the source files that failed to compile
+	std::vector<u32>				failedSourceFileIndices;
+
+	// indices of the configs this one depends on
+	std::vector<u32>				dependencyIndices;
+
+	// which of BuilderOptions::resourcePools each source file compiles in, and which one the link goes in
+	// RESOURCE_POOL_NONE if it isnt in one
+	std::vector<u32>				sourceFilePoolIndices;
+	u32								linkPoolIndex;
+
+	// where this config's source files start in buildContext_t::compilationDatabase
+	u64								compilationDatabaseOffset;
+
+	// only used if the config has a precompiled header (see BuildConfig::precompiledHeader)
+	// the config's source files dont get queued up until this has compiled
+	compileJob_t					precompiledHeaderJob;
+	bool8							compilingPrecompiledHeader;
+	u32								precompiledHeaderPoolIndex;
+
+	// only used if the config uses C++20 modules (see BuildConfig::cppModules), one per source file
+	// the indices into BuildConfig::sourceFiles of the source files that export the modules it imports, including the ones it only imports indirectly
+	std::vector<std::vector<u32>>	moduleDependencies;
+
+	// which config cache entry the binary is, 0 if it isnt in the config cache (yet)
+	// configs that depend on this one can only go in the config cache once this one is
+	u64								configCacheEntryHash;
+
+	// the binary came out of the config cache (or was already the same as the entry in it), so theres nothing to compile or link
+	bool8							configCacheHit;
+
+	float64							startTimeMS;
+	float64							buildTimeMS;
+
+	// when the link job actually ran, 0 if it never did
+	float64							linkStartTimeMS;
+	float64							linkEndTimeMS;
 };
 
-static s32 CompileJobThread( void *data ) {
-	compileJobPool_t *pool = Cast( compileJobPool_t *, data );
+#define RESOURCE_POOL_NONE	U32_MAX
 
-	while ( 1 ) {
-		u32 sourceFileIndex = Thread_AtomicIncrement( &pool->nextSourceFileIndex ) - 1;
+enum buildJobType_t {
+	BUILD_JOB_TYPE_COMPILE	= 0,
+	BUILD_JOB_TYPE_PRECOMPILED_HEADER,
+	BUILD_JOB_TYPE_LINK,
+};
 
-		if ( sourceFileIndex >= pool->numSourceFiles ) {
-			break;
-		}
+struct buildQueue_t;
 
-		u64 marker = Mem_TempTell();
-		defer { Mem_TempRewindTo( marker ); };
+struct buildJob_t {
+	buildQueue_t	*queue;
+	buildJobType_t	type;
+	u32				buildIndex;
+	u32				compileJobIndex;	// only for compile jobs, the first one if its a batch
+	u32				poolIndex;			// RESOURCE_POOL_NONE if it isnt in one
+
+	// filled out by the thread that ran the job
+	bool8			succeeded;
+};
+
+// keeps track of every job the build has handed to the job pool
+// only the main thread ever submits jobs, works out what can run next, and touches the include dependency database
+// the job pool just runs whatever is next and hands the result back here
+struct buildQueue_t {
+	compilerBackend_t		*compilerBackend;
+	buildContext_t			*context;
+	const BuilderOptions	*options;
+	configBuild_t			*builds;
+
+	// every job that could possibly get submitted this build
+	// reserved up front so pointers to these stay valid while the job pool has them
+	std::vector<buildJob_t>	jobs;
+
+	mutex_t					mutex;
+	semaphore_t				jobFinished;	// the main thread waits on this
+	std::vector<buildJob_t>	finishedJobs;
+
+	// main thread only
+	u32						numJobsInFlight;
+
+	// how many jobs from each of BuilderOptions::resourcePools have been submitted but havent finished yet
+	// main thread only
+	std::vector<u32>		numJobsInPools;
+
+	// for telling the user how good our guesses at compile times were (verbose only)
+	// predicted times are in the order the compile jobs got submitted
+	std::vector<float64>	predictedCompileTimesMS;
+	float64					firstCompileSubmitTimeMS;
+	float64					lastCompileFinishTimeMS;
+
+	// compile jobs wait on this before they start, so we dont run the machine out of memory
+	memoryThrottle_t		memoryThrottle;
+};
+
+static bool8 RunCompileJob( buildQueue_t *queue, configBuild_t *build, compileJob_t *job ) {
+	compilerBackend_t *compilerBackend = queue->compilerBackend;
+
+	const char *sourceFile = build->config->sourceFiles[job->sourceFileIndex].c_str();
+
+	bool8 generateCompilationDatabase = queue->options && queue->options->generateCompilationDatabase;
+
+	float64 startTimeMS = Time_MS();
+
+	bool8 compiled = compilerBackend->CompileSourceFile( compilerBackend, queue->context, build->config, build->cmdArchetype, sourceFile, generateCompilationDatabase, build->compilationDatabaseOffset + job->sourceFileIndex, &job->includeDependencies, &job->peakMemoryBytes, &job->cacheHit );
+
+	job->compileTimeMS = Time_MS() - startTimeMS;
+
+	if ( !compiled ) {
+		return false;
+	}
+
+	// remember what everything we just compiled looked like so next time we can tell if it changed
+	const char **includeDependencies = Cast( const char **, Mem_TempAlloc( Max( job->includeDependencies.size(), Cast( size_t, 1 ) ) * sizeof( const char * ) ) );
+	For ( u64, dependencyIndex, 0, job->includeDependencies.size() ) {
+		includeDependencies[dependencyIndex] = job->includeDependencies[dependencyIndex].c_str();
+	}
+
+	job->inputsHash = GetSourceFileInputsHash( queue->context, sourceFile, includeDependencies, job->includeDependencies.size() );
+	job->succeeded = true;
+
+	return true;
+}
+
+// compiles the batch of jobs that starts with 'jobs' in one run of the compiler (see BuildBinary_BatchSmallCompileJobs())
+// returns true if every one of them compiled
+static bool8 RunCompileBatchJob( buildQueue_t *queue, configBuild_t *build, compileJob_t *jobs ) {
+	compilerBackend_t *compilerBackend = queue->compilerBackend;
+
+	u32 numJobs = jobs[0].numJobsInBatch;
+	Assert( numJobs > 1 );
+
+	bool8 generateCompilationDatabase = queue->options && queue->options->generateCompilationDatabase;
+
+	const char **sourceFiles = Cast( const char **, Mem_TempAlloc( numJobs * sizeof( const char * ) ) );
+	u64 *sourceFileIndices = Cast( u64 *, Mem_TempAlloc( numJobs * sizeof( u64 ) ) );
+	bool8 *succeeded = Cast( bool8 *, Mem_TempAlloc( numJobs * sizeof( bool8 ) ) );
+	bool8 *cacheHits = Cast( bool8 *, Mem_TempAlloc( numJobs * sizeof( bool8 ) ) );
+
+	std::vector<std::vector<std::string>> includeDependencies;
+	includeDependencies.resize( numJobs );
+
+	float64 predictedTimeMS = 0.0;
 
-		const char *sourceFile = pool->config->sourceFiles[sourceFileIndex].c_str();
+	For ( u32, jobIndex, 0, numJobs ) {
+		sourceFiles[jobIndex] = build->config->sourceFiles[jobs[jobIndex].sourceFileIndex].c_str();
+		sourceFileIndices[jobIndex] = build->compilationDatabaseOffset + jobs[jobIndex].sourceFileIndex;
 
-		string_t sourceFileNoPath = String_Set( sourceFile );
-		sourceFileNoPath = Path_RemovePathFromFile( &sourceFileNoPath );
+		predictedTimeMS += jobs[jobIndex].predictedTimeMS;
+	}
+
+	u64 peakMemoryBytes = 0;
+
+	float64 startTimeMS = Time_MS();
+
+	bool8 compiled = compilerBackend->CompileSourceFiles( compilerBackend, queue->context, build->config, build->cmdArchetype, sourceFiles, numJobs, generateCompilationDatabase, sourceFileIndices, includeDependencies.data(), succeeded, cacheHits, &peakMemoryBytes );
 
-		string_t sourceFileNoPathAndExtension = Path_RemoveFileExtension( &sourceFileNoPath );
+	float64 compileTimeMS = Time_MS() - startTimeMS;
 
-		string_t intermediateFilename = String_Printf( Mem_GetTempStorage(), "%s%c%s.o", pool->config->intermediateFolder.c_str(), PATH_SEPARATOR, String_Cstr( &sourceFileNoPathAndExtension ) );
-		( *pool->intermediateFiles )[sourceFileIndex] = intermediateFilename.data;
+	For ( u32, jobIndex, 0, numJobs ) {
+		compileJob_t *job = &jobs[jobIndex];
 
-		u32 sourceFileHashmapIndex = HM_GetValue( pool->context->sourceFileIndices, HashString( sourceFile, 0 ) );
+		// theres no telling how long each one took on its own, so share the time out by how long we thought each one would take
+		job->compileTimeMS = ( predictedTimeMS > 0.0 ) ? compileTimeMS * ( job->predictedTimeMS / predictedTimeMS ) : compileTimeMS / numJobs;
+		job->peakMemoryBytes = peakMemoryBytes;
+		job->cacheHit = cacheHits[jobIndex];
+		job->includeDependencies.swap( includeDependencies[jobIndex] );
 
-		if ( !ShouldRebuildSourceFile( pool->context, sourceFile, intermediateFilename.data, sourceFileHashmapIndex ) ) {
+		if ( !succeeded[jobIndex] ) {
 			continue;
 		}
 
-		std::vector<std::string> includeDependencies;
-		if ( !pool->compilerBackend->CompileSourceFile( pool->compilerBackend, pool->context, pool->config, *pool->cmdArchetype, sourceFile, pool->generateCompilationDatabase, sourceFileIndex, &includeDependencies ) ) {
-			Thread_AtomicIncrement( &pool->numFailed );
-			continue;
+		const char **jobIncludeDependencies = Cast( const char **, Mem_TempAlloc( Max( job->includeDependencies.size(), Cast( size_t, 1 ) ) * sizeof( const char * ) ) );
+		For ( u64, dependencyIndex, 0, job->includeDependencies.size() ) {
+			jobIncludeDependencies[dependencyIndex] = job->includeDependencies[dependencyIndex].c_str();
 		}
 
-		pool->context->sourceFileIncludeDependencies[sourceFileHashmapIndex].includeDependencies = std::move( includeDependencies );
+		job->inputsHash = GetSourceFileInputsHash( queue->context, sourceFiles[jobIndex], jobIncludeDependencies, job->includeDependencies.size() );
+		job->succeeded = true;
 	}
 
-	return 0;
+	return compiled;
 }
 
-static buildResult_t BuildBinary( buildContext_t *context, BuildConfig *config, compilerBackend_t *compilerBackend, const BuilderOptions *options ) {
-	// create binary folder
-	if ( !FS_CreateFolderIfItDoesntExist( config->binaryFolder.c_str() ) ) {
-		s32 errorCode = GetLastErrorCode();
-		FatalError( "Failed to create the binary folder you specified inside %s: \"%s\".  Error code: " ERROR_CODE_FORMAT "", SET_BUILDER_OPTIONS_FUNC_NAME, config->binaryFolder.c_str(), errorCode );
-		return BUILD_RESULT_FAILED;
+static bool8 RunPrecompiledHeaderJob( buildQueue_t *queue, configBuild_t *build, compileJob_t *job ) {
+	compilerBackend_t *compilerBackend = queue->compilerBackend;
+
+	const char *precompiledHeader = build->config->precompiledHeader.c_str();
+
+	float64 startTimeMS = Time_MS();
+
+	bool8 compiled = compilerBackend->CompilePrecompiledHeader( compilerBackend, queue->context, build->config, build->cmdArchetype, &job->includeDependencies, &job->peakMemoryBytes );
+
+	job->compileTimeMS = Time_MS() - startTimeMS;
+
+	if ( !compiled ) {
+		return false;
 	}
 
-	// create intermediate folder
-	if ( !FS_CreateFolderIfItDoesntExist( config->intermediateFolder.c_str() ) ) {
-		s32 errorCode = GetLastErrorCode();
-		FatalError( "Failed to create intermediate binary folder.  Error code: " ERROR_CODE_FORMAT "\n", errorCode );
-		return BUILD_RESULT_FAILED;
+	const char **includeDependencies = Cast( const char **, Mem_TempAlloc( Max( job->includeDependencies.size(), Cast( size_t, 1 ) ) * sizeof( const char * ) ) );
+	For ( u64, dependencyIndex, 0, job->includeDependencies.size() ) {
+		includeDependencies[dependencyIndex] = job->includeDependencies[dependencyIndex].c_str();
 	}
 
-	if ( config->OnPreBuild ) {
-		LogVerbose( "Found a OnPreBuild() func ptr for BuildConfig: \"%s\".  Running...\n", config->name.c_str() );
-		config->OnPreBuild( config );
+	job->inputsHash = GetSourceFileInputsHash( queue->context, precompiledHeader, includeDependencies, job->includeDependencies.size() );
+	job->succeeded = true;
+
+	return true;
+}
+
+// runs on a job pool thread
+static void BuildJob_Run( void *data ) {
+	buildJob_t *job = Cast( buildJob_t *, data );
+	buildQueue_t *queue = job->queue;
+
+	configBuild_t *build = &queue->builds[job->buildIndex];
+
+	switch ( job->type ) {
+		case BUILD_JOB_TYPE_COMPILE: {
+			compileJob_t *compileJob = &build->compileJobs[job->compileJobIndex];
+
+			// the compiler goes through a batch one source file at a time, so it only ever needs as much memory as the biggest one
+			u64 predictedPeakMemoryBytes = compileJob->predictedPeakMemoryBytes;
+			For ( u32, batchJobIndex, 1, compileJob->numJobsInBatch ) {
+				predictedPeakMemoryBytes = Max( predictedPeakMemoryBytes, compileJob[batchJobIndex].predictedPeakMemoryBytes );
+			}
+
+			// wait for the memory first, theres no point holding a jobserver slot that someone else could use while we cant start anyway
+			MemoryThrottle_Admit( &queue->memoryThrottle, predictedPeakMemoryBytes );
+
+			// the compiler gets a jobserver slot of its own for as long as its running
+			// so if something else in the build (make, another builder, an LTO link) is busy then we back off
+			jobserverToken_t token = Jobserver_AcquireToken();
+
+			const char *spanName = ( compileJob->numJobsInBatch > 1 ) ? TempPrintf( "%u source files", compileJob->numJobsInBatch ) : build->config->sourceFiles[compileJob->sourceFileIndex].c_str();
+			buildTraceSpan_t span = BuildTrace_BeginSpan( "compile", spanName );
+
+			float64 cpuTimeStartMS = GetThreadChildProcessCPUTimeMS();
+			float64 startTimeMS = Time_MS();
+
+			if ( compileJob->numJobsInBatch > 1 ) {
+				job->succeeded = RunCompileBatchJob( queue, build, compileJob );
+			} else {
+				job->succeeded = RunCompileJob( queue, build, compileJob );
+			}
+
+			float64 endTimeMS = Time_MS();
+			float64 cpuTimeMS = GetThreadChildProcessCPUTimeMS() - cpuTimeStartMS;
+
+			// a batch is one run of the compiler, so share its CPU time out the same way as its compile time
+			float64 batchTimeMS = 0.0;
+			For ( u32, batchJobIndex, 0, compileJob->numJobsInBatch ) {
+				batchTimeMS += compileJob[batchJobIndex].compileTimeMS;
+			}
+
+			For ( u32, batchJobIndex, 0, compileJob->numJobsInBatch ) {
+				compileJob[batchJobIndex].cpuTimeMS = ( batchTimeMS > 0.0 ) ? cpuTimeMS * ( compileJob[batchJobIndex].compileTimeMS / batchTimeMS ) : cpuTimeMS / compileJob->numJobsInBatch;
+				compileJob[batchJobIndex].startTimeMS = startTimeMS;
+				compileJob[batchJobIndex].endTimeMS = endTimeMS;
+			}
+
+			BuildTrace_EndSpan( &span, build->config->binaryName.c_str() );
+
+			Jobserver_ReleaseToken( token );
+
+			MemoryThrottle_Release( &queue->memoryThrottle, predictedPeakMemoryBytes );
+		} break;
+
+		case BUILD_JOB_TYPE_PRECOMPILED_HEADER: {
+			compileJob_t *compileJob = &build->precompiledHeaderJob;
+
+			MemoryThrottle_Admit( &queue->memoryThrottle, compileJob->predictedPeakMemoryBytes );
+
+			jobserverToken_t token = Jobserver_AcquireToken();
+
+			buildTraceSpan_t span = BuildTrace_BeginSpan( "compile", build->config->precompiledHeader.c_str() );
+
+			float64 cpuTimeStartMS = GetThreadChildProcessCPUTimeMS();
+			compileJob->startTimeMS = Time_MS();
+
+			job->succeeded = RunPrecompiledHeaderJob( queue, build, compileJob );
+
+			compileJob->endTimeMS = Time_MS();
+			compileJob->cpuTimeMS = GetThreadChildProcessCPUTimeMS() - cpuTimeStartMS;
+
+			BuildTrace_EndSpan( &span, build->config->binaryName.c_str() );
+
+			Jobserver_ReleaseToken( token );
+
+			MemoryThrottle_Release( &queue->memoryThrottle, compileJob->predictedPeakMemoryBytes );
+		} break;
+
+		case BUILD_JOB_TYPE_LINK: {
+			// links dont go through the memory throttle
+			// there's at most one per config, and other configs are often waiting on it, so holding it back would only make things slower
+			jobserverToken_t token = Jobserver_AcquireToken();
+
+			buildTraceSpan_t span = BuildTrace_BeginSpan( "link", build->config->binaryName.c_str() );
+
+			build->linkStartTimeMS = Time_MS();
+
+			job->succeeded = queue->compilerBackend->LinkIntermediateFiles( queue->compilerBackend, build->intermediateFiles, build->config, queue->options );
+
+			build->linkEndTimeMS = Time_MS();
+
+			BuildTrace_EndSpan( &span );
+
+			Jobserver_ReleaseToken( token );
+		} break;
 	}
 
-	std::vector<std::string> intermediateFiles;
-	intermediateFiles.resize( config->sourceFiles.size() );
+	Mutex_Lock( &queue->mutex );
+	queue->finishedJobs.push_back( *job );
+	Mutex_Unlock( &queue->mutex );
 
-	// process_t only once how the base compilation command should look like, fill up dep/output/source args later for each source file
-	compilationCommandArchetype_t cmdArchetype {};
-	if ( !compilerBackend->GetCompilationCommandArchetype( compilerBackend, config, cmdArchetype ) ) {
-		Error( "Failed to generate compilation command.\n" );
-		return BUILD_RESULT_FAILED;
+	Semaphore_Signal( &queue->jobFinished );
+}
+
+// main thread only
+static void BuildQueue_Submit( buildQueue_t *queue, const buildJobType_t type, const u32 buildIndex, const u32 compileJobIndex, const u32 poolIndex ) {
+	Assert( queue->jobs.size() < queue->jobs.capacity() );
+
+	queue->jobs.push_back( {
+		.queue				= queue,
+		.type				= type,
+		.buildIndex			= buildIndex,
+		.compileJobIndex	= compileJobIndex,
+		.poolIndex			= poolIndex,
+	} );
+
+	queue->numJobsInFlight++;
+
+	if ( poolIndex != RESOURCE_POOL_NONE ) {
+		queue->numJobsInPools[poolIndex]++;
 	}
 
-	if ( context->consolidateCompilerArgs ) {
-		printf( "Compiling with the following command line options for each source file:\n" );
-		For ( u32, argIndex, 0, cmdArchetype.baseArgs.count ) {
-			printf( "%s ", cmdArchetype.baseArgs[argIndex] );
+	// links go first, there could be other configs waiting on them
+	JobPool_Submit( BuildJob_Run, &queue->jobs.back(), NULL, ( type == BUILD_JOB_TYPE_LINK ) ? JOB_PRIORITY_HIGH : JOB_PRIORITY_NORMAL );
+}
+
+// main thread only
+// blocks until a job finishes, then hands it back
+static buildJob_t BuildQueue_WaitForFinishedJob( buildQueue_t *queue ) {
+	Assert( queue->numJobsInFlight > 0 );
+
+	Semaphore_Wait( &queue->jobFinished );
+
+	Mutex_Lock( &queue->mutex );
+
+	Assert( queue->finishedJobs.size() > 0 );
+
+	buildJob_t job = queue->finishedJobs.back();
+	queue->finishedJobs.pop_back();
+
+	Mutex_Unlock( &queue->mutex );
+
+	queue->numJobsInFlight--;
+
+	if ( job.poolIndex != RESOURCE_POOL_NONE ) {
+		Assert( queue->numJobsInPools[job.poolIndex] > 0 );
+		queue->numJobsInPools[job.poolIndex]--;
+	}
+
+	return job;
+}
+
+// main thread only
+// returns true if another job can go in the given pool right now
+static bool8 BuildQueue_PoolHasRoom( const buildQueue_t *queue, const u32 poolIndex ) {
+	if ( poolIndex == RESOURCE_POOL_NONE ) {
+		return true;
+	}
+
+	return queue->numJobsInPools[poolIndex] < queue->options->resourcePools[poolIndex].depth;
+}
+
+// our guess at how long a file we've never compiled before will take is the size of the file times how many files it includes
+// this is roughly how many of those it takes to make one millisecond of compiling
+// on a first build we dont know what anything includes yet, so this is really just bytes of source per millisecond
+// only used until at least one file in the config has compiled once, after that we know how fast this config actually compiles
+#define COMPILE_TIME_GUESS_COST_PER_MS	100.0
+
+// how much memory we guess the compiler needs for a file we've never compiled before
+// only used until at least one file in the config has compiled once, after that we guess the average of what the others needed
+#define COMPILE_MEMORY_GUESS_MB			256
+
+// works out how long each compile job will probably take so the longest ones can go first
+// if one of them takes 40 seconds and it starts last then every other thread sits around doing nothing while it finishes
+// also works out how much memory each one will probably need, so the memory throttle knows which ones can run together
+// files we've compiled before just take as long and need as much as they did last time
+static void BuildBinary_PredictCompileCosts( buildContext_t *context, configBuild_t *build ) {
+	const includeDependencyDB_t *db = context->includeDependencyDB;
+
+	std::vector<compileJob_t> &compileJobs = build->compileJobs;
+
+	std::vector<float64> guessCosts;
+	guessCosts.resize( compileJobs.size() );
+
+	// work out how much guessed cost is worth one millisecond from every file we do know the compile time of
+	float64 knownCost = 0.0;
+	float64 knownTimeMS = 0.0;
+
+	u64 knownPeakMemoryMB = 0;
+	u64 numKnownPeakMemories = 0;
+
+	For ( u64, jobIndex, 0, compileJobs.size() ) {
+		const includeDependencyRecord_t *record = IncludeDependencyDB_GetRecord( db, compileJobs[jobIndex].recordIndex );
+
+		fileStat_t sourceFileStat = {};
+		FileStatMemo_GetFileStat( context->fileStatMemo, build->config->sourceFiles[compileJobs[jobIndex].sourceFileIndex].c_str(), &sourceFileStat );
+
+		// +1 so a file that includes nothing still costs something
+		guessCosts[jobIndex] = Cast( float64, sourceFileStat.sizeBytes ) * ( record->numDependencies + 1 );
+
+		if ( record->compileTimeMS > 0 ) {
+			knownCost += guessCosts[jobIndex];
+			knownTimeMS += record->compileTimeMS;
 		}
-		printf( "\n" );
-	} else {
-		printf( "Compiling:\n" );
+
+		if ( record->peakMemoryMB > 0 ) {
+			knownPeakMemoryMB += record->peakMemoryMB;
+			numKnownPeakMemories++;
+		}
+	}
+
+	float64 costPerMS = ( knownCost > 0.0 && knownTimeMS > 0.0 ) ? knownCost / knownTimeMS : COMPILE_TIME_GUESS_COST_PER_MS;
+
+	u64 guessPeakMemoryMB = ( numKnownPeakMemories > 0 ) ? knownPeakMemoryMB / numKnownPeakMemories : COMPILE_MEMORY_GUESS_MB;
+
+	For ( u64, jobIndex, 0, compileJobs.size() ) {
+		const includeDependencyRecord_t *record = IncludeDependencyDB_GetRecord( db, compileJobs[jobIndex].recordIndex );
+
+		if ( record->compileTimeMS > 0 ) {
+			compileJobs[jobIndex].predictedTimeMS = record->compileTimeMS;
+		} else {
+			compileJobs[jobIndex].predictedTimeMS = guessCosts[jobIndex] / costPerMS;
+		}
+
+		u64 peakMemoryMB = ( record->peakMemoryMB > 0 ) ? record->peakMemoryMB : guessPeakMemoryMB;
+
+		compileJobs[jobIndex].predictedPeakMemoryBytes = peakMemoryMB * 1024 * 1024;
 	}
+}
+
+// returns true if the source file exports or imports a C++20 module (see BuildConfig::cppModules)
+static bool8 BuildBinary_SourceFileUsesModules( const configBuild_t *build, const u32 sourceFileIndex ) {
+	const hashmap_t *moduleArgsIndices = build->cmdArchetype.moduleArgsIndices;
+
+	return moduleArgsIndices && HM_GetValue( moduleArgsIndices, HashString( build->config->sourceFiles[sourceFileIndex].c_str(), 0 ) ) != HASHMAP_INVALID_VALUE;
+}
+
+// only source files we think take less than this to compile go in a batch
+// starting the compiler is what were trying to save, so once the compile itself takes a lot longer than that theres nothing to gain
+#define COMPILE_BATCH_MAX_FILE_TIME_MS	100.0
+
+// batches stop growing once we think they take this long to compile
+#define COMPILE_BATCH_TARGET_TIME_MS	500.0
+
+// so the command line doesnt get silly
+#define COMPILE_BATCH_MAX_FILES			32
+
+// puts the compile jobs that we think only take a moment into batches that each get compiled in one run of the compiler (see BuildConfig::batchSmallSourceFiles)
+// for lots of tiny source files, starting the compiler for each one can take longer than compiling them
+// batches never get so big that there arent enough of them to keep every thread busy, and never mix source files from different resource pools
+// the jobs in a batch end up next to each other in 'compileJobs', after every job that still compiles on its own
+static void BuildBinary_BatchSmallCompileJobs( configBuild_t *build, const u32 numThreads ) {
+	std::vector<compileJob_t> &compileJobs = build->compileJobs;
+
+	std::vector<compileJob_t> smallJobs;
+	float64 smallJobsTimeMS = 0.0;
+
+	u64 numOtherJobs = 0;
+
+	For ( u64, jobIndex, 0, compileJobs.size() ) {
+		const compileJob_t *job = &compileJobs[jobIndex];
+
+		// source files that export or import modules have to wait for each other, so they always compile on their own
+		if ( job->predictedTimeMS < COMPILE_BATCH_MAX_FILE_TIME_MS && !BuildBinary_SourceFileUsesModules( build, job->sourceFileIndex ) ) {
+			smallJobs.push_back( *job );
+			smallJobsTimeMS += job->predictedTimeMS;
+		} else {
+			compileJobs[numOtherJobs++] = *job;
+		}
+	}
+
+	if ( smallJobs.size() < 2 ) {
+		compileJobs.resize( numOtherJobs );
+		compileJobs.insert( compileJobs.end(), smallJobs.begin(), smallJobs.end() );
+		return;
+	}
+
+	float64 targetTimeMS = smallJobsTimeMS / Max( numThreads, 1U );
+	if ( targetTimeMS > COMPILE_BATCH_TARGET_TIME_MS ) {
+		targetTimeMS = COMPILE_BATCH_TARGET_TIME_MS;
+	}
+
+	std::vector<bool8> batched;
+	batched.resize( smallJobs.size(), false );
+
+	compileJobs.resize( numOtherJobs );
+
+	u32 numBatches = 0;
+
+	For ( u64, smallJobIndex, 0, smallJobs.size() ) {
+		if ( batched[smallJobIndex] ) {
+			continue;
+		}
+
+		u64 firstJobIndex = compileJobs.size();
+		u32 poolIndex = build->sourceFilePoolIndices[smallJobs[smallJobIndex].sourceFileIndex];
+
+		compileJobs.push_back( smallJobs[smallJobIndex] );
+		batched[smallJobIndex] = true;
+
+		float64 batchTimeMS = smallJobs[smallJobIndex].predictedTimeMS;
+		u32 numJobsInBatch = 1;
+
+		for ( u64 otherJobIndex = smallJobIndex + 1; otherJobIndex < smallJobs.size() && numJobsInBatch < COMPILE_BATCH_MAX_FILES && batchTimeMS < targetTimeMS; otherJobIndex++ ) {
+			const compileJob_t *otherJob = &smallJobs[otherJobIndex];
+
+			if ( batched[otherJobIndex] || build->sourceFilePoolIndices[otherJob->sourceFileIndex] != poolIndex ) {
+				continue;
+			}
+
+			compileJobs.push_back( *otherJob );
+			compileJobs.back().numJobsInBatch = 0;
+			batched[otherJobIndex] = true;
+
+			batchTimeMS += otherJob->predictedTimeMS;
+			numJobsInBatch++;
+		}
+
+		compileJobs[firstJobIndex].numJobsInBatch = numJobsInBatch;
+
+		numBatches++;
+	}
+
+	LogVerbose( "Put %" PRIu64 " small source files into %u compiler runs, aiming for %f ms each.\n", smallJobs.size(), numBatches, targetTimeMS );
+}
+
+static void RemoveRootFolder( const compileCache_t *cache, std::vector<std::string> &strings ) {
+	For ( u64, stringIndex, 0, strings.size() ) {
+		strings[stringIndex] = CompileCache_RemoveRootFolder( cache, strings[stringIndex].c_str() );
+	}
+}
+
+// returns the key for this config in the config cache, which covers everything that goes into its binary apart from the headers its source files include (the cache checks those itself)
+// returns 0 if the config cant use the config cache
+// main thread only
+static u64 BuildBinary_GetConfigCacheKey( buildContext_t *context, const configBuild_t *builds, const configBuild_t *build, compilerBackend_t *compilerBackend, const BuilderOptions *options ) {
+	compileCache_t *compileCache = context->compileCache;
+
+	if ( !compileCache ) {
+		return 0;
+	}
+
+	const BuildConfig *config = build->config;
+
+#ifdef _WIN32
+	// exes and dlls come with other files (pdbs, import libraries) that would need to go in the cache too
+	if ( config->binaryType != BINARY_TYPE_STATIC_LIBRARY ) {
+		return 0;
+	}
+#endif
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	u64 key = GetCompilerIdentityHash( compilerBackend );
+
+	// we dont know what we'd be linking against unless everything we depend on is in the cache too
+	For ( u64, dependencyIndex, 0, build->dependencyIndices.size() ) {
+		u64 dependencyEntryHash = builds[build->dependencyIndices[dependencyIndex]].configCacheEntryHash;
+
+		if ( dependencyEntryHash == 0 ) {
+			return 0;
+		}
+
+		key = Hash64( &dependencyEntryHash, sizeof( u64 ), key );
+	}
+
+	// by now all of the paths in the config are absolute, so swap out the root folder to give the config the same key in every checkout
+	BuildConfig portableConfig = *config;
+	RemoveRootFolder( compileCache, portableConfig.sourceFiles );
+	RemoveRootFolder( compileCache, portableConfig.additionalIncludes );
+	RemoveRootFolder( compileCache, portableConfig.additionalLibPaths );
+	RemoveRootFolder( compileCache, portableConfig.additionalCompilerArguments );
+	RemoveRootFolder( compileCache, portableConfig.additionalLinkerArguments );
+	portableConfig.precompiledHeader = CompileCache_RemoveRootFolder( compileCache, config->precompiledHeader.c_str() );
+	portableConfig.binaryFolder = CompileCache_RemoveRootFolder( compileCache, config->binaryFolder.c_str() );
+	portableConfig.intermediateFolder = CompileCache_RemoveRootFolder( compileCache, config->intermediateFolder.c_str() );
+
+	u32 configHash = BuilderGetConfigHash( &portableConfig, 0 );
+	key = Hash64( &configHash, sizeof( u32 ), key );
+
+	bool8 noDefaultLibs = options && options->noDefaultLibs;
+	key = Hash64( &noDefaultLibs, sizeof( bool8 ), key );
+
+	For ( u64, sourceFileIndex, 0, config->sourceFiles.size() ) {
+		u64 contentHash = 0;
+		if ( !FileStatMemo_GetFileHash( context->fileStatMemo, config->sourceFiles[sourceFileIndex].c_str(), &contentHash ) ) {
+			return 0;
+		}
+
+		key = HashString( portableConfig.sourceFiles[sourceFileIndex].c_str(), key );
+		key = Hash64( &contentHash, sizeof( u64 ), key );
+	}
+
+	return key;
+}
+
+// looks for this config's binary in the config cache, and puts it back if its there
+// returns true if the binary is now up to date without compiling or linking anything
+// main thread only
+static bool8 BuildBinary_RestoreFromConfigCache( buildContext_t *context, const configBuild_t *builds, configBuild_t *build, compilerBackend_t *compilerBackend, const BuilderOptions *options ) {
+	// a forced rebuild never takes anything out of the cache
+	if ( context->forceRebuild ) {
+		return false;
+	}
+
+	u64 configKey = BuildBinary_GetConfigCacheKey( context, builds, build, compilerBackend, options );
+	if ( configKey == 0 ) {
+		return false;
+	}
+
+	u64 entryHash = CompileCache_FindConfig( context->compileCache, configKey );
+	if ( entryHash == 0 ) {
+		return false;
+	}
+
+	const char *fullBinaryName = BuildConfig_GetFullBinaryName( build->config, Mem_GetTempStorage() );
+
+	// the link hash of a binary that came out of (or went into) the config cache is its entry hash
+	// so if its the same then the binary we have is already the one in the cache
+	if ( IncludeDependencyDB_GetLinkHash( context->includeDependencyDB, fullBinaryName ) == entryHash && FS_FileExists( fullBinaryName ) ) {
+		build->result = BUILD_RESULT_SKIPPED;
+	} else {
+		if ( !CompileCache_RestoreConfig( context->compileCache, configKey, entryHash, fullBinaryName ) ) {
+			LogVerbose( "Found \"%s\" in the compile cache, but couldn't restore it.\n", fullBinaryName );
+			return false;
+		}
+
+		IncludeDependencyDB_SetLinkHash( context->includeDependencyDB, fullBinaryName, entryHash );
+
+		printf( "Restored \"%s\" from the compile cache.\n", fullBinaryName );
+
+		build->result = BUILD_RESULT_SUCCESS;
+	}
+
+	build->configCacheEntryHash = entryHash;
+	build->configCacheHit = true;
+
+	return true;
+}
+
+// adds the binary this config just built (or found was already up to date) to the config cache
+// main thread only
+static void BuildBinary_StoreInConfigCache( buildContext_t *context, const configBuild_t *builds, configBuild_t *build, compilerBackend_t *compilerBackend, const BuilderOptions *options ) {
+	u64 configKey = BuildBinary_GetConfigCacheKey( context, builds, build, compilerBackend, options );
+	if ( configKey == 0 ) {
+		return;
+	}
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	const includeDependencyDB_t *db = context->includeDependencyDB;
+
+	// every header that any of the source files included
+	// the compile jobs have all finished and written their include dependencies into the database by now
+	std::vector<const char *> includeDependencies;
+
+	For ( u64, intermediateFileIndex, 0, build->intermediateFiles.size() ) {
+		u32 recordIndex = IncludeDependencyDB_FindRecord( db, build->intermediateFiles[intermediateFileIndex].c_str() );
+		if ( recordIndex == INCLUDE_DEPENDENCY_DB_INVALID_INDEX ) {
+			return;
+		}
+
+		const includeDependencyRecord_t *record = IncludeDependencyDB_GetRecord( db, recordIndex );
+		For ( u32, dependencyIndex, 0, record->numDependencies ) {
+			includeDependencies.push_back( IncludeDependencyDB_GetString( db, IncludeDependencyDB_GetDependency( db, record, dependencyIndex ) ) );
+		}
+	}
+
+	const char *fullBinaryName = BuildConfig_GetFullBinaryName( build->config, Mem_GetTempStorage() );
+
+	u64 entryHash = CompileCache_StoreConfig( context->compileCache, configKey, includeDependencies.data(), includeDependencies.size(), fullBinaryName );
+	if ( entryHash == 0 ) {
+		LogVerbose( "Couldn't add \"%s\" to the compile cache.\n", fullBinaryName );
+		return;
+	}
+
+	IncludeDependencyDB_SetLinkHash( context->includeDependencyDB, fullBinaryName, entryHash );
+
+	build->configCacheEntryHash = entryHash;
+}
+
+// the file that the given source file compiles to, which is also what the include dependency database knows the source file by
+static const char *BuildConfig_GetIntermediateFilename( const BuildConfig *config, const char *sourceFile ) {
+	string_t sourceFileNoPath = String_Set( sourceFile );
+	sourceFileNoPath = Path_RemovePathFromFile( &sourceFileNoPath );
+
+	string_t sourceFileNoPathAndExtension = Path_RemoveFileExtension( &sourceFileNoPath );
+
+	return TempPrintf( "%s%c%s.o", config->intermediateFolder.c_str(), PATH_SEPARATOR, String_Cstr( &sourceFileNoPathAndExtension ) );
+}
+
+// headers that changed more recently than this dont get added to an automatic precompiled header, see pch_advisor.h
+#define AUTOMATIC_PCH_RECENTLY_CHANGED_DAYS	7ULL
+
+// headers that more commits than this changed in the last HEADER_IMPACT_COMMIT_DAYS days dont go in an automatic precompiled header, and get taken out if they were in it already
+// roughly once a week
+#define AUTOMATIC_PCH_MAX_COMMITS			12
+
+// where the header that BuildConfig::automaticPrecompiledHeader generates goes
+// this cant be straight in the intermediate folder because thats where the precompiled header's wrapper goes, and that has the same name (see Clang_CompilePrecompiledHeader())
+static const char *BuildConfig_GetAutomaticPrecompiledHeaderFilename( const BuildConfig *config ) {
+	return TempPrintf( "%s%cautomatic_pch%c%s_pch.h", config->intermediateFolder.c_str(), PATH_SEPARATOR, PATH_SEPARATOR, config->binaryName.c_str() );
+}
+
+// which headers went in the automatic precompiled header last time, see PCHAdvisor_GetSelection()
+static const char *BuildConfig_GetAutomaticPrecompiledHeaderSelectionFilename( const BuildConfig *config ) {
+	return TempPrintf( "%s%cautomatic_pch%c%s_pch_selection.txt", config->intermediateFolder.c_str(), PATH_SEPARATOR, PATH_SEPARATOR, config->binaryName.c_str() );
+}
+
+// works out which headers should go in the config's precompiled header, see pch_advisor.h
+// the config's source files have to have been globbed already
+// 'commitCounts' comes from GetRecentCommitCounts() and can be NULL
+static void BuildConfig_GetPCHAdvice( buildContext_t *context, const BuildConfig *config, const hashmap_t *commitCounts, pchAdvice_t *outAdvice ) {
+	u64 numSourceFiles = config->sourceFiles.size();
+
+	const char **intermediateFilenames = Cast( const char **, Mem_TempAlloc( Max( numSourceFiles, Cast( u64, 1 ) ) * sizeof( const char * ) ) );
+	For ( u64, sourceFileIndex, 0, numSourceFiles ) {
+		intermediateFilenames[sourceFileIndex] = BuildConfig_GetIntermediateFilename( config, config->sourceFiles[sourceFileIndex].c_str() );
+	}
+
+	// every source file "includes" everything in the precompiled header it already has, so that mustnt count as a header they include
+	const char *precompiledHeader = config->precompiledHeader.empty() ? BuildConfig_GetAutomaticPrecompiledHeaderFilename( config ) : config->precompiledHeader.c_str();
+
+	string_t precompiledHeaderNoPath = String_Set( precompiledHeader );
+	precompiledHeaderNoPath = Path_RemovePathFromFile( &precompiledHeaderNoPath );
+
+	const char *ignoreHeaders[] = {
+		precompiledHeader,
+		TempPrintf( "%s%c%s", config->intermediateFolder.c_str(), PATH_SEPARATOR, String_Cstr( &precompiledHeaderNoPath ) ),
+	};
+
+	// the headers that went in last time stay in unless they started changing too often, so that the precompiled header doesnt keep changing
+	array_t<const char *> previousSelection;
+	previousSelection.Init( Mem_GetTempStorage() );
+
+	string_t selectionFile = {};
+	if ( FS_ReadEntireFile( BuildConfig_GetAutomaticPrecompiledHeaderSelectionFilename( config ), &selectionFile ) ) {
+		char *selection = Cast( char *, Mem_TempAlloc( selectionFile.count + 1 ) );
+		memcpy( selection, selectionFile.data, selectionFile.count );
+		selection[selectionFile.count] = 0;
+
+		FS_FreeFileBuffer( &selectionFile );
+
+		PCHAdvisor_ParseSelection( selection, &previousSelection );
+	}
+
+	pchHistory_t history = {
+		.previousSelection		= previousSelection.data,
+		.numPreviousSelection	= TruncCast( u32, previousSelection.count ),
+		.commitCounts			= commitCounts,
+		.maxCommits				= AUTOMATIC_PCH_MAX_COMMITS,
+		.recentlyChangedTime	= FS_GetCurrentFileTime() - ( AUTOMATIC_PCH_RECENTLY_CHANGED_DAYS * 24 * 60 * 60 * FILE_TIME_UNITS_PER_SECOND ),
+	};
+
+	PCHAdvisor_Analyse( context->includeDependencyDB, intermediateFilenames, TruncCast( u32, numSourceFiles ), ignoreHeaders, COUNT_OF( ignoreHeaders ), &history, Mem_GetTempStorage(), outAdvice );
+}
+
+// how far back --header-impact looks in the git history to see how often each header changes
+#define HEADER_IMPACT_COMMIT_DAYS	90
+
+// counts how many commits changed each file in the last HEADER_IMPACT_COMMIT_DAYS days, keyed the way HeaderImpact_Analyse() wants them
+// returns NULL if git isnt installed or the build source file isnt in a git repository
+static hashmap_t *GetRecentCommitCounts( const buildContext_t *context, linearAllocator_t *allocator ) {
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	array_t<const char *> args;
+	args.Init( Mem_GetTempStorage() );
+	args.Add( "git" );
+	args.Add( "-C" );
+	args.Add( context->inputFilePath.data );
+	args.Add( "rev-parse" );
+	args.Add( "--show-toplevel" );
+
+	string_t topLevel = {};
+	if ( RunProc( &args, NULL, 0, &topLevel ) != 0 || topLevel.count == 0 ) {
+		LogVerbose( "Couldn't find the git repository that \"%s\" is in, so I won't know how often each header changes.\n", context->inputFilePath.data );
+		return NULL;
+	}
+
+	while ( topLevel.count > 0 && ( topLevel.data[topLevel.count - 1] == '\n' || topLevel.data[topLevel.count - 1] == '\r' ) ) {
+		topLevel.count -= 1;
+	}
+
+	const char *topLevelFolder = String_Cstr( &topLevel );
+
+	// every file each commit changed, relative to the top of the repository, and a blank line between commits
+	args.Reset();
+	args.Add( "git" );
+	args.Add( "-C" );
+	args.Add( topLevelFolder );
+	args.Add( "-c" );
+	args.Add( "core.quotePath=false" );
+	args.Add( "log" );
+	args.Add( TempPrintf( "--since=%u.days.ago", HEADER_IMPACT_COMMIT_DAYS ) );
+	args.Add( "--format=" );
+	args.Add( "--name-only" );
+
+	string_t log = {};
+	if ( RunProc( &args, NULL, 0, &log ) != 0 ) {
+		LogVerbose( "Couldn't read the git history of \"%s\", so I won't know how often each header changes.\n", topLevelFolder );
+		return NULL;
+	}
+
+	hashmap_t *commitCounts = HM_Create( allocator, 1024 );
+
+	const char *line = log.data;
+	const char *logEnd = log.data + log.count;
+
+	while ( line && line < logEnd ) {
+		const char *lineEnd = line;
+		while ( lineEnd < logEnd && *lineEnd != '\n' && *lineEnd != '\r' ) {
+			lineEnd += 1;
+		}
+
+		if ( lineEnd > line ) {
+			u64 key = HeaderImpact_HashPath( TempPrintf( "%s/%.*s", topLevelFolder, TruncCast( int, lineEnd - line ), line ) );
+
+			u32 numCommits = HM_GetValue( commitCounts, key );
+			HM_SetValue( commitCounts, key, ( numCommits == HASHMAP_INVALID_VALUE ) ? 1 : numCommits + 1 );
+		}
+
+		line = lineEnd + 1;
+	}
+
+	return commitCounts;
+}
+
+static void BuildConfig_PrintHeaderImpact( buildContext_t *context, const BuildConfig *config, const hashmap_t *commitCounts ) {
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	u64 numSourceFiles = config->sourceFiles.size();
+
+	const char **intermediateFilenames = Cast( const char **, Mem_TempAlloc( Max( numSourceFiles, Cast( u64, 1 ) ) * sizeof( const char * ) ) );
+	For ( u64, sourceFileIndex, 0, numSourceFiles ) {
+		intermediateFilenames[sourceFileIndex] = BuildConfig_GetIntermediateFilename( config, config->sourceFiles[sourceFileIndex].c_str() );
+	}
+
+	headerImpactReport_t report;
+	HeaderImpact_Analyse( context->includeDependencyDB, intermediateFilenames, TruncCast( u32, numSourceFiles ), commitCounts, HEADER_IMPACT_COMMIT_DAYS, Mem_GetTempStorage(), &report );
+
+	HeaderImpact_PrintReport( &report, config->name.empty() ? config->binaryName.c_str() : config->name.c_str() );
+}
+
+// writes 'contents' to 'filename', but only if thats not whats in it already
+// returns false if it had to write it and couldnt
+static bool8 WriteFileIfChanged( const char *filename, const char *contents, bool8 *outChanged ) {
+	string_t oldContents = {};
+	bool8 upToDate = false;
+	if ( FS_ReadEntireFile( filename, &oldContents ) ) {
+		upToDate = oldContents.count == strlen( contents ) && memcmp( oldContents.data, contents, oldContents.count ) == 0;
+		FS_FreeFileBuffer( &oldContents );
+	}
+
+	*outChanged = !upToDate;
+
+	if ( upToDate ) {
+		return true;
+	}
+
+	if ( !FS_WriteEntireFile( filename, contents, strlen( contents ) ) ) {
+		s32 errorCode = GetLastErrorCode();
+		Error( "Failed to write \"%s\".  Error code: " ERROR_CODE_FORMAT "\n", filename, errorCode );
+		return false;
+	}
+
+	return true;
+}
+
+// picks the headers for the config's precompiled header and points the config at it, see BuildConfig::automaticPrecompiledHeader
+// the generated header only gets written when the headers that go in it change, because that means every source file in the config has to compile again
+// which headers got picked gets saved too, so that next time they stay in unless they start changing too often
+// returns false if the header couldnt be written
+static bool8 BuildConfig_UpdateAutomaticPrecompiledHeader( buildContext_t *context, BuildConfig *config, const hashmap_t *commitCounts ) {
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	pchAdvice_t advice;
+	BuildConfig_GetPCHAdvice( context, config, commitCounts, &advice );
+
+	// nothing to go on (like the first time the config builds, or after the .builder folder got deleted), so build without one
+	// and dont forget what got picked before, since that hasnt changed
+	if ( advice.numSourceFilesCompiled == 0 ) {
+		LogVerbose( "None of the source files in BuildConfig \"%s\" have compiled yet, so there's nothing to pick precompiled headers from.\n", config->name.c_str() );
+		return true;
+	}
+
+	const char *automaticHeader = BuildConfig_GetAutomaticPrecompiledHeaderFilename( config );
+
+	string_t automaticHeaderFolder = String_Set( automaticHeader );
+	automaticHeaderFolder = Path_RemoveFileFromPath( &automaticHeaderFolder );
+
+	const char *folders[] = {
+		config->binaryFolder.c_str(),
+		config->intermediateFolder.c_str(),
+		String_Cstr( &automaticHeaderFolder ),
+	};
+
+	For ( u64, folderIndex, 0, COUNT_OF( folders ) ) {
+		if ( !FS_CreateFolderIfItDoesntExist( folders[folderIndex] ) ) {
+			s32 errorCode = GetLastErrorCode();
+			Error( "Failed to create folder \"%s\".  Error code: " ERROR_CODE_FORMAT "\n", folders[folderIndex], errorCode );
+			return false;
+		}
+	}
+
+	bool8 selectionChanged = false;
+	if ( !WriteFileIfChanged( BuildConfig_GetAutomaticPrecompiledHeaderSelectionFilename( config ), PCHAdvisor_GetSelection( &advice, Mem_GetTempStorage() ), &selectionChanged ) ) {
+		return false;
+	}
+
+	const char *contents = PCHAdvisor_GetHeaderContents( &advice, Mem_GetTempStorage() );
+
+	if ( !contents ) {
+		LogVerbose( "None of the headers that BuildConfig \"%s\" includes are worth precompiling yet.\n", config->name.c_str() );
+		return true;
+	}
+
+	bool8 headerChanged = false;
+	if ( !WriteFileIfChanged( automaticHeader, contents, &headerChanged ) ) {
+		return false;
+	}
+
+	if ( headerChanged ) {
+		printf( "Precompiled header for config \"%s\" now has %u headers in it, expected to save %.0f ms per full rebuild.\n", config->name.c_str(), advice.numSelected, advice.savingsMS );
+	}
+
+	config->precompiledHeader = automaticHeader;
+
+	return true;
+}
+
+// how many entries of each list the time report prints, the JSON version always has all of them
+#define TIME_REPORT_MAX_ENTRIES	20
+
+// adds up the time trace that clang wrote next to each of the config's object files, then prints the report and writes it next to them as text and JSON, see time_trace.h
+// returns false if the report couldnt be written
+static bool8 BuildConfig_WriteTimeReport( const BuildConfig *config ) {
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	timeTraceReport_t report;
+	TimeTrace_Init( &report, Mem_GetTempStorage() );
+
+	For ( u64, sourceFileIndex, 0, config->sourceFiles.size() ) {
+		string_t intermediateFilename = String_Set( BuildConfig_GetIntermediateFilename( config, config->sourceFiles[sourceFileIndex].c_str() ) );
+		string_t traceFilename = Path_RemoveFileExtension( &intermediateFilename );
+
+		const char *traceFile = TempPrintf( "%s.json", String_Cstr( &traceFilename ) );
+
+		if ( !TimeTrace_AddTraceFile( &report, traceFile ) ) {
+			Warning( "Couldn't read the time trace for \"%s\" (it should be \"%s\"), so it's left out of the time report.\n", config->sourceFiles[sourceFileIndex].c_str(), traceFile );
+		}
+	}
+
+	TimeTrace_Sort( &report );
+
+	const char *configName = config->name.empty() ? config->binaryName.c_str() : config->name.c_str();
+
+	stringBuilder_t text = SB_Create( Mem_GetTempStorage() );
+	TimeTrace_WriteTextReport( &report, configName, TIME_REPORT_MAX_ENTRIES, &text );
+
+	printf( "%s", SB_ToString( &text ) );
+
+	// the text version gets everything too, the printed one only has room for the top of each list
+	stringBuilder_t fullText = SB_Create( Mem_GetTempStorage() );
+	TimeTrace_WriteTextReport( &report, configName, U32_MAX, &fullText );
+
+	stringBuilder_t json = SB_Create( Mem_GetTempStorage() );
+	TimeTrace_WriteJSONReport( &report, configName, &json );
+
+	const char *reportFilename = TempPrintf( "%s%c%s_time_report", config->intermediateFolder.c_str(), PATH_SEPARATOR, config->binaryName.c_str() );
+
+	if ( !WriteStringBuilderToFile( &fullText, TempPrintf( "%s.txt", reportFilename ) ) || !WriteStringBuilderToFile( &json, TempPrintf( "%s.json", reportFilename ) ) ) {
+		return false;
+	}
+
+	printf( "    Written to \"%s.txt\" and \"%s.json\".\n\n", reportFilename, reportFilename );
+
+	return true;
+}
+
+// source files that were edited more recently than this compile on their own instead of in their unity batch, see unity_build.h
+#define UNITY_RECENTLY_EDITED_HOURS	24ULL
+
+// everything about a config's unity build that has to last for the whole build, see BuildConfig::unityBuild
+struct unityConfig_t {
+	// the config's source files from before they got put in batches
+	std::vector<std::string>		sourceFiles;
+
+	unityBuild_t					unity;
+
+	// the batches this build compiles, the source file that got generated for each of them, and which source files are in it (indices into unityBuild_t::sourceFiles)
+	std::vector<u32>				batchIndices;
+	std::vector<std::string>		batchSourceFiles;
+	std::vector<std::vector<u32>>	batchFileIndices;
+
+	// indices into unityBuild_t::sourceFiles of the source files that got taken out of batches that failed to compile
+	// theyre compiling on their own to see if they only failed because they clash with each other
+	std::vector<u32>				separatedFileIndices;
+};
+
+// where the generated source files for the config's unity batches go, and where we remember which batch each source file is in
+static const char *BuildConfig_GetUnityBuildFolder( const BuildConfig *config ) {
+	return TempPrintf( "%s%cunity", config->intermediateFolder.c_str(), PATH_SEPARATOR );
+}
+
+static const char *BuildConfig_GetUnityBatchesFilename( const BuildConfig *config ) {
+	return TempPrintf( "%s%c%s_unity_batches.txt", BuildConfig_GetUnityBuildFolder( config ), PATH_SEPARATOR, config->binaryName.c_str() );
+}
+
+// works out which batch each of the config's source files goes in, see BuildConfig::unityBuild
+// only does anything the first time its called for a config, after that the batches stay the same for the rest of the build
+// the config's source files (and the files in BuildConfig::unityExcludedFiles and BuildConfig::sourceFilePools) have to have been globbed already
+// if 'writeFiles' is false then the batches only get worked out, and nothing gets saved for next time (like when all we want is a report)
+static bool8 BuildConfig_AssignUnityBatches( buildContext_t *context, BuildConfig *config, unityConfig_t *unityConfig, const bool8 writeFiles ) {
+	if ( unityConfig->unity.allocator ) {
+		return true;
+	}
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	unityConfig->sourceFiles = config->sourceFiles;
+
+	UnityBuild_Init( &unityConfig->unity, context->allocator );
+
+	const char *unityBuildFolder = BuildConfig_GetUnityBuildFolder( config );
+	const char *batchesFilename = BuildConfig_GetUnityBatchesFilename( config );
+
+	const char *folders[] = {
+		config->binaryFolder.c_str(),
+		config->intermediateFolder.c_str(),
+		unityBuildFolder,
+	};
+
+	if ( writeFiles ) {
+		For ( u64, folderIndex, 0, COUNT_OF( folders ) ) {
+			if ( !FS_CreateFolderIfItDoesntExist( folders[folderIndex] ) ) {
+				s32 errorCode = GetLastErrorCode();
+				Error( "Failed to create folder \"%s\".  Error code: " ERROR_CODE_FORMAT "\n", folders[folderIndex], errorCode );
+				return false;
+			}
+		}
+	}
+
+	// nothing from last time just means everything goes in a batch from scratch
+	if ( !UnityBuild_Load( &unityConfig->unity, batchesFilename ) ) {
+		LogVerbose( "No unity batches from last time for BuildConfig \"%s\", putting every source file in one from scratch.\n", config->name.c_str() );
+	}
+
+	// the source files that never go in a batch
+	// these got globbed exactly the same way as the config's source files, so comparing paths is enough
+	hashmap_t *excludedFiles = HM_Create( Mem_GetTempStorage(), 64 );
+
+	For ( u64, excludedFileIndex, 0, config->unityExcludedFiles.size() ) {
+		HM_SetValue( excludedFiles, HashString( config->unityExcludedFiles[excludedFileIndex].c_str(), 0 ), 1 );
+	}
+
+	// source files that the user put in a different pool are usually the heavy ones, so they dont want to be stuck in a batch with anything else
+	For ( u64, sourceFilePoolIndex, 0, config->sourceFilePools.size() ) {
+		const SourceFilePool *sourceFilePool = &config->sourceFilePools[sourceFilePoolIndex];
+
+		For ( u64, fileIndex, 0, sourceFilePool->sourceFiles.size() ) {
+			HM_SetValue( excludedFiles, HashString( sourceFilePool->sourceFiles[fileIndex].c_str(), 0 ), 1 );
+		}
+	}
+
+	std::vector<const char *> candidates;
+	candidates.reserve( config->sourceFiles.size() );
+
+	For ( u64, sourceFileIndex, 0, config->sourceFiles.size() ) {
+		const char *sourceFile = config->sourceFiles[sourceFileIndex].c_str();
+
+		if ( !FileIsSourceFile( sourceFile ) || HM_GetValue( excludedFiles, HashString( sourceFile, 0 ) ) != HASHMAP_INVALID_VALUE ) {
+			continue;
+		}
+
+		// a module declaration has to be the first thing in its translation unit, and imports need to know where each module's compiled interface is
+		// neither of those work once the source file gets #included into a batch
+		if ( config->cppModules ) {
+			moduleScan_t scan;
+			if ( ModuleScanner_ScanFile( sourceFile, Mem_GetTempStorage(), &scan ) && ( scan.exportedModule || scan.importedModules.count > 0 ) ) {
+				continue;
+			}
+		}
+
+		candidates.push_back( sourceFile );
+	}
+
+	u32 batchSize = ( config->unityBatchSize > 0 ) ? config->unityBatchSize : UNITY_BUILD_DEFAULT_BATCH_SIZE;
+
+	UnityBuild_AssignBatches( &unityConfig->unity, candidates.data(), TruncCast( u32, candidates.size() ), batchSize );
+
+	if ( writeFiles && !UnityBuild_Save( &unityConfig->unity, batchesFilename ) ) {
+		s32 errorCode = GetLastErrorCode();
+		Error( "Failed to write \"%s\".  Error code: " ERROR_CODE_FORMAT "\n", batchesFilename, errorCode );
+		return false;
+	}
+
+	return true;
+}
+
+// generates a source file for every unity batch that has more than one source file to compile in it, and points the config at those instead of the source files in them
+// source files that are in a batch but were edited recently compile on their own instead, see unity_build.h
+// if 'writeFiles' is false then the config still gets pointed at the batches, but their source files dont get written
+static bool8 BuildConfig_GenerateUnityBatches( BuildConfig *config, unityConfig_t *unityConfig, const bool8 writeFiles ) {
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	const unityBuild_t *unity = &unityConfig->unity;
+
+	u64 numUnitySourceFiles = unity->sourceFiles.count;
+
+	const char **unitySourceFiles = Cast( const char **, Mem_TempAlloc( Max( numUnitySourceFiles, 1ULL ) * sizeof( const char * ) ) );
+	For ( u64, fileIndex, 0, numUnitySourceFiles ) {
+		unitySourceFiles[fileIndex] = unity->sourceFiles[fileIndex].filename;
+	}
+
+	bool8 *recentlyEdited = Cast( bool8 *, Mem_TempAlloc( Max( numUnitySourceFiles, 1ULL ) * sizeof( bool8 ) ) );
+
+	u64 recentlyEditedTime = FS_GetCurrentFileTime() - ( UNITY_RECENTLY_EDITED_HOURS * 60 * 60 * FILE_TIME_UNITS_PER_SECOND );
+
+	UnityBuild_FindRecentlyEditedFiles( unitySourceFiles, TruncCast( u32, numUnitySourceFiles ), recentlyEditedTime, recentlyEdited );
+
+	// which of the source files get compiled in each batch this time
+	std::vector<std::vector<u32>> batches;
+	batches.resize( unity->numBatches );
+
+	For ( u64, fileIndex, 0, numUnitySourceFiles ) {
+		const unitySourceFile_t *sourceFile = &unity->sourceFiles[fileIndex];
+
+		if ( sourceFile->batchIndex == UNITY_BATCH_NONE || sourceFile->collides ) {
+			continue;
+		}
+
+		if ( recentlyEdited[fileIndex] ) {
+			LogVerbose( "\"%s\" was edited recently, so it's compiling on its own instead of in unity batch %u.\n", sourceFile->filename, sourceFile->batchIndex );
+			continue;
+		}
+
+		batches[sourceFile->batchIndex].push_back( TruncCast( u32, fileIndex ) );
+	}
+
+	hashmap_t *batchedFiles = HM_Create( Mem_GetTempStorage(), Max( TruncCast( u32, numUnitySourceFiles * 2 ), 1U ) );
+
+	unityConfig->batchIndices.clear();
+	unityConfig->batchSourceFiles.clear();
+	unityConfig->batchFileIndices.clear();
+
+	For ( u32, batchIndex, 0, unity->numBatches ) {
+		const std::vector<u32> &batch = batches[batchIndex];
+
+		// a batch of one is just that source file with extra steps
+		if ( batch.size() < 2 ) {
+			continue;
+		}
+
+		const char **batchFiles = Cast( const char **, Mem_TempAlloc( batch.size() * sizeof( const char * ) ) );
+		For ( u64, fileIndex, 0, batch.size() ) {
+			batchFiles[fileIndex] = unity->sourceFiles[batch[fileIndex]].filename;
+		}
+
+		const char *extension = String_EndsWith( batchFiles[0], ".c" ) ? "c" : "cpp";
+		const char *batchSourceFile = TempPrintf( "%s%c%s_unity_%u.%s", BuildConfig_GetUnityBuildFolder( config ), PATH_SEPARATOR, config->binaryName.c_str(), batchIndex, extension );
+
+		if ( writeFiles ) {
+			const char *contents = UnityBuild_GetSourceFileContents( batchFiles, TruncCast( u32, batch.size() ), Mem_GetTempStorage() );
+
+			// only write it if its different, so it doesnt look like it changed when it didnt
+			string_t oldContents = {};
+			bool8 upToDate = false;
+			if ( FS_ReadEntireFile( batchSourceFile, &oldContents ) ) {
+				upToDate = String_Equals( oldContents.data, contents );
+				FS_FreeFileBuffer( &oldContents );
+			}
+
+			if ( !upToDate && !FS_WriteEntireFile( batchSourceFile, contents, strlen( contents ) ) ) {
+				s32 errorCode = GetLastErrorCode();
+				Error( "Failed to write \"%s\".  Error code: " ERROR_CODE_FORMAT "\n", batchSourceFile, errorCode );
+				return false;
+			}
+		}
+
+		unityConfig->batchIndices.push_back( batchIndex );
+		unityConfig->batchSourceFiles.push_back( batchSourceFile );
+		unityConfig->batchFileIndices.push_back( batch );
+
+		For ( u64, fileIndex, 0, batch.size() ) {
+			HM_SetValue( batchedFiles, HashString( batchFiles[fileIndex], 0 ), 1 );
+		}
+	}
+
+	// everything thats not in a batch compiles on its own, same as it would without a unity build
+	std::vector<std::string> sourceFiles;
+	sourceFiles.reserve( unityConfig->sourceFiles.size() );
+
+	For ( u64, sourceFileIndex, 0, unityConfig->sourceFiles.size() ) {
+		const std::string &sourceFile = unityConfig->sourceFiles[sourceFileIndex];
+
+		if ( HM_GetValue( batchedFiles, HashString( sourceFile.c_str(), 0 ) ) == HASHMAP_INVALID_VALUE ) {
+			sourceFiles.push_back( sourceFile );
+		}
+	}
+
+	u64 numSeparateFiles = sourceFiles.size();
+
+	sourceFiles.insert( sourceFiles.end(), unityConfig->batchSourceFiles.begin(), unityConfig->batchSourceFiles.end() );
+
+	LogVerbose( "Unity build for BuildConfig \"%s\": %" PRIu64 " source files in %" PRIu64 " batches, %" PRIu64 " on their own.\n", config->name.c_str(), unityConfig->sourceFiles.size() - numSeparateFiles, unityConfig->batchSourceFiles.size(), numSeparateFiles );
+
+	config->sourceFiles = sourceFiles;
+
+	return true;
+}
+
+// a unity batch can fail to compile just because its source files clash with each other once theyre in the same translation unit
+// so this takes the source files of every batch that failed out of it, so that the next build of the config compiles them on their own
+// returns true if any batches failed
+static bool8 BuildConfig_SeparateFailedUnityBatches( const configBuild_t *build, unityConfig_t *unityConfig ) {
+	BuildConfig *config = build->config;
+	unityBuild_t *unity = &unityConfig->unity;
+
+	unityConfig->separatedFileIndices.clear();
+
+	For ( u64, failedIndex, 0, build->failedSourceFileIndices.size() ) {
+		const std::string &failedSourceFile = config->sourceFiles[build->failedSourceFileIndices[failedIndex]];
+
+		For ( u64, batchSourceFileIndex, 0, unityConfig->batchSourceFiles.size() ) {
+			if ( unityConfig->batchSourceFiles[batchSourceFileIndex] != failedSourceFile ) {
+				continue;
+			}
+
+			const std::vector<u32> &batch = unityConfig->batchFileIndices[batchSourceFileIndex];
+
+			printf( "Unity batch \"%s\" failed to compile, so compiling its source files on their own to see if they just clash with each other.\n", failedSourceFile.c_str() );
+
+			// this doesnt get saved unless they all compile on their own, see BuildConfig_ConfirmUnityCollisions()
+			For ( u64, fileIndex, 0, batch.size() ) {
+				unity->sourceFiles[batch[fileIndex]].collides = true;
+				unityConfig->separatedFileIndices.push_back( batch[fileIndex] );
+			}
+
+			break;
+		}
+	}
+
+	return !unityConfig->separatedFileIndices.empty();
+}
+
+// source files from batches that failed that all compiled fine on their own clash with each other, so they stay out of batches for good
+// if any of them failed on their own too then the batch was just broken, so they go back in it
+static bool8 BuildConfig_ConfirmUnityCollisions( buildContext_t *context, BuildConfig *config, unityConfig_t *unityConfig ) {
+	unityBuild_t *unity = &unityConfig->unity;
+
+	if ( unityConfig->separatedFileIndices.empty() ) {
+		return true;
+	}
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	std::vector<bool8> batchesCompiled;
+	batchesCompiled.resize( unity->numBatches, true );
+
+	For ( u64, separatedIndex, 0, unityConfig->separatedFileIndices.size() ) {
+		const unitySourceFile_t *sourceFile = &unity->sourceFiles[unityConfig->separatedFileIndices[separatedIndex]];
+
+		u32 recordIndex = IncludeDependencyDB_FindRecord( context->includeDependencyDB, BuildConfig_GetIntermediateFilename( config, sourceFile->filename ) );
+
+		if ( recordIndex == INCLUDE_DEPENDENCY_DB_INVALID_INDEX || IncludeDependencyDB_GetRecord( context->includeDependencyDB, recordIndex )->inputsHash == 0 ) {
+			batchesCompiled[sourceFile->batchIndex] = false;
+		}
+	}
+
+	For ( u32, batchIndex, 0, unity->numBatches ) {
+		bool8 printedBatch = false;
+
+		For ( u64, separatedIndex, 0, unityConfig->separatedFileIndices.size() ) {
+			unitySourceFile_t *sourceFile = &unity->sourceFiles[unityConfig->separatedFileIndices[separatedIndex]];
+
+			if ( sourceFile->batchIndex != batchIndex ) {
+				continue;
+			}
+
+			if ( !batchesCompiled[batchIndex] ) {
+				sourceFile->collides = false;
+				continue;
+			}
+
+			if ( !printedBatch ) {
+				Warning( "These source files only compile on their own, not in the same unity batch, so Builder will compile them on their own from now on:\n" );
+				printedBatch = true;
+			}
+
+			printf( "    %s\n", sourceFile->filename );
+
+			unity->dirty = true;
+		}
+	}
+
+	unityConfig->separatedFileIndices.clear();
+
+	const char *batchesFilename = BuildConfig_GetUnityBatchesFilename( config );
+
+	if ( !UnityBuild_Save( unity, batchesFilename ) ) {
+		s32 errorCode = GetLastErrorCode();
+		Error( "Failed to write \"%s\".  Error code: " ERROR_CODE_FORMAT "\n", batchesFilename, errorCode );
+		return false;
+	}
+
+	return true;
+}
+
+enum moduleVisitState_t {
+	MODULE_VISIT_STATE_NOT_VISITED	= 0,
+	MODULE_VISIT_STATE_VISITING,
+	MODULE_VISIT_STATE_VISITED,
+};
+
+// works out every source file that exports a module the given source file needs, including the ones it only imports indirectly
+// depth first, so a module that ends up importing itself shows up as one were still in the middle of
+static bool8 BuildBinary_CollectModuleDependencies( const BuildConfig *config, const moduleScan_t *scans, const hashmap_t *moduleSourceFileIndices, const u32 sourceFileIndex, std::vector<moduleVisitState_t> &visitStates, std::vector<std::vector<u32>> &outDependencies ) {
+	visitStates[sourceFileIndex] = MODULE_VISIT_STATE_VISITING;
+
+	std::vector<u32> &dependencies = outDependencies[sourceFileIndex];
+
+	auto AddDependency = [&dependencies]( const u32 dependencyIndex ) {
+		For ( u64, index, 0, dependencies.size() ) {
+			if ( dependencies[index] == dependencyIndex ) {
+				return;
+			}
+		}
+
+		dependencies.push_back( dependencyIndex );
+	};
+
+	const moduleScan_t *scan = &scans[sourceFileIndex];
+
+	For ( u64, importIndex, 0, scan->importedModules.count ) {
+		const char *importedModule = scan->importedModules[importIndex];
+
+		u32 dependencyIndex = HM_GetValue( moduleSourceFileIndices, HashString( importedModule, 0 ) );
+
+		// could be one the compiler already knows about (like "std"), so let the compiler be the one to complain if it isnt
+		if ( dependencyIndex == HASHMAP_INVALID_VALUE ) {
+			LogVerbose( "\"%s\" imports module \"%s\", but none of the source files in this config export it.\n", config->sourceFiles[sourceFileIndex].c_str(), importedModule );
+			continue;
+		}
+
+		if ( visitStates[dependencyIndex] == MODULE_VISIT_STATE_VISITING ) {
+			Error( "Module \"%s\" ends up importing itself, through \"%s\".  Modules can't import each other in a circle.\n", importedModule, config->sourceFiles[sourceFileIndex].c_str() );
+			return false;
+		}
+
+		if ( visitStates[dependencyIndex] == MODULE_VISIT_STATE_NOT_VISITED ) {
+			if ( !BuildBinary_CollectModuleDependencies( config, scans, moduleSourceFileIndices, dependencyIndex, visitStates, outDependencies ) ) {
+				return false;
+			}
+		}
+
+		AddDependency( dependencyIndex );
+
+		const std::vector<u32> &indirectDependencies = outDependencies[dependencyIndex];
+		For ( u64, indirectIndex, 0, indirectDependencies.size() ) {
+			AddDependency( indirectDependencies[indirectIndex] );
+		}
+	}
+
+	visitStates[sourceFileIndex] = MODULE_VISIT_STATE_VISITED;
+
+	return true;
+}
+
+// scans every one of the config's source files for the module it exports and the modules it imports, and gets their module args from the backend (see BuildConfig::cppModules)
+// fills in configBuild_t::moduleDependencies
+// returns false if two source files export the same module, or if the imports go round in a circle
+static bool8 BuildBinary_ScanModules( buildContext_t *context, configBuild_t *build, compilerBackend_t *compilerBackend ) {
+	BuildConfig *config = build->config;
+
+	build->moduleDependencies.clear();
+
+	if ( !compilerBackend->GetModuleArgs ) {
+		Warning( "BuildConfig \"%s\" has cppModules turned on, but Builder can't do C++20 modules with this compiler yet.\n", config->name.c_str() );
+		return true;
+	}
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	u32 numSourceFiles = TruncCast( u32, config->sourceFiles.size() );
+
+	std::vector<moduleScan_t> scans;
+	scans.resize( numSourceFiles );
+
+	// the name of each module, and the source file that exports it
+	hashmap_t *moduleSourceFileIndices = HM_Create( Mem_GetTempStorage(), Max( numSourceFiles, 1U ) );
+
+	For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+		const char *sourceFile = config->sourceFiles[sourceFileIndex].c_str();
+
+		if ( !ModuleScanner_ScanFile( sourceFile, Mem_GetTempStorage(), &scans[sourceFileIndex] ) ) {
+			s32 errorCode = GetLastErrorCode();
+			Error( "Failed to read \"%s\" to find out what modules it exports and imports.  Error code: " ERROR_CODE_FORMAT "\n", sourceFile, errorCode );
+			return false;
+		}
+
+		const char *exportedModule = scans[sourceFileIndex].exportedModule;
+
+		if ( !exportedModule ) {
+			continue;
+		}
+
+		u64 moduleHash = HashString( exportedModule, 0 );
+		u32 otherSourceFileIndex = HM_GetValue( moduleSourceFileIndices, moduleHash );
+
+		if ( otherSourceFileIndex != HASHMAP_INVALID_VALUE ) {
+			Error( "\"%s\" and \"%s\" both export module \"%s\".\n", config->sourceFiles[otherSourceFileIndex].c_str(), sourceFile, exportedModule );
+			return false;
+		}
+
+		HM_SetValue( moduleSourceFileIndices, moduleHash, sourceFileIndex );
+	}
+
+	std::vector<std::vector<u32>> moduleDependencies;
+	moduleDependencies.resize( numSourceFiles );
+
+	std::vector<moduleVisitState_t> visitStates;
+	visitStates.resize( numSourceFiles, MODULE_VISIT_STATE_NOT_VISITED );
+
+	For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+		if ( visitStates[sourceFileIndex] == MODULE_VISIT_STATE_NOT_VISITED ) {
+			if ( !BuildBinary_CollectModuleDependencies( config, scans.data(), moduleSourceFileIndices, sourceFileIndex, visitStates, moduleDependencies ) ) {
+				return false;
+			}
+		}
+	}
+
+	// only the source files that export or import something get any module args
+	std::vector<moduleUnit_t> units;
+
+	For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+		const moduleScan_t *scan = &scans[sourceFileIndex];
+
+		if ( !scan->exportedModule && scan->importedModules.count == 0 ) {
+			continue;
+		}
+
+		const std::vector<u32> &dependencies = moduleDependencies[sourceFileIndex];
+
+		const char **importedModules = Cast( const char **, Mem_TempAlloc( Max( dependencies.size(), Cast( size_t, 1 ) ) * sizeof( const char * ) ) );
+		For ( u64, dependencyIndex, 0, dependencies.size() ) {
+			importedModules[dependencyIndex] = scans[dependencies[dependencyIndex]].exportedModule;
+		}
+
+		units.push_back( {
+			.sourceFile			= config->sourceFiles[sourceFileIndex].c_str(),
+			.exportedModule		= scan->exportedModule,
+			.importedModules	= importedModules,
+			.numImportedModules	= TruncCast( u32, dependencies.size() ),
+		} );
+	}
+
+	LogVerbose( "Found %" PRIu64 " source files in BuildConfig \"%s\" that export or import a module.\n", units.size(), config->name.c_str() );
+
+	compilationCommandArchetype_t *cmdArchetype = &build->cmdArchetype;
+
+	cmdArchetype->moduleArgsIndices = HM_Create( context->allocator, Max( TruncCast( u32, units.size() ), 1U ) );
+
+	For ( u32, unitIndex, 0, units.size() ) {
+		HM_SetValue( cmdArchetype->moduleArgsIndices, HashString( units[unitIndex].sourceFile, 0 ), unitIndex );
+	}
+
+	if ( !compilerBackend->GetModuleArgs( compilerBackend, config, units.data(), TruncCast( u32, units.size() ), *cmdArchetype ) ) {
+		return false;
+	}
+
+	build->moduleDependencies.swap( moduleDependencies );
+
+	return true;
+}
+
+// when a source file that exports a module compiles it makes a new compiled interface for that module, and everything that imports the module has to compile again against the new one
+// thats true even if nothing those source files include changed, so they wouldnt have gone stale on their own
+// a source file whose compiled interface went missing has to compile again too, even if its object file is fine
+static void BuildBinary_FindStaleModuleImporters( const configBuild_t *build, std::vector<bool8> &stale ) {
+	const compilationCommandArchetype_t *cmdArchetype = &build->cmdArchetype;
+
+	For ( u32, sourceFileIndex, 0, stale.size() ) {
+		if ( stale[sourceFileIndex] ) {
+			continue;
+		}
+
+		u32 moduleArgsIndex = HM_GetValue( cmdArchetype->moduleArgsIndices, HashString( build->config->sourceFiles[sourceFileIndex].c_str(), 0 ) );
+
+		if ( moduleArgsIndex == HASHMAP_INVALID_VALUE ) {
+			continue;
+		}
+
+		const std::string &moduleInterfaceFile = cmdArchetype->moduleInterfaceFiles[moduleArgsIndex];
+
+		if ( !moduleInterfaceFile.empty() && !FS_FileExists( moduleInterfaceFile.c_str() ) ) {
+			LogVerbose( "\"%s\" is missing, so \"%s\" has to compile again.\n", moduleInterfaceFile.c_str(), build->config->sourceFiles[sourceFileIndex].c_str() );
+			stale[sourceFileIndex] = true;
+		}
+	}
+
+	// the module dependencies include the modules each source file only imports indirectly, so one pass is enough
+	For ( u32, sourceFileIndex, 0, stale.size() ) {
+		if ( stale[sourceFileIndex] ) {
+			continue;
+		}
+
+		const std::vector<u32> &dependencies = build->moduleDependencies[sourceFileIndex];
+
+		For ( u64, dependencyIndex, 0, dependencies.size() ) {
+			if ( stale[dependencies[dependencyIndex]] ) {
+				stale[sourceFileIndex] = true;
+				break;
+			}
+		}
+	}
+}
+
+static float64 BuildBinary_GetModuleImportersTimeMS( std::vector<compileJob_t> &compileJobs, const u32 compileJobIndex, std::vector<bool8> &known ) {
+	compileJob_t *compileJob = &compileJobs[compileJobIndex];
+
+	if ( known[compileJobIndex] ) {
+		return compileJob->moduleImportersTimeMS;
+	}
+
+	float64 longestTimeMS = 0.0;
+
+	For ( u64, importerIndex, 0, compileJob->moduleImporterJobIndices.size() ) {
+		u32 importerJobIndex = compileJob->moduleImporterJobIndices[importerIndex];
+
+		float64 timeMS = compileJobs[importerJobIndex].predictedTimeMS + BuildBinary_GetModuleImportersTimeMS( compileJobs, importerJobIndex, known );
+
+		if ( timeMS > longestTimeMS ) {
+			longestTimeMS = timeMS;
+		}
+	}
+
+	// compileJobs never grows in here, so the pointer is still good
+	compileJob->moduleImportersTimeMS = longestTimeMS;
+	known[compileJobIndex] = true;
+
+	return longestTimeMS;
+}
+
+// makes every compile job that imports a module wait for the compile job that exports it, if that one is compiling too
+// anything that doesnt import a module thats compiling can start straight away, so the build goes as wide as the imports let it
+// also works out the longest chain of jobs waiting on each one, so that the ones holding up the most go first
+static void BuildBinary_OrderModuleCompileJobs( configBuild_t *build ) {
+	std::vector<compileJob_t> &compileJobs = build->compileJobs;
+
+	std::vector<u32> sourceFileJobIndices;
+	sourceFileJobIndices.resize( build->config->sourceFiles.size(), U32_MAX );
+
+	For ( u32, jobIndex, 0, compileJobs.size() ) {
+		sourceFileJobIndices[compileJobs[jobIndex].sourceFileIndex] = jobIndex;
+	}
+
+	For ( u32, jobIndex, 0, compileJobs.size() ) {
+		compileJob_t *compileJob = &compileJobs[jobIndex];
+
+		const std::vector<u32> &dependencies = build->moduleDependencies[compileJob->sourceFileIndex];
+
+		For ( u64, dependencyIndex, 0, dependencies.size() ) {
+			u32 dependencyJobIndex = sourceFileJobIndices[dependencies[dependencyIndex]];
+
+			// its up to date, so its compiled interface is already there
+			if ( dependencyJobIndex == U32_MAX ) {
+				continue;
+			}
+
+			compileJobs[dependencyJobIndex].moduleImporterJobIndices.push_back( jobIndex );
+			compileJob->numModulesWaitingFor++;
+		}
+	}
+
+	std::vector<bool8> known;
+	known.resize( compileJobs.size(), false );
+
+	For ( u32, jobIndex, 0, compileJobs.size() ) {
+		BuildBinary_GetModuleImportersTimeMS( compileJobs, jobIndex, known );
+	}
+}
+
+// runs on the main thread before any of this config's compile jobs get queued
+// works out which of the config's source files actually need compiling
+static buildResult_t BuildBinary_Prepare( buildContext_t *context, const configBuild_t *builds, configBuild_t *build, compilerBackend_t *compilerBackend, const BuilderOptions *options ) {
+	BuildConfig *config = build->config;
+
+	// create binary folder
+	if ( !FS_CreateFolderIfItDoesntExist( config->binaryFolder.c_str() ) ) {
+		s32 errorCode = GetLastErrorCode();
+		FatalError( "Failed to create the binary folder you specified inside %s: \"%s\".  Error code: " ERROR_CODE_FORMAT "", SET_BUILDER_OPTIONS_FUNC_NAME, config->binaryFolder.c_str(), errorCode );
+		return BUILD_RESULT_FAILED;
+	}
+
+	// create intermediate folder
+	if ( !FS_CreateFolderIfItDoesntExist( config->intermediateFolder.c_str() ) ) {
+		s32 errorCode = GetLastErrorCode();
+		FatalError( "Failed to create intermediate binary folder.  Error code: " ERROR_CODE_FORMAT "\n", errorCode );
+		return BUILD_RESULT_FAILED;
+	}
+
+	if ( config->OnPreBuild ) {
+		LogVerbose( "Found a OnPreBuild() func ptr for BuildConfig: \"%s\".  Running...\n", config->name.c_str() );
+
+		buildTraceSpan_t span = BuildTrace_BeginSpan( "callback", "OnPreBuild" );
+		config->OnPreBuild( config );
+		BuildTrace_EndSpan( &span, config->binaryName.c_str() );
+
+		// user code could have generated or changed any file, so dont trust anything we remembered from before
+		FileStatMemo_Invalidate( context->fileStatMemo );
+	}
+
+	build->intermediateFiles.resize( config->sourceFiles.size() );
+
+	// process_t only once how the base compilation command should look like, fill up dep/output/source args later for each source file
+	if ( !compilerBackend->GetCompilationCommandArchetype( compilerBackend, config, build->cmdArchetype ) ) {
+		Error( "Failed to generate compilation command.\n" );
+		return BUILD_RESULT_FAILED;
+	}
+
+	build->commandHash = GetCompilationCommandHash( compilerBackend, context->compileCache, &build->cmdArchetype );
+
+	// if the whole binary is in the config cache then we dont need to look at a single one of its source files
+	if ( BuildBinary_RestoreFromConfigCache( context, builds, build, compilerBackend, options ) ) {
+		build->compileJobs.clear();
+		build->numCompileJobsLeft = 0;
+
+		return BUILD_RESULT_SUCCESS;
+	}
+
+	if ( context->consolidateCompilerArgs ) {
+		printf( "Compiling with the following command line options for each source file:\n" );
+		For ( u32, argIndex, 0, build->cmdArchetype.baseArgs.count ) {
+			printf( "%s ", build->cmdArchetype.baseArgs[argIndex] );
+		}
+		printf( "\n" );
+	} else {
+		printf( "Compiling:\n" );
+	}
+
+	// make sure every source file has a record in the include dependency database
+	// records are keyed by the intermediate file, not the source file, because the same source file can be built by more than one config and each of those .o files goes stale independently
+	std::vector<compileJob_t> &compileJobs = build->compileJobs;
+	compileJobs.resize( config->sourceFiles.size() );
+
+	For ( u64, sourceFileIndex, 0, config->sourceFiles.size() ) {
+		u64 marker = Mem_TempTell();
+		defer { Mem_TempRewindTo( marker ); };
+
+		const char *sourceFile = config->sourceFiles[sourceFileIndex].c_str();
+
+		const char *intermediateFilename = BuildConfig_GetIntermediateFilename( config, sourceFile );
+		build->intermediateFiles[sourceFileIndex] = intermediateFilename;
+
+		u32 recordIndex = IncludeDependencyDB_FindRecord( context->includeDependencyDB, intermediateFilename );
+
+		if ( recordIndex == INCLUDE_DEPENDENCY_DB_INVALID_INDEX ) {
+			recordIndex = IncludeDependencyDB_AddRecord( context->includeDependencyDB, sourceFile, intermediateFilename );
+		}
+
+		compileJobs[sourceFileIndex].sourceFileIndex = TruncCast( u32, sourceFileIndex );
+		compileJobs[sourceFileIndex].recordIndex = recordIndex;
+		compileJobs[sourceFileIndex].numJobsInBatch = 1;
+		compileJobs[sourceFileIndex].numModulesWaitingFor = 0;
+		compileJobs[sourceFileIndex].moduleImporterJobIndices.clear();
+		compileJobs[sourceFileIndex].moduleImportersTimeMS = 0.0;
+	}
+
+	if ( config->cppModules && !BuildBinary_ScanModules( context, build, compilerBackend ) ) {
+		return BUILD_RESULT_FAILED;
+	}
+
+	// the precompiled header comes first, because if it needs compiling then so does every source file
+	build->compilingPrecompiledHeader = false;
+
+	if ( !config->precompiledHeader.empty() && !compilerBackend->CompilePrecompiledHeader ) {
+		Warning( "BuildConfig \"%s\" has a precompiled header, but Builder can't do precompiled headers with this compiler yet, so it won't be used.\n", config->name.c_str() );
+	}
+
+	if ( build->cmdArchetype.precompiledHeaderFile ) {
+		const char *precompiledHeaderFile = build->cmdArchetype.precompiledHeaderFile;
+
+		u32 recordIndex = IncludeDependencyDB_FindRecord( context->includeDependencyDB, precompiledHeaderFile );
+
+		if ( recordIndex == INCLUDE_DEPENDENCY_DB_INVALID_INDEX ) {
+			recordIndex = IncludeDependencyDB_AddRecord( context->includeDependencyDB, config->precompiledHeader.c_str(), precompiledHeaderFile );
+		}
+
+		const includeDependencyRecord_t *record = IncludeDependencyDB_GetRecord( context->includeDependencyDB, recordIndex );
+
+		compileJob_t *job = &build->precompiledHeaderJob;
+		*job = {};
+		job->recordIndex = recordIndex;
+		job->predictedTimeMS = record->compileTimeMS;
+		job->predictedPeakMemoryBytes = Cast( u64, ( record->peakMemoryMB > 0 ) ? record->peakMemoryMB : COMPILE_MEMORY_GUESS_MB ) * 1024 * 1024;
+
+		if ( ShouldRebuildSourceFile( context, config->precompiledHeader.c_str(), FS_FileExists( precompiledHeaderFile ), recordIndex, build->commandHash ) ) {
+			build->compilingPrecompiledHeader = true;
+		} else {
+			const includeDependencyDB_t *db = context->includeDependencyDB;
+
+			build->cmdArchetype.precompiledHeaderDependencies.clear();
+			For ( u32, dependencyIndex, 0, record->numDependencies ) {
+				build->cmdArchetype.precompiledHeaderDependencies.push_back( IncludeDependencyDB_GetString( db, IncludeDependencyDB_GetDependency( db, record, dependencyIndex ) ) );
+			}
+		}
+	}
+
+	// now work out which source files are actually out of date
+	// a no-op build of a big project is nothing but tens of thousands of stat calls, so rather than doing them one at a time get them all in one batch up front
+	// after that, the staleness checks only have to go to disk for files whose metadata changed since the last build
+	{
+		u64 numSourceFiles = config->sourceFiles.size();
+
+		const includeDependencyDB_t *db = context->includeDependencyDB;
+
+		std::vector<const char *> filesToStat;
+		filesToStat.reserve( numSourceFiles * 2 );
+
+		For ( u64, jobIndex, 0, compileJobs.size() ) {
+			const compileJob_t *job = &compileJobs[jobIndex];
+
+			filesToStat.push_back( config->sourceFiles[job->sourceFileIndex].c_str() );
+
+			const includeDependencyRecord_t *record = IncludeDependencyDB_GetRecord( db, job->recordIndex );
+			For ( u32, dependencyIndex, 0, record->numDependencies ) {
+				filesToStat.push_back( IncludeDependencyDB_GetString( db, IncludeDependencyDB_GetDependency( db, record, dependencyIndex ) ) );
+			}
+		}
+
+		FileStatMemo_PrefetchFileStats( context->fileStatMemo, filesToStat.data(), TruncCast( u32, filesToStat.size() ) );
+
+		// .o files get overwritten during the build so they dont go through the memo
+		std::vector<const char *> intermediateFilenames;
+		intermediateFilenames.resize( numSourceFiles );
+		For ( u64, sourceFileIndex, 0, numSourceFiles ) {
+			intermediateFilenames[sourceFileIndex] = build->intermediateFiles[sourceFileIndex].c_str();
+		}
+
+		std::vector<fileStat_t> intermediateFileStats;
+		intermediateFileStats.resize( numSourceFiles );
+
+		std::vector<bool8> intermediateFilesExist;
+		intermediateFilesExist.resize( numSourceFiles );
+
+		FS_GetFileStats( intermediateFilenames.data(), TruncCast( u32, numSourceFiles ), intermediateFileStats.data(), intermediateFilesExist.data() );
+
+		// do this before throwing away the jobs that are up to date, they still tell us how fast this config compiles
+		BuildBinary_PredictCompileCosts( context, build );
+
+		// theres one compile job for every source file at this point, in the same order
+		std::vector<bool8> stale;
+		stale.resize( numSourceFiles );
+
+		For ( u64, jobIndex, 0, compileJobs.size() ) {
+			const compileJob_t *job = &compileJobs[jobIndex];
+
+			stale[job->sourceFileIndex] = build->compilingPrecompiledHeader || ShouldRebuildSourceFile( context, config->sourceFiles[job->sourceFileIndex].c_str(), intermediateFilesExist[job->sourceFileIndex], job->recordIndex, build->commandHash );
+		}
+
+		if ( !build->moduleDependencies.empty() ) {
+			BuildBinary_FindStaleModuleImporters( build, stale );
+		}
+
+		u64 numStaleJobs = 0;
+
+		For ( u64, jobIndex, 0, compileJobs.size() ) {
+			if ( stale[compileJobs[jobIndex].sourceFileIndex] ) {
+				compileJobs[numStaleJobs++] = compileJobs[jobIndex];
+			}
+		}
+
+		compileJobs.resize( numStaleJobs );
+	}
+
+	if ( config->batchSmallSourceFiles ) {
+		if ( compilerBackend->CompileSourceFiles ) {
+			BuildBinary_BatchSmallCompileJobs( build, JobPool_GetMaxConcurrentJobs() );
+		} else {
+			Warning( "BuildConfig \"%s\" has batchSmallSourceFiles turned on, but Builder can't compile more than one source file at once with this compiler yet, so they'll compile one at a time.\n", config->name.c_str() );
+		}
+	}
+
+	// do this last, it needs to know where each compile job ended up
+	if ( !build->moduleDependencies.empty() ) {
+		BuildBinary_OrderModuleCompileJobs( build );
+	}
+
+	// the precompiled header counts as one of the compile jobs, so that the config cant link before its compiled even if it has no source files
+	build->numCompileJobsLeft = TruncCast( u32, compileJobs.size() ) + ( build->compilingPrecompiledHeader ? 1 : 0 );
+
+	printf( "Compiling %" PRIu64 " of %" PRIu64 " files.\n", compileJobs.size(), config->sourceFiles.size() );
+
+	return BUILD_RESULT_SUCCESS;
+}
+
+// runs on the main thread once all of this config's source files compiled and everything it depends on is finished
+// we only want to link if the binary doesnt exist, if the link command line changed, or if any of the intermediate files are newer than the binary
+static bool8 BuildBinary_ShouldLink( buildContext_t *context, configBuild_t *build, const BuilderOptions *options ) {
+	const char *fullBinaryName = BuildConfig_GetFullBinaryName( build->config, Mem_GetTempStorage() );
+
+	build->linkHash = GetLinkCommandHash( build->config, options, build->commandHash, build->intermediateFiles );
+
+	u64 binaryFileLastWriteTime = 0;
+
+	if ( !FS_GetFileLastWriteTime( fullBinaryName, &binaryFileLastWriteTime ) ) {
+		return true;
+	}
+
+	if ( IncludeDependencyDB_GetLinkHash( context->includeDependencyDB, fullBinaryName ) != build->linkHash ) {
+		LogVerbose( "Link command line for \"%s\" changed since it was last linked.\n", fullBinaryName );
+		return true;
+	}
+
+	const std::vector<std::string> &intermediateFiles = build->intermediateFiles;
+
+	std::vector<const char *> intermediateFilenames;
+	intermediateFilenames.resize( intermediateFiles.size() );
+	For ( u64, intermediateFileIndex, 0, intermediateFiles.size() ) {
+		intermediateFilenames[intermediateFileIndex] = intermediateFiles[intermediateFileIndex].c_str();
+	}
+
+	std::vector<fileStat_t> intermediateFileStats;
+	intermediateFileStats.resize( intermediateFiles.size() );
+
+	std::vector<bool8> intermediateFilesExist;
+	intermediateFilesExist.resize( intermediateFiles.size() );
+
+	FS_GetFileStats( intermediateFilenames.data(), TruncCast( u32, intermediateFiles.size() ), intermediateFileStats.data(), intermediateFilesExist.data() );
+
+	For ( u64, intermediateFileIndex, 0, intermediateFiles.size() ) {
+		// same as before, a missing .o file counts as being newer than the binary
+		if ( !intermediateFilesExist[intermediateFileIndex] || intermediateFileStats[intermediateFileIndex].lastWriteTime > binaryFileLastWriteTime ) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool8 BuildConfigs_DependenciesDone( const configBuild_t *builds, const configBuild_t *build ) {
+	For ( u64, dependencyIndex, 0, build->dependencyIndices.size() ) {
+		if ( builds[build->dependencyIndices[dependencyIndex]].state != CONFIG_BUILD_STATE_DONE ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// anything that imports a module that failed to compile would only fail too, so those dont get compiled at all
+// they still count as failed, so the config doesnt link and they get compiled next time
+// the jobs waiting on a module include the ones that only import it indirectly, so theres no need to go any further than these
+static void BuildConfigs_SkipModuleImporters( buildContext_t *context, configBuild_t *build, const u32 compileJobIndex ) {
+	const compileJob_t *compileJob = &build->compileJobs[compileJobIndex];
+
+	For ( u64, importerIndex, 0, compileJob->moduleImporterJobIndices.size() ) {
+		compileJob_t *importer = &build->compileJobs[compileJob->moduleImporterJobIndices[importerIndex]];
+
+		if ( importer->numModulesWaitingFor == MODULE_IMPORTER_SKIPPED ) {
+			continue;
+		}
+
+		importer->numModulesWaitingFor = MODULE_IMPORTER_SKIPPED;
+
+		build->numCompileJobsLeft--;
+		build->numCompileJobsFailed++;
+		build->failedSourceFileIndices.push_back( importer->sourceFileIndex );
+
+		IncludeDependencyDB_InvalidateRecord( context->includeDependencyDB, importer->recordIndex );
+
+		Error( "Not compiling \"%s\" because a module it imports failed to compile.\n", build->config->sourceFiles[importer->sourceFileIndex].c_str() );
+	}
+}
+
+// main thread only
+static void BuildConfigs_OnJobFinished( buildQueue_t *queue, const buildJob_t *job ) {
+	buildContext_t *context = queue->context;
+
+	configBuild_t *build = &queue->builds[job->buildIndex];
+
+	switch ( job->type ) {
+		case BUILD_JOB_TYPE_COMPILE: {
+			queue->lastCompileFinishTimeMS = Time_MS();
+
+			// a batch still succeeds or fails one source file at a time
+			u32 numJobsInBatch = build->compileJobs[job->compileJobIndex].numJobsInBatch;
+
+			For ( u32, batchJobIndex, 0, numJobsInBatch ) {
+				const compileJob_t *compileJob = &build->compileJobs[job->compileJobIndex + batchJobIndex];
+
+				build->numCompileJobsLeft--;
+
+				// if the compile failed then forget it so that it gets compiled again next time regardless
+				if ( !compileJob->succeeded ) {
+					build->numCompileJobsFailed++;
+					build->failedSourceFileIndices.push_back( compileJob->sourceFileIndex );
+
+					IncludeDependencyDB_InvalidateRecord( context->includeDependencyDB, compileJob->recordIndex );
+
+					BuildConfigs_SkipModuleImporters( context, build, job->compileJobIndex + batchJobIndex );
+
+					continue;
+				}
+
+				u64 marker = Mem_TempTell();
+				defer { Mem_TempRewindTo( marker ); };
+
+				const char **includeDependencies = Cast( const char **, Mem_TempAlloc( Max( compileJob->includeDependencies.size(), Cast( size_t, 1 ) ) * sizeof( const char * ) ) );
+				For ( u64, dependencyIndex, 0, compileJob->includeDependencies.size() ) {
+					includeDependencies[dependencyIndex] = compileJob->includeDependencies[dependencyIndex].c_str();
+				}
+
+				// round up so that a really quick file doesnt look like one we dont know the compile time of
+				u32 compileTimeMS = Cast( u32, compileJob->compileTimeMS ) + 1;
+
+				// 0 if the OS couldnt tell us, which is the same as not knowing
+				u32 peakMemoryMB = TruncCast( u32, ( compileJob->peakMemoryBytes + ( 1024 * 1024 ) - 1 ) / ( 1024 * 1024 ) );
+
+				// restoring from the compile cache says nothing about what a real compile costs, so keep whatever we knew before
+				if ( compileJob->cacheHit ) {
+					const includeDependencyRecord_t *record = IncludeDependencyDB_GetRecord( context->includeDependencyDB, compileJob->recordIndex );
+
+					compileTimeMS = record->compileTimeMS;
+					peakMemoryMB = record->peakMemoryMB;
+				}
+
+				IncludeDependencyDB_SetRecord( context->includeDependencyDB, compileJob->recordIndex, build->config->sourceFiles[compileJob->sourceFileIndex].c_str(), includeDependencies, TruncCast( u32, compileJob->includeDependencies.size() ), compileJob->inputsHash, build->commandHash, compileTimeMS, peakMemoryMB );
+			}
+		} break;
+
+		case BUILD_JOB_TYPE_PRECOMPILED_HEADER: {
+			const compileJob_t *compileJob = &build->precompiledHeaderJob;
+
+			const char *precompiledHeader = build->config->precompiledHeader.c_str();
+
+			build->compilingPrecompiledHeader = false;
+
+			queue->lastCompileFinishTimeMS = Time_MS();
+
+			// none of the source files got queued up, so theres nothing else left to wait for
+			if ( !job->succeeded ) {
+				build->numCompileJobsFailed++;
+				build->numCompileJobsLeft = 0;
+
+				IncludeDependencyDB_InvalidateRecord( context->includeDependencyDB, compileJob->recordIndex );
+
+				Error( "Compiling precompiled header \"%s\" failed.\n", precompiledHeader );
+
+				break;
+			}
+
+			build->numCompileJobsLeft--;
+
+			// every source file compiled after this needs to know what the precompiled header depends on
+			build->cmdArchetype.precompiledHeaderDependencies = compileJob->includeDependencies;
+
+			u64 marker = Mem_TempTell();
+			defer { Mem_TempRewindTo( marker ); };
+
+			const char **includeDependencies = Cast( const char **, Mem_TempAlloc( Max( compileJob->includeDependencies.size(), Cast( size_t, 1 ) ) * sizeof( const char * ) ) );
+			For ( u64, dependencyIndex, 0, compileJob->includeDependencies.size() ) {
+				includeDependencies[dependencyIndex] = compileJob->includeDependencies[dependencyIndex].c_str();
+			}
+
+			u32 compileTimeMS = Cast( u32, compileJob->compileTimeMS ) + 1;
+			u32 peakMemoryMB = TruncCast( u32, ( compileJob->peakMemoryBytes + ( 1024 * 1024 ) - 1 ) / ( 1024 * 1024 ) );
+
+			IncludeDependencyDB_SetRecord( context->includeDependencyDB, compileJob->recordIndex, precompiledHeader, includeDependencies, TruncCast( u32, compileJob->includeDependencies.size() ), compileJob->inputsHash, build->commandHash, compileTimeMS, peakMemoryMB );
+		} break;
+
+		case BUILD_JOB_TYPE_LINK: {
+			const char *fullBinaryName = BuildConfig_GetFullBinaryName( build->config, Mem_GetTempStorage() );
+
+			if ( !job->succeeded ) {
+				IncludeDependencyDB_SetLinkHash( context->includeDependencyDB, fullBinaryName, 0 );
+
+				Error( "Linking \"%s\" failed.\n", fullBinaryName );
+
+				build->result = BUILD_RESULT_FAILED;
+				build->state = CONFIG_BUILD_STATE_DONE;
+
+				break;
+			}
+
+			IncludeDependencyDB_SetLinkHash( context->includeDependencyDB, fullBinaryName, build->linkHash );
+
+			build->result = BUILD_RESULT_SUCCESS;
+			build->state = CONFIG_BUILD_STATE_LINKED;
+
+			BuildBinary_StoreInConfigCache( context, queue->builds, build, queue->compilerBackend, queue->options );
+		} break;
+	}
+}
+
+// the pending compile job is the config's precompiled header, not one of its source files
+#define PRECOMPILED_HEADER_JOB_INDEX	U32_MAX
+
+struct pendingCompileJob_t {
+	u32		buildIndex;
+	u32		compileJobIndex;	// PRECOMPILED_HEADER_JOB_INDEX if its the precompiled header
+	u32		poolIndex;
+	float64	predictedTimeMS;
+
+	// predictedTimeMS plus the longest chain of compile jobs that cant start until this one finishes, this is what the jobs get sorted by
+	float64	criticalPathMS;
+};
+
+// longest chain of work first
+// ties go in the order the configs and source files were given to us so the order is always the same
+static int ComparePendingCompileJobs( const void *a, const void *b ) {
+	const pendingCompileJob_t *jobA = Cast( const pendingCompileJob_t *, a );
+	const pendingCompileJob_t *jobB = Cast( const pendingCompileJob_t *, b );
+
+	if ( jobA->criticalPathMS != jobB->criticalPathMS ) return ( jobA->criticalPathMS > jobB->criticalPathMS ) ? -1 : 1;
+	if ( jobA->buildIndex != jobB->buildIndex ) return ( jobA->buildIndex < jobB->buildIndex ) ? -1 : 1;
+
+	return ( jobA->compileJobIndex < jobB->compileJobIndex ) ? -1 : ( jobA->compileJobIndex > jobB->compileJobIndex ) ? 1 : 0;
+}
+
+static void BuildConfigs_AddPendingCompileJob( std::vector<pendingCompileJob_t> *pendingCompileJobs, const configBuild_t *build, const u32 buildIndex, const u32 compileJobIndex ) {
+	const compileJob_t *compileJob = &build->compileJobs[compileJobIndex];
+
+	float64 predictedTimeMS = 0.0;
+	For ( u32, batchJobIndex, 0, compileJob->numJobsInBatch ) {
+		predictedTimeMS += compileJob[batchJobIndex].predictedTimeMS;
+	}
+
+	pendingCompileJobs->push_back( { buildIndex, compileJobIndex, build->sourceFilePoolIndices[compileJob->sourceFileIndex], predictedTimeMS, predictedTimeMS + compileJob->moduleImportersTimeMS } );
+}
+
+// a batch only gets one pending job, for its first compile job
+// jobs that are waiting on a module get added once its compiled, see BuildConfigs_AddModuleImporters()
+static void BuildConfigs_AddPendingCompileJobs( std::vector<pendingCompileJob_t> *pendingCompileJobs, const configBuild_t *build, const u32 buildIndex ) {
+	For ( u32, compileJobIndex, 0, build->compileJobs.size() ) {
+		const compileJob_t *compileJob = &build->compileJobs[compileJobIndex];
+
+		if ( compileJob->numJobsInBatch == 0 || compileJob->numModulesWaitingFor > 0 ) {
+			continue;
+		}
+
+		BuildConfigs_AddPendingCompileJob( pendingCompileJobs, build, buildIndex, compileJobIndex );
+	}
+}
+
+// once a module has compiled, anything that was only waiting on that can start
+// returns true if any of them got added
+static bool8 BuildConfigs_AddModuleImporters( std::vector<pendingCompileJob_t> *pendingCompileJobs, configBuild_t *build, const u32 buildIndex, const u32 compileJobIndex ) {
+	const compileJob_t *compileJob = &build->compileJobs[compileJobIndex];
+
+	bool8 added = false;
+
+	For ( u64, importerIndex, 0, compileJob->moduleImporterJobIndices.size() ) {
+		u32 importerJobIndex = compileJob->moduleImporterJobIndices[importerIndex];
+		compileJob_t *importer = &build->compileJobs[importerJobIndex];
+
+		// something else it imports failed
+		if ( importer->numModulesWaitingFor == MODULE_IMPORTER_SKIPPED ) {
+			continue;
+		}
+
+		Assert( importer->numModulesWaitingFor > 0 );
+		importer->numModulesWaitingFor--;
+
+		if ( importer->numModulesWaitingFor == 0 ) {
+			BuildConfigs_AddPendingCompileJob( pendingCompileJobs, build, buildIndex, importerJobIndex );
+			added = true;
+		}
+	}
+
+	return added;
+}
+
+// gets the remote compile cache looking for the outputs of each of these jobs, in the order they'll get handed out
+// jobs that got prefetched already are fine to pass in again, they just get skipped
+static void PrefetchPendingCompileJobs( buildContext_t *context, compilerBackend_t *compilerBackend, configBuild_t *builds, const std::vector<pendingCompileJob_t> &pendingCompileJobs ) {
+	compileCache_t *compileCache = context->compileCache;
+
+	// a forced rebuild never takes anything out of the cache
+	if ( !compileCache || !compileCache->remote || context->forceRebuild || !compilerBackend->GetCompileCommand ) {
+		return;
+	}
+
+	For ( u64, pendingJobIndex, 0, pendingCompileJobs.size() ) {
+		const pendingCompileJob_t *pendingJob = &pendingCompileJobs[pendingJobIndex];
+
+		// precompiled headers never go in the compile cache
+		if ( pendingJob->compileJobIndex == PRECOMPILED_HEADER_JOB_INDEX ) {
+			continue;
+		}
+
+		u64 marker = Mem_TempTell();
+		defer { Mem_TempRewindTo( marker ); };
+
+		configBuild_t *build = &builds[pendingJob->buildIndex];
+		const compileJob_t *compileJob = &build->compileJobs[pendingJob->compileJobIndex];
+
+		For ( u32, batchJobIndex, 0, compileJob->numJobsInBatch ) {
+			const char *sourceFile = build->config->sourceFiles[compileJob[batchJobIndex].sourceFileIndex].c_str();
+
+			array_t<const char *> args;
+			args.Init( Mem_GetTempStorage() );
+
+			if ( compilerBackend->GetCompileCommand( compilerBackend, context, build->config, build->cmdArchetype, sourceFile, &args ) ) {
+				CompileCache_Prefetch( compileCache, CompileCache_HashCommand( compileCache, &args ), sourceFile );
+			}
+		}
+	}
+}
+
+// how long we think it would take to get through all of these jobs if every thread takes the next one in order as soon as its free
+static float64 PredictMakespanMS( const std::vector<float64> &jobTimesMS, const u32 numThreads ) {
+	std::vector<float64> threadFinishTimesMS;
+	threadFinishTimesMS.resize( Max( numThreads, 1U ), 0.0 );
+
+	float64 makespanMS = 0.0;
+
+	For ( u64, jobIndex, 0, jobTimesMS.size() ) {
+		u64 freeThreadIndex = 0;
+		For ( u64, threadIndex, 1, threadFinishTimesMS.size() ) {
+			if ( threadFinishTimesMS[threadIndex] < threadFinishTimesMS[freeThreadIndex] ) {
+				freeThreadIndex = threadIndex;
+			}
+		}
+
+		threadFinishTimesMS[freeThreadIndex] += jobTimesMS[jobIndex];
+
+		if ( threadFinishTimesMS[freeThreadIndex] > makespanMS ) {
+			makespanMS = threadFinishTimesMS[freeThreadIndex];
+		}
+	}
+
+	return makespanMS;
+}
+
+// returns the index of the pool in BuilderOptions::resourcePools with the given name
+// RESOURCE_POOL_NONE if 'name' is empty or there isnt a pool with that name
+static u32 FindResourcePool( const BuilderOptions *options, const std::string &name ) {
+	if ( !options || name.empty() ) {
+		return RESOURCE_POOL_NONE;
+	}
+
+	For ( u64, poolIndex, 0, options->resourcePools.size() ) {
+		if ( options->resourcePools[poolIndex].name == name ) {
+			return TruncCast( u32, poolIndex );
+		}
+	}
+
+	return RESOURCE_POOL_NONE;
+}
+
+// returns the name of the first pool the config uses that isnt in BuilderOptions::resourcePools
+// NULL if every pool it uses is there
+static const char *BuildConfig_FindMissingResourcePool( const BuilderOptions *options, const BuildConfig *config ) {
+	if ( !config->compilePool.empty() && FindResourcePool( options, config->compilePool ) == RESOURCE_POOL_NONE ) {
+		return config->compilePool.c_str();
+	}
+
+	if ( !config->linkPool.empty() && FindResourcePool( options, config->linkPool ) == RESOURCE_POOL_NONE ) {
+		return config->linkPool.c_str();
+	}
+
+	For ( u64, sourceFilePoolIndex, 0, config->sourceFilePools.size() ) {
+		const std::string &pool = config->sourceFilePools[sourceFilePoolIndex].pool;
+
+		if ( FindResourcePool( options, pool ) == RESOURCE_POOL_NONE ) {
+			return pool.c_str();
+		}
+	}
+
+	return NULL;
+}
+
+// works out which pool each of the config's source files compiles in, and which pool it links in
+// SourceFilePool::sourceFiles has to have been globbed the same way as BuildConfig::sourceFiles, so that the same file has exactly the same path in both
+static void BuildConfigs_ResolvePools( const BuilderOptions *options, configBuild_t *build ) {
+	const BuildConfig *config = build->config;
+
+	u32 compilePoolIndex = FindResourcePool( options, config->compilePool );
+
+	build->linkPoolIndex = FindResourcePool( options, config->linkPool );
+	build->precompiledHeaderPoolIndex = compilePoolIndex;
+	build->sourceFilePoolIndices.assign( config->sourceFiles.size(), compilePoolIndex );
+
+	if ( config->sourceFilePools.empty() ) {
+		return;
+	}
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	hashmap_t *sourceFileIndices = HM_Create( Mem_GetTempStorage(), Max( TruncCast( u32, config->sourceFiles.size() * 2 ), 1U ) );
+
+	For ( u64, sourceFileIndex, 0, config->sourceFiles.size() ) {
+		HM_SetValue( sourceFileIndices, HashString( config->sourceFiles[sourceFileIndex].c_str(), 0 ), TruncCast( u32, sourceFileIndex ) );
+	}
+
+	std::vector<bool8> inSourceFilePool;
+	inSourceFilePool.resize( config->sourceFiles.size(), false );
+
+	For ( u64, sourceFilePoolIndex, 0, config->sourceFilePools.size() ) {
+		const SourceFilePool *sourceFilePool = &config->sourceFilePools[sourceFilePoolIndex];
+
+		u32 poolIndex = FindResourcePool( options, sourceFilePool->pool );
+
+		For ( u64, fileIndex, 0, sourceFilePool->sourceFiles.size() ) {
+			u32 sourceFileIndex = HM_GetValue( sourceFileIndices, HashString( sourceFilePool->sourceFiles[fileIndex].c_str(), 0 ) );
+
+			// not one of the files this config builds
+			if ( sourceFileIndex == HASHMAP_INVALID_VALUE ) {
+				continue;
+			}
+
+			// first one wins
+			if ( inSourceFilePool[sourceFileIndex] ) {
+				continue;
+			}
+
+			build->sourceFilePoolIndices[sourceFileIndex] = poolIndex;
+			inSourceFilePool[sourceFileIndex] = true;
+		}
+	}
+}
+
+// builds every config as one big dependency graph instead of one after the other
+// the source files of every config go into the same queue, so they all compile as soon as theres a thread free
+// each config links as soon as its own source files compiled and everything it depends on finished
+// 'builds' must be ordered so that every config comes after the configs it depends on (AddBuildConfigAndDependenciesUnique() does this)
+// if 'printConfigProgress' is set then print when each config starts and finishes, so the user can tell which output belongs to which config
+// returns true if every config built (or was already up to date)
+static bool8 BuildConfigs( buildContext_t *context, configBuild_t *builds, const u32 numBuilds, compilerBackend_t *compilerBackend, const BuilderOptions *options, const bool8 printConfigProgress ) {
+	buildTraceSpan_t span = BuildTrace_BeginSpan( "phase", "Compile and link" );
+	defer { BuildTrace_EndSpan( &span ); };
+
+	// every source file of every config gets its own slot in the compilation database so configs can fill theirs in at the same time
+	u64 numSourceFilesTotal = 0;
+
+	For ( u32, buildIndex, 0, numBuilds ) {
+		configBuild_t *build = &builds[buildIndex];
+
+		build->state = CONFIG_BUILD_STATE_WAITING;
+		build->result = BUILD_RESULT_FAILED;
+		build->compilationDatabaseOffset = numSourceFilesTotal;
+
+		numSourceFilesTotal += build->config->sourceFiles.size();
+
+		BuildConfigs_ResolvePools( options, build );
+
+		For ( u64, dependencyIndex, 0, build->config->dependsOn.size() ) {
+			const char *dependencyName = build->config->dependsOn[dependencyIndex].name.c_str();
+
+			For ( u32, otherBuildIndex, 0, buildIndex ) {
+				if ( builds[otherBuildIndex].config->name == dependencyName ) {
+					build->dependencyIndices.push_back( otherBuildIndex );
+					break;
+				}
+			}
+		}
+	}
+
+	if ( options && options->generateCompilationDatabase ) {
+		context->compilationDatabase.resize( numSourceFilesTotal );
+	}
+
+	buildQueue_t queue = {
+		.compilerBackend	= compilerBackend,
+		.context			= context,
+		.options			= options,
+		.builds				= builds,
+		.mutex				= Mutex_Create(),
+		.jobFinished		= Semaphore_Create( 0 ),
+	};
+
+	// at most one compile job per source file, and one precompiled header job and one link job per config
+	queue.jobs.reserve( numSourceFilesTotal + numBuilds * 2 );
+
+	queue.numJobsInPools.resize( options ? options->resourcePools.size() : 0, 0 );
+
+	{
+		memoryStatus_t memoryStatus;
+		bool8 gotMemoryStatus = OS_GetMemoryStatus( &memoryStatus );
+
+		if ( !gotMemoryStatus ) {
+			Warning( "Couldn't find out how much memory this machine has, so compile jobs won't be held back if it runs low.\n" );
+		}
+
+		MemoryThrottle_Init( &queue.memoryThrottle, gotMemoryStatus ? &memoryStatus : NULL );
+	}
+
+	defer {
+		// we never leave with jobs still running, so nothing else can be touching these
+		Assert( queue.numJobsInFlight == 0 );
+
+		MemoryThrottle_Shutdown( &queue.memoryThrottle );
+
+		Semaphore_Destroy( &queue.jobFinished );
+		Mutex_Destroy( &queue.mutex );
+	};
+
+	u32 nextBuildToStart = 0;
+	bool8 failed = false;
+
+	std::vector<pendingCompileJob_t> pendingCompileJobs;
+	bool8 addedPendingCompileJobs = false;
+
+	while ( 1 ) {
+		bool8 madeProgress = true;
+
+		while ( madeProgress ) {
+			madeProgress = false;
+
+			// OnPreBuild and OnPostBuild are user code that can touch any file, including ones that other configs are compiling or linking right now
+			// so those only ever run when nothing else is
+			bool8 postBuildWaiting = false;
+			For ( u32, buildIndex, 0, numBuilds ) {
+				if ( builds[buildIndex].state == CONFIG_BUILD_STATE_LINKED && builds[buildIndex].config->OnPostBuild ) {
+					postBuildWaiting = true;
+					break;
+				}
+			}
+
+			// start configs in order
+			while ( !failed && !postBuildWaiting && nextBuildToStart < numBuilds ) {
+				configBuild_t *build = &builds[nextBuildToStart];
+
+				// OnPreBuild has always been able to rely on everything the config depends on being built, so keep it that way
+				if ( build->config->OnPreBuild && ( queue.numJobsInFlight > 0 || !BuildConfigs_DependenciesDone( builds, build ) ) ) {
+					break;
+				}
+
+				if ( printConfigProgress ) {
+					if ( !build->config->name.empty() ) {
+						printf( "Building config \"%s\":\n", build->config->name.c_str() );
+					} else {
+						printf( "Building config:\n" );
+					}
+				}
+
+				build->startTimeMS = Time_MS();
+				build->state = CONFIG_BUILD_STATE_COMPILING;
+
+				nextBuildToStart++;
+				madeProgress = true;
+
+				if ( BuildBinary_Prepare( context, builds, build, compilerBackend, options ) == BUILD_RESULT_FAILED ) {
+					build->state = CONFIG_BUILD_STATE_DONE;
+					failed = true;
+					break;
+				}
+
+				// every source file includes the precompiled header, so they have to wait for it
+				// it goes first because nothing else in the config can start until its done
+				if ( build->compilingPrecompiledHeader ) {
+					pendingCompileJobs.push_back( { nextBuildToStart - 1, PRECOMPILED_HEADER_JOB_INDEX, build->precompiledHeaderPoolIndex, FLOAT64_MAX, FLOAT64_MAX } );
+				} else {
+					BuildConfigs_AddPendingCompileJobs( &pendingCompileJobs, build, nextBuildToStart - 1 );
+				}
+
+				addedPendingCompileJobs = true;
+			}
+
+			// hand out the compile jobs of every config we just started, longest first
+			// the job pool takes jobs from the main thread in the order they were submitted
+			// jobs whose pool is full stay pending until one of the jobs in that pool finishes
+			if ( !pendingCompileJobs.empty() ) {
+				if ( addedPendingCompileJobs ) {
+					qsort( pendingCompileJobs.data(), pendingCompileJobs.size(), sizeof( pendingCompileJob_t ), ComparePendingCompileJobs );
+					addedPendingCompileJobs = false;
+
+					PrefetchPendingCompileJobs( context, compilerBackend, builds, pendingCompileJobs );
+				}
+
+				if ( queue.predictedCompileTimesMS.empty() ) {
+					queue.firstCompileSubmitTimeMS = Time_MS();
+				}
+
+				u64 numStillPending = 0;
+
+				For ( u64, pendingJobIndex, 0, pendingCompileJobs.size() ) {
+					const pendingCompileJob_t *pendingJob = &pendingCompileJobs[pendingJobIndex];
+
+					if ( !BuildQueue_PoolHasRoom( &queue, pendingJob->poolIndex ) ) {
+						pendingCompileJobs[numStillPending++] = *pendingJob;
+						continue;
+					}
+
+					if ( pendingJob->compileJobIndex == PRECOMPILED_HEADER_JOB_INDEX ) {
+						queue.predictedCompileTimesMS.push_back( builds[pendingJob->buildIndex].precompiledHeaderJob.predictedTimeMS );
+
+						BuildQueue_Submit( &queue, BUILD_JOB_TYPE_PRECOMPILED_HEADER, pendingJob->buildIndex, 0, pendingJob->poolIndex );
+					} else {
+						queue.predictedCompileTimesMS.push_back( pendingJob->predictedTimeMS );
+
+						BuildQueue_Submit( &queue, BUILD_JOB_TYPE_COMPILE, pendingJob->buildIndex, pendingJob->compileJobIndex, pendingJob->poolIndex );
+					}
+				}
+
+				pendingCompileJobs.resize( numStillPending );
+			}
+
+			For ( u32, buildIndex, 0, numBuilds ) {
+				configBuild_t *build = &builds[buildIndex];
+
+				// if its link pool is full then it stays like this until one of the links in that pool finishes
+				if ( build->state == CONFIG_BUILD_STATE_COMPILING && build->numCompileJobsLeft == 0 ) {
+					if ( build->numCompileJobsFailed > 0 ) {
+						Error( "Compile failed.\n" );
+
+						build->state = CONFIG_BUILD_STATE_DONE;
+						failed = true;
+						madeProgress = true;
+					} else if ( build->configCacheHit ) {
+						// BuildBinary_Prepare() already set the result
+						build->state = CONFIG_BUILD_STATE_LINKED;
+						madeProgress = true;
+					} else if ( !failed && BuildConfigs_DependenciesDone( builds, build ) && BuildQueue_PoolHasRoom( &queue, build->linkPoolIndex ) ) {
+						// if anything we depend on got re-linked then we have to link against the new one
+						bool8 dependencyRelinked = false;
+						For ( u64, dependencyIndex, 0, build->dependencyIndices.size() ) {
+							if ( builds[build->dependencyIndices[dependencyIndex]].result == BUILD_RESULT_SUCCESS ) {
+								dependencyRelinked = true;
+								break;
+							}
+						}
+
+						if ( BuildBinary_ShouldLink( context, build, options ) || dependencyRelinked ) {
+							printf( "\nLinking \"%s\":\n", BuildConfig_GetFullBinaryName( build->config, Mem_GetTempStorage() ) );
+
+							build->state = CONFIG_BUILD_STATE_LINKING;
+
+							BuildQueue_Submit( &queue, BUILD_JOB_TYPE_LINK, buildIndex, 0, build->linkPoolIndex );
+						} else {
+							build->result = BUILD_RESULT_SKIPPED;
+							build->state = CONFIG_BUILD_STATE_LINKED;
+
+							// it could have been built before the config cache had it, or before anything it depends on was in there
+							BuildBinary_StoreInConfigCache( context, builds, build, compilerBackend, options );
+						}
+
+						madeProgress = true;
+					}
+				}
+
+				if ( build->state == CONFIG_BUILD_STATE_LINKED ) {
+					if ( build->config->OnPostBuild ) {
+						if ( failed || queue.numJobsInFlight > 0 ) {
+							continue;
+						}
+
+						LogVerbose( "Found a OnPostBuild() func ptr for BuildConfig: \"%s\".  Running...\n", build->config->name.c_str() );
+
+						buildTraceSpan_t span = BuildTrace_BeginSpan( "callback", "OnPostBuild" );
+						build->config->OnPostBuild( build->config );
+						BuildTrace_EndSpan( &span, build->config->binaryName.c_str() );
+
+						FileStatMemo_Invalidate( context->fileStatMemo );
+					}
+
+					build->state = CONFIG_BUILD_STATE_DONE;
+					build->buildTimeMS = Time_MS() - build->startTimeMS;
+
+					if ( printConfigProgress ) {
+						if ( build->result == BUILD_RESULT_SKIPPED ) {
+							printf( "Skipped \"%s\"!\n\n", build->config->binaryName.c_str() );
+						} else {
+							printf( "Finished building \"%s\", %f ms\n\n", build->config->binaryName.c_str(), build->buildTimeMS );
+						}
+					}
+
+					madeProgress = true;
+				}
+			}
+		}
+
+		// nothing is running, so nothing else can change
+		if ( queue.numJobsInFlight == 0 ) {
+			break;
+		}
+
+		buildJob_t job = BuildQueue_WaitForFinishedJob( &queue );
+
+		BuildConfigs_OnJobFinished( &queue, &job );
+
+		if ( job.type == BUILD_JOB_TYPE_PRECOMPILED_HEADER && job.succeeded ) {
+			BuildConfigs_AddPendingCompileJobs( &pendingCompileJobs, &builds[job.buildIndex], job.buildIndex );
+			addedPendingCompileJobs = true;
+		}
+
+		if ( job.type == BUILD_JOB_TYPE_COMPILE && job.succeeded ) {
+			if ( BuildConfigs_AddModuleImporters( &pendingCompileJobs, &builds[job.buildIndex], job.buildIndex, job.compileJobIndex ) ) {
+				addedPendingCompileJobs = true;
+			}
+		}
+
+		if ( job.type == BUILD_JOB_TYPE_LINK && !job.succeeded ) {
+			failed = true;
+		}
+	}
+
+	if ( !queue.predictedCompileTimesMS.empty() ) {
+		// the prediction assumes every compile job was there from the start, which isnt true if a config had to wait for OnPreBuild or OnPostBuild
+		float64 predictedMakespanMS = PredictMakespanMS( queue.predictedCompileTimesMS, JobPool_GetMaxConcurrentJobs() );
+		float64 actualMakespanMS = queue.lastCompileFinishTimeMS - queue.firstCompileSubmitTimeMS;
+
+		LogVerbose( "Compiled %" PRIu64 " files, predicted makespan %f ms, actual makespan %f ms.\n", queue.predictedCompileTimesMS.size(), predictedMakespanMS, actualMakespanMS );
 
-	bool8 generateCompilationDatabase = options && options->generateCompilationDatabase;
-	if ( generateCompilationDatabase ) {
-		context->compilationDatabase.resize( config->sourceFiles.size() );
+		if ( queue.memoryThrottle.numJobsHeldBack > 0 ) {
+			LogVerbose( "%u compile jobs had to wait for memory before they could start.\n", queue.memoryThrottle.numJobsHeldBack );
+		}
 	}
 
-	// ensure every source file has a slot in sourceFileIncludeDependencies before the compile loop runs
-	// this allows compile jobs to write their include dependencies by index with no contention
-	// the hashmap loaded from disk was sized for previously-seen files only
-	// so rebuild it with enough capacity for all current source files before adding any new entries
-	{
-		u64 totalCapacity = context->sourceFileIncludeDependencies.size() + config->sourceFiles.size();
-
-		hashmap_t *freshHashmap = HM_Create( context->allocator, TruncCast( u32, totalCapacity ), 0.5f );
+	For ( u32, buildIndex, 0, numBuilds ) {
+		if ( builds[buildIndex].state != CONFIG_BUILD_STATE_DONE ) {
+			Assert( failed );
+			builds[buildIndex].result = BUILD_RESULT_FAILED;
+		}
 
-		For ( u64, i, 0, context->sourceFileIncludeDependencies.size() ) {
-			u64 hash = HashString( context->sourceFileIncludeDependencies[i].filename.c_str(), 0 );
-			HM_SetValue( freshHashmap, hash, TruncCast( u32, i ) );
+		if ( builds[buildIndex].result == BUILD_RESULT_FAILED ) {
+			failed = true;
 		}
+	}
+
+	return !failed;
+}
+
+// keeps names short and the same no matter where the project is
+static const char *RemoveInputFilePath( const buildContext_t *context, const char *filename ) {
+	const char *inputFilePath = context->inputFilePath.data;
+	u64 inputFilePathLength = context->inputFilePath.count;
 
-		context->sourceFileIndices = freshHashmap;
+	if ( String_StartsWith( filename, inputFilePath ) && ( filename[inputFilePathLength] == '/' || filename[inputFilePathLength] == '\\' ) ) {
+		return filename + inputFilePathLength + 1;
 	}
 
-	For ( u64, sourceFileIndex, 0, config->sourceFiles.size() ) {
-		const char *sourceFile = config->sourceFiles[sourceFileIndex].c_str();
-		u64 sourceFileHash = HashString( sourceFile, 0 );
+	return filename;
+}
 
-		if ( HM_GetValue( context->sourceFileIndices, sourceFileHash ) == HASHMAP_INVALID_VALUE ) {
-			u32 newIndex = TruncCast( u32, context->sourceFileIncludeDependencies.size() );
+// "<config>: <source file>"
+static const char *GetSourceFileDisplayName( const buildContext_t *context, const BuildConfig *config, const char *sourceFile ) {
+	const char *configName = !config->name.empty() ? config->name.c_str() : config->binaryName.c_str();
 
-			context->sourceFileIncludeDependencies.push_back( { sourceFile, {} } );
+	return TempPrintf( "%s: %s", configName, RemoveInputFilePath( context, sourceFile ) );
+}
 
-			HM_SetValue( context->sourceFileIndices, sourceFileHash, newIndex );
-		}
-	}
+// works out which chain of compile and link jobs the build couldnt have gone any faster than, and prints it
+// goes off when each job actually started and finished, so only call this once the build is done
+static void BuildConfigs_PrintCriticalPath( const buildContext_t *context, const configBuild_t *builds, const u32 numBuilds ) {
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
 
-	// compile step
-	// subtract 1 from the number of CPU cores queried because the main thread already occupies one core
-	// spawning OS_GetNumCpuCores() threads would give us N+1 threads for N cores
-	// causing the OS scheduler to context-switch between them, adding unnecessary overhead
-	u32 numCores = Max( OS_GetNumCpuCores() - 1, 1 );
-	u32 numThreads = Min( numCores, TruncCast( u32, config->sourceFiles.size() ) );
+	criticalPath_t criticalPath;
+	CriticalPath_Init( &criticalPath, Mem_GetTempStorage() );
 
-	printf( "Compiling %" PRIu64 " files across %u threads.\n", config->sourceFiles.size(), numThreads );
+	// CRITICAL_PATH_NO_NODE for anything that didnt run
+	std::vector<u32> linkNodes( numBuilds, CRITICAL_PATH_NO_NODE );
 
-	compileJobPool_t pool = {
-		.compilerBackend				= compilerBackend,
-		.context						= context,
-		.config							= config,
-		.cmdArchetype					= &cmdArchetype,
-		.intermediateFiles				= &intermediateFiles,
-		.generateCompilationDatabase	= generateCompilationDatabase,
-		.numSourceFiles					= TruncCast( u32, config->sourceFiles.size() ),
-		.nextSourceFileIndex			= { 0 },
-		.numFailed						= { 0 },
-	};
+	For ( u32, buildIndex, 0, numBuilds ) {
+		const configBuild_t *build = &builds[buildIndex];
+		const BuildConfig *config = build->config;
 
-	array_t<thread_t> threads;
-	threads.Init( Mem_GetTempStorage() );
-	threads.Reserve( numThreads );
+		u32 precompiledHeaderNode = CRITICAL_PATH_NO_NODE;
 
-	For ( u64, threadIndex, 0, numThreads ) {
-		threads.Add( Thread_Create( CompileJobThread, &pool ) );
-	}
+		if ( build->precompiledHeaderJob.endTimeMS > 0.0 ) {
+			const compileJob_t *compileJob = &build->precompiledHeaderJob;
 
-	defer {
-		For ( u64, threadIndex, 0, numThreads ) {
-			Thread_Destroy( &threads[threadIndex] );
+			const char *name = TempPrintf( "%s (precompiled header)", GetSourceFileDisplayName( context, config, config->precompiledHeader.c_str() ) );
+
+			precompiledHeaderNode = CriticalPath_AddNode( &criticalPath, name, compileJob->startTimeMS, compileJob->endTimeMS );
 		}
-	};
 
-	For ( u64, threadIndex, 0, threads.count ) {
-		Thread_Wait( &threads[threadIndex] );
-	}
+		// every job in a batch ran in the same run of the compiler, so the whole batch is one node
+		std::vector<u32> compileNodes( build->compileJobs.size(), CRITICAL_PATH_NO_NODE );
 
-	if ( pool.numFailed.value > 0 ) {
-		Error( "Compile failed.\n" );
-		return BUILD_RESULT_FAILED;
-	}
+		For ( u64, compileJobIndex, 0, build->compileJobs.size() ) {
+			const compileJob_t *compileJob = &build->compileJobs[compileJobIndex];
 
-	// link step
-	// we only want to link if the binary doesnt exist or if any of the intermediate files are newer than the binary
-	// otherwise we can skip it
-	{
-		bool8 doLinking = false;
+			if ( compileJob->numJobsInBatch == 0 || compileJob->endTimeMS <= 0.0 ) {
+				continue;
+			}
 
-		const char *fullBinaryName = BuildConfig_GetFullBinaryName( config, Mem_GetTempStorage() );
+			const char *name = GetSourceFileDisplayName( context, config, config->sourceFiles[compileJob->sourceFileIndex].c_str() );
 
-		u64 binaryFileLastWriteTime = 0;
+			if ( compileJob->numJobsInBatch > 1 ) {
+				name = TempPrintf( "%s and %u other source files (batched)", name, compileJob->numJobsInBatch - 1 );
+			}
 
-		if ( !FS_GetFileLastWriteTime( fullBinaryName, &binaryFileLastWriteTime ) ) {
-			doLinking = true;
-		} else {
-			For ( u64, intermediateFileIndex, 0, intermediateFiles.size() ) {
-				u64 intermediateFileLastWriteTime = GetLastFileWriteTime( intermediateFiles[intermediateFileIndex].c_str() );
+			u32 node = CriticalPath_AddNode( &criticalPath, name, compileJob->startTimeMS, compileJob->endTimeMS );
 
-				if ( intermediateFileLastWriteTime > binaryFileLastWriteTime ) {
-					doLinking = true;
-					break;
+			For ( u32, batchJobIndex, 0, compileJob->numJobsInBatch ) {
+				compileNodes[compileJobIndex + batchJobIndex] = node;
+			}
+
+			if ( precompiledHeaderNode != CRITICAL_PATH_NO_NODE ) {
+				CriticalPath_AddDependency( &criticalPath, node, precompiledHeaderNode );
+			}
+		}
+
+		// source files that import modules cant start until the source files that export them have compiled
+		For ( u64, compileJobIndex, 0, build->compileJobs.size() ) {
+			const compileJob_t *compileJob = &build->compileJobs[compileJobIndex];
+
+			if ( compileNodes[compileJobIndex] == CRITICAL_PATH_NO_NODE ) {
+				continue;
+			}
+
+			For ( u64, importerIndex, 0, compileJob->moduleImporterJobIndices.size() ) {
+				u32 importerNode = compileNodes[compileJob->moduleImporterJobIndices[importerIndex]];
+
+				if ( importerNode != CRITICAL_PATH_NO_NODE && importerNode != compileNodes[compileJobIndex] ) {
+					CriticalPath_AddDependency( &criticalPath, importerNode, compileNodes[compileJobIndex] );
 				}
 			}
 		}
 
-		if ( !doLinking ) {
-			return BUILD_RESULT_SKIPPED;
+		if ( build->linkEndTimeMS <= 0.0 ) {
+			continue;
+		}
+
+		const char *linkName = TempPrintf( "%s: link %s", !config->name.empty() ? config->name.c_str() : config->binaryName.c_str(), RemoveInputFilePath( context, BuildConfig_GetFullBinaryName( config, Mem_GetTempStorage() ) ) );
+
+		linkNodes[buildIndex] = CriticalPath_AddNode( &criticalPath, linkName, build->linkStartTimeMS, build->linkEndTimeMS );
+
+		if ( precompiledHeaderNode != CRITICAL_PATH_NO_NODE ) {
+			CriticalPath_AddDependency( &criticalPath, linkNodes[buildIndex], precompiledHeaderNode );
+		}
+
+		For ( u64, compileJobIndex, 0, build->compileJobs.size() ) {
+			if ( build->compileJobs[compileJobIndex].numJobsInBatch > 0 && compileNodes[compileJobIndex] != CRITICAL_PATH_NO_NODE ) {
+				CriticalPath_AddDependency( &criticalPath, linkNodes[buildIndex], compileNodes[compileJobIndex] );
+			}
 		}
 
-		printf( "\nLinking:\n" );
+		// configs only ever depend on configs that come before them, so their link nodes already exist
+		For ( u64, dependencyIndex, 0, build->dependencyIndices.size() ) {
+			u32 dependencyLinkNode = linkNodes[build->dependencyIndices[dependencyIndex]];
 
-		if ( !compilerBackend->LinkIntermediateFiles( compilerBackend, intermediateFiles, config, options ) ) {
-			Error( "Linking failed.\n" );
-			return BUILD_RESULT_FAILED;
+			if ( dependencyLinkNode != CRITICAL_PATH_NO_NODE ) {
+				CriticalPath_AddDependency( &criticalPath, linkNodes[buildIndex], dependencyLinkNode );
+			}
 		}
 	}
 
-	if ( config->OnPostBuild ) {
-		LogVerbose( "Found a OnPostBuild() func ptr for BuildConfig: \"%s\".  Running...\n", config->name.c_str() );
-		config->OnPostBuild( config );
+	if ( criticalPath.nodes.count == 0 ) {
+		return;
 	}
 
-	return BUILD_RESULT_SUCCESS;
+	if ( !CriticalPath_Compute( &criticalPath ) ) {
+		Warning( "The jobs in this build depend on each other in a circle, so there's no critical path to show.\n" );
+		return;
+	}
+
+	CriticalPath_Print( &criticalPath, 5 );
+}
+
+static buildResult_t BuildBinary( buildContext_t *context, BuildConfig *config, compilerBackend_t *compilerBackend, const BuilderOptions *options ) {
+	configBuild_t build = {
+		.config	= config,
+	};
+
+	BuildConfigs( context, &build, 1, compilerBackend, options, false );
+
+	return build.result;
 }
 
 struct nukeContext_t {
@@ -984,134 +3739,49 @@ static std::vector<std::string> GetAllSourceFiles( const string_t *inputFilePath
 	return allSourceFiles;
 }
 
-static inline std::vector<std::string> BuildConfig_GetAllSourceFiles( const buildContext_t *context, const BuildConfig *config ) {
-	return GetAllSourceFiles( &context->inputFilePath, config->sourceFiles );
-}
+struct globJob_t {
+	const string_t				*inputFilePath;
+	std::vector<std::string>	*sourceFiles;	// gets replaced with everything it matched
+};
 
-static void AddBuildConfigAndDependenciesUnique( buildContext_t *context, const BuildConfig *config, std::vector<BuildConfig> &outConfigs ) {
-	u64 configNameHash = HashString( config->name.c_str(), 0 );
+static void GlobJob_Run( void *data ) {
+	globJob_t *job = Cast( globJob_t *, data );
 
-	if ( HM_GetValue( context->configIndices, configNameHash ) == HASHMAP_INVALID_VALUE ) {
-		// add other configs that this config depends on first
-		For ( size_t, dependencyIndex, 0, config->dependsOn.size() ) {
-			AddBuildConfigAndDependenciesUnique( context, &config->dependsOn[dependencyIndex], outConfigs );
-		}
+	buildTraceSpan_t span = BuildTrace_BeginSpan( "glob", "Glob source files" );
 
-		outConfigs.push_back( *config );
+	*job->sourceFiles = GetAllSourceFiles( job->inputFilePath, *job->sourceFiles );
 
-		HM_SetValue( context->configIndices, configNameHash, TruncCast( u32, outConfigs.size() - 1 ) );
-	}
+	BuildTrace_EndSpan( &span, TempPrintf( "%zu matched", job->sourceFiles->size() ) );
 }
 
-struct byteBuffer_t {
-	array_t<u8>	data;
-	u64			readOffset;
+struct compileCacheTrimJob_t {
+	const char					*folder;
+	u64							maxSizeBytes;
+	compileCacheTrimResult_t	result;
+	bool8						success;
 };
 
-static void ReadIncludeDependenciesFile( buildContext_t *context ) {
-	byteBuffer_t byteBuffer = {};
-
-	// there wont be an include dependencies file on the first build or if you nuked the binaries folder (for instance)
-	// so this is allowed to fail
-	string_t includeDependenciesFileBuffer = {};
-	if ( !FS_ReadEntireFile( context->includeDependenciesFilename.data, &includeDependenciesFileBuffer ) ) {
-		context->sourceFileIndices = HM_Create( context->allocator, 1, 1.0f );
-		return;
-	}
-
-	byteBuffer.data.data = Cast( u8 *, includeDependenciesFileBuffer.data );
-	byteBuffer.data.count = includeDependenciesFileBuffer.count;
-
-	auto ByteBuffer_Read_U32 = []( byteBuffer_t *buffer ) -> u32 {
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wcast-align"
-		u32 *result = Cast( u32 *, &buffer->data[buffer->readOffset] );
-#pragma clang diagnostic pop
-
-		buffer->readOffset += sizeof( u32 );
-
-		return *result;
-	};
-
-	auto ByteBuffer_Read_String = [&ByteBuffer_Read_U32]( byteBuffer_t *buffer ) -> std::string {
-		u32 stringLength = ByteBuffer_Read_U32( buffer );
-
-		std::string result( Cast( char *, &buffer->data[buffer->readOffset] ), stringLength );
-
-		buffer->readOffset += stringLength;
+static s32 CompileCacheTrimJob_Run( void *data ) {
+	compileCacheTrimJob_t *job = Cast( compileCacheTrimJob_t *, data );
 
-		return result;
-	};
-
-	u32 numSourceFiles = ByteBuffer_Read_U32( &byteBuffer );
-
-	context->sourceFileIndices = HM_Create( context->allocator, numSourceFiles, 1.0f );
-
-	context->sourceFileIncludeDependencies.resize( numSourceFiles );
-
-	For ( u64, sourceFileIndex, 0, context->sourceFileIncludeDependencies.size() ) {
-		includeDependencies_t *sourceFileIncludeDependencies = &context->sourceFileIncludeDependencies[sourceFileIndex];
-
-		std::string sourceFilename = ByteBuffer_Read_String( &byteBuffer );
-		u64 sourceFilenameHash = HashString( sourceFilename.c_str(), 0 );
-		u32 sourceFileIndexU32 = TruncCast( u32, sourceFileIndex );
-		HM_SetValue( context->sourceFileIndices, sourceFilenameHash, sourceFileIndexU32 );
-
-		sourceFileIncludeDependencies->filename = sourceFilename;
-
-		u64 numIncludeDependencies = ByteBuffer_Read_U32( &byteBuffer );
-		sourceFileIncludeDependencies->includeDependencies.resize( numIncludeDependencies );
+	job->success = CompileCache_Trim( job->folder, job->maxSizeBytes, &job->result );
 
-		For ( u64, dependencyIndex, 0, numIncludeDependencies ) {
-			sourceFileIncludeDependencies->includeDependencies[dependencyIndex] = ByteBuffer_Read_String( &byteBuffer );
-		}
-	}
+	return 0;
 }
 
-static bool8 WriteIncludeDependenciesFile( buildContext_t *context ) {
-	byteBuffer_t byteBuffer = {};
-	byteBuffer.data.Init( Mem_GetTempStorage() );
-
-	auto ByteBuffer_Write_U32 = []( byteBuffer_t *buffer, const u32 x ) {
-		buffer->data.Reserve( buffer->data.count + sizeof( u32 ) );
-
-		buffer->data.Add( ( x ) & 0xFF );
-		buffer->data.Add( ( x >> 8 ) & 0xFF );
-		buffer->data.Add( ( x >> 16 ) & 0xFF );
-		buffer->data.Add( ( x >> 24 ) & 0xFF );
-	};
-
-	auto ByteBuffer_Write_String = [&ByteBuffer_Write_U32]( byteBuffer_t *buffer, const std::string &string ) {
-		u32 stringLength = TruncCast( u32, string.size() );
-
-		ByteBuffer_Write_U32( buffer, stringLength );
-
-		buffer->data.AddRange( Cast( const u8 *, string.data() ), stringLength );
-	};
-
-	ByteBuffer_Write_U32( &byteBuffer, TruncCast( u32, context->sourceFileIncludeDependencies.size() ) );
-
-	For ( u64, sourceFileIndex, 0, context->sourceFileIncludeDependencies.size() ) {
-		const includeDependencies_t *sourceFileIncludeDependencies = &context->sourceFileIncludeDependencies[sourceFileIndex];
-
-		ByteBuffer_Write_String( &byteBuffer, context->sourceFileIncludeDependencies[sourceFileIndex].filename );
-
-		ByteBuffer_Write_U32( &byteBuffer, TruncCast( u32, sourceFileIncludeDependencies->includeDependencies.size() ) );
-
-		For ( u64, dependencyIndex, 0, sourceFileIncludeDependencies->includeDependencies.size() ) {
-			const std::string &dependencyFilename = sourceFileIncludeDependencies->includeDependencies[dependencyIndex];
+static void AddBuildConfigAndDependenciesUnique( buildContext_t *context, const BuildConfig *config, std::vector<BuildConfig> &outConfigs ) {
+	u64 configNameHash = HashString( config->name.c_str(), 0 );
 
-			ByteBuffer_Write_String( &byteBuffer, dependencyFilename );
+	if ( HM_GetValue( context->configIndices, configNameHash ) == HASHMAP_INVALID_VALUE ) {
+		// add other configs that this config depends on first
+		For ( size_t, dependencyIndex, 0, config->dependsOn.size() ) {
+			AddBuildConfigAndDependenciesUnique( context, &config->dependsOn[dependencyIndex], outConfigs );
 		}
-	}
 
-	if ( !FS_WriteEntireFile( context->includeDependenciesFilename.data, byteBuffer.data.data, byteBuffer.data.count ) ) {
-		s32 errorCode = GetLastErrorCode();
-		Error( "Failed to write file \"%s\".  Error code: " ERROR_CODE_FORMAT ".\n", context->includeDependenciesFilename.data, errorCode );
-		return false;
-	}
+		outConfigs.push_back( *config );
 
-	return true;
+		HM_SetValue( context->configIndices, configNameHash, TruncCast( u32, outConfigs.size() - 1 ) );
+	}
 }
 
 void RecordCompilationDatabaseEntry( buildContext_t *buildContext, const char *sourceFileName, const array_t<const char *> &compilationCommandArray, const u64 sourceFileIndex ) {
@@ -1187,6 +3857,67 @@ static const flagRule_t *IsFlagMatch( const char *arg ) {
 	return nullptr;
 }
 
+// clang and gcc arguments that take a path
+// longer flags come before any shorter ones they start with, so "-include-pch" doesnt get mistaken for "-include"
+static constexpr flagRule_t compilerPathArgumentRules[] = {
+	{ "-include-pch",				SEPARATE },
+	{ "-include",					JOINED | SEPARATE },
+	{ "-imacros",					JOINED | SEPARATE },
+	{ "-isystem",					JOINED | SEPARATE },
+	{ "-iquote",					JOINED | SEPARATE },
+	{ "-idirafter",					JOINED | SEPARATE },
+	{ "-isysroot",					JOINED | SEPARATE },
+	{ "-ivfsoverlay",				JOINED | SEPARATE },
+	{ "--sysroot=",					JOINED },
+	{ "-fsanitize-ignorelist=",		JOINED },
+	{ "-fsanitize-blacklist=",		JOINED },
+	{ "-fprofile-use=",				JOINED },
+	{ "-fprofile-instr-use=",		JOINED },
+	{ "-fprofile-sample-use=",		JOINED },
+	{ "-fmodule-map-file=",			JOINED },
+	{ "-fprebuilt-module-path=",	JOINED },
+	{ "-I",							JOINED | SEPARATE },
+};
+
+// batched compiles run inside the intermediate folder (see Clang_CompileSourceFiles()), so relative paths in BuildConfig::additionalCompilerArguments would mean something else there
+// make them relative to 'folder' instead, same as BuildConfig::additionalIncludes
+// only knows clang and gcc arguments, so dont call this for anything else
+static void MakeCompilerArgumentPathsAbsolute( const char *folder, std::vector<std::string> &args ) {
+	For ( u64, argIndex, 0, args.size() ) {
+		const char *arg = args[argIndex].c_str();
+
+		For ( u64, ruleIndex, 0, COUNT_OF( compilerPathArgumentRules ) ) {
+			const flagRule_t *rule = &compilerPathArgumentRules[ruleIndex];
+
+			if ( !String_StartsWith( arg, rule->flag ) ) {
+				continue;
+			}
+
+			u64 flagLength = strlen( rule->flag );
+
+			if ( arg[flagLength] == 0 ) {
+				if ( ( rule->forms & SEPARATE ) && argIndex + 1 < args.size() ) {
+					argIndex++;
+
+					const char *path = args[argIndex].c_str();
+
+					if ( !Path_IsAbsolute( path ) ) {
+						args[argIndex] = TempPrintf( "%s%c%s", folder, PATH_SEPARATOR, path );
+					}
+				}
+			} else if ( rule->forms & JOINED ) {
+				const char *path = arg + flagLength;
+
+				if ( !Path_IsAbsolute( path ) ) {
+					args[argIndex] = TempPrintf( "%s%s%c%s", rule->flag, folder, PATH_SEPARATOR, path );
+				}
+			}
+
+			break;
+		}
+	}
+}
+
 static void FixCompilatiomDatabasePath( std::string &path ) {
 	for ( char &c : path ) {
 		if ( c == '\\' ) {
@@ -1360,6 +4091,68 @@ static bool WriteCompilationDatabase( buildContext_t *context ) {
 	return true;
 }
 
+static void BuildHistory_AddCompileJob( buildHistory_t *history, const buildContext_t *context, const BuildConfig *config, const char *sourceFile, const compileJob_t *compileJob ) {
+	u32 peakMemoryMB = TruncCast( u32, ( compileJob->peakMemoryBytes + ( 1024 * 1024 ) - 1 ) / ( 1024 * 1024 ) );
+
+	BuildHistory_AddSourceFile( history, GetSourceFileDisplayName( context, config, sourceFile ), compileJob->compileTimeMS, compileJob->cpuTimeMS, peakMemoryMB, compileJob->cacheHit );
+}
+
+// adds the build that just finished to the end of the build history
+static void RecordBuildHistory( const buildContext_t *context, const configBuild_t *builds, const u32 numBuilds, const bool8 succeeded, const float64 wallTimeMS ) {
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	// there wont be one on the first build
+	buildHistory_t history;
+	BuildHistory_Init( &history, context->allocator );
+	BuildHistory_Load( &history, context->buildHistoryFilename.data );
+
+	buildHistoryBuild_t build = {
+		.timestamp	= Cast( u64, time( NULL ) ),
+		.wallTimeMS	= wallTimeMS,
+		.cpuTimeMS	= OS_GetProcessCPUTimeMS() + GetChildProcessCPUTimeMS(),
+		.succeeded	= succeeded,
+	};
+
+	BuildHistory_AddBuild( &history, &build );
+
+	buildHistoryBuild_t *newBuild = &history.builds[history.builds.count - 1];
+
+	For ( u32, buildIndex, 0, numBuilds ) {
+		const configBuild_t *configBuild = &builds[buildIndex];
+		const BuildConfig *config = configBuild->config;
+
+		// only the source files that compiled, the ones that failed dont say much about how long they normally take
+		if ( configBuild->precompiledHeaderJob.succeeded ) {
+			const compileJob_t *compileJob = &configBuild->precompiledHeaderJob;
+
+			BuildHistory_AddCompileJob( &history, context, config, config->precompiledHeader.c_str(), compileJob );
+
+			newBuild->peakMemoryBytes = Max( newBuild->peakMemoryBytes, compileJob->peakMemoryBytes );
+			newBuild->numSourceFilesCompiled++;
+		}
+
+		For ( u64, compileJobIndex, 0, configBuild->compileJobs.size() ) {
+			const compileJob_t *compileJob = &configBuild->compileJobs[compileJobIndex];
+
+			if ( !compileJob->succeeded ) {
+				continue;
+			}
+
+			BuildHistory_AddCompileJob( &history, context, config, config->sourceFiles[compileJob->sourceFileIndex].c_str(), compileJob );
+
+			if ( compileJob->cacheHit ) {
+				newBuild->numCacheHits++;
+			} else {
+				newBuild->peakMemoryBytes = Max( newBuild->peakMemoryBytes, compileJob->peakMemoryBytes );
+				newBuild->numSourceFilesCompiled++;
+			}
+		}
+	}
+
+	BuildHistory_Save( &history, context->buildHistoryFilename.data );
+}
+
 int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 	float64 totalTimeStart = Time_MS();
 
@@ -1411,6 +4204,26 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 
 	bool8 isVisualStudioBuild = false;
 
+	// 0 means the user didnt say
+	u32 numJobs = 0;
+
+	bool8 useCompileCache = true;
+
+	// NULL if the user didnt say
+	const char *remoteCacheArg = NULL;
+
+	bool8 showPCHReport = false;
+
+	bool8 showHeaderImpact = false;
+
+	bool8 showTimeReport = false;
+
+	// NULL if the user didnt ask for a trace
+	const char *traceFilename = NULL;
+
+	bool8 showStats = false;
+	float64 statsThresholdPercent = 25.0;
+
 	CommandLineArgs args = {
 		.argc = argc,
 		// .argv = argv,
@@ -1481,34 +4294,165 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 				QUIT_ERROR();
 			}
 
-			const char *folderToNuke = argv[argIndex + 1];
-
-			float64 startTime = Time_MS();
+			const char *folderToNuke = argv[argIndex + 1];
+
+			float64 startTime = Time_MS();
+
+			printf( "Nuking \"%s\"\n", folderToNuke );
+
+			if ( !FS_FolderExists( folderToNuke ) ) {
+				Error( "Can't nuke folder \"%s\" because it doesn't exist.  Have you typed it in correctly?\n", folderToNuke );
+				QUIT_ERROR();
+			}
+
+			if ( !NukeFolder( folderToNuke, false, true ) ) {
+				Error( "Failed to nuke folder \"%s\".  You will have to clean this one up manually by yourself.  Sorry.\n", folderToNuke );
+				QUIT_ERROR();
+			}
+
+			float64 endTime = Time_MS();
+
+			printf( "Done.  %f ms\n", endTime - startTime );
+
+			return 0;
+		}
+
+		if ( String_Equals( arg, ARG_VISUAL_STUDIO_BUILD ) ) {
+			isVisualStudioBuild = true;
+
+			continue;
+		}
+
+		if ( String_StartsWith( arg, ARG_JOBS ) ) {
+			const char *jobsString = arg + strlen( ARG_JOBS );
+
+			char *jobsStringEnd = NULL;
+			unsigned long jobs = strtoul( jobsString, &jobsStringEnd, 10 );
+
+			if ( jobsStringEnd == jobsString || *jobsStringEnd != 0 || jobs < 1 || jobs > U32_MAX ) {
+				Error( "\"%s\" isn't a number of jobs I can use.  It needs to be a whole number that's at least 1, like " ARG_JOBS "8.\n", jobsString );
+
+				return ShowUsage( 1 );
+			}
+
+			numJobs = Cast( u32, jobs );
+
+			continue;
+		}
+
+		if ( String_Equals( arg, ARG_NO_CACHE ) ) {
+			useCompileCache = false;
+
+			continue;
+		}
+
+		if ( String_Equals( arg, ARG_PCH_REPORT ) ) {
+			showPCHReport = true;
+
+			continue;
+		}
+
+		if ( String_Equals( arg, ARG_HEADER_IMPACT ) ) {
+			showHeaderImpact = true;
+
+			continue;
+		}
+
+		if ( String_Equals( arg, ARG_TIME_REPORT ) ) {
+			showTimeReport = true;
+
+			continue;
+		}
+
+		if ( String_StartsWith( arg, ARG_TRACE ) ) {
+			traceFilename = arg + strlen( ARG_TRACE );
+
+			if ( traceFilename[0] == 0 ) {
+				Error( "You specified " ARG_TRACE " but never told me what file to write the trace to.\n" );
+
+				return ShowUsage( 1 );
+			}
+
+			continue;
+		}
+
+		if ( String_Equals( arg, ARG_STATS ) ) {
+			showStats = true;
+
+			continue;
+		}
+
+		if ( String_StartsWith( arg, ARG_STATS "=" ) ) {
+			const char *thresholdString = arg + strlen( ARG_STATS "=" );
+
+			char *thresholdStringEnd = NULL;
+			statsThresholdPercent = strtod( thresholdString, &thresholdStringEnd );
+
+			if ( thresholdStringEnd == thresholdString || *thresholdStringEnd != 0 || statsThresholdPercent < 0.0 ) {
+				Error( "\"%s\" isn't a percentage I can use.  It needs to be a number that's at least 0, like " ARG_STATS "=25.\n", thresholdString );
+
+				return ShowUsage( 1 );
+			}
+
+			showStats = true;
+
+			continue;
+		}
+
+		if ( String_StartsWith( arg, ARG_REMOTE_CACHE ) ) {
+			remoteCacheArg = arg + strlen( ARG_REMOTE_CACHE );
+
+			if ( remoteCacheArg[0] == 0 ) {
+				Error( "You specified " ARG_REMOTE_CACHE " but never told me where the remote cache is.\n" );
+
+				return ShowUsage( 1 );
+			}
+
+			continue;
+		}
+
+		if ( String_Equals( arg, ARG_SERVE_CACHE ) ) {
+			if ( argIndex + 2 >= argc ) {
+				Error( "You passed in " ARG_SERVE_CACHE " but I need a folder to keep the cache in and a port to listen on, like " ARG_SERVE_CACHE " /path/to/cache 8080.\n" );
+				QUIT_ERROR();
+			}
+
+			const char *cacheFolder = argv[argIndex + 1];
+			const char *portString = argv[argIndex + 2];
 
-			printf( "Nuking \"%s\"\n", folderToNuke );
+			char *portStringEnd = NULL;
+			unsigned long port = strtoul( portString, &portStringEnd, 10 );
 
-			if ( !FS_FolderExists( folderToNuke ) ) {
-				Error( "Can't nuke folder \"%s\" because it doesn't exist.  Have you typed it in correctly?\n", folderToNuke );
+			if ( portStringEnd == portString || *portStringEnd != 0 || port > 65535 ) {
+				Error( "\"%s\" isn't a port I can listen on.  It needs to be a whole number from 0 to 65535.\n", portString );
 				QUIT_ERROR();
 			}
 
-			if ( !NukeFolder( folderToNuke, false, true ) ) {
-				Error( "Failed to nuke folder \"%s\".  You will have to clean this one up manually by yourself.  Sorry.\n", folderToNuke );
+			// there's no authentication, so only listen on other network interfaces if we were explicitly told to
+			bool8 allInterfaces = false;
+			For ( s32, otherArgIndex, 1, argc ) {
+				if ( String_Equals( argv[otherArgIndex], ARG_ALL_INTERFACES ) ) {
+					allInterfaces = true;
+					break;
+				}
+			}
+
+			cacheServer_t server = {};
+			if ( !CacheServer_Start( &server, cacheFolder, Cast( u16, port ), allInterfaces ) ) {
 				QUIT_ERROR();
 			}
 
-			float64 endTime = Time_MS();
+			if ( allInterfaces ) {
+				printf( "Serving the cache in \"%s\" on port %u on every network interface.  Anyone who can reach this machine can write to it.\n", cacheFolder, server.port );
+			} else {
+				printf( "Serving the cache in \"%s\" on port %u to this machine only (pass " ARG_ALL_INTERFACES " to let other machines use it).\n", cacheFolder, server.port );
+			}
+			fflush( stdout );
 
-			printf( "Done.  %f ms\n", endTime - startTime );
+			CacheServer_Wait( &server );
 
 			return 0;
 		}
-
-		if ( String_Equals( arg, ARG_VISUAL_STUDIO_BUILD ) ) {
-			isVisualStudioBuild = true;
-
-			continue;
-		}
 	}
 
 	// we need a source file specified at the command line
@@ -1522,6 +4466,56 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 		QUIT_ERROR();
 	}
 
+	if ( numJobs == 0 ) {
+		// subtract 1 from the number of CPU cores queried because the main thread already occupies one core
+		// spawning OS_GetNumCpuCores() threads would give us N+1 threads for N cores
+		// causing the OS scheduler to context-switch between them, adding unnecessary overhead
+		numJobs = Max( OS_GetNumCpuCores() - 1, 1U );
+	}
+
+	// every stage of the build shares these threads, see job_pool.h
+	JobPool_Init( numJobs );
+	defer { JobPool_Shutdown(); };
+
+	// the trace gets written no matter how we leave, a trace of a failed build is still useful
+	// this has to happen before the job pool shuts down, but every job has finished by then anyway
+	buildTraceSpan_t builderSpan = {};
+	if ( traceFilename ) {
+		BuildTrace_Init();
+
+		builderSpan = BuildTrace_BeginSpan( "builder", "Builder" );
+	}
+	defer {
+		if ( traceFilename ) {
+			BuildTrace_EndSpan( &builderSpan );
+
+			stringBuilder_t trace = SB_Create( Mem_GetTempStorage() );
+			BuildTrace_WriteJSON( &trace );
+
+			if ( WriteStringBuilderToFile( &trace, traceFilename ) ) {
+				printf( "Wrote the build trace to \"%s\".\n", traceFilename );
+			}
+
+			BuildTrace_Shutdown();
+		}
+	};
+
+	// how many compiles and links actually run at once is down to the jobserver, see jobserver.h
+	switch ( Jobserver_Init( numJobs ) ) {
+		case JOBSERVER_MODE_NONE:
+			LogVerbose( "Running up to %u jobs at once, without a jobserver.\n", numJobs );
+			break;
+
+		case JOBSERVER_MODE_SERVER:
+			LogVerbose( "Running up to %u jobs at once, sharing them through our own jobserver.\n", numJobs );
+			break;
+
+		case JOBSERVER_MODE_CLIENT:
+			LogVerbose( "Using the jobserver from MAKEFLAGS, running up to %u jobs at once if it lets us.\n", numJobs );
+			break;
+	}
+	defer { Jobserver_Shutdown(); };
+
 #ifdef _WIN32
 	if ( !Win_GetWindowsSDK( context.allocator, &context.winSDK ) ) {
 		QUIT_ERROR();
@@ -1557,9 +4551,30 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 
 		context.includeDependenciesFilename = String_Printf( context.allocator, "%s%c%s.include_dependencies", context.dotBuilderFolder.data, PATH_SEPARATOR, String_Cstr( &inputFileStripped ) );
 
+		context.fileHashCacheFilename = String_Printf( context.allocator, "%s%c%s.file_hashes", context.dotBuilderFolder.data, PATH_SEPARATOR, String_Cstr( &inputFileStripped ) );
+
+		context.buildHistoryFilename = String_Printf( context.allocator, "%s%c%s.build_history", context.dotBuilderFolder.data, PATH_SEPARATOR, String_Cstr( &inputFileStripped ) );
+
 		LogVerbose( "input file path                  : %s\n", context.inputFilePath.data );
 		LogVerbose( ".builder folder location         : %s\n", context.dotBuilderFolder.data );
 		LogVerbose( "includedependencies file location: %s\n", context.includeDependenciesFilename.data );
+		LogVerbose( "file hash cache location         : %s\n", context.fileHashCacheFilename.data );
+		LogVerbose( "build history location           : %s\n", context.buildHistoryFilename.data );
+	}
+
+	if ( showStats ) {
+		buildHistory_t buildHistory;
+		BuildHistory_Init( &buildHistory, context.allocator );
+
+		if ( !BuildHistory_Load( &buildHistory, context.buildHistoryFilename.data ) ) {
+			printf( "There's no build history for \"%s\" yet.  Every build you do from now on gets added to it.\n", context.inputFile );
+
+			return 0;
+		}
+
+		BuildHistory_PrintStats( &buildHistory, 20, statsThresholdPercent );
+
+		return 0;
 	}
 
 	string_t defaultBinaryNameView = String_Set( context.inputFile );
@@ -1570,7 +4585,54 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 	defaultBinaryName.data[defaultBinaryNameView.count] = '\0';
 	defaultBinaryName.count = defaultBinaryNameView.count;
 
-	ReadIncludeDependenciesFile( &context );
+	// there wont be an include dependencies file on the first build or if you nuked the .builder folder (for instance)
+	// so this is allowed to fail
+	includeDependencyDB_t includeDependencyDB;
+	IncludeDependencyDB_Init( &includeDependencyDB, context.allocator );
+	{
+		buildTraceSpan_t span = BuildTrace_BeginSpan( "phase", "Load include dependencies" );
+
+		if ( !IncludeDependencyDB_Load( &includeDependencyDB, context.includeDependenciesFilename.data ) ) {
+			LogVerbose( "No usable include dependencies file at \"%s\", everything will be rebuilt.\n", context.includeDependenciesFilename.data );
+		}
+
+		BuildTrace_EndSpan( &span );
+	}
+	context.includeDependencyDB = &includeDependencyDB;
+
+	// same as the include dependencies file, this wont exist on the first build
+	fileHashCache_t fileHashCache = {};
+	FileHashCache_Init( &fileHashCache, context.allocator );
+	FileHashCache_Read( &fileHashCache, context.fileHashCacheFilename.data );
+
+	// leave some room for files we havent seen before
+	// if it ever fills up then lookups for anything that didnt fit just go straight to the file system
+	context.fileStatMemo = FileStatMemo_Create( context.allocator, &fileHashCache, 4096 );
+
+	// write these back out no matter how we leave, even if a build fails
+	// every source file that compiled successfully before the failure has its up-to-date hash in here, so it wont need compiling again next time
+	// source files that failed to compile have no hash, so they always get compiled again
+	defer {
+		IncludeDependencyDB_Save( &includeDependencyDB, context.includeDependenciesFilename.data );
+
+		FileStatMemo_UpdateFileHashCache( context.fileStatMemo, &fileHashCache );
+		FileHashCache_Write( &fileHashCache, context.fileHashCacheFilename.data );
+
+		const fileStatMemo_t *memo = context.fileStatMemo;
+		LogVerbose( "File stats: %u stat calls made, %u saved by the memo.\n", memo->numStatCalls.value, memo->numStatCallsSaved.value );
+		LogVerbose( "File hashes: %u files hashed, %u reused from the file hash cache, %u saved by the memo.\n", memo->numFilesHashed.value, memo->numHashesFromCache.value, memo->numHashesSaved.value );
+	};
+
+	compileCache_t compileCache = {};
+	if ( useCompileCache ) {
+		const char *compileCacheFolder = Path_Join( context.allocator, context.dotBuilderFolder.data, "cache" ).data;
+
+		if ( CompileCache_Init( &compileCache, compileCacheFolder, NULL, false, context.fileStatMemo ) ) {
+			context.compileCache = &compileCache;
+		} else {
+			Warning( "Failed to create the compile cache folder \"%s\", so everything will be compiled from scratch.\n", compileCacheFolder );
+		}
+	}
 
 	string_t appPathOnly = Path_AppPath( Mem_GetTempStorage() );
 	appPathOnly = Path_RemoveFileFromPath( &appPathOnly );
@@ -1595,6 +4657,8 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 	{
 		float64 userConfigBuildTimeStart = Time_MS();
 
+		buildTraceSpan_t span = BuildTrace_BeginSpan( "phase", "User config build" );
+
 		printf( "Doing user config build:\n" );
 
 		BuildConfig userConfigBuildConfig = {
@@ -1651,11 +4715,10 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 		switch ( userConfigBuildResult ) {
 			case BUILD_RESULT_SUCCESS: {
 				printf( "\n" );
-				// if the user config DLL got rebuilt then compile settings might have changed
-				// force a rebuild of everything
-				context.forceRebuild = true;
-
-				LogVerbose( "User config build was successful.  All of the BuildConfigs we build from now on will be fully rebuilt...\n\n" );
+				// the user config DLL got rebuilt so compile settings might have changed
+				// but we dont need to force a rebuild of everything because of that
+				// each source file remembers the command line it was last compiled with, so only the ones whose command line actually changed get rebuilt
+				LogVerbose( "User config build was successful.\n\n" );
 			} break;
 
 			case BUILD_RESULT_FAILED: {
@@ -1668,6 +4731,8 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 		 	} break;
 		}
 
+		BuildTrace_EndSpan( &span );
+
 		userConfigBuildTimeMS = Time_MS() - userConfigBuildTimeStart;
 	}
 
@@ -1697,11 +4762,16 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 
 		float64 setBuilderOptionsTimeStart = Time_MS();
 
+		buildTraceSpan_t span = BuildTrace_BeginSpan( "phase", SET_BUILDER_OPTIONS_FUNC_NAME );
+
 		if ( setBuilderOptionsFunc ) {
 			printf( "%s override function found.  Running...\n", SET_BUILDER_OPTIONS_FUNC_NAME );
 
 			setBuilderOptionsFunc( &options, &args );
 
+			// user code could have generated or changed any file, so dont trust anything we remembered from before
+			FileStatMemo_Invalidate( context.fileStatMemo );
+
 			printf( "%s override function finished.\n\n", SET_BUILDER_OPTIONS_FUNC_NAME );
 		} else {
 			LogVerbose( "No %s override function was found.\n\n", SET_BUILDER_OPTIONS_FUNC_NAME );
@@ -1710,9 +4780,85 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 		context.forceRebuild |= options.forceRebuild;
 		context.consolidateCompilerArgs = options.consolidateCompilerArgs;
 
+		BuildTrace_EndSpan( &span );
+
 		setBuilderOptionsTimeMS = Time_MS() - setBuilderOptionsTimeStart;
 	}
 
+	// the user wants the compile cache shared between checkouts instead of the one in the .builder folder
+	if ( context.compileCache && !options.compileCacheFolder.empty() ) {
+		const char *compileCacheFolder = options.compileCacheFolder.c_str();
+
+		if ( !Path_IsAbsolute( compileCacheFolder ) ) {
+			Error( "BuilderOptions::compileCacheFolder is \"%s\", but it MUST be an absolute path.  Otherwise each checkout would end up with its own cache anyway.\n", compileCacheFolder );
+			QUIT_ERROR();
+		}
+
+		// everything is relative to the folder the build source file is in, so thats the bit that differs between checkouts
+		const char *rootFolder = Path_AbsolutePath( context.allocator, context.inputFilePath.data ).data;
+
+		if ( CompileCache_Init( &compileCache, compileCacheFolder, rootFolder, true, context.fileStatMemo ) ) {
+			LogVerbose( "Using the shared compile cache \"%s\" (root folder \"%s\").\n", compileCacheFolder, rootFolder );
+		} else {
+			Warning( "Failed to create the compile cache folder \"%s\", so everything will be compiled from scratch.\n", compileCacheFolder );
+			context.compileCache = NULL;
+		}
+	}
+
+	// the command line wins, so the same build source file can be used with and without the remote cache (e.g. on CI and on a developer's machine)
+	const char *remoteCacheLocation = remoteCacheArg;
+	if ( !remoteCacheLocation && !options.remoteCache.empty() ) {
+		remoteCacheLocation = options.remoteCache.c_str();
+	}
+
+	if ( context.compileCache && remoteCacheLocation ) {
+		// entries can only match between machines if the checkout's path has been swapped out of them
+		if ( !compileCache.rootFolder ) {
+			const char *rootFolder = Path_AbsolutePath( context.allocator, context.inputFilePath.data ).data;
+
+			CompileCache_Init( &compileCache, compileCache.folder, rootFolder, false, context.fileStatMemo );
+		}
+
+		if ( CompileCache_ConnectRemote( &compileCache, remoteCacheLocation ) ) {
+			LogVerbose( "Using the remote cache \"%s\".\n", remoteCacheLocation );
+		} else {
+			Warning( "Can't use the remote cache \"%s\", so only the local compile cache will be used.\n", remoteCacheLocation );
+		}
+	}
+
+	bool8 usedRemoteCache = compileCache.remote != NULL;
+
+	defer { CompileCache_DisconnectRemote( &compileCache ); };
+
+	// trimming has to walk the whole cache, which can take a while when its shared, so do it on its own thread while we build
+	// its only ever deleting entries we arent using this build (theyre the oldest), and a lookup that loses the race is just a miss
+	compileCacheTrimJob_t compileCacheTrimJob = {};
+	thread_t compileCacheTrimThread = {};
+
+	if ( context.compileCache && options.compileCacheMaxSizeMB > 0 ) {
+		compileCacheTrimJob.folder = context.compileCache->folder;
+		compileCacheTrimJob.maxSizeBytes = MEM_MEGABYTES( options.compileCacheMaxSizeMB );
+
+		compileCacheTrimThread = Thread_Create( CompileCacheTrimJob_Run, &compileCacheTrimJob );
+	}
+
+	defer {
+		if ( compileCacheTrimThread.ptr ) {
+			Thread_Wait( &compileCacheTrimThread );
+			Thread_Destroy( &compileCacheTrimThread );
+
+			const compileCacheTrimResult_t *result = &compileCacheTrimJob.result;
+
+			if ( compileCacheTrimJob.success ) {
+				LogVerbose( "Compile cache trimmed from %" PRIu64 " to %" PRIu64 " bytes (%u files deleted).\n", result->sizeBytesBefore, result->sizeBytesAfter, result->numFilesDeleted );
+			} else {
+				// files come and go while we build (including our own), so this can happen without anything being wrong
+				// next build will try again
+				LogVerbose( "Couldn't trim the compile cache \"%s\" this time.\n", compileCacheTrimJob.folder );
+			}
+		}
+	};
+
 	std::vector<BuildConfig> configsToBuild;
 
 	array_t<float64> configBuildTimes;
@@ -1724,6 +4870,8 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 	if ( options.generateSolution && !isVisualStudioBuild ) {
 		float64 start = Time_MS();
 
+		buildTraceSpan_t span = BuildTrace_BeginSpan( "generate", "Generate Visual Studio solution" );
+
 		// you either want to generate a visual studio solution or build this config, but not both
 		if ( inputConfigName ) {
 			Error(
@@ -1737,19 +4885,37 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 		// make sure BuilderOptions::configs and configs from visual studio match
 		// we will need this list later for validation
 		// at the same time grab the list of files we are adding to the solution
-		options.configs.clear();
+		// every project and config globs on its own job
+		std::vector<globJob_t> globJobs;
+
+		jobCounter_t globJobCounter;
+		JobCounter_Init( &globJobCounter );
+		defer { JobCounter_Destroy( &globJobCounter ); };
+
 		For ( u64, projectIndex, 0, options.solution.projects.size() ) {
 			VisualStudioProject *project = &options.solution.projects[projectIndex];
 
 			For ( u64, configIndex, 0, project->configs.size() ) {
-				VisualStudioConfig *config = &project->configs[configIndex];
-
-				config->options.sourceFiles = BuildConfig_GetAllSourceFiles( &context, &config->options );
-				AddBuildConfigAndDependenciesUnique( &context, &config->options, options.configs );
+				globJobs.push_back( { &context.inputFilePath, &project->configs[configIndex].options.sourceFiles } );
 			}
 
 			if ( !project->extraFiles.empty() ) {
-				project->extraFiles = GetAllSourceFiles( &context.inputFilePath, project->extraFiles );
+				globJobs.push_back( { &context.inputFilePath, &project->extraFiles } );
+			}
+		}
+
+		For ( u64, globJobIndex, 0, globJobs.size() ) {
+			JobPool_Submit( GlobJob_Run, &globJobs[globJobIndex], &globJobCounter );
+		}
+
+		JobPool_Wait( &globJobCounter );
+
+		options.configs.clear();
+		For ( u64, projectIndex, 0, options.solution.projects.size() ) {
+			VisualStudioProject *project = &options.solution.projects[projectIndex];
+
+			For ( u64, configIndex, 0, project->configs.size() ) {
+				AddBuildConfigAndDependenciesUnique( &context, &project->configs[configIndex].options, options.configs );
 			}
 		}
 
@@ -1764,24 +4930,34 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 
 		printf( "Done.\n\n" );
 
+		BuildTrace_EndSpan( &span );
+
 		visualStudioGenerationTimeMS = Time_MS() - start;
 	} else if ( options.generateVSCodeJSONFiles ) {
 		float64 start = Time_MS();
 
+		buildTraceSpan_t span = BuildTrace_BeginSpan( "generate", "Generate VS Code JSON files" );
+
 		if ( !GenerateVSCodeJSONFiles( &context, &options ) ) {
 			Error( "Failed to generate VS Code JSON files.\n" );
 			QUIT_ERROR();
 		}
 
+		BuildTrace_EndSpan( &span );
+
 		vsCodeJSONGenerationTimeMS = Time_MS() - start;
 	} else if ( options.generateZedJSONFiles ) {
 		float64 start = Time_MS();
 
+		buildTraceSpan_t span = BuildTrace_BeginSpan( "generate", "Generate Zed JSON files" );
+
 		if ( !GenerateZedJSONFiles( &context, &options ) ) {
 			Error( "Failed to generate Zed JSON files.\n" );
 			QUIT_ERROR();
 		}
 
+		BuildTrace_EndSpan( &span );
+
 		zedJSONGenerationTimeMS = Time_MS() - start;
 	} else {
 		// otherwise the user wants to actually build
@@ -1843,10 +5019,14 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 			{
 				float64 compilerBackendInitStart = Time_MS();
 
+				buildTraceSpan_t span = BuildTrace_BeginSpan( "phase", "Compiler init" );
+
 				if ( !compilerBackend.Init( &compilerBackend, &context, options.compilerPath.c_str(), options.compilerVersion.c_str() ) ) {
 					QUIT_ERROR();
 				}
 
+				BuildTrace_EndSpan( &span );
+
 				float64 compilerBackendInitEnd = Time_MS();
 
 				compilerBackendInitTimeMS = compilerBackendInitEnd - compilerBackendInitStart;
@@ -1950,6 +5130,37 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 			}
 		}
 
+		// a pool that doesnt exist is almost certainly a typo, and it would be a pain to find out about it by noticing that the limit never happened
+		For ( u64, poolIndex, 0, options.resourcePools.size() ) {
+			const ResourcePool *pool = &options.resourcePools[poolIndex];
+
+			if ( pool->name.empty() ) {
+				Error( "One of the ResourcePools in BuilderOptions::resourcePools has an empty name.  Every ResourcePool MUST have a name, otherwise BuildConfigs can't put anything in it.\n" );
+				QUIT_ERROR();
+			}
+
+			if ( pool->depth == 0 ) {
+				Error( "ResourcePool \"%s\" has a depth of 0, so nothing in it would ever get to run.  The depth MUST be at least 1.\n", pool->name.c_str() );
+				QUIT_ERROR();
+			}
+
+			if ( FindResourcePool( &options, pool->name ) != poolIndex ) {
+				Error( "I found multiple ResourcePools with the name \"%s\".  All ResourcePool names MUST be unique, otherwise I don't know which one you want.\n", pool->name.c_str() );
+				QUIT_ERROR();
+			}
+		}
+
+		For ( u64, configToBuildIndex, 0, configsToBuild.size() ) {
+			const BuildConfig *config = &configsToBuild[configToBuildIndex];
+
+			const char *missingPool = BuildConfig_FindMissingResourcePool( &options, config );
+
+			if ( missingPool ) {
+				Error( "BuildConfig \"%s\" uses the ResourcePool \"%s\", but there's no ResourcePool with that name in BuilderOptions::resourcePools.\n", config->name.c_str(), missingPool );
+				QUIT_ERROR();
+			}
+		}
+
 		configBuildTimes.Resize( configsToBuild.size() );
 		configBuildResults.Resize( configsToBuild.size() );
 
@@ -1962,12 +5173,27 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 				Path_SetCwd( oldCWD.data );
 			};
 
+			buildTraceSpan_t span = BuildTrace_BeginSpan( "callback", PRE_BUILD_FUNC_NAME );
 			preBuildFunc();
+			BuildTrace_EndSpan( &span );
 		}
 
-		u32 numSuccessfulBuilds = 0;
-		u32 numFailedBuilds = 0;
-		u32 numSkippedBuilds = 0;
+		// resolve everything about each config up front, before anything starts building
+		// every config globs its source files (and the source files of each of its SourceFilePools) on its own job
+		// reserved up front so pointers to these stay valid while the job pool has them
+		u64 numGlobJobs = 0;
+		For ( u64, configToBuildIndex, 0, configsToBuild.size() ) {
+			numGlobJobs += 2 + configsToBuild[configToBuildIndex].sourceFilePools.size();
+		}
+
+		std::vector<globJob_t> globJobs;
+		globJobs.reserve( numGlobJobs );
+
+		buildTraceSpan_t globSpan = BuildTrace_BeginSpan( "phase", "Resolve configs and glob source files" );
+
+		jobCounter_t globJobCounter;
+		JobCounter_Init( &globJobCounter );
+		defer { JobCounter_Destroy( &globJobCounter ); };
 
 		For ( u64, configToBuildIndex, 0, configsToBuild.size() ) {
 			BuildConfig *config = &configsToBuild[configToBuildIndex];
@@ -1990,14 +5216,6 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 				config->binaryName = defaultBinaryName.data;
 			}
 
-			{
-				if ( !config->name.empty() ) {
-					printf( "Building config \"%s\":\n", config->name.c_str() );
-				} else {
-					printf( "Building config:\n" );
-				}
-			}
-
 #ifdef _WIN32
 			if ( options.linkAgainstWindowsDynamicRuntime ) {
 				config->defines.push_back( "_DLL" );
@@ -2013,6 +5231,14 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 				}
 			}
 
+			if ( config->batchSmallSourceFiles && compilerBackend.CompileSourceFiles ) {
+				MakeCompilerArgumentPathsAbsolute( context.inputFilePath.data, config->additionalCompilerArguments );
+			}
+
+			if ( !config->precompiledHeader.empty() && !Path_IsAbsolute( config->precompiledHeader.c_str() ) ) {
+				config->precompiledHeader = TempPrintf( "%s%c%s", context.inputFilePath.data, PATH_SEPARATOR, config->precompiledHeader.c_str() );
+			}
+
 			// make all non-absolute additional library paths relative to the build source file
 			For ( u64, libPathIndex, 0, config->additionalLibPaths.size() ) {
 				const char *additionalLibPath = config->additionalLibPaths[libPathIndex].c_str();
@@ -2031,40 +5257,196 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 			} else {
 				// otherwise the user told us to build other source files, so go find and build those instead
 				// keep this as a std::vector because this gets fed back into BuilderOptions::sourceFiles
-				config->sourceFiles = BuildConfig_GetAllSourceFiles( &context, config );
+				globJobs.push_back( { &context.inputFilePath, &config->sourceFiles } );
+				JobPool_Submit( GlobJob_Run, &globJobs.back(), &globJobCounter );
 
 				// at this point its totally acceptable for finalSourceFilesToBuild to be empty
 				// this is because the compiler should be the one that tells the user they specified no valid source files to build with
 				// the compiler can and will throw an error for that, so let it
 			}
 
-			// now do the actual build
-			{
-				float64 buildTimeStart = Time_MS();
+			// these get globbed exactly the same way as the config's source files so we can tell which files they mean just by comparing paths
+			For ( u64, sourceFilePoolIndex, 0, config->sourceFilePools.size() ) {
+				globJobs.push_back( { &context.inputFilePath, &config->sourceFilePools[sourceFilePoolIndex].sourceFiles } );
+				JobPool_Submit( GlobJob_Run, &globJobs.back(), &globJobCounter );
+			}
+
+			if ( !config->unityExcludedFiles.empty() ) {
+				globJobs.push_back( { &context.inputFilePath, &config->unityExcludedFiles } );
+				JobPool_Submit( GlobJob_Run, &globJobs.back(), &globJobCounter );
+			}
+		}
+
+		JobPool_Wait( &globJobCounter );
+
+		BuildTrace_EndSpan( &globSpan );
+
+		std::vector<unityConfig_t> unityConfigs;
+		unityConfigs.resize( configsToBuild.size() );
+
+		// only worked out once, since its the same for every config
+		// automatic precompiled headers need it too, so that headers which change often stay out of them
+		bool8 needCommitCounts = showHeaderImpact || showPCHReport;
+		For ( u64, configToBuildIndex, 0, configsToBuild.size() ) {
+			const BuildConfig *config = &configsToBuild[configToBuildIndex];
+
+			if ( config->automaticPrecompiledHeader && config->precompiledHeader.empty() && compilerBackend.CompilePrecompiledHeader ) {
+				needCommitCounts = true;
+			}
+		}
+
+		hashmap_t *commitCounts = needCommitCounts ? GetRecentCommitCounts( &context, context.allocator ) : NULL;
+
+		// picking the headers for a precompiled header needs to know exactly which source files each config builds, so this cant happen any earlier
+		// unity batches change which source files get compiled, so those come first
+		// the reports dont compile anything, so they only need to know what the batches are and mustnt touch the ones on disk
+		bool8 reportOnly = showPCHReport || showHeaderImpact;
+
+		For ( u64, configToBuildIndex, 0, configsToBuild.size() ) {
+			BuildConfig *config = &configsToBuild[configToBuildIndex];
+
+			if ( config->unityBuild ) {
+				buildTraceSpan_t span = BuildTrace_BeginSpan( "generate", "Generate unity batches" );
+
+				if ( !BuildConfig_AssignUnityBatches( &context, config, &unityConfigs[configToBuildIndex], !reportOnly ) || !BuildConfig_GenerateUnityBatches( config, &unityConfigs[configToBuildIndex], !reportOnly ) ) {
+					QUIT_ERROR();
+				}
+
+				BuildTrace_EndSpan( &span, config->binaryName.c_str() );
+			}
+
+			if ( showPCHReport ) {
+				u64 marker = Mem_TempTell();
+				defer { Mem_TempRewindTo( marker ); };
+
+				pchAdvice_t advice;
+				BuildConfig_GetPCHAdvice( &context, config, commitCounts, &advice );
+
+				PCHAdvisor_PrintReport( &advice, config->name.empty() ? config->binaryName.c_str() : config->name.c_str() );
+
+				continue;
+			}
+
+			if ( showHeaderImpact ) {
+				BuildConfig_PrintHeaderImpact( &context, config, commitCounts );
+
+				continue;
+			}
+
+			if ( config->automaticPrecompiledHeader && config->precompiledHeader.empty() && compilerBackend.CompilePrecompiledHeader ) {
+				buildTraceSpan_t span = BuildTrace_BeginSpan( "generate", "Generate precompiled header" );
+
+				if ( !BuildConfig_UpdateAutomaticPrecompiledHeader( &context, config, commitCounts ) ) {
+					QUIT_ERROR();
+				}
+
+				BuildTrace_EndSpan( &span, config->binaryName.c_str() );
+			}
+		}
+
+		if ( reportOnly ) {
+			return 0;
+		}
+
+		// the report needs a trace from every source file, so everything has to actually compile
+		// left until now so the user config build doesnt get traced too
+		if ( showTimeReport ) {
+			string_t compilerPath = compilerBackend.GetCompilerPath( &compilerBackend );
+
+			if ( !String_EndsWith( compilerPath.data, "clang" ) && !String_EndsWith( compilerPath.data, "clang++" ) ) {
+				Error( ARG_TIME_REPORT " needs Clang's -ftime-trace, but you're building with \"%s\".\n", compilerPath.data );
+				QUIT_ERROR();
+			}
+
+			context.timeTrace = true;
+			context.forceRebuild = true;
+			context.compileCache = NULL;
+		}
 
-				configBuildResults[configToBuildIndex] = BuildBinary( &context, config, &compilerBackend, &options );
+		// now do the actual build
+		// every config goes in at once so that configs which dont depend on each other can build at the same time
+		std::vector<configBuild_t> configBuilds;
+		configBuilds.resize( configsToBuild.size() );
+		For ( u64, configToBuildIndex, 0, configsToBuild.size() ) {
+			configBuilds[configToBuildIndex].config = &configsToBuild[configToBuildIndex];
+		}
 
-				configBuildTimes[configToBuildIndex] = Time_MS() - buildTimeStart;
+		bool8 buildSucceeded = BuildConfigs( &context, configBuilds.data(), TruncCast( u32, configBuilds.size() ), &compilerBackend, &options, true );
 
-				switch ( configBuildResults[configToBuildIndex] ) {
-					case BUILD_RESULT_SUCCESS:
-						numSuccessfulBuilds++;
-						printf( "Finished building \"%s\", %f ms\n\n", config->binaryName.c_str(), configBuildTimes[configToBuildIndex] );
-						break;
+		// if any unity batches failed then give their source files a go on their own before calling it a failure, see BuildConfig_SeparateFailedUnityBatches()
+		if ( !buildSucceeded ) {
+			bool8 separatedAnyBatches = false;
 
-					case BUILD_RESULT_FAILED:
-						numFailedBuilds++;
-						Error( "Build failed.\n\n" );
+			For ( u64, configToBuildIndex, 0, configsToBuild.size() ) {
+				BuildConfig *config = &configsToBuild[configToBuildIndex];
+
+				if ( config->unityBuild && BuildConfig_SeparateFailedUnityBatches( &configBuilds[configToBuildIndex], &unityConfigs[configToBuildIndex] ) ) {
+					if ( !BuildConfig_GenerateUnityBatches( config, &unityConfigs[configToBuildIndex], true ) ) {
 						QUIT_ERROR();
+					}
+
+					separatedAnyBatches = true;
+				}
+			}
+
+			if ( separatedAnyBatches ) {
+				// everything that compiled the first time round is up to date now, even if this is a forced rebuild
+				bool8 forceRebuild = context.forceRebuild;
+				context.forceRebuild = false;
+
+				configBuilds.clear();
+				configBuilds.resize( configsToBuild.size() );
+				For ( u64, configToBuildIndex, 0, configsToBuild.size() ) {
+					configBuilds[configToBuildIndex].config = &configsToBuild[configToBuildIndex];
+				}
+
+				buildSucceeded = BuildConfigs( &context, configBuilds.data(), TruncCast( u32, configBuilds.size() ), &compilerBackend, &options, true );
+
+				context.forceRebuild = forceRebuild;
 
-					case BUILD_RESULT_SKIPPED:
-						numSkippedBuilds++;
-						printf( "Skipped!\n\n" );
-						break;
+				For ( u64, configToBuildIndex, 0, configsToBuild.size() ) {
+					if ( !BuildConfig_ConfirmUnityCollisions( &context, &configsToBuild[configToBuildIndex], &unityConfigs[configToBuildIndex] ) ) {
+						QUIT_ERROR();
+					}
 				}
 			}
+		}
+
+		u32 numSuccessfulBuilds = 0;
+
+		For ( u64, configToBuildIndex, 0, configBuilds.size() ) {
+			configBuildResults[configToBuildIndex] = configBuilds[configToBuildIndex].result;
+			configBuildTimes[configToBuildIndex] = configBuilds[configToBuildIndex].buildTimeMS;
+
+			if ( configBuildResults[configToBuildIndex] == BUILD_RESULT_SUCCESS ) {
+				numSuccessfulBuilds++;
+			}
+		}
+
+		// forced rebuilds with -ftime-trace on arent like normal builds, so theyd only throw the trends off
+		if ( !showTimeReport ) {
+			RecordBuildHistory( &context, configBuilds.data(), TruncCast( u32, configBuilds.size() ), buildSucceeded, Time_MS() - totalTimeStart );
+		}
+
+		Mem_ResetTempStorage();
+
+		if ( !buildSucceeded ) {
+			Error( "Build failed.\n\n" );
+			QUIT_ERROR();
+		}
+
+		BuildConfigs_PrintCriticalPath( &context, configBuilds.data(), TruncCast( u32, configBuilds.size() ) );
 
-			Mem_ResetTempStorage();
+		if ( showTimeReport ) {
+			For ( u64, configToBuildIndex, 0, configsToBuild.size() ) {
+				if ( configBuildResults[configToBuildIndex] != BUILD_RESULT_SUCCESS ) {
+					continue;
+				}
+
+				if ( !BuildConfig_WriteTimeReport( &configsToBuild[configToBuildIndex] ) ) {
+					QUIT_ERROR();
+				}
+			}
 		}
 
 		if ( postBuildFunc ) {
@@ -2076,14 +5458,12 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 				Path_SetCwd( oldCWD.data );
 			};
 
+			buildTraceSpan_t span = BuildTrace_BeginSpan( "callback", POST_BUILD_FUNC_NAME );
 			postBuildFunc();
+			BuildTrace_EndSpan( &span );
 		}
 
-		if ( numSuccessfulBuilds > 0 && numFailedBuilds == 0 ) {
-			if ( !WriteIncludeDependenciesFile( &context ) ) {
-				QUIT_ERROR();
-			}
-
+		if ( numSuccessfulBuilds > 0 ) {
 			if ( options.generateCompilationDatabase && !WriteCompilationDatabase( &context ) ) {
 				context.compilationDatabase.clear();
 				QUIT_ERROR();
@@ -2091,6 +5471,10 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 		}
 	}
 
+	// everything we compiled should be in the remote cache before we say we're done, otherwise the next agent to build this commit would miss it
+	// this only waits so long though, a slow remote cache shouldnt hold up a build thats already finished
+	CompileCache_DisconnectRemote( &compileCache );
+
 	// build summary
 	{
 		struct buildSummaryLine_t {
@@ -2125,6 +5509,19 @@ int BuilderMain( const int firstArg, int argc, const char * const * argv ) {
 				printf( "    %-*s: %f ms %s\n", lineLength, line->description, line->timeMS, line->suffix ? line->suffix : "" );
 			}
 		}
+		if ( context.compileCache ) {
+			const compileCache_t *cache = context.compileCache;
+
+			printf( "    %-*s: %u hits, %u misses\n", lineLength, "Compile cache", cache->numHits.value, cache->numMisses.value );
+
+			if ( cache->numConfigHits.value > 0 ) {
+				printf( "    %-*s: %u restored from the cache\n", lineLength, "Configs", cache->numConfigHits.value );
+			}
+
+			if ( usedRemoteCache ) {
+				printf( "    %-*s: %u hits, %u uploads\n", lineLength, "Remote cache", cache->numRemoteHits.value, cache->numRemoteUploads.value );
+			}
+		}
 		// leave this one separate at the end because we want to capture the end timestamp as late as possible
 		printf( "    %-*s: %f ms\n", lineLength, "Total time", Time_MS() - totalTimeStart );
 		printf( "\n" );
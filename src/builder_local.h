@@ -54,6 +54,16 @@ SOFTWARE.
 #define ARG_NUKE				"--nuke"
 #define ARG_CONFIG				"--config="
 #define ARG_VISUAL_STUDIO_BUILD	"--visual-studio-build"
+#define ARG_JOBS				"--jobs="
+#define ARG_NO_CACHE			"--no-cache"
+#define ARG_REMOTE_CACHE		"--remote-cache="
+#define ARG_SERVE_CACHE			"--serve-cache"
+#define ARG_ALL_INTERFACES		"--all-interfaces"
+#define ARG_PCH_REPORT			"--pch-report"
+#define ARG_HEADER_IMPACT		"--header-impact"
+#define ARG_TIME_REPORT			"--time-report"
+#define ARG_TRACE				"--trace="
+#define ARG_STATS				"--stats"
 
 
 struct buildContext_t;
@@ -61,6 +71,9 @@ struct buildContext_t;
 struct hashmap_t;
 struct stringBuilder_t;
 struct linearAllocator_t;
+struct fileStatMemo_t;
+struct includeDependencyDB_t;
+struct compileCache_t;
 
 
 // memory conversion helpers
@@ -78,6 +91,42 @@ struct compilationCommandArchetype_t {
 	array_t<const char *>	baseArgs;
 	array_t<const char *>	dependencyFlags;
 	const char				*outputFlag = nullptr;
+
+	// everything below here is only set if the config has a precompiled header (see BuildConfig::precompiledHeader)
+
+	// what the precompiled header gets compiled into, the build keys its include dependencies by this
+	const char				*precompiledHeaderFile = nullptr;
+
+	// goes on the command line of every source file in the config, but not the precompiled header's
+	array_t<const char *>	precompiledHeaderArgs;
+
+	// every file the precompiled header included
+	// every source file counts these as things it included too, since the compiler wont tell us about them
+	// filled in by the build once the precompiled header is up to date, before any source files compile
+	std::vector<std::string>	precompiledHeaderDependencies;
+
+	// everything below here is only set if the config uses C++20 modules (see BuildConfig::cppModules)
+
+	// what each source file that exports or imports a module needs on the command line on top of everything else
+	// keyed by HashString() of the source file, the values are indices into moduleArgs and moduleInterfaceFiles
+	hashmap_t								*moduleArgsIndices = nullptr;
+	std::vector<std::vector<std::string>>	moduleArgs;
+
+	// the compiled module interface that each of those source files makes, empty if it doesnt export a module
+	std::vector<std::string>				moduleInterfaceFiles;
+};
+
+// a source file that exports or imports a C++20 module (see BuildConfig::cppModules)
+struct moduleUnit_t {
+	const char			*sourceFile;
+
+	// NULL if it doesnt export one
+	const char			*exportedModule;
+
+	// every module it needs, including the ones it only imports indirectly
+	// the compiler needs to be told about all of them, because a compiled module interface refers to the ones it imports by name
+	const char * const	*importedModules;
+	u32					numImportedModules;
 };
 
 struct compilerBackend_t {
@@ -85,7 +134,19 @@ struct compilerBackend_t {
 
 	bool8		( *Init )( compilerBackend_t *backend, const buildContext_t *context, const char *compilerPath, const char *compilerVersion );
 	void		( *Shutdown )( compilerBackend_t *backend );
-	bool8		( *CompileSourceFile )( compilerBackend_t *backend, buildContext_t *buildContext, BuildConfig *config, compilationCommandArchetype_t &commandArchetype, const char *sourceFile, bool recordCompilation, u64 sourceFileIndex, std::vector<std::string> *outIncludeDependencies );
+	// NULL if the backend can't use the compile cache
+	bool8		( *GetCompileCommand )( compilerBackend_t *backend, const buildContext_t *buildContext, const BuildConfig *config, const compilationCommandArchetype_t &commandArchetype, const char *sourceFile, array_t<const char *> *outArgs );
+	bool8		( *CompileSourceFile )( compilerBackend_t *backend, buildContext_t *buildContext, BuildConfig *config, compilationCommandArchetype_t &commandArchetype, const char *sourceFile, bool recordCompilation, u64 sourceFileIndex, std::vector<std::string> *outIncludeDependencies, u64 *outPeakMemoryBytes, bool8 *outCacheHit );
+	// compiles every one of 'sourceFiles' in one run of the compiler, each of the out arrays has one element per source file
+	// returns true if they all compiled
+	// NULL if the backend cant compile more than one source file at once
+	bool8		( *CompileSourceFiles )( compilerBackend_t *backend, buildContext_t *buildContext, BuildConfig *config, compilationCommandArchetype_t &commandArchetype, const char * const *sourceFiles, const u32 numSourceFiles, bool recordCompilation, const u64 *sourceFileIndices, std::vector<std::string> *outIncludeDependencies, bool8 *outSucceeded, bool8 *outCacheHits, u64 *outPeakMemoryBytes );
+	// NULL if the backend can't do precompiled headers
+	bool8		( *CompilePrecompiledHeader )( compilerBackend_t *backend, buildContext_t *buildContext, BuildConfig *config, compilationCommandArchetype_t &commandArchetype, std::vector<std::string> *outIncludeDependencies, u64 *outPeakMemoryBytes );
+	// fills in moduleArgs and moduleInterfaceFiles of 'commandArchetype' with one element for each of 'units', in the same order
+	// also writes anything else the compiler needs for them into the intermediate folder
+	// NULL if the backend can't do C++20 modules
+	bool8		( *GetModuleArgs )( compilerBackend_t *backend, const BuildConfig *config, const moduleUnit_t *units, const u32 numUnits, compilationCommandArchetype_t &commandArchetype );
 	bool8		( *LinkIntermediateFiles )( compilerBackend_t *backend, const std::vector<std::string> &intermediateFiles, BuildConfig *config, const BuilderOptions *options );
 	bool8		( *GetCompilationCommandArchetype )( const compilerBackend_t *backend, const BuildConfig *config, compilationCommandArchetype_t &outCmdArchetype );
 	string_t	( *GetCompilerPath )( compilerBackend_t *backend );
@@ -96,11 +157,6 @@ void	CreateCompilerBackend_Clang( compilerBackend_t *outBackend );
 void	CreateCompilerBackend_MSVC( compilerBackend_t *outBackend );
 void	CreateCompilerBackend_GCC( compilerBackend_t *outBackend );
 
-struct includeDependencies_t {
-	std::string					filename;
-	std::vector<std::string>	includeDependencies;
-};
-
 struct compilationDatabaseEntry_t {
 	std::vector<std::string>	arguments;
 	std::string					directory;
@@ -112,16 +168,28 @@ struct buildContext_t {
 	linearAllocator_t						*allocator;
 
 	hashmap_t								*configIndices;
-	hashmap_t								*sourceFileIndices;
-	std::vector<includeDependencies_t>		sourceFileIncludeDependencies;
+
+	// see include_dependency_db.h
+	includeDependencyDB_t					*includeDependencyDB;
 
 	const char								*inputFile;
 	string_t								inputFilePath;
 	string_t								dotBuilderFolder;
 	string_t								includeDependenciesFilename;
+	string_t								fileHashCacheFilename;
+	string_t								buildHistoryFilename;
+
+	// shared by every compile thread, see file_stat_memo.h
+	fileStatMemo_t							*fileStatMemo;
+
+	// NULL if the compile cache is turned off, see compile_cache.h
+	compileCache_t							*compileCache;
 
 	bool8									forceRebuild;
 	bool8									consolidateCompilerArgs;
+
+	// every source file gets compiled with -ftime-trace, see time_trace.h
+	bool8									timeTrace;
 	std::vector<compilationDatabaseEntry_t>	compilationDatabase;
 
 #ifdef _WIN32
@@ -154,7 +222,13 @@ const char				*BuildConfig_GetFullBinaryName( const BuildConfig *config, linearA
 
 void					RecordCompilationDatabaseEntry( buildContext_t *buildContext, const char *sourceFileName, const array_t<const char *> &compilationCommandArray, u64 sourceFileIndex );
 
-s32						RunProc( array_t<const char *> *args, array_t<const char *> *environmentVariables, const procFlags_t procFlags = 0, string_t *outStdout = NULL );
+s32						RunProc( array_t<const char *> *args, array_t<const char *> *environmentVariables, const procFlags_t procFlags = 0, string_t *outStdout = NULL, u64 *outPeakMemoryBytes = NULL, const char *workingDirectory = NULL );
+
+// Returns how much CPU time every process RunProc() has run so far used, on any thread.
+float64					GetChildProcessCPUTimeMS();
+
+// Same as GetChildProcessCPUTimeMS(), but only counts the processes RunProc() ran on the calling thread.
+float64					GetThreadChildProcessCPUTimeMS();
 
 bool8					WriteStringBuilderToFile( stringBuilder_t *stringBuilder, const char *filename );
 
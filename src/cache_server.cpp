@@ -0,0 +1,277 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "cache_server.h"
+
+#include "remote_cache.h"
+#include "http.h"
+#include "typecast.h"
+#include "debug.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+================================================================================================
+
+	Cache server
+
+================================================================================================
+*/
+
+// same as the biggest blob the HTTP backend will take
+#define CACHE_SERVER_MAX_BLOB_SIZE	( 1024ULL * 1024ULL * 1024ULL )
+
+struct cacheServerConnection_t {
+	cacheServer_t		*server;
+	httpConnection_t	connection;
+	thread_t			thread;
+	atomic32_t			finished;	// set by its thread when it's done, so the accept thread can clean it up
+};
+
+static bool8 CacheServer_SendResponse( httpConnection_t *connection, const u32 statusCode, const char *reason, const u64 contentLength, const bool8 keepAlive, const void *body ) {
+	char head[256];
+	snprintf( head, sizeof( head ), "HTTP/1.1 %u %s\r\nContent-Length: %" PRIu64 "\r\n%s\r\n", statusCode, reason, contentLength, keepAlive ? "" : "Connection: close\r\n" );
+
+	if ( !Socket_Send( &connection->socket, head, strlen( head ) ) ) {
+		return false;
+	}
+
+	if ( body ) {
+		return Socket_Send( &connection->socket, body, contentLength );
+	}
+
+	return true;
+}
+
+// answers one request
+// returns false if the connection needs closing
+static bool8 CacheServer_HandleRequest( httpConnection_t *connection, remoteCacheBackend_t *backend ) {
+	httpHead_t head;
+	if ( !Http_ReadRequestHead( connection, &head ) ) {
+		return false;
+	}
+
+	const char *key = head.path + ( head.path[0] == '/' ? 1 : 0 );
+
+	bool8 isGet = strcmp( head.method, "GET" ) == 0;
+	bool8 isHead = strcmp( head.method, "HEAD" ) == 0;
+	bool8 isPut = strcmp( head.method, "PUT" ) == 0;
+
+	if ( !isGet && !isHead && !isPut ) {
+		Http_SkipBody( connection, head.contentLength );
+		CacheServer_SendResponse( connection, 405, "Method Not Allowed", 0, false, NULL );
+		return false;
+	}
+
+	if ( !RemoteCache_IsValidKey( key ) ) {
+		Http_SkipBody( connection, head.contentLength );
+		CacheServer_SendResponse( connection, 400, "Bad Request", 0, false, NULL );
+		return false;
+	}
+
+	if ( isGet ) {
+		remoteCacheBlob_t blob = {};
+		backend->Get( backend, &key, 1, &blob );
+
+		bool8 sent = blob.found ? CacheServer_SendResponse( connection, 200, "OK", blob.size, head.keepAlive, blob.data ) : CacheServer_SendResponse( connection, 404, "Not Found", 0, head.keepAlive, NULL );
+
+		RemoteCache_FreeBlob( &blob );
+
+		return sent && head.keepAlive;
+	}
+
+	if ( isHead ) {
+		bool8 contains = false;
+		backend->Contains( backend, &key, 1, &contains );
+
+		bool8 sent = contains ? CacheServer_SendResponse( connection, 200, "OK", 0, head.keepAlive, NULL ) : CacheServer_SendResponse( connection, 404, "Not Found", 0, head.keepAlive, NULL );
+
+		return sent && head.keepAlive;
+	}
+
+	// PUT
+	if ( head.contentLength > CACHE_SERVER_MAX_BLOB_SIZE ) {
+		CacheServer_SendResponse( connection, 413, "Payload Too Large", 0, false, NULL );
+		return false;
+	}
+
+	u8 *data = Cast( u8 *, malloc( head.contentLength + 1 ) );
+
+	if ( !data ) {
+		bool8 skipped = Http_SkipBody( connection, head.contentLength );
+		bool8 sent = CacheServer_SendResponse( connection, 500, "Internal Server Error", 0, head.keepAlive && skipped, NULL );
+
+		return sent && skipped && head.keepAlive;
+	}
+
+	if ( !Http_ReadBody( connection, data, head.contentLength ) ) {
+		free( data );
+		return false;
+	}
+
+	bool8 stored = backend->Put( backend, key, data, head.contentLength );
+
+	free( data );
+
+	bool8 sent = stored ? CacheServer_SendResponse( connection, 201, "Created", 0, head.keepAlive, NULL ) : CacheServer_SendResponse( connection, 500, "Internal Server Error", 0, head.keepAlive, NULL );
+
+	return sent && head.keepAlive;
+}
+
+static s32 CacheServer_ConnectionThread( void *data ) {
+	cacheServerConnection_t *connection = Cast( cacheServerConnection_t *, data );
+
+	// the file system backend is what actually looks after the folder
+	remoteCacheBackend_t backend;
+	RemoteCache_CreateBackend_FileSystem( connection->server->folder, &backend );
+
+	while ( !Thread_AtomicLoad( &connection->server->stopping ) && CacheServer_HandleRequest( &connection->connection, &backend ) ) {
+	}
+
+	backend.Shutdown( &backend );
+
+	// stops the client waiting on us, the socket itself gets closed when the connection gets cleaned up
+	Socket_Shutdown( &connection->connection.socket );
+
+	Thread_AtomicStore( &connection->finished, 1 );
+
+	return 0;
+}
+
+static void CacheServer_DestroyConnection( cacheServerConnection_t *connection ) {
+	Thread_Wait( &connection->thread );
+	Thread_Destroy( &connection->thread );
+
+	Http_CloseConnection( &connection->connection );
+	free( connection );
+}
+
+// a server can be up for a long time, so dont hang on to connections that are done
+// must be holding the mutex
+static void CacheServer_CleanUpFinishedConnections( cacheServer_t *server ) {
+	u64 numStillOpen = 0;
+
+	For ( u64, connectionIndex, 0, server->connections.size() ) {
+		cacheServerConnection_t *connection = server->connections[connectionIndex];
+
+		if ( Thread_AtomicLoad( &connection->finished ) ) {
+			CacheServer_DestroyConnection( connection );
+		} else {
+			server->connections[numStillOpen++] = connection;
+		}
+	}
+
+	server->connections.resize( numStillOpen );
+}
+
+static s32 CacheServer_AcceptThread( void *data ) {
+	cacheServer_t *server = Cast( cacheServer_t *, data );
+
+	while ( 1 ) {
+		socket_t socket;
+		if ( !Socket_Accept( &server->listenSocket, &socket ) ) {
+			break;
+		}
+
+		if ( Thread_AtomicLoad( &server->stopping ) ) {
+			Socket_Close( &socket );
+			break;
+		}
+
+		cacheServerConnection_t *connection = Cast( cacheServerConnection_t *, malloc( sizeof( cacheServerConnection_t ) ) );
+		connection->server = server;
+		connection->finished.value = 0;
+		Http_OpenConnection( &connection->connection, socket );
+
+		Mutex_Lock( &server->mutex );
+		CacheServer_CleanUpFinishedConnections( server );
+		server->connections.push_back( connection );
+		connection->thread = Thread_Create( CacheServer_ConnectionThread, connection );
+		Mutex_Unlock( &server->mutex );
+	}
+
+	return 0;
+}
+
+bool8 CacheServer_Start( cacheServer_t *server, const char *folder, const u16 port, const bool8 allInterfaces ) {
+	Assert( server );
+	Assert( folder );
+
+	server->folder = folder;
+	server->stopping.value = 0;
+
+	if ( !Socket_Listen( port, allInterfaces, &server->listenSocket ) ) {
+		return false;
+	}
+
+	server->port = Socket_GetPort( &server->listenSocket );
+	server->mutex = Mutex_Create();
+	server->acceptThread = Thread_Create( CacheServer_AcceptThread, server );
+
+	return true;
+}
+
+void CacheServer_Wait( cacheServer_t *server ) {
+	Assert( server );
+
+	Thread_Wait( &server->acceptThread );
+}
+
+void CacheServer_Stop( cacheServer_t *server ) {
+	Assert( server );
+
+	Thread_AtomicStore( &server->stopping, 1 );
+
+	// accept() doesnt wake up for anything else on every OS
+	socket_t wakeUp;
+	if ( Socket_Connect( "localhost", server->port, 1000, &wakeUp ) ) {
+		Socket_Close( &wakeUp );
+	}
+
+	// CacheServer_Wait() might have already waited for it
+	if ( server->acceptThread.ptr ) {
+		Thread_Wait( &server->acceptThread );
+	}
+	Thread_Destroy( &server->acceptThread );
+
+	// nothing else is adding to the list now
+	For ( u64, connectionIndex, 0, server->connections.size() ) {
+		cacheServerConnection_t *connection = server->connections[connectionIndex];
+
+		Socket_Shutdown( &connection->connection.socket );
+		CacheServer_DestroyConnection( connection );
+	}
+
+	server->connections.clear();
+
+	Mutex_Destroy( &server->mutex );
+	Socket_Close( &server->listenSocket );
+}
@@ -0,0 +1,88 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "socket.h"
+#include "thread.h"
+
+#include <vector>
+
+/*
+================================================================================================
+
+	Cache server
+
+	A tiny HTTP server for a remote cache (see remote_cache.h), so the HTTP backend can be tried
+	out and tested without setting up a real one.  Run it with "builder --serve-cache <folder>
+	<port>".
+
+	Blobs live in a folder laid out the same as the file system backend, so the same folder can
+	be served over HTTP and used directly at the same time.
+
+	- "GET /<key>"		200 with the blob, or 404.
+	- "HEAD /<key>"		200 or 404.
+	- "PUT /<key>"		201 once the blob is stored.
+
+	Every connection gets its own thread and is kept alive until the client closes it, and
+	requests on a connection are answered in the order they came in, so clients can pipeline
+	them.  There's no authentication, so anyone who can connect can put whatever object files
+	they like in the cache.  That's why it only listens on the loopback address unless you
+	explicitly ask for every network interface, and even then it's only meant for a trusted
+	network.  Nothing ever gets deleted either.
+
+================================================================================================
+*/
+
+struct cacheServerConnection_t;
+
+struct cacheServer_t {
+	const char								*folder;
+
+	socket_t								listenSocket;
+	u16										port;
+
+	thread_t								acceptThread;
+	atomic32_t								stopping;
+
+	mutex_t									mutex;
+	std::vector<cacheServerConnection_t *>	connections;
+};
+
+// Starts listening on 'port' and serving blobs out of 'folder' on other threads.
+// Only other processes on this machine can connect unless 'allInterfaces' is true, see Socket_Listen().
+// Pass 0 for 'port' to have the OS pick one, 'server->port' says which one it got.
+// Returns false if it couldn't listen on that port.
+bool8	CacheServer_Start( cacheServer_t *server, const char *folder, const u16 port, const bool8 allInterfaces );
+
+// Blocks until the server stops, which is only ever when something goes wrong or CacheServer_Stop() gets called.
+void	CacheServer_Wait( cacheServer_t *server );
+
+// Closes every connection and waits for the server's threads to finish.
+void	CacheServer_Stop( cacheServer_t *server );
@@ -0,0 +1,1670 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "compile_cache.h"
+
+#include "file_stat_memo.h"
+#include "file.h"
+#include "hash.h"
+#include "compression.h"
+#include "remote_cache.h"
+#include "hashmap.h"
+#include "linear_allocator.h"
+#include "string.h"
+#include "string_builder.h"
+#include "temp_storage.h"
+#include "timer.h"
+#include "array.inl"
+#include "typecast.h"
+#include "debug.h"
+#include "defer.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+================================================================================================
+
+	Compile cache
+
+================================================================================================
+*/
+
+// how many different include lists we remember for each command before forgetting the oldest
+// switching between a handful of branches is the common case, so this doesnt need to be big
+#define COMPILE_CACHE_MAX_MANIFEST_ENTRIES	16
+
+// what the root folder gets swapped for inside the cache
+#define COMPILE_CACHE_ROOT_MARKER			"$BUILDER_ROOT"
+
+#define COMPILE_CACHE_COMPRESSED_MAGIC		0x315A4C42	// "BLZ1"
+
+// when the cache gets too big, trim it down to this much of the max size so that we dont end up trimming it again on the very next build
+#define COMPILE_CACHE_TRIM_TARGET_PERCENT	90
+
+// only ever holds the lookup queue, but there can be a lot of source files
+#define COMPILE_CACHE_REMOTE_MEMORY_RESERVE	( 1ULL << 32 )
+
+struct manifestEntry_t {
+	const char	**includeDependencies;	// with the root folder swapped out
+	u64			numIncludeDependencies;
+};
+
+// goes at the start of every compressed object file
+struct compressedObjectHeader_t {
+	u32		magic;
+	u32		padding;
+	u64		sizeBytes;		// before it got compressed
+	u64		contentHash;	// of the object file before it got compressed, so we never put back something that got corrupted
+};
+
+static const char *CompileCache_GetEntryPath( const compileCache_t *cache, const u64 hash, const char *extension ) {
+	// split entries across subfolders by the top byte of the hash so no one folder ends up with too many files in it
+	return TempPrintf( "%s/%02" PRIx64 "/%016" PRIx64 ".%s", cache->folder, hash >> 56, hash, extension );
+}
+
+static const char *CompileCache_GetTempFilename( const char *filename ) {
+	// the time plus the address of something on this thread's stack is unique enough across threads and other Builders sharing the cache
+	u64 cycles = Cast( u64, Time_Cycles() );
+	u64 unique = Hash64( &cycles, sizeof( u64 ), Cast( u64, &cycles ) );
+
+	return TempPrintf( "%s.%016" PRIx64 ".tmp", filename, unique );
+}
+
+// returns a copy of 'str' in temp storage with every 'from' swapped for 'to'
+static string_t CompileCache_ReplaceAll( const char *str, const u64 length, const char *from, const char *to ) {
+	u64 fromLength = strlen( from );
+	u64 toLength = strlen( to );
+
+	u64 numOccurrences = 0;
+	for ( u64 i = 0; i + fromLength <= length; ) {
+		if ( memcmp( str + i, from, fromLength ) == 0 ) {
+			numOccurrences++;
+			i += fromLength;
+		} else {
+			i++;
+		}
+	}
+
+	u64 newLength = length - ( numOccurrences * fromLength ) + ( numOccurrences * toLength );
+
+	char *result = Cast( char *, Mem_TempAlloc( newLength + 1, 1 ) );
+	char *out = result;
+
+	for ( u64 i = 0; i < length; ) {
+		if ( i + fromLength <= length && memcmp( str + i, from, fromLength ) == 0 ) {
+			memcpy( out, to, toLength );
+			out += toLength;
+			i += fromLength;
+		} else {
+			*out++ = str[i];
+			i++;
+		}
+	}
+
+	*out = 0;
+
+	return String_Set( result, newLength );
+}
+
+// swaps the root folder for the placeholder
+static string_t CompileCache_RemoveRoot( const compileCache_t *cache, const char *str, const u64 length ) {
+	if ( !cache->rootFolder ) {
+		return String_Set( str, length );
+	}
+
+	return CompileCache_ReplaceAll( str, length, cache->rootFolder, COMPILE_CACHE_ROOT_MARKER );
+}
+
+// swaps the placeholder for the root folder
+static string_t CompileCache_RestoreRoot( const compileCache_t *cache, const char *str, const u64 length ) {
+	if ( !cache->rootFolder ) {
+		return String_Set( str, length );
+	}
+
+	return CompileCache_ReplaceAll( str, length, COMPILE_CACHE_ROOT_MARKER, cache->rootFolder );
+}
+
+static bool8 CompileCache_WriteFileAtomically( const char *filename, const void *data, const u64 size ) {
+	const char *tempFilename = CompileCache_GetTempFilename( filename );
+
+	if ( !FS_WriteEntireFile( tempFilename, data, size ) ) {
+		return false;
+	}
+
+	if ( !FS_RenameFile( tempFilename, filename ) ) {
+		FS_DeleteFile( tempFilename );
+		return false;
+	}
+
+	return true;
+}
+
+// puts 'filename' at 'newFilename' as cheaply as the file system lets us
+static bool8 CompileCache_PlaceFile( const char *filename, const char *newFilename ) {
+	if ( FS_FileExists( newFilename ) && !FS_DeleteFile( newFilename ) ) {
+		return false;
+	}
+
+	if ( FS_CloneFile( filename, newFilename ) ) {
+		return true;
+	}
+
+	// hard links across volumes (e.g. a cache folder on another drive) dont work, so copying is the last resort
+	if ( FS_HardLinkFile( filename, newFilename ) ) {
+		return true;
+	}
+
+	return FS_CopyFile( filename, newFilename );
+}
+
+// for text files that might have the root folder in them
+static bool8 CompileCache_StoreTextFile( const compileCache_t *cache, const char *entryFilename, const char *text, const u64 length ) {
+	string_t remapped = CompileCache_RemoveRoot( cache, text, length );
+
+	return CompileCache_WriteFileAtomically( entryFilename, remapped.data, remapped.count );
+}
+
+static bool8 CompileCache_RestoreTextFile( const compileCache_t *cache, const char *entryFilename, string_t *outText ) {
+	string_t contents = {};
+	if ( !FS_ReadEntireFile( entryFilename, &contents ) ) {
+		return false;
+	}
+
+	defer { FS_FreeFileBuffer( &contents ); };
+
+	*outText = CompileCache_RestoreRoot( cache, contents.data, contents.count );
+
+	// if it just gave us back what we passed in then it needs copying out before we free it
+	if ( outText->data == contents.data ) {
+		*outText = String_Alloc( Mem_GetTempStorage(), contents.data, contents.count );
+	}
+
+	return true;
+}
+
+// returns the object file compressed, with a compressedObjectHeader_t in front
+// free it with free()
+static u8 *CompileCache_CompressObject( const void *object, const u64 size, u64 *outCompressedSize ) {
+	u8 *compressed = Cast( u8 *, malloc( sizeof( compressedObjectHeader_t ) + Compression_GetMaxCompressedSize( size ) ) );
+	if ( !compressed ) {
+		return NULL;
+	}
+
+	compressedObjectHeader_t header = {
+		.magic			= COMPILE_CACHE_COMPRESSED_MAGIC,
+		.padding		= 0,
+		.sizeBytes		= size,
+		.contentHash	= Hash64( object, size, 0 ),
+	};
+	memcpy( compressed, &header, sizeof( compressedObjectHeader_t ) );
+
+	*outCompressedSize = sizeof( compressedObjectHeader_t ) + Compression_Compress( object, size, compressed + sizeof( compressedObjectHeader_t ) );
+
+	return compressed;
+}
+
+// the opposite of CompileCache_CompressObject()
+// returns NULL if it isnt a compressed object file or if it got corrupted
+// free it with free()
+static u8 *CompileCache_DecompressObject( const void *compressed, const u64 compressedSize, u64 *outSize ) {
+	if ( compressedSize < sizeof( compressedObjectHeader_t ) ) {
+		return NULL;
+	}
+
+	compressedObjectHeader_t header;
+	memcpy( &header, compressed, sizeof( compressedObjectHeader_t ) );
+
+	if ( header.magic != COMPILE_CACHE_COMPRESSED_MAGIC ) {
+		return NULL;
+	}
+
+	u8 *object = Cast( u8 *, malloc( header.sizeBytes + 1 ) );
+	if ( !object ) {
+		return NULL;
+	}
+
+	const u8 *compressedData = Cast( const u8 *, compressed ) + sizeof( compressedObjectHeader_t );
+
+	if ( !Compression_Decompress( compressedData, compressedSize - sizeof( compressedObjectHeader_t ), object, header.sizeBytes ) || Hash64( object, header.sizeBytes, 0 ) != header.contentHash ) {
+		free( object );
+		return NULL;
+	}
+
+	*outSize = header.sizeBytes;
+
+	return object;
+}
+
+static bool8 CompileCache_StoreCompressedObject( const char *objectFile, const char *entryFilename ) {
+	string_t object = {};
+	if ( !FS_ReadEntireFile( objectFile, &object ) ) {
+		return false;
+	}
+
+	defer { FS_FreeFileBuffer( &object ); };
+
+	u64 compressedSize = 0;
+	u8 *compressed = CompileCache_CompressObject( object.data, object.count, &compressedSize );
+	if ( !compressed ) {
+		return false;
+	}
+
+	defer { free( compressed ); };
+
+	return CompileCache_WriteFileAtomically( entryFilename, compressed, compressedSize );
+}
+
+static bool8 CompileCache_RestoreCompressedObject( const char *entryFilename, const char *objectFile ) {
+	string_t compressed = {};
+	if ( !FS_ReadEntireFile( entryFilename, &compressed ) ) {
+		return false;
+	}
+
+	defer { FS_FreeFileBuffer( &compressed ); };
+
+	u64 size = 0;
+	u8 *object = CompileCache_DecompressObject( compressed.data, compressed.count, &size );
+	if ( !object ) {
+		return false;
+	}
+
+	defer { free( object ); };
+
+	// the object file might be a hard link into a different cache, so dont write through it
+	if ( FS_FileExists( objectFile ) && !FS_DeleteFile( objectFile ) ) {
+		return false;
+	}
+
+	return FS_WriteEntireFile( objectFile, object, size );
+}
+
+// same as GetSourceFileInputsHash() in builder.cpp, except the paths that get hashed have the root folder swapped out
+// 'sourceFile' is NULL for configs, their source files are part of the config key instead
+static u64 CompileCache_GetInputsHash( compileCache_t *cache, const char *sourceFile, const char * const *includeDependencies, const u64 numIncludeDependencies ) {
+	u64 contentHash = 0;
+
+	if ( sourceFile ) {
+		if ( !FileStatMemo_GetFileHash( cache->fileStatMemo, sourceFile, &contentHash ) ) {
+			return 0;
+		}
+	} else {
+		// anything but 0, which means the inputs couldnt be hashed
+		contentHash = numIncludeDependencies + 1;
+	}
+
+	u64 inputsHash = Hash64( &contentHash, sizeof( u64 ), 0 );
+
+	For ( u64, dependencyIndex, 0, numIncludeDependencies ) {
+		const char *dependency = includeDependencies[dependencyIndex];
+		string_t dependencyFilename = CompileCache_RestoreRoot( cache, dependency, strlen( dependency ) );
+
+		if ( !FileStatMemo_GetFileHash( cache->fileStatMemo, dependencyFilename.data, &contentHash ) ) {
+			return 0;
+		}
+
+		inputsHash = HashString( dependency, inputsHash );
+		inputsHash = Hash64( &contentHash, sizeof( u64 ), inputsHash );
+	}
+
+	return inputsHash;
+}
+
+// the manifest is a list of entries, each one being the number of include dependencies on one line followed by each include dependency on its own line
+// everything in 'outEntries' points into 'manifest', which gets changed
+static void CompileCache_ParseManifest( char *manifest, const u64 size, array_t<manifestEntry_t> *outEntries ) {
+	char *current = manifest;
+	char *end = manifest + size;
+
+	// turn every line into its own string
+	For ( char *, c, current, end ) {
+		if ( *c == '\n' ) {
+			*c = 0;
+		}
+	}
+
+	while ( current < end && outEntries->count < COMPILE_CACHE_MAX_MANIFEST_ENTRIES ) {
+		char *countEnd = NULL;
+		u64 numIncludeDependencies = strtoull( current, &countEnd, 10 );
+
+		// someone else half-wrote it or it got corrupted, either way just treat it as finished
+		if ( countEnd == current || *countEnd != 0 ) {
+			break;
+		}
+
+		current = countEnd + 1;
+
+		// every include dependency takes at least one byte, so this can only be a corrupt count
+		if ( numIncludeDependencies > Cast( u64, end - current ) ) {
+			break;
+		}
+
+		manifestEntry_t entry = {
+			.includeDependencies	= Cast( const char **, Mem_TempAlloc( ( numIncludeDependencies + 1 ) * sizeof( const char * ) ) ),
+			.numIncludeDependencies	= numIncludeDependencies,
+		};
+
+		For ( u64, dependencyIndex, 0, numIncludeDependencies ) {
+			if ( current >= end ) {
+				return;
+			}
+
+			entry.includeDependencies[dependencyIndex] = current;
+			current += strlen( current ) + 1;
+		}
+
+		outEntries->Add( entry );
+	}
+}
+
+// everything in 'outEntries' points into 'outBuffer', so free that with FS_FreeFileBuffer() only when youre done with them
+static bool8 CompileCache_ReadManifest( const char *manifestFilename, string_t *outBuffer, array_t<manifestEntry_t> *outEntries ) {
+	if ( !FS_ReadEntireFile( manifestFilename, outBuffer ) ) {
+		return false;
+	}
+
+	CompileCache_ParseManifest( outBuffer->data, outBuffer->count, outEntries );
+
+	return true;
+}
+
+static bool8 CompileCache_SameIncludeDependencies( const manifestEntry_t *entry, const char * const *includeDependencies, const u64 numIncludeDependencies ) {
+	if ( entry->numIncludeDependencies != numIncludeDependencies ) {
+		return false;
+	}
+
+	For ( u64, dependencyIndex, 0, numIncludeDependencies ) {
+		if ( !String_Equals( entry->includeDependencies[dependencyIndex], includeDependencies[dependencyIndex] ) ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void CompileCache_AppendManifestEntry( stringBuilder_t *sb, const char * const *includeDependencies, const u64 numIncludeDependencies ) {
+	SB_Appendf( sb, "%" PRIu64 "\n", numIncludeDependencies );
+
+	For ( u64, dependencyIndex, 0, numIncludeDependencies ) {
+		SB_Appendf( sb, "%s\n", includeDependencies[dependencyIndex] );
+	}
+}
+
+// writes out a manifest with 'newEntries' first and then whatever 'oldEntries' has that 'newEntries' doesnt, up to the max
+static const char *CompileCache_MergeManifests( const array_t<manifestEntry_t> *newEntries, const array_t<manifestEntry_t> *oldEntries ) {
+	stringBuilder_t sb = SB_Create( Mem_GetTempStorage() );
+
+	const manifestEntry_t *mergedEntries[COMPILE_CACHE_MAX_MANIFEST_ENTRIES];
+	u64 numMergedEntries = 0;
+
+	const array_t<manifestEntry_t> *lists[] = { newEntries, oldEntries };
+
+	For ( u64, listIndex, 0, COUNT_OF( lists ) ) {
+		For ( u64, entryIndex, 0, lists[listIndex]->count ) {
+			if ( numMergedEntries == COMPILE_CACHE_MAX_MANIFEST_ENTRIES ) {
+				break;
+			}
+
+			const manifestEntry_t *entry = &( *lists[listIndex] )[entryIndex];
+
+			bool8 duplicate = false;
+			For ( u64, mergedIndex, 0, numMergedEntries ) {
+				if ( CompileCache_SameIncludeDependencies( mergedEntries[mergedIndex], entry->includeDependencies, entry->numIncludeDependencies ) ) {
+					duplicate = true;
+					break;
+				}
+			}
+
+			if ( duplicate ) {
+				continue;
+			}
+
+			CompileCache_AppendManifestEntry( &sb, entry->includeDependencies, entry->numIncludeDependencies );
+
+			mergedEntries[numMergedEntries++] = entry;
+		}
+	}
+
+	return SB_ToString( &sb );
+}
+
+// 'includeDependencies' must have the root folder swapped out already
+static bool8 CompileCache_AddToManifest( compileCache_t *cache, const u64 commandHash, const char * const *includeDependencies, const u64 numIncludeDependencies ) {
+	const char *manifestFilename = CompileCache_GetEntryPath( cache, commandHash, "manifest" );
+
+	string_t manifestBuffer = {};
+	array_t<manifestEntry_t> entries;
+	entries.Init( Mem_GetTempStorage() );
+
+	bool8 readManifest = CompileCache_ReadManifest( manifestFilename, &manifestBuffer, &entries );
+	defer {
+		if ( readManifest ) {
+			FS_FreeFileBuffer( &manifestBuffer );
+		}
+	};
+
+	array_t<manifestEntry_t> newEntries;
+	newEntries.Init( Mem_GetTempStorage() );
+	newEntries.Add( { Cast( const char **, includeDependencies ), numIncludeDependencies } );
+
+	const char *manifest = CompileCache_MergeManifests( &newEntries, &entries );
+
+	// if another Builder updated the manifest at the same time then one of the include lists gets lost, but its entry is still there
+	// so the worst case is that it gets compiled one more time
+	return CompileCache_WriteFileAtomically( manifestFilename, manifest, strlen( manifest ) );
+}
+
+// looks through the manifest for an include list whose files havent changed since it was stored
+// 'extension' is the file that makes the entry count
+// returns the hash of its entry, or 0 if there isnt one
+static u64 CompileCache_FindEntry( compileCache_t *cache, const u64 commandHash, const char *sourceFile, const char *extension ) {
+	string_t manifestBuffer = {};
+	array_t<manifestEntry_t> entries;
+	entries.Init( Mem_GetTempStorage() );
+
+	if ( !CompileCache_ReadManifest( CompileCache_GetEntryPath( cache, commandHash, "manifest" ), &manifestBuffer, &entries ) ) {
+		return 0;
+	}
+
+	defer { FS_FreeFileBuffer( &manifestBuffer ); };
+
+	For ( u64, entryIndex, 0, entries.count ) {
+		const manifestEntry_t *entry = &entries[entryIndex];
+
+		u64 inputsHash = CompileCache_GetInputsHash( cache, sourceFile, entry->includeDependencies, entry->numIncludeDependencies );
+		if ( inputsHash == 0 ) {
+			continue;
+		}
+
+		u64 entryHash = Hash64( &inputsHash, sizeof( u64 ), commandHash );
+
+		if ( FS_FileExists( CompileCache_GetEntryPath( cache, entryHash, extension ) ) ) {
+			return entryHash;
+		}
+	}
+
+	return 0;
+}
+
+/*
+================================================================================================
+
+	Remote cache
+
+	The build never waits on the remote cache.  The main thread queues a lookup for every file
+	it's about to compile, in the order they'll get compiled, and the lookup thread works
+	through them in batches, copying any entries it finds into the local cache.  When a compile
+	job gets to its file the entry is either in the local cache already, or the job cancels the
+	lookup and compiles the file itself, which is what would have happened without a remote
+	cache anyway.  The only exception is a lookup that's already waiting on the remote cache,
+	which the job gives a moment to finish first.
+
+	Every store gets uploaded on another thread, which only gets waited on at the very end, and
+	only for so long.  Whatever hasn't been uploaded by then gets dropped, since the build is
+	done and a slow remote cache shouldn't be able to hold it up.
+
+================================================================================================
+*/
+
+// how many lookups get their requests sent together
+#define COMPILE_CACHE_REMOTE_BATCH_SIZE		64
+
+// the most a compile job waits for a lookup thats already in flight
+// compiling almost anything takes longer than this, and at most one batch of lookups is ever in flight, so a slow remote cache can only ever cost this much per batch
+#define COMPILE_CACHE_REMOTE_MAX_WAIT_MS	100
+
+// this many failed requests in a row and we assume the remote cache is down and stop using it
+#define COMPILE_CACHE_REMOTE_MAX_FAILURES	3
+
+// the most the end of the build waits for uploads that are still queued, anything left after that doesnt get uploaded
+#define COMPILE_CACHE_REMOTE_MAX_DRAIN_MS	5000
+
+enum remoteLookupState_t {
+	REMOTE_LOOKUP_STATE_QUEUED,
+	REMOTE_LOOKUP_STATE_IN_FLIGHT,
+	REMOTE_LOOKUP_STATE_DONE,
+	REMOTE_LOOKUP_STATE_CANCELLED,
+};
+
+struct remoteLookup_t {
+	u64			commandHash;
+	const char	*sourceFile;
+	atomic32_t	state;	// remoteLookupState_t
+	bool8		found;	// only valid once the lookup is done
+};
+
+struct remoteUpload_t {
+	u64			commandHash;
+	u64			entryHash;
+};
+
+struct remoteCandidate_t {
+	u32				lookupIndex;
+	u64				entryHash;
+	manifestEntry_t	manifestEntry;
+};
+
+struct compileCacheRemote_t {
+	// one for each thread, since a backend can only be used by one thread at a time
+	remoteCacheBackend_t			lookupBackend;
+	remoteCacheBackend_t			uploadBackend;
+
+	// everything below gets allocated from here, and only while the mutex is locked
+	linearAllocator_t				*allocator;
+	mutex_t							mutex;
+
+	hashmap_t						*lookupIndices;	// command hash -> index into 'lookups'
+	array_t<remoteLookup_t *>		lookups;
+	u64								nextLookup;
+
+	array_t<remoteUpload_t>			uploads;
+	u64								nextUpload;
+	u64								numUploadsDropped;	// only touched by the upload thread until its stopped
+
+	float64							drainDeadlineMS;	// set before 'stopping'
+
+	semaphore_t						lookupsQueued;
+	semaphore_t						uploadsQueued;
+
+	thread_t						lookupThread;
+	thread_t						uploadThread;
+
+	atomic32_t						stopping;
+	atomic32_t						numFailuresInARow;
+	atomic32_t						answered;	// at least once
+	atomic32_t						disabled;
+};
+
+static const char *CompileCache_GetEntryKey( const u64 hash, const char *extension ) {
+	return TempPrintf( "%02" PRIx64 "/%016" PRIx64 ".%s", hash >> 56, hash, extension );
+}
+
+static void CompileCache_RecordRemoteResult( compileCacheRemote_t *remote, const bool8 succeeded ) {
+	if ( succeeded ) {
+		Thread_AtomicStore( &remote->numFailuresInARow, 0 );
+		Thread_AtomicStore( &remote->answered, 1 );
+		return;
+	}
+
+	u32 numFailuresInARow = Thread_AtomicIncrement( &remote->numFailuresInARow );
+
+	// if it hasnt answered once yet then its probably not there at all, so dont let every upload wait to find that out at the end of the build
+	if ( numFailuresInARow == COMPILE_CACHE_REMOTE_MAX_FAILURES || ( numFailuresInARow == 1 && !Thread_AtomicLoad( &remote->answered ) ) ) {
+		Thread_AtomicStore( &remote->disabled, 1 );
+
+		Warning( "Remote cache %s isn't responding, so it won't be used for the rest of this build.\n", remote->lookupBackend.description );
+	}
+}
+
+static void CompileCache_FreeBlobs( remoteCacheBlob_t *blobs, const u32 count ) {
+	For ( u32, blobIndex, 0, count ) {
+		RemoteCache_FreeBlob( &blobs[blobIndex] );
+	}
+}
+
+// puts an entry that came from the remote cache into the local cache
+// the remote cache always has the object file compressed, and the text files with the root folder swapped out (same as the local cache, since it has to have a root folder)
+static bool8 CompileCache_InstallRemoteEntry( compileCache_t *cache, const u64 commandHash, const remoteCandidate_t *candidate, const remoteCacheBlob_t *objectBlob, const remoteCacheBlob_t *depFileBlob, const remoteCacheBlob_t *outputBlob ) {
+	u64 entryHash = candidate->entryHash;
+
+	if ( !objectBlob->found || !depFileBlob->found ) {
+		return false;
+	}
+
+	if ( !FS_CreateFolderIfItDoesntExist( TempPrintf( "%s/%02" PRIx64, cache->folder, entryHash >> 56 ) ) ) {
+		return false;
+	}
+
+	if ( !FS_CreateFolderIfItDoesntExist( TempPrintf( "%s/%02" PRIx64, cache->folder, commandHash >> 56 ) ) ) {
+		return false;
+	}
+
+	if ( outputBlob->found ) {
+		if ( !CompileCache_WriteFileAtomically( CompileCache_GetEntryPath( cache, entryHash, "out" ), outputBlob->data, outputBlob->size ) ) {
+			return false;
+		}
+	}
+
+	if ( !CompileCache_WriteFileAtomically( CompileCache_GetEntryPath( cache, entryHash, "d" ), depFileBlob->data, depFileBlob->size ) ) {
+		return false;
+	}
+
+	// object file goes last, same as CompileCache_Store()
+	if ( cache->compress ) {
+		// CompileCache_RestoreCompressedObject() checks that it didnt get corrupted along the way
+		if ( !CompileCache_WriteFileAtomically( CompileCache_GetEntryPath( cache, entryHash, "lz" ), objectBlob->data, objectBlob->size ) ) {
+			return false;
+		}
+	} else {
+		u64 objectSize = 0;
+		u8 *object = CompileCache_DecompressObject( objectBlob->data, objectBlob->size, &objectSize );
+		if ( !object ) {
+			return false;
+		}
+
+		defer { free( object ); };
+
+		if ( !CompileCache_WriteFileAtomically( CompileCache_GetEntryPath( cache, entryHash, "o" ), object, objectSize ) ) {
+			return false;
+		}
+	}
+
+	return CompileCache_AddToManifest( cache, commandHash, candidate->manifestEntry.includeDependencies, candidate->manifestEntry.numIncludeDependencies );
+}
+
+// three round trips no matter how many lookups there are: get the manifests, check which entries are there, then get those entries
+static void CompileCache_RunRemoteLookups( compileCache_t *cache, remoteLookup_t **lookups, const u32 count ) {
+	compileCacheRemote_t *remote = cache->remote;
+	remoteCacheBackend_t *backend = &remote->lookupBackend;
+
+	// dont ask for anything the local cache already has
+	remoteLookup_t **misses = Cast( remoteLookup_t **, Mem_TempAlloc( count * sizeof( remoteLookup_t * ) ) );
+	u32 numMisses = 0;
+
+	For ( u32, lookupIndex, 0, count ) {
+		if ( CompileCache_FindEntry( cache, lookups[lookupIndex]->commandHash, lookups[lookupIndex]->sourceFile, cache->compress ? "lz" : "o" ) == 0 ) {
+			misses[numMisses++] = lookups[lookupIndex];
+		}
+	}
+
+	if ( numMisses == 0 ) {
+		return;
+	}
+
+	// manifests
+	const char **manifestKeys = Cast( const char **, Mem_TempAlloc( numMisses * sizeof( const char * ) ) );
+	For ( u32, missIndex, 0, numMisses ) {
+		manifestKeys[missIndex] = CompileCache_GetEntryKey( misses[missIndex]->commandHash, "manifest" );
+	}
+
+	remoteCacheBlob_t *manifests = Cast( remoteCacheBlob_t *, Mem_TempAlloc( numMisses * sizeof( remoteCacheBlob_t ) ) );
+
+	bool8 gotManifests = backend->Get( backend, manifestKeys, numMisses, manifests );
+	CompileCache_RecordRemoteResult( remote, gotManifests );
+
+	if ( !gotManifests ) {
+		return;
+	}
+
+	defer { CompileCache_FreeBlobs( manifests, numMisses ); };
+
+	// work out which entries would be hits and check which of those are actually there
+	array_t<remoteCandidate_t> candidates;
+	candidates.Init( Mem_GetTempStorage() );
+
+	For ( u32, missIndex, 0, numMisses ) {
+		if ( !manifests[missIndex].found ) {
+			continue;
+		}
+
+		array_t<manifestEntry_t> entries;
+		entries.Init( Mem_GetTempStorage() );
+
+		CompileCache_ParseManifest( Cast( char *, manifests[missIndex].data ), manifests[missIndex].size, &entries );
+
+		For ( u64, entryIndex, 0, entries.count ) {
+			const manifestEntry_t *entry = &entries[entryIndex];
+
+			u64 inputsHash = CompileCache_GetInputsHash( cache, misses[missIndex]->sourceFile, entry->includeDependencies, entry->numIncludeDependencies );
+			if ( inputsHash == 0 ) {
+				continue;
+			}
+
+			candidates.Add( {
+				.lookupIndex	= missIndex,
+				.entryHash		= Hash64( &inputsHash, sizeof( u64 ), misses[missIndex]->commandHash ),
+				.manifestEntry	= *entry,
+			} );
+		}
+	}
+
+	if ( candidates.count == 0 ) {
+		return;
+	}
+
+	const char **objectKeys = Cast( const char **, Mem_TempAlloc( candidates.count * sizeof( const char * ) ) );
+	For ( u64, candidateIndex, 0, candidates.count ) {
+		objectKeys[candidateIndex] = CompileCache_GetEntryKey( candidates[candidateIndex].entryHash, "lz" );
+	}
+
+	bool8 *contains = Cast( bool8 *, Mem_TempAlloc( candidates.count * sizeof( bool8 ) ) );
+
+	bool8 checkedEntries = backend->Contains( backend, objectKeys, TruncCast( u32, candidates.count ), contains );
+	CompileCache_RecordRemoteResult( remote, checkedEntries );
+
+	if ( !checkedEntries ) {
+		return;
+	}
+
+	// the manifest is newest first, so the first one thats there for each lookup is the one we want
+	const remoteCandidate_t **chosen = Cast( const remoteCandidate_t **, Mem_TempAlloc( numMisses * sizeof( remoteCandidate_t * ) ) );
+	memset( chosen, 0, numMisses * sizeof( remoteCandidate_t * ) );
+
+	For ( u64, candidateIndex, 0, candidates.count ) {
+		const remoteCandidate_t *candidate = &candidates[candidateIndex];
+
+		if ( contains[candidateIndex] && !chosen[candidate->lookupIndex] ) {
+			chosen[candidate->lookupIndex] = candidate;
+		}
+	}
+
+	// the entries themselves, three files each
+	const char **entryKeys = Cast( const char **, Mem_TempAlloc( numMisses * 3 * sizeof( const char * ) ) );
+	const remoteCandidate_t **entryCandidates = Cast( const remoteCandidate_t **, Mem_TempAlloc( numMisses * sizeof( remoteCandidate_t * ) ) );
+	u32 numEntries = 0;
+
+	For ( u32, missIndex, 0, numMisses ) {
+		if ( !chosen[missIndex] ) {
+			continue;
+		}
+
+		u64 entryHash = chosen[missIndex]->entryHash;
+
+		entryKeys[( numEntries * 3 ) + 0] = CompileCache_GetEntryKey( entryHash, "lz" );
+		entryKeys[( numEntries * 3 ) + 1] = CompileCache_GetEntryKey( entryHash, "d" );
+		entryKeys[( numEntries * 3 ) + 2] = CompileCache_GetEntryKey( entryHash, "out" );
+
+		entryCandidates[numEntries++] = chosen[missIndex];
+	}
+
+	if ( numEntries == 0 ) {
+		return;
+	}
+
+	remoteCacheBlob_t *entryBlobs = Cast( remoteCacheBlob_t *, Mem_TempAlloc( numEntries * 3 * sizeof( remoteCacheBlob_t ) ) );
+
+	bool8 gotEntries = backend->Get( backend, entryKeys, numEntries * 3, entryBlobs );
+	CompileCache_RecordRemoteResult( remote, gotEntries );
+
+	if ( !gotEntries ) {
+		return;
+	}
+
+	defer { CompileCache_FreeBlobs( entryBlobs, numEntries * 3 ); };
+
+	For ( u32, entryIndex, 0, numEntries ) {
+		const remoteCandidate_t *candidate = entryCandidates[entryIndex];
+		remoteLookup_t *lookup = misses[candidate->lookupIndex];
+
+		const remoteCacheBlob_t *blobs = &entryBlobs[entryIndex * 3];
+
+		lookup->found = CompileCache_InstallRemoteEntry( cache, lookup->commandHash, candidate, &blobs[0], &blobs[1], &blobs[2] );
+	}
+}
+
+static s32 CompileCache_RemoteLookupThread( void *data ) {
+	compileCache_t *cache = Cast( compileCache_t *, data );
+	compileCacheRemote_t *remote = cache->remote;
+
+	while ( true ) {
+		Semaphore_Wait( &remote->lookupsQueued );
+
+		if ( Thread_AtomicLoad( &remote->stopping ) ) {
+			break;
+		}
+
+		remoteLookup_t *batch[COMPILE_CACHE_REMOTE_BATCH_SIZE];
+		u32 batchCount = 0;
+
+		Mutex_Lock( &remote->mutex );
+
+		while ( batchCount < COMPILE_CACHE_REMOTE_BATCH_SIZE && remote->nextLookup < remote->lookups.count ) {
+			remoteLookup_t *lookup = remote->lookups[remote->nextLookup++];
+
+			// the compile job might have got to it first
+			if ( Thread_AtomicCompareExchange( &lookup->state, REMOTE_LOOKUP_STATE_QUEUED, REMOTE_LOOKUP_STATE_IN_FLIGHT ) == REMOTE_LOOKUP_STATE_QUEUED ) {
+				batch[batchCount++] = lookup;
+			}
+		}
+
+		Mutex_Unlock( &remote->mutex );
+
+		if ( batchCount == 0 ) {
+			continue;
+		}
+
+		if ( !Thread_AtomicLoad( &remote->disabled ) ) {
+			u64 tempStoragePos = Mem_TempTell();
+
+			CompileCache_RunRemoteLookups( cache, batch, batchCount );
+
+			Mem_TempRewindTo( tempStoragePos );
+		}
+
+		For ( u32, lookupIndex, 0, batchCount ) {
+			Thread_AtomicStore( &batch[lookupIndex]->state, REMOTE_LOOKUP_STATE_DONE );
+		}
+	}
+
+	return 0;
+}
+
+static bool8 CompileCache_PutFile( compileCacheRemote_t *remote, const char *key, const char *filename ) {
+	string_t contents = {};
+	if ( !FS_ReadEntireFile( filename, &contents ) ) {
+		return false;
+	}
+
+	defer { FS_FreeFileBuffer( &contents ); };
+
+	bool8 put = remote->uploadBackend.Put( &remote->uploadBackend, key, contents.data, contents.count );
+	CompileCache_RecordRemoteResult( remote, put );
+
+	return put;
+}
+
+static void CompileCache_UploadRemoteEntry( compileCache_t *cache, const remoteUpload_t *upload ) {
+	compileCacheRemote_t *remote = cache->remote;
+	remoteCacheBackend_t *backend = &remote->uploadBackend;
+
+	const char *objectKey = CompileCache_GetEntryKey( upload->entryHash, "lz" );
+
+	// another agent building the same commit has probably beaten us to it
+	bool8 alreadyThere = false;
+	bool8 checked = backend->Contains( backend, &objectKey, 1, &alreadyThere );
+	CompileCache_RecordRemoteResult( remote, checked );
+
+	if ( !checked ) {
+		return;
+	}
+
+	if ( !alreadyThere ) {
+		// same order as CompileCache_Store(), so the object file going last is what makes the entry count
+		const char *outputFile = CompileCache_GetEntryPath( cache, upload->entryHash, "out" );
+		if ( FS_FileExists( outputFile ) && !CompileCache_PutFile( remote, CompileCache_GetEntryKey( upload->entryHash, "out" ), outputFile ) ) {
+			return;
+		}
+
+		if ( !CompileCache_PutFile( remote, CompileCache_GetEntryKey( upload->entryHash, "d" ), CompileCache_GetEntryPath( cache, upload->entryHash, "d" ) ) ) {
+			return;
+		}
+
+		if ( cache->compress ) {
+			if ( !CompileCache_PutFile( remote, objectKey, CompileCache_GetEntryPath( cache, upload->entryHash, "lz" ) ) ) {
+				return;
+			}
+		} else {
+			string_t object = {};
+			if ( !FS_ReadEntireFile( CompileCache_GetEntryPath( cache, upload->entryHash, "o" ), &object ) ) {
+				return;
+			}
+
+			defer { FS_FreeFileBuffer( &object ); };
+
+			u64 compressedSize = 0;
+			u8 *compressed = CompileCache_CompressObject( object.data, object.count, &compressedSize );
+			if ( !compressed ) {
+				return;
+			}
+
+			defer { free( compressed ); };
+
+			bool8 put = backend->Put( backend, objectKey, compressed, compressedSize );
+			CompileCache_RecordRemoteResult( remote, put );
+
+			if ( !put ) {
+				return;
+			}
+		}
+
+		Thread_AtomicIncrement( &cache->numRemoteUploads );
+	}
+
+	// merge our include lists into the remote manifest instead of replacing it, since other agents might have built this on a different branch
+	// same as the local cache, if two agents do this at once then one of the include lists gets lost and that file gets compiled one more time
+	const char *manifestKey = CompileCache_GetEntryKey( upload->commandHash, "manifest" );
+
+	remoteCacheBlob_t remoteManifest = {};
+	bool8 gotManifest = backend->Get( backend, &manifestKey, 1, &remoteManifest );
+	CompileCache_RecordRemoteResult( remote, gotManifest );
+
+	if ( !gotManifest ) {
+		return;
+	}
+
+	defer { RemoteCache_FreeBlob( &remoteManifest ); };
+
+	array_t<manifestEntry_t> remoteEntries;
+	remoteEntries.Init( Mem_GetTempStorage() );
+
+	if ( remoteManifest.found ) {
+		CompileCache_ParseManifest( Cast( char *, remoteManifest.data ), remoteManifest.size, &remoteEntries );
+	}
+
+	string_t localManifestBuffer = {};
+	array_t<manifestEntry_t> localEntries;
+	localEntries.Init( Mem_GetTempStorage() );
+
+	if ( !CompileCache_ReadManifest( CompileCache_GetEntryPath( cache, upload->commandHash, "manifest" ), &localManifestBuffer, &localEntries ) ) {
+		return;
+	}
+
+	defer { FS_FreeFileBuffer( &localManifestBuffer ); };
+
+	const char *manifest = CompileCache_MergeManifests( &localEntries, &remoteEntries );
+
+	bool8 put = backend->Put( backend, manifestKey, manifest, strlen( manifest ) );
+	CompileCache_RecordRemoteResult( remote, put );
+}
+
+static s32 CompileCache_RemoteUploadThread( void *data ) {
+	compileCache_t *cache = Cast( compileCache_t *, data );
+	compileCacheRemote_t *remote = cache->remote;
+
+	// every upload signals the semaphore once, and stopping signals it once more, so we finish every upload before we stop
+	// unless that takes too long, then whatever is left gets dropped
+	while ( true ) {
+		Semaphore_Wait( &remote->uploadsQueued );
+
+		remoteUpload_t upload = {};
+		bool8 gotUpload = false;
+		bool8 pastDeadline = Thread_AtomicLoad( &remote->stopping ) && Time_MS() > remote->drainDeadlineMS;
+
+		Mutex_Lock( &remote->mutex );
+
+		if ( pastDeadline ) {
+			remote->numUploadsDropped = remote->uploads.count - remote->nextUpload;
+			remote->nextUpload = remote->uploads.count;
+		} else if ( remote->nextUpload < remote->uploads.count ) {
+			upload = remote->uploads[remote->nextUpload++];
+			gotUpload = true;
+		}
+
+		Mutex_Unlock( &remote->mutex );
+
+		if ( pastDeadline ) {
+			break;
+		}
+
+		if ( !gotUpload ) {
+			if ( Thread_AtomicLoad( &remote->stopping ) ) {
+				break;
+			}
+
+			continue;
+		}
+
+		if ( Thread_AtomicLoad( &remote->disabled ) ) {
+			continue;
+		}
+
+		u64 tempStoragePos = Mem_TempTell();
+
+		CompileCache_UploadRemoteEntry( cache, &upload );
+
+		Mem_TempRewindTo( tempStoragePos );
+	}
+
+	return 0;
+}
+
+// returns true if the entry for this command came from the remote cache
+// a lookup that hasnt started yet gets cancelled, since compiling the file is what we would have done without a remote cache anyway
+// one thats already waiting on the remote cache gets a little while to finish, since its usually most of the way there
+static bool8 CompileCache_FinishRemoteLookup( compileCache_t *cache, const u64 commandHash ) {
+	compileCacheRemote_t *remote = cache->remote;
+
+	remoteLookup_t *lookup = NULL;
+
+	Mutex_Lock( &remote->mutex );
+
+	u32 lookupIndex = HM_GetValue( remote->lookupIndices, commandHash );
+	if ( lookupIndex != HASHMAP_INVALID_VALUE ) {
+		lookup = remote->lookups[lookupIndex];
+	}
+
+	Mutex_Unlock( &remote->mutex );
+
+	if ( !lookup ) {
+		return false;
+	}
+
+	u32 state = Thread_AtomicCompareExchange( &lookup->state, REMOTE_LOOKUP_STATE_QUEUED, REMOTE_LOOKUP_STATE_CANCELLED );
+
+	for ( u32 waitedMS = 0; state == REMOTE_LOOKUP_STATE_IN_FLIGHT && waitedMS < COMPILE_CACHE_REMOTE_MAX_WAIT_MS; waitedMS++ ) {
+		Thread_Sleep( 1 );
+		state = Thread_AtomicLoad( &lookup->state );
+	}
+
+	return state == REMOTE_LOOKUP_STATE_DONE && lookup->found;
+}
+
+static void CompileCache_QueueRemoteUpload( compileCache_t *cache, const u64 commandHash, const u64 entryHash ) {
+	compileCacheRemote_t *remote = cache->remote;
+
+	if ( Thread_AtomicLoad( &remote->disabled ) ) {
+		return;
+	}
+
+	Mutex_Lock( &remote->mutex );
+	remote->uploads.Add( { commandHash, entryHash } );
+	Mutex_Unlock( &remote->mutex );
+
+	Semaphore_Signal( &remote->uploadsQueued );
+}
+
+bool8 CompileCache_ConnectRemote( compileCache_t *cache, const char *location ) {
+	Assert( cache );
+	Assert( cache->rootFolder );
+	Assert( !cache->remote );
+	Assert( location );
+
+	compileCacheRemote_t *remote = Cast( compileCacheRemote_t *, calloc( 1, sizeof( compileCacheRemote_t ) ) );
+
+	if ( !RemoteCache_CreateBackend( location, &remote->lookupBackend ) ) {
+		free( remote );
+		return false;
+	}
+
+	RemoteCache_CreateBackend( location, &remote->uploadBackend );
+
+	remote->allocator = Mem_CreateAllocator( COMPILE_CACHE_REMOTE_MEMORY_RESERVE );
+	remote->mutex = Mutex_Create();
+
+	remote->lookupIndices = HM_Create( remote->allocator, 1024 );
+	remote->lookups.Init( remote->allocator );
+	remote->uploads.Init( remote->allocator );
+
+	remote->lookupsQueued = Semaphore_Create( 0 );
+	remote->uploadsQueued = Semaphore_Create( 0 );
+
+	cache->remote = remote;
+
+	remote->lookupThread = Thread_Create( CompileCache_RemoteLookupThread, cache );
+	remote->uploadThread = Thread_Create( CompileCache_RemoteUploadThread, cache );
+
+	return true;
+}
+
+void CompileCache_DisconnectRemote( compileCache_t *cache ) {
+	Assert( cache );
+
+	compileCacheRemote_t *remote = cache->remote;
+
+	if ( !remote ) {
+		return;
+	}
+
+	remote->drainDeadlineMS = Time_MS() + COMPILE_CACHE_REMOTE_MAX_DRAIN_MS;
+
+	Thread_AtomicStore( &remote->stopping, 1 );
+
+	Semaphore_Signal( &remote->lookupsQueued );
+	Semaphore_Signal( &remote->uploadsQueued );
+
+	Thread_Wait( &remote->lookupThread );
+	Thread_Wait( &remote->uploadThread );
+
+	if ( remote->numUploadsDropped > 0 ) {
+		Warning( "Remote cache %s took too long, so %" PRIu64 " compiled files didn't get uploaded to it.\n", remote->uploadBackend.description, remote->numUploadsDropped );
+	}
+
+	Thread_Destroy( &remote->lookupThread );
+	Thread_Destroy( &remote->uploadThread );
+
+	remote->lookupBackend.Shutdown( &remote->lookupBackend );
+	remote->uploadBackend.Shutdown( &remote->uploadBackend );
+
+	Semaphore_Destroy( &remote->lookupsQueued );
+	Semaphore_Destroy( &remote->uploadsQueued );
+
+	Mutex_Destroy( &remote->mutex );
+
+	Mem_DestroyAllocator( remote->allocator );
+
+	free( remote );
+
+	cache->remote = NULL;
+}
+
+void CompileCache_Prefetch( compileCache_t *cache, const u64 commandHash, const char *sourceFile ) {
+	Assert( cache );
+	Assert( sourceFile );
+
+	compileCacheRemote_t *remote = cache->remote;
+
+	if ( !remote || Thread_AtomicLoad( &remote->disabled ) ) {
+		return;
+	}
+
+	Mutex_Lock( &remote->mutex );
+
+	if ( HM_GetValue( remote->lookupIndices, commandHash ) != HASHMAP_INVALID_VALUE ) {
+		Mutex_Unlock( &remote->mutex );
+		return;
+	}
+
+	u64 sourceFileLength = strlen( sourceFile );
+
+	char *sourceFileCopy = Cast( char *, Mem_Alloc( remote->allocator, sourceFileLength + 1 ) );
+	memcpy( sourceFileCopy, sourceFile, sourceFileLength + 1 );
+
+	remoteLookup_t *lookup = Cast( remoteLookup_t *, Mem_Alloc( remote->allocator, sizeof( remoteLookup_t ) ) );
+	*lookup = {
+		.commandHash	= commandHash,
+		.sourceFile		= sourceFileCopy,
+		.state			= { REMOTE_LOOKUP_STATE_QUEUED },
+		.found			= false,
+	};
+
+	HM_SetValue( remote->lookupIndices, commandHash, TruncCast( u32, remote->lookups.count ) );
+	remote->lookups.Add( lookup );
+
+	Mutex_Unlock( &remote->mutex );
+
+	Semaphore_Signal( &remote->lookupsQueued );
+}
+
+bool8 CompileCache_Init( compileCache_t *cache, const char *folder, const char *rootFolder, const bool8 compress, fileStatMemo_t *fileStatMemo ) {
+	Assert( cache );
+	Assert( folder );
+	Assert( fileStatMemo );
+
+	*cache = {
+		.folder			= folder,
+		.rootFolder		= rootFolder,
+		.compress		= compress,
+		.fileStatMemo	= fileStatMemo,
+	};
+
+	return FS_CreateFolderIfItDoesntExist( folder );
+}
+
+u64 CompileCache_HashCommand( compileCache_t *cache, const array_t<const char *> *args ) {
+	Assert( cache );
+	Assert( args );
+	Assert( args->count >= 1 );
+
+	const char *compilerPath = ( *args )[0];
+
+	u64 hash = HashString( compilerPath, 0 );
+
+	// if the compiler gets upgraded in-place then nothing it built before is any good any more
+	// this can fail if the compiler path is just a name that gets resolved via PATH (e.g. "gcc"), in which case the path is all we've got
+	fileStat_t compilerStat = {};
+	if ( FileStatMemo_GetFileStat( cache->fileStatMemo, compilerPath, &compilerStat ) ) {
+		hash = Hash64( &compilerStat.sizeBytes, sizeof( u64 ), hash );
+		hash = Hash64( &compilerStat.lastWriteTime, sizeof( u64 ), hash );
+	}
+
+	// unlike the command hash in the include dependency database, "-v" counts here
+	// it doesnt change the object file, but it does change what the compiler prints, which is part of the entry too
+	For ( u64, argIndex, 1, args->count ) {
+		const char *arg = ( *args )[argIndex];
+
+		string_t remappedArg = CompileCache_RemoveRoot( cache, arg, strlen( arg ) );
+
+		hash = HashString( &remappedArg, hash );
+	}
+
+	return hash;
+}
+
+bool8 CompileCache_Restore( compileCache_t *cache, const u64 commandHash, const char *sourceFile, const char *objectFile, const char *depFile, string_t *outCompilerOutput ) {
+	Assert( cache );
+	Assert( sourceFile );
+	Assert( objectFile );
+	Assert( depFile );
+	Assert( outCompilerOutput );
+
+	*outCompilerOutput = {};
+
+	bool8 fromRemote = cache->remote && CompileCache_FinishRemoteLookup( cache, commandHash );
+
+	u64 entryHash = CompileCache_FindEntry( cache, commandHash, sourceFile, cache->compress ? "lz" : "o" );
+
+	// a single loop so that anything going wrong can break out and count as a miss
+	while ( entryHash != 0 ) {
+		const char *entryObjectFile = CompileCache_GetEntryPath( cache, entryHash, cache->compress ? "lz" : "o" );
+
+		string_t depFileContents = {};
+		if ( !CompileCache_RestoreTextFile( cache, CompileCache_GetEntryPath( cache, entryHash, "d" ), &depFileContents ) ) {
+			break;
+		}
+
+		if ( !FS_WriteEntireFile( depFile, depFileContents.data, depFileContents.count ) ) {
+			break;
+		}
+
+		if ( cache->compress ) {
+			if ( !CompileCache_RestoreCompressedObject( entryObjectFile, objectFile ) ) {
+				break;
+			}
+		} else {
+			if ( !CompileCache_PlaceFile( entryObjectFile, objectFile ) ) {
+				break;
+			}
+
+			// otherwise the object file keeps the time it was first built and we wouldnt know to relink
+			FS_TouchFile( objectFile );
+		}
+
+		// so CompileCache_Trim() knows this entry (and the manifest that found it) are still being used
+		FS_TouchFile( entryObjectFile );
+		FS_TouchFile( CompileCache_GetEntryPath( cache, commandHash, "manifest" ) );
+
+		CompileCache_RestoreTextFile( cache, CompileCache_GetEntryPath( cache, entryHash, "out" ), outCompilerOutput );
+
+		Thread_AtomicIncrement( &cache->numHits );
+
+		if ( fromRemote ) {
+			Thread_AtomicIncrement( &cache->numRemoteHits );
+		}
+
+		return true;
+	}
+
+	Thread_AtomicIncrement( &cache->numMisses );
+
+	return false;
+}
+
+bool8 CompileCache_Store( compileCache_t *cache, const u64 commandHash, const char *sourceFile, const char * const *includeDependencies, const u64 numIncludeDependencies, const char *objectFile, const char *depFile, const string_t *compilerOutput ) {
+	Assert( cache );
+	Assert( sourceFile );
+	Assert( includeDependencies || numIncludeDependencies == 0 );
+	Assert( objectFile );
+	Assert( depFile );
+
+	// everything that goes in the cache has the root folder swapped out
+	const char **remappedDependencies = Cast( const char **, Mem_TempAlloc( ( numIncludeDependencies + 1 ) * sizeof( const char * ) ) );
+	For ( u64, dependencyIndex, 0, numIncludeDependencies ) {
+		const char *dependency = includeDependencies[dependencyIndex];
+		remappedDependencies[dependencyIndex] = CompileCache_RemoveRoot( cache, dependency, strlen( dependency ) ).data;
+	}
+
+	u64 inputsHash = CompileCache_GetInputsHash( cache, sourceFile, remappedDependencies, numIncludeDependencies );
+	if ( inputsHash == 0 ) {
+		return false;
+	}
+
+	u64 entryHash = Hash64( &inputsHash, sizeof( u64 ), commandHash );
+
+	if ( !FS_CreateFolderIfItDoesntExist( TempPrintf( "%s/%02" PRIx64, cache->folder, entryHash >> 56 ) ) ) {
+		return false;
+	}
+
+	if ( !FS_CreateFolderIfItDoesntExist( TempPrintf( "%s/%02" PRIx64, cache->folder, commandHash >> 56 ) ) ) {
+		return false;
+	}
+
+	if ( compilerOutput && compilerOutput->count > 0 ) {
+		if ( !CompileCache_StoreTextFile( cache, CompileCache_GetEntryPath( cache, entryHash, "out" ), compilerOutput->data, compilerOutput->count ) ) {
+			return false;
+		}
+	}
+
+	{
+		string_t depFileContents = {};
+		if ( !FS_ReadEntireFile( depFile, &depFileContents ) ) {
+			return false;
+		}
+
+		defer { FS_FreeFileBuffer( &depFileContents ); };
+
+		if ( !CompileCache_StoreTextFile( cache, CompileCache_GetEntryPath( cache, entryHash, "d" ), depFileContents.data, depFileContents.count ) ) {
+			return false;
+		}
+	}
+
+	// object file goes last, its what makes the entry count
+	if ( cache->compress ) {
+		if ( !CompileCache_StoreCompressedObject( objectFile, CompileCache_GetEntryPath( cache, entryHash, "lz" ) ) ) {
+			return false;
+		}
+	} else {
+		const char *entryObjectFile = CompileCache_GetEntryPath( cache, entryHash, "o" );
+		const char *tempFilename = CompileCache_GetTempFilename( entryObjectFile );
+
+		if ( !CompileCache_PlaceFile( objectFile, tempFilename ) ) {
+			return false;
+		}
+
+		if ( !FS_RenameFile( tempFilename, entryObjectFile ) ) {
+			FS_DeleteFile( tempFilename );
+			return false;
+		}
+
+		// renaming a hard link over another link to the same file does nothing, which happens when the object file came out of this entry in the first place
+		if ( FS_FileExists( tempFilename ) ) {
+			FS_DeleteFile( tempFilename );
+		}
+	}
+
+	// put this include list at the front of the manifest so the next lookup tries it first
+	if ( !CompileCache_AddToManifest( cache, commandHash, remappedDependencies, numIncludeDependencies ) ) {
+		return false;
+	}
+
+	Thread_AtomicIncrement( &cache->numStores );
+
+	if ( cache->remote ) {
+		CompileCache_QueueRemoteUpload( cache, commandHash, entryHash );
+	}
+
+	return true;
+}
+
+/*
+================================================================================================
+
+	Config cache
+
+	Works the same way as the cache for single source files, except the entry is the binary a
+	whole config built and the config key takes the place of the command hash.  The config
+	key already covers the config itself and the contents of its source files, so the manifest
+	only needs to list the headers that those source files included.
+
+	The binary never gets hard linked in or out of the cache.  Linkers (and ar especially)
+	are allowed to update an existing binary in place, which would change the entry too.
+
+================================================================================================
+*/
+
+static int CompareStrings( const void *lhs, const void *rhs ) {
+	return strcmp( *Cast( const char * const *, lhs ), *Cast( const char * const *, rhs ) );
+}
+
+static const char *CompileCache_GetConfigEntryExtension( const compileCache_t *cache ) {
+	return cache->compress ? "lz" : "bin";
+}
+
+// like CompileCache_PlaceFile(), except 'newFilename' never ends up sharing its data with 'filename'
+static bool8 CompileCache_CopyFile( const char *filename, const char *newFilename ) {
+	if ( FS_FileExists( newFilename ) && !FS_DeleteFile( newFilename ) ) {
+		return false;
+	}
+
+	// a clone only shares data until one of them gets written to, so thats fine
+	if ( FS_CloneFile( filename, newFilename ) ) {
+		return true;
+	}
+
+	return FS_CopyFile( filename, newFilename );
+}
+
+const char *CompileCache_RemoveRootFolder( const compileCache_t *cache, const char *str ) {
+	Assert( cache );
+	Assert( str );
+
+	return CompileCache_RemoveRoot( cache, str, strlen( str ) ).data;
+}
+
+u64 CompileCache_FindConfig( compileCache_t *cache, const u64 configKey ) {
+	Assert( cache );
+	Assert( configKey != 0 );
+
+	return CompileCache_FindEntry( cache, configKey, NULL, CompileCache_GetConfigEntryExtension( cache ) );
+}
+
+bool8 CompileCache_RestoreConfig( compileCache_t *cache, const u64 configKey, const u64 entryHash, const char *binaryFile ) {
+	Assert( cache );
+	Assert( configKey != 0 );
+	Assert( entryHash != 0 );
+	Assert( binaryFile );
+
+	const char *entryBinaryFile = CompileCache_GetEntryPath( cache, entryHash, CompileCache_GetConfigEntryExtension( cache ) );
+
+	if ( cache->compress ) {
+		if ( !CompileCache_RestoreCompressedObject( entryBinaryFile, binaryFile ) ) {
+			return false;
+		}
+	} else {
+		if ( !CompileCache_CopyFile( entryBinaryFile, binaryFile ) ) {
+			return false;
+		}
+	}
+
+	// so anything that links against this binary knows it changed
+	FS_TouchFile( binaryFile );
+
+	FS_TouchFile( entryBinaryFile );
+	FS_TouchFile( CompileCache_GetEntryPath( cache, configKey, "manifest" ) );
+
+	Thread_AtomicIncrement( &cache->numConfigHits );
+
+	return true;
+}
+
+u64 CompileCache_StoreConfig( compileCache_t *cache, const u64 configKey, const char * const *includeDependencies, const u64 numIncludeDependencies, const char *binaryFile ) {
+	Assert( cache );
+	Assert( configKey != 0 );
+	Assert( includeDependencies || numIncludeDependencies == 0 );
+	Assert( binaryFile );
+
+	const char **remappedDependencies = Cast( const char **, Mem_TempAlloc( ( numIncludeDependencies + 1 ) * sizeof( const char * ) ) );
+	For ( u64, dependencyIndex, 0, numIncludeDependencies ) {
+		remappedDependencies[dependencyIndex] = CompileCache_RemoveRootFolder( cache, includeDependencies[dependencyIndex] );
+	}
+
+	// the same headers have to hash the same no matter which order the source files found them in
+	qsort( remappedDependencies, numIncludeDependencies, sizeof( const char * ), CompareStrings );
+
+	u64 numUniqueDependencies = 0;
+	For ( u64, dependencyIndex, 0, numIncludeDependencies ) {
+		if ( numUniqueDependencies == 0 || !String_Equals( remappedDependencies[numUniqueDependencies - 1], remappedDependencies[dependencyIndex] ) ) {
+			remappedDependencies[numUniqueDependencies++] = remappedDependencies[dependencyIndex];
+		}
+	}
+
+	u64 inputsHash = CompileCache_GetInputsHash( cache, NULL, remappedDependencies, numUniqueDependencies );
+	if ( inputsHash == 0 ) {
+		return 0;
+	}
+
+	u64 entryHash = Hash64( &inputsHash, sizeof( u64 ), configKey );
+
+	if ( !FS_CreateFolderIfItDoesntExist( TempPrintf( "%s/%02" PRIx64, cache->folder, entryHash >> 56 ) ) ) {
+		return 0;
+	}
+
+	if ( !FS_CreateFolderIfItDoesntExist( TempPrintf( "%s/%02" PRIx64, cache->folder, configKey >> 56 ) ) ) {
+		return 0;
+	}
+
+	const char *entryBinaryFile = CompileCache_GetEntryPath( cache, entryHash, CompileCache_GetConfigEntryExtension( cache ) );
+
+	// another Builder (or another checkout) could have stored the exact same thing already
+	if ( !FS_FileExists( entryBinaryFile ) ) {
+		if ( cache->compress ) {
+			if ( !CompileCache_StoreCompressedObject( binaryFile, entryBinaryFile ) ) {
+				return 0;
+			}
+		} else {
+			const char *tempFilename = CompileCache_GetTempFilename( entryBinaryFile );
+
+			if ( !CompileCache_CopyFile( binaryFile, tempFilename ) ) {
+				return 0;
+			}
+
+			if ( !FS_RenameFile( tempFilename, entryBinaryFile ) ) {
+				FS_DeleteFile( tempFilename );
+				return 0;
+			}
+		}
+	}
+
+	if ( !CompileCache_AddToManifest( cache, configKey, remappedDependencies, numUniqueDependencies ) ) {
+		return 0;
+	}
+
+	Thread_AtomicIncrement( &cache->numConfigStores );
+
+	return entryHash;
+}
+
+/*
+================================================================================================
+
+	Trimming
+
+	Every file in the cache belongs to the entry (or manifest) that has the same name minus the
+	extension.  An entry was last used whenever the newest of its files was last written to,
+	since hits touch the object file.  Entries get deleted oldest first, all of their files at
+	once, until the cache is small enough.
+
+================================================================================================
+*/
+
+struct cacheFile_t {
+	const char	*fullFilename;
+	u64			stemLength;	// everything up to the first '.' in the filename, which is the same for every file in an entry
+	u64			sizeBytes;
+	u64			lastWriteTime;
+};
+
+struct cacheEntry_t {
+	u32			firstFileIndex;
+	u32			numFiles;
+	u64			sizeBytes;
+	u64			lastUsedTime;
+};
+
+struct trimContext_t {
+	array_t<cacheFile_t>	files;
+	u64						totalSizeBytes;
+};
+
+static void CompileCache_Trim_VisitFile( const fileInfo_t *fileInfo, void *userData ) {
+	trimContext_t *context = Cast( trimContext_t *, userData );
+
+	const char *firstDot = strchr( fileInfo->filename, '.' );
+	u64 filenameOffset = Cast( u64, fileInfo->filename - fileInfo->fullFilename );
+
+	// the visitor reuses 'filename' for each file, but 'fullFilename' is ours to keep
+	cacheFile_t file = {
+		.fullFilename	= fileInfo->fullFilename,
+		.stemLength		= firstDot ? ( Cast( u64, firstDot - fileInfo->filename ) + filenameOffset ) : strlen( fileInfo->fullFilename ),
+		.sizeBytes		= fileInfo->sizeBytes,
+		.lastWriteTime	= fileInfo->lastWriteTime,
+	};
+
+	context->files.Add( file );
+	context->totalSizeBytes += fileInfo->sizeBytes;
+}
+
+static int CompareCacheFilesByStem( const void *lhs, const void *rhs ) {
+	const cacheFile_t *a = Cast( const cacheFile_t *, lhs );
+	const cacheFile_t *b = Cast( const cacheFile_t *, rhs );
+
+	u64 minLength = ( a->stemLength < b->stemLength ) ? a->stemLength : b->stemLength;
+
+	int result = strncmp( a->fullFilename, b->fullFilename, minLength );
+	if ( result != 0 ) {
+		return result;
+	}
+
+	return ( a->stemLength < b->stemLength ) ? -1 : ( a->stemLength > b->stemLength ) ? 1 : 0;
+}
+
+static int CompareCacheEntriesByLastUsed( const void *lhs, const void *rhs ) {
+	const cacheEntry_t *a = Cast( const cacheEntry_t *, lhs );
+	const cacheEntry_t *b = Cast( const cacheEntry_t *, rhs );
+
+	return ( a->lastUsedTime < b->lastUsedTime ) ? -1 : ( a->lastUsedTime > b->lastUsedTime ) ? 1 : 0;
+}
+
+bool8 CompileCache_Trim( const char *folder, const u64 maxSizeBytes, compileCacheTrimResult_t *outResult ) {
+	Assert( folder );
+	Assert( outResult );
+
+	*outResult = {};
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	trimContext_t context = {};
+	context.files.Init( Mem_GetTempStorage() );
+
+	// the visitor wants a trailing slash on the folder
+	const char *folderWithSlash = String_EndsWith( folder, '/' ) ? folder : TempPrintf( "%s/", folder );
+
+	if ( !FS_GetAllFilesInFolder( folderWithSlash, FILE_VISIT_FILES | FILE_VISIT_RECURSIVE, CompileCache_Trim_VisitFile, &context ) ) {
+		return false;
+	}
+
+	outResult->sizeBytesBefore = context.totalSizeBytes;
+	outResult->sizeBytesAfter = context.totalSizeBytes;
+
+	if ( context.totalSizeBytes <= maxSizeBytes ) {
+		return true;
+	}
+
+	// group the files into entries
+	qsort( context.files.data, context.files.count, sizeof( cacheFile_t ), CompareCacheFilesByStem );
+
+	array_t<cacheEntry_t> entries;
+	entries.Init( Mem_GetTempStorage() );
+
+	For ( u32, fileIndex, 0, TruncCast( u32, context.files.count ) ) {
+		const cacheFile_t *file = &context.files[fileIndex];
+
+		if ( entries.count == 0 || CompareCacheFilesByStem( &context.files[entries[entries.count - 1].firstFileIndex], file ) != 0 ) {
+			cacheEntry_t entry = {
+				.firstFileIndex	= fileIndex,
+				.numFiles		= 0,
+				.sizeBytes		= 0,
+				.lastUsedTime	= 0,
+			};
+
+			entries.Add( entry );
+		}
+
+		cacheEntry_t *entry = &entries[entries.count - 1];
+		entry->numFiles++;
+		entry->sizeBytes += file->sizeBytes;
+		entry->lastUsedTime = ( file->lastWriteTime > entry->lastUsedTime ) ? file->lastWriteTime : entry->lastUsedTime;
+	}
+
+	qsort( entries.data, entries.count, sizeof( cacheEntry_t ), CompareCacheEntriesByLastUsed );
+
+	u64 targetSizeBytes = ( maxSizeBytes / 100 ) * COMPILE_CACHE_TRIM_TARGET_PERCENT;
+
+	For ( u64, entryIndex, 0, entries.count ) {
+		if ( outResult->sizeBytesAfter <= targetSizeBytes ) {
+			break;
+		}
+
+		const cacheEntry_t *entry = &entries[entryIndex];
+
+		For ( u32, fileIndex, entry->firstFileIndex, entry->firstFileIndex + entry->numFiles ) {
+			const cacheFile_t *file = &context.files[fileIndex];
+
+			// someone else might have trimmed it first
+			if ( !FS_FileExists( file->fullFilename ) || !FS_DeleteFile( file->fullFilename ) ) {
+				continue;
+			}
+
+			outResult->sizeBytesAfter -= file->sizeBytes;
+			outResult->numFilesDeleted++;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,193 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "array.h"
+#include "thread.h"
+
+struct string_t;
+struct fileStatMemo_t;
+struct compileCacheRemote_t;
+
+/*
+================================================================================================
+
+	Compile cache
+
+	Remembers the outputs of every compile we've done so that compiling the exact same thing
+	again (e.g. after switching branches, or switching back to a config we built earlier) just
+	puts the old outputs back instead of running the compiler.
+
+	Each compile is keyed by two hashes:
+
+	- The command hash: the compiler's command line (which has the source file and output
+	  paths in it) and the identity of the compiler binary itself.
+	- The inputs hash: the contents of the source file and every file it included.
+
+	We can't know which files a source file includes until we compile it, so for every
+	command hash we keep a small manifest of the include lists it had the last few times it
+	got compiled.  A lookup hashes the current contents of each of those lists in turn until
+	one of them matches an entry.
+
+	Layout of the cache folder:
+
+		<2 hex digits>/<command hash>.manifest	include lists, newest first
+		<2 hex digits>/<entry hash>.o			the object file
+		<2 hex digits>/<entry hash>.lz			the object file, compressed (see compression.h)
+		<2 hex digits>/<entry hash>.d			the dependency file
+		<2 hex digits>/<entry hash>.out			whatever the compiler printed, if anything
+
+	Every file gets written under a temporary name and then renamed into place, and the object
+	file always goes last, so a half-written entry never looks like a hit.  That also means
+	more than one Builder can share a cache folder at once.
+
+	A cache can be shared between several checkouts of the same project by giving it a root
+	folder.  Everywhere the root folder shows up (in the command line, the include lists, the
+	dependency files, and the compiler output) it gets swapped for a placeholder on the way in
+	and swapped back for the current root folder on the way out, so the same code compiles to
+	the same entries no matter where it's checked out.  The compiler needs to leave the root
+	folder out of the object files too, which is what -ffile-prefix-map is for.
+
+	Every hit touches the entry so that CompileCache_Trim() can tell which entries were used
+	least recently.
+
+	A cache with a root folder can also be backed by a remote cache (see remote_cache.h), so
+	that entries get shared between machines, E.G. every agent in a CI farm.  Lookups in the
+	remote cache happen in the background ahead of the compiles that need them (see
+	CompileCache_Prefetch()), and a compile never waits more than a moment for one, and every
+	store gets uploaded in the background too.  Object files always get compressed in the
+	remote cache.
+
+	The cache also holds whole configs: the binary a config built, keyed by everything that
+	went into it (see CompileCache_FindConfig()).  A config whose binary is in the cache doesn't
+	need any of its source files compiled, or even looked at.  Config entries don't go to the
+	remote cache.
+
+	Lookups and stores are thread-safe.
+
+================================================================================================
+*/
+
+struct compileCache_t {
+	const char				*folder;
+
+	// NULL if the cache isn't shared between checkouts
+	const char				*rootFolder;
+
+	// a shared cache can be a lot bigger, and can be on another drive where hard links don't work anyway
+	bool8					compress;
+
+	// used to hash the inputs, so that every header only gets hashed once per build no matter how many lookups need it
+	fileStatMemo_t			*fileStatMemo;
+
+	// NULL unless CompileCache_ConnectRemote() was called
+	compileCacheRemote_t	*remote;
+
+	atomic32_t				numHits;
+	atomic32_t				numMisses;
+	atomic32_t				numStores;
+
+	atomic32_t				numRemoteHits;		// hits that were only hits because the entry came from the remote cache
+	atomic32_t				numRemoteUploads;
+
+	atomic32_t				numConfigHits;
+	atomic32_t				numConfigStores;
+};
+
+struct compileCacheTrimResult_t {
+	u64			sizeBytesBefore;
+	u64			sizeBytesAfter;
+	u32			numFilesDeleted;
+};
+
+// Creates 'folder' if it doesn't exist yet.
+// 'rootFolder' must be an absolute path, or NULL if the cache doesn't need to be shared between checkouts.
+// If 'compress' is true then object files get compressed instead of hard linked in and out of the cache.
+// Returns false if the folder couldn't be created, in which case the cache must not be used.
+bool8		CompileCache_Init( compileCache_t *cache, const char *folder, const char *rootFolder, const bool8 compress, fileStatMemo_t *fileStatMemo );
+
+// Returns the hash of the compiler command line 'args' (where args[0] is the compiler) plus the identity of the compiler binary.
+// Thread-safe.
+u64			CompileCache_HashCommand( compileCache_t *cache, const array_t<const char *> *args );
+
+// If there's an entry for compiling 'sourceFile' with 'commandHash' that has the same inputs as right now then puts the object and dependency files it made back at 'objectFile' and 'depFile' and returns true.
+// 'outCompilerOutput' gets set to whatever the compiler printed when it made the entry, allocated from temp storage.
+// Otherwise returns false.
+// Thread-safe.
+bool8		CompileCache_Restore( compileCache_t *cache, const u64 commandHash, const char *sourceFile, const char *objectFile, const char *depFile, string_t *outCompilerOutput );
+
+// Adds an entry for a compile that just succeeded.
+// 'includeDependencies' must be every file that 'sourceFile' included (i.e. what was in 'depFile').
+// Returns true if the entry was added.
+// Thread-safe.
+bool8		CompileCache_Store( compileCache_t *cache, const u64 commandHash, const char *sourceFile, const char * const *includeDependencies, const u64 numIncludeDependencies, const char *objectFile, const char *depFile, const string_t *compilerOutput );
+
+// Deletes the entries in the cache at 'folder' that were used least recently until the cache is comfortably smaller than 'maxSizeBytes'.
+// Doesn't do anything if the cache is already smaller than that.
+// Safe to run while other Builders are using the same cache, the worst that can happen is they miss an entry that was just deleted.
+// Returns false if the cache folder couldn't be looked through.
+bool8		CompileCache_Trim( const char *folder, const u64 maxSizeBytes, compileCacheTrimResult_t *outResult );
+
+// Backs the cache with the remote cache at 'location' (see RemoteCache_CreateBackend()).
+// The cache must have a root folder, otherwise nothing would ever match between machines.
+// Returns false (and says why) if 'location' isn't something we can use.
+bool8		CompileCache_ConnectRemote( compileCache_t *cache, const char *location );
+
+// Finishes uploading everything that got stored, then stops using the remote cache.
+// Only waits a few seconds for uploads that are still queued though, anything left after that doesn't get uploaded.
+void		CompileCache_DisconnectRemote( compileCache_t *cache );
+
+// Starts looking for the entry for compiling 'sourceFile' with 'commandHash' in the remote cache, so that it's hopefully in the local cache by the time CompileCache_Restore() wants it.
+// Call this in the order the files will get compiled.
+// Does nothing if there's no remote cache.
+// Thread-safe.
+void		CompileCache_Prefetch( compileCache_t *cache, const u64 commandHash, const char *sourceFile );
+
+// Returns 'str' with the root folder swapped for a placeholder, allocated from temp storage, so that it's the same in every checkout.
+// Returns 'str' if the cache doesn't have a root folder.
+// Thread-safe.
+const char	*CompileCache_RemoveRootFolder( const compileCache_t *cache, const char *str );
+
+// Looks for a binary that was built for a config with 'configKey' and whose include dependencies haven't changed since.
+// 'configKey' must cover everything else about the config: the config itself, the compiler, the contents of its source files, and the binaries it links against.
+// Returns the hash of the entry, or 0 if there isn't one.
+// Thread-safe.
+u64			CompileCache_FindConfig( compileCache_t *cache, const u64 configKey );
+
+// Puts the binary from the entry that CompileCache_FindConfig() found back at 'binaryFile'.
+// Returns false if it couldn't, in which case the config needs building the normal way.
+// Thread-safe.
+bool8		CompileCache_RestoreConfig( compileCache_t *cache, const u64 configKey, const u64 entryHash, const char *binaryFile );
+
+// Adds an entry for the binary that a config with 'configKey' just built.
+// 'includeDependencies' must be every file that any of the config's source files included, in any order, and duplicates are fine.
+// Returns the hash of the entry, or 0 if it couldn't be added.
+// Thread-safe.
+u64			CompileCache_StoreConfig( compileCache_t *cache, const u64 configKey, const char * const *includeDependencies, const u64 numIncludeDependencies, const char *binaryFile );
@@ -0,0 +1,261 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "compression.h"
+
+#include "typecast.h"
+#include "debug.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+================================================================================================
+
+	Compression
+
+================================================================================================
+*/
+
+/*
+	Each sequence looks like this:
+
+	- A token byte.  The top 4 bits are how many bytes get copied straight from the input, the
+	  bottom 4 bits are how long the match is minus COMPRESSION_MIN_MATCH_LENGTH.
+	- If either of those is 15 then more bytes follow to add to it, each one up to 255, until
+	  one of them isn't 255.  The extra literal length bytes come straight after the token.
+	- The literal bytes.
+	- The offset of the match (how far back in the output it starts) as 2 bytes, little endian.
+	- The extra match length bytes.
+
+	The last sequence is only literals, so it stops after the literal bytes.
+*/
+
+#define COMPRESSION_MIN_MATCH_LENGTH	4
+#define COMPRESSION_MAX_OFFSET			65535
+
+// leave a few bytes at the end that never start a match so the 4 byte reads cant go past the end of the input
+#define COMPRESSION_LAST_LITERALS		5
+
+#define COMPRESSION_HASH_BITS			14
+
+static u32 Compression_Read32( const u8 *ptr ) {
+	u32 value;
+	memcpy( &value, ptr, sizeof( u32 ) );
+	return value;
+}
+
+static u32 Compression_HashSequence( const u32 sequence ) {
+	// Knuth's multiplicative hash, the top bits are the best mixed
+	return ( sequence * 2654435761U ) >> ( 32 - COMPRESSION_HASH_BITS );
+}
+
+static u8 *Compression_WriteLength( u8 *out, u64 length ) {
+	while ( length >= 255 ) {
+		*out++ = 255;
+		length -= 255;
+	}
+
+	*out++ = Cast( u8, length );
+
+	return out;
+}
+
+static u8 *Compression_WriteSequence( u8 *out, const u8 *literals, const u64 numLiterals, const u64 offset, const u64 matchLength ) {
+	u8 *token = out++;
+
+	u64 matchLengthCode = matchLength - COMPRESSION_MIN_MATCH_LENGTH;
+
+	*token = Cast( u8, ( ( numLiterals >= 15 ? 15 : numLiterals ) << 4 ) | ( matchLengthCode >= 15 ? 15 : matchLengthCode ) );
+
+	if ( numLiterals >= 15 ) {
+		out = Compression_WriteLength( out, numLiterals - 15 );
+	}
+
+	memcpy( out, literals, numLiterals );
+	out += numLiterals;
+
+	out[0] = Cast( u8, offset & 0xFF );
+	out[1] = Cast( u8, offset >> 8 );
+	out += 2;
+
+	if ( matchLengthCode >= 15 ) {
+		out = Compression_WriteLength( out, matchLengthCode - 15 );
+	}
+
+	return out;
+}
+
+u64 Compression_GetMaxCompressedSize( const u64 sizeBytes ) {
+	// worst case is no matches at all, which is every byte as a literal plus the literal length bytes
+	return sizeBytes + ( sizeBytes / 255 ) + 16;
+}
+
+u64 Compression_Compress( const void *data, const u64 sizeBytes, void *outCompressed ) {
+	Assert( data || sizeBytes == 0 );
+	Assert( outCompressed );
+
+	const u8 *in = Cast( const u8 *, data );
+	u8 *out = Cast( u8 *, outCompressed );
+
+	u64 anchor = 0;	// start of the literals that havent been written yet
+
+	if ( sizeBytes > COMPRESSION_MIN_MATCH_LENGTH + COMPRESSION_LAST_LITERALS ) {
+		// where each sequence of 4 bytes was last seen, plus 1 so that 0 means never
+		// too big for the stack of a job pool thread, so this comes off the heap
+		u32 *table = Cast( u32 *, calloc( 1 << COMPRESSION_HASH_BITS, sizeof( u32 ) ) );
+		Assert( table );
+
+		u64 matchLimit = sizeBytes - COMPRESSION_LAST_LITERALS;
+		u64 pos = 0;
+
+		while ( pos + COMPRESSION_MIN_MATCH_LENGTH <= matchLimit ) {
+			u32 sequence = Compression_Read32( in + pos );
+			u32 hash = Compression_HashSequence( sequence );
+
+			u64 candidate = table[hash];
+			table[hash] = TruncCast( u32, pos + 1 );
+
+			if ( candidate == 0 || pos - ( candidate - 1 ) > COMPRESSION_MAX_OFFSET || Compression_Read32( in + candidate - 1 ) != sequence ) {
+				pos++;
+				continue;
+			}
+
+			u64 matchStart = candidate - 1;
+			u64 matchLength = COMPRESSION_MIN_MATCH_LENGTH;
+
+			while ( pos + matchLength < matchLimit && in[matchStart + matchLength] == in[pos + matchLength] ) {
+				matchLength++;
+			}
+
+			out = Compression_WriteSequence( out, in + anchor, pos - anchor, pos - matchStart, matchLength );
+
+			pos += matchLength;
+			anchor = pos;
+		}
+
+		free( table );
+	}
+
+	// everything thats left is literals
+	u64 numLiterals = sizeBytes - anchor;
+
+	*out++ = Cast( u8, ( numLiterals >= 15 ? 15 : numLiterals ) << 4 );
+
+	if ( numLiterals >= 15 ) {
+		out = Compression_WriteLength( out, numLiterals - 15 );
+	}
+
+	if ( numLiterals > 0 ) {
+		memcpy( out, in + anchor, numLiterals );
+		out += numLiterals;
+	}
+
+	return Cast( u64, out - Cast( u8 *, outCompressed ) );
+}
+
+// returns false if the length runs off the end of the input
+static bool8 Compression_ReadLength( const u8 **in, const u8 *inEnd, u64 *length ) {
+	u8 byte = 0;
+
+	do {
+		if ( *in >= inEnd ) {
+			return false;
+		}
+
+		byte = **in;
+		*in += 1;
+		*length += byte;
+	} while ( byte == 255 );
+
+	return true;
+}
+
+bool8 Compression_Decompress( const void *compressed, const u64 compressedSizeBytes, void *outData, const u64 sizeBytes ) {
+	Assert( compressed );
+	Assert( outData || sizeBytes == 0 );
+
+	const u8 *in = Cast( const u8 *, compressed );
+	const u8 *inEnd = in + compressedSizeBytes;
+
+	u8 *out = Cast( u8 *, outData );
+	u8 *outStart = out;
+	u8 *outEnd = out + sizeBytes;
+
+	while ( in < inEnd ) {
+		u8 token = *in++;
+
+		u64 numLiterals = token >> 4;
+		if ( numLiterals == 15 && !Compression_ReadLength( &in, inEnd, &numLiterals ) ) {
+			return false;
+		}
+
+		if ( numLiterals > Cast( u64, inEnd - in ) || numLiterals > Cast( u64, outEnd - out ) ) {
+			return false;
+		}
+
+		memcpy( out, in, numLiterals );
+		in += numLiterals;
+		out += numLiterals;
+
+		// the last sequence is only literals
+		if ( in == inEnd ) {
+			break;
+		}
+
+		if ( inEnd - in < 2 ) {
+			return false;
+		}
+
+		u64 offset = Cast( u64, in[0] ) | ( Cast( u64, in[1] ) << 8 );
+		in += 2;
+
+		if ( offset == 0 || offset > Cast( u64, out - outStart ) ) {
+			return false;
+		}
+
+		u64 matchLength = token & 0xF;
+		if ( matchLength == 15 && !Compression_ReadLength( &in, inEnd, &matchLength ) ) {
+			return false;
+		}
+		matchLength += COMPRESSION_MIN_MATCH_LENGTH;
+
+		if ( matchLength > Cast( u64, outEnd - out ) ) {
+			return false;
+		}
+
+		// the match can overlap what its writing (e.g. a run of the same byte), so this has to go one byte at a time
+		const u8 *match = out - offset;
+		For ( u64, byteIndex, 0, matchLength ) {
+			out[byteIndex] = match[byteIndex];
+		}
+		out += matchLength;
+	}
+
+	return out == outEnd;
+}
@@ -0,0 +1,59 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+
+/*
+================================================================================================
+
+	Compression
+
+	A small LZ77 compressor in the style of LZ4: the output is a list of sequences, where each
+	sequence is some bytes copied straight from the input followed by a copy of something that
+	came earlier in the output.  It only looks for repeats with a single hash table lookup, so it
+	doesnt compress as well as zlib or zstd, but it's fast at both ends and object files still
+	shrink a lot with it.
+
+	The compressed data doesn't say how big it was before it got compressed, so whoever stores it
+	needs to store that too.
+
+================================================================================================
+*/
+
+// Returns the most bytes Compression_Compress() could ever need to compress 'sizeBytes' bytes.
+u64		Compression_GetMaxCompressedSize( const u64 sizeBytes );
+
+// Compresses 'sizeBytes' bytes of 'data' into 'outCompressed' and returns how big the compressed data is.
+// 'outCompressed' must be at least Compression_GetMaxCompressedSize( sizeBytes ) bytes.
+u64		Compression_Compress( const void *data, const u64 sizeBytes, void *outCompressed );
+
+// Decompresses 'compressedSizeBytes' bytes of 'compressed' into 'outData', which must be exactly as big as the original data was.
+// Returns false if the compressed data is corrupt or doesn't decompress to exactly 'sizeBytes' bytes.
+bool8	Compression_Decompress( const void *compressed, const u64 compressedSizeBytes, void *outData, const u64 sizeBytes );
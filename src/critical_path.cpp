@@ -0,0 +1,327 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "critical_path.h"
+
+#include "array.inl"
+#include "debug.h"
+#include "typecast.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+
+/*
+================================================================================================
+
+	Critical Path
+
+================================================================================================
+*/
+
+// jobs on the critical path are the ones with no slack
+// but the times are floats, so leave a bit of room for rounding
+#define CRITICAL_PATH_SLACK_EPSILON_MS	0.001
+
+void CriticalPath_Init( criticalPath_t *criticalPath, linearAllocator_t *allocator ) {
+	Assert( criticalPath );
+	Assert( allocator );
+
+	*criticalPath = {};
+
+	criticalPath->nodes.Init( allocator );
+	criticalPath->edges.Init( allocator );
+	criticalPath->path.Init( allocator );
+}
+
+u32 CriticalPath_AddNode( criticalPath_t *criticalPath, const char *name, const float64 startTimeMS, const float64 endTimeMS ) {
+	Assert( criticalPath );
+	Assert( name );
+	Assert( endTimeMS >= startTimeMS );
+
+	criticalPathNode_t node = {
+		.name				= name,
+		.startTimeMS		= startTimeMS,
+		.endTimeMS			= endTimeMS,
+		.criticalDependency	= CRITICAL_PATH_NO_NODE,
+	};
+
+	criticalPath->nodes.Add( node );
+
+	return TruncCast( u32, criticalPath->nodes.count - 1 );
+}
+
+void CriticalPath_AddDependency( criticalPath_t *criticalPath, const u32 node, const u32 dependency ) {
+	Assert( criticalPath );
+	Assert( node < criticalPath->nodes.count );
+	Assert( dependency < criticalPath->nodes.count );
+
+	criticalPath->edges.Add( { dependency, node } );
+}
+
+bool8 CriticalPath_Compute( criticalPath_t *criticalPath ) {
+	Assert( criticalPath );
+
+	u32 numNodes = TruncCast( u32, criticalPath->nodes.count );
+	u32 numEdges = TruncCast( u32, criticalPath->edges.count );
+
+	criticalPathNode_t *nodes = criticalPath->nodes.data;
+	const criticalPathEdge_t *edges = criticalPath->edges.data;
+
+	criticalPath->path.count = 0;
+	criticalPath->minimumTimeMS = 0.0;
+	criticalPath->actualTimeMS = 0.0;
+
+	if ( numNodes == 0 ) {
+		return true;
+	}
+
+	float64 buildStartMS = nodes[0].startTimeMS;
+	float64 buildEndMS = nodes[0].endTimeMS;
+	For ( u32, nodeIndex, 1, numNodes ) {
+		buildStartMS = ( nodes[nodeIndex].startTimeMS < buildStartMS ) ? nodes[nodeIndex].startTimeMS : buildStartMS;
+		buildEndMS = ( nodes[nodeIndex].endTimeMS > buildEndMS ) ? nodes[nodeIndex].endTimeMS : buildEndMS;
+	}
+
+	criticalPath->actualTimeMS = buildEndMS - buildStartMS;
+
+	// each node's dependencies and dependents, packed together
+	std::vector<u32> firstDependency( numNodes + 1, 0 );
+	std::vector<u32> firstDependent( numNodes + 1, 0 );
+
+	For ( u32, edgeIndex, 0, numEdges ) {
+		firstDependency[edges[edgeIndex].to + 1]++;
+		firstDependent[edges[edgeIndex].from + 1]++;
+	}
+
+	For ( u32, nodeIndex, 0, numNodes ) {
+		firstDependency[nodeIndex + 1] += firstDependency[nodeIndex];
+		firstDependent[nodeIndex + 1] += firstDependent[nodeIndex];
+	}
+
+	std::vector<u32> dependencies( numEdges );
+	std::vector<u32> dependents( numEdges );
+
+	{
+		std::vector<u32> nextDependency( firstDependency.begin(), firstDependency.end() - 1 );
+		std::vector<u32> nextDependent( firstDependent.begin(), firstDependent.end() - 1 );
+
+		For ( u32, edgeIndex, 0, numEdges ) {
+			dependencies[nextDependency[edges[edgeIndex].to]++] = edges[edgeIndex].from;
+			dependents[nextDependent[edges[edgeIndex].from]++] = edges[edgeIndex].to;
+		}
+	}
+
+	// put the nodes in an order where every node comes after everything it depends on
+	std::vector<u32> order;
+	order.reserve( numNodes );
+
+	{
+		std::vector<u32> numDependenciesLeft( numNodes );
+
+		For ( u32, nodeIndex, 0, numNodes ) {
+			numDependenciesLeft[nodeIndex] = firstDependency[nodeIndex + 1] - firstDependency[nodeIndex];
+
+			if ( numDependenciesLeft[nodeIndex] == 0 ) {
+				order.push_back( nodeIndex );
+			}
+		}
+
+		For ( u64, orderIndex, 0, order.size() ) {
+			u32 nodeIndex = order[orderIndex];
+
+			For ( u32, dependentIndex, firstDependent[nodeIndex], firstDependent[nodeIndex + 1] ) {
+				u32 dependent = dependents[dependentIndex];
+
+				if ( --numDependenciesLeft[dependent] == 0 ) {
+					order.push_back( dependent );
+				}
+			}
+		}
+	}
+
+	if ( order.size() != numNodes ) {
+		return false;
+	}
+
+	// forwards: when each node would have finished if it started the moment it could
+	u32 lastNode = order[0];
+
+	For ( u32, orderIndex, 0, numNodes ) {
+		u32 nodeIndex = order[orderIndex];
+		criticalPathNode_t *node = &nodes[nodeIndex];
+
+		float64 earliestStartMS = 0.0;
+		float64 readyTimeMS = buildStartMS;
+
+		node->criticalDependency = CRITICAL_PATH_NO_NODE;
+
+		For ( u32, dependencyIndex, firstDependency[nodeIndex], firstDependency[nodeIndex + 1] ) {
+			const criticalPathNode_t *dependency = &nodes[dependencies[dependencyIndex]];
+
+			if ( node->criticalDependency == CRITICAL_PATH_NO_NODE || dependency->earliestFinishMS > earliestStartMS ) {
+				earliestStartMS = dependency->earliestFinishMS;
+				node->criticalDependency = dependencies[dependencyIndex];
+			}
+
+			readyTimeMS = ( dependency->endTimeMS > readyTimeMS ) ? dependency->endTimeMS : readyTimeMS;
+		}
+
+		node->earliestFinishMS = earliestStartMS + ( node->endTimeMS - node->startTimeMS );
+		node->waitMS = ( node->startTimeMS > readyTimeMS ) ? node->startTimeMS - readyTimeMS : 0.0;
+
+		if ( node->earliestFinishMS > nodes[lastNode].earliestFinishMS ) {
+			lastNode = nodeIndex;
+		}
+	}
+
+	criticalPath->minimumTimeMS = nodes[lastNode].earliestFinishMS;
+
+	// backwards: the latest each node could have finished without making the build any longer
+	for ( u32 orderIndex = numNodes; orderIndex-- > 0; ) {
+		u32 nodeIndex = order[orderIndex];
+		criticalPathNode_t *node = &nodes[nodeIndex];
+
+		node->latestFinishMS = criticalPath->minimumTimeMS;
+
+		For ( u32, dependentIndex, firstDependent[nodeIndex], firstDependent[nodeIndex + 1] ) {
+			const criticalPathNode_t *dependent = &nodes[dependents[dependentIndex]];
+
+			float64 latestStartMS = dependent->latestFinishMS - ( dependent->endTimeMS - dependent->startTimeMS );
+
+			node->latestFinishMS = ( latestStartMS < node->latestFinishMS ) ? latestStartMS : node->latestFinishMS;
+		}
+
+		node->slackMS = node->latestFinishMS - node->earliestFinishMS;
+
+		if ( node->slackMS < CRITICAL_PATH_SLACK_EPSILON_MS ) {
+			node->slackMS = 0.0;
+		}
+	}
+
+	for ( u32 nodeIndex = lastNode; nodeIndex != CRITICAL_PATH_NO_NODE; nodeIndex = nodes[nodeIndex].criticalDependency ) {
+		criticalPath->path.Add( nodeIndex );
+	}
+
+	// that went last to first
+	For ( u64, pathIndex, 0, criticalPath->path.count / 2 ) {
+		u32 temp = criticalPath->path[pathIndex];
+		criticalPath->path[pathIndex] = criticalPath->path[criticalPath->path.count - 1 - pathIndex];
+		criticalPath->path[criticalPath->path.count - 1 - pathIndex] = temp;
+	}
+
+	return true;
+}
+
+struct nearlyCriticalNode_t {
+	u32		nodeIndex;
+	float64	slackMS;
+};
+
+static int CompareNearlyCriticalNodes( const void *a, const void *b ) {
+	const nearlyCriticalNode_t *nodeA = Cast( const nearlyCriticalNode_t *, a );
+	const nearlyCriticalNode_t *nodeB = Cast( const nearlyCriticalNode_t *, b );
+
+	if ( nodeA->slackMS != nodeB->slackMS ) return ( nodeA->slackMS < nodeB->slackMS ) ? -1 : 1;
+
+	return ( nodeA->nodeIndex < nodeB->nodeIndex ) ? -1 : 1;
+}
+
+void CriticalPath_Print( const criticalPath_t *criticalPath, const u32 maxNearlyCritical ) {
+	Assert( criticalPath );
+
+	if ( criticalPath->path.count == 0 ) {
+		return;
+	}
+
+	const criticalPathNode_t *nodes = criticalPath->nodes.data;
+
+	float64 buildStartMS = nodes[0].startTimeMS;
+	For ( u64, nodeIndex, 1, criticalPath->nodes.count ) {
+		buildStartMS = ( nodes[nodeIndex].startTimeMS < buildStartMS ) ? nodes[nodeIndex].startTimeMS : buildStartMS;
+	}
+
+	printf( "Critical path:\n" );
+	printf( "    Compiling and linking took %.0f ms, and would have taken %.0f ms with infinite cores.\n", criticalPath->actualTimeMS, criticalPath->minimumTimeMS );
+
+	// if the build took about as long as the critical path then the cores were never what held it back
+	float64 lostTimeMS = criticalPath->actualTimeMS - criticalPath->minimumTimeMS;
+
+	if ( lostTimeMS <= criticalPath->minimumTimeMS * 0.05 ) {
+		printf( "    So more cores wouldn't make this any faster, only making the jobs on the critical path faster would.\n" );
+	} else {
+		printf( "    The other %.0f ms went on jobs waiting to start after everything they needed was done (for a free core, memory, or a slot in their resource pool).\n", lostTimeMS );
+	}
+
+	printf( "\n" );
+	printf( "        %10s  %10s  %10s  %s\n", "started", "took", "waited", "job" );
+
+	For ( u64, pathIndex, 0, criticalPath->path.count ) {
+		const criticalPathNode_t *node = &nodes[criticalPath->path[pathIndex]];
+
+		printf( "        %7.0f ms  %7.0f ms  %7.0f ms  %s\n", node->startTimeMS - buildStartMS, node->endTimeMS - node->startTimeMS, node->waitMS, node->name );
+	}
+
+	if ( maxNearlyCritical == 0 || criticalPath->nodes.count == criticalPath->path.count ) {
+		printf( "\n" );
+		return;
+	}
+
+	std::vector<nearlyCriticalNode_t> nearlyCritical;
+	nearlyCritical.reserve( criticalPath->nodes.count );
+
+	For ( u32, nodeIndex, 0, criticalPath->nodes.count ) {
+		bool8 onPath = false;
+		For ( u64, pathIndex, 0, criticalPath->path.count ) {
+			if ( criticalPath->path[pathIndex] == nodeIndex ) {
+				onPath = true;
+				break;
+			}
+		}
+
+		if ( !onPath ) {
+			nearlyCritical.push_back( { nodeIndex, nodes[nodeIndex].slackMS } );
+		}
+	}
+
+	qsort( nearlyCritical.data(), nearlyCritical.size(), sizeof( nearlyCriticalNode_t ), CompareNearlyCriticalNodes );
+
+	u64 numShown = ( nearlyCritical.size() < maxNearlyCritical ) ? nearlyCritical.size() : maxNearlyCritical;
+
+	printf( "\n    The jobs closest to being on the critical path, and how much longer each could have taken without making the build any longer:\n" );
+	printf( "        %10s  %10s  %s\n", "slack", "took", "job" );
+
+	For ( u64, nearlyCriticalIndex, 0, numShown ) {
+		const criticalPathNode_t *node = &nodes[nearlyCritical[nearlyCriticalIndex].nodeIndex];
+
+		printf( "        %7.0f ms  %7.0f ms  %s\n", node->slackMS, node->endTimeMS - node->startTimeMS, node->name );
+	}
+
+	printf( "\n" );
+}
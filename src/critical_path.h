@@ -0,0 +1,123 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "array.h"
+
+struct linearAllocator_t;
+
+/*
+================================================================================================
+
+	Critical Path
+
+	Works out which chain of jobs a finished build couldn't have gone any faster than, no
+	matter how many cores it had.
+
+	Every job is a node that took as long as it actually took (from when it actually started
+	to when it actually finished).  Dependencies are edges between them: a source file can't
+	compile until the precompiled header and any modules it imports have, a binary can't link
+	until all of its source files have compiled, and a config can't link until every config
+	it depends on has.
+
+	With infinite cores every job would start the moment everything it depends on finished,
+	so the longest chain of dependencies is the shortest the build could possibly take.  That
+	chain is the critical path.  Every other job has some slack: how much longer it could
+	have taken without making the build any longer.
+
+	If the build took about as long as the critical path, more cores won't help and the only
+	way to make it faster is to make the jobs on the critical path faster (or break up the
+	dependencies between them).
+
+	Not thread-safe.
+
+================================================================================================
+*/
+
+struct criticalPathNode_t {
+	const char	*name;
+
+	// when the job actually ran
+	float64		startTimeMS;
+	float64		endTimeMS;
+
+	// filled out by CriticalPath_Compute()
+	// as if every job started the moment everything it depends on finished, relative to the start of the build
+	float64		earliestFinishMS;
+	float64		latestFinishMS;
+
+	// how much longer the job could have taken without making the build any longer
+	// 0 for the jobs on the critical path
+	float64		slackMS;
+
+	// how long the job actually sat waiting (for a free core, memory, or a slot in its resource pool) after everything it depends on finished
+	float64		waitMS;
+
+	// the dependency that finished last (in theory), so following these from the last node gives you the critical path
+	// CRITICAL_PATH_NO_NODE if it doesnt depend on anything
+	u32			criticalDependency;
+};
+
+#define CRITICAL_PATH_NO_NODE	0xFFFFFFFF
+
+struct criticalPathEdge_t {
+	u32		from;	// has to finish before 'to' can start
+	u32		to;
+};
+
+struct criticalPath_t {
+	array_t<criticalPathNode_t>	nodes;
+	array_t<criticalPathEdge_t>	edges;
+
+	// filled out by CriticalPath_Compute()
+	// indices into 'nodes' of the jobs on the critical path, first to last
+	array_t<u32>				path;
+
+	// how long the build would have taken with infinite cores
+	float64						minimumTimeMS;
+
+	// how long the build actually took, from when the first job started to when the last one finished
+	float64						actualTimeMS;
+};
+
+void	CriticalPath_Init( criticalPath_t *criticalPath, linearAllocator_t *allocator );
+
+// Returns the index of the new node.
+u32		CriticalPath_AddNode( criticalPath_t *criticalPath, const char *name, const float64 startTimeMS, const float64 endTimeMS );
+
+// Says that 'node' couldn't start until 'dependency' finished.
+void	CriticalPath_AddDependency( criticalPath_t *criticalPath, const u32 node, const u32 dependency );
+
+// Works out the critical path, the minimum build time, and every node's slack.
+// Returns false if the dependencies go round in a circle, otherwise returns true.
+bool8	CriticalPath_Compute( criticalPath_t *criticalPath );
+
+// Prints the critical path, and the 'maxNearlyCritical' jobs with the least slack that aren't on it.
+void	CriticalPath_Print( const criticalPath_t *criticalPath, const u32 maxNearlyCritical );
@@ -31,6 +31,10 @@ SOFTWARE.
 #include "typecast.h"
 #include "debug.h"
 #include "string.h"
+#include "thread.h"
+#include "job_pool.h"
+#include "os.h"
+#include "math.h"
 
 #include <malloc.h>
 #include <string.h>
@@ -69,7 +73,8 @@ bool8 FS_ReadEntireFile( const char *filename, string_t *outBuffer ) {
 
 	char *temp = Cast( char *, malloc( fileSize + 1 ) );
 
-	bool8 read = FS_ReadFile( &file, 0, fileSize, temp );
+	// same as writing, an empty file has nothing to read
+	bool8 read = fileSize == 0 || FS_ReadFile( &file, 0, fileSize, temp );
 
 	FS_CloseFile( &file );
 
@@ -101,7 +106,8 @@ bool8 FS_WriteEntireFile( const char *filename, const void *data, const u64 size
 		return false;
 	}
 
-	if ( !FS_WriteFile( &file, data, 0, size ) ) {
+	// an empty file is still a file (e.g. an empty blob in a remote cache), theres just nothing to write into it
+	if ( size > 0 && !FS_WriteFile( &file, data, 0, size ) ) {
 		return false;
 	}
 
@@ -125,3 +131,66 @@ bool8 FS_WriteFile( file_t *file, const void *data, const u64 size ) {
 bool8 FS_WriteFile( file_t *file, const char *data ) {
 	return FS_WriteFile( file, data, strlen( data ) * sizeof( char ) );
 }
+
+struct fileStatJobs_t {
+	const char * const	*filenames;
+	fileStat_t			*outStats;
+	bool8				*outExists;
+	u32					numFiles;
+	atomic32_t			nextFileIndex;
+};
+
+// how many files each thread grabs at a time
+// stat calls are cheap enough that handing them out one at a time means threads spend more time fighting over the counter than doing the stats
+static const u32 FILE_STAT_JOB_BATCH_SIZE = 64;
+
+static void FileStatJob( void *data ) {
+	fileStatJobs_t *jobs = Cast( fileStatJobs_t *, data );
+
+	while ( 1 ) {
+		u32 endIndex = Thread_AtomicAdd( &jobs->nextFileIndex, FILE_STAT_JOB_BATCH_SIZE );
+		u32 startIndex = endIndex - FILE_STAT_JOB_BATCH_SIZE;
+
+		if ( startIndex >= jobs->numFiles ) {
+			break;
+		}
+
+		endIndex = Min( endIndex, jobs->numFiles );
+
+		For ( u32, fileIndex, startIndex, endIndex ) {
+			jobs->outExists[fileIndex] = FS_GetFileStat( jobs->filenames[fileIndex], &jobs->outStats[fileIndex] );
+		}
+	}
+}
+
+void FS_GetFileStatsThreaded( const char * const *filenames, const u32 numFiles, fileStat_t *outStats, bool8 *outExists ) {
+	Assert( filenames || numFiles == 0 );
+	Assert( outStats || numFiles == 0 );
+	Assert( outExists || numFiles == 0 );
+
+	fileStatJobs_t jobs = {
+		.filenames		= filenames,
+		.outStats		= outStats,
+		.outExists		= outExists,
+		.numFiles		= numFiles,
+		.nextFileIndex	= { 0 },
+	};
+
+	// the calling thread does a share of the work too, so only hand out extra jobs if theres more than one batch to go around
+	// every job keeps grabbing batches until theres none left, so any that start late just finish straight away
+	u32 numBatches = ( numFiles + FILE_STAT_JOB_BATCH_SIZE - 1 ) / FILE_STAT_JOB_BATCH_SIZE;
+	u32 numExtraJobs = ( numBatches == 0 ) ? 0 : Min( OS_GetNumCpuCores(), numBatches ) - 1;
+
+	jobCounter_t counter;
+	JobCounter_Init( &counter );
+
+	For ( u32, jobIndex, 0, numExtraJobs ) {
+		JobPool_Submit( FileStatJob, &jobs, &counter );
+	}
+
+	FileStatJob( &jobs );
+
+	JobPool_Wait( &counter );
+
+	JobCounter_Destroy( &counter );
+}
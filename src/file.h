@@ -56,6 +56,13 @@ struct file_t {
 	u64		offset;
 };
 
+// A whole file mapped read-only into memory.
+struct fileMapping_t {
+	const void	*data;
+	u64			sizeBytes;
+	u64			handle;	// only used on Windows
+};
+
 enum fileVisitFlagBits_t {
 	FILE_VISIT_RECURSIVE	= BIT( 0 ),
 	FILE_VISIT_FILES		= BIT( 1 ),
@@ -69,6 +76,13 @@ enum fileOpenFlagBits_t {
 };
 typedef u32 fileOpenFlags_t;
 
+// How many FS_GetFileLastWriteTime() units there are in one second.
+#if defined( _WIN32 )
+#define FILE_TIME_UNITS_PER_SECOND	10000000ULL
+#elif defined( __linux__ )
+#define FILE_TIME_UNITS_PER_SECOND	1000000000ULL
+#endif
+
 // TODO: DM: 05/10/2025: support for symlinks
 struct fileInfo_t {
 	u64			sizeBytes;
@@ -78,6 +92,14 @@ struct fileInfo_t {
 	const char	*fullFilename;
 };
 
+// The bits of a file's metadata that tell you whether or not its contents could have changed.
+// 'lastWriteTime' is in the same units as FS_GetFileLastWriteTime().
+struct fileStat_t {
+	u64			fileID;		// inode on Linux, file index on Windows
+	u64			sizeBytes;
+	u64			lastWriteTime;
+};
+
 typedef void ( *fileVisitCallback_t )( const fileInfo_t *fileInfo, void *userData );
 
 
@@ -125,12 +147,58 @@ bool8	FS_WriteFile( file_t *file, const void *data, const u64 offset, const u64
 // Returns true if successfully deletes the file, otherwise returns false.
 bool8	FS_DeleteFile( const char *filename );
 
+// Renames the file, replacing whatever was at 'newFilename' if anything was there.
+// Returns true if successful, otherwise returns false.
+bool8	FS_RenameFile( const char *oldFilename, const char *newFilename );
+
+// Makes 'newFilename' share the same data on disk as 'filename' without copying any of it (a reflink).
+// Only works on file systems that support it (e.g. Btrfs or XFS on Linux, or ReFS on Windows).  'newFilename' must not already exist.
+// Returns true if successful, otherwise returns false.
+bool8	FS_CloneFile( const char *filename, const char *newFilename );
+
+// Makes a hard link to 'filename' called 'newFilename'.  Both must be on the same volume, and 'newFilename' must not already exist.
+// Bear in mind that writing into either file changes both of them.
+// Returns true if successful, otherwise returns false.
+bool8	FS_HardLinkFile( const char *filename, const char *newFilename );
+
+// Copies the contents of 'filename' into 'newFilename', replacing whatever was at 'newFilename' if anything was there.
+// Returns true if successful, otherwise returns false.
+bool8	FS_CopyFile( const char *filename, const char *newFilename );
+
+// Sets the file's last write time to right now.
+// Returns true if successful, otherwise returns false.
+bool8	FS_TouchFile( const char *filename );
+
+// Maps the whole file into memory read-only so it can be read without copying any of it.
+// Returns true if successful, otherwise returns false.
+// Call FS_UnmapFile() when you're done with it.
+bool8	FS_MapFile( const char *filename, fileMapping_t *outMapping );
+
+// Unmaps a file mapped with FS_MapFile().
+// On Windows a file cannot be replaced while it's mapped, so unmap it first.
+void	FS_UnmapFile( fileMapping_t *mapping );
+
 // If the file exists sets 'outSize' to the size of the file and returns true, otherwise returns false.
 bool8	FS_GetFileSize( const char *filename, u64 *outSize );
 
 // If the file exists sets 'outLastWriteTime' to the timestamp of when the file was last written to and returns true, otherwise returns false.
+// On Linux the timestamp is in nanoseconds, on Windows it is a FILETIME (100 nanosecond intervals).
 bool8	FS_GetFileLastWriteTime( const char *filename, u64 *outLastWriteTime );
 
+// Returns the current time in the same units as FS_GetFileLastWriteTime().
+u64		FS_GetCurrentFileTime();
+
+// If the file exists fills out 'outStat' with the file's ID, size, and last write time and returns true, otherwise returns false.
+bool8	FS_GetFileStat( const char *filename, fileStat_t *outStat );
+
+// Does FS_GetFileStat() for every file in 'filenames' in one go, which is a lot faster than calling FS_GetFileStat() on each of them one after the other.
+// For each file, 'outExists' gets set to whether or not it exists, and if it does then 'outStats' gets filled out.
+// On Linux this goes through io_uring if the kernel supports it, otherwise it does the same as FS_GetFileStatsThreaded().
+void	FS_GetFileStats( const char * const *filenames, const u32 numFiles, fileStat_t *outStats, bool8 *outExists );
+
+// Same as FS_GetFileStats() but just spreads FS_GetFileStat() calls across the job pool (see job_pool.h).
+void	FS_GetFileStatsThreaded( const char * const *filenames, const u32 numFiles, fileStat_t *outStats, bool8 *outExists );
+
 // Returns true if all files found in path can be successfully visited, otherwise returns false.
 // For each file found, 'visitCallback' gets called.
 // If 'visitFolders' is true then 'visitCallback' will also fire for each folder that gets visited.
@@ -0,0 +1,185 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "file_hash_cache.h"
+
+#include "array.inl"
+#include "hashmap.h"
+#include "file.h"
+#include "string.h"
+#include "debug.h"
+#include "typecast.h"
+#include "defer.h"
+
+#include <string.h>
+
+/*
+================================================================================================
+
+	File Hash Cache
+
+================================================================================================
+*/
+
+#define FILE_HASH_CACHE_MAGIC	0x43484642	// "BFHC"
+#define FILE_HASH_CACHE_VERSION	1
+
+struct fileHashCacheHeader_t {
+	u32		magic;
+	u32		version;
+	u64		numEntries;
+};
+
+void FileHashCache_Init( fileHashCache_t *cache, linearAllocator_t *allocator ) {
+	Assert( cache );
+	Assert( allocator );
+
+	cache->entries.Init( allocator );
+	cache->entryIndices = HM_Create( allocator, 64 );
+	cache->dirty = false;
+}
+
+bool8 FileHashCache_Read( fileHashCache_t *cache, const char *filename ) {
+	Assert( cache );
+	Assert( filename );
+
+	string_t fileBuffer = {};
+	if ( !FS_ReadEntireFile( filename, &fileBuffer ) ) {
+		return false;
+	}
+
+	defer { FS_FreeFileBuffer( &fileBuffer ); };
+
+	if ( fileBuffer.count < sizeof( fileHashCacheHeader_t ) ) {
+		return false;
+	}
+
+	fileHashCacheHeader_t header;
+	memcpy( &header, fileBuffer.data, sizeof( fileHashCacheHeader_t ) );
+
+	// if the format changed then just throw the old one away, everything will get re-hashed once and we're back to normal
+	if ( header.magic != FILE_HASH_CACHE_MAGIC || header.version != FILE_HASH_CACHE_VERSION ) {
+		return false;
+	}
+
+	if ( fileBuffer.count != sizeof( fileHashCacheHeader_t ) + header.numEntries * sizeof( fileHashCacheEntry_t ) ) {
+		Warning( "File hash cache \"%s\" is corrupt, ignoring it.\n", filename );
+		return false;
+	}
+
+	// a file that was written to in the same timestamp tick as (or after) the cache was saved could have changed again after we hashed it without its metadata changing
+	// we cant trust those entries, so make sure they get hashed again
+	// this is the same trick git uses for its index to deal with "racily clean" files
+	u64 cacheLastWriteTime = 0;
+	FS_GetFileLastWriteTime( filename, &cacheLastWriteTime );
+
+	cache->entries.Resize( header.numEntries );
+	memcpy( cache->entries.data, fileBuffer.data + sizeof( fileHashCacheHeader_t ), header.numEntries * sizeof( fileHashCacheEntry_t ) );
+
+	For ( u64, entryIndex, 0, cache->entries.count ) {
+		fileHashCacheEntry_t *entry = &cache->entries[entryIndex];
+
+		if ( entry->lastWriteTime >= cacheLastWriteTime ) {
+			entry->lastWriteTime = 0;
+		}
+
+		HM_SetValue( cache->entryIndices, entry->pathHash, TruncCast( u32, entryIndex ) );
+	}
+
+	return true;
+}
+
+bool8 FileHashCache_Write( fileHashCache_t *cache, const char *filename ) {
+	Assert( cache );
+	Assert( filename );
+
+	if ( !cache->dirty ) {
+		return true;
+	}
+
+	file_t file = FS_OpenOrCreateFile( filename );
+
+	if ( file.handle == INVALID_FILE_HANDLE ) {
+		s32 errorCode = GetLastErrorCode();
+		Error( "Failed to open file \"%s\" for writing.  Error code: " ERROR_CODE_FORMAT ".\n", filename, errorCode );
+		return false;
+	}
+
+	defer { FS_CloseFile( &file ); };
+
+	fileHashCacheHeader_t header = {
+		.magic		= FILE_HASH_CACHE_MAGIC,
+		.version	= FILE_HASH_CACHE_VERSION,
+		.numEntries	= cache->entries.count,
+	};
+
+	bool8 written = FS_WriteFile( &file, &header, sizeof( fileHashCacheHeader_t ) );
+
+	if ( written && cache->entries.count > 0 ) {
+		written = FS_WriteFile( &file, cache->entries.data, cache->entries.count * sizeof( fileHashCacheEntry_t ) );
+	}
+
+	if ( !written ) {
+		s32 errorCode = GetLastErrorCode();
+		Error( "Failed to write file \"%s\".  Error code: " ERROR_CODE_FORMAT ".\n", filename, errorCode );
+		return false;
+	}
+
+	cache->dirty = false;
+
+	return true;
+}
+
+void FileHashCache_SetFileHash( fileHashCache_t *cache, const u64 pathHash, const fileStat_t *stat, const u64 contentHash ) {
+	Assert( cache );
+	Assert( stat );
+
+	fileHashCacheEntry_t newEntry = {
+		.pathHash		= pathHash,
+		.fileID			= stat->fileID,
+		.sizeBytes		= stat->sizeBytes,
+		.lastWriteTime	= stat->lastWriteTime,
+		.contentHash	= contentHash,
+	};
+
+	u32 entryIndex = HM_GetValue( cache->entryIndices, pathHash );
+
+	if ( entryIndex != HASHMAP_INVALID_VALUE ) {
+		if ( memcmp( &cache->entries[entryIndex], &newEntry, sizeof( fileHashCacheEntry_t ) ) == 0 ) {
+			return;
+		}
+
+		cache->entries[entryIndex] = newEntry;
+	} else {
+		HM_SetValue( cache->entryIndices, pathHash, TruncCast( u32, cache->entries.count ) );
+
+		cache->entries.Add( newEntry );
+	}
+
+	cache->dirty = true;
+}
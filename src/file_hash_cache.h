@@ -0,0 +1,83 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "array.h"
+
+struct hashmap_t;
+struct linearAllocator_t;
+struct fileStat_t;
+
+/*
+================================================================================================
+
+	File Hash Cache
+
+	Remembers the content hash of every file we've had to hash, keyed by the file's path.
+
+	An entry is only trusted while the file's ID, size, and last write time still match what
+	they were when we hashed it.  So we only read a file's contents again when its metadata
+	changes, and a file that gets touched but keeps the same contents still gives the same hash.
+
+	Gets saved to the .builder folder so it persists between builds.
+
+	Not thread-safe.  During a build all lookups go through fileStatMemo_t instead, which gets
+	seeded from this and writes its results back into this once the build is done.
+
+================================================================================================
+*/
+
+struct fileHashCacheEntry_t {
+	u64		pathHash;
+	u64		fileID;
+	u64		sizeBytes;
+	u64		lastWriteTime;
+	u64		contentHash;
+};
+
+struct fileHashCache_t {
+	array_t<fileHashCacheEntry_t>	entries;
+	hashmap_t						*entryIndices;
+	bool8							dirty;
+};
+
+void	FileHashCache_Init( fileHashCache_t *cache, linearAllocator_t *allocator );
+
+// Loads the cache from the given file.
+// Returns true if the file was read successfully, otherwise returns false and leaves the cache empty.
+// It's fine for this to fail (first build, or after you nuke the .builder folder).
+bool8	FileHashCache_Read( fileHashCache_t *cache, const char *filename );
+
+// Writes the cache to the given file, but only if something in it changed since it was read.
+// Returns true if the write was successful (or there was nothing to write), otherwise returns false.
+bool8	FileHashCache_Write( fileHashCache_t *cache, const char *filename );
+
+// Remembers that the file with path hash 'pathHash' had the contents hash 'contentHash' when its metadata looked like 'stat'.
+void	FileHashCache_SetFileHash( fileHashCache_t *cache, const u64 pathHash, const fileStat_t *stat, const u64 contentHash );
@@ -0,0 +1,334 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "file_stat_memo.h"
+
+#include "file_hash_cache.h"
+#include "linear_allocator.h"
+#include "array.inl"
+#include "hash.h"
+#include "math.h"
+#include "debug.h"
+#include "typecast.h"
+#include "defer.h"
+
+#include <malloc.h>
+#include <string.h>
+
+/*
+================================================================================================
+
+	File Stat Memo
+
+================================================================================================
+*/
+
+static u64 FileStatMemo_HashPath( const char *filename ) {
+	u64 pathHash = HashString( filename, 0 );
+
+	// 0 marks a free slot
+	if ( pathHash == 0 ) {
+		pathHash = 1;
+	}
+
+	return pathHash;
+}
+
+// returns the slot for the given path hash, claiming a free one if this path hasn't been seen before
+// returns NULL if the memo is full
+static fileStatMemoEntry_t *FileStatMemo_FindOrClaimEntry( fileStatMemo_t *memo, const u64 pathHash ) {
+	u32 mask = memo->capacity - 1;
+	u32 slotIndex = TruncCast( u32, pathHash & mask );
+
+	For ( u32, probeIndex, 0, memo->capacity ) {
+		fileStatMemoEntry_t *entry = &memo->entries[slotIndex];
+
+		u64 slotPathHash = Thread_AtomicLoad( &entry->pathHash );
+
+		if ( slotPathHash == 0 ) {
+			slotPathHash = Thread_AtomicCompareExchange( &entry->pathHash, 0, pathHash );
+
+			// we either claimed it or someone else claimed it for the same file at the same time
+			if ( slotPathHash == 0 || slotPathHash == pathHash ) {
+				return entry;
+			}
+		} else if ( slotPathHash == pathHash ) {
+			return entry;
+		}
+
+		slotIndex = ( slotIndex + 1 ) & mask;
+	}
+
+	return NULL;
+}
+
+static bool8 FileStatMemo_StatFile( fileStatMemo_t *memo, const char *filename, fileStat_t *outStat ) {
+	Thread_AtomicIncrement( &memo->numStatCalls );
+
+	return FS_GetFileStat( filename, outStat );
+}
+
+static bool8 FileStatMemo_GetEntryStat( fileStatMemo_t *memo, fileStatMemoEntry_t *entry, const char *filename, fileStat_t *outStat ) {
+	u32 statState = Thread_AtomicLoad( &entry->statState );
+
+	if ( statState == FILE_STAT_MEMO_STATE_DONE ) {
+		Thread_AtomicIncrement( &memo->numStatCallsSaved );
+
+		*outStat = entry->stat;
+
+		return entry->exists;
+	}
+
+	if ( statState == FILE_STAT_MEMO_STATE_EMPTY && Thread_AtomicCompareExchange( &entry->statState, FILE_STAT_MEMO_STATE_EMPTY, FILE_STAT_MEMO_STATE_BUSY ) == FILE_STAT_MEMO_STATE_EMPTY ) {
+		entry->exists = FileStatMemo_StatFile( memo, filename, &entry->stat );
+
+		Thread_AtomicStore( &entry->statState, FILE_STAT_MEMO_STATE_DONE );
+
+		*outStat = entry->stat;
+
+		return entry->exists;
+	}
+
+	// another thread is in the middle of doing this stat
+	// dont wait for it, just do it ourselves
+	return FileStatMemo_StatFile( memo, filename, outStat );
+}
+
+fileStatMemo_t *FileStatMemo_Create( linearAllocator_t *allocator, const fileHashCache_t *fileHashCache, const u32 numExtraFiles ) {
+	Assert( allocator );
+
+	const u64 minCapacity = 64 * 1024;
+
+	u64 numFiles = numExtraFiles;
+	if ( fileHashCache ) {
+		numFiles += fileHashCache->entries.count;
+	}
+
+	// keep the memo at most half full so probes stay short
+	u64 capacity = Max( minCapacity, NextPowerOf2Up( numFiles * 2 ) );
+
+	fileStatMemo_t *memo = Cast( fileStatMemo_t *, Mem_Alloc( allocator, sizeof( fileStatMemo_t ) ) );
+	memset( memo, 0, sizeof( fileStatMemo_t ) );
+
+	memo->entries = Cast( fileStatMemoEntry_t *, Mem_Alloc( allocator, capacity * sizeof( fileStatMemoEntry_t ) ) );
+	memo->capacity = TruncCast( u32, capacity );
+
+	memset( memo->entries, 0, capacity * sizeof( fileStatMemoEntry_t ) );
+
+	if ( fileHashCache ) {
+		For ( u64, cacheEntryIndex, 0, fileHashCache->entries.count ) {
+			const fileHashCacheEntry_t *cacheEntry = &fileHashCache->entries[cacheEntryIndex];
+
+			fileStatMemoEntry_t *entry = FileStatMemo_FindOrClaimEntry( memo, cacheEntry->pathHash );
+			Assert( entry );
+
+			entry->cachedStat = {
+				.fileID			= cacheEntry->fileID,
+				.sizeBytes		= cacheEntry->sizeBytes,
+				.lastWriteTime	= cacheEntry->lastWriteTime,
+			};
+			entry->cachedContentHash = cacheEntry->contentHash;
+		}
+	}
+
+	return memo;
+}
+
+bool8 FileStatMemo_GetFileStat( fileStatMemo_t *memo, const char *filename, fileStat_t *outStat ) {
+	Assert( memo );
+	Assert( filename );
+	Assert( outStat );
+
+	fileStatMemoEntry_t *entry = FileStatMemo_FindOrClaimEntry( memo, FileStatMemo_HashPath( filename ) );
+
+	if ( !entry ) {
+		return FileStatMemo_StatFile( memo, filename, outStat );
+	}
+
+	return FileStatMemo_GetEntryStat( memo, entry, filename, outStat );
+}
+
+void FileStatMemo_PrefetchFileStats( fileStatMemo_t *memo, const char * const *filenames, const u32 numFiles ) {
+	Assert( memo );
+	Assert( filenames || numFiles == 0 );
+
+	if ( numFiles == 0 ) {
+		return;
+	}
+
+	const char **batchFilenames = Cast( const char **, malloc( numFiles * sizeof( const char * ) ) );
+	fileStatMemoEntry_t **batchEntries = Cast( fileStatMemoEntry_t **, malloc( numFiles * sizeof( fileStatMemoEntry_t * ) ) );
+	fileStat_t *batchStats = Cast( fileStat_t *, malloc( numFiles * sizeof( fileStat_t ) ) );
+	bool8 *batchExists = Cast( bool8 *, malloc( numFiles * sizeof( bool8 ) ) );
+
+	defer {
+		free( batchExists );
+		free( batchStats );
+		free( batchEntries );
+		free( batchFilenames );
+	};
+
+	u32 numInBatch = 0;
+
+	For ( u32, fileIndex, 0, numFiles ) {
+		fileStatMemoEntry_t *entry = FileStatMemo_FindOrClaimEntry( memo, FileStatMemo_HashPath( filenames[fileIndex] ) );
+
+		// if the memo is full then theres nowhere to put the result, so let that file get stat'd on demand
+		if ( !entry ) {
+			continue;
+		}
+
+		// marking it busy means duplicates further down the list get skipped
+		// compile threads for other configs can be looking files up while this runs, so claim it the same way they do
+		if ( Thread_AtomicCompareExchange( &entry->statState, FILE_STAT_MEMO_STATE_EMPTY, FILE_STAT_MEMO_STATE_BUSY ) != FILE_STAT_MEMO_STATE_EMPTY ) {
+			continue;
+		}
+
+		batchFilenames[numInBatch] = filenames[fileIndex];
+		batchEntries[numInBatch] = entry;
+		numInBatch++;
+	}
+
+	FS_GetFileStats( batchFilenames, numInBatch, batchStats, batchExists );
+
+	Thread_AtomicAdd( &memo->numStatCalls, numInBatch );
+
+	For ( u32, batchIndex, 0, numInBatch ) {
+		fileStatMemoEntry_t *entry = batchEntries[batchIndex];
+
+		entry->exists = batchExists[batchIndex];
+		entry->stat = batchStats[batchIndex];
+
+		Thread_AtomicStore( &entry->statState, FILE_STAT_MEMO_STATE_DONE );
+	}
+}
+
+bool8 FileStatMemo_GetFileHash( fileStatMemo_t *memo, const char *filename, u64 *outContentHash ) {
+	Assert( memo );
+	Assert( filename );
+	Assert( outContentHash );
+
+	fileStatMemoEntry_t *entry = FileStatMemo_FindOrClaimEntry( memo, FileStatMemo_HashPath( filename ) );
+
+	fileStat_t stat = {};
+
+	if ( !entry ) {
+		if ( !FileStatMemo_StatFile( memo, filename, &stat ) ) {
+			return false;
+		}
+
+		Thread_AtomicIncrement( &memo->numFilesHashed );
+
+		return HashFileContents( filename, stat.sizeBytes, outContentHash );
+	}
+
+	if ( Thread_AtomicLoad( &entry->hashState ) == FILE_STAT_MEMO_STATE_DONE ) {
+		Thread_AtomicIncrement( &memo->numHashesSaved );
+
+		*outContentHash = entry->contentHash;
+
+		return true;
+	}
+
+	if ( !FileStatMemo_GetEntryStat( memo, entry, filename, &stat ) ) {
+		return false;
+	}
+
+	u64 contentHash = 0;
+
+	// a last write time of 0 means we couldnt trust the cached hash when we loaded it
+	bool8 unchangedSinceCached = entry->cachedStat.lastWriteTime != 0 &&
+		entry->cachedStat.fileID == stat.fileID &&
+		entry->cachedStat.sizeBytes == stat.sizeBytes &&
+		entry->cachedStat.lastWriteTime == stat.lastWriteTime;
+
+	if ( unchangedSinceCached ) {
+		Thread_AtomicIncrement( &memo->numHashesFromCache );
+
+		contentHash = entry->cachedContentHash;
+	} else {
+		if ( !HashFileContents( filename, stat.sizeBytes, &contentHash ) ) {
+			return false;
+		}
+
+		Thread_AtomicIncrement( &memo->numFilesHashed );
+	}
+
+	// if another thread beat us to it then it got the same answer, so its fine to just use ours
+	if ( Thread_AtomicCompareExchange( &entry->hashState, FILE_STAT_MEMO_STATE_EMPTY, FILE_STAT_MEMO_STATE_BUSY ) == FILE_STAT_MEMO_STATE_EMPTY ) {
+		entry->contentHash = contentHash;
+
+		Thread_AtomicStore( &entry->hashState, FILE_STAT_MEMO_STATE_DONE );
+	}
+
+	*outContentHash = contentHash;
+
+	return true;
+}
+
+void FileStatMemo_Invalidate( fileStatMemo_t *memo ) {
+	Assert( memo );
+
+	For ( u32, entryIndex, 0, memo->capacity ) {
+		fileStatMemoEntry_t *entry = &memo->entries[entryIndex];
+
+		if ( entry->pathHash.value == 0 ) {
+			continue;
+		}
+
+		// whatever we hashed this build is still worth keeping around
+		// if the file didnt actually change then we still dont need to read it again
+		if ( entry->hashState.value == FILE_STAT_MEMO_STATE_DONE ) {
+			entry->cachedStat = entry->stat;
+			entry->cachedContentHash = entry->contentHash;
+		}
+
+		entry->statState.value = FILE_STAT_MEMO_STATE_EMPTY;
+		entry->hashState.value = FILE_STAT_MEMO_STATE_EMPTY;
+	}
+}
+
+void FileStatMemo_UpdateFileHashCache( fileStatMemo_t *memo, fileHashCache_t *fileHashCache ) {
+	Assert( memo );
+	Assert( fileHashCache );
+
+	For ( u32, entryIndex, 0, memo->capacity ) {
+		fileStatMemoEntry_t *entry = &memo->entries[entryIndex];
+
+		if ( entry->pathHash.value == 0 ) {
+			continue;
+		}
+
+		if ( entry->hashState.value == FILE_STAT_MEMO_STATE_DONE ) {
+			FileHashCache_SetFileHash( fileHashCache, entry->pathHash.value, &entry->stat, entry->contentHash );
+		} else if ( entry->cachedContentHash != 0 && entry->cachedStat.lastWriteTime != 0 ) {
+			// hashed in a previous build, or earlier in this build before an invalidate
+			FileHashCache_SetFileHash( fileHashCache, entry->pathHash.value, &entry->cachedStat, entry->cachedContentHash );
+		}
+	}
+}
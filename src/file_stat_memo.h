@@ -0,0 +1,116 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "file.h"
+#include "thread.h"
+
+struct linearAllocator_t;
+struct fileHashCache_t;
+
+/*
+================================================================================================
+
+	File Stat Memo
+
+	Remembers the metadata (and, if asked for, the content hash) of every file we look at during
+	a build so that each file only gets stat'd and hashed once per build, no matter how many
+	source files include it.
+
+	Lookups are thread-safe and lock-free, so compile threads can all share one of these.
+
+	A fixed-size open addressing hash table where slots get claimed by atomically swapping in
+	the path hash.  Whichever thread claims a slot (or wins the race to fill it) does the stat
+	or the hash and publishes it.  Any thread that finds a slot that's still being filled does
+	the work itself instead of waiting, which gives the same answer.
+
+	If the memo ever fills up, lookups for files that didn't make it in just go to the file
+	system every time.
+
+================================================================================================
+*/
+
+enum fileStatMemoState_t {
+	FILE_STAT_MEMO_STATE_EMPTY	= 0,
+	FILE_STAT_MEMO_STATE_BUSY,
+	FILE_STAT_MEMO_STATE_DONE,
+};
+
+struct fileStatMemoEntry_t {
+	atomic64_t	pathHash;	// 0 if this slot is free
+	atomic32_t	statState;
+	atomic32_t	hashState;
+
+	bool8		exists;
+	fileStat_t	stat;
+	u64			contentHash;
+
+	// what the file looked like the last time we hashed it (from the file hash cache)
+	// if it still looks the same then we can skip reading it
+	fileStat_t	cachedStat;
+	u64			cachedContentHash;
+};
+
+struct fileStatMemo_t {
+	fileStatMemoEntry_t	*entries;
+	u32					capacity;	// always a power of 2
+
+	atomic32_t			numStatCalls;			// how many times we actually asked the OS for a file's metadata
+	atomic32_t			numStatCallsSaved;		// how many times we got a file's metadata from the memo instead
+	atomic32_t			numFilesHashed;			// how many files we actually read and hashed
+	atomic32_t			numHashesFromCache;		// how many hashes we got from the file hash cache because the file didn't change since last build
+	atomic32_t			numHashesSaved;			// how many times we got a file's hash from the memo instead
+};
+
+// Creates a memo big enough for every file in 'fileHashCache' plus 'numExtraFiles' more, and seeds it with the hashes in the cache.
+// 'fileHashCache' can be NULL.
+fileStatMemo_t	*FileStatMemo_Create( linearAllocator_t *allocator, const fileHashCache_t *fileHashCache, const u32 numExtraFiles );
+
+// If the file exists, fills out 'outStat' with its metadata and returns true, otherwise returns false.
+// Thread-safe.
+bool8			FileStatMemo_GetFileStat( fileStatMemo_t *memo, const char *filename, fileStat_t *outStat );
+
+// Gets the metadata of all the given files in one batch (see FS_GetFileStats()) so that later calls to FileStatMemo_GetFileStat() and FileStatMemo_GetFileHash() for them dont have to.
+// Files that are already in the memo get skipped, and so do duplicates.
+// Thread-safe.
+void			FileStatMemo_PrefetchFileStats( fileStatMemo_t *memo, const char * const *filenames, const u32 numFiles );
+
+// If the file exists, sets 'outContentHash' to the hash of its contents and returns true, otherwise returns false.
+// Thread-safe.
+bool8			FileStatMemo_GetFileHash( fileStatMemo_t *memo, const char *filename, u64 *outContentHash );
+
+// Forgets the metadata of every file, so the next lookup for each file goes to the file system again.
+// Call this after running any user code that could have written to files (e.g. OnPreBuild).
+// NOT thread-safe.
+void			FileStatMemo_Invalidate( fileStatMemo_t *memo );
+
+// Writes every hash we worked out this build back into the file hash cache so we can skip hashing those files next build.
+// NOT thread-safe.
+void			FileStatMemo_UpdateFileHashCache( fileStatMemo_t *memo, fileHashCache_t *fileHashCache );
@@ -32,6 +32,11 @@ SOFTWARE.
 #include "linear_allocator.h"
 #include "string.h"
 #include "debug.h"
+#include "file.h"
+#include "defer.h"
+#include "math.h"
+
+#include <malloc.h>
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Weverything"
@@ -65,3 +70,44 @@ u64 HashString( const string_t *string, const u64 seed ) {
 
 	return Hash64( string->data, string->count, seed );
 }
+
+bool8 HashFileContents( const char *filename, const u64 sizeBytes, u64 *outHash ) {
+	Assert( filename );
+	Assert( outHash );
+
+	XXH3_state_t state;
+	XXH3_64bits_reset( &state );
+
+	if ( sizeBytes > 0 ) {
+		file_t file = FS_OpenFile( filename, FILE_OPEN_READ );
+
+		if ( file.handle == INVALID_FILE_HANDLE ) {
+			return false;
+		}
+
+		defer { FS_CloseFile( &file ); };
+
+		const u64 maxChunkSize = 64 * 1024;
+		const u64 chunkSize = Min( sizeBytes, maxChunkSize );
+
+		u8 *chunk = Cast( u8 *, malloc( chunkSize ) );
+		defer { free( chunk ); };
+
+		u64 offset = 0;
+		while ( offset < sizeBytes ) {
+			u64 bytesToRead = Min( chunkSize, sizeBytes - offset );
+
+			if ( !FS_ReadFile( &file, offset, bytesToRead, chunk ) ) {
+				return false;
+			}
+
+			XXH3_64bits_update( &state, chunk, bytesToRead );
+
+			offset += bytesToRead;
+		}
+	}
+
+	*outHash = XXH3_64bits_digest( &state );
+
+	return true;
+}
@@ -42,3 +42,8 @@ u64		Hash64( const void *data, const u64 length, const u64 seed );
 // If 'seed' is zero then will not use a pre-existing seed as a base for the hash.
 u64		HashString( const char *string, const u64 seed );
 u64		HashString( const string_t *string, const u64 seed );
+
+// Hashes the contents of the file with XXH3 and stores the result in 'outHash'.
+// 'sizeBytes' must be the size of the file, the file is read in fixed size chunks so big files don't have to be loaded into memory all at once.
+// Returns true if the whole file could be read, otherwise returns false.
+bool8	HashFileContents( const char *filename, const u64 sizeBytes, u64 *outHash );
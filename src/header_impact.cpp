@@ -0,0 +1,889 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "header_impact.h"
+
+#include "builder_local.h"
+#include "include_dependency_db.h"
+#include "file.h"
+#include "hash.h"
+#include "hashmap.h"
+#include "linear_allocator.h"
+#include "temp_storage.h"
+#include "paths.h"
+#include "string.h"
+#include "array.inl"
+#include "typecast.h"
+#include "defer.h"
+#include "debug.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+/*
+================================================================================================
+
+	Header impact report
+
+================================================================================================
+*/
+
+// how many headers the report lists before it just says how many more there are
+#define HEADER_IMPACT_REPORT_MAX_HEADERS	20
+
+// how many of the source files that dont need a header the report names before it just says how many more there are
+#define HEADER_IMPACT_REPORT_MAX_UNUSED_BY	3
+
+// a header that isnt one of the headers in the report (like a source file that a unity batch includes)
+#define HEADER_IMPACT_INDEX_IGNORED			0xFFFFFFFE
+
+enum scopeKind_t : u8 {
+	SCOPE_KIND_TRANSPARENT	= 0,	// namespaces and extern "C", everything in them is as good as declared at the top
+	SCOPE_KIND_ENUM,				// the values in these count as declared by the header too
+	SCOPE_KIND_OTHER,				// struct bodies, function bodies, initialisers, etc.
+};
+
+struct codeToken_t {
+	const char	*start;
+	u32			length;
+	bool8		identifier;
+};
+
+// names that come up all over the place but are never something a header declares
+static const char *g_notDeclaredNames[] = {
+	"alignas", "alignof", "asm", "auto", "bool", "break", "case", "catch", "char", "class", "const", "consteval", "constexpr", "constinit", "continue",
+	"decltype", "default", "defined", "delete", "do", "double", "else", "enum", "explicit", "extern", "false", "final", "float", "for", "friend", "goto",
+	"if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "nullptr", "operator", "override", "private", "protected", "public",
+	"register", "restrict", "return", "short", "signed", "sizeof", "static", "static_assert", "struct", "switch", "template", "this", "thread_local",
+	"throw", "true", "try", "typedef", "typename", "typeof", "union", "unsigned", "using", "virtual", "void", "volatile", "while",
+	"_Static_assert", "__attribute__", "__declspec", "__extension__", "__forceinline", "__inline", "__restrict",
+};
+
+static bool8 TokenEquals( const codeToken_t *token, const char *string ) {
+	return token->length == strlen( string ) && strncmp( token->start, string, token->length ) == 0;
+}
+
+static bool8 IsPunctuation( const codeToken_t *token, const char c ) {
+	return !token->identifier && token->length == 1 && token->start[0] == c;
+}
+
+static bool8 IsNotDeclaredName( const codeToken_t *token ) {
+	For ( u64, nameIndex, 0, COUNT_OF( g_notDeclaredNames ) ) {
+		if ( TokenEquals( token, g_notDeclaredNames[nameIndex] ) ) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// a key of 0 means an empty bucket
+static u64 GetNameKey( const char *name, const u64 length ) {
+	u64 hash = Hash64( name, length, 0 );
+
+	return hash ? hash : 1;
+}
+
+// blanks out comments and the insides of string and character literals, so whats left is just code
+// newlines stay where they are so preprocessor directives still end where they did
+// the file name in an #include keeps its quotes and everything in them, since thats the one string we care about
+static void BlankCommentsAndLiterals( char *code, const u64 length ) {
+	u64 index = 0;
+
+	// only whitespace so far on this line
+	bool8 lineStart = true;
+	bool8 includeLine = false;
+
+	while ( index < length ) {
+		char c = code[index];
+
+		if ( c == '\n' ) {
+			lineStart = true;
+			includeLine = false;
+			index += 1;
+			continue;
+		}
+
+		if ( c == '/' && index + 1 < length && code[index + 1] == '/' ) {
+			while ( index < length && code[index] != '\n' ) {
+				code[index] = ' ';
+				index += 1;
+			}
+
+			continue;
+		}
+
+		if ( c == '/' && index + 1 < length && code[index + 1] == '*' ) {
+			code[index] = ' ';
+			code[index + 1] = ' ';
+			index += 2;
+
+			while ( index < length && !( code[index] == '*' && index + 1 < length && code[index + 1] == '/' ) ) {
+				if ( code[index] != '\n' ) {
+					code[index] = ' ';
+				}
+
+				index += 1;
+			}
+
+			if ( index < length ) {
+				code[index] = ' ';
+				code[index + 1] = ' ';
+				index += 2;
+			}
+
+			continue;
+		}
+
+		if ( c == '#' && lineStart ) {
+			u64 nameIndex = index + 1;
+			while ( nameIndex < length && ( code[nameIndex] == ' ' || code[nameIndex] == '\t' ) ) {
+				nameIndex += 1;
+			}
+
+			includeLine = length - nameIndex >= 7 && strncmp( code + nameIndex, "include", 7 ) == 0;
+		}
+
+		lineStart = lineStart && ( c == ' ' || c == '\t' || c == '\r' );
+
+		// a quote straight after a digit or a letter is a digit separator (1'000'000), not a character literal
+		bool8 isLiteral = c == '"' || ( c == '\'' && !( index > 0 && String_IsIdentifierChar( code[index - 1] ) ) );
+
+		if ( !isLiteral || ( includeLine && c == '"' ) ) {
+			if ( isLiteral ) {
+				index += 1;
+				while ( index < length && code[index] != '"' && code[index] != '\n' ) {
+					index += 1;
+				}
+			}
+
+			index += 1;
+			continue;
+		}
+
+		index += 1;
+
+		// raw strings dont have escapes, they go on until )delimiter"
+		if ( c == '"' && index >= 2 && code[index - 2] == 'R' ) {
+			u64 delimiterStart = index;
+			while ( index < length && code[index] != '(' && code[index] != '\n' ) {
+				index += 1;
+			}
+
+			u64 delimiterLength = index - delimiterStart;
+
+			while ( index < length ) {
+				if ( code[index] == ')' && index + delimiterLength + 1 < length && strncmp( code + index + 1, code + delimiterStart, delimiterLength ) == 0 && code[index + 1 + delimiterLength] == '"' ) {
+					index += delimiterLength + 2;
+					break;
+				}
+
+				if ( code[index] != '\n' ) {
+					code[index] = ' ';
+				}
+
+				index += 1;
+			}
+
+			continue;
+		}
+
+		while ( index < length && code[index] != c && code[index] != '\n' ) {
+			if ( code[index] == '\\' && index + 1 < length ) {
+				code[index] = ' ';
+				index += 1;
+
+				if ( code[index] == '\n' ) {
+					continue;
+				}
+			}
+
+			code[index] = ' ';
+			index += 1;
+		}
+
+		index += 1;
+	}
+}
+
+// returns where the preprocessor directive that 'current' is in ends, lines ending with a backslash carry on to the next one
+static const char *FindDirectiveEnd( const char *current, const char *end ) {
+	while ( current < end ) {
+		if ( *current == '\n' && !( current[-1] == '\\' || ( current[-1] == '\r' && current[-2] == '\\' ) ) ) {
+			return current;
+		}
+
+		current += 1;
+	}
+
+	return end;
+}
+
+// returns false once theres nothing left before 'end'
+static bool8 NextToken( const char **current, const char *end, codeToken_t *outToken ) {
+	const char *c = *current;
+
+	while ( c < end && ( *c == ' ' || *c == '\t' || *c == '\r' || *c == '\n' || *c == '\\' ) ) {
+		c += 1;
+	}
+
+	if ( c >= end ) {
+		*current = end;
+		return false;
+	}
+
+	outToken->start = c;
+	outToken->identifier = String_IsIdentifierStart( *c );
+
+	// numbers (including things like 0x1F and 1.5e3f) come out as one token, but never as an identifier
+	if ( String_IsIdentifierChar( *c ) ) {
+		while ( c < end && ( String_IsIdentifierChar( *c ) || ( !outToken->identifier && *c == '.' ) ) ) {
+			c += 1;
+		}
+	} else {
+		c += 1;
+	}
+
+	outToken->length = TruncCast( u32, c - outToken->start );
+
+	*current = c;
+
+	return true;
+}
+
+// returns the directive name and moves 'current' to the start of whatever comes after it, 'current' has to be just past the #
+static codeToken_t ReadDirectiveName( const char **current, const char *directiveEnd ) {
+	codeToken_t name = {};
+	if ( !NextToken( current, directiveEnd, &name ) || !name.identifier ) {
+		name = {};
+	}
+
+	return name;
+}
+
+// finds every #include in the (blanked) source code, and every name the code mentions
+static void ScanSourceFile( const char *code, const u64 length, linearAllocator_t *allocator, array_t<const char *> *outIncludes, hashmap_t *outNames ) {
+	const char *current = code;
+	const char *end = code + length;
+
+	bool8 lineStart = true;
+
+	while ( current < end ) {
+		char c = *current;
+
+		if ( c == '\n' ) {
+			lineStart = true;
+			current += 1;
+			continue;
+		}
+
+		if ( c == ' ' || c == '\t' || c == '\r' ) {
+			current += 1;
+			continue;
+		}
+
+		if ( c == '#' && lineStart ) {
+			const char *directiveEnd = FindDirectiveEnd( current, end );
+
+			current += 1;
+
+			codeToken_t directive = ReadDirectiveName( &current, directiveEnd );
+
+			if ( TokenEquals( &directive, "include" ) ) {
+				while ( current < directiveEnd && *current != '"' && *current != '<' ) {
+					current += 1;
+				}
+
+				if ( current < directiveEnd ) {
+					char close = ( *current == '"' ) ? '"' : '>';
+					const char *nameStart = current + 1;
+					const char *nameEnd = nameStart;
+
+					while ( nameEnd < directiveEnd && *nameEnd != close ) {
+						nameEnd += 1;
+					}
+
+					if ( nameEnd < directiveEnd && nameEnd > nameStart ) {
+						u64 nameLength = Cast( u64, nameEnd - nameStart );
+
+						char *name = String_Alloc( allocator, nameStart, nameLength + 1 ).data;
+						name[nameLength] = 0;
+
+						outIncludes->Add( name );
+					}
+				}
+
+				current = directiveEnd;
+				continue;
+			}
+
+			// any other directive can use names from a header just like code does (like #if SOME_MACRO)
+			codeToken_t token;
+			while ( NextToken( &current, directiveEnd, &token ) ) {
+				if ( token.identifier ) {
+					HM_SetValue( outNames, GetNameKey( token.start, token.length ), 1 );
+				}
+			}
+
+			continue;
+		}
+
+		lineStart = false;
+
+		codeToken_t token;
+		const char *lineEnd = current;
+		while ( lineEnd < end && *lineEnd != '\n' ) {
+			lineEnd += 1;
+		}
+
+		while ( NextToken( &current, lineEnd, &token ) ) {
+			if ( token.identifier ) {
+				HM_SetValue( outNames, GetNameKey( token.start, token.length ), 1 );
+			}
+		}
+	}
+}
+
+// finds every name the (blanked) header declares at the top level, see header_impact.h
+static void CollectDeclaredNames( const char *code, const u64 length, array_t<u64> *outNames ) {
+	const char *current = code;
+	const char *end = code + length;
+
+	std::vector<codeToken_t> tokens;
+
+	// the #define straight after an #ifndef of the same name is an include guard, which nobody else ever uses
+	codeToken_t lastIfndef = {};
+
+	bool8 lineStart = true;
+
+	while ( current < end ) {
+		char c = *current;
+
+		if ( c == '\n' ) {
+			lineStart = true;
+			current += 1;
+			continue;
+		}
+
+		if ( c == ' ' || c == '\t' || c == '\r' ) {
+			current += 1;
+			continue;
+		}
+
+		if ( c == '#' && lineStart ) {
+			const char *directiveEnd = FindDirectiveEnd( current, end );
+
+			current += 1;
+
+			codeToken_t directive = ReadDirectiveName( &current, directiveEnd );
+
+			codeToken_t name = {};
+			bool8 hasName = NextToken( &current, directiveEnd, &name ) && name.identifier;
+
+			if ( hasName && TokenEquals( &directive, "define" ) ) {
+				bool8 isIncludeGuard = lastIfndef.length == name.length && strncmp( lastIfndef.start, name.start, name.length ) == 0;
+
+				if ( !isIncludeGuard ) {
+					outNames->Add( GetNameKey( name.start, name.length ) );
+				}
+			}
+
+			lastIfndef = ( hasName && TokenEquals( &directive, "ifndef" ) ) ? name : codeToken_t {};
+
+			current = directiveEnd;
+			continue;
+		}
+
+		lineStart = false;
+
+		const char *lineEnd = current;
+		while ( lineEnd < end && *lineEnd != '\n' ) {
+			lineEnd += 1;
+		}
+
+		codeToken_t token;
+		while ( NextToken( &current, lineEnd, &token ) ) {
+			tokens.push_back( token );
+		}
+	}
+
+	std::vector<scopeKind_t> scopes;
+
+	// scopes that arent SCOPE_KIND_TRANSPARENT, nothing in those counts unless its the values of an enum
+	u32 numOpaqueScopes = 0;
+
+	u32 parenDepth = 0;
+
+	// what the next { opens
+	scopeKind_t nextScope = SCOPE_KIND_OTHER;
+
+	For ( u64, tokenIndex, 0, tokens.size() ) {
+		const codeToken_t *token = &tokens[tokenIndex];
+		const codeToken_t *next = ( tokenIndex + 1 < tokens.size() ) ? &tokens[tokenIndex + 1] : NULL;
+		const codeToken_t *previous = ( tokenIndex > 0 ) ? &tokens[tokenIndex - 1] : NULL;
+
+		if ( !token->identifier ) {
+			if ( IsPunctuation( token, '(' ) || IsPunctuation( token, '[' ) ) {
+				parenDepth += 1;
+			} else if ( IsPunctuation( token, ')' ) || IsPunctuation( token, ']' ) ) {
+				parenDepth -= ( parenDepth > 0 ) ? 1 : 0;
+			} else if ( IsPunctuation( token, '{' ) ) {
+				scopes.push_back( nextScope );
+				numOpaqueScopes += ( nextScope != SCOPE_KIND_TRANSPARENT ) ? 1 : 0;
+				nextScope = SCOPE_KIND_OTHER;
+			} else if ( IsPunctuation( token, '}' ) ) {
+				if ( !scopes.empty() ) {
+					numOpaqueScopes -= ( scopes.back() != SCOPE_KIND_TRANSPARENT ) ? 1 : 0;
+					scopes.pop_back();
+				}
+			} else if ( IsPunctuation( token, ';' ) ) {
+				nextScope = SCOPE_KIND_OTHER;
+			}
+
+			continue;
+		}
+
+		if ( TokenEquals( token, "namespace" ) || ( TokenEquals( token, "extern" ) && next && IsPunctuation( next, '"' ) ) ) {
+			nextScope = SCOPE_KIND_TRANSPARENT;
+			continue;
+		}
+
+		if ( TokenEquals( token, "enum" ) ) {
+			nextScope = SCOPE_KIND_ENUM;
+			continue;
+		}
+
+		// the names of template parameters arent declared by the header
+		if ( TokenEquals( token, "template" ) && next && IsPunctuation( next, '<' ) ) {
+			u32 angleDepth = 0;
+
+			For ( u64, skipIndex, tokenIndex + 1, tokens.size() ) {
+				if ( IsPunctuation( &tokens[skipIndex], '<' ) ) {
+					angleDepth += 1;
+				} else if ( IsPunctuation( &tokens[skipIndex], '>' ) ) {
+					angleDepth -= 1;
+				}
+
+				if ( angleDepth == 0 ) {
+					tokenIndex = skipIndex;
+					break;
+				}
+			}
+
+			continue;
+		}
+
+		if ( !next || parenDepth > 0 || IsNotDeclaredName( token ) || ( previous && previous->identifier && TokenEquals( previous, "namespace" ) ) ) {
+			continue;
+		}
+
+		bool8 declared = false;
+
+		if ( numOpaqueScopes == 0 ) {
+			// a name followed by :: is something else's scope, not a declaration
+			bool8 isScope = IsPunctuation( next, ':' ) && tokenIndex + 2 < tokens.size() && IsPunctuation( &tokens[tokenIndex + 2], ':' );
+
+			declared = !isScope && ( IsPunctuation( next, '(' ) || IsPunctuation( next, ';' ) || IsPunctuation( next, '=' ) || IsPunctuation( next, '[' ) ||
+				IsPunctuation( next, ',' ) || IsPunctuation( next, '{' ) || IsPunctuation( next, ':' ) );
+		} else if ( numOpaqueScopes == 1 && scopes.back() == SCOPE_KIND_ENUM ) {
+			declared = IsPunctuation( next, ',' ) || IsPunctuation( next, '=' ) || IsPunctuation( next, '}' );
+		}
+
+		if ( declared ) {
+			outNames->Add( GetNameKey( token->start, token->length ) );
+		}
+	}
+}
+
+// true if 'path' is 'includeName', or ends with a path separator then 'includeName' (forward slashes and backslashes count as the same thing)
+static bool8 PathEndsWithInclude( const char *path, const char *includeName ) {
+	// "../foo/bar.h" can only be matched by what comes after the ../ bits
+	while ( String_StartsWith( includeName, "./" ) || String_StartsWith( includeName, ".\\" ) ) {
+		includeName += 2;
+	}
+
+	while ( String_StartsWith( includeName, "../" ) || String_StartsWith( includeName, "..\\" ) ) {
+		includeName += 3;
+	}
+
+	u64 pathLength = strlen( path );
+	u64 nameLength = strlen( includeName );
+
+	if ( nameLength == 0 || nameLength > pathLength ) {
+		return false;
+	}
+
+	const char *pathEnd = path + pathLength - nameLength;
+
+	For ( u64, charIndex, 0, nameLength ) {
+		char a = pathEnd[charIndex];
+		char b = includeName[charIndex];
+
+		if ( a == '\\' ) a = '/';
+		if ( b == '\\' ) b = '/';
+
+		if ( a != b ) {
+			return false;
+		}
+	}
+
+	return pathEnd == path || pathEnd[-1] == '/' || pathEnd[-1] == '\\';
+}
+
+static int CompareHeadersByImpact( const void *a, const void *b ) {
+	const headerImpact_t *headerA = Cast( const headerImpact_t *, a );
+	const headerImpact_t *headerB = Cast( const headerImpact_t *, b );
+
+	if ( headerA->churnTimeMS != headerB->churnTimeMS ) return ( headerA->churnTimeMS > headerB->churnTimeMS ) ? -1 : 1;
+	if ( headerA->rebuildTimeMS != headerB->rebuildTimeMS ) return ( headerA->rebuildTimeMS > headerB->rebuildTimeMS ) ? -1 : 1;
+
+	return strcmp( headerA->filename, headerB->filename );
+}
+
+u64 HeaderImpact_HashPath( const char *path ) {
+	Assert( path );
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	u64 length = strlen( path );
+
+	char *normalised = Cast( char *, Mem_TempAlloc( length + 1 ) );
+	For ( u64, charIndex, 0, length ) {
+		normalised[charIndex] = ( path[charIndex] == '\\' ) ? '/' : path[charIndex];
+	}
+
+	return GetNameKey( normalised, length );
+}
+
+void HeaderImpact_Analyse( const includeDependencyDB_t *db, const char * const *intermediateFilenames, const u32 numSourceFiles, const hashmap_t *commitCounts, const u32 commitDays, linearAllocator_t *allocator, headerImpactReport_t *outReport ) {
+	Assert( db );
+	Assert( intermediateFilenames || numSourceFiles == 0 );
+	Assert( outReport );
+
+	*outReport = {};
+	outReport->headers.Init( allocator );
+	outReport->numSourceFiles = numSourceFiles;
+	outReport->knowsCommits = commitCounts != NULL;
+	outReport->commitDays = commitDays;
+
+	// only the source files that compiled successfully last time know what they include
+	array_t<const includeDependencyRecord_t *> records;
+	records.Init( allocator );
+
+	u32 numTimedRecords = 0;
+	float64 timedCompileTimeMS = 0.0;
+
+	For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+		u32 recordIndex = IncludeDependencyDB_FindRecord( db, intermediateFilenames[sourceFileIndex] );
+
+		if ( recordIndex == INCLUDE_DEPENDENCY_DB_INVALID_INDEX ) {
+			continue;
+		}
+
+		const includeDependencyRecord_t *record = IncludeDependencyDB_GetRecord( db, recordIndex );
+
+		if ( record->inputsHash == 0 ) {
+			continue;
+		}
+
+		records.Add( record );
+
+		if ( record->compileTimeMS > 0 ) {
+			numTimedRecords += 1;
+			timedCompileTimeMS += record->compileTimeMS;
+		}
+	}
+
+	outReport->numSourceFilesCompiled = TruncCast( u32, records.count );
+	outReport->compileTimeMS = timedCompileTimeMS;
+
+	// see the top of header_impact.h
+	float64 averageCompileTimeMS = ( numTimedRecords > 0 ) ? timedCompileTimeMS / numTimedRecords : 0.0;
+
+	// find every header they include, and what compiling everything that includes it costs
+	// keyed by path ID + 1, because a key of 0 means an empty bucket
+	hashmap_t *headerIndices = HM_Create( allocator, 1024 );
+
+	array_t<headerImpact_t> &headers = outReport->headers;
+
+	// the same header can be in a source file's include list more than once, so only count it once per source file
+	array_t<u32> lastRecordIndices;
+	lastRecordIndices.Init( allocator );
+
+	For ( u64, recordIndex, 0, records.count ) {
+		const includeDependencyRecord_t *record = records[recordIndex];
+
+		float64 recordCompileTimeMS = ( record->compileTimeMS > 0 ) ? Cast( float64, record->compileTimeMS ) : averageCompileTimeMS;
+
+		For ( u32, dependencyIndex, 0, record->numDependencies ) {
+			u32 stringID = IncludeDependencyDB_GetDependency( db, record, dependencyIndex );
+
+			u32 headerIndex = HM_GetValue( headerIndices, Cast( u64, stringID ) + 1 );
+
+			if ( headerIndex == HASHMAP_INVALID_VALUE ) {
+				const char *filename = IncludeDependencyDB_GetString( db, stringID );
+
+				if ( FileIsSourceFile( filename ) ) {
+					headerIndex = HEADER_IMPACT_INDEX_IGNORED;
+				} else {
+					headerIndex = TruncCast( u32, headers.count );
+
+					headerImpact_t header = {
+						.filename	= filename,
+					};
+					header.unusedBy.Init( allocator );
+
+					headers.Add( header );
+
+					lastRecordIndices.Add( U32_MAX );
+				}
+
+				HM_SetValue( headerIndices, Cast( u64, stringID ) + 1, headerIndex );
+			}
+
+			if ( headerIndex == HEADER_IMPACT_INDEX_IGNORED || lastRecordIndices[headerIndex] == recordIndex ) {
+				continue;
+			}
+
+			headers[headerIndex].numSourceFiles++;
+			headers[headerIndex].rebuildTimeMS += recordCompileTimeMS;
+			lastRecordIndices[headerIndex] = TruncCast( u32, recordIndex );
+		}
+	}
+
+	if ( commitCounts ) {
+		For ( u64, headerIndex, 0, headers.count ) {
+			headerImpact_t *header = &headers[headerIndex];
+
+			// the commit counts have the real path of each file, which is only different if theres a symlink in the way
+			// a header that doesnt exist anymore cant have its real path looked up, but it also cant be changed again
+			if ( !FS_FileExists( header->filename ) ) {
+				continue;
+			}
+
+			u64 marker = Mem_TempTell();
+
+			string_t absolutePath = Path_AbsolutePath( Mem_GetTempStorage(), header->filename );
+			u32 numCommits = HM_GetValue( commitCounts, HeaderImpact_HashPath( String_Cstr( &absolutePath ) ) );
+
+			Mem_TempRewindTo( marker );
+
+			header->numCommits = ( numCommits == HASHMAP_INVALID_VALUE ) ? 0 : numCommits;
+			header->churnTimeMS = header->rebuildTimeMS * header->numCommits;
+		}
+	}
+
+	// now look for headers that source files include but dont need
+	// the names each header declares only get worked out the first time a source file includes it directly
+	array_t<array_t<u64>> declaredNames;
+	declaredNames.Init( allocator );
+	declaredNames.Resize( headers.count );
+
+	array_t<bool8> scannedHeaders;
+	scannedHeaders.Init( allocator );
+	scannedHeaders.Resize( headers.count );
+
+	For ( u64, headerIndex, 0, headers.count ) {
+		declaredNames[headerIndex].Init( allocator );
+		scannedHeaders[headerIndex] = false;
+		lastRecordIndices[headerIndex] = U32_MAX;
+	}
+
+	hashmap_t *sourceFileNames = HM_Create( allocator, 4096 );
+
+	array_t<const char *> includes;
+	includes.Init( allocator );
+
+	For ( u64, recordIndex, 0, records.count ) {
+		const includeDependencyRecord_t *record = records[recordIndex];
+
+		const char *sourceFilename = IncludeDependencyDB_GetString( db, record->filenameID );
+
+		string_t sourceCode = {};
+		if ( !FS_ReadEntireFile( sourceFilename, &sourceCode ) ) {
+			continue;
+		}
+
+		BlankCommentsAndLiterals( sourceCode.data, sourceCode.count );
+
+		includes.Reset();
+		HM_Reset( sourceFileNames );
+
+		ScanSourceFile( sourceCode.data, sourceCode.count, allocator, &includes, sourceFileNames );
+
+		FS_FreeFileBuffer( &sourceCode );
+
+		For ( u64, includeIndex, 0, includes.count ) {
+			u32 headerIndex = HASHMAP_INVALID_VALUE;
+
+			For ( u32, dependencyIndex, 0, record->numDependencies ) {
+				u32 stringID = IncludeDependencyDB_GetDependency( db, record, dependencyIndex );
+
+				if ( PathEndsWithInclude( IncludeDependencyDB_GetString( db, stringID ), includes[includeIndex] ) ) {
+					headerIndex = HM_GetValue( headerIndices, Cast( u64, stringID ) + 1 );
+					break;
+				}
+			}
+
+			// system headers arent in the include dependency database, and source files can include other source files (like unity batches do)
+			if ( headerIndex >= headers.count || lastRecordIndices[headerIndex] == recordIndex ) {
+				continue;
+			}
+
+			lastRecordIndices[headerIndex] = TruncCast( u32, recordIndex );
+
+			headerImpact_t *header = &headers[headerIndex];
+			header->numDirectIncludes++;
+
+			if ( !scannedHeaders[headerIndex] ) {
+				scannedHeaders[headerIndex] = true;
+
+				string_t headerCode = {};
+				if ( FS_ReadEntireFile( header->filename, &headerCode ) ) {
+					BlankCommentsAndLiterals( headerCode.data, headerCode.count );
+					CollectDeclaredNames( headerCode.data, headerCode.count, &declaredNames[headerIndex] );
+
+					FS_FreeFileBuffer( &headerCode );
+				}
+			}
+
+			// a header that doesnt declare anything itself is only there for what it includes, so theres no telling whether its needed
+			if ( declaredNames[headerIndex].count == 0 ) {
+				continue;
+			}
+
+			bool8 used = false;
+			For ( u64, nameIndex, 0, declaredNames[headerIndex].count ) {
+				if ( HM_GetValue( sourceFileNames, declaredNames[headerIndex][nameIndex] ) != HASHMAP_INVALID_VALUE ) {
+					used = true;
+					break;
+				}
+			}
+
+			if ( !used ) {
+				if ( header->unusedBy.count == 0 ) {
+					outReport->numUnneededHeaders++;
+				}
+
+				header->unusedBy.Add( sourceFilename );
+			}
+		}
+	}
+
+	qsort( headers.data, headers.count, sizeof( headerImpact_t ), CompareHeadersByImpact );
+}
+
+void HeaderImpact_PrintReport( const headerImpactReport_t *report, const char *configName ) {
+	Assert( report );
+	Assert( configName );
+
+	printf( "Header impact report for config \"%s\":\n", configName );
+
+	if ( report->numSourceFilesCompiled == 0 ) {
+		printf( "    None of its source files have compiled yet, so there's nothing to go on.  Build it first.\n\n" );
+		return;
+	}
+
+	printf( "    %u of %u source files compiled last time, which took %.0f ms in total.\n", report->numSourceFilesCompiled, report->numSourceFiles, report->compileTimeMS );
+
+	if ( report->knowsCommits ) {
+		printf( "    How often each header changes comes from the last %u days of git history.\n\n", report->commitDays );
+	} else {
+		printf( "    There's no git history to go on, so this is only what one edit to each header costs.\n\n" );
+	}
+
+	if ( report->headers.count == 0 ) {
+		printf( "    None of them include any headers.\n\n" );
+		return;
+	}
+
+	printf( "    Headers that cost the most to change:\n" );
+
+	if ( report->knowsCommits ) {
+		printf( "        %13s  %17s  %7s  %17s\n", "cost per edit", "source files", "commits", "cost of commits" );
+	} else {
+		printf( "        %13s  %17s\n", "cost per edit", "source files" );
+	}
+
+	u64 numShown = Min( report->headers.count, Cast( u64, HEADER_IMPACT_REPORT_MAX_HEADERS ) );
+
+	For ( u64, headerIndex, 0, numShown ) {
+		const headerImpact_t *header = &report->headers[headerIndex];
+
+		float64 percent = ( Cast( float64, header->numSourceFiles ) / report->numSourceFilesCompiled ) * 100.0;
+
+		if ( report->knowsCommits ) {
+			printf( "        %10.0f ms  %10u (%3.0f%%)  %7u  %14.0f ms  %s\n", header->rebuildTimeMS, header->numSourceFiles, percent, header->numCommits, header->churnTimeMS, header->filename );
+		} else {
+			printf( "        %10.0f ms  %10u (%3.0f%%)  %s\n", header->rebuildTimeMS, header->numSourceFiles, percent, header->filename );
+		}
+	}
+
+	if ( report->headers.count > numShown ) {
+		printf( "        ... and %" PRIu64 " more.\n", report->headers.count - numShown );
+	}
+
+	if ( report->numUnneededHeaders == 0 ) {
+		printf( "\n    None of the source files seem to include headers they don't need.\n\n" );
+		return;
+	}
+
+	printf( "\n    These headers get included by source files that don't seem to use anything they declare:\n" );
+
+	For ( u64, headerIndex, 0, report->headers.count ) {
+		const headerImpact_t *header = &report->headers[headerIndex];
+
+		if ( header->unusedBy.count == 0 ) {
+			continue;
+		}
+
+		printf( "        %s: %" PRIu64 " of the %u source files that include it directly (", header->filename, header->unusedBy.count, header->numDirectIncludes );
+
+		u64 numNamed = Min( header->unusedBy.count, Cast( u64, HEADER_IMPACT_REPORT_MAX_UNUSED_BY ) );
+
+		For ( u64, unusedIndex, 0, numNamed ) {
+			string_t sourceFile = String_Set( header->unusedBy[unusedIndex] );
+			sourceFile = Path_RemovePathFromFile( &sourceFile );
+
+			printf( "%s%.*s", ( unusedIndex > 0 ) ? ", " : "", TruncCast( int, sourceFile.count ), sourceFile.data );
+		}
+
+		if ( header->unusedBy.count > numNamed ) {
+			printf( ", and %" PRIu64 " more", header->unusedBy.count - numNamed );
+		}
+
+		printf( ")\n" );
+	}
+
+	printf( "\n" );
+}
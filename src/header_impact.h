@@ -0,0 +1,117 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "array.h"
+
+struct hashmap_t;
+struct includeDependencyDB_t;
+struct linearAllocator_t;
+
+/*
+================================================================================================
+
+	Header impact report
+
+	Works out what it costs to change each header a config's source files include, from what
+	the include dependency database says each of them included (and how long each of them
+	took to compile) the last time they compiled.  Changing a header means every source file
+	that includes it (directly or not) has to compile again, so what one edit to it costs is
+	how long all of those take to compile.  Source files that haven't got a compile time yet
+	count as taking as long as the average one that has.
+
+	If we know how many commits changed each header recently then that gets multiplied in
+	too, since a header that costs a lot to change but never changes doesn't actually cost
+	anything.  Those are the headers worth splitting up, or replacing with forward
+	declarations in the headers that include them.
+
+	It also looks for headers that a source file includes itself but doesn't seem to need.
+	For each header a source file #includes, it looks for any of the names the header
+	declares (its types, functions, variables, enum values, and macros) in the source file's
+	code.  If none of them are there then the source file probably only needs something that
+	header includes, or nothing at all.  This doesn't run the preprocessor or the compiler,
+	so it can be fooled (like by a name that only comes out of a macro), and headers that
+	don't declare anything themselves (ones that just include other headers) never count.
+
+================================================================================================
+*/
+
+struct headerImpact_t {
+	const char				*filename;
+
+	// how many of the config's source files include this header, directly or not
+	u32						numSourceFiles;
+
+	// how long we expect it to take to compile all of them again after an edit to this header
+	float64					rebuildTimeMS;
+
+	// how many commits changed this header recently, and what all of those edits cost put together
+	// both 0 if we dont know
+	u32						numCommits;
+	float64					churnTimeMS;
+
+	// how many of the source files #include this header themselves
+	u32						numDirectIncludes;
+
+	// of those, the ones that dont seem to use anything this header declares
+	array_t<const char *>	unusedBy;
+};
+
+struct headerImpactReport_t {
+	// most expensive first, by churnTimeMS if we know how often each header changes, otherwise by rebuildTimeMS
+	array_t<headerImpact_t>	headers;
+
+	u32						numSourceFiles;
+
+	// how many of the source files compiled successfully last time, and how long they took in total
+	// only these ones count
+	u32						numSourceFilesCompiled;
+	float64					compileTimeMS;
+
+	// true if the commit counts were given to HeaderImpact_Analyse()
+	bool8					knowsCommits;
+	u32						commitDays;
+
+	// how many headers at least one source file includes without needing it
+	u32						numUnneededHeaders;
+};
+
+// Works out what changing each header that the config's source files include costs.
+// 'intermediateFilenames' are the files each source file compiles to, since that's what the include dependency database knows them by.
+// 'commitCounts' is how many commits changed each file in the last 'commitDays' days, keyed by HeaderImpact_HashPath() of the file's absolute path.
+// It can be NULL if we don't know (like if the code isn't in a git repository).
+void	HeaderImpact_Analyse( const includeDependencyDB_t *db, const char * const *intermediateFilenames, const u32 numSourceFiles, const hashmap_t *commitCounts, const u32 commitDays, linearAllocator_t *allocator, headerImpactReport_t *outReport );
+
+// Returns the key for 'path' in the commit counts given to HeaderImpact_Analyse().
+// Forward slashes and backslashes are treated as the same thing.
+u64		HeaderImpact_HashPath( const char *path );
+
+// Prints the headers that cost the most to change, and the ones that source files include without needing.
+void	HeaderImpact_PrintReport( const headerImpactReport_t *report, const char *configName );
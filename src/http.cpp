@@ -0,0 +1,311 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "http.h"
+
+#include "debug.h"
+#include "typecast.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/*
+================================================================================================
+
+	HTTP
+
+================================================================================================
+*/
+
+#define HTTP_BUFFER_SIZE	( 64 * 1024 )
+
+static_assert( HTTP_BUFFER_SIZE > HTTP_MAX_HEAD_SIZE, "The whole head of a message has to fit in the buffer." );
+
+void Http_OpenConnection( httpConnection_t *connection, const socket_t socket ) {
+	Assert( connection );
+
+	*connection = {
+		.socket			= socket,
+		.buffer			= Cast( u8 *, malloc( HTTP_BUFFER_SIZE ) ),
+		.bufferStart	= 0,
+		.bufferEnd		= 0,
+	};
+}
+
+void Http_CloseConnection( httpConnection_t *connection ) {
+	Assert( connection );
+
+	Socket_Close( &connection->socket );
+
+	free( connection->buffer );
+	connection->buffer = NULL;
+}
+
+// receives more into the buffer, moving whats left to the front first if it needs the room
+static bool8 Http_Receive( httpConnection_t *connection ) {
+	if ( connection->bufferStart == connection->bufferEnd ) {
+		connection->bufferStart = 0;
+		connection->bufferEnd = 0;
+	} else if ( connection->bufferEnd == HTTP_BUFFER_SIZE ) {
+		u64 numUnread = connection->bufferEnd - connection->bufferStart;
+
+		memmove( connection->buffer, connection->buffer + connection->bufferStart, numUnread );
+		connection->bufferStart = 0;
+		connection->bufferEnd = numUnread;
+	}
+
+	s64 bytesReceived = Socket_Receive( &connection->socket, connection->buffer + connection->bufferEnd, HTTP_BUFFER_SIZE - connection->bufferEnd );
+
+	if ( bytesReceived <= 0 ) {
+		return false;
+	}
+
+	connection->bufferEnd += Cast( u64, bytesReceived );
+
+	return true;
+}
+
+static bool8 Http_StartsWithNoCase( const char *str, const char *prefix ) {
+	for ( ; *prefix; str++, prefix++ ) {
+		if ( tolower( *str ) != tolower( *prefix ) ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// reads everything up to and including the blank line at the end of the head
+// returns the head as a null-terminated string with each line null-terminated too, in the connection's buffer, so its only good until the next read
+static char *Http_ReadHead( httpConnection_t *connection, u64 *outLength ) {
+	u64 searchStart = connection->bufferStart;
+
+	while ( 1 ) {
+		For ( u64, i, searchStart, connection->bufferEnd ) {
+			if ( i - connection->bufferStart >= 3 && memcmp( connection->buffer + i - 3, "\r\n\r\n", 4 ) == 0 ) {
+				char *head = Cast( char *, connection->buffer + connection->bufferStart );
+				u64 length = i + 1 - connection->bufferStart;
+
+				connection->bufferStart = i + 1;
+
+				For ( u64, j, 0, length ) {
+					if ( head[j] == '\r' || head[j] == '\n' ) {
+						head[j] = 0;
+					}
+				}
+
+				*outLength = length;
+
+				return head;
+			}
+		}
+
+		if ( connection->bufferEnd - connection->bufferStart >= HTTP_MAX_HEAD_SIZE ) {
+			return NULL;
+		}
+
+		u64 numSearched = connection->bufferEnd - connection->bufferStart;
+
+		if ( !Http_Receive( connection ) ) {
+			return NULL;
+		}
+
+		// receiving might have moved everything to the front of the buffer
+		searchStart = connection->bufferStart + numSearched;
+	}
+}
+
+// fills out the parts of the head that requests and responses have in common
+static bool8 Http_ParseHeaders( const char *head, const u64 length, const bool8 keepAliveByDefault, httpHead_t *outHead ) {
+	outHead->contentLength = 0;
+	outHead->keepAlive = keepAliveByDefault;
+
+	const char *end = head + length;
+
+	// skip the first line, the caller does that one
+	const char *line = head + strlen( head ) + 1;
+
+	while ( line < end ) {
+		if ( *line == 0 ) {
+			line++;
+			continue;
+		}
+
+		if ( Http_StartsWithNoCase( line, "Content-Length:" ) ) {
+			char *numberEnd = NULL;
+			outHead->contentLength = strtoull( line + strlen( "Content-Length:" ), &numberEnd, 10 );
+		} else if ( Http_StartsWithNoCase( line, "Connection:" ) ) {
+			const char *value = line + strlen( "Connection:" );
+			while ( *value == ' ' ) {
+				value++;
+			}
+
+			if ( Http_StartsWithNoCase( value, "close" ) ) {
+				outHead->keepAlive = false;
+			} else if ( Http_StartsWithNoCase( value, "keep-alive" ) ) {
+				outHead->keepAlive = true;
+			}
+		} else if ( Http_StartsWithNoCase( line, "Transfer-Encoding:" ) ) {
+			// the only thing that ever goes here is chunked, and we dont do that
+			return false;
+		}
+
+		line += strlen( line ) + 1;
+	}
+
+	return true;
+}
+
+bool8 Http_ReadRequestHead( httpConnection_t *connection, httpHead_t *outHead ) {
+	Assert( connection );
+	Assert( outHead );
+
+	u64 length = 0;
+	char *head = Http_ReadHead( connection, &length );
+
+	if ( !head ) {
+		return false;
+	}
+
+	// "METHOD /path HTTP/1.1"
+	const char *methodEnd = strchr( head, ' ' );
+	if ( !methodEnd || Cast( u64, methodEnd - head ) >= sizeof( outHead->method ) ) {
+		return false;
+	}
+
+	const char *path = methodEnd + 1;
+	const char *pathEnd = strchr( path, ' ' );
+	if ( !pathEnd || Cast( u64, pathEnd - path ) >= sizeof( outHead->path ) ) {
+		return false;
+	}
+
+	memcpy( outHead->method, head, Cast( u64, methodEnd - head ) );
+	outHead->method[methodEnd - head] = 0;
+
+	memcpy( outHead->path, path, Cast( u64, pathEnd - path ) );
+	outHead->path[pathEnd - path] = 0;
+
+	outHead->statusCode = 0;
+
+	// HTTP/1.0 closes after every message unless it says otherwise
+	bool8 keepAliveByDefault = strcmp( pathEnd + 1, "HTTP/1.0" ) != 0;
+
+	return Http_ParseHeaders( head, length, keepAliveByDefault, outHead );
+}
+
+bool8 Http_ReadResponseHead( httpConnection_t *connection, httpHead_t *outHead ) {
+	Assert( connection );
+	Assert( outHead );
+
+	u64 length = 0;
+	char *head = Http_ReadHead( connection, &length );
+
+	if ( !head ) {
+		return false;
+	}
+
+	// "HTTP/1.1 200 OK"
+	if ( !Http_StartsWithNoCase( head, "HTTP/1." ) ) {
+		return false;
+	}
+
+	const char *statusCode = strchr( head, ' ' );
+	if ( !statusCode ) {
+		return false;
+	}
+
+	outHead->method[0] = 0;
+	outHead->path[0] = 0;
+	outHead->statusCode = TruncCast( u32, strtoul( statusCode + 1, NULL, 10 ) );
+
+	bool8 keepAliveByDefault = !Http_StartsWithNoCase( head, "HTTP/1.0" );
+
+	return Http_ParseHeaders( head, length, keepAliveByDefault, outHead );
+}
+
+bool8 Http_ReadBody( httpConnection_t *connection, void *outBody, const u64 size ) {
+	Assert( connection );
+	Assert( outBody || size == 0 );
+
+	u8 *out = Cast( u8 *, outBody );
+	u64 bytesLeft = size;
+
+	while ( bytesLeft > 0 ) {
+		if ( connection->bufferStart == connection->bufferEnd ) {
+			// big bodies go straight from the socket to where they're going rather than through the buffer
+			if ( bytesLeft >= HTTP_BUFFER_SIZE ) {
+				s64 bytesReceived = Socket_Receive( &connection->socket, out, bytesLeft );
+
+				if ( bytesReceived <= 0 ) {
+					return false;
+				}
+
+				out += bytesReceived;
+				bytesLeft -= Cast( u64, bytesReceived );
+
+				continue;
+			}
+
+			if ( !Http_Receive( connection ) ) {
+				return false;
+			}
+		}
+
+		u64 numBuffered = connection->bufferEnd - connection->bufferStart;
+		u64 numToCopy = ( numBuffered < bytesLeft ) ? numBuffered : bytesLeft;
+
+		memcpy( out, connection->buffer + connection->bufferStart, numToCopy );
+
+		connection->bufferStart += numToCopy;
+		out += numToCopy;
+		bytesLeft -= numToCopy;
+	}
+
+	return true;
+}
+
+bool8 Http_SkipBody( httpConnection_t *connection, const u64 size ) {
+	Assert( connection );
+
+	u8 scratch[4096];
+
+	u64 bytesLeft = size;
+
+	while ( bytesLeft > 0 ) {
+		u64 numToRead = ( bytesLeft < sizeof( scratch ) ) ? bytesLeft : sizeof( scratch );
+
+		if ( !Http_ReadBody( connection, scratch, numToRead ) ) {
+			return false;
+		}
+
+		bytesLeft -= numToRead;
+	}
+
+	return true;
+}
@@ -0,0 +1,91 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "socket.h"
+
+/*
+================================================================================================
+
+	HTTP
+
+	The bare minimum of HTTP/1.1 that the remote cache needs, on both the client and the server
+	side: reading request and response heads, and reading bodies that have a Content-Length.
+	Chunked bodies aren't supported.
+
+	Connections are kept alive unless either side says otherwise, and reads are buffered, so
+	any number of requests can be sent down one connection before reading any of the
+	responses back (pipelining).
+
+	Writing a message is just formatting the head yourself and sending it with Socket_Send().
+
+================================================================================================
+*/
+
+#define HTTP_MAX_HEAD_SIZE	8192
+#define HTTP_MAX_PATH		1024
+
+struct httpConnection_t {
+	socket_t	socket;
+
+	// what we've received but not read yet is between 'bufferStart' and 'bufferEnd'
+	u8			*buffer;
+	u64			bufferStart;
+	u64			bufferEnd;
+};
+
+// The head of a request or a response.
+struct httpHead_t {
+	// requests only
+	char		method[16];
+	char		path[HTTP_MAX_PATH];
+
+	// responses only
+	u32			statusCode;
+
+	u64			contentLength;	// 0 if there wasn't a Content-Length
+	bool8		keepAlive;		// false if either side should close the connection after this message
+};
+
+// Takes ownership of 'socket'.
+void	Http_OpenConnection( httpConnection_t *connection, const socket_t socket );
+
+// Closes the socket too.
+void	Http_CloseConnection( httpConnection_t *connection );
+
+// Returns false if the connection closed, timed out, or the head was malformed (or had a chunked body).
+bool8	Http_ReadRequestHead( httpConnection_t *connection, httpHead_t *outHead );
+bool8	Http_ReadResponseHead( httpConnection_t *connection, httpHead_t *outHead );
+
+// Reads exactly 'size' bytes of body into 'outBody'.
+bool8	Http_ReadBody( httpConnection_t *connection, void *outBody, const u64 size );
+
+// Same as Http_ReadBody(), but throws it away.
+bool8	Http_SkipBody( httpConnection_t *connection, const u64 size );
@@ -0,0 +1,742 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "include_dependency_db.h"
+
+#include "array.inl"
+#include "hashmap.h"
+#include "hash.h"
+#include "math.h"
+#include "linear_allocator.h"
+#include "temp_storage.h"
+#include "string.h"
+#include "debug.h"
+#include "typecast.h"
+#include "defer.h"
+
+#include <string.h>
+
+/*
+================================================================================================
+
+	Include Dependency Database
+
+================================================================================================
+*/
+
+// bump this whenever the layout of the file changes
+// files written by an older version of builder get thrown away, which just means everything gets rebuilt once
+#define INCLUDE_DEPENDENCY_DB_MAGIC		0x44494642	// "BFID"
+#define INCLUDE_DEPENDENCY_DB_VERSION	5
+
+// the hash tables on disk are never allowed to be completely full, so probing always finds an empty slot eventually
+#define INCLUDE_DEPENDENCY_DB_MIN_TABLE_CAPACITY	16
+
+struct includeDependencyDBHeader_t {
+	u32		magic;
+	u32		version;
+	u32		numStrings;
+	u32		stringTableCapacity;
+	u32		numRecords;
+	u32		recordTableCapacity;
+	u32		numDependencies;
+	u32		numLinkRecords;
+	u64		stringDataSize;
+};
+
+// where each section lives in the file, relative to the start of it
+// every section starts on an 8 byte boundary so that everything can be read straight out of the mapping
+struct includeDependencyDBLayout_t {
+	u64		stringHashesOffset;
+	u64		recordsOffset;
+	u64		linkRecordsOffset;
+	u64		stringOffsetsOffset;
+	u64		stringTableOffset;
+	u64		recordTableOffset;
+	u64		dependenciesOffset;
+	u64		stringDataOffset;
+	u64		totalSize;
+};
+
+static u64 AlignUp8( const u64 x ) {
+	return ( x + 7 ) & ~Cast( u64, 7 );
+}
+
+static includeDependencyDBLayout_t IncludeDependencyDB_GetLayout( const includeDependencyDBHeader_t *header ) {
+	includeDependencyDBLayout_t layout = {};
+
+	u64 offset = sizeof( includeDependencyDBHeader_t );
+
+	layout.stringHashesOffset = offset;
+	offset += header->numStrings * sizeof( u64 );
+
+	layout.recordsOffset = offset;
+	offset += header->numRecords * sizeof( includeDependencyRecord_t );
+
+	layout.linkRecordsOffset = offset;
+	offset += header->numLinkRecords * sizeof( includeDependencyLinkRecord_t );
+
+	layout.stringOffsetsOffset = offset;
+	offset = AlignUp8( offset + header->numStrings * sizeof( u32 ) );
+
+	layout.stringTableOffset = offset;
+	offset = AlignUp8( offset + header->stringTableCapacity * sizeof( u32 ) );
+
+	layout.recordTableOffset = offset;
+	offset = AlignUp8( offset + header->recordTableCapacity * sizeof( u32 ) );
+
+	layout.dependenciesOffset = offset;
+	offset = AlignUp8( offset + header->numDependencies * sizeof( u32 ) );
+
+	layout.stringDataOffset = offset;
+	offset += header->stringDataSize;
+
+	layout.totalSize = offset;
+
+	return layout;
+}
+
+static bool8 IsPowerOf2( const u32 x ) {
+	return x != 0 && ( x & ( x - 1 ) ) == 0;
+}
+
+static u32 IncludeDependencyDB_GetTableCapacity( const u64 numItems ) {
+	return TruncCast( u32, Max( Cast( u64, INCLUDE_DEPENDENCY_DB_MIN_TABLE_CAPACITY ), NextPowerOf2Up( numItems * 2 ) ) );
+}
+
+static u32 IncludeDependencyDB_GetNumRecords( const includeDependencyDB_t *db ) {
+	return db->recordsCopied ? TruncCast( u32, db->records.count ) : db->numFileRecords;
+}
+
+static u32 IncludeDependencyDB_GetNumLinkRecords( const includeDependencyDB_t *db ) {
+	return db->linkRecordsCopied ? TruncCast( u32, db->linkRecords.count ) : db->numFileLinkRecords;
+}
+
+static const includeDependencyLinkRecord_t *IncludeDependencyDB_GetLinkRecord( const includeDependencyDB_t *db, const u32 linkRecordIndex ) {
+	return db->linkRecordsCopied ? &db->linkRecords[linkRecordIndex] : &db->fileLinkRecords[linkRecordIndex];
+}
+
+static void IncludeDependencyDB_CopyRecords( includeDependencyDB_t *db ) {
+	if ( db->recordsCopied ) {
+		return;
+	}
+
+	db->records.Resize( db->numFileRecords );
+
+	if ( db->numFileRecords > 0 ) {
+		memcpy( db->records.data, db->fileRecords, db->numFileRecords * sizeof( includeDependencyRecord_t ) );
+	}
+
+	db->recordsCopied = true;
+}
+
+static void IncludeDependencyDB_CopyLinkRecords( includeDependencyDB_t *db ) {
+	if ( db->linkRecordsCopied ) {
+		return;
+	}
+
+	db->linkRecords.Resize( db->numFileLinkRecords );
+
+	if ( db->numFileLinkRecords > 0 ) {
+		memcpy( db->linkRecords.data, db->fileLinkRecords, db->numFileLinkRecords * sizeof( includeDependencyLinkRecord_t ) );
+	}
+
+	db->linkRecordsCopied = true;
+}
+
+static u32 IncludeDependencyDB_FindString( const includeDependencyDB_t *db, const char *string, const u64 hash ) {
+	if ( db->numFileStrings > 0 ) {
+		u32 mask = db->fileStringTableCapacity - 1;
+		u32 slotIndex = TruncCast( u32, hash & mask );
+
+		while ( db->fileStringTable[slotIndex] != 0 ) {
+			u32 stringID = db->fileStringTable[slotIndex] - 1;
+
+			if ( db->fileStringHashes[stringID] == hash && strcmp( IncludeDependencyDB_GetString( db, stringID ), string ) == 0 ) {
+				return stringID;
+			}
+
+			slotIndex = ( slotIndex + 1 ) & mask;
+		}
+	}
+
+	u32 stringID = HM_GetValue( db->newStringIDs, hash );
+
+	if ( stringID != HASHMAP_INVALID_VALUE && strcmp( IncludeDependencyDB_GetString( db, stringID ), string ) == 0 ) {
+		return stringID;
+	}
+
+	return INCLUDE_DEPENDENCY_DB_INVALID_INDEX;
+}
+
+static u32 IncludeDependencyDB_InternString( includeDependencyDB_t *db, const char *string ) {
+	u64 hash = HashString( string, 0 );
+
+	u32 stringID = IncludeDependencyDB_FindString( db, string, hash );
+
+	if ( stringID != INCLUDE_DEPENDENCY_DB_INVALID_INDEX ) {
+		return stringID;
+	}
+
+	u64 length = strlen( string );
+
+	char *copy = Cast( char *, Mem_Alloc( db->allocator, length + 1 ) );
+	memcpy( copy, string, length + 1 );
+
+	stringID = db->numFileStrings + TruncCast( u32, db->newStrings.count );
+
+	db->newStrings.Add( copy );
+
+	HM_SetValue( db->newStringIDs, hash, stringID );
+
+	return stringID;
+}
+
+// a hash table slot is either empty (0) or 1 + the index of what it points to
+// every table must have exactly as many full slots as there are things in it, so that probing always finds an empty slot eventually
+static bool8 IncludeDependencyDB_IsTableValid( const u32 *table, const u32 capacity, const u32 numItems ) {
+	u32 numFullSlots = 0;
+
+	For ( u32, slotIndex, 0, capacity ) {
+		if ( table[slotIndex] == 0 ) {
+			continue;
+		}
+
+		if ( table[slotIndex] > numItems ) {
+			return false;
+		}
+
+		numFullSlots++;
+	}
+
+	return numFullSlots == numItems;
+}
+
+// checks every ID, offset, and range in the file once up front, so nothing that reads from the mapping afterwards has to
+static bool8 IncludeDependencyDB_IsFileValid( const includeDependencyDBHeader_t *header, const includeDependencyDBLayout_t *layout, const u8 *base ) {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wcast-align"
+	const u32 *stringOffsets = Cast( const u32 *, base + layout->stringOffsetsOffset );
+	const u32 *stringTable = Cast( const u32 *, base + layout->stringTableOffset );
+	const u32 *recordTable = Cast( const u32 *, base + layout->recordTableOffset );
+	const u32 *dependencies = Cast( const u32 *, base + layout->dependenciesOffset );
+	const includeDependencyRecord_t *records = Cast( const includeDependencyRecord_t *, base + layout->recordsOffset );
+	const includeDependencyLinkRecord_t *linkRecords = Cast( const includeDependencyLinkRecord_t *, base + layout->linkRecordsOffset );
+#pragma clang diagnostic pop
+
+	For ( u32, stringID, 0, header->numStrings ) {
+		if ( stringOffsets[stringID] >= header->stringDataSize ) {
+			return false;
+		}
+	}
+
+	For ( u32, dependencyIndex, 0, header->numDependencies ) {
+		if ( dependencies[dependencyIndex] >= header->numStrings ) {
+			return false;
+		}
+	}
+
+	For ( u32, recordIndex, 0, header->numRecords ) {
+		const includeDependencyRecord_t *record = &records[recordIndex];
+
+		if ( record->filenameID >= header->numStrings || record->intermediateFilenameID >= header->numStrings ) {
+			return false;
+		}
+
+		if ( Cast( u64, record->firstDependency ) + record->numDependencies > header->numDependencies ) {
+			return false;
+		}
+	}
+
+	For ( u32, linkRecordIndex, 0, header->numLinkRecords ) {
+		if ( linkRecords[linkRecordIndex].binaryFilenameID >= header->numStrings ) {
+			return false;
+		}
+	}
+
+	return IncludeDependencyDB_IsTableValid( stringTable, header->stringTableCapacity, header->numStrings ) &&
+		IncludeDependencyDB_IsTableValid( recordTable, header->recordTableCapacity, header->numRecords );
+}
+
+void IncludeDependencyDB_Init( includeDependencyDB_t *db, linearAllocator_t *allocator ) {
+	Assert( db );
+	Assert( allocator );
+
+	*db = {};
+
+	db->allocator = allocator;
+
+	db->newStrings.Init( allocator );
+	db->newStringIDs = HM_Create( allocator, 64 );
+	db->records.Init( allocator );
+	db->newRecordIndices = HM_Create( allocator, 64 );
+	db->newDependencies.Init( allocator );
+	db->linkRecords.Init( allocator );
+}
+
+bool8 IncludeDependencyDB_Load( includeDependencyDB_t *db, const char *filename ) {
+	Assert( db );
+	Assert( filename );
+	Assert( db->mapping.data == NULL );
+
+	fileMapping_t mapping = {};
+	if ( !FS_MapFile( filename, &mapping ) ) {
+		return false;
+	}
+
+	if ( mapping.sizeBytes < sizeof( includeDependencyDBHeader_t ) ) {
+		FS_UnmapFile( &mapping );
+		return false;
+	}
+
+	const u8 *base = Cast( const u8 *, mapping.data );
+
+	const includeDependencyDBHeader_t *header = Cast( const includeDependencyDBHeader_t *, base );
+
+	if ( header->magic != INCLUDE_DEPENDENCY_DB_MAGIC || header->version != INCLUDE_DEPENDENCY_DB_VERSION ) {
+		FS_UnmapFile( &mapping );
+		return false;
+	}
+
+	includeDependencyDBLayout_t layout = IncludeDependencyDB_GetLayout( header );
+
+	// the sections have to add up to exactly the size of the file before anything in them can be looked at
+	// the string data size gets checked on its own first since its the only size big enough to wrap the total around
+	// the last byte must be a null terminator so that no string can run off the end of the mapping
+	bool8 valid = header->stringDataSize <= mapping.sizeBytes && layout.totalSize == mapping.sizeBytes &&
+		IsPowerOf2( header->stringTableCapacity ) && header->stringTableCapacity > header->numStrings &&
+		IsPowerOf2( header->recordTableCapacity ) && header->recordTableCapacity > header->numRecords &&
+		( header->stringDataSize == 0 || base[mapping.sizeBytes - 1] == '\0' ) &&
+		IncludeDependencyDB_IsFileValid( header, &layout, base );
+
+	if ( !valid ) {
+		Warning( "Include dependencies file \"%s\" is corrupt, ignoring it.\n", filename );
+		FS_UnmapFile( &mapping );
+		return false;
+	}
+
+	db->mapping = mapping;
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wcast-align"
+	db->fileStringHashes		= Cast( const u64 *, base + layout.stringHashesOffset );
+	db->fileRecords				= Cast( const includeDependencyRecord_t *, base + layout.recordsOffset );
+	db->fileLinkRecords			= Cast( const includeDependencyLinkRecord_t *, base + layout.linkRecordsOffset );
+	db->fileStringOffsets		= Cast( const u32 *, base + layout.stringOffsetsOffset );
+	db->fileStringTable			= Cast( const u32 *, base + layout.stringTableOffset );
+	db->fileRecordTable			= Cast( const u32 *, base + layout.recordTableOffset );
+	db->fileDependencies		= Cast( const u32 *, base + layout.dependenciesOffset );
+#pragma clang diagnostic pop
+	db->fileStringData			= Cast( const char *, base + layout.stringDataOffset );
+
+	db->numFileStrings			= header->numStrings;
+	db->fileStringTableCapacity	= header->stringTableCapacity;
+	db->numFileRecords			= header->numRecords;
+	db->fileRecordTableCapacity	= header->recordTableCapacity;
+	db->numFileDependencies		= header->numDependencies;
+	db->numFileLinkRecords		= header->numLinkRecords;
+
+	return true;
+}
+
+bool8 IncludeDependencyDB_Save( includeDependencyDB_t *db, const char *filename ) {
+	Assert( db );
+	Assert( filename );
+
+	// nothing changed, so whats on disk is already right
+	if ( !db->dirty ) {
+		FS_UnmapFile( &db->mapping );
+		return true;
+	}
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	u32 numRecords = IncludeDependencyDB_GetNumRecords( db );
+	u32 numLinkRecords = IncludeDependencyDB_GetNumLinkRecords( db );
+	u32 numStringsBefore = db->numFileStrings + TruncCast( u32, db->newStrings.count );
+
+	// write out a fresh copy that only has the strings and dependencies that are still in use
+	// anything that got replaced during this build would otherwise just pile up forever
+	u32 *stringRemap = Cast( u32 *, Mem_TempAlloc( numStringsBefore * sizeof( u32 ) ) );
+	memset( stringRemap, 0xFF, numStringsBefore * sizeof( u32 ) );
+
+	array_t<u32> strings;
+	strings.Init( Mem_GetTempStorage() );
+
+	u64 stringDataSize = 0;
+
+	auto RemapString = [&]( const u32 stringID ) -> u32 {
+		if ( stringRemap[stringID] == INCLUDE_DEPENDENCY_DB_INVALID_INDEX ) {
+			stringRemap[stringID] = TruncCast( u32, strings.count );
+			strings.Add( stringID );
+			stringDataSize += strlen( IncludeDependencyDB_GetString( db, stringID ) ) + 1;
+		}
+
+		return stringRemap[stringID];
+	};
+
+	array_t<includeDependencyRecord_t> records;
+	records.Init( Mem_GetTempStorage() );
+	records.Resize( numRecords );
+
+	array_t<u32> dependencies;
+	dependencies.Init( Mem_GetTempStorage() );
+
+	For ( u32, recordIndex, 0, numRecords ) {
+		const includeDependencyRecord_t *record = IncludeDependencyDB_GetRecord( db, recordIndex );
+
+		includeDependencyRecord_t *newRecord = &records[recordIndex];
+		*newRecord = *record;
+		newRecord->filenameID = RemapString( record->filenameID );
+		newRecord->intermediateFilenameID = RemapString( record->intermediateFilenameID );
+		newRecord->firstDependency = TruncCast( u32, dependencies.count );
+
+		For ( u32, dependencyIndex, 0, record->numDependencies ) {
+			dependencies.Add( RemapString( IncludeDependencyDB_GetDependency( db, record, dependencyIndex ) ) );
+		}
+	}
+
+	array_t<includeDependencyLinkRecord_t> linkRecords;
+	linkRecords.Init( Mem_GetTempStorage() );
+	linkRecords.Resize( numLinkRecords );
+
+	For ( u32, linkRecordIndex, 0, numLinkRecords ) {
+		linkRecords[linkRecordIndex] = *IncludeDependencyDB_GetLinkRecord( db, linkRecordIndex );
+		linkRecords[linkRecordIndex].binaryFilenameID = RemapString( linkRecords[linkRecordIndex].binaryFilenameID );
+	}
+
+	includeDependencyDBHeader_t header = {
+		.magic					= INCLUDE_DEPENDENCY_DB_MAGIC,
+		.version				= INCLUDE_DEPENDENCY_DB_VERSION,
+		.numStrings				= TruncCast( u32, strings.count ),
+		.stringTableCapacity	= IncludeDependencyDB_GetTableCapacity( strings.count ),
+		.numRecords				= numRecords,
+		.recordTableCapacity	= IncludeDependencyDB_GetTableCapacity( numRecords ),
+		.numDependencies		= TruncCast( u32, dependencies.count ),
+		.numLinkRecords			= numLinkRecords,
+		.stringDataSize			= stringDataSize,
+	};
+
+	includeDependencyDBLayout_t layout = IncludeDependencyDB_GetLayout( &header );
+
+	u8 *buffer = Cast( u8 *, Mem_TempAlloc( layout.totalSize ) );
+	memset( buffer, 0, layout.totalSize );
+
+	memcpy( buffer, &header, sizeof( includeDependencyDBHeader_t ) );
+
+	if ( numRecords > 0 ) {
+		memcpy( buffer + layout.recordsOffset, records.data, numRecords * sizeof( includeDependencyRecord_t ) );
+	}
+
+	if ( numLinkRecords > 0 ) {
+		memcpy( buffer + layout.linkRecordsOffset, linkRecords.data, numLinkRecords * sizeof( includeDependencyLinkRecord_t ) );
+	}
+
+	if ( dependencies.count > 0 ) {
+		memcpy( buffer + layout.dependenciesOffset, dependencies.data, dependencies.count * sizeof( u32 ) );
+	}
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wcast-align"
+	u64 *stringHashes = Cast( u64 *, buffer + layout.stringHashesOffset );
+	u32 *stringOffsets = Cast( u32 *, buffer + layout.stringOffsetsOffset );
+	u32 *stringTable = Cast( u32 *, buffer + layout.stringTableOffset );
+	u32 *recordTable = Cast( u32 *, buffer + layout.recordTableOffset );
+#pragma clang diagnostic pop
+	char *stringData = Cast( char *, buffer + layout.stringDataOffset );
+
+	u32 stringDataOffset = 0;
+
+	For ( u32, stringIndex, 0, TruncCast( u32, strings.count ) ) {
+		const char *string = IncludeDependencyDB_GetString( db, strings[stringIndex] );
+		u64 length = strlen( string );
+
+		memcpy( stringData + stringDataOffset, string, length + 1 );
+
+		stringOffsets[stringIndex] = stringDataOffset;
+		stringDataOffset += TruncCast( u32, length + 1 );
+
+		u64 hash = HashString( string, 0 );
+		stringHashes[stringIndex] = hash;
+
+		u32 mask = header.stringTableCapacity - 1;
+		u32 slotIndex = TruncCast( u32, hash & mask );
+		while ( stringTable[slotIndex] != 0 ) {
+			slotIndex = ( slotIndex + 1 ) & mask;
+		}
+
+		stringTable[slotIndex] = stringIndex + 1;
+	}
+
+	For ( u32, recordIndex, 0, numRecords ) {
+		u32 mask = header.recordTableCapacity - 1;
+		u32 slotIndex = TruncCast( u32, records[recordIndex].intermediateFilenameHash & mask );
+		while ( recordTable[slotIndex] != 0 ) {
+			slotIndex = ( slotIndex + 1 ) & mask;
+		}
+
+		recordTable[slotIndex] = recordIndex + 1;
+	}
+
+	// write to a separate file and swap it in once its complete, so a build that gets killed part way through writing never leaves a half-written file behind
+	// this also means we never write over the file we currently have mapped
+	string_t tempFilename = String_Printf( Mem_GetTempStorage(), "%s.tmp", filename );
+
+	if ( !FS_WriteEntireFile( tempFilename.data, buffer, layout.totalSize ) ) {
+		s32 errorCode = GetLastErrorCode();
+		Error( "Failed to write file \"%s\".  Error code: " ERROR_CODE_FORMAT ".\n", tempFilename.data, errorCode );
+		FS_UnmapFile( &db->mapping );
+		return false;
+	}
+
+	// windows wont let us replace the file while we still have it mapped
+	FS_UnmapFile( &db->mapping );
+
+	if ( !FS_RenameFile( tempFilename.data, filename ) ) {
+		s32 errorCode = GetLastErrorCode();
+		Error( "Failed to replace file \"%s\".  Error code: " ERROR_CODE_FORMAT ".\n", filename, errorCode );
+		return false;
+	}
+
+	db->dirty = false;
+
+	return true;
+}
+
+u32 IncludeDependencyDB_FindRecord( const includeDependencyDB_t *db, const char *intermediateFilename ) {
+	Assert( db );
+	Assert( intermediateFilename );
+
+	u64 hash = HashString( intermediateFilename, 0 );
+
+	if ( db->numFileRecords > 0 ) {
+		u32 mask = db->fileRecordTableCapacity - 1;
+		u32 slotIndex = TruncCast( u32, hash & mask );
+
+		while ( db->fileRecordTable[slotIndex] != 0 ) {
+			u32 recordIndex = db->fileRecordTable[slotIndex] - 1;
+
+			const includeDependencyRecord_t *record = IncludeDependencyDB_GetRecord( db, recordIndex );
+
+			if ( record->intermediateFilenameHash == hash && strcmp( IncludeDependencyDB_GetString( db, record->intermediateFilenameID ), intermediateFilename ) == 0 ) {
+				return recordIndex;
+			}
+
+			slotIndex = ( slotIndex + 1 ) & mask;
+		}
+	}
+
+	u32 recordIndex = HM_GetValue( db->newRecordIndices, hash );
+
+	if ( recordIndex != HASHMAP_INVALID_VALUE ) {
+		return recordIndex;
+	}
+
+	return INCLUDE_DEPENDENCY_DB_INVALID_INDEX;
+}
+
+u32 IncludeDependencyDB_AddRecord( includeDependencyDB_t *db, const char *sourceFilename, const char *intermediateFilename ) {
+	Assert( db );
+	Assert( sourceFilename );
+	Assert( intermediateFilename );
+
+	IncludeDependencyDB_CopyRecords( db );
+
+	u64 hash = HashString( intermediateFilename, 0 );
+
+	includeDependencyRecord_t record = {
+		.intermediateFilenameHash	= hash,
+		.inputsHash					= 0,
+		.commandHash				= 0,
+		.filenameID					= IncludeDependencyDB_InternString( db, sourceFilename ),
+		.intermediateFilenameID		= IncludeDependencyDB_InternString( db, intermediateFilename ),
+		.firstDependency			= 0,
+		.numDependencies			= 0,
+		.compileTimeMS				= 0,
+		.peakMemoryMB				= 0,
+	};
+
+	u32 recordIndex = TruncCast( u32, db->records.count );
+
+	db->records.Add( record );
+
+	HM_SetValue( db->newRecordIndices, hash, recordIndex );
+
+	db->dirty = true;
+
+	return recordIndex;
+}
+
+const includeDependencyRecord_t *IncludeDependencyDB_GetRecord( const includeDependencyDB_t *db, const u32 recordIndex ) {
+	Assert( db );
+	Assert( recordIndex < IncludeDependencyDB_GetNumRecords( db ) );
+
+	return db->recordsCopied ? &db->records[recordIndex] : &db->fileRecords[recordIndex];
+}
+
+const char *IncludeDependencyDB_GetString( const includeDependencyDB_t *db, const u32 stringID ) {
+	Assert( db );
+
+	if ( stringID < db->numFileStrings ) {
+		return db->fileStringData + db->fileStringOffsets[stringID];
+	}
+
+	return db->newStrings[stringID - db->numFileStrings];
+}
+
+u32 IncludeDependencyDB_GetDependency( const includeDependencyDB_t *db, const includeDependencyRecord_t *record, const u32 dependencyIndex ) {
+	Assert( db );
+	Assert( record );
+	Assert( dependencyIndex < record->numDependencies );
+
+	u32 index = record->firstDependency + dependencyIndex;
+
+	if ( index < db->numFileDependencies ) {
+		return db->fileDependencies[index];
+	}
+
+	return db->newDependencies[index - db->numFileDependencies];
+}
+
+void IncludeDependencyDB_SetRecord( includeDependencyDB_t *db, const u32 recordIndex, const char *sourceFilename, const char * const *dependencies, const u32 numDependencies, const u64 inputsHash, const u64 commandHash, const u32 compileTimeMS, const u32 peakMemoryMB ) {
+	Assert( db );
+	Assert( sourceFilename );
+	Assert( dependencies || numDependencies == 0 );
+
+	const includeDependencyRecord_t *oldRecord = IncludeDependencyDB_GetRecord( db, recordIndex );
+
+	includeDependencyRecord_t newRecord = *oldRecord;
+	newRecord.filenameID = IncludeDependencyDB_InternString( db, sourceFilename );
+	newRecord.inputsHash = inputsHash;
+	newRecord.commandHash = commandHash;
+	newRecord.compileTimeMS = compileTimeMS;
+	newRecord.peakMemoryMB = peakMemoryMB;
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	u32 *dependencyIDs = Cast( u32 *, Mem_TempAlloc( Max( numDependencies, 1U ) * sizeof( u32 ) ) );
+
+	bool8 dependenciesChanged = numDependencies != oldRecord->numDependencies;
+
+	For ( u32, dependencyIndex, 0, numDependencies ) {
+		dependencyIDs[dependencyIndex] = IncludeDependencyDB_InternString( db, dependencies[dependencyIndex] );
+
+		if ( !dependenciesChanged && dependencyIDs[dependencyIndex] != IncludeDependencyDB_GetDependency( db, oldRecord, dependencyIndex ) ) {
+			dependenciesChanged = true;
+		}
+	}
+
+	// most of the time a file that gets recompiled still includes exactly the same things, so dont bother storing another copy of the same list
+	if ( dependenciesChanged ) {
+		newRecord.firstDependency = db->numFileDependencies + TruncCast( u32, db->newDependencies.count );
+		newRecord.numDependencies = numDependencies;
+
+		db->newDependencies.AddRange( dependencyIDs, numDependencies );
+	}
+
+	if ( memcmp( oldRecord, &newRecord, sizeof( includeDependencyRecord_t ) ) == 0 ) {
+		return;
+	}
+
+	IncludeDependencyDB_CopyRecords( db );
+
+	db->records[recordIndex] = newRecord;
+
+	db->dirty = true;
+}
+
+void IncludeDependencyDB_InvalidateRecord( includeDependencyDB_t *db, const u32 recordIndex ) {
+	Assert( db );
+
+	if ( IncludeDependencyDB_GetRecord( db, recordIndex )->inputsHash == 0 ) {
+		return;
+	}
+
+	IncludeDependencyDB_CopyRecords( db );
+
+	db->records[recordIndex].inputsHash = 0;
+
+	db->dirty = true;
+}
+
+static u32 IncludeDependencyDB_FindLinkRecord( const includeDependencyDB_t *db, const char *binaryFilename, const u64 hash ) {
+	For ( u32, linkRecordIndex, 0, IncludeDependencyDB_GetNumLinkRecords( db ) ) {
+		const includeDependencyLinkRecord_t *linkRecord = IncludeDependencyDB_GetLinkRecord( db, linkRecordIndex );
+
+		if ( linkRecord->binaryFilenameHash == hash && strcmp( IncludeDependencyDB_GetString( db, linkRecord->binaryFilenameID ), binaryFilename ) == 0 ) {
+			return linkRecordIndex;
+		}
+	}
+
+	return INCLUDE_DEPENDENCY_DB_INVALID_INDEX;
+}
+
+u64 IncludeDependencyDB_GetLinkHash( const includeDependencyDB_t *db, const char *binaryFilename ) {
+	Assert( db );
+	Assert( binaryFilename );
+
+	u32 linkRecordIndex = IncludeDependencyDB_FindLinkRecord( db, binaryFilename, HashString( binaryFilename, 0 ) );
+
+	if ( linkRecordIndex == INCLUDE_DEPENDENCY_DB_INVALID_INDEX ) {
+		return 0;
+	}
+
+	return IncludeDependencyDB_GetLinkRecord( db, linkRecordIndex )->linkHash;
+}
+
+void IncludeDependencyDB_SetLinkHash( includeDependencyDB_t *db, const char *binaryFilename, const u64 linkHash ) {
+	Assert( db );
+	Assert( binaryFilename );
+
+	u64 hash = HashString( binaryFilename, 0 );
+
+	u32 linkRecordIndex = IncludeDependencyDB_FindLinkRecord( db, binaryFilename, hash );
+
+	if ( linkRecordIndex != INCLUDE_DEPENDENCY_DB_INVALID_INDEX && IncludeDependencyDB_GetLinkRecord( db, linkRecordIndex )->linkHash == linkHash ) {
+		return;
+	}
+
+	IncludeDependencyDB_CopyLinkRecords( db );
+
+	if ( linkRecordIndex == INCLUDE_DEPENDENCY_DB_INVALID_INDEX ) {
+		includeDependencyLinkRecord_t linkRecord = {
+			.binaryFilenameHash	= hash,
+			.linkHash			= linkHash,
+			.binaryFilenameID	= IncludeDependencyDB_InternString( db, binaryFilename ),
+			.padding			= 0,
+		};
+
+		db->linkRecords.Add( linkRecord );
+	} else {
+		db->linkRecords[linkRecordIndex].linkHash = linkHash;
+	}
+
+	db->dirty = true;
+}
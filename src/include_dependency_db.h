@@ -0,0 +1,174 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "array.h"
+#include "file.h"
+
+struct hashmap_t;
+struct linearAllocator_t;
+
+/*
+================================================================================================
+
+	Include Dependency Database
+
+	Remembers, for every intermediate (.o) file we've built, which source file it came from,
+	every file that source file included, and the hashes we need to tell whether it's out of
+	date.  Also remembers the link command hash of every binary we've linked.
+
+	On disk, every path is stored exactly once in a string table and everything else refers
+	to paths by a u32 ID.  Each source file's include dependencies are a range in one big
+	array of path IDs.  The string table and the source file list both come with a hash table
+	baked in, so lookups work straight off the file.
+
+	Loading just maps the file read-only and points into it, there is no parsing at all.  The
+	only thing it does is check once that every ID, offset, and range in the file points
+	somewhere valid, and throw the whole file away if not, so nothing that reads from it later
+	has to.  Anything that changes during a
+	build gets copied out of the mapping first and the whole file gets rewritten (compacted)
+	at the end, but only if anything actually changed.
+
+	Not thread-safe.
+
+================================================================================================
+*/
+
+#define INCLUDE_DEPENDENCY_DB_INVALID_INDEX	0xFFFFFFFF
+
+struct includeDependencyRecord_t {
+	u64		intermediateFilenameHash;
+
+	// combined hash of the contents of the source file and all its include dependencies from when it last compiled successfully
+	// 0 if we dont know (never compiled, or the last compile failed)
+	u64		inputsHash;
+
+	// hash of the compiler and the command line this file was last compiled with
+	u64		commandHash;
+
+	u32		filenameID;
+	u32		intermediateFilenameID;
+	u32		firstDependency;
+	u32		numDependencies;
+
+	// how long this file took to compile the last time it compiled successfully
+	// 0 if we dont know
+	u32		compileTimeMS;
+
+	// peak resident memory the compiler used the last time this file compiled successfully, rounded up to the nearest MB
+	// 0 if we dont know
+	u32		peakMemoryMB;
+};
+
+struct includeDependencyLinkRecord_t {
+	u64		binaryFilenameHash;
+
+	// hash of the compiler and everything that went into the command line this binary was last linked with
+	// 0 if the last link failed
+	u64		linkHash;
+
+	u32		binaryFilenameID;
+	u32		padding;
+};
+
+struct includeDependencyDB_t {
+	linearAllocator_t						*allocator;
+
+	fileMapping_t							mapping;
+
+	// everything that came from the file, pointing straight into the mapping
+	const u64								*fileStringHashes;
+	const u32								*fileStringOffsets;
+	const u32								*fileStringTable;
+	const char								*fileStringData;
+	const includeDependencyRecord_t			*fileRecords;
+	const u32								*fileRecordTable;
+	const u32								*fileDependencies;
+	const includeDependencyLinkRecord_t		*fileLinkRecords;
+	u32										numFileStrings;
+	u32										fileStringTableCapacity;
+	u32										numFileRecords;
+	u32										fileRecordTableCapacity;
+	u32										numFileDependencies;
+	u32										numFileLinkRecords;
+
+	// everything added or changed since loading
+	// records and link records get copied out of the mapping the first time anything about them changes
+	array_t<const char *>					newStrings;
+	hashmap_t								*newStringIDs;
+	array_t<includeDependencyRecord_t>		records;
+	hashmap_t								*newRecordIndices;
+	array_t<u32>							newDependencies;
+	array_t<includeDependencyLinkRecord_t>	linkRecords;
+	bool8									recordsCopied;
+	bool8									linkRecordsCopied;
+
+	bool8									dirty;
+};
+
+void								IncludeDependencyDB_Init( includeDependencyDB_t *db, linearAllocator_t *allocator );
+
+// Maps the given file.
+// Returns true if it was loaded, otherwise returns false and leaves the database empty.
+// It's fine for this to fail (first build, after you nuke the .builder folder, or if the file was written by a different version of Builder).
+bool8								IncludeDependencyDB_Load( includeDependencyDB_t *db, const char *filename );
+
+// Writes the database to the given file, but only if something in it changed since it was loaded.
+// Unmaps the file it was loaded from, so the database is empty afterwards.
+// Returns true if the write was successful (or there was nothing to write), otherwise returns false.
+bool8								IncludeDependencyDB_Save( includeDependencyDB_t *db, const char *filename );
+
+// Returns the index of the record for the given intermediate file, or INCLUDE_DEPENDENCY_DB_INVALID_INDEX if there isn't one.
+u32									IncludeDependencyDB_FindRecord( const includeDependencyDB_t *db, const char *intermediateFilename );
+
+// Adds a new record for the given intermediate file that says it has never been compiled, and returns its index.
+u32									IncludeDependencyDB_AddRecord( includeDependencyDB_t *db, const char *sourceFilename, const char *intermediateFilename );
+
+// Returns the record at the given index.
+// The pointer stays valid until the next call that adds or changes a record.
+const includeDependencyRecord_t		*IncludeDependencyDB_GetRecord( const includeDependencyDB_t *db, const u32 recordIndex );
+
+// Returns the path with the given ID.
+const char							*IncludeDependencyDB_GetString( const includeDependencyDB_t *db, const u32 stringID );
+
+// Returns the path ID of the 'dependencyIndex'th include dependency of the given record.
+u32									IncludeDependencyDB_GetDependency( const includeDependencyDB_t *db, const includeDependencyRecord_t *record, const u32 dependencyIndex );
+
+// Replaces everything about the record at the given index with what it looks like after a successful compile.
+void								IncludeDependencyDB_SetRecord( includeDependencyDB_t *db, const u32 recordIndex, const char *sourceFilename, const char * const *dependencies, const u32 numDependencies, const u64 inputsHash, const u64 commandHash, const u32 compileTimeMS, const u32 peakMemoryMB );
+
+// Forgets the inputs hash of the record at the given index, so it always gets compiled again next time.
+void								IncludeDependencyDB_InvalidateRecord( includeDependencyDB_t *db, const u32 recordIndex );
+
+// Returns the hash of the link command the given binary was last linked with, or 0 if we don't know.
+u64									IncludeDependencyDB_GetLinkHash( const includeDependencyDB_t *db, const char *binaryFilename );
+
+// Remembers the hash of the link command the given binary was linked with.
+void								IncludeDependencyDB_SetLinkHash( includeDependencyDB_t *db, const char *binaryFilename, const u64 linkHash );
@@ -0,0 +1,419 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "job_pool.h"
+
+#include "temp_storage.h"
+#include "math.h"
+#include "debug.h"
+#include "typecast.h"
+
+#include <malloc.h>
+#include <string.h>
+
+/*
+================================================================================================
+
+	Job Pool
+
+================================================================================================
+*/
+
+struct job_t {
+	JobFunc			func;
+	void			*data;
+	jobCounter_t	*counter;
+};
+
+// ring buffer of jobs
+// the owner pushes and pops at the bottom, everyone else takes from the top
+// the jobs are way bigger than the time it takes to lock this, so a plain mutex is fine
+struct jobDeque_t {
+	mutex_t	mutex;
+	job_t	*jobs;
+	u32		capacity;	// always a power of 2
+	u32		top;
+	u32		count;
+};
+
+struct jobPool_t {
+	jobDeque_t	sharedQueue;
+	jobDeque_t	*workerDeques;
+	thread_t	*workers;
+	u32			maxWorkers;
+
+	// one signal for every job that gets queued, so a thread that takes a signal is guaranteed that theres a job for it somewhere
+	semaphore_t	jobsQueued;
+	atomic32_t	numJobsQueued;
+
+	// including jobs that threads waiting in JobPool_Wait() picked up
+	atomic32_t	numJobsRunning;
+
+	mutex_t		startWorkerMutex;
+	atomic32_t	numWorkersStarted;
+
+	atomic32_t	shutdown;
+};
+
+static jobPool_t				*g_jobPool = NULL;
+
+// -1 if this thread isnt one of the pool's workers
+static THREAD_LOCAL s32			g_jobPoolWorkerIndex = -1;
+
+static void JobDeque_Init( jobDeque_t *deque ) {
+	deque->mutex = Mutex_Create();
+	deque->capacity = 64;
+	deque->jobs = Cast( job_t *, malloc( deque->capacity * sizeof( job_t ) ) );
+	deque->top = 0;
+	deque->count = 0;
+}
+
+static void JobDeque_Destroy( jobDeque_t *deque ) {
+	Assert( deque->count == 0 );
+
+	free( deque->jobs );
+	deque->jobs = NULL;
+
+	Mutex_Destroy( &deque->mutex );
+}
+
+static void JobDeque_Push( jobDeque_t *deque, const job_t *job, const bool8 pushToTop ) {
+	Mutex_Lock( &deque->mutex );
+
+	if ( deque->count == deque->capacity ) {
+		u32 newCapacity = deque->capacity * 2;
+		job_t *newJobs = Cast( job_t *, malloc( newCapacity * sizeof( job_t ) ) );
+
+		For ( u32, jobIndex, 0, deque->count ) {
+			newJobs[jobIndex] = deque->jobs[( deque->top + jobIndex ) & ( deque->capacity - 1 )];
+		}
+
+		free( deque->jobs );
+
+		deque->jobs = newJobs;
+		deque->capacity = newCapacity;
+		deque->top = 0;
+	}
+
+	if ( pushToTop ) {
+		deque->top = ( deque->top - 1 ) & ( deque->capacity - 1 );
+		deque->jobs[deque->top] = *job;
+	} else {
+		deque->jobs[( deque->top + deque->count ) & ( deque->capacity - 1 )] = *job;
+	}
+
+	deque->count++;
+
+	Mutex_Unlock( &deque->mutex );
+}
+
+static bool8 JobDeque_Pop( jobDeque_t *deque, const bool8 popFromTop, job_t *outJob ) {
+	Mutex_Lock( &deque->mutex );
+
+	if ( deque->count == 0 ) {
+		Mutex_Unlock( &deque->mutex );
+		return false;
+	}
+
+	deque->count--;
+
+	if ( popFromTop ) {
+		*outJob = deque->jobs[deque->top];
+		deque->top = ( deque->top + 1 ) & ( deque->capacity - 1 );
+	} else {
+		*outJob = deque->jobs[( deque->top + deque->count ) & ( deque->capacity - 1 )];
+	}
+
+	Mutex_Unlock( &deque->mutex );
+
+	return true;
+}
+
+static void JobPool_RunJob( const job_t *job ) {
+	u64 marker = Mem_TempTell();
+
+	jobPool_t *pool = g_jobPool;
+
+	if ( pool ) {
+		Thread_AtomicIncrement( &pool->numJobsRunning );
+	}
+
+	job->func( job->data );
+
+	if ( pool ) {
+		Thread_AtomicAdd( &pool->numJobsRunning, U32_MAX );
+	}
+
+	Mem_TempRewindTo( marker );
+
+	// this has to be the very last thing we do with the counter, the thread waiting on it is allowed to destroy it as soon as this happens
+	if ( job->counter ) {
+		Semaphore_Signal( &job->counter->jobFinished );
+	}
+}
+
+// only call this after taking a signal from jobsQueued
+// returns false if theres nothing to take because the pool is shutting down
+static bool8 JobPool_TakeJob( jobPool_t *pool, job_t *outJob ) {
+	s32 workerIndex = g_jobPoolWorkerIndex;
+
+	while ( 1 ) {
+		// our own newest job first
+		if ( workerIndex != -1 && JobDeque_Pop( &pool->workerDeques[workerIndex], false, outJob ) ) {
+			break;
+		}
+
+		if ( JobDeque_Pop( &pool->sharedQueue, true, outJob ) ) {
+			break;
+		}
+
+		// then steal the oldest job off someone else
+		bool8 stole = false;
+
+		u32 numWorkers = Thread_AtomicLoad( &pool->numWorkersStarted );
+
+		For ( u32, i, 1, numWorkers + 1 ) {
+			u32 victimIndex = ( Cast( u32, workerIndex + 1 ) + i ) % numWorkers;
+
+			if ( Cast( s32, victimIndex ) == workerIndex ) {
+				continue;
+			}
+
+			if ( JobDeque_Pop( &pool->workerDeques[victimIndex], true, outJob ) ) {
+				stole = true;
+				break;
+			}
+		}
+
+		if ( stole ) {
+			break;
+		}
+
+		if ( Thread_AtomicLoad( &pool->shutdown ) ) {
+			return false;
+		}
+
+		// having a signal means theres a job somewhere, we just raced whoever put it there
+		// so go round again
+	}
+
+	Thread_AtomicAdd( &pool->numJobsQueued, U32_MAX );
+
+	return true;
+}
+
+static s32 JobPool_WorkerThread( void *data ) {
+	jobPool_t *pool = g_jobPool;
+
+	g_jobPoolWorkerIndex = TruncCast( s32, Cast( jobDeque_t *, data ) - pool->workerDeques );
+
+	while ( 1 ) {
+		Semaphore_Wait( &pool->jobsQueued );
+
+		job_t job;
+		if ( !JobPool_TakeJob( pool, &job ) ) {
+			break;
+		}
+
+		JobPool_RunJob( &job );
+	}
+
+	g_jobPoolWorkerIndex = -1;
+
+	return 0;
+}
+
+void JobPool_Init( const u32 maxWorkers ) {
+	Assert( !g_jobPool );
+	Assert( maxWorkers > 0 );
+
+	jobPool_t *pool = Cast( jobPool_t *, malloc( sizeof( jobPool_t ) ) );
+	memset( pool, 0, sizeof( jobPool_t ) );
+
+	JobDeque_Init( &pool->sharedQueue );
+
+	pool->maxWorkers = maxWorkers;
+	pool->workerDeques = Cast( jobDeque_t *, malloc( maxWorkers * sizeof( jobDeque_t ) ) );
+	pool->workers = Cast( thread_t *, malloc( maxWorkers * sizeof( thread_t ) ) );
+
+	For ( u32, workerIndex, 0, maxWorkers ) {
+		JobDeque_Init( &pool->workerDeques[workerIndex] );
+	}
+
+	pool->jobsQueued = Semaphore_Create( 0 );
+	pool->startWorkerMutex = Mutex_Create();
+
+	g_jobPool = pool;
+}
+
+void JobPool_Shutdown() {
+	jobPool_t *pool = g_jobPool;
+
+	if ( !pool ) {
+		return;
+	}
+
+	Assert( Thread_AtomicLoad( &pool->numJobsQueued ) == 0 );
+
+	Thread_AtomicStore( &pool->shutdown, 1 );
+
+	u32 numWorkers = Thread_AtomicLoad( &pool->numWorkersStarted );
+
+	Semaphore_Signal( &pool->jobsQueued, numWorkers );
+
+	For ( u32, workerIndex, 0, numWorkers ) {
+		Thread_Wait( &pool->workers[workerIndex] );
+		Thread_Destroy( &pool->workers[workerIndex] );
+	}
+
+	For ( u32, workerIndex, 0, pool->maxWorkers ) {
+		JobDeque_Destroy( &pool->workerDeques[workerIndex] );
+	}
+
+	JobDeque_Destroy( &pool->sharedQueue );
+
+	Mutex_Destroy( &pool->startWorkerMutex );
+	Semaphore_Destroy( &pool->jobsQueued );
+
+	free( pool->workers );
+	free( pool->workerDeques );
+	free( pool );
+
+	g_jobPool = NULL;
+}
+
+bool8 JobPool_IsRunning() {
+	return g_jobPool != NULL;
+}
+
+u32 JobPool_GetMaxConcurrentJobs() {
+	return g_jobPool ? g_jobPool->maxWorkers : 1;
+}
+
+u32 JobPool_GetNumJobsQueued() {
+	return g_jobPool ? Thread_AtomicLoad( &g_jobPool->numJobsQueued ) : 0;
+}
+
+u32 JobPool_GetNumJobsRunning() {
+	return g_jobPool ? Thread_AtomicLoad( &g_jobPool->numJobsRunning ) : 0;
+}
+
+void JobCounter_Init( jobCounter_t *counter ) {
+	Assert( counter );
+
+	counter->numJobsSubmitted.value = 0;
+	counter->jobFinished = Semaphore_Create( 0 );
+}
+
+void JobCounter_Destroy( jobCounter_t *counter ) {
+	Assert( counter );
+	Assert( Thread_AtomicLoad( &counter->numJobsSubmitted ) == 0 );
+
+	Semaphore_Destroy( &counter->jobFinished );
+}
+
+void JobPool_Submit( JobFunc func, void *data, jobCounter_t *counter, const jobPriority_t priority ) {
+	Assert( func );
+
+	job_t job = {
+		.func		= func,
+		.data		= data,
+		.counter	= counter,
+	};
+
+	if ( counter ) {
+		Thread_AtomicIncrement( &counter->numJobsSubmitted );
+	}
+
+	jobPool_t *pool = g_jobPool;
+
+	if ( !pool ) {
+		JobPool_RunJob( &job );
+		return;
+	}
+
+	s32 workerIndex = g_jobPoolWorkerIndex;
+
+	if ( workerIndex != -1 ) {
+		// high priority jobs go on the bottom too, thats the end we take from next
+		JobDeque_Push( &pool->workerDeques[workerIndex], &job, false );
+	} else {
+		JobDeque_Push( &pool->sharedQueue, &job, priority == JOB_PRIORITY_HIGH );
+	}
+
+	u32 numJobsQueued = Thread_AtomicIncrement( &pool->numJobsQueued );
+
+	Semaphore_Signal( &pool->jobsQueued );
+
+	// only start another worker if theres more work queued up than there are workers to take it
+	if ( Thread_AtomicLoad( &pool->numWorkersStarted ) < Min( pool->maxWorkers, numJobsQueued ) ) {
+		Mutex_Lock( &pool->startWorkerMutex );
+
+		u32 numWorkers = pool->numWorkersStarted.value;
+
+		if ( numWorkers < Min( pool->maxWorkers, numJobsQueued ) ) {
+			pool->workers[numWorkers] = Thread_Create( JobPool_WorkerThread, &pool->workerDeques[numWorkers] );
+
+			Thread_AtomicStore( &pool->numWorkersStarted, numWorkers + 1 );
+		}
+
+		Mutex_Unlock( &pool->startWorkerMutex );
+	}
+}
+
+void JobPool_Wait( jobCounter_t *counter ) {
+	Assert( counter );
+
+	jobPool_t *pool = g_jobPool;
+
+	// jobs can submit more jobs with the same counter, but they always do that before they finish
+	// so once every job we know about has finished, there can't be any more on the way
+	u32 numJobsFinished = 0;
+
+	while ( numJobsFinished < Thread_AtomicLoad( &counter->numJobsSubmitted ) ) {
+		if ( Semaphore_TryWait( &counter->jobFinished ) ) {
+			numJobsFinished++;
+			continue;
+		}
+
+		// rather than sit here doing nothing, help out with whatever else is queued
+		if ( pool && Semaphore_TryWait( &pool->jobsQueued ) ) {
+			job_t job;
+			if ( JobPool_TakeJob( pool, &job ) ) {
+				JobPool_RunJob( &job );
+			}
+
+			continue;
+		}
+
+		Semaphore_Wait( &counter->jobFinished );
+		numJobsFinished++;
+	}
+
+	Thread_AtomicStore( &counter->numJobsSubmitted, 0 );
+}
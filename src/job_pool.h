@@ -0,0 +1,105 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "thread.h"
+
+/*
+================================================================================================
+
+	Job Pool
+
+	One set of worker threads that lives for as long as Builder does, so every stage of the
+	build (globbing, compiling, linking, and so on) hands its work to the same threads instead
+	of starting and stopping its own.
+
+	Every worker has its own deque of jobs.  Jobs that a worker submits go on the bottom of its
+	own deque, and it takes its next job from the bottom too, so whatever it just made is still
+	hot in its cache.  Jobs submitted from any other thread (E.G. the main thread) go in one
+	shared queue.  A worker with nothing left in its own deque takes from the shared queue, and
+	if that's empty it steals from the top of another worker's deque.
+
+	Workers only get started once there's enough work queued up to need them, so something
+	like a no-op build never starts any.  Each worker keeps its temp storage for its whole life
+	and rewinds it after every job, so jobs can use temp storage freely.
+
+	If the pool isn't running then jobs just run straight away on the thread that submitted
+	them.
+
+================================================================================================
+*/
+
+typedef void ( *JobFunc )( void *data );
+
+enum jobPriority_t {
+	JOB_PRIORITY_NORMAL	= 0,
+	JOB_PRIORITY_HIGH,			// gets taken before anything else that's waiting
+};
+
+// Lets you wait for a group of jobs to finish.
+struct jobCounter_t {
+	atomic32_t	numJobsSubmitted;
+	semaphore_t	jobFinished;	// signalled once by every job when it finishes
+};
+
+// Starts the pool.  No worker threads actually get started until there are jobs for them.
+// 'maxWorkers' is the most worker threads the pool will ever have.
+void	JobPool_Init( const u32 maxWorkers );
+
+// Stops and waits for every worker thread.
+// Every job must have finished before calling this.
+void	JobPool_Shutdown();
+
+// Returns true if JobPool_Init() has been called and JobPool_Shutdown() hasn't been yet.
+bool8	JobPool_IsRunning();
+
+// Returns the most jobs that can ever run at the same time.
+// That's the 'maxWorkers' passed to JobPool_Init(), or 1 if the pool isn't running because then jobs run one at a time on whoever submits them.
+u32		JobPool_GetMaxConcurrentJobs();
+
+// Returns how many jobs are waiting for a thread to run them right now.
+// Only meant for reporting, it could have changed by the time you look at it.
+u32		JobPool_GetNumJobsQueued();
+
+// Returns how many jobs are running right now, on any thread.
+// Only meant for reporting, it could have changed by the time you look at it.
+u32		JobPool_GetNumJobsRunning();
+
+void	JobCounter_Init( jobCounter_t *counter );
+void	JobCounter_Destroy( jobCounter_t *counter );
+
+// Queues 'func' to run on a worker thread with 'data' passed through.
+// If 'counter' isn't NULL, the job counts towards it so JobPool_Wait() can wait for it.
+// Thread-safe, including from inside another job.
+void	JobPool_Submit( JobFunc func, void *data, jobCounter_t *counter, const jobPriority_t priority = JOB_PRIORITY_NORMAL );
+
+// Blocks until every job submitted with 'counter' has finished.
+// Runs other queued jobs on the calling thread while it waits rather than just sleeping.
+void	JobPool_Wait( jobCounter_t *counter );
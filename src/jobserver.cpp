@@ -0,0 +1,253 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "jobserver.h"
+
+#include "thread.h"
+#include "debug.h"
+#include "typecast.h"
+
+#include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+================================================================================================
+
+	Jobserver
+
+================================================================================================
+*/
+
+// how long to wait for a token before checking whether our implicit slot freed up in the meantime
+#define JOBSERVER_TAKE_TOKEN_TIMEOUT_MS	10
+
+struct jobserver_t {
+	jobserverMode_t	mode;
+
+	// the one slot every process gets without taking a token
+	atomic32_t		implicitTokenTaken;
+
+	// only if we made our own jobserver, so we can put MAKEFLAGS back how it was
+	char			*oldMakeflags;
+};
+
+static jobserver_t g_jobserver;
+
+bool8 Jobserver_ParseMakeflags( const char *makeflags, jobserverAuth_t *outAuth ) {
+	Assert( outAuth );
+
+	memset( outAuth, 0, sizeof( jobserverAuth_t ) );
+	outAuth->readFD = -1;
+	outAuth->writeFD = -1;
+
+	if ( !makeflags ) {
+		return false;
+	}
+
+	// older versions of make only know about --jobserver-fds
+	const char *options[] = {
+		"--jobserver-auth=",
+		"--jobserver-fds=",
+	};
+
+	const char *value = NULL;
+
+	For ( u64, optionIndex, 0, sizeof( options ) / sizeof( options[0] ) ) {
+		u64 optionLength = strlen( options[optionIndex] );
+
+		const char *found = strstr( makeflags, options[optionIndex] );
+
+		while ( found ) {
+			if ( !value || found + optionLength > value ) {
+				value = found + optionLength;
+			}
+
+			found = strstr( found + optionLength, options[optionIndex] );
+		}
+	}
+
+	if ( !value ) {
+		return false;
+	}
+
+	u64 valueLength = 0;
+	while ( value[valueLength] && value[valueLength] != ' ' && value[valueLength] != '\t' ) {
+		valueLength++;
+	}
+
+	if ( valueLength == 0 ) {
+		return false;
+	}
+
+	const char *fifoPrefix = "fifo:";
+	u64 fifoPrefixLength = strlen( fifoPrefix );
+
+	if ( valueLength > fifoPrefixLength && strncmp( value, fifoPrefix, fifoPrefixLength ) == 0 ) {
+		if ( valueLength - fifoPrefixLength >= sizeof( outAuth->name ) ) {
+			return false;
+		}
+
+		outAuth->type = JOBSERVER_AUTH_TYPE_FIFO;
+		memcpy( outAuth->name, value + fifoPrefixLength, valueLength - fifoPrefixLength );
+
+		return true;
+	}
+
+	s32 readFD = -1;
+	s32 writeFD = -1;
+	s32 numCharsRead = 0;
+
+	if ( sscanf( value, "%d,%d%n", &readFD, &writeFD, &numCharsRead ) == 2 && Cast( u64, numCharsRead ) == valueLength ) {
+		// make passes negative fds when it wants us to know theres a jobserver but not use it
+		if ( readFD < 0 || writeFD < 0 ) {
+			return false;
+		}
+
+		outAuth->type = JOBSERVER_AUTH_TYPE_PIPE;
+		outAuth->readFD = readFD;
+		outAuth->writeFD = writeFD;
+
+		return true;
+	}
+
+	if ( valueLength >= sizeof( outAuth->name ) ) {
+		return false;
+	}
+
+	outAuth->type = JOBSERVER_AUTH_TYPE_SEMAPHORE;
+	memcpy( outAuth->name, value, valueLength );
+
+	return true;
+}
+
+jobserverMode_t Jobserver_Init( const u32 numJobs ) {
+	Assert( g_jobserver.mode == JOBSERVER_MODE_NONE );
+	Assert( numJobs > 0 );
+
+	g_jobserver.implicitTokenTaken.value = 0;
+
+	const char *makeflags = getenv( "MAKEFLAGS" );
+
+	jobserverAuth_t auth;
+	if ( Jobserver_ParseMakeflags( makeflags, &auth ) ) {
+		if ( Jobserver_PlatformConnect( &auth ) ) {
+			g_jobserver.mode = JOBSERVER_MODE_CLIENT;
+			return g_jobserver.mode;
+		}
+
+		// make only lets us use its jobserver if the rule that ran us starts with a '+' or uses $(MAKE)
+		Warning( "MAKEFLAGS says there's a jobserver I should use but I can't get to it, so I'll run up to %u jobs at once by myself instead.  If make is running me, put a '+' at the start of the rule so make shares its jobserver with me.\n", numJobs );
+	}
+
+	char authArg[sizeof( auth.name ) + 32];
+	if ( !Jobserver_PlatformCreate( numJobs - 1, authArg, sizeof( authArg ) ) ) {
+		Warning( "Failed to create a jobserver.  Anything I run that wants to use one (like -flto=jobserver) won't be able to.  Error code: " ERROR_CODE_FORMAT "\n", GetLastErrorCode() );
+		return JOBSERVER_MODE_NONE;
+	}
+
+	// keep everything else that was in MAKEFLAGS, and put ours last so its the one that gets used
+	const char *jobserverFormat = "%s%s-j%u --jobserver-auth=%s";
+	const char *oldMakeflags = makeflags ? makeflags : "";
+	const char *separator = makeflags ? " " : "";
+
+	s32 newMakeflagsLength = snprintf( NULL, 0, jobserverFormat, oldMakeflags, separator, numJobs, authArg );
+
+	char *newMakeflags = Cast( char *, malloc( Cast( u64, newMakeflagsLength ) + 1 ) );
+	snprintf( newMakeflags, Cast( u64, newMakeflagsLength ) + 1, jobserverFormat, oldMakeflags, separator, numJobs, authArg );
+
+	if ( makeflags ) {
+		u64 oldMakeflagsLength = strlen( makeflags );
+
+		g_jobserver.oldMakeflags = Cast( char *, malloc( oldMakeflagsLength + 1 ) );
+		memcpy( g_jobserver.oldMakeflags, makeflags, oldMakeflagsLength + 1 );
+	}
+
+	Jobserver_PlatformSetMakeflags( newMakeflags );
+
+	free( newMakeflags );
+
+	g_jobserver.mode = JOBSERVER_MODE_SERVER;
+
+	return g_jobserver.mode;
+}
+
+void Jobserver_Shutdown() {
+	if ( g_jobserver.mode == JOBSERVER_MODE_NONE ) {
+		return;
+	}
+
+	Assert( Thread_AtomicLoad( &g_jobserver.implicitTokenTaken ) == 0 );
+
+	if ( g_jobserver.mode == JOBSERVER_MODE_SERVER ) {
+		Jobserver_PlatformSetMakeflags( g_jobserver.oldMakeflags );
+
+		free( g_jobserver.oldMakeflags );
+		g_jobserver.oldMakeflags = NULL;
+	}
+
+	Jobserver_PlatformDisconnect();
+
+	g_jobserver.mode = JOBSERVER_MODE_NONE;
+}
+
+jobserverToken_t Jobserver_AcquireToken() {
+	jobserverToken_t token = {
+		.isImplicit	= true,
+		.value		= 0,
+	};
+
+	if ( g_jobserver.mode == JOBSERVER_MODE_NONE ) {
+		return token;
+	}
+
+	while ( 1 ) {
+		if ( Thread_AtomicCompareExchange( &g_jobserver.implicitTokenTaken, 0, 1 ) == 0 ) {
+			return token;
+		}
+
+		// dont wait on the jobserver forever, if our implicit slot frees up in the meantime then use that instead
+		if ( Jobserver_PlatformTakeToken( JOBSERVER_TAKE_TOKEN_TIMEOUT_MS, &token.value ) ) {
+			token.isImplicit = false;
+			return token;
+		}
+	}
+}
+
+void Jobserver_ReleaseToken( const jobserverToken_t token ) {
+	if ( g_jobserver.mode == JOBSERVER_MODE_NONE ) {
+		return;
+	}
+
+	if ( token.isImplicit ) {
+		Thread_AtomicStore( &g_jobserver.implicitTokenTaken, 0 );
+	} else {
+		Jobserver_PlatformGiveToken( token.value );
+	}
+}
@@ -0,0 +1,124 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+
+/*
+================================================================================================
+
+	Jobserver
+
+	GNU make's way of sharing out how many things can run at once between every process in a
+	build (make itself, anything make runs, and anything those run, like a GCC LTO link with
+	-flto=jobserver).
+
+	Whoever started the build owns N slots.  N - 1 of those are single-byte tokens sitting in
+	a pipe (or a named semaphore on Windows), and every process also gets one implicit slot for
+	free.  To run one more thing at once you take a token, and you give it back when that
+	thing finishes.  Which jobserver to use gets passed down through the MAKEFLAGS environment
+	variable (--jobserver-auth=).
+
+	If we were started by something that already has a jobserver then we take our slots from
+	that.  Otherwise we make our own with however many slots we were told to use, and put it
+	in MAKEFLAGS so anything we run can share it with us too.
+
+================================================================================================
+*/
+
+enum jobserverMode_t {
+	JOBSERVER_MODE_NONE		= 0,	// theres no jobserver, so taking a slot never waits
+	JOBSERVER_MODE_SERVER,			// we made the jobserver
+	JOBSERVER_MODE_CLIENT,			// we're using the jobserver of whatever started us
+};
+
+enum jobserverAuthType_t {
+	JOBSERVER_AUTH_TYPE_NONE	= 0,
+	JOBSERVER_AUTH_TYPE_PIPE,		// --jobserver-auth=R,W (or --jobserver-fds=R,W on older versions of make)
+	JOBSERVER_AUTH_TYPE_FIFO,		// --jobserver-auth=fifo:PATH
+	JOBSERVER_AUTH_TYPE_SEMAPHORE,	// --jobserver-auth=NAME (Windows only)
+};
+
+// what MAKEFLAGS says about the jobserver we should use
+struct jobserverAuth_t {
+	jobserverAuthType_t	type;
+	s32					readFD;
+	s32					writeFD;
+	char				name[260];	// fifo path or semaphore name
+};
+
+struct jobserverToken_t {
+	bool8	isImplicit;
+	char	value;			// what we took from the jobserver, it has to go back exactly as it was
+};
+
+// Parses the jobserver out of the contents of a MAKEFLAGS environment variable.
+// If there's more than one, the last one wins (same as make).
+// Returns true if it found one, otherwise returns false.
+bool8				Jobserver_ParseMakeflags( const char *makeflags, jobserverAuth_t *outAuth );
+
+// If MAKEFLAGS says there's a jobserver we can use, connects to that.
+// Otherwise creates our own with 'numJobs' slots and adds it to MAKEFLAGS for everything we run.
+jobserverMode_t		Jobserver_Init( const u32 numJobs );
+
+// Disconnects from the jobserver (or destroys ours) and puts MAKEFLAGS back how it was.
+// Every token must have been given back before calling this.
+void				Jobserver_Shutdown();
+
+// Blocks until we're allowed to run one more thing at once.
+// Thread-safe.
+jobserverToken_t	Jobserver_AcquireToken();
+
+// Gives back a token from Jobserver_AcquireToken().
+// Thread-safe.
+void				Jobserver_ReleaseToken( const jobserverToken_t token );
+
+
+// Everything below is implemented per OS, and only the jobserver itself should need them.
+
+// Connects to the jobserver that 'auth' describes.
+// Returns true if it's usable, otherwise returns false.
+bool8				Jobserver_PlatformConnect( const jobserverAuth_t *auth );
+
+// Creates a jobserver with 'numTokens' tokens in it and writes what goes after --jobserver-auth= to 'outAuthArg'.
+// Returns true if successful, otherwise returns false.
+bool8				Jobserver_PlatformCreate( const u32 numTokens, char *outAuthArg, const u64 authArgSize );
+
+// Disconnects from the jobserver, or destroys it if we created it.
+void				Jobserver_PlatformDisconnect();
+
+// Takes one token, waiting for at most 'timeoutMS' for one to be free.
+// Returns true if it got one, otherwise returns false.
+bool8				Jobserver_PlatformTakeToken( const u32 timeoutMS, char *outValue );
+
+void				Jobserver_PlatformGiveToken( const char value );
+
+// Sets MAKEFLAGS for us and everything we run after this.
+// NULL removes it.
+void				Jobserver_PlatformSetMakeflags( const char *makeflags );
@@ -34,16 +34,25 @@ SOFTWARE.
 #include "../defer.h"
 #include "../string.h"
 #include "../temp_storage.h"
+#include "../math.h"
 
 #include <unistd.h>
 #include <fcntl.h>
+#include <malloc.h>
 
 #include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include <linux/fs.h>
 #include <dirent.h>
 #include <errno.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 
 /*
 ================================================================================================
@@ -53,6 +62,11 @@ SOFTWARE.
 ================================================================================================
 */
 
+// st_mtime only has second granularity, which is too coarse to tell apart files that get written in quick succession (like a .o and the binary that links it)
+static u64 FS_StatTimeToNanoseconds( const struct stat *fileStat ) {
+	return TruncCast( u64, fileStat->st_mtim.tv_sec ) * 1000000000ULL + TruncCast( u64, fileStat->st_mtim.tv_nsec );
+}
+
 static file_t FS_OpenFileInternal( const char *filename, int flags ) {
 	Assert( filename );
 
@@ -139,6 +153,143 @@ bool8 FS_DeleteFile( const char *filename ) {
 	return result == 0;
 }
 
+bool8 FS_RenameFile( const char *oldFilename, const char *newFilename ) {
+	Assert( oldFilename );
+	Assert( newFilename );
+
+	// rename() replaces the destination atomically, so anyone that still has the old file mapped keeps seeing the old contents
+	return rename( oldFilename, newFilename ) == 0;
+}
+
+bool8 FS_CloneFile( const char *filename, const char *newFilename ) {
+	Assert( filename );
+	Assert( newFilename );
+
+	int source = open( filename, O_RDONLY );
+	if ( source == -1 ) {
+		return false;
+	}
+	defer { close( source ); };
+
+	// keep the permissions too, the file could be an executable
+	struct stat sourceStat = {};
+	if ( fstat( source, &sourceStat ) != 0 ) {
+		return false;
+	}
+
+	int dest = open( newFilename, O_WRONLY | O_CREAT | O_EXCL, sourceStat.st_mode & 0777 );
+	if ( dest == -1 ) {
+		return false;
+	}
+
+	bool8 cloned = ioctl( dest, FICLONE, source ) == 0;
+
+	close( dest );
+
+	// most file systems (ext4 included) dont do reflinks, so dont leave an empty file behind
+	if ( !cloned ) {
+		unlink( newFilename );
+	}
+
+	return cloned;
+}
+
+bool8 FS_HardLinkFile( const char *filename, const char *newFilename ) {
+	Assert( filename );
+	Assert( newFilename );
+
+	return link( filename, newFilename ) == 0;
+}
+
+bool8 FS_CopyFile( const char *filename, const char *newFilename ) {
+	Assert( filename );
+	Assert( newFilename );
+
+	int source = open( filename, O_RDONLY );
+	if ( source == -1 ) {
+		return false;
+	}
+	defer { close( source ); };
+
+	struct stat sourceStat = {};
+	if ( fstat( source, &sourceStat ) != 0 ) {
+		return false;
+	}
+
+	int dest = open( newFilename, O_WRONLY | O_CREAT | O_TRUNC, sourceStat.st_mode & 0777 );
+	if ( dest == -1 ) {
+		return false;
+	}
+	defer { close( dest ); };
+
+	// sendfile() copies inside the kernel so the data never has to come through us
+	off_t offset = 0;
+	while ( offset < sourceStat.st_size ) {
+		ssize_t bytesCopied = sendfile( dest, source, &offset, TruncCast( size_t, sourceStat.st_size - offset ) );
+
+		if ( bytesCopied == -1 && errno == EINTR ) {
+			continue;
+		}
+
+		if ( bytesCopied <= 0 ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool8 FS_TouchFile( const char *filename ) {
+	Assert( filename );
+
+	// NULL means set both the access and modification times to now
+	return utimensat( AT_FDCWD, filename, NULL, 0 ) == 0;
+}
+
+bool8 FS_MapFile( const char *filename, fileMapping_t *outMapping ) {
+	Assert( filename );
+	Assert( outMapping );
+
+	int handle = open( filename, O_RDONLY );
+	if ( handle == -1 ) {
+		return false;
+	}
+
+	// the mapping keeps the file alive by itself
+	defer { close( handle ); };
+
+	struct stat fileStat = {};
+	if ( fstat( handle, &fileStat ) != 0 ) {
+		return false;
+	}
+
+	// mmap() refuses to map 0 bytes
+	if ( fileStat.st_size == 0 ) {
+		return false;
+	}
+
+	void *data = mmap( NULL, TruncCast( size_t, fileStat.st_size ), PROT_READ, MAP_PRIVATE, handle, 0 );
+	if ( data == MAP_FAILED ) {
+		return false;
+	}
+
+	outMapping->data = data;
+	outMapping->sizeBytes = TruncCast( u64, fileStat.st_size );
+	outMapping->handle = 0;
+
+	return true;
+}
+
+void FS_UnmapFile( fileMapping_t *mapping ) {
+	Assert( mapping );
+
+	if ( mapping->data ) {
+		munmap( const_cast<void *>( mapping->data ), mapping->sizeBytes );
+	}
+
+	*mapping = {};
+}
+
 bool8 FS_GetFileSize( const char *filename, u64 *outSize ) {
 	Assert( filename );
 	Assert( outSize );
@@ -162,11 +313,279 @@ bool8 FS_GetFileLastWriteTime( const char *filename, u64 *outLastWriteTime ) {
 		return false;
 	}
 
-	*outLastWriteTime = TruncCast( u64, fileStat.st_mtime );
+	*outLastWriteTime = FS_StatTimeToNanoseconds( &fileStat );
+
+	return true;
+}
+
+u64 FS_GetCurrentFileTime() {
+	struct timespec now = {};
+	clock_gettime( CLOCK_REALTIME, &now );
+
+	return TruncCast( u64, now.tv_sec ) * 1000000000ULL + TruncCast( u64, now.tv_nsec );
+}
+
+bool8 FS_GetFileStat( const char *filename, fileStat_t *outStat ) {
+	Assert( filename );
+	Assert( outStat );
+
+	struct stat fileStat = {};
+	if ( stat( filename, &fileStat ) != 0 ) {
+		return false;
+	}
+
+	outStat->fileID = TruncCast( u64, fileStat.st_ino );
+	outStat->sizeBytes = TruncCast( u64, fileStat.st_size );
+	outStat->lastWriteTime = FS_StatTimeToNanoseconds( &fileStat );
+
+	return true;
+}
+
+/*
+================================================================================================
+
+	Batched file stats via io_uring
+
+	Rather than doing one stat() syscall per file, we queue up a statx for every file in one
+	go and let the kernel get through them all with only a handful of syscalls.
+
+	We talk to io_uring with the raw syscalls rather than pulling in liburing, since this is
+	the only thing we use it for.
+
+================================================================================================
+*/
+
+struct ioUring_t {
+	int				fd;
+
+	void			*sqRing;
+	u64				sqRingSize;
+	void			*cqRing;
+	u64				cqRingSize;
+	io_uring_sqe	*sqes;
+	u64				sqesSize;
+
+	u32				*sqTail;
+	u32				*sqMask;
+	u32				*sqArray;
+
+	u32				*cqHead;
+	u32				*cqTail;
+	u32				*cqMask;
+	io_uring_cqe	*cqes;
+
+	u32				numEntries;
+};
+
+// not worth the cost of setting up a ring for anything less than this
+static const u32 IO_URING_MIN_BATCH_SIZE = 32;
+
+// io_uring is often unavailable (older kernels, or blocked by seccomp inside containers)
+// once we know that, stop asking for it every batch
+static bool8 g_ioUringUnavailable = false;
+
+static void IOUring_Destroy( ioUring_t *ring ) {
+	if ( ring->sqes ) {
+		munmap( ring->sqes, ring->sqesSize );
+	}
+
+	if ( ring->cqRing && ring->cqRing != ring->sqRing ) {
+		munmap( ring->cqRing, ring->cqRingSize );
+	}
+
+	if ( ring->sqRing ) {
+		munmap( ring->sqRing, ring->sqRingSize );
+	}
+
+	if ( ring->fd >= 0 ) {
+		close( ring->fd );
+	}
+
+	*ring = {};
+	ring->fd = -1;
+}
+
+static bool8 IOUring_Create( ioUring_t *ring, const u32 numEntries ) {
+	*ring = {};
+	ring->fd = -1;
+
+	io_uring_params params = {};
+
+	int fd = TruncCast( int, syscall( __NR_io_uring_setup, numEntries, &params ) );
+	if ( fd < 0 ) {
+		return false;
+	}
+
+	ring->fd = fd;
+	ring->numEntries = params.sq_entries;
+
+	ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof( u32 );
+	ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof( io_uring_cqe );
+
+	// newer kernels let us map both rings in one go
+	bool8 singleMap = ( params.features & IORING_FEAT_SINGLE_MMAP ) != 0;
+	if ( singleMap ) {
+		ring->sqRingSize = Max( ring->sqRingSize, ring->cqRingSize );
+		ring->cqRingSize = ring->sqRingSize;
+	}
+
+	ring->sqRing = mmap( NULL, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING );
+	if ( ring->sqRing == MAP_FAILED ) {
+		ring->sqRing = NULL;
+		IOUring_Destroy( ring );
+		return false;
+	}
+
+	if ( singleMap ) {
+		ring->cqRing = ring->sqRing;
+	} else {
+		ring->cqRing = mmap( NULL, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING );
+		if ( ring->cqRing == MAP_FAILED ) {
+			ring->cqRing = NULL;
+			IOUring_Destroy( ring );
+			return false;
+		}
+	}
+
+	ring->sqesSize = params.sq_entries * sizeof( io_uring_sqe );
+	ring->sqes = Cast( io_uring_sqe *, mmap( NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES ) );
+	if ( ring->sqes == MAP_FAILED ) {
+		ring->sqes = NULL;
+		IOUring_Destroy( ring );
+		return false;
+	}
+
+	u8 *sqRing = Cast( u8 *, ring->sqRing );
+	ring->sqTail  = Cast( u32 *, sqRing + params.sq_off.tail );
+	ring->sqMask  = Cast( u32 *, sqRing + params.sq_off.ring_mask );
+	ring->sqArray = Cast( u32 *, sqRing + params.sq_off.array );
+
+	u8 *cqRing = Cast( u8 *, ring->cqRing );
+	ring->cqHead = Cast( u32 *, cqRing + params.cq_off.head );
+	ring->cqTail = Cast( u32 *, cqRing + params.cq_off.tail );
+	ring->cqMask = Cast( u32 *, cqRing + params.cq_off.ring_mask );
+	ring->cqes   = Cast( io_uring_cqe *, cqRing + params.cq_off.cqes );
 
 	return true;
 }
 
+static void FS_StatxToFileStat( const struct statx *fileStatx, fileStat_t *outStat ) {
+	outStat->fileID = TruncCast( u64, fileStatx->stx_ino );
+	outStat->sizeBytes = TruncCast( u64, fileStatx->stx_size );
+	outStat->lastWriteTime = TruncCast( u64, fileStatx->stx_mtime.tv_sec ) * 1000000000ULL + TruncCast( u64, fileStatx->stx_mtime.tv_nsec );
+}
+
+// returns false if io_uring couldnt be used, in which case whatever got written to the outputs is meaningless
+static bool8 FS_GetFileStatsIOUring( const char * const *filenames, const u32 numFiles, fileStat_t *outStats, bool8 *outExists ) {
+	const u64 maxRingEntries = 1024;
+
+	ioUring_t ring;
+	if ( !IOUring_Create( &ring, TruncCast( u32, Min( NextPowerOf2Up( numFiles ), maxRingEntries ) ) ) ) {
+		return false;
+	}
+
+	defer { IOUring_Destroy( &ring ); };
+
+	struct statx *statxBuffers = Cast( struct statx *, malloc( ring.numEntries * sizeof( struct statx ) ) );
+	defer { free( statxBuffers ); };
+
+	const u32 statxMask = STATX_INO | STATX_SIZE | STATX_MTIME;
+
+	u32 firstFileIndex = 0;
+
+	// submit the files in rounds of however many the ring can hold, and wait for each round to finish before starting the next
+	// the statx buffers get reused each round, so nothing can still be in flight when we move on
+	while ( firstFileIndex < numFiles ) {
+		u32 numInRound = Min( ring.numEntries, numFiles - firstFileIndex );
+
+		u32 sqTail = *ring.sqTail;
+		u32 sqMask = *ring.sqMask;
+
+		For ( u32, roundIndex, 0, numInRound ) {
+			io_uring_sqe *sqe = &ring.sqes[roundIndex];
+			memset( sqe, 0, sizeof( io_uring_sqe ) );
+
+			sqe->opcode = IORING_OP_STATX;
+			sqe->fd = AT_FDCWD;
+			sqe->addr = Cast( u64, filenames[firstFileIndex + roundIndex] );
+			sqe->len = statxMask;
+			sqe->off = Cast( u64, &statxBuffers[roundIndex] );
+			sqe->user_data = roundIndex;
+
+			ring.sqArray[( sqTail + roundIndex ) & sqMask] = roundIndex;
+		}
+
+		// the kernel must see the filled out entries before it sees the new tail
+		__atomic_store_n( ring.sqTail, sqTail + numInRound, __ATOMIC_RELEASE );
+
+		u32 numToSubmit = numInRound;
+		u32 numCompleted = 0;
+
+		while ( numCompleted < numInRound ) {
+			long result = syscall( __NR_io_uring_enter, ring.fd, numToSubmit, 1, IORING_ENTER_GETEVENTS, NULL, 0 );
+
+			if ( result < 0 ) {
+				if ( errno == EINTR || errno == EAGAIN || errno == EBUSY ) {
+					continue;
+				}
+
+				// the ring is broken somehow, so let the caller redo the whole lot without it
+				// leak the statx buffers on purpose, the kernel could still be writing into them for anything that was already in flight
+				statxBuffers = NULL;
+				return false;
+			}
+
+			numToSubmit -= TruncCast( u32, result );
+
+			u32 cqHead = *ring.cqHead;
+			u32 cqTail = __atomic_load_n( ring.cqTail, __ATOMIC_ACQUIRE );
+			u32 cqMask = *ring.cqMask;
+
+			while ( cqHead != cqTail ) {
+				const io_uring_cqe *cqe = &ring.cqes[cqHead & cqMask];
+
+				u32 roundIndex = TruncCast( u32, cqe->user_data );
+				u32 fileIndex = firstFileIndex + roundIndex;
+
+				if ( cqe->res == 0 ) {
+					outExists[fileIndex] = true;
+					FS_StatxToFileStat( &statxBuffers[roundIndex], &outStats[fileIndex] );
+				} else if ( cqe->res == -EINVAL || cqe->res == -EOPNOTSUPP ) {
+					// the kernel has io_uring, but is too old to know about statx through it
+					outExists[fileIndex] = FS_GetFileStat( filenames[fileIndex], &outStats[fileIndex] );
+				} else {
+					outExists[fileIndex] = false;
+				}
+
+				cqHead++;
+				numCompleted++;
+			}
+
+			__atomic_store_n( ring.cqHead, cqHead, __ATOMIC_RELEASE );
+		}
+
+		firstFileIndex += numInRound;
+	}
+
+	return true;
+}
+
+void FS_GetFileStats( const char * const *filenames, const u32 numFiles, fileStat_t *outStats, bool8 *outExists ) {
+	Assert( filenames || numFiles == 0 );
+	Assert( outStats || numFiles == 0 );
+	Assert( outExists || numFiles == 0 );
+
+	if ( numFiles >= IO_URING_MIN_BATCH_SIZE && !g_ioUringUnavailable ) {
+		if ( FS_GetFileStatsIOUring( filenames, numFiles, outStats, outExists ) ) {
+			return;
+		}
+
+		g_ioUringUnavailable = true;
+	}
+
+	FS_GetFileStatsThreaded( filenames, numFiles, outStats, outExists );
+}
+
 bool8 FS_GetAllFilesInFolder( const char *path, const fileVisitFlags_t visitFlags, fileVisitCallback_t visitCallback, void *userData ) {
 	Assert( path );
 	Assert( visitCallback );
@@ -224,7 +643,7 @@ bool8 FS_GetAllFilesInFolder( const char *path, const fileVisitFlags_t visitFlag
 
 			fileInfo_t fileInfo = {
 				.sizeBytes			= TruncCast( u64, fileStat.st_size ),
-				.lastWriteTime	= TruncCast( u64, fileStat.st_mtime ),
+				.lastWriteTime	= FS_StatTimeToNanoseconds( &fileStat ),
 				.isDirectory		= isDirectory,
 				.filename			= entry->d_name,
 				.fullFilename		= fullFilename.data,
@@ -302,7 +721,7 @@ bool8 FS_DeleteFolder( const char *path ) {
 
 	if ( result != 0 ) {
 		int err = errno;
-		FatalError( "Failed to delete folder \"%s\": %s.\n", strerror( err ) );
+		FatalError( "Failed to delete folder \"%s\": %s.\n", path, strerror( err ) );
 	}
 
 	return result == 0;
@@ -0,0 +1,204 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#ifdef __linux__
+
+#include "../jobserver.h"
+
+#include "../debug.h"
+#include "../typecast.h"
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <errno.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+struct linuxJobserver_t {
+	// our own handle to the read end, so we can make it non-blocking without changing it for every other process that uses the jobserver
+	// otherwise if someone else takes a token between us seeing it and reading it then we'd block until another one turns up
+	s32		readFD;
+	s32		writeFD;
+
+	// only if we created the jobserver
+	// these are the ends that everything we run inherits
+	s32		pipeFDs[2];
+};
+
+static linuxJobserver_t g_linuxJobserver = {
+	.readFD		= -1,
+	.writeFD	= -1,
+	.pipeFDs	= { -1, -1 },
+};
+
+// returns a new file descriptor for the same pipe as 'fd' that doesnt share its flags
+static s32 ReopenFD( const s32 fd, const s32 flags ) {
+	char path[64];
+	snprintf( path, sizeof( path ), "/proc/self/fd/%d", fd );
+
+	return open( path, flags | O_CLOEXEC );
+}
+
+bool8 Jobserver_PlatformConnect( const jobserverAuth_t *auth ) {
+	Assert( auth );
+	Assert( g_linuxJobserver.readFD == -1 );
+
+	switch ( auth->type ) {
+		case JOBSERVER_AUTH_TYPE_PIPE: {
+			// make doesnt give the pipe to anything it doesnt think is part of the build, but it still leaves it in MAKEFLAGS
+			if ( fcntl( auth->readFD, F_GETFD ) == -1 || fcntl( auth->writeFD, F_GETFD ) == -1 ) {
+				return false;
+			}
+
+			s32 readFD = ReopenFD( auth->readFD, O_RDONLY | O_NONBLOCK );
+			if ( readFD == -1 ) {
+				return false;
+			}
+
+			g_linuxJobserver.readFD = readFD;
+			g_linuxJobserver.writeFD = auth->writeFD;
+
+			return true;
+		}
+
+		case JOBSERVER_AUTH_TYPE_FIFO: {
+			s32 fd = open( auth->name, O_RDWR | O_NONBLOCK | O_CLOEXEC );
+			if ( fd == -1 ) {
+				return false;
+			}
+
+			g_linuxJobserver.readFD = fd;
+			g_linuxJobserver.writeFD = fd;
+
+			return true;
+		}
+
+		case JOBSERVER_AUTH_TYPE_NONE:
+		case JOBSERVER_AUTH_TYPE_SEMAPHORE:
+			return false;
+	}
+
+	return false;
+}
+
+bool8 Jobserver_PlatformCreate( const u32 numTokens, char *outAuthArg, const u64 authArgSize ) {
+	Assert( outAuthArg );
+	Assert( g_linuxJobserver.readFD == -1 );
+
+	// everything we run needs to inherit both ends, so no O_CLOEXEC
+	s32 fds[2];
+	if ( pipe( fds ) == -1 ) {
+		return false;
+	}
+
+	// a pipe holds at least 64KB, so this cant block for any number of cores that exists today
+	For ( u32, tokenIndex, 0, numTokens ) {
+		char token = '+';
+		if ( write( fds[1], &token, 1 ) != 1 ) {
+			close( fds[0] );
+			close( fds[1] );
+			return false;
+		}
+	}
+
+	s32 readFD = ReopenFD( fds[0], O_RDONLY | O_NONBLOCK );
+	if ( readFD == -1 ) {
+		close( fds[0] );
+		close( fds[1] );
+		return false;
+	}
+
+	g_linuxJobserver.readFD = readFD;
+	g_linuxJobserver.writeFD = fds[1];
+	g_linuxJobserver.pipeFDs[0] = fds[0];
+	g_linuxJobserver.pipeFDs[1] = fds[1];
+
+	snprintf( outAuthArg, authArgSize, "%d,%d", fds[0], fds[1] );
+
+	return true;
+}
+
+void Jobserver_PlatformDisconnect() {
+	if ( g_linuxJobserver.readFD != -1 ) {
+		close( g_linuxJobserver.readFD );
+	}
+
+	For ( u32, pipeIndex, 0, 2 ) {
+		if ( g_linuxJobserver.pipeFDs[pipeIndex] != -1 ) {
+			close( g_linuxJobserver.pipeFDs[pipeIndex] );
+		}
+	}
+
+	// the write end belongs to whoever made the jobserver (or is one of the pipe fds we just closed)
+	g_linuxJobserver = {
+		.readFD		= -1,
+		.writeFD	= -1,
+		.pipeFDs	= { -1, -1 },
+	};
+}
+
+bool8 Jobserver_PlatformTakeToken( const u32 timeoutMS, char *outValue ) {
+	Assert( outValue );
+	Assert( g_linuxJobserver.readFD != -1 );
+
+	pollfd pollFD = {
+		.fd			= g_linuxJobserver.readFD,
+		.events		= POLLIN,
+		.revents	= 0,
+	};
+
+	if ( poll( &pollFD, 1, Cast( int, timeoutMS ) ) <= 0 ) {
+		return false;
+	}
+
+	// someone else could still beat us to it, in which case this just fails with EAGAIN
+	return read( g_linuxJobserver.readFD, outValue, 1 ) == 1;
+}
+
+void Jobserver_PlatformGiveToken( const char value ) {
+	Assert( g_linuxJobserver.writeFD != -1 );
+
+	while ( write( g_linuxJobserver.writeFD, &value, 1 ) != 1 ) {
+		if ( errno != EINTR && errno != EAGAIN ) {
+			Error( "Failed to give a token back to the jobserver.  Error code: " ERROR_CODE_FORMAT "\n", errno );
+			return;
+		}
+	}
+}
+
+void Jobserver_PlatformSetMakeflags( const char *makeflags ) {
+	if ( makeflags ) {
+		setenv( "MAKEFLAGS", makeflags, 1 );
+	} else {
+		unsetenv( "MAKEFLAGS" );
+	}
+}
+
+#endif // __linux__
@@ -32,6 +32,11 @@ SOFTWARE.
 #include "../typecast.h"
 
 #include <unistd.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
 
 u32	OS_GetVirtualMemoryPageSize() {
 	long pageSize = sysconf( _SC_PAGESIZE );
@@ -43,4 +48,78 @@ u32 OS_GetNumCpuCores() {
 	return TruncCast( u32, numCores );
 }
 
+float64 OS_GetProcessCPUTimeMS() {
+	struct rusage usage = {};
+	if ( getrusage( RUSAGE_SELF, &usage ) != 0 ) {
+		return 0.0;
+	}
+
+	return Cast( float64, usage.ru_utime.tv_sec + usage.ru_stime.tv_sec ) * 1000.0 + Cast( float64, usage.ru_utime.tv_usec + usage.ru_stime.tv_usec ) / 1000.0;
+}
+
+// reads a small /proc file into 'buffer' and null terminates it
+// returns false if the file couldnt be read
+static bool8 ReadProcFile( const char *filename, char *buffer, const u64 bufferSize ) {
+	int fd = open( filename, O_RDONLY | O_CLOEXEC );
+	if ( fd == -1 ) {
+		return false;
+	}
+
+	ssize_t numBytesRead = read( fd, buffer, bufferSize - 1 );
+	close( fd );
+
+	if ( numBytesRead <= 0 ) {
+		return false;
+	}
+
+	buffer[numBytesRead] = 0;
+
+	return true;
+}
+
+// returns the value in kB of the /proc/meminfo line that starts with 'key', or 0 if it isnt there
+static u64 GetMeminfoValue( const char *meminfo, const char *key ) {
+	const char *line = strstr( meminfo, key );
+	if ( !line ) {
+		return 0;
+	}
+
+	return strtoull( line + strlen( key ), NULL, 10 );
+}
+
+bool8 OS_GetMemoryStatus( memoryStatus_t *outStatus ) {
+	char buffer[4096];
+
+	if ( !ReadProcFile( "/proc/meminfo", buffer, sizeof( buffer ) ) ) {
+		return false;
+	}
+
+	u64 totalKB = GetMeminfoValue( buffer, "MemTotal:" );
+	u64 availableKB = GetMeminfoValue( buffer, "MemAvailable:" );
+
+	if ( totalKB == 0 ) {
+		return false;
+	}
+
+	// kernels older than 3.14 dont have MemAvailable, so guess at it
+	if ( availableKB == 0 ) {
+		availableKB = GetMeminfoValue( buffer, "MemFree:" ) + GetMeminfoValue( buffer, "Cached:" );
+	}
+
+	outStatus->totalBytes = totalKB * 1024;
+	outStatus->availableBytes = availableKB * 1024;
+	outStatus->pressure = 0.0f;
+
+	// PSI is only there on 4.20+ kernels built with CONFIG_PSI, and not always readable inside containers
+	// the first line looks like "some avg10=1.23 avg60=0.50 avg300=0.10 total=12345"
+	if ( ReadProcFile( "/proc/pressure/memory", buffer, sizeof( buffer ) ) ) {
+		const char *avg10 = strstr( buffer, "avg10=" );
+		if ( avg10 ) {
+			outStatus->pressure = strtof( avg10 + strlen( "avg10=" ), NULL ) / 100.0f;
+		}
+	}
+
+	return true;
+}
+
 #endif // __linux__
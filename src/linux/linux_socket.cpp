@@ -0,0 +1,296 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#ifdef __linux__
+
+#include "../socket.h"
+
+#include "../debug.h"
+#include "../typecast.h"
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include <stdio.h>
+#include <string.h>
+
+static void Socket_SetTimeout( const s32 fd, const u32 timeoutMS ) {
+	struct timeval timeout = {
+		.tv_sec		= timeoutMS / 1000,
+		.tv_usec	= ( timeoutMS % 1000 ) * 1000,
+	};
+
+	// connect() uses the send timeout too
+	setsockopt( fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof( timeout ) );
+	setsockopt( fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof( timeout ) );
+}
+
+bool8 Socket_Connect( const char *host, const u16 port, const u32 timeoutMS, socket_t *outSocket ) {
+	Assert( host );
+	Assert( outSocket );
+
+	outSocket->handle = -1;
+
+	char portString[8];
+	snprintf( portString, sizeof( portString ), "%u", port );
+
+	struct addrinfo hints = {};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+
+	struct addrinfo *addresses = NULL;
+	if ( getaddrinfo( host, portString, &hints, &addresses ) != 0 ) {
+		return false;
+	}
+
+	for ( struct addrinfo *address = addresses; address != NULL; address = address->ai_next ) {
+		// the compilers we run shouldnt inherit this
+		s32 fd = socket( address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol );
+		if ( fd == -1 ) {
+			continue;
+		}
+
+		if ( timeoutMS > 0 ) {
+			Socket_SetTimeout( fd, timeoutMS );
+		}
+
+		if ( connect( fd, address->ai_addr, address->ai_addrlen ) != 0 ) {
+			close( fd );
+			continue;
+		}
+
+		// requests are small and we want them out straight away, not sat waiting for the rest of a packet that isnt coming
+		s32 noDelay = 1;
+		setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof( noDelay ) );
+
+		outSocket->handle = fd;
+		break;
+	}
+
+	freeaddrinfo( addresses );
+
+	return outSocket->handle != -1;
+}
+
+// returns -1 if it couldnt bind to the address
+static s32 Socket_BindIPv6( const u16 port, const struct in6_addr *ipAddress ) {
+	s32 fd = socket( AF_INET6, SOCK_STREAM | SOCK_CLOEXEC, 0 );
+
+	if ( fd == -1 ) {
+		return -1;
+	}
+
+	// let IPv4 connections come in through it too
+	s32 off = 0;
+	setsockopt( fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof( off ) );
+
+	s32 on = 1;
+	setsockopt( fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof( on ) );
+
+	struct sockaddr_in6 address = {};
+	address.sin6_family = AF_INET6;
+	address.sin6_port = htons( port );
+	address.sin6_addr = *ipAddress;
+
+	if ( bind( fd, Cast( struct sockaddr *, &address ), sizeof( address ) ) != 0 ) {
+		close( fd );
+		return -1;
+	}
+
+	return fd;
+}
+
+// returns -1 if it couldnt bind to the address
+static s32 Socket_BindIPv4( const u16 port, const u32 ipAddress ) {
+	s32 fd = socket( AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0 );
+
+	if ( fd == -1 ) {
+		return -1;
+	}
+
+	s32 on = 1;
+	setsockopt( fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof( on ) );
+
+	struct sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons( port );
+	address.sin_addr.s_addr = htonl( ipAddress );
+
+	if ( bind( fd, Cast( struct sockaddr *, &address ), sizeof( address ) ) != 0 ) {
+		close( fd );
+		return -1;
+	}
+
+	return fd;
+}
+
+bool8 Socket_Listen( const u16 port, const bool8 allInterfaces, socket_t *outSocket ) {
+	Assert( outSocket );
+
+	outSocket->handle = -1;
+
+	s32 fd = -1;
+
+	if ( allInterfaces ) {
+		// try IPv6 first, with IPv4 connections coming in through it too, otherwise just IPv4
+		fd = Socket_BindIPv6( port, &in6addr_any );
+
+		if ( fd == -1 ) {
+			fd = Socket_BindIPv4( port, INADDR_ANY );
+		}
+	} else {
+		// the IPv6 loopback address doesnt take IPv4 connections, and most things still connect to localhost over IPv4 first
+		fd = Socket_BindIPv4( port, INADDR_LOOPBACK );
+
+		if ( fd == -1 ) {
+			fd = Socket_BindIPv6( port, &in6addr_loopback );
+		}
+	}
+
+	if ( fd == -1 ) {
+		return false;
+	}
+
+	if ( listen( fd, SOMAXCONN ) != 0 ) {
+		close( fd );
+		return false;
+	}
+
+	outSocket->handle = fd;
+
+	return true;
+}
+
+bool8 Socket_Accept( socket_t *listenSocket, socket_t *outSocket ) {
+	Assert( listenSocket );
+	Assert( outSocket );
+
+	outSocket->handle = -1;
+
+	while ( 1 ) {
+		s32 fd = accept4( TruncCast( s32, listenSocket->handle ), NULL, NULL, SOCK_CLOEXEC );
+
+		if ( fd != -1 ) {
+			s32 noDelay = 1;
+			setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof( noDelay ) );
+
+			outSocket->handle = fd;
+
+			return true;
+		}
+
+		// the client gave up before we got to it, thats not our problem
+		if ( errno == EINTR || errno == ECONNABORTED ) {
+			continue;
+		}
+
+		return false;
+	}
+}
+
+u16 Socket_GetPort( const socket_t *socket ) {
+	Assert( socket );
+
+	struct sockaddr_storage address = {};
+	socklen_t addressLength = sizeof( address );
+
+	if ( getsockname( TruncCast( s32, socket->handle ), Cast( struct sockaddr *, &address ), &addressLength ) != 0 ) {
+		return 0;
+	}
+
+	if ( address.ss_family == AF_INET6 ) {
+		return ntohs( ( Cast( struct sockaddr_in6 *, &address ) )->sin6_port );
+	}
+
+	return ntohs( ( Cast( struct sockaddr_in *, &address ) )->sin_port );
+}
+
+bool8 Socket_Send( socket_t *socket, const void *data, const u64 size ) {
+	Assert( socket );
+	Assert( data || size == 0 );
+
+	const u8 *current = Cast( const u8 *, data );
+	u64 bytesLeft = size;
+
+	while ( bytesLeft > 0 ) {
+		// MSG_NOSIGNAL because the other side hanging up shouldnt kill us with SIGPIPE
+		ssize_t bytesSent = send( TruncCast( s32, socket->handle ), current, bytesLeft, MSG_NOSIGNAL );
+
+		if ( bytesSent < 0 ) {
+			if ( errno == EINTR ) {
+				continue;
+			}
+
+			return false;
+		}
+
+		current += bytesSent;
+		bytesLeft -= Cast( u64, bytesSent );
+	}
+
+	return true;
+}
+
+s64 Socket_Receive( socket_t *socket, void *outBuffer, const u64 size ) {
+	Assert( socket );
+	Assert( outBuffer );
+
+	while ( 1 ) {
+		ssize_t bytesReceived = recv( TruncCast( s32, socket->handle ), outBuffer, size, 0 );
+
+		if ( bytesReceived < 0 && errno == EINTR ) {
+			continue;
+		}
+
+		return bytesReceived;
+	}
+}
+
+void Socket_Shutdown( socket_t *socket ) {
+	Assert( socket );
+
+	if ( socket->handle != -1 ) {
+		shutdown( TruncCast( s32, socket->handle ), SHUT_RDWR );
+	}
+}
+
+void Socket_Close( socket_t *socket ) {
+	Assert( socket );
+
+	if ( socket->handle != -1 ) {
+		close( TruncCast( s32, socket->handle ) );
+		socket->handle = -1;
+	}
+}
+
+#endif // __linux__
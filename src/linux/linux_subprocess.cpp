@@ -44,6 +44,7 @@ SOFTWARE.
 #include <spawn.h>
 #include <errno.h>
 #include <sys/wait.h>
+#include <sys/resource.h>
 
 /*
 ================================================================================================
@@ -59,6 +60,15 @@ struct process_t {
 	FILE	*stderr;
 };
 
+static void Proc_ClosePipe( int handles[2] ) {
+	For ( u32, handleIndex, 0, 2 ) {
+		if ( handles[handleIndex] != -1 ) {
+			close( handles[handleIndex] );
+			handles[handleIndex] = -1;
+		}
+	}
+}
+
 static bool8 Proc_CreatePipeWithFileActions( posix_spawn_file_actions_t *spawnActions, int fileno, int outHandles[2], const char *subprocessName ) {
 	if ( pipe( outHandles ) != 0 ) {
 		int err = errno;
@@ -87,7 +97,7 @@ static bool8 Proc_CreatePipeWithFileActions( posix_spawn_file_actions_t *spawnAc
 	return true;
 }
 
-process_t	*Proc_Create( linearAllocator_t *allocator, array_t<const char *> *args, array_t<const char *> *environmentVariables, const processFlags_t flags ) {
+process_t	*Proc_Create( linearAllocator_t *allocator, array_t<const char *> *args, array_t<const char *> *environmentVariables, const processFlags_t flags, const char *workingDirectory ) {
 	process_t *subprocess = Cast( process_t *, Mem_Alloc( allocator, sizeof( process_t ) ) );
 
 	const char *subprocessName = ( *args )[0];
@@ -108,12 +118,21 @@ process_t	*Proc_Create( linearAllocator_t *allocator, array_t<const char *> *arg
 	};
 
 	int stdoutFileHandles[2] = { -1, -1 };
+	int stderrFileHandles[2] = { -1, -1 };
+
+	// only needed if we leave before the process gets started, after that the process owns the write ends and the read ends get handed to the process_t
+	bool8 spawned = false;
+	defer {
+		if ( !spawned ) {
+			Proc_ClosePipe( stdoutFileHandles );
+			Proc_ClosePipe( stderrFileHandles );
+		}
+	};
+
 	if ( !Proc_CreatePipeWithFileActions( &spawnActions, STDOUT_FILENO, stdoutFileHandles, subprocessName ) ) {
 		return NULL;
 	}
 
-	int stderrFileHandles[2] = { -1, -1 };
-
 	if ( flags & PROCESS_FLAG_COMBINE_STDOUT_AND_STDERR ) {
 		if ( posix_spawn_file_actions_adddup2( &spawnActions, STDOUT_FILENO, STDERR_FILENO ) != 0 ) {
 			int err = errno;
@@ -126,6 +145,17 @@ process_t	*Proc_Create( linearAllocator_t *allocator, array_t<const char *> *arg
 		}
 	}
 
+	// the posix_spawn functions give back the error instead of setting errno
+	// not being able to use the working directory isnt fatal, the caller can always run things a different way
+	if ( workingDirectory ) {
+		int err = posix_spawn_file_actions_addchdir_np( &spawnActions, workingDirectory );
+
+		if ( err != 0 ) {
+			Error( "Failed to set the working directory of subprocess %s to \"%s\": %s\n", subprocessName, workingDirectory, strerror( err ) );
+			return NULL;
+		}
+	}
+
 	if ( ( *args )[args->count - 1] != NULL ) {
 		args->Add( NULL );
 	}
@@ -143,12 +173,21 @@ process_t	*Proc_Create( linearAllocator_t *allocator, array_t<const char *> *arg
 		envVarsStart = environ;
 	}
 
-	if ( posix_spawnp( &subprocess->pid, subprocessName, &spawnActions, NULL, argsStart, envVarsStart ) != 0 ) {
-		int err = errno;
-		FatalError( "Failed to spawn subprocess %s: %s\n", subprocessName, strerror( err ) );
+	int spawnResult = posix_spawnp( &subprocess->pid, subprocessName, &spawnActions, NULL, argsStart, envVarsStart );
+
+	if ( spawnResult != 0 ) {
+		// if the working directory doesnt exist then this is where we find out
+		if ( workingDirectory ) {
+			Error( "Failed to spawn subprocess %s in \"%s\": %s\n", subprocessName, workingDirectory, strerror( spawnResult ) );
+		} else {
+			FatalError( "Failed to spawn subprocess %s: %s\n", subprocessName, strerror( spawnResult ) );
+		}
+
 		return NULL;
 	}
 
+	spawned = true;
+
 	close( stdoutFileHandles[1] );
 	subprocess->stdout = fdopen( stdoutFileHandles[0], "rb" );
 
@@ -185,14 +224,25 @@ bool8		Proc_Destroy( process_t *process ) {
 	return true;
 }
 
-s32		Proc_Join( process_t *process ) {
+s32		Proc_Join( process_t *process, u64 *outPeakMemoryBytes, float64 *outCPUTimeMS ) {
 	int status = -1;
-	if ( waitpid( process->pid, &status, 0 ) != process->pid ) {
+	struct rusage usage = {};
+	if ( wait4( process->pid, &status, 0, &usage ) != process->pid ) {
 		int err = errno;
 		FatalError( "Failed to wait for process to finish: %s\n", strerror( err ) );
 		return -1;
 	}
 
+	// this is already the biggest out of the process and every child it waited on (E.G. gcc running cc1plus)
+	if ( outPeakMemoryBytes ) {
+		*outPeakMemoryBytes = Cast( u64, usage.ru_maxrss ) * 1024;
+	}
+
+	// same for this, it includes every child it waited on
+	if ( outCPUTimeMS ) {
+		*outCPUTimeMS = Cast( float64, usage.ru_utime.tv_sec + usage.ru_stime.tv_sec ) * 1000.0 + Cast( float64, usage.ru_utime.tv_usec + usage.ru_stime.tv_usec ) / 1000.0;
+	}
+
 	if ( WIFEXITED( status ) ) {
 		return WEXITSTATUS( status );
 	} else {
@@ -37,7 +37,9 @@ SOFTWARE.
 #include "../linear_allocator.h"
 
 #include <pthread.h>
+#include <semaphore.h>
 #include <errno.h>
+#include <time.h>
 
 #include <string.h>
 #include <malloc.h>
@@ -127,6 +129,118 @@ s32		Thread_Wait( thread_t *thread ) {
 	return TruncCast( s32, exitCode2 );
 }
 
+void Thread_Sleep( const u32 milliseconds ) {
+	struct timespec duration = {
+		.tv_sec = milliseconds / 1000,
+		.tv_nsec = Cast( long, milliseconds % 1000 ) * 1000000,
+	};
+
+	// keep sleeping for whatever is left if a signal woke us up early
+	while ( nanosleep( &duration, &duration ) == -1 && errno == EINTR ) {
+	}
+}
+
+mutex_t Mutex_Create() {
+	pthread_mutex_t *mutexLinux = Cast( pthread_mutex_t *, malloc( sizeof( pthread_mutex_t ) ) );
+
+	if ( pthread_mutex_init( mutexLinux, NULL ) != 0 ) {
+		int err = errno;
+		FatalError( "Failed to create mutex: %s\n", strerror( err ) );
+
+		free( mutexLinux );
+
+		return { NULL };
+	}
+
+	return { mutexLinux };
+}
+
+void Mutex_Destroy( mutex_t *mutex ) {
+	Assert( mutex );
+
+	pthread_mutex_t *mutexLinux = Cast( pthread_mutex_t *, mutex->ptr );
+
+	if ( mutexLinux ) {
+		pthread_mutex_destroy( mutexLinux );
+		free( mutexLinux );
+
+		mutex->ptr = NULL;
+	}
+}
+
+void Mutex_Lock( mutex_t *mutex ) {
+	Assert( mutex );
+	Assert( mutex->ptr );
+
+	pthread_mutex_lock( Cast( pthread_mutex_t *, mutex->ptr ) );
+}
+
+void Mutex_Unlock( mutex_t *mutex ) {
+	Assert( mutex );
+	Assert( mutex->ptr );
+
+	pthread_mutex_unlock( Cast( pthread_mutex_t *, mutex->ptr ) );
+}
+
+semaphore_t Semaphore_Create( const u32 initialCount ) {
+	sem_t *semaphoreLinux = Cast( sem_t *, malloc( sizeof( sem_t ) ) );
+
+	if ( sem_init( semaphoreLinux, 0, initialCount ) != 0 ) {
+		int err = errno;
+		FatalError( "Failed to create semaphore: %s\n", strerror( err ) );
+
+		free( semaphoreLinux );
+
+		return { NULL };
+	}
+
+	return { semaphoreLinux };
+}
+
+void Semaphore_Destroy( semaphore_t *semaphore ) {
+	Assert( semaphore );
+
+	sem_t *semaphoreLinux = Cast( sem_t *, semaphore->ptr );
+
+	if ( semaphoreLinux ) {
+		sem_destroy( semaphoreLinux );
+		free( semaphoreLinux );
+
+		semaphore->ptr = NULL;
+	}
+}
+
+void Semaphore_Signal( semaphore_t *semaphore, const u32 count ) {
+	Assert( semaphore );
+	Assert( semaphore->ptr );
+
+	For ( u32, i, 0, count ) {
+		sem_post( Cast( sem_t *, semaphore->ptr ) );
+	}
+}
+
+void Semaphore_Wait( semaphore_t *semaphore ) {
+	Assert( semaphore );
+	Assert( semaphore->ptr );
+
+	// sem_wait can get woken up early by signals, in which case we still havent got anything so just go back to waiting
+	while ( sem_wait( Cast( sem_t *, semaphore->ptr ) ) != 0 && errno == EINTR ) {
+	}
+}
+
+bool8 Semaphore_TryWait( semaphore_t *semaphore ) {
+	Assert( semaphore );
+	Assert( semaphore->ptr );
+
+	while ( sem_trywait( Cast( sem_t *, semaphore->ptr ) ) != 0 ) {
+		if ( errno != EINTR ) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 #pragma clang diagnostic push
 // TOOD: DM: 04/05/2026: this warning means we are imposing "stronger memory barriers than necessary", but I think we definitely need them?
 // the whole point of doing an "atomic" operation is to guarantee syncronization of values between threads in order to safely avoid race conditions, which is exactly what these intrinsics offer
@@ -138,6 +252,41 @@ u32		Thread_AtomicIncrement( atomic32_t *atomic ) {
 	return __sync_add_and_fetch( &atomic->value, 1 );
 }
 
+u32		Thread_AtomicAdd( atomic32_t *atomic, const u32 value ) {
+	Assert( atomic );
+	return __sync_add_and_fetch( &atomic->value, value );
+}
+
+u32		Thread_AtomicCompareExchange( atomic32_t *atomic, const u32 expected, const u32 desired ) {
+	Assert( atomic );
+	return __sync_val_compare_and_swap( &atomic->value, expected, desired );
+}
+
+u64		Thread_AtomicCompareExchange( atomic64_t *atomic, const u64 expected, const u64 desired ) {
+	Assert( atomic );
+	return __sync_val_compare_and_swap( &atomic->value, expected, desired );
+}
+
+u32		Thread_AtomicLoad( const atomic32_t *atomic ) {
+	Assert( atomic );
+	return __atomic_load_n( &atomic->value, __ATOMIC_ACQUIRE );
+}
+
+u64		Thread_AtomicLoad( const atomic64_t *atomic ) {
+	Assert( atomic );
+	return __atomic_load_n( &atomic->value, __ATOMIC_ACQUIRE );
+}
+
+void	Thread_AtomicStore( atomic32_t *atomic, const u32 value ) {
+	Assert( atomic );
+	__atomic_store_n( &atomic->value, value, __ATOMIC_RELEASE );
+}
+
+void	Thread_AtomicStore( atomic64_t *atomic, const u64 value ) {
+	Assert( atomic );
+	__atomic_store_n( &atomic->value, value, __ATOMIC_RELEASE );
+}
+
 #pragma clang diagnostic pop
 
 #endif
@@ -0,0 +1,178 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "memory_throttle.h"
+
+#include "os.h"
+#include "debug.h"
+#include "defer.h"
+
+/*
+================================================================================================
+
+	Memory throttle
+
+================================================================================================
+*/
+
+// if more than this fraction of the last 10 seconds was spent with something stalled waiting on memory then we're under pressure
+// see /proc/pressure/memory
+#define MEMORY_THROTTLE_PRESSURE_LIMIT		0.1f
+
+// how long a held back job sleeps before looking at the machine's memory again
+#define MEMORY_THROTTLE_POLL_INTERVAL_MS	50
+
+void MemoryThrottle_Init( memoryThrottle_t *throttle, const memoryStatus_t *status ) {
+	Assert( throttle );
+
+	*throttle = {
+		.mutex		= Mutex_Create(),
+		.enabled	= status != NULL,
+	};
+
+	if ( !status ) {
+		return;
+	}
+
+	// leave some memory for everything else on the machine
+	throttle->headroomBytes = status->totalBytes / 10;
+
+	throttle->budgetBytes = ( status->availableBytes > throttle->headroomBytes ) ? status->availableBytes - throttle->headroomBytes : 0;
+}
+
+void MemoryThrottle_Shutdown( memoryThrottle_t *throttle ) {
+	Assert( throttle );
+	Assert( throttle->numRunningJobs == 0 );
+	Assert( throttle->reservedBytes == 0 );
+
+	Mutex_Destroy( &throttle->mutex );
+}
+
+bool8 MemoryThrottle_IsHog( const memoryThrottle_t *throttle, const u64 predictedPeakBytes ) {
+	Assert( throttle );
+
+	// two of these at once would use up at least half of everything we're allowed
+	return predictedPeakBytes > throttle->budgetBytes / 4;
+}
+
+bool8 MemoryThrottle_TryAdmit( memoryThrottle_t *throttle, const u64 predictedPeakBytes, const memoryStatus_t *status ) {
+	Assert( throttle );
+
+	if ( !throttle->enabled ) {
+		return true;
+	}
+
+	bool8 isHog = MemoryThrottle_IsHog( throttle, predictedPeakBytes );
+
+	Mutex_Lock( &throttle->mutex );
+	defer { Mutex_Unlock( &throttle->mutex ); };
+
+	// if nothing is running then nothing will free any memory up for us, so waiting wont help
+	if ( throttle->numRunningJobs > 0 ) {
+		if ( status ) {
+			if ( status->pressure > MEMORY_THROTTLE_PRESSURE_LIMIT ) {
+				return false;
+			}
+
+			if ( status->availableBytes < throttle->headroomBytes + predictedPeakBytes ) {
+				return false;
+			}
+		}
+
+		if ( throttle->reservedBytes + predictedPeakBytes > throttle->budgetBytes ) {
+			return false;
+		}
+
+		if ( isHog && throttle->numRunningHogs > 0 ) {
+			return false;
+		}
+	}
+
+	throttle->reservedBytes += predictedPeakBytes;
+	throttle->numRunningJobs++;
+
+	if ( isHog ) {
+		throttle->numRunningHogs++;
+	}
+
+	return true;
+}
+
+void MemoryThrottle_Admit( memoryThrottle_t *throttle, const u64 predictedPeakBytes ) {
+	Assert( throttle );
+
+	if ( !throttle->enabled ) {
+		return;
+	}
+
+	bool8 heldBack = false;
+
+	while ( 1 ) {
+		memoryStatus_t status;
+		bool8 gotStatus = OS_GetMemoryStatus( &status );
+
+		if ( MemoryThrottle_TryAdmit( throttle, predictedPeakBytes, gotStatus ? &status : NULL ) ) {
+			break;
+		}
+
+		if ( !heldBack ) {
+			heldBack = true;
+
+			Mutex_Lock( &throttle->mutex );
+			throttle->numJobsHeldBack++;
+			Mutex_Unlock( &throttle->mutex );
+		}
+
+		// whatever is running now will free its memory when it finishes, and PSI only changes over time
+		// so theres nothing better to wake up on than just checking again a bit later
+		Thread_Sleep( MEMORY_THROTTLE_POLL_INTERVAL_MS );
+	}
+}
+
+void MemoryThrottle_Release( memoryThrottle_t *throttle, const u64 predictedPeakBytes ) {
+	Assert( throttle );
+
+	if ( !throttle->enabled ) {
+		return;
+	}
+
+	Mutex_Lock( &throttle->mutex );
+
+	Assert( throttle->numRunningJobs > 0 );
+	Assert( throttle->reservedBytes >= predictedPeakBytes );
+
+	throttle->reservedBytes -= predictedPeakBytes;
+	throttle->numRunningJobs--;
+
+	if ( MemoryThrottle_IsHog( throttle, predictedPeakBytes ) ) {
+		Assert( throttle->numRunningHogs > 0 );
+		throttle->numRunningHogs--;
+	}
+
+	Mutex_Unlock( &throttle->mutex );
+}
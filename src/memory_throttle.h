@@ -0,0 +1,101 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "thread.h"
+
+struct memoryStatus_t;
+
+/*
+================================================================================================
+
+	Memory throttle
+
+	Stops too many compile jobs running at once when the machine is running out of memory.
+	Running one compiler per core is fine until a few of the heaviest translation units all
+	land at the same time and the OOM killer starts picking off compilers.
+
+	Every compile job says up front how much memory it thinks it will need (from how much it
+	actually used the last time it compiled, see includeDependencyRecord_t::peakMemoryMB).
+	A job only gets to start if:
+
+	- nothing else is running (so the build can always make progress), or
+	- the machine isnt under memory pressure right now, and
+	- everything that's running plus this job still fits in the memory we had when the build
+	  started, and
+	- it isnt a memory hog while another memory hog is already running.
+
+	Otherwise it waits until one of those changes.
+
+================================================================================================
+*/
+
+struct memoryThrottle_t {
+	mutex_t		mutex;
+	bool8		enabled;
+
+	// if less than this is available then we're under pressure
+	u64			headroomBytes;
+
+	// how much memory all the jobs running at once are allowed to need between them
+	u64			budgetBytes;
+
+	u64			reservedBytes;
+	u32			numRunningJobs;
+	u32			numRunningHogs;
+
+	// how many jobs had to wait at least once before they could start
+	u32			numJobsHeldBack;
+};
+
+// 'status' is what the machine's memory looks like right now.
+// If 'status' is NULL then the throttle is disabled and lets every job straight through.
+void	MemoryThrottle_Init( memoryThrottle_t *throttle, const memoryStatus_t *status );
+
+// Every job must have been released before calling this.
+void	MemoryThrottle_Shutdown( memoryThrottle_t *throttle );
+
+// Returns true if a job that needs 'predictedPeakBytes' is big enough that it should never run alongside another one like it.
+bool8	MemoryThrottle_IsHog( const memoryThrottle_t *throttle, const u64 predictedPeakBytes );
+
+// If a job that needs 'predictedPeakBytes' is allowed to start given the memory 'status' then reserves its memory and returns true.
+// Otherwise returns false straight away.
+// 'status' can be NULL if the OS couldnt tell us, in which case only the reservations are checked.
+// Thread-safe.
+bool8	MemoryThrottle_TryAdmit( memoryThrottle_t *throttle, const u64 predictedPeakBytes, const memoryStatus_t *status );
+
+// Blocks until a job that needs 'predictedPeakBytes' is allowed to start, then reserves its memory.
+// Thread-safe.
+void	MemoryThrottle_Admit( memoryThrottle_t *throttle, const u64 predictedPeakBytes );
+
+// Gives back what MemoryThrottle_Admit() or MemoryThrottle_TryAdmit() reserved once the job finishes.
+// 'predictedPeakBytes' must be the same value the job was admitted with.
+// Thread-safe.
+void	MemoryThrottle_Release( memoryThrottle_t *throttle, const u64 predictedPeakBytes );
@@ -0,0 +1,295 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "module_scanner.h"
+
+#include "file.h"
+#include "string.h"
+#include "array.inl"
+#include "typecast.h"
+#include "defer.h"
+
+#include <string.h>
+
+/*
+================================================================================================
+
+	C++20 module scanner
+
+================================================================================================
+*/
+
+static const char *SkipSpaces( const char *current, const char *end ) {
+	while ( current < end && ( *current == ' ' || *current == '\t' ) ) {
+		current += 1;
+	}
+
+	return current;
+}
+
+// module names are identifiers separated by dots, like "engine.render"
+static const char *ReadModuleName( const char *current, const char *end ) {
+	while ( current < end && ( String_IsIdentifierChar( *current ) || *current == '.' ) ) {
+		current += 1;
+	}
+
+	return current;
+}
+
+// the declaration only counts if it ends with a semicolon (attributes can go before it)
+// anything else means the line wasnt a module declaration or an import after all, like "module = 3;"
+static bool8 EndsDeclaration( const char *current, const char *end ) {
+	current = SkipSpaces( current, end );
+
+	return current < end && ( *current == ';' || *current == '[' );
+}
+
+static void AddImportedModule( moduleScan_t *scan, const char *name ) {
+	For ( u64, importIndex, 0, scan->importedModules.count ) {
+		if ( strcmp( scan->importedModules[importIndex], name ) == 0 ) {
+			return;
+		}
+	}
+
+	scan->importedModules.Add( name );
+}
+
+// skips over a string or character literal, starting at the opening quote
+static const char *SkipLiteral( const char *current, const char *end ) {
+	char quote = *current;
+	current += 1;
+
+	while ( current < end && *current != quote && *current != '\n' ) {
+		if ( *current == '\\' ) {
+			current += 1;
+		}
+
+		current += 1;
+	}
+
+	return ( current < end ) ? current + 1 : end;
+}
+
+// skips over a raw string literal, starting at the opening quote
+// these can have anything in them, including lines that start with "import"
+static const char *SkipRawStringLiteral( const char *current, const char *end ) {
+	const char *delimiterStart = current + 1;
+	const char *delimiterEnd = delimiterStart;
+
+	while ( delimiterEnd < end && *delimiterEnd != '(' && *delimiterEnd != '\n' ) {
+		delimiterEnd += 1;
+	}
+
+	if ( delimiterEnd >= end || *delimiterEnd != '(' ) {
+		return SkipLiteral( current, end );
+	}
+
+	u64 delimiterLength = Cast( u64, delimiterEnd - delimiterStart );
+
+	for ( current = delimiterEnd + 1; current < end; current++ ) {
+		if ( *current == ')' && Cast( u64, end - current ) > delimiterLength + 1 && strncmp( current + 1, delimiterStart, delimiterLength ) == 0 && current[delimiterLength + 1] == '"' ) {
+			return current + delimiterLength + 2;
+		}
+	}
+
+	return end;
+}
+
+void ModuleScanner_Scan( const char *code, const u64 length, linearAllocator_t *allocator, moduleScan_t *outScan ) {
+	outScan->exportedModule = NULL;
+	outScan->importedModules.Init( allocator );
+
+	// the module this source file is part of, so "import :part;" knows whose partition it is
+	string_t currentModule = {};
+
+	const char *current = code;
+	const char *end = code + length;
+
+	bool8 atLineStart = true;
+
+	while ( current < end ) {
+		char c = *current;
+
+		if ( c == '\n' ) {
+			atLineStart = true;
+			current += 1;
+			continue;
+		}
+
+		if ( c == ' ' || c == '\t' || c == '\r' ) {
+			current += 1;
+			continue;
+		}
+
+		// comments dont stop the next thing from being at the start of the line
+		if ( c == '/' && current + 1 < end && current[1] == '/' ) {
+			while ( current < end && *current != '\n' ) {
+				current += 1;
+			}
+
+			continue;
+		}
+
+		if ( c == '/' && current + 1 < end && current[1] == '*' ) {
+			const char *commentEnd = strstr( current + 2, "*/" );
+			current = ( commentEnd && commentEnd < end ) ? commentEnd + 2 : end;
+			continue;
+		}
+
+		// preprocessor directives go until the end of the line, including any lines they continue onto
+		if ( c == '#' && atLineStart ) {
+			while ( current < end && *current != '\n' ) {
+				if ( *current == '\\' && current + 1 < end && ( current[1] == '\n' || current[1] == '\r' ) ) {
+					current += ( current[1] == '\r' && current + 2 < end && current[2] == '\n' ) ? 3 : 2;
+					continue;
+				}
+
+				current += 1;
+			}
+
+			continue;
+		}
+
+		if ( c == '"' || c == '\'' ) {
+			current = SkipLiteral( current, end );
+			atLineStart = false;
+			continue;
+		}
+
+		if ( !String_IsIdentifierChar( c ) ) {
+			current += 1;
+			atLineStart = false;
+			continue;
+		}
+
+		const char *identifier = current;
+		while ( current < end && String_IsIdentifierChar( *current ) ) {
+			current += 1;
+		}
+
+		u64 identifierLength = Cast( u64, current - identifier );
+
+		// R"(...)", u8R"(...)" and so on
+		if ( current < end && *current == '"' && identifier[identifierLength - 1] == 'R' ) {
+			current = SkipRawStringLiteral( current, end );
+			atLineStart = false;
+			continue;
+		}
+
+		if ( !atLineStart ) {
+			continue;
+		}
+
+		atLineStart = false;
+
+		bool8 exported = false;
+
+		if ( identifierLength == 6 && strncmp( identifier, "export", 6 ) == 0 ) {
+			exported = true;
+
+			current = SkipSpaces( current, end );
+
+			identifier = current;
+			while ( current < end && String_IsIdentifierChar( *current ) ) {
+				current += 1;
+			}
+
+			identifierLength = Cast( u64, current - identifier );
+		}
+
+		if ( identifierLength == 6 && strncmp( identifier, "module", 6 ) == 0 ) {
+			const char *nameStart = SkipSpaces( current, end );
+			const char *nameEnd = ReadModuleName( nameStart, end );
+
+			// "module;" starts the global module fragment and "module :private;" starts the private one, neither of those are a name
+			if ( nameEnd == nameStart ) {
+				continue;
+			}
+
+			const char *partitionEnd = nameEnd;
+			if ( partitionEnd < end && *partitionEnd == ':' ) {
+				partitionEnd = ReadModuleName( partitionEnd + 1, end );
+			}
+
+			if ( !EndsDeclaration( partitionEnd, end ) ) {
+				continue;
+			}
+
+			currentModule = String_Set( nameStart, Cast( u64, nameEnd - nameStart ) );
+
+			const char *name = String_Printf( allocator, "%.*s", Cast( int, partitionEnd - nameStart ), nameStart ).data;
+
+			// a module implementation unit needs the interface of the module its implementing
+			if ( exported || partitionEnd != nameEnd ) {
+				outScan->exportedModule = name;
+			} else {
+				AddImportedModule( outScan, name );
+			}
+
+			current = partitionEnd;
+		} else if ( identifierLength == 6 && strncmp( identifier, "import", 6 ) == 0 ) {
+			const char *nameStart = SkipSpaces( current, end );
+
+			if ( nameStart < end && *nameStart == ':' ) {
+				const char *partitionEnd = ReadModuleName( nameStart + 1, end );
+
+				if ( currentModule.count == 0 || partitionEnd == nameStart + 1 || !EndsDeclaration( partitionEnd, end ) ) {
+					continue;
+				}
+
+				AddImportedModule( outScan, String_Printf( allocator, "%.*s%.*s", Cast( int, currentModule.count ), currentModule.data, Cast( int, partitionEnd - nameStart ), nameStart ).data );
+
+				current = partitionEnd;
+			} else {
+				// header units start with < or ", so they dont have a name and get skipped here
+				const char *nameEnd = ReadModuleName( nameStart, end );
+
+				if ( nameEnd == nameStart || !EndsDeclaration( nameEnd, end ) ) {
+					continue;
+				}
+
+				AddImportedModule( outScan, String_Printf( allocator, "%.*s", Cast( int, nameEnd - nameStart ), nameStart ).data );
+
+				current = nameEnd;
+			}
+		}
+	}
+}
+
+bool8 ModuleScanner_ScanFile( const char *filename, linearAllocator_t *allocator, moduleScan_t *outScan ) {
+	string_t contents = {};
+	if ( !FS_ReadEntireFile( filename, &contents ) ) {
+		return false;
+	}
+
+	defer { FS_FreeFileBuffer( &contents ); };
+
+	ModuleScanner_Scan( contents.data, contents.count, allocator, outScan );
+
+	return true;
+}
@@ -0,0 +1,75 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "array.h"
+
+struct linearAllocator_t;
+
+/*
+================================================================================================
+
+	C++20 module scanner
+
+	A source file that imports a module can't compile until the source file that exports it
+	has, because compiling that one is what makes the module's compiled interface (its "BMI"),
+	which is what the compiler reads instead of the module's source code.  So before anything
+	compiles, every source file gets scanned for the module it exports and the modules it
+	imports, and that tells the build what order they have to go in.
+
+	The scan doesn't run the preprocessor.  It doesn't need to, because the standard says a
+	module declaration or an import has to be at the start of a line, and can't come out of a
+	macro.  So it only looks at lines that start with "module", "export module", "import" or
+	"export import", and skips comments.  That means one inside an #if that's turned off
+	still counts.
+
+	Partitions get their full name, so "import :part;" inside module "foo" imports "foo:part".
+	A module implementation unit ("module foo;") counts as importing "foo".  Header units
+	("import <vector>;") get ignored, those aren't supported.
+
+================================================================================================
+*/
+
+struct moduleScan_t {
+	// NULL if the source file doesnt export a module
+	// partitions count as exporting a module too, because other source files import them by name
+	const char				*exportedModule;
+
+	// every module the source file imports directly, each one only once
+	array_t<const char *>	importedModules;
+};
+
+// Scans 'length' bytes of source code for the module it exports and the modules it imports.
+// The names in 'outScan' get allocated from 'allocator'.
+void	ModuleScanner_Scan( const char *code, const u64 length, linearAllocator_t *allocator, moduleScan_t *outScan );
+
+// Same as ModuleScanner_Scan(), but reads the source code from 'filename' first.
+// Returns false if the file couldn't be read.
+bool8	ModuleScanner_ScanFile( const char *filename, linearAllocator_t *allocator, moduleScan_t *outScan );
@@ -33,3 +33,20 @@ u32	OS_GetVirtualMemoryPageSize();
 
 // Returns the total number of cores that the CPU has, including hyperthreads.
 u32	OS_GetNumCpuCores();
+
+// Returns how much CPU time (user and kernel, across every thread) this process has used so far.
+// Doesn't include any processes it ran.
+float64	OS_GetProcessCPUTimeMS();
+
+struct memoryStatus_t {
+	u64		totalBytes;
+	u64		availableBytes;
+
+	// fraction of recent wall time that at least one task was stalled waiting on memory (0 to 1)
+	// 0 if the OS doesnt report this
+	float32	pressure;
+};
+
+// Fills out how much physical memory the machine has and how much of it can still be used without swapping.
+// Returns false if the OS couldnt tell us.
+bool8	OS_GetMemoryStatus( memoryStatus_t *outStatus );
@@ -0,0 +1,513 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "pch_advisor.h"
+
+#include "builder_local.h"
+#include "include_dependency_db.h"
+#include "header_impact.h"
+#include "file.h"
+#include "hash.h"
+#include "hashmap.h"
+#include "linear_allocator.h"
+#include "temp_storage.h"
+#include "paths.h"
+#include "string.h"
+#include "string_builder.h"
+#include "array.inl"
+#include "typecast.h"
+#include "debug.h"
+#include "defer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+================================================================================================
+
+	Precompiled header advisor
+
+================================================================================================
+*/
+
+// roughly how much of what it costs to parse a header it costs to load it out of a precompiled header instead
+#define PCH_LOAD_COST_FRACTION			0.1
+
+// how many headers the report lists before it just says how many more there are
+#define PCH_REPORT_MAX_HEADERS			20
+
+// a header has to have been written at least this long after most of the config's files to count as recently changed
+// so that all the files a checkout or a branch switch wrote at once dont count
+#define PCH_RECENTLY_CHANGED_MIN_SECONDS	( 60 * 60 )
+
+// headers that are never candidates, so that we dont keep looking at their paths
+#define PCH_HEADER_INDEX_IGNORED		0xFFFFFFFE
+
+// folders that hold headers that are only meant to be included by other headers
+static const char *g_internalHeaderFolders[] = {
+	"bits",
+	"detail",
+	"details",
+	"internal",
+	"impl",
+};
+
+static bool8 IsInternalHeader( const char *filename ) {
+	const char *folderStart = filename;
+
+	for ( const char *c = filename; *c; c++ ) {
+		if ( *c != '/' && *c != '\\' ) {
+			continue;
+		}
+
+		u64 folderLength = Cast( u64, c - folderStart );
+
+		For ( u64, folderIndex, 0, COUNT_OF( g_internalHeaderFolders ) ) {
+			const char *internalFolder = g_internalHeaderFolders[folderIndex];
+
+			if ( strlen( internalFolder ) == folderLength && strncmp( folderStart, internalFolder, folderLength ) == 0 ) {
+				return true;
+			}
+		}
+
+		folderStart = c + 1;
+	}
+
+	return false;
+}
+
+// most savings first
+// ties go in the order the headers first showed up in, so the order is always the same
+static int CompareHeadersBySavings( const void *a, const void *b ) {
+	const pchHeader_t *headerA = Cast( const pchHeader_t *, a );
+	const pchHeader_t *headerB = Cast( const pchHeader_t *, b );
+
+	if ( headerA->savingsMS != headerB->savingsMS ) return ( headerA->savingsMS > headerB->savingsMS ) ? -1 : 1;
+
+	return ( headerA->order < headerB->order ) ? -1 : ( headerA->order > headerB->order ) ? 1 : 0;
+}
+
+static int CompareFileTimes( const void *a, const void *b ) {
+	u64 timeA = *Cast( const u64 *, a );
+	u64 timeB = *Cast( const u64 *, b );
+
+	return ( timeA < timeB ) ? -1 : ( timeA > timeB ) ? 1 : 0;
+}
+
+static int CompareHeadersByOrder( const void *a, const void *b ) {
+	const pchHeader_t *headerA = *Cast( const pchHeader_t * const *, a );
+	const pchHeader_t *headerB = *Cast( const pchHeader_t * const *, b );
+
+	return ( headerA->order < headerB->order ) ? -1 : ( headerA->order > headerB->order ) ? 1 : 0;
+}
+
+static bool8 IsIgnoredHeader( const char *filename, const char * const *ignoreHeaders, const u32 numIgnoreHeaders ) {
+	For ( u32, ignoreIndex, 0, numIgnoreHeaders ) {
+		if ( String_Equals( filename, ignoreHeaders[ignoreIndex] ) ) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// returns 0 if the header doesnt exist or we dont know
+static u32 GetNumCommits( const hashmap_t *commitCounts, const char *filename ) {
+	if ( !commitCounts ) {
+		return 0;
+	}
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	// the commit counts have the real path of each file, which is only different if theres a symlink in the way
+	string_t absolutePath = Path_AbsolutePath( Mem_GetTempStorage(), filename );
+	u32 numCommits = HM_GetValue( commitCounts, HeaderImpact_HashPath( String_Cstr( &absolutePath ) ) );
+
+	return ( numCommits == HASHMAP_INVALID_VALUE ) ? 0 : numCommits;
+}
+
+void PCHAdvisor_Analyse( const includeDependencyDB_t *db, const char * const *intermediateFilenames, const u32 numSourceFiles, const char * const *ignoreHeaders, const u32 numIgnoreHeaders, const pchHistory_t *history, linearAllocator_t *allocator, pchAdvice_t *outAdvice ) {
+	Assert( db );
+	Assert( intermediateFilenames || numSourceFiles == 0 );
+	Assert( ignoreHeaders || numIgnoreHeaders == 0 );
+	Assert( outAdvice );
+
+	pchHistory_t noHistory = {};
+	if ( !history ) {
+		history = &noHistory;
+	}
+
+	// keyed by the hash of the filename, the value doesnt matter
+	hashmap_t *previousSelection = HM_Create( allocator, TruncCast( u32, Max( Cast( u64, history->numPreviousSelection ) * 2, 64ULL ) ) );
+	For ( u32, selectionIndex, 0, history->numPreviousSelection ) {
+		HM_SetValue( previousSelection, HashString( history->previousSelection[selectionIndex], 0 ), 1 );
+	}
+
+	*outAdvice = {};
+	outAdvice->headers.Init( allocator );
+	outAdvice->numSourceFiles = numSourceFiles;
+
+	// only the source files that compiled successfully last time know what they include
+	array_t<const includeDependencyRecord_t *> records;
+	records.Init( allocator );
+
+	For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+		u32 recordIndex = IncludeDependencyDB_FindRecord( db, intermediateFilenames[sourceFileIndex] );
+
+		if ( recordIndex == INCLUDE_DEPENDENCY_DB_INVALID_INDEX ) {
+			continue;
+		}
+
+		const includeDependencyRecord_t *record = IncludeDependencyDB_GetRecord( db, recordIndex );
+
+		if ( record->inputsHash == 0 ) {
+			continue;
+		}
+
+		records.Add( record );
+	}
+
+	outAdvice->numSourceFilesCompiled = TruncCast( u32, records.count );
+
+	// find every header they include, and how many of them include it
+	// keyed by path ID + 1, because a key of 0 means an empty bucket
+	hashmap_t *headerIndices = HM_Create( allocator, 1024 );
+
+	array_t<pchHeader_t> &headers = outAdvice->headers;
+
+	// the same header can be in a source file's include list more than once, so only count it once per source file
+	array_t<u32> lastRecordIndices;
+	lastRecordIndices.Init( allocator );
+
+	For ( u64, recordIndex, 0, records.count ) {
+		const includeDependencyRecord_t *record = records[recordIndex];
+
+		For ( u32, dependencyIndex, 0, record->numDependencies ) {
+			u32 stringID = IncludeDependencyDB_GetDependency( db, record, dependencyIndex );
+
+			u32 headerIndex = HM_GetValue( headerIndices, Cast( u64, stringID ) + 1 );
+
+			if ( headerIndex == HASHMAP_INVALID_VALUE ) {
+				const char *filename = IncludeDependencyDB_GetString( db, stringID );
+
+				if ( FileIsSourceFile( filename ) || IsIgnoredHeader( filename, ignoreHeaders, numIgnoreHeaders ) ) {
+					headerIndex = PCH_HEADER_INDEX_IGNORED;
+				} else {
+					headerIndex = TruncCast( u32, headers.count );
+
+					headers.Add( {
+						.filename	= filename,
+						.order		= headerIndex,
+					} );
+
+					lastRecordIndices.Add( U32_MAX );
+				}
+
+				HM_SetValue( headerIndices, Cast( u64, stringID ) + 1, headerIndex );
+			}
+
+			if ( headerIndex == PCH_HEADER_INDEX_IGNORED || lastRecordIndices[headerIndex] == recordIndex ) {
+				continue;
+			}
+
+			headers[headerIndex].numSourceFiles++;
+			lastRecordIndices[headerIndex] = TruncCast( u32, recordIndex );
+		}
+	}
+
+	// get the size and last write time of every header and source file in one go
+	u64 numFiles = headers.count + records.count;
+
+	const char **filenames = Cast( const char **, Mem_Alloc( allocator, Max( numFiles, 1ULL ) * sizeof( const char * ) ) );
+	fileStat_t *fileStats = Cast( fileStat_t *, Mem_Alloc( allocator, Max( numFiles, 1ULL ) * sizeof( fileStat_t ) ) );
+	bool8 *filesExist = Cast( bool8 *, Mem_Alloc( allocator, Max( numFiles, 1ULL ) * sizeof( bool8 ) ) );
+
+	For ( u64, headerIndex, 0, headers.count ) {
+		filenames[headerIndex] = headers[headerIndex].filename;
+	}
+
+	For ( u64, recordIndex, 0, records.count ) {
+		filenames[headers.count + recordIndex] = IncludeDependencyDB_GetString( db, records[recordIndex]->filenameID );
+	}
+
+	FS_GetFileStats( filenames, TruncCast( u32, numFiles ), fileStats, filesExist );
+
+	// a fresh checkout writes every file at once, which doesnt mean anyone is working on them
+	// so a header only counts as recently changed if it was also written after most of the other files were
+	u64 typicalLastWriteTime = 0;
+	{
+		array_t<u64> lastWriteTimes;
+		lastWriteTimes.Init( allocator );
+
+		For ( u64, fileIndex, 0, numFiles ) {
+			if ( filesExist[fileIndex] ) {
+				lastWriteTimes.Add( fileStats[fileIndex].lastWriteTime );
+			}
+		}
+
+		if ( lastWriteTimes.count > 0 ) {
+			qsort( lastWriteTimes.data, lastWriteTimes.count, sizeof( u64 ), CompareFileTimes );
+
+			typicalLastWriteTime = lastWriteTimes[lastWriteTimes.count / 2];
+		}
+	}
+
+	For ( u64, headerIndex, 0, headers.count ) {
+		pchHeader_t *header = &headers[headerIndex];
+
+		u64 lastWriteTime = fileStats[headerIndex].lastWriteTime;
+
+		// a header that doesnt exist anymore is about as recently changed as it gets
+		header->sizeBytes = filesExist[headerIndex] ? fileStats[headerIndex].sizeBytes : 0;
+		header->recentlyChanged = !filesExist[headerIndex] || ( lastWriteTime > history->recentlyChangedTime && lastWriteTime > typicalLastWriteTime + PCH_RECENTLY_CHANGED_MIN_SECONDS * FILE_TIME_UNITS_PER_SECOND );
+		header->previouslySelected = HM_GetValue( previousSelection, HashString( header->filename, 0 ) ) != HASHMAP_INVALID_VALUE;
+		header->internal = IsInternalHeader( header->filename );
+	}
+
+	// work out what compiling one byte costs from the source files we know the compile time of
+	float64 timedCompileTimeMS = 0.0;
+	u64 timedBytes = 0;
+
+	For ( u64, recordIndex, 0, records.count ) {
+		const includeDependencyRecord_t *record = records[recordIndex];
+
+		outAdvice->compileTimeMS += record->compileTimeMS;
+
+		if ( record->compileTimeMS == 0 ) {
+			continue;
+		}
+
+		u64 sourceFileStatIndex = headers.count + recordIndex;
+
+		u64 bytes = filesExist[sourceFileStatIndex] ? fileStats[sourceFileStatIndex].sizeBytes : 0;
+
+		For ( u32, dependencyIndex, 0, record->numDependencies ) {
+			u32 headerIndex = HM_GetValue( headerIndices, Cast( u64, IncludeDependencyDB_GetDependency( db, record, dependencyIndex ) ) + 1 );
+
+			if ( headerIndex < headers.count ) {
+				bytes += headers[headerIndex].sizeBytes;
+			}
+		}
+
+		timedCompileTimeMS += record->compileTimeMS;
+		timedBytes += bytes;
+	}
+
+	float64 msPerByte = ( timedBytes > 0 ) ? timedCompileTimeMS / Cast( float64, timedBytes ) : 0.0;
+
+	// see the top of pch_advisor.h
+	float64 numSourceFilesCompiled = Cast( float64, records.count );
+
+	For ( u64, headerIndex, 0, headers.count ) {
+		pchHeader_t *header = &headers[headerIndex];
+
+		float64 numIncluding = Cast( float64, header->numSourceFiles );
+		float64 numNotIncluding = numSourceFilesCompiled - numIncluding;
+
+		float64 parsesSaved = ( numIncluding - 1.0 ) - ( numNotIncluding * PCH_LOAD_COST_FRACTION );
+
+		header->savingsMS = parsesSaved * Cast( float64, header->sizeBytes ) * msPerByte;
+		header->worthPrecompiling = header->numSourceFiles >= 2 && parsesSaved > 0.0;
+
+		// looking up the commits means finding the real path of the header, so only bother for the ones that could go in
+		bool8 exists = filesExist[headerIndex];
+
+		if ( header->worthPrecompiling && exists ) {
+			header->numCommits = GetNumCommits( history->commitCounts, header->filename );
+			header->changesOften = history->commitCounts && header->numCommits > history->maxCommits;
+		}
+
+		header->selected = header->worthPrecompiling && exists && !header->changesOften && ( header->previouslySelected || !header->recentlyChanged );
+
+		if ( header->selected ) {
+			outAdvice->numSelected++;
+			outAdvice->savingsMS += header->savingsMS;
+		}
+	}
+
+	qsort( headers.data, headers.count, sizeof( pchHeader_t ), CompareHeadersBySavings );
+}
+
+const char *PCHAdvisor_GetHeaderContents( const pchAdvice_t *advice, linearAllocator_t *allocator ) {
+	Assert( advice );
+
+	array_t<const pchHeader_t *> includes;
+	includes.Init( allocator );
+
+	For ( u64, headerIndex, 0, advice->headers.count ) {
+		const pchHeader_t *header = &advice->headers[headerIndex];
+
+		if ( header->selected && !header->internal ) {
+			includes.Add( header );
+		}
+	}
+
+	if ( includes.count == 0 ) {
+		return NULL;
+	}
+
+	qsort( includes.data, includes.count, sizeof( const pchHeader_t * ), CompareHeadersByOrder );
+
+	stringBuilder_t builder = SB_Create( allocator );
+
+	SB_Appendf( &builder, "// Generated by Builder from the headers this config's source files include the most (see BuildConfig::automaticPrecompiledHeader).\n" );
+	SB_Appendf( &builder, "// Don't edit this, it gets rewritten whenever the headers that go in it change.\n\n" );
+	SB_Appendf( &builder, "#pragma once\n\n" );
+
+	For ( u64, includeIndex, 0, includes.count ) {
+		SB_Appendf( &builder, "#include \"%s\"\n", includes[includeIndex]->filename );
+	}
+
+	return SB_ToString( &builder );
+}
+
+const char *PCHAdvisor_GetSelection( const pchAdvice_t *advice, linearAllocator_t *allocator ) {
+	Assert( advice );
+
+	stringBuilder_t builder = SB_Create( allocator );
+
+	// internal headers count too, so that they dont look like new candidates next time
+	For ( u64, headerIndex, 0, advice->headers.count ) {
+		const pchHeader_t *header = &advice->headers[headerIndex];
+
+		if ( header->selected ) {
+			SB_Appendf( &builder, "%s\n", header->filename );
+		}
+	}
+
+	return SB_ToString( &builder );
+}
+
+void PCHAdvisor_ParseSelection( char *selection, array_t<const char *> *outHeaders ) {
+	Assert( selection );
+	Assert( outHeaders );
+
+	char *line = selection;
+
+	while ( *line ) {
+		char *lineEnd = line;
+		while ( *lineEnd && *lineEnd != '\n' && *lineEnd != '\r' ) {
+			lineEnd += 1;
+		}
+
+		bool8 lastLine = *lineEnd == 0;
+
+		*lineEnd = 0;
+
+		if ( lineEnd > line ) {
+			outHeaders->Add( line );
+		}
+
+		if ( lastLine ) {
+			break;
+		}
+
+		line = lineEnd + 1;
+	}
+}
+
+static void PrintHeaders( const pchAdvice_t *advice, const bool8 leftOut ) {
+	u32 numPrinted = 0;
+	u32 numLeft = 0;
+
+	printf( "        %-12s %10s %10s  %s\n", "Included by", "Size (KB)", "Saves (ms)", "Header" );
+
+	For ( u64, headerIndex, 0, advice->headers.count ) {
+		const pchHeader_t *header = &advice->headers[headerIndex];
+
+		bool8 listed = leftOut ? ( header->worthPrecompiling && !header->selected ) : header->selected;
+
+		if ( !listed ) {
+			continue;
+		}
+
+		if ( numPrinted == PCH_REPORT_MAX_HEADERS ) {
+			numLeft++;
+			continue;
+		}
+
+		const char *numSourceFiles = TempPrintf( "%u/%u", header->numSourceFiles, advice->numSourceFilesCompiled );
+
+		const char *note = "";
+		if ( leftOut ) {
+			note = header->changesOften ? TempPrintf( " (changed in %u recent commits)", header->numCommits ) : " (changed recently)";
+		} else if ( header->internal ) {
+			note = " (comes with the header that includes it)";
+		}
+
+		printf( "        %-12s %10.1f %10.0f  %s%s\n", numSourceFiles, Cast( float64, header->sizeBytes ) / 1024.0, header->savingsMS, header->filename, note );
+
+		numPrinted++;
+	}
+
+	if ( numLeft > 0 ) {
+		printf( "        ...and %u more.\n", numLeft );
+	}
+}
+
+void PCHAdvisor_PrintReport( const pchAdvice_t *advice, const char *configName ) {
+	Assert( advice );
+
+	printf( "Precompiled header report for config \"%s\":\n", configName );
+
+	if ( advice->numSourceFilesCompiled == 0 ) {
+		printf( "    None of its source files have compiled yet, so there's nothing to go on.  Build it first.\n\n" );
+		return;
+	}
+
+	printf( "    %u of %u source files compiled last time, which took %.0f ms in total.\n\n", advice->numSourceFilesCompiled, advice->numSourceFiles, advice->compileTimeMS );
+
+	if ( advice->numSelected == 0 ) {
+		printf( "    None of the headers they include are worth precompiling.\n\n" );
+		return;
+	}
+
+	printf( "    These %u headers would go in the precompiled header:\n", advice->numSelected );
+	PrintHeaders( advice, false );
+
+	bool8 anyLeftOut = false;
+	For ( u64, headerIndex, 0, advice->headers.count ) {
+		if ( advice->headers[headerIndex].worthPrecompiling && !advice->headers[headerIndex].selected ) {
+			anyLeftOut = true;
+			break;
+		}
+	}
+
+	if ( anyLeftOut ) {
+		printf( "\n    These would be worth it too, but they're left out because they change too much:\n" );
+		PrintHeaders( advice, true );
+	}
+
+	if ( advice->compileTimeMS > 0.0 ) {
+		printf( "\n    Expected saving: %.0f ms per full rebuild (%.0f%%).\n\n", advice->savingsMS, ( advice->savingsMS / advice->compileTimeMS ) * 100.0 );
+	} else {
+		printf( "\n    Expected saving: unknown, none of the source files have a compile time yet.\n\n" );
+	}
+}
@@ -0,0 +1,161 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "array.h"
+
+struct includeDependencyDB_t;
+struct linearAllocator_t;
+struct hashmap_t;
+
+/*
+================================================================================================
+
+	Precompiled header advisor
+
+	Works out which headers are worth putting in a config's precompiled header, from what the
+	include dependency database says each of the config's source files included (and how long
+	each of them took to compile) the last time they compiled.
+
+	Builder only knows about the headers that the compiler puts in its dependency files, which
+	leaves out system headers.  That's fine though, because putting a header in the precompiled
+	header also puts everything it includes in there.
+
+	Every header that at least two of the config's source files include is a candidate.  A
+	header that N source files include gets parsed N times, but only once if it's in the
+	precompiled header.  The catch is that every source file that didn't include it now has to
+	load it as part of the precompiled header, which is a lot cheaper than parsing it but isn't
+	free.  So a header goes in if what it saves the source files that include it is more than
+	what it costs the ones that don't.
+
+	To turn that into milliseconds we assume a compile costs the same for every byte of the
+	source file and everything it includes, and work out how much that is from the compile
+	times we know about.  That's rough, but it's only used to say how much time we expect to
+	save and to rank the headers.
+
+	Headers that change often are left out.  Changing anything in the precompiled header means
+	every source file in the config has to compile again, so a header that keeps changing
+	would make every change to it a full rebuild.  Often means more than a set number of
+	commits changed it recently, when the code is in a git repository.
+
+	Taking a header out of the precompiled header (or putting one in) is a full rebuild of the
+	config too, so the headers that got picked last time stay in for as long as they're still
+	worth precompiling and don't start changing often.  A header that isn't in yet also gets
+	left out if it was written recently and after most of the config's other files were (a
+	fresh checkout writes every file at once, so none of them count), since someone is
+	probably working on it right now.
+
+	Headers in folders like bits/ and detail/ are implementation details of another header and
+	often refuse to be included on their own, so they never get included directly.  They still
+	come along with the header that includes them.
+
+================================================================================================
+*/
+
+struct pchHeader_t {
+	const char	*filename;
+	u64			sizeBytes;
+
+	// how many of the config's source files include this header
+	u32			numSourceFiles;
+
+	// where this header first showed up in the include lists of the config's source files
+	// the generated header includes everything in this order so that headers still come after the headers they rely on
+	u32			order;
+
+	// how much time putting this header in the precompiled header is expected to save a full rebuild of the config
+	// negative if it would make it slower
+	float64		savingsMS;
+
+	// how many commits changed this header recently, 0 if we dont know
+	u32			numCommits;
+
+	bool8		worthPrecompiling;
+	bool8		recentlyChanged;
+	bool8		changesOften;
+	bool8		previouslySelected;
+	bool8		internal;	// lives in a folder like bits/, see above
+
+	// worth precompiling, still exists, doesnt change often, and either got picked last time or didnt change recently
+	bool8		selected;
+};
+
+// what the advisor gets told about the headers on top of what's in the include dependency database, see above
+struct pchHistory_t {
+	// the headers that got selected last time, see PCHAdvisor_GetSelection()
+	const char * const	*previousSelection;
+	u32					numPreviousSelection;
+
+	// how many commits changed each file recently, keyed by HeaderImpact_HashPath() of the file's absolute path
+	// NULL if we don't know (like when the code isn't in a git repository)
+	const hashmap_t		*commitCounts;
+
+	// headers that more commits than this changed change often
+	u32					maxCommits;
+
+	// headers that were last written after this (in FS_GetFileLastWriteTime() units) can count as recently changed
+	u64					recentlyChangedTime;
+};
+
+struct pchAdvice_t {
+	// most savings first
+	array_t<pchHeader_t>	headers;
+
+	u32						numSourceFiles;
+
+	// how many of the source files compiled successfully last time, and how long they took in total
+	// only these ones count
+	u32						numSourceFilesCompiled;
+	float64					compileTimeMS;
+
+	// of the selected headers
+	u32						numSelected;
+	float64					savingsMS;
+};
+
+// Works out which headers should go in the precompiled header of a config with the given source files.
+// 'intermediateFilenames' are the files each source file compiles to, since that's what the include dependency database knows them by.
+// The headers in 'ignoreHeaders' are never candidates (like the precompiled header the config already has).
+// 'history' can be NULL if there's no previous selection and nothing is known about how often headers change.
+void		PCHAdvisor_Analyse( const includeDependencyDB_t *db, const char * const *intermediateFilenames, const u32 numSourceFiles, const char * const *ignoreHeaders, const u32 numIgnoreHeaders, const pchHistory_t *history, linearAllocator_t *allocator, pchAdvice_t *outAdvice );
+
+// Returns the contents of a header that includes every selected header.
+// Returns NULL if no headers got selected.
+const char	*PCHAdvisor_GetHeaderContents( const pchAdvice_t *advice, linearAllocator_t *allocator );
+
+// Returns every selected header, one per line, so it can be saved and given back as pchHistory_t::previousSelection next time.
+const char	*PCHAdvisor_GetSelection( const pchAdvice_t *advice, linearAllocator_t *allocator );
+
+// Splits what PCHAdvisor_GetSelection() returned back up into headers.
+// 'selection' gets modified, and the headers point into it.
+void		PCHAdvisor_ParseSelection( char *selection, array_t<const char *> *outHeaders );
+
+// Prints which headers would go in the precompiled header, and how much time that's expected to save.
+void		PCHAdvisor_PrintReport( const pchAdvice_t *advice, const char *configName );
@@ -0,0 +1,505 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "remote_cache.h"
+
+#include "http.h"
+#include "socket.h"
+#include "file.h"
+#include "string.h"
+#include "string_builder.h"
+#include "paths.h"
+#include "temp_storage.h"
+#include "timer.h"
+#include "hash.h"
+#include "typecast.h"
+#include "debug.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+================================================================================================
+
+	Remote cache
+
+================================================================================================
+*/
+
+// nothing that goes in the compile cache should ever be this big, so anything that says it is is either broken or lying
+#define REMOTE_CACHE_MAX_BLOB_SIZE	( 1024ULL * 1024ULL * 1024ULL )
+
+// the backends outlive whatever allocator the caller has, so they keep their own copies of strings
+static char *RemoteCache_CopyString( const char *str ) {
+	u64 length = strlen( str );
+
+	char *copy = Cast( char *, malloc( length + 1 ) );
+	memcpy( copy, str, length + 1 );
+
+	return copy;
+}
+
+void RemoteCache_FreeBlob( remoteCacheBlob_t *blob ) {
+	Assert( blob );
+
+	free( blob->data );
+
+	*blob = {};
+}
+
+bool8 RemoteCache_IsValidKey( const char *key ) {
+	Assert( key );
+
+	if ( *key == 0 || *key == '/' || *key == '\\' ) {
+		return false;
+	}
+
+	// nothing that could walk out of the folder, and nothing that needs escaping in a URL
+	for ( const char *c = key; *c; c++ ) {
+		bool8 isAllowed = ( *c >= 'a' && *c <= 'z' ) || ( *c >= 'A' && *c <= 'Z' ) || ( *c >= '0' && *c <= '9' ) || *c == '.' || *c == '/' || *c == '_' || *c == '-';
+
+		if ( !isAllowed ) {
+			return false;
+		}
+	}
+
+	return strstr( key, ".." ) == NULL;
+}
+
+bool8 RemoteCache_CreateBackend( const char *location, remoteCacheBackend_t *outBackend ) {
+	Assert( location );
+	Assert( outBackend );
+
+	if ( String_StartsWith( location, "http://" ) ) {
+		return RemoteCache_CreateBackend_HTTP( location, outBackend );
+	}
+
+	if ( String_StartsWith( location, "https://" ) ) {
+		Error( "The remote cache \"%s\" is HTTPS, but Builder only knows how to talk HTTP.  Put it behind something that does the HTTPS for you, or use http://.\n", location );
+		return false;
+	}
+
+	RemoteCache_CreateBackend_FileSystem( location, outBackend );
+
+	return true;
+}
+
+/*
+================================================================================================
+
+	File system backend
+
+================================================================================================
+*/
+
+struct fileSystemBackend_t {
+	char	*folder;
+};
+
+static const char *FileSystemBackend_GetPath( const fileSystemBackend_t *fs, const char *key ) {
+	return TempPrintf( "%s/%s", fs->folder, key );
+}
+
+static void FileSystemBackend_Shutdown( remoteCacheBackend_t *backend ) {
+	fileSystemBackend_t *fs = Cast( fileSystemBackend_t *, backend->data );
+
+	free( fs->folder );
+	free( fs );
+
+	backend->data = NULL;
+}
+
+static bool8 FileSystemBackend_Get( remoteCacheBackend_t *backend, const char * const *keys, const u32 count, remoteCacheBlob_t *outBlobs ) {
+	const fileSystemBackend_t *fs = Cast( const fileSystemBackend_t *, backend->data );
+
+	For ( u32, keyIndex, 0, count ) {
+		outBlobs[keyIndex] = {};
+
+		string_t contents = {};
+		if ( FS_ReadEntireFile( FileSystemBackend_GetPath( fs, keys[keyIndex] ), &contents ) ) {
+			outBlobs[keyIndex] = {
+				.found	= true,
+				.data	= Cast( u8 *, contents.data ),
+				.size	= contents.count,
+			};
+		}
+	}
+
+	return true;
+}
+
+static bool8 FileSystemBackend_Contains( remoteCacheBackend_t *backend, const char * const *keys, const u32 count, bool8 *outContains ) {
+	const fileSystemBackend_t *fs = Cast( const fileSystemBackend_t *, backend->data );
+
+	For ( u32, keyIndex, 0, count ) {
+		outContains[keyIndex] = FS_FileExists( FileSystemBackend_GetPath( fs, keys[keyIndex] ) );
+	}
+
+	return true;
+}
+
+static bool8 FileSystemBackend_Put( remoteCacheBackend_t *backend, const char *key, const void *data, const u64 size ) {
+	const fileSystemBackend_t *fs = Cast( const fileSystemBackend_t *, backend->data );
+
+	const char *filename = FileSystemBackend_GetPath( fs, key );
+
+	string_t filenameString = String_Set( filename );
+	string_t folder = Path_RemoveFileFromPath( &filenameString );
+
+	if ( !FS_CreateFolderIfItDoesntExist( TempPrintf( "%.*s", TruncCast( int, folder.count ), folder.data ) ) ) {
+		return false;
+	}
+
+	// other machines could be reading it while we write it, so it needs to turn up all at once
+	u64 cycles = Cast( u64, Time_Cycles() );
+	const char *tempFilename = TempPrintf( "%s.%016" PRIx64 ".tmp", filename, Hash64( &cycles, sizeof( u64 ), Cast( u64, &cycles ) ) );
+
+	if ( !FS_WriteEntireFile( tempFilename, data, size ) ) {
+		return false;
+	}
+
+	if ( !FS_RenameFile( tempFilename, filename ) ) {
+		FS_DeleteFile( tempFilename );
+		return false;
+	}
+
+	return true;
+}
+
+void RemoteCache_CreateBackend_FileSystem( const char *folder, remoteCacheBackend_t *outBackend ) {
+	Assert( folder );
+	Assert( outBackend );
+
+	fileSystemBackend_t *fs = Cast( fileSystemBackend_t *, malloc( sizeof( fileSystemBackend_t ) ) );
+	fs->folder = RemoteCache_CopyString( folder );
+
+	*outBackend = {
+		.data			= fs,
+		.description	= fs->folder,
+		.Shutdown		= FileSystemBackend_Shutdown,
+		.Get			= FileSystemBackend_Get,
+		.Contains		= FileSystemBackend_Contains,
+		.Put			= FileSystemBackend_Put,
+	};
+}
+
+/*
+================================================================================================
+
+	HTTP backend
+
+	Keeps one connection open for as long as the backend lives, and reconnects whenever the
+	server closes it.  Gets and checks are pipelined: every request in the batch goes out
+	before any of the responses get read.
+
+================================================================================================
+*/
+
+// how many requests we send before reading any responses
+// requests are tiny so these never fill up the socket's send buffer, which is what would deadlock us if the server stopped reading because its own send buffer filled up with responses we werent reading yet
+#define HTTP_BACKEND_PIPELINE_DEPTH	32
+
+// a cache that isnt answering shouldnt hold anything up for long
+// this is how long connecting, or any one send or receive, can go without any progress, so big blobs still have as long as they need
+#define HTTP_BACKEND_TIMEOUT_MS		2000
+
+struct httpBackend_t {
+	char				host[256];
+	u16					port;
+	char				pathPrefix[HTTP_MAX_PATH];	// either empty or starts with a '/', and never ends with one
+
+	char				*url;
+
+	httpConnection_t	connection;
+	bool8				connected;
+};
+
+static bool8 HTTPBackend_Connect( httpBackend_t *http ) {
+	if ( http->connected ) {
+		return true;
+	}
+
+	socket_t socket;
+	if ( !Socket_Connect( http->host, http->port, HTTP_BACKEND_TIMEOUT_MS, &socket ) ) {
+		return false;
+	}
+
+	Http_OpenConnection( &http->connection, socket );
+	http->connected = true;
+
+	return true;
+}
+
+static void HTTPBackend_Disconnect( httpBackend_t *http ) {
+	if ( http->connected ) {
+		Http_CloseConnection( &http->connection );
+		http->connected = false;
+	}
+}
+
+static void HTTPBackend_Shutdown( remoteCacheBackend_t *backend ) {
+	httpBackend_t *http = Cast( httpBackend_t *, backend->data );
+
+	HTTPBackend_Disconnect( http );
+
+	free( http->url );
+	free( http );
+
+	backend->data = NULL;
+}
+
+// sends a GET or HEAD for every key, then reads the responses back in the same order
+// 'outBlobs' for GET, 'outContains' for HEAD
+static bool8 HTTPBackend_RunBatch( httpBackend_t *http, const char *method, const char * const *keys, const u32 count, remoteCacheBlob_t *outBlobs, bool8 *outContains ) {
+	bool8 isHead = outContains != NULL;
+
+	For ( u32, keyIndex, 0, count ) {
+		if ( isHead ) {
+			outContains[keyIndex] = false;
+		} else {
+			outBlobs[keyIndex] = {};
+		}
+	}
+
+	u32 numAnswered = 0;
+	u32 numFailedAttempts = 0;
+
+	while ( numAnswered < count ) {
+		// the server is allowed to close the connection whenever it likes, so try again on a new one once before giving up
+		if ( numFailedAttempts > 1 || !HTTPBackend_Connect( http ) ) {
+			HTTPBackend_Disconnect( http );
+			return false;
+		}
+
+		u32 numToSend = count - numAnswered;
+		if ( numToSend > HTTP_BACKEND_PIPELINE_DEPTH ) {
+			numToSend = HTTP_BACKEND_PIPELINE_DEPTH;
+		}
+
+		u64 marker = Mem_TempTell();
+
+		stringBuilder_t sb = SB_Create( Mem_GetTempStorage() );
+		For ( u32, keyIndex, numAnswered, numAnswered + numToSend ) {
+			SB_Appendf( &sb, "%s %s/%s HTTP/1.1\r\nHost: %s\r\n\r\n", method, http->pathPrefix, keys[keyIndex], http->host );
+		}
+
+		const char *requests = SB_ToString( &sb );
+		bool8 sent = Socket_Send( &http->connection.socket, requests, strlen( requests ) );
+
+		Mem_TempRewindTo( marker );
+
+		if ( !sent ) {
+			HTTPBackend_Disconnect( http );
+			numFailedAttempts++;
+			continue;
+		}
+
+		u32 numAnsweredBefore = numAnswered;
+
+		For ( u32, keyIndex, numAnsweredBefore, numAnsweredBefore + numToSend ) {
+			httpHead_t head;
+			if ( !Http_ReadResponseHead( &http->connection, &head ) ) {
+				HTTPBackend_Disconnect( http );
+				break;
+			}
+
+			if ( isHead ) {
+				// responses to HEAD say how big the body would be, but dont have one
+				outContains[keyIndex] = head.statusCode == 200;
+			} else if ( head.statusCode == 200 ) {
+				if ( head.contentLength > REMOTE_CACHE_MAX_BLOB_SIZE ) {
+					HTTPBackend_Disconnect( http );
+					break;
+				}
+
+				u8 *data = Cast( u8 *, malloc( head.contentLength + 1 ) );
+
+				if ( !Http_ReadBody( &http->connection, data, head.contentLength ) ) {
+					free( data );
+					HTTPBackend_Disconnect( http );
+					break;
+				}
+
+				data[head.contentLength] = 0;
+
+				outBlobs[keyIndex] = {
+					.found	= true,
+					.data	= data,
+					.size	= head.contentLength,
+				};
+			} else {
+				if ( !Http_SkipBody( &http->connection, head.contentLength ) ) {
+					HTTPBackend_Disconnect( http );
+					break;
+				}
+			}
+
+			numAnswered++;
+
+			// anything else we sent down this connection isnt getting answered
+			if ( !head.keepAlive ) {
+				HTTPBackend_Disconnect( http );
+				break;
+			}
+		}
+
+		if ( numAnswered == numAnsweredBefore ) {
+			numFailedAttempts++;
+		} else {
+			numFailedAttempts = 0;
+		}
+	}
+
+	return true;
+}
+
+static bool8 HTTPBackend_Get( remoteCacheBackend_t *backend, const char * const *keys, const u32 count, remoteCacheBlob_t *outBlobs ) {
+	httpBackend_t *http = Cast( httpBackend_t *, backend->data );
+
+	return HTTPBackend_RunBatch( http, "GET", keys, count, outBlobs, NULL );
+}
+
+static bool8 HTTPBackend_Contains( remoteCacheBackend_t *backend, const char * const *keys, const u32 count, bool8 *outContains ) {
+	httpBackend_t *http = Cast( httpBackend_t *, backend->data );
+
+	return HTTPBackend_RunBatch( http, "HEAD", keys, count, NULL, outContains );
+}
+
+static bool8 HTTPBackend_Put( remoteCacheBackend_t *backend, const char *key, const void *data, const u64 size ) {
+	httpBackend_t *http = Cast( httpBackend_t *, backend->data );
+
+	For ( u32, attempt, 0, 2 ) {
+		if ( !HTTPBackend_Connect( http ) ) {
+			return false;
+		}
+
+		const char *head = TempPrintf( "PUT %s/%s HTTP/1.1\r\nHost: %s\r\nContent-Length: %" PRIu64 "\r\n\r\n", http->pathPrefix, key, http->host, size );
+
+		if ( !Socket_Send( &http->connection.socket, head, strlen( head ) ) || !Socket_Send( &http->connection.socket, data, size ) ) {
+			HTTPBackend_Disconnect( http );
+			continue;
+		}
+
+		httpHead_t responseHead;
+		if ( !Http_ReadResponseHead( &http->connection, &responseHead ) || !Http_SkipBody( &http->connection, responseHead.contentLength ) ) {
+			HTTPBackend_Disconnect( http );
+			continue;
+		}
+
+		if ( !responseHead.keepAlive ) {
+			HTTPBackend_Disconnect( http );
+		}
+
+		return responseHead.statusCode >= 200 && responseHead.statusCode < 300;
+	}
+
+	return false;
+}
+
+bool8 RemoteCache_CreateBackend_HTTP( const char *url, remoteCacheBackend_t *outBackend ) {
+	Assert( url );
+	Assert( outBackend );
+
+	if ( !String_StartsWith( url, "http://" ) ) {
+		Error( "The remote cache URL \"%s\" needs to start with http://.\n", url );
+		return false;
+	}
+
+	httpBackend_t *http = Cast( httpBackend_t *, calloc( 1, sizeof( httpBackend_t ) ) );
+	http->port = 80;
+
+	const char *host = url + strlen( "http://" );
+	const char *hostEnd = NULL;
+	const char *afterHost = NULL;
+
+	// IPv6 addresses are in square brackets so the colons dont look like a port
+	if ( *host == '[' ) {
+		host++;
+		hostEnd = strchr( host, ']' );
+		afterHost = hostEnd ? hostEnd + 1 : NULL;
+	} else {
+		hostEnd = host + strcspn( host, ":/" );
+		afterHost = hostEnd;
+	}
+
+	u64 hostLength = hostEnd ? Cast( u64, hostEnd - host ) : 0;
+
+	if ( hostLength == 0 || hostLength >= sizeof( http->host ) ) {
+		Error( "I can't find the host name in the remote cache URL \"%s\".  It should look like http://host:port/prefix.\n", url );
+		free( http );
+		return false;
+	}
+
+	memcpy( http->host, host, hostLength );
+	http->host[hostLength] = 0;
+
+	const char *path = afterHost;
+
+	if ( *afterHost == ':' ) {
+		char *portEnd = NULL;
+		unsigned long port = strtoul( afterHost + 1, &portEnd, 10 );
+
+		if ( portEnd == afterHost + 1 || port == 0 || port > 65535 || ( *portEnd != 0 && *portEnd != '/' ) ) {
+			Error( "The port in the remote cache URL \"%s\" needs to be a number between 1 and 65535.\n", url );
+			free( http );
+			return false;
+		}
+
+		http->port = Cast( u16, port );
+		path = portEnd;
+	}
+
+	u64 pathLength = strlen( path );
+	while ( pathLength > 0 && path[pathLength - 1] == '/' ) {
+		pathLength--;
+	}
+
+	if ( pathLength >= sizeof( http->pathPrefix ) ) {
+		Error( "The path in the remote cache URL \"%s\" is too long.\n", url );
+		free( http );
+		return false;
+	}
+
+	memcpy( http->pathPrefix, path, pathLength );
+	http->pathPrefix[pathLength] = 0;
+
+	http->url = RemoteCache_CopyString( url );
+
+	*outBackend = {
+		.data			= http,
+		.description	= http->url,
+		.Shutdown		= HTTPBackend_Shutdown,
+		.Get			= HTTPBackend_Get,
+		.Contains		= HTTPBackend_Contains,
+		.Put			= HTTPBackend_Put,
+	};
+
+	return true;
+}
@@ -0,0 +1,97 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+
+/*
+================================================================================================
+
+	Remote cache
+
+	Somewhere outside this machine (or at least outside this checkout) that compile cache
+	entries can be shared through, so a CI farm building the same commit on lots of agents only
+	has to compile each file once.  See compile_cache.h for what goes in it.
+
+	Everything in a remote cache is a blob with a key.  Keys are relative paths like
+	"ab/abcdef0123456789.lz".  Every backend can get, put, and check for blobs, and gets and
+	checks take a whole batch of keys at once so that backends that can pipeline requests
+	(like HTTP) only wait for one round trip per batch instead of one per key.
+
+	Backends:
+
+	- File system: a folder, E.G. on a network drive.  Laid out exactly like the keys.
+	- HTTP: a server that answers "GET /<key>", "HEAD /<key>", and "PUT /<key>" with 200 or 404.
+	  Builder comes with one of these (see cache_server.h) so you can try it out locally.
+
+	A backend is only ever used by one thread at a time.  Make one per thread if you need more.
+
+================================================================================================
+*/
+
+struct remoteCacheBlob_t {
+	bool8	found;
+	u8		*data;	// always has a null terminator after it, free with RemoteCache_FreeBlob()
+	u64		size;
+};
+
+struct remoteCacheBackend_t {
+	void		*data;
+
+	// what to tell the user this backend is
+	const char	*description;
+
+	void		( *Shutdown )( remoteCacheBackend_t *backend );
+
+	// Gets the blob for each of the 'count' keys.  'found' is false for the ones that aren't in the cache.
+	// Returns false if the cache couldn't be reached at all, in which case none of them were found.
+	bool8		( *Get )( remoteCacheBackend_t *backend, const char * const *keys, const u32 count, remoteCacheBlob_t *outBlobs );
+
+	// Same as Get(), except it only says whether each blob is there.
+	bool8		( *Contains )( remoteCacheBackend_t *backend, const char * const *keys, const u32 count, bool8 *outContains );
+
+	// Adds the blob to the cache, replacing whatever already had that key.
+	bool8		( *Put )( remoteCacheBackend_t *backend, const char *key, const void *data, const u64 size );
+};
+
+// Makes an HTTP backend if 'location' starts with "http://", otherwise a file system backend with 'location' as the folder.
+// Returns false (and says why) if 'location' isn't something we can use.
+bool8	RemoteCache_CreateBackend( const char *location, remoteCacheBackend_t *outBackend );
+
+void	RemoteCache_CreateBackend_FileSystem( const char *folder, remoteCacheBackend_t *outBackend );
+
+// 'url' is "http://host[:port][/prefix]".
+// Only checks that the URL makes sense, doesn't connect to anything until the backend gets used.
+bool8	RemoteCache_CreateBackend_HTTP( const char *url, remoteCacheBackend_t *outBackend );
+
+void	RemoteCache_FreeBlob( remoteCacheBlob_t *blob );
+
+// Returns true if 'key' is something a backend should ever be asked for.
+// So that a server can't be made to touch anything outside its folder.
+bool8	RemoteCache_IsValidKey( const char *key );
@@ -0,0 +1,81 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+
+/*
+================================================================================================
+
+	socket_t
+
+	OS-agnostic blocking TCP sockets.  Just enough for talking to (and being) a remote cache
+	server, so IPv4 and IPv6 both work but there's nothing fancy like non-blocking sockets or
+	TLS.
+
+================================================================================================
+*/
+
+struct socket_t {
+	s64		handle;	// -1 if it isn't open
+};
+
+// Connects to 'host' (a name or an address) on 'port'.
+// If 'timeoutMS' isn't 0 then connecting, sending, and receiving all give up after that long instead of waiting however long the OS wants to.
+// Returns false if it couldn't connect.
+bool8	Socket_Connect( const char *host, const u16 port, const u32 timeoutMS, socket_t *outSocket );
+
+// Starts listening for connections on 'port'.
+// Only connections from this machine (the loopback address) get accepted unless 'allInterfaces' is true, in which case it listens on every network interface.
+// Pass 0 for 'port' to have the OS pick one, then use Socket_GetPort() to find out what it picked.
+// Returns false if it couldn't listen on that port (E.G. something else is already listening on it).
+bool8	Socket_Listen( const u16 port, const bool8 allInterfaces, socket_t *outSocket );
+
+// Blocks until someone connects to 'listenSocket'.
+// Returns false if the listen socket got closed or something went wrong.
+bool8	Socket_Accept( socket_t *listenSocket, socket_t *outSocket );
+
+// Returns the port that the socket is bound to.
+u16		Socket_GetPort( const socket_t *socket );
+
+// Sends all 'size' bytes of 'data'.
+// Returns false if the connection got closed or timed out before all of it got sent.
+bool8	Socket_Send( socket_t *socket, const void *data, const u64 size );
+
+// Receives up to 'size' bytes into 'outBuffer'.
+// Returns how many bytes were received, 0 if the other side closed the connection, or -1 if something went wrong (including timing out).
+s64		Socket_Receive( socket_t *socket, void *outBuffer, const u64 size );
+
+// Wakes up anything blocked sending to or receiving from the socket, and stops anything else being sent or received, without closing it.
+// This doesn't wake up Socket_Accept() on every OS, so to stop that connect to the listen socket instead.
+// Thread-safe.
+void	Socket_Shutdown( socket_t *socket );
+
+// Does nothing if the socket isn't open.
+void	Socket_Close( socket_t *socket );
@@ -278,6 +278,14 @@ bool8 String_FindFromRight( const string_t *str, const char c, u64 *outIndex ) {
 	return false;
 }
 
+bool8 String_IsIdentifierStart( const char c ) {
+	return ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || c == '_';
+}
+
+bool8 String_IsIdentifierChar( const char c ) {
+	return String_IsIdentifierStart( c ) || ( c >= '0' && c <= '9' );
+}
+
 const char *String_Cstr( const string_t *str ) {
 	Assert( str );
 
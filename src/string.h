@@ -117,6 +117,12 @@ bool8		String_FindFromLeft( const string_t *str, const char c, u64 *outIndex );
 // Returns true if character 'c' is found in 'str', searching right to left, and sets 'outIndex' to the position of the last occurrence.  Returns false if 'c' cannot be found.
 bool8		String_FindFromRight( const string_t *str, const char c, u64 *outIndex );
 
+// Returns true if 'c' can be the first character of a C/C++ identifier.
+bool8		String_IsIdentifierStart( const char c );
+
+// Returns true if 'c' can be anywhere in a C/C++ identifier after the first character.
+bool8		String_IsIdentifierChar( const char c );
+
 // Returns a null-terminated copy of 'str' allocated on temp storage, truncated to 'str->count'.
 // Use this to safely pass a string_t as a '%s' argument to printf.
 const char	*String_Cstr( const string_t *str );
@@ -35,6 +35,7 @@ SOFTWARE.
 #include "stb_local.h"
 
 #include <stdarg.h>
+#include <stdio.h>
 #include <memory.h>
 #include <string.h>
 
@@ -89,6 +90,42 @@ void SB_Appendf( stringBuilder_t *builder, const char *fmt, ... ) {
 	va_end( args );
 }
 
+void SB_AppendJSONString( stringBuilder_t *builder, const char *string ) {
+	Assert( builder );
+	Assert( string );
+
+	SB_Appendf( builder, "\"" );
+
+	const char *runStart = string;
+
+	for ( const char *c = string; *c; c++ ) {
+		const char *escaped = NULL;
+		char controlEscape[8];
+
+		switch ( *c ) {
+			case '"':	escaped = "\\\""; break;
+			case '\\':	escaped = "\\\\"; break;
+			case '\n':	escaped = "\\n"; break;
+			case '\r':	escaped = "\\r"; break;
+			case '\t':	escaped = "\\t"; break;
+
+			default:
+				if ( Cast( u8, *c ) < 0x20 ) {
+					snprintf( controlEscape, sizeof( controlEscape ), "\\u%04x", Cast( u32, *c ) );
+					escaped = controlEscape;
+				}
+				break;
+		}
+
+		if ( escaped ) {
+			SB_Appendf( builder, "%.*s%s", TruncCast( int, c - runStart ), runStart, escaped );
+			runStart = c + 1;
+		}
+	}
+
+	SB_Appendf( builder, "%s\"", runStart );
+}
+
 const char *SB_ToString( stringBuilder_t *builder ) {
 	char *result = NULL;
 	u64 totalLength = 0;
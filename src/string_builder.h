@@ -71,4 +71,7 @@ stringBuilder_t	SB_Create( linearAllocator_t *allocator );
 
 void			SB_Appendf( stringBuilder_t *builder, const char *fmt, ... );
 
+// Appends 'string' as a JSON string, with the quotes around it and everything in it that JSON needs escaped.
+void			SB_AppendJSONString( stringBuilder_t *builder, const char *string );
+
 const char		*SB_ToString( stringBuilder_t *builder );
@@ -56,11 +56,15 @@ enum processFlagBits_t {
 typedef u32 processFlags_t;
 
 
-process_t	*Proc_Create( linearAllocator_t *allocator, array_t<const char *> *args, array_t<const char *> *environmentVariables = NULL, const processFlags_t flags = 0 );
+// If 'workingDirectory' isn't NULL then the process runs in that folder instead of the current one.
+process_t	*Proc_Create( linearAllocator_t *allocator, array_t<const char *> *args, array_t<const char *> *environmentVariables = NULL, const processFlags_t flags = 0, const char *workingDirectory = NULL );
 
 bool8		Proc_Destroy( process_t *process );
 
-s32			Proc_Join( process_t *process );
+// Waits for the process to finish and returns its exit code.
+// If 'outPeakMemoryBytes' isn't NULL then it gets set to the most physical memory the process (and anything it ran) used at once.
+// If 'outCPUTimeMS' isn't NULL then it gets set to how much CPU time (user and kernel) the process used.
+s32			Proc_Join( process_t *process, u64 *outPeakMemoryBytes = NULL, float64 *outCPUTimeMS = NULL );
 
 u32			Proc_ReadStdout( process_t *process, char *outBuffer, const u64 count );
 
@@ -29,6 +29,7 @@ SOFTWARE.
 #include "temp_storage.h"
 
 #include "linear_allocator.h"
+#include "thread.h"
 #include "typecast.h"
 #include "debug.h"
 
@@ -40,13 +41,6 @@ SOFTWARE.
 ================================================================================================
 */
 
-// DM!!! this cant live here!
-#ifdef _WIN32
-#define THREAD_LOCAL __declspec( thread )
-#else
-#define THREAD_LOCAL __thread
-#endif
-
 static THREAD_LOCAL linearAllocator_t *gTempStorage = NULL;
 
 linearAllocator_t *Mem_GetTempStorage() {
@@ -42,14 +42,32 @@ SOFTWARE.
 ================================================================================================
 */
 
+#ifdef _WIN32
+#define THREAD_LOCAL __declspec( thread )
+#else
+#define THREAD_LOCAL __thread
+#endif
+
 struct thread_t {
 	void	*ptr;
 };
 
+struct mutex_t {
+	void	*ptr;
+};
+
+struct semaphore_t {
+	void	*ptr;
+};
+
 struct atomic32_t {
 	volatile u32	value;
 };
 
+struct atomic64_t {
+	volatile u64	value;
+};
+
 typedef s32 ( *ThreadFunc )( void *data );
 
 // Creates and immediately executes a thread that runs 'threadFunc' with 'data' passed through.
@@ -61,5 +79,54 @@ void		Thread_Destroy( thread_t *thread );
 // Waits for the thread to stop running, returning the exit code when it finished.
 s32			Thread_Wait( thread_t *thread );
 
+// Puts the calling thread to sleep for at least 'milliseconds'.
+void		Thread_Sleep( const u32 milliseconds );
+
+// Creates a mutex that isnt locked by anyone.
+mutex_t		Mutex_Create();
+
+// Destroys the mutex.  Nothing can be holding it.
+void		Mutex_Destroy( mutex_t *mutex );
+
+// Blocks until this thread holds the mutex.
+void		Mutex_Lock( mutex_t *mutex );
+
+// Releases the mutex so another thread can take it.
+void		Mutex_Unlock( mutex_t *mutex );
+
+// Creates a counting semaphore that starts with 'initialCount'.
+semaphore_t	Semaphore_Create( const u32 initialCount );
+
+// Destroys the semaphore.  Nothing can be waiting on it.
+void		Semaphore_Destroy( semaphore_t *semaphore );
+
+// Adds 'count' to the semaphore, waking up to that many waiting threads.
+void		Semaphore_Signal( semaphore_t *semaphore, const u32 count = 1 );
+
+// Blocks until the semaphore's count is more than zero, then takes one from it.
+void		Semaphore_Wait( semaphore_t *semaphore );
+
+// If the semaphore's count is more than zero, takes one from it and returns true.
+// Otherwise returns false straight away.
+bool8		Semaphore_TryWait( semaphore_t *semaphore );
+
 // Performs an atomic increment.
 u32			Thread_AtomicIncrement( atomic32_t *atomic );
+
+// Atomically adds 'value' to the atomic and returns the result.
+u32			Thread_AtomicAdd( atomic32_t *atomic, const u32 value );
+
+// Atomically sets the atomic to 'desired' but only if its current value is 'expected'.
+// Returns the value the atomic had before, so the exchange happened if the return value equals 'expected'.
+u32			Thread_AtomicCompareExchange( atomic32_t *atomic, const u32 expected, const u32 desired );
+u64			Thread_AtomicCompareExchange( atomic64_t *atomic, const u64 expected, const u64 desired );
+
+// Reads the atomic's value.
+// Anything another thread wrote before it stored this value with Thread_AtomicStore() is guaranteed to be visible after this.
+u32			Thread_AtomicLoad( const atomic32_t *atomic );
+u64			Thread_AtomicLoad( const atomic64_t *atomic );
+
+// Sets the atomic's value.
+// Anything this thread wrote before this call is guaranteed to be visible to another thread that reads this value with Thread_AtomicLoad().
+void		Thread_AtomicStore( atomic32_t *atomic, const u32 value );
+void		Thread_AtomicStore( atomic64_t *atomic, const u64 value );
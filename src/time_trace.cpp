@@ -0,0 +1,666 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "time_trace.h"
+
+#include "file.h"
+#include "hash.h"
+#include "hashmap.h"
+#include "math.h"
+#include "string.h"
+#include "string_builder.h"
+#include "array.inl"
+#include "typecast.h"
+#include "defer.h"
+#include "debug.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+/*
+================================================================================================
+
+	Time trace report
+
+================================================================================================
+*/
+
+// arrays and objects in a trace only go a couple deep, anything deeper than this isnt a trace
+#define JSON_MAX_DEPTH	64
+
+struct jsonReader_t {
+	char	*current;
+	char	*end;
+};
+
+struct traceEvent_t {
+	const char	*name;
+	const char	*phase;
+	const char	*detail;	// NULL if the event doesnt have one
+	float64		durationUS;
+	bool8		hasDuration;
+};
+
+static const char *g_timeTraceCategoryTitles[] = {
+	"Headers (time spent parsing each one, including the headers it includes)",	// TIME_TRACE_CATEGORY_HEADERS
+	"Template instantiations",													// TIME_TRACE_CATEGORY_TEMPLATES
+	"Backend passes",															// TIME_TRACE_CATEGORY_BACKEND_PASSES
+};
+
+static_assert( COUNT_OF( g_timeTraceCategoryTitles ) == TIME_TRACE_CATEGORY_COUNT );
+
+static const char *g_timeTraceCategoryJSONNames[] = {
+	"headers",			// TIME_TRACE_CATEGORY_HEADERS
+	"templates",		// TIME_TRACE_CATEGORY_TEMPLATES
+	"backendPasses",	// TIME_TRACE_CATEGORY_BACKEND_PASSES
+};
+
+static_assert( COUNT_OF( g_timeTraceCategoryJSONNames ) == TIME_TRACE_CATEGORY_COUNT );
+
+static void SkipWhitespace( jsonReader_t *reader ) {
+	while ( reader->current < reader->end && ( *reader->current == ' ' || *reader->current == '\t' || *reader->current == '\n' || *reader->current == '\r' ) ) {
+		reader->current += 1;
+	}
+}
+
+// skips over 'c' if its the next thing after any whitespace
+static bool8 Consume( jsonReader_t *reader, const char c ) {
+	SkipWhitespace( reader );
+
+	if ( reader->current < reader->end && *reader->current == c ) {
+		reader->current += 1;
+		return true;
+	}
+
+	return false;
+}
+
+static s32 HexDigitValue( const char c ) {
+	if ( c >= '0' && c <= '9' ) return c - '0';
+	if ( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+	if ( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+
+	return -1;
+}
+
+static bool8 ReadHex4( jsonReader_t *reader, u32 *outValue ) {
+	if ( reader->end - reader->current < 4 ) {
+		return false;
+	}
+
+	u32 value = 0;
+
+	For ( u32, digitIndex, 0, 4 ) {
+		s32 digit = HexDigitValue( reader->current[digitIndex] );
+		if ( digit < 0 ) {
+			return false;
+		}
+
+		value = ( value << 4 ) | Cast( u32, digit );
+	}
+
+	reader->current += 4;
+
+	*outValue = value;
+
+	return true;
+}
+
+// unescapes the string where it is and null-terminates it
+// the unescaped string is never longer than the escaped one, so it always fits (the closing quote becomes the null terminator if nothing else does)
+static bool8 ReadString( jsonReader_t *reader, const char **outString ) {
+	if ( !Consume( reader, '"' ) ) {
+		return false;
+	}
+
+	char *start = reader->current;
+	char *write = reader->current;
+
+	while ( reader->current < reader->end ) {
+		char c = *reader->current;
+		reader->current += 1;
+
+		if ( c == '"' ) {
+			*write = 0;
+			*outString = start;
+			return true;
+		}
+
+		if ( c != '\\' ) {
+			*write++ = c;
+			continue;
+		}
+
+		if ( reader->current >= reader->end ) {
+			return false;
+		}
+
+		char escaped = *reader->current;
+		reader->current += 1;
+
+		switch ( escaped ) {
+			case '"':	*write++ = '"'; break;
+			case '\\':	*write++ = '\\'; break;
+			case '/':	*write++ = '/'; break;
+			case 'b':	*write++ = '\b'; break;
+			case 'f':	*write++ = '\f'; break;
+			case 'n':	*write++ = '\n'; break;
+			case 'r':	*write++ = '\r'; break;
+			case 't':	*write++ = '\t'; break;
+
+			case 'u': {
+				u32 codepoint = 0;
+				if ( !ReadHex4( reader, &codepoint ) ) {
+					return false;
+				}
+
+				// characters outside the basic multilingual plane come as two of these
+				if ( codepoint >= 0xD800 && codepoint <= 0xDBFF && reader->end - reader->current >= 6 && reader->current[0] == '\\' && reader->current[1] == 'u' ) {
+					reader->current += 2;
+
+					u32 low = 0;
+					if ( !ReadHex4( reader, &low ) || low < 0xDC00 || low > 0xDFFF ) {
+						return false;
+					}
+
+					codepoint = 0x10000 + ( ( codepoint - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+				}
+
+				// utf-8 never needs more bytes than the escape took up
+				if ( codepoint < 0x80 ) {
+					*write++ = Cast( char, codepoint );
+				} else if ( codepoint < 0x800 ) {
+					*write++ = Cast( char, 0xC0 | ( codepoint >> 6 ) );
+					*write++ = Cast( char, 0x80 | ( codepoint & 0x3F ) );
+				} else if ( codepoint < 0x10000 ) {
+					*write++ = Cast( char, 0xE0 | ( codepoint >> 12 ) );
+					*write++ = Cast( char, 0x80 | ( ( codepoint >> 6 ) & 0x3F ) );
+					*write++ = Cast( char, 0x80 | ( codepoint & 0x3F ) );
+				} else {
+					*write++ = Cast( char, 0xF0 | ( codepoint >> 18 ) );
+					*write++ = Cast( char, 0x80 | ( ( codepoint >> 12 ) & 0x3F ) );
+					*write++ = Cast( char, 0x80 | ( ( codepoint >> 6 ) & 0x3F ) );
+					*write++ = Cast( char, 0x80 | ( codepoint & 0x3F ) );
+				}
+
+				break;
+			}
+
+			default:
+				return false;
+		}
+	}
+
+	return false;
+}
+
+static bool8 ReadNumber( jsonReader_t *reader, float64 *outNumber ) {
+	SkipWhitespace( reader );
+
+	// copy it out first, because the file isnt null-terminated so strtod() could run off the end of it
+	char number[64];
+	u64 length = 0;
+
+	while ( reader->current + length < reader->end && length < sizeof( number ) - 1 ) {
+		char c = reader->current[length];
+
+		if ( !( ( c >= '0' && c <= '9' ) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E' ) ) {
+			break;
+		}
+
+		number[length] = c;
+		length += 1;
+	}
+
+	number[length] = 0;
+
+	char *numberEnd = NULL;
+	*outNumber = strtod( number, &numberEnd );
+
+	if ( length == 0 || numberEnd != number + length ) {
+		return false;
+	}
+
+	reader->current += length;
+
+	return true;
+}
+
+static bool8 SkipValue( jsonReader_t *reader, const u32 depth );
+
+static bool8 SkipObject( jsonReader_t *reader, const u32 depth ) {
+	if ( !Consume( reader, '{' ) ) {
+		return false;
+	}
+
+	if ( Consume( reader, '}' ) ) {
+		return true;
+	}
+
+	do {
+		const char *key = NULL;
+		if ( !ReadString( reader, &key ) || !Consume( reader, ':' ) || !SkipValue( reader, depth + 1 ) ) {
+			return false;
+		}
+	} while ( Consume( reader, ',' ) );
+
+	return Consume( reader, '}' );
+}
+
+static bool8 SkipArray( jsonReader_t *reader, const u32 depth ) {
+	if ( !Consume( reader, '[' ) ) {
+		return false;
+	}
+
+	if ( Consume( reader, ']' ) ) {
+		return true;
+	}
+
+	do {
+		if ( !SkipValue( reader, depth + 1 ) ) {
+			return false;
+		}
+	} while ( Consume( reader, ',' ) );
+
+	return Consume( reader, ']' );
+}
+
+static bool8 SkipValue( jsonReader_t *reader, const u32 depth ) {
+	if ( depth > JSON_MAX_DEPTH ) {
+		return false;
+	}
+
+	SkipWhitespace( reader );
+
+	if ( reader->current >= reader->end ) {
+		return false;
+	}
+
+	switch ( *reader->current ) {
+		case '"': {
+			const char *string = NULL;
+			return ReadString( reader, &string );
+		}
+
+		case '{':
+			return SkipObject( reader, depth );
+
+		case '[':
+			return SkipArray( reader, depth );
+
+		case 't':
+		case 'f':
+		case 'n': {
+			const char *literals[] = { "true", "false", "null" };
+
+			For ( u32, literalIndex, 0, COUNT_OF( literals ) ) {
+				u64 literalLength = strlen( literals[literalIndex] );
+
+				if ( Cast( u64, reader->end - reader->current ) >= literalLength && strncmp( reader->current, literals[literalIndex], literalLength ) == 0 ) {
+					reader->current += literalLength;
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		default: {
+			float64 number = 0.0;
+			return ReadNumber( reader, &number );
+		}
+	}
+}
+
+// the only thing we want out of an event's args is its detail, which says what the event was about (which header, which template, etc.)
+static bool8 ReadEventArgs( jsonReader_t *reader, traceEvent_t *outEvent ) {
+	if ( !Consume( reader, '{' ) ) {
+		return false;
+	}
+
+	if ( Consume( reader, '}' ) ) {
+		return true;
+	}
+
+	do {
+		const char *key = NULL;
+		if ( !ReadString( reader, &key ) || !Consume( reader, ':' ) ) {
+			return false;
+		}
+
+		bool8 read = false;
+		if ( String_Equals( key, "detail" ) ) {
+			read = ReadString( reader, &outEvent->detail );
+		} else {
+			read = SkipValue( reader, 2 );
+		}
+
+		if ( !read ) {
+			return false;
+		}
+	} while ( Consume( reader, ',' ) );
+
+	return Consume( reader, '}' );
+}
+
+static bool8 ReadEvent( jsonReader_t *reader, traceEvent_t *outEvent ) {
+	*outEvent = {};
+
+	if ( !Consume( reader, '{' ) ) {
+		return false;
+	}
+
+	if ( Consume( reader, '}' ) ) {
+		return true;
+	}
+
+	do {
+		const char *key = NULL;
+		if ( !ReadString( reader, &key ) || !Consume( reader, ':' ) ) {
+			return false;
+		}
+
+		bool8 read = false;
+		if ( String_Equals( key, "name" ) ) {
+			read = ReadString( reader, &outEvent->name );
+		} else if ( String_Equals( key, "ph" ) ) {
+			read = ReadString( reader, &outEvent->phase );
+		} else if ( String_Equals( key, "dur" ) ) {
+			read = ReadNumber( reader, &outEvent->durationUS );
+			outEvent->hasDuration = true;
+		} else if ( String_Equals( key, "args" ) ) {
+			read = ReadEventArgs( reader, outEvent );
+		} else {
+			read = SkipValue( reader, 1 );
+		}
+
+		if ( !read ) {
+			return false;
+		}
+	} while ( Consume( reader, ',' ) );
+
+	return Consume( reader, '}' );
+}
+
+static void AddEntry( timeTraceReport_t *report, const timeTraceCategory_t category, const char *name, const float64 timeMS ) {
+	u64 key = HashString( name, 0 );
+
+	u32 entryIndex = HM_GetValue( report->entryIndices[category], key );
+
+	if ( entryIndex == HASHMAP_INVALID_VALUE ) {
+		entryIndex = TruncCast( u32, report->entries[category].count );
+		HM_SetValue( report->entryIndices[category], key, entryIndex );
+
+		report->entries[category].Add( { String_Alloc( report->allocator, name, strlen( name ) + 1 ).data, 0.0, 0 } );
+	}
+
+	timeTraceEntry_t *entry = &report->entries[category][entryIndex];
+	entry->totalMS += timeMS;
+	entry->count += 1;
+}
+
+static void AddEvent( timeTraceReport_t *report, const traceEvent_t *event ) {
+	// only complete events have a duration, the rest are metadata
+	if ( !event->name || !event->phase || !event->hasDuration || !String_Equals( event->phase, "X" ) ) {
+		return;
+	}
+
+	// clang adds up each kind of event itself at the end of the trace, we do our own
+	if ( String_StartsWith( event->name, "Total " ) ) {
+		return;
+	}
+
+	float64 timeMS = event->durationUS / 1000.0;
+
+	bool8 hasDetail = event->detail && event->detail[0];
+
+	if ( String_Equals( event->name, "Frontend" ) ) {
+		report->frontendMS += timeMS;
+	} else if ( String_Equals( event->name, "Backend" ) ) {
+		report->backendMS += timeMS;
+	} else if ( String_Equals( event->name, "Source" ) ) {
+		if ( hasDetail ) {
+			AddEntry( report, TIME_TRACE_CATEGORY_HEADERS, event->detail, timeMS );
+		}
+	} else if ( String_StartsWith( event->name, "Instantiate" ) ) {
+		if ( hasDetail ) {
+			AddEntry( report, TIME_TRACE_CATEGORY_TEMPLATES, event->detail, timeMS );
+		}
+	} else if ( String_Equals( event->name, "RunPass" ) ) {
+		// the legacy pass manager (code generation still uses it) puts the name of the pass in the detail
+		if ( hasDetail ) {
+			AddEntry( report, TIME_TRACE_CATEGORY_BACKEND_PASSES, event->detail, timeMS );
+		}
+	} else if ( String_EndsWith( event->name, "Pass" ) ) {
+		// the new one names the event after the pass, and the detail is the function or module it ran on
+		AddEntry( report, TIME_TRACE_CATEGORY_BACKEND_PASSES, event->name, timeMS );
+	}
+}
+
+static int CompareEntriesByTotalTime( const void *a, const void *b ) {
+	const timeTraceEntry_t *entryA = Cast( const timeTraceEntry_t *, a );
+	const timeTraceEntry_t *entryB = Cast( const timeTraceEntry_t *, b );
+
+	if ( entryA->totalMS != entryB->totalMS ) return ( entryA->totalMS > entryB->totalMS ) ? -1 : 1;
+
+	return strcmp( entryA->name, entryB->name );
+}
+
+void TimeTrace_Init( timeTraceReport_t *report, linearAllocator_t *allocator ) {
+	Assert( report );
+	Assert( allocator );
+
+	*report = {};
+	report->allocator = allocator;
+
+	For ( u32, categoryIndex, 0, TIME_TRACE_CATEGORY_COUNT ) {
+		report->entryIndices[categoryIndex] = HM_Create( allocator, 256 );
+		report->entries[categoryIndex].Init( allocator );
+	}
+}
+
+bool8 TimeTrace_AddTrace( timeTraceReport_t *report, char *json, const u64 length ) {
+	Assert( report );
+	Assert( json );
+
+	jsonReader_t reader = {
+		.current	= json,
+		.end		= json + length,
+	};
+
+	// read all of it before adding any of it, so a broken trace doesnt count for half
+	std::vector<traceEvent_t> events;
+	bool8 foundEvents = false;
+
+	if ( !Consume( &reader, '{' ) ) {
+		return false;
+	}
+
+	if ( !Consume( &reader, '}' ) ) {
+		do {
+			const char *key = NULL;
+			if ( !ReadString( &reader, &key ) || !Consume( &reader, ':' ) ) {
+				return false;
+			}
+
+			if ( !String_Equals( key, "traceEvents" ) ) {
+				if ( !SkipValue( &reader, 1 ) ) {
+					return false;
+				}
+
+				continue;
+			}
+
+			if ( !Consume( &reader, '[' ) ) {
+				return false;
+			}
+
+			foundEvents = true;
+
+			if ( Consume( &reader, ']' ) ) {
+				continue;
+			}
+
+			do {
+				traceEvent_t event;
+				if ( !ReadEvent( &reader, &event ) ) {
+					return false;
+				}
+
+				events.push_back( event );
+			} while ( Consume( &reader, ',' ) );
+
+			if ( !Consume( &reader, ']' ) ) {
+				return false;
+			}
+		} while ( Consume( &reader, ',' ) );
+
+		if ( !Consume( &reader, '}' ) ) {
+			return false;
+		}
+	}
+
+	if ( !foundEvents ) {
+		return false;
+	}
+
+	For ( u64, eventIndex, 0, events.size() ) {
+		AddEvent( report, &events[eventIndex] );
+	}
+
+	report->numTraces += 1;
+
+	return true;
+}
+
+bool8 TimeTrace_AddTraceFile( timeTraceReport_t *report, const char *filename ) {
+	Assert( report );
+	Assert( filename );
+
+	string_t contents = {};
+	if ( !FS_ReadEntireFile( filename, &contents ) ) {
+		return false;
+	}
+
+	defer { FS_FreeFileBuffer( &contents ); };
+
+	return TimeTrace_AddTrace( report, contents.data, contents.count );
+}
+
+void TimeTrace_Sort( timeTraceReport_t *report ) {
+	Assert( report );
+
+	For ( u32, categoryIndex, 0, TIME_TRACE_CATEGORY_COUNT ) {
+		array_t<timeTraceEntry_t> *entries = &report->entries[categoryIndex];
+
+		qsort( entries->data, entries->count, sizeof( timeTraceEntry_t ), CompareEntriesByTotalTime );
+
+		// the indices moved, so the map has to be redone
+		HM_Reset( report->entryIndices[categoryIndex] );
+
+		For ( u64, entryIndex, 0, entries->count ) {
+			HM_SetValue( report->entryIndices[categoryIndex], HashString( ( *entries )[entryIndex].name, 0 ), TruncCast( u32, entryIndex ) );
+		}
+	}
+}
+
+void TimeTrace_WriteTextReport( const timeTraceReport_t *report, const char *configName, const u32 maxEntries, stringBuilder_t *sb ) {
+	Assert( report );
+	Assert( configName );
+	Assert( sb );
+
+	SB_Appendf( sb, "Time trace report for config \"%s\":\n", configName );
+
+	if ( report->numTraces == 0 ) {
+		SB_Appendf( sb, "    None of its source files left a time trace, so there's nothing to go on.\n\n" );
+		return;
+	}
+
+	SB_Appendf( sb, "    %u source files spent %.0f ms in the frontend and %.0f ms in the backend, in total.\n\n", report->numTraces, report->frontendMS, report->backendMS );
+
+	For ( u32, categoryIndex, 0, TIME_TRACE_CATEGORY_COUNT ) {
+		const array_t<timeTraceEntry_t> *entries = &report->entries[categoryIndex];
+
+		SB_Appendf( sb, "    %s:\n", g_timeTraceCategoryTitles[categoryIndex] );
+
+		if ( entries->count == 0 ) {
+			SB_Appendf( sb, "        None.\n\n" );
+			continue;
+		}
+
+		u64 numShown = Min( entries->count, Cast( u64, maxEntries ) );
+
+		For ( u64, entryIndex, 0, numShown ) {
+			const timeTraceEntry_t *entry = &( *entries )[entryIndex];
+
+			SB_Appendf( sb, "        %10.1f ms  %6ux  %s\n", entry->totalMS, entry->count, entry->name );
+		}
+
+		if ( entries->count > numShown ) {
+			SB_Appendf( sb, "        ... and %" PRIu64 " more.\n", entries->count - numShown );
+		}
+
+		SB_Appendf( sb, "\n" );
+	}
+}
+
+void TimeTrace_WriteJSONReport( const timeTraceReport_t *report, const char *configName, stringBuilder_t *sb ) {
+	Assert( report );
+	Assert( configName );
+	Assert( sb );
+
+	SB_Appendf( sb, "{\n" );
+	SB_Appendf( sb, "\t\"config\": " );
+	SB_AppendJSONString( sb, configName );
+	SB_Appendf( sb, ",\n" );
+	SB_Appendf( sb, "\t\"numSourceFiles\": %u,\n", report->numTraces );
+	SB_Appendf( sb, "\t\"frontendMS\": %.3f,\n", report->frontendMS );
+	SB_Appendf( sb, "\t\"backendMS\": %.3f", report->backendMS );
+
+	For ( u32, categoryIndex, 0, TIME_TRACE_CATEGORY_COUNT ) {
+		const array_t<timeTraceEntry_t> *entries = &report->entries[categoryIndex];
+
+		SB_Appendf( sb, ",\n\t\"%s\": [", g_timeTraceCategoryJSONNames[categoryIndex] );
+
+		For ( u64, entryIndex, 0, entries->count ) {
+			const timeTraceEntry_t *entry = &( *entries )[entryIndex];
+
+			SB_Appendf( sb, "%s\n\t\t{ \"name\": ", ( entryIndex > 0 ) ? "," : "" );
+			SB_AppendJSONString( sb, entry->name );
+			SB_Appendf( sb, ", \"totalMS\": %.3f, \"count\": %u }", entry->totalMS, entry->count );
+		}
+
+		SB_Appendf( sb, ( entries->count > 0 ) ? "\n\t]" : "]" );
+	}
+
+	SB_Appendf( sb, "\n}\n" );
+}
@@ -0,0 +1,116 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "array.h"
+
+struct hashmap_t;
+struct linearAllocator_t;
+struct stringBuilder_t;
+
+/*
+================================================================================================
+
+	Time trace report
+
+	Clang's -ftime-trace makes it write a trace of where the time went next to every object
+	file it compiles (in Chrome's trace event format, so it's JSON).  One trace only says
+	what one source file spent its time on though, and the things that make a build slow
+	(a header everything includes, a template that gets instantiated everywhere) only stand
+	out once every source file's trace gets added up.  That's what this does.
+
+	Every trace that gets added is boiled down to three lists, each one ranked by the total
+	time spent across all of them:
+
+	- Headers: how long it took to parse each header, everywhere it got included.  This
+	  includes the time it took to parse the headers it includes, so a header that only
+	  includes other expensive headers still shows up as expensive, because it is.
+	- Templates: how long it took to instantiate each template (with its template arguments).
+	- Backend passes: how long each optimisation and code generation pass took.  Passes that
+	  run other passes include the time of the passes they ran.
+
+	Clang leaves out anything quicker than -ftime-trace-granularity (half a millisecond by
+	default), so the totals are a bit less than the real thing.
+
+================================================================================================
+*/
+
+enum timeTraceCategory_t {
+	TIME_TRACE_CATEGORY_HEADERS	= 0,
+	TIME_TRACE_CATEGORY_TEMPLATES,
+	TIME_TRACE_CATEGORY_BACKEND_PASSES,
+
+	TIME_TRACE_CATEGORY_COUNT
+};
+
+struct timeTraceEntry_t {
+	const char	*name;
+	float64		totalMS;
+
+	// how many times it showed up, across every trace
+	u32			count;
+};
+
+struct timeTraceReport_t {
+	linearAllocator_t			*allocator;
+
+	// keyed by HashString() of the entry's name, the values are indices into 'entries'
+	hashmap_t					*entryIndices[TIME_TRACE_CATEGORY_COUNT];
+
+	// most time first, once TimeTrace_Sort() has been called
+	array_t<timeTraceEntry_t>	entries[TIME_TRACE_CATEGORY_COUNT];
+
+	u32							numTraces;
+
+	// in total, across every trace
+	float64						frontendMS;
+	float64						backendMS;
+};
+
+// Everything in the report gets allocated from 'allocator'.
+void	TimeTrace_Init( timeTraceReport_t *report, linearAllocator_t *allocator );
+
+// Adds the trace in the 'length' bytes of 'json' to the report.
+// The strings in 'json' get unescaped where they are, so it gets modified.
+// Returns false if 'json' isn't a trace, in which case nothing gets added.
+bool8	TimeTrace_AddTrace( timeTraceReport_t *report, char *json, const u64 length );
+
+// Same as TimeTrace_AddTrace(), but reads the trace from 'filename' first.
+// Returns false if the file couldn't be read or isn't a trace.
+bool8	TimeTrace_AddTraceFile( timeTraceReport_t *report, const char *filename );
+
+// Ranks every entry by its total time.  Call this once every trace has been added.
+void	TimeTrace_Sort( timeTraceReport_t *report );
+
+// Appends a readable version of the report to 'sb', with at most 'maxEntries' entries in each list.
+void	TimeTrace_WriteTextReport( const timeTraceReport_t *report, const char *configName, const u32 maxEntries, stringBuilder_t *sb );
+
+// Appends the whole report to 'sb' as JSON.
+void	TimeTrace_WriteJSONReport( const timeTraceReport_t *report, const char *configName, stringBuilder_t *sb );
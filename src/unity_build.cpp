@@ -0,0 +1,640 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#include "unity_build.h"
+
+#include "file.h"
+#include "hash.h"
+#include "hashmap.h"
+#include "linear_allocator.h"
+#include "temp_storage.h"
+#include "string.h"
+#include "string_builder.h"
+#include "array.inl"
+#include "typecast.h"
+#include "defer.h"
+#include "debug.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+================================================================================================
+
+	Unity builds
+
+================================================================================================
+*/
+
+// a source file has to have been written at least this long after most of the config's source files to count as recently edited
+// so that all the files a checkout or a branch switch wrote at once dont count
+#define UNITY_RECENTLY_EDITED_MIN_SECONDS	( 5 * 60 )
+
+// when a new batch gets filled, only this many of the source files that still need a batch get looked at for each slot
+// theyre sorted by path, so these are the ones in the same folders anyway, and it keeps batching thousands of files from taking forever
+#define UNITY_BATCH_SEARCH_WINDOW			128
+
+#define UNITY_FILE_BATCH_SIZE_PREFIX		"batch size: "
+#define UNITY_FILE_COLLIDES_PREFIX			"collides: "
+
+// the files a source file #includes, as sorted hashes of exactly whats written between the quotes or angle brackets
+// thats close enough to tell which source files include the same things without having to run the preprocessor
+struct includeSet_t {
+	u64	*hashes;
+	u32	count;
+};
+
+// C and C++ source files cant go in the same batch, the batch compiles as whichever one its generated source file is
+static bool8 IsCSourceFile( const char *filename ) {
+	return String_EndsWith( filename, ".c" );
+}
+
+static int CompareU64s( const void *a, const void *b ) {
+	u64 lhs = *Cast( const u64 *, a );
+	u64 rhs = *Cast( const u64 *, b );
+
+	return ( lhs < rhs ) ? -1 : ( lhs > rhs ) ? 1 : 0;
+}
+
+static int CompareFileTimes( const void *a, const void *b ) {
+	return CompareU64s( a, b );
+}
+
+static void IncludeSet_Read( const char *filename, linearAllocator_t *allocator, includeSet_t *outSet ) {
+	*outSet = {};
+
+	string_t contents = {};
+	if ( !FS_ReadEntireFile( filename, &contents ) ) {
+		return;
+	}
+
+	defer { FS_FreeFileBuffer( &contents ); };
+
+	array_t<u64> hashes;
+	hashes.Init( allocator );
+
+	const char *current = contents.data;
+	const char *end = contents.data + contents.count;
+
+	while ( current < end ) {
+		while ( current < end && ( *current == ' ' || *current == '\t' ) ) {
+			current += 1;
+		}
+
+		if ( current < end && *current == '#' ) {
+			current += 1;
+
+			while ( current < end && ( *current == ' ' || *current == '\t' ) ) {
+				current += 1;
+			}
+
+			if ( end - current > 7 && strncmp( current, "include", 7 ) == 0 ) {
+				current += 7;
+
+				while ( current < end && ( *current == ' ' || *current == '\t' ) ) {
+					current += 1;
+				}
+
+				if ( current < end && ( *current == '"' || *current == '<' ) ) {
+					char close = ( *current == '"' ) ? '"' : '>';
+
+					const char *nameStart = current + 1;
+					const char *nameEnd = nameStart;
+
+					while ( nameEnd < end && *nameEnd != close && *nameEnd != '\n' ) {
+						nameEnd += 1;
+					}
+
+					if ( nameEnd < end && *nameEnd == close ) {
+						hashes.Add( Hash64( nameStart, Cast( u64, nameEnd - nameStart ), 0 ) );
+					}
+
+					current = nameEnd;
+				}
+			}
+		}
+
+		while ( current < end && *current != '\n' ) {
+			current += 1;
+		}
+
+		current += 1;
+	}
+
+	if ( hashes.count == 0 ) {
+		return;
+	}
+
+	qsort( hashes.data, hashes.count, sizeof( u64 ), CompareU64s );
+
+	u64 numUnique = 1;
+	For ( u64, hashIndex, 1, hashes.count ) {
+		if ( hashes[hashIndex] != hashes[numUnique - 1] ) {
+			hashes[numUnique++] = hashes[hashIndex];
+		}
+	}
+
+	outSet->hashes = hashes.data;
+	outSet->count = TruncCast( u32, numUnique );
+}
+
+// how many includes the two sets share, out of how many there are between them
+static float64 IncludeSet_Similarity( const includeSet_t *a, const includeSet_t *b ) {
+	u32 numShared = 0;
+	u32 indexA = 0;
+	u32 indexB = 0;
+
+	while ( indexA < a->count && indexB < b->count ) {
+		if ( a->hashes[indexA] == b->hashes[indexB] ) {
+			numShared++;
+			indexA++;
+			indexB++;
+		} else if ( a->hashes[indexA] < b->hashes[indexB] ) {
+			indexA++;
+		} else {
+			indexB++;
+		}
+	}
+
+	u32 numTotal = a->count + b->count - numShared;
+
+	return ( numTotal > 0 ) ? Cast( float64, numShared ) / Cast( float64, numTotal ) : 0.0;
+}
+
+// adds everything in 'other' that isnt already in 'set'
+static void IncludeSet_Merge( includeSet_t *set, const includeSet_t *other, linearAllocator_t *allocator ) {
+	if ( other->count == 0 ) {
+		return;
+	}
+
+	u64 *hashes = Cast( u64 *, Mem_Alloc( allocator, ( Cast( u64, set->count ) + other->count ) * sizeof( u64 ) ) );
+	u32 count = 0;
+
+	u32 indexA = 0;
+	u32 indexB = 0;
+
+	while ( indexA < set->count || indexB < other->count ) {
+		if ( indexB == other->count || ( indexA < set->count && set->hashes[indexA] < other->hashes[indexB] ) ) {
+			hashes[count++] = set->hashes[indexA++];
+		} else if ( indexA == set->count || other->hashes[indexB] < set->hashes[indexA] ) {
+			hashes[count++] = other->hashes[indexB++];
+		} else {
+			hashes[count++] = set->hashes[indexA++];
+			indexB++;
+		}
+	}
+
+	set->hashes = hashes;
+	set->count = count;
+}
+
+void UnityBuild_Init( unityBuild_t *unity, linearAllocator_t *allocator ) {
+	Assert( unity );
+	Assert( allocator );
+
+	*unity = {};
+	unity->allocator = allocator;
+	unity->sourceFiles.Init( allocator );
+}
+
+bool8 UnityBuild_Load( unityBuild_t *unity, const char *filename ) {
+	Assert( unity );
+	Assert( filename );
+
+	string_t contents = {};
+	if ( !FS_ReadEntireFile( filename, &contents ) ) {
+		return false;
+	}
+
+	defer { FS_FreeFileBuffer( &contents ); };
+
+	u32 batchSize = 0;
+	u32 numBatches = 0;
+
+	array_t<unitySourceFile_t> sourceFiles;
+	sourceFiles.Init( unity->allocator );
+
+	char *line = contents.data;
+
+	while ( *line ) {
+		char *lineEnd = strchr( line, '\n' );
+		char *nextLine = lineEnd ? lineEnd + 1 : line + strlen( line );
+
+		if ( !lineEnd ) {
+			lineEnd = nextLine;
+		}
+
+		if ( lineEnd > line && *( lineEnd - 1 ) == '\r' ) {
+			lineEnd -= 1;
+		}
+
+		*lineEnd = 0;
+
+		if ( line[0] == 0 || String_StartsWith( line, "//" ) ) {
+			// nothing to do
+		} else if ( String_StartsWith( line, UNITY_FILE_BATCH_SIZE_PREFIX ) ) {
+			batchSize = Cast( u32, strtoul( line + strlen( UNITY_FILE_BATCH_SIZE_PREFIX ), NULL, 10 ) );
+		} else if ( String_StartsWith( line, UNITY_FILE_COLLIDES_PREFIX ) ) {
+			sourceFiles.Add( {
+				.filename	= String_Alloc( unity->allocator, line + strlen( UNITY_FILE_COLLIDES_PREFIX ) ).data,
+				.batchIndex	= UNITY_BATCH_NONE,
+				.collides	= true,
+			} );
+		} else {
+			char *filenameStart = NULL;
+			u32 batchIndex = Cast( u32, strtoul( line, &filenameStart, 10 ) );
+
+			// not something we wrote, so dont trust any of it
+			if ( filenameStart == line || !String_StartsWith( filenameStart, ": " ) ) {
+				return false;
+			}
+
+			sourceFiles.Add( {
+				.filename	= String_Alloc( unity->allocator, filenameStart + 2 ).data,
+				.batchIndex	= batchIndex,
+			} );
+
+			numBatches = Max( numBatches, batchIndex + 1 );
+		}
+
+		line = nextLine;
+	}
+
+	if ( batchSize == 0 ) {
+		return false;
+	}
+
+	unity->batchSize = batchSize;
+	unity->numBatches = numBatches;
+	unity->sourceFiles = sourceFiles;
+	unity->dirty = false;
+
+	return true;
+}
+
+// by batch, then by path, with the ones that arent in a batch last
+static int CompareUnitySourceFiles( const void *a, const void *b ) {
+	const unitySourceFile_t *sourceFileA = *Cast( const unitySourceFile_t * const *, a );
+	const unitySourceFile_t *sourceFileB = *Cast( const unitySourceFile_t * const *, b );
+
+	if ( sourceFileA->batchIndex != sourceFileB->batchIndex ) {
+		return ( sourceFileA->batchIndex < sourceFileB->batchIndex ) ? -1 : 1;
+	}
+
+	return strcmp( sourceFileA->filename, sourceFileB->filename );
+}
+
+bool8 UnityBuild_Save( unityBuild_t *unity, const char *filename ) {
+	Assert( unity );
+	Assert( filename );
+
+	if ( !unity->dirty ) {
+		return true;
+	}
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	const unitySourceFile_t **sortedSourceFiles = Cast( const unitySourceFile_t **, Mem_TempAlloc( Max( unity->sourceFiles.count, 1ULL ) * sizeof( const unitySourceFile_t * ) ) );
+	For ( u64, sourceFileIndex, 0, unity->sourceFiles.count ) {
+		sortedSourceFiles[sourceFileIndex] = &unity->sourceFiles[sourceFileIndex];
+	}
+
+	qsort( sortedSourceFiles, unity->sourceFiles.count, sizeof( const unitySourceFile_t * ), CompareUnitySourceFiles );
+
+	stringBuilder_t builder = SB_Create( Mem_GetTempStorage() );
+
+	SB_Appendf( &builder, "// Which batch each of this config's source files goes in (see BuildConfig::unityBuild).\n" );
+	SB_Appendf( &builder, "// Generated by Builder.  Delete this to have Builder put every source file in a batch again from scratch.\n" );
+	SB_Appendf( &builder, UNITY_FILE_BATCH_SIZE_PREFIX "%u\n", unity->batchSize );
+
+	For ( u64, sourceFileIndex, 0, unity->sourceFiles.count ) {
+		const unitySourceFile_t *sourceFile = sortedSourceFiles[sourceFileIndex];
+
+		if ( sourceFile->collides ) {
+			SB_Appendf( &builder, UNITY_FILE_COLLIDES_PREFIX "%s\n", sourceFile->filename );
+		} else if ( sourceFile->batchIndex != UNITY_BATCH_NONE ) {
+			SB_Appendf( &builder, "%u: %s\n", sourceFile->batchIndex, sourceFile->filename );
+		}
+	}
+
+	const char *contents = SB_ToString( &builder );
+
+	if ( !FS_WriteEntireFile( filename, contents, strlen( contents ) ) ) {
+		return false;
+	}
+
+	unity->dirty = false;
+
+	return true;
+}
+
+void UnityBuild_AssignBatches( unityBuild_t *unity, const char * const *sourceFiles, const u32 numSourceFiles, const u32 batchSize ) {
+	Assert( unity );
+	Assert( sourceFiles || numSourceFiles == 0 );
+	Assert( batchSize > 0 );
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	// batches of a different size means every batch is different anyway
+	if ( unity->batchSize != batchSize ) {
+		For ( u64, sourceFileIndex, 0, unity->sourceFiles.count ) {
+			unity->sourceFiles[sourceFileIndex].batchIndex = UNITY_BATCH_NONE;
+		}
+
+		unity->batchSize = batchSize;
+		unity->numBatches = 0;
+		unity->dirty = true;
+	}
+
+	// keep what we knew about the source files that are still here, and forget the rest
+	{
+		hashmap_t *oldIndices = HM_Create( Mem_GetTempStorage(), Max( TruncCast( u32, unity->sourceFiles.count * 2 ), 1U ) );
+
+		For ( u64, sourceFileIndex, 0, unity->sourceFiles.count ) {
+			HM_SetValue( oldIndices, HashString( unity->sourceFiles[sourceFileIndex].filename, 0 ), TruncCast( u32, sourceFileIndex ) );
+		}
+
+		array_t<unitySourceFile_t> newSourceFiles;
+		newSourceFiles.Init( unity->allocator );
+		newSourceFiles.Reserve( numSourceFiles );
+
+		u32 numKept = 0;
+
+		For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+			u32 oldIndex = HM_GetValue( oldIndices, HashString( sourceFiles[sourceFileIndex], 0 ) );
+
+			if ( oldIndex != HASHMAP_INVALID_VALUE && strcmp( unity->sourceFiles[oldIndex].filename, sourceFiles[sourceFileIndex] ) == 0 ) {
+				newSourceFiles.Add( unity->sourceFiles[oldIndex] );
+				numKept++;
+			} else {
+				newSourceFiles.Add( {
+					.filename	= String_Alloc( unity->allocator, sourceFiles[sourceFileIndex] ).data,
+					.batchIndex	= UNITY_BATCH_NONE,
+				} );
+			}
+		}
+
+		if ( numKept != unity->sourceFiles.count ) {
+			unity->dirty = true;
+		}
+
+		unity->sourceFiles = newSourceFiles;
+	}
+
+	array_t<unitySourceFile_t> &files = unity->sourceFiles;
+
+	u32 *batchCounts = Cast( u32 *, Mem_TempAlloc( Max( unity->numBatches, 1U ) * sizeof( u32 ) ) );
+	memset( batchCounts, 0, Max( unity->numBatches, 1U ) * sizeof( u32 ) );
+
+	array_t<u32> unassigned;
+	unassigned.Init( Mem_GetTempStorage() );
+
+	For ( u64, fileIndex, 0, files.count ) {
+		if ( files[fileIndex].collides ) {
+			continue;
+		}
+
+		if ( files[fileIndex].batchIndex == UNITY_BATCH_NONE ) {
+			unassigned.Add( TruncCast( u32, fileIndex ) );
+		} else {
+			batchCounts[files[fileIndex].batchIndex]++;
+		}
+	}
+
+	if ( unassigned.count == 0 ) {
+		return;
+	}
+
+	unity->dirty = true;
+
+	// sorted by path so that source files in the same folder end up next to each other, and so the batches always come out the same
+	{
+		const unitySourceFile_t **sortedFiles = Cast( const unitySourceFile_t **, Mem_TempAlloc( unassigned.count * sizeof( const unitySourceFile_t * ) ) );
+		For ( u64, unassignedIndex, 0, unassigned.count ) {
+			sortedFiles[unassignedIndex] = &files[unassigned[unassignedIndex]];
+		}
+
+		qsort( sortedFiles, unassigned.count, sizeof( const unitySourceFile_t * ), CompareUnitySourceFiles );
+
+		For ( u64, unassignedIndex, 0, unassigned.count ) {
+			unassigned[unassignedIndex] = TruncCast( u32, sortedFiles[unassignedIndex] - files.data );
+		}
+	}
+
+	includeSet_t *includeSets = Cast( includeSet_t *, Mem_TempAlloc( files.count * sizeof( includeSet_t ) ) );
+	bool8 *includeSetsRead = Cast( bool8 *, Mem_TempAlloc( files.count * sizeof( bool8 ) ) );
+	memset( includeSetsRead, 0, files.count * sizeof( bool8 ) );
+
+	auto GetIncludeSet = [&]( const u32 fileIndex ) -> const includeSet_t * {
+		if ( !includeSetsRead[fileIndex] ) {
+			IncludeSet_Read( files[fileIndex].filename, Mem_GetTempStorage(), &includeSets[fileIndex] );
+			includeSetsRead[fileIndex] = true;
+		}
+
+		return &includeSets[fileIndex];
+	};
+
+	auto RemoveAssigned = [&files, &unassigned]() {
+		u64 numLeft = 0;
+		For ( u64, unassignedIndex, 0, unassigned.count ) {
+			if ( files[unassigned[unassignedIndex]].batchIndex == UNITY_BATCH_NONE ) {
+				unassigned[numLeft++] = unassigned[unassignedIndex];
+			}
+		}
+		unassigned.count = numLeft;
+	};
+
+	// top up the batches we already had first, but only with source files that have something in common with whats already in there
+	// filling them with anything else would compile them again for nothing
+	For ( u32, batchIndex, 0, unity->numBatches ) {
+		if ( batchCounts[batchIndex] == 0 || batchCounts[batchIndex] >= batchSize ) {
+			continue;
+		}
+
+		includeSet_t batchIncludes = {};
+		bool8 batchIsC = false;
+		For ( u64, fileIndex, 0, files.count ) {
+			if ( files[fileIndex].batchIndex == batchIndex ) {
+				IncludeSet_Merge( &batchIncludes, GetIncludeSet( TruncCast( u32, fileIndex ) ), Mem_GetTempStorage() );
+				batchIsC = IsCSourceFile( files[fileIndex].filename );
+			}
+		}
+
+		while ( batchCounts[batchIndex] < batchSize ) {
+			u32 bestFileIndex = U32_MAX;
+			float64 bestSimilarity = 0.0;
+
+			For ( u64, unassignedIndex, 0, unassigned.count ) {
+				u32 fileIndex = unassigned[unassignedIndex];
+
+				if ( files[fileIndex].batchIndex != UNITY_BATCH_NONE || IsCSourceFile( files[fileIndex].filename ) != batchIsC ) {
+					continue;
+				}
+
+				float64 similarity = IncludeSet_Similarity( GetIncludeSet( fileIndex ), &batchIncludes );
+
+				if ( similarity > bestSimilarity ) {
+					bestFileIndex = fileIndex;
+					bestSimilarity = similarity;
+				}
+			}
+
+			if ( bestFileIndex == U32_MAX ) {
+				break;
+			}
+
+			files[bestFileIndex].batchIndex = batchIndex;
+			batchCounts[batchIndex]++;
+
+			IncludeSet_Merge( &batchIncludes, GetIncludeSet( bestFileIndex ), Mem_GetTempStorage() );
+		}
+	}
+
+	RemoveAssigned();
+
+	// everything else goes in new batches
+	// each one starts with the first source file that still needs a batch, then takes whichever ones include the most similar files to whats in there already
+	while ( unassigned.count > 0 ) {
+		u32 batchIndex = unity->numBatches++;
+
+		u32 seedFileIndex = unassigned[0];
+		files[seedFileIndex].batchIndex = batchIndex;
+
+		bool8 batchIsC = IsCSourceFile( files[seedFileIndex].filename );
+
+		includeSet_t batchIncludes = {};
+		IncludeSet_Merge( &batchIncludes, GetIncludeSet( seedFileIndex ), Mem_GetTempStorage() );
+
+		u32 batchCount = 1;
+
+		while ( batchCount < batchSize ) {
+			u32 bestFileIndex = U32_MAX;
+			float64 bestSimilarity = -1.0;
+
+			u64 numCandidates = Min( unassigned.count, Cast( u64, UNITY_BATCH_SEARCH_WINDOW + batchCount ) );
+
+			For ( u64, unassignedIndex, 1, numCandidates ) {
+				u32 fileIndex = unassigned[unassignedIndex];
+
+				if ( files[fileIndex].batchIndex != UNITY_BATCH_NONE || IsCSourceFile( files[fileIndex].filename ) != batchIsC ) {
+					continue;
+				}
+
+				float64 similarity = IncludeSet_Similarity( GetIncludeSet( fileIndex ), &batchIncludes );
+
+				if ( similarity > bestSimilarity ) {
+					bestFileIndex = fileIndex;
+					bestSimilarity = similarity;
+				}
+			}
+
+			if ( bestFileIndex == U32_MAX ) {
+				break;
+			}
+
+			files[bestFileIndex].batchIndex = batchIndex;
+			batchCount++;
+
+			IncludeSet_Merge( &batchIncludes, GetIncludeSet( bestFileIndex ), Mem_GetTempStorage() );
+		}
+
+		RemoveAssigned();
+	}
+}
+
+void UnityBuild_FindRecentlyEditedFiles( const char * const *sourceFiles, const u32 numSourceFiles, const u64 recentlyEditedTime, bool8 *outRecentlyEdited ) {
+	Assert( sourceFiles || numSourceFiles == 0 );
+	Assert( outRecentlyEdited || numSourceFiles == 0 );
+
+	if ( numSourceFiles == 0 ) {
+		return;
+	}
+
+	u64 marker = Mem_TempTell();
+	defer { Mem_TempRewindTo( marker ); };
+
+	fileStat_t *fileStats = Cast( fileStat_t *, Mem_TempAlloc( numSourceFiles * sizeof( fileStat_t ) ) );
+	bool8 *filesExist = Cast( bool8 *, Mem_TempAlloc( numSourceFiles * sizeof( bool8 ) ) );
+
+	FS_GetFileStats( sourceFiles, numSourceFiles, fileStats, filesExist );
+
+	// a fresh checkout writes every file at once, which doesnt mean anyone is working on them
+	// so a source file only counts as recently edited if it was also written a while after most of the others were
+	u64 typicalLastWriteTime = 0;
+	{
+		u64 *lastWriteTimes = Cast( u64 *, Mem_TempAlloc( numSourceFiles * sizeof( u64 ) ) );
+		u32 numLastWriteTimes = 0;
+
+		For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+			if ( filesExist[sourceFileIndex] ) {
+				lastWriteTimes[numLastWriteTimes++] = fileStats[sourceFileIndex].lastWriteTime;
+			}
+		}
+
+		if ( numLastWriteTimes > 0 ) {
+			qsort( lastWriteTimes, numLastWriteTimes, sizeof( u64 ), CompareFileTimes );
+
+			typicalLastWriteTime = lastWriteTimes[numLastWriteTimes / 2];
+		}
+	}
+
+	u32 numRecentlyEdited = 0;
+
+	For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+		u64 lastWriteTime = fileStats[sourceFileIndex].lastWriteTime;
+
+		outRecentlyEdited[sourceFileIndex] = filesExist[sourceFileIndex] && lastWriteTime > recentlyEditedTime && lastWriteTime > typicalLastWriteTime + UNITY_RECENTLY_EDITED_MIN_SECONDS * FILE_TIME_UNITS_PER_SECOND;
+
+		if ( outRecentlyEdited[sourceFileIndex] ) {
+			numRecentlyEdited++;
+		}
+	}
+
+	// nobody edits that many files by hand, so thats a pull or a branch switch rather than someone working on them
+	if ( numRecentlyEdited * 4 > numSourceFiles ) {
+		memset( outRecentlyEdited, 0, numSourceFiles * sizeof( bool8 ) );
+	}
+}
+
+const char *UnityBuild_GetSourceFileContents( const char * const *sourceFiles, const u32 numSourceFiles, linearAllocator_t *allocator ) {
+	Assert( sourceFiles || numSourceFiles == 0 );
+
+	stringBuilder_t builder = SB_Create( allocator );
+
+	SB_Appendf( &builder, "// Generated by Builder to compile these source files as one (see BuildConfig::unityBuild).\n" );
+	SB_Appendf( &builder, "// Don't edit this, it gets rewritten whenever the source files in the batch change.\n\n" );
+
+	For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+		SB_Appendf( &builder, "#include \"%s\"\n", sourceFiles[sourceFileIndex] );
+	}
+
+	return SB_ToString( &builder );
+}
@@ -0,0 +1,116 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#pragma once
+
+#include "int_types.h"
+#include "array.h"
+
+struct linearAllocator_t;
+
+/*
+================================================================================================
+
+	Unity builds
+
+	A unity build (or "jumbo" build) compiles a config's source files in batches, by generating
+	a source file for each batch that #includes every source file in it.  Every header the
+	source files in a batch share only gets parsed once for the whole batch instead of once per
+	source file, and the compiler only has to start once per batch, which is where most of the
+	time goes when a project has lots of small source files.
+
+	The catch is that the source files in a batch end up in the same translation unit, so
+	anything that only had to be unique per source file (like two static functions with the
+	same name) doesn't compile anymore.  So when a batch fails, its source files get compiled on
+	their own instead, and if they all compile like that then they clash with each other and
+	never go in a batch again.
+
+	Which batch each source file is in gets remembered between builds.  Adding or removing a
+	source file only changes the batch it goes in or comes out of, rather than shuffling every
+	other source file into a different batch (which would compile all of them again).  New
+	source files go in whichever batch #includes the most similar set of files, so that batches
+	share as many headers as possible.
+
+	Source files that were edited recently (in the last day, and after most of the config's
+	other source files were) get compiled on their own while someone is working on them, so
+	each edit only compiles that one file instead of its whole batch.
+
+================================================================================================
+*/
+
+#define UNITY_BUILD_DEFAULT_BATCH_SIZE	8
+
+#define UNITY_BATCH_NONE				U32_MAX
+
+struct unitySourceFile_t {
+	const char	*filename;
+
+	// UNITY_BATCH_NONE if its never going in a batch
+	u32			batchIndex;
+
+	// it failed to compile in its batch but compiled fine on its own, so it doesnt go in a batch anymore
+	bool8		collides;
+};
+
+struct unityBuild_t {
+	linearAllocator_t			*allocator;
+
+	u32							batchSize;
+
+	// every batch index is less than this, but not every batch has source files in it
+	u32							numBatches;
+
+	// every source file that can go in a batch
+	array_t<unitySourceFile_t>	sourceFiles;
+
+	// something changed since it was loaded, so it needs saving
+	bool8						dirty;
+};
+
+// Everything 'unity' needs gets allocated from 'allocator'.
+void		UnityBuild_Init( unityBuild_t *unity, linearAllocator_t *allocator );
+
+// Loads which batch each source file went in last time.
+// Returns false if the file doesn't exist or isn't one of ours, in which case everything gets put in batches from scratch.
+bool8		UnityBuild_Load( unityBuild_t *unity, const char *filename );
+
+// Writes the batches out so that the next build puts every source file back in the same one.
+// Does nothing if nothing changed since they were loaded.
+bool8		UnityBuild_Save( unityBuild_t *unity, const char *filename );
+
+// Makes sure every one of the given source files is in a batch of at most 'batchSize' source files.
+// Source files that were already in a batch stay there, and source files that aren't in 'sourceFiles' anymore get forgotten.
+// If the batch size changed then every source file gets put in a batch again from scratch.
+void		UnityBuild_AssignBatches( unityBuild_t *unity, const char * const *sourceFiles, const u32 numSourceFiles, const u32 batchSize );
+
+// Works out which of the given source files someone is working on right now, see above.
+// Source files that were written after 'recentlyEditedTime' (in FS_GetFileLastWriteTime() units) can count as recently edited.
+void		UnityBuild_FindRecentlyEditedFiles( const char * const *sourceFiles, const u32 numSourceFiles, const u64 recentlyEditedTime, bool8 *outRecentlyEdited );
+
+// Returns the contents of the source file that compiles the given source files as one batch.
+const char	*UnityBuild_GetSourceFileContents( const char * const *sourceFiles, const u32 numSourceFiles, linearAllocator_t *allocator );
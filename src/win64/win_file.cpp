@@ -37,8 +37,10 @@ SOFTWARE.
 #include "../paths.h"
 #include "../array.inl"
 #include "../string.h"
+#include "../math.h"
 
 #include <Windows.h>
+#include <winioctl.h>
 #include <string.h>
 
 /*
@@ -178,6 +180,164 @@ bool8 FS_DeleteFile( const char *filename ) {
 	return Cast( bool8, result );
 }
 
+bool8 FS_RenameFile( const char *oldFilename, const char *newFilename ) {
+	Assert( oldFilename );
+	Assert( newFilename );
+
+	return Cast( bool8, MoveFileExA( oldFilename, newFilename, MOVEFILE_REPLACE_EXISTING ) );
+}
+
+bool8 FS_CloneFile( const char *filename, const char *newFilename ) {
+	Assert( filename );
+	Assert( newFilename );
+
+	HANDLE source = CreateFileA( filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( source == INVALID_HANDLE_VALUE ) {
+		return false;
+	}
+	defer { CloseHandle( source ); };
+
+	// only ReFS does block cloning, and this fails on everything else (NTFS included) so we can bail before making the new file
+	FSCTL_GET_INTEGRITY_INFORMATION_BUFFER integrity = {};
+	DWORD bytesReturned = 0;
+	if ( !DeviceIoControl( source, FSCTL_GET_INTEGRITY_INFORMATION, NULL, 0, &integrity, sizeof( integrity ), &bytesReturned, NULL ) ) {
+		return false;
+	}
+
+	BY_HANDLE_FILE_INFORMATION sourceInfo = {};
+	if ( !GetFileInformationByHandle( source, &sourceInfo ) ) {
+		return false;
+	}
+
+	HANDLE dest = CreateFileA( newFilename, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( dest == INVALID_HANDLE_VALUE ) {
+		return false;
+	}
+
+	bool8 cloned = true;
+
+	// the new file has to match the source in these before anything can get cloned into it
+	if ( sourceInfo.dwFileAttributes & FILE_ATTRIBUTE_SPARSE_FILE ) {
+		cloned &= Cast( bool8, DeviceIoControl( dest, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &bytesReturned, NULL ) );
+	}
+
+	FSCTL_SET_INTEGRITY_INFORMATION_BUFFER setIntegrity = {};
+	setIntegrity.ChecksumAlgorithm = integrity.ChecksumAlgorithm;
+	setIntegrity.Flags = integrity.Flags;
+	cloned &= Cast( bool8, DeviceIoControl( dest, FSCTL_SET_INTEGRITY_INFORMATION, &setIntegrity, sizeof( setIntegrity ), NULL, 0, &bytesReturned, NULL ) );
+
+	u64 fileSize = ( Cast( u64, sourceInfo.nFileSizeHigh ) << 32 ) | sourceInfo.nFileSizeLow;
+
+	FILE_END_OF_FILE_INFO endOfFile = {};
+	endOfFile.EndOfFile.QuadPart = Cast( LONGLONG, fileSize );
+	cloned &= Cast( bool8, SetFileInformationByHandle( dest, FileEndOfFileInfo, &endOfFile, sizeof( endOfFile ) ) );
+
+	// each clone has to be a whole number of clusters and less than 4GB
+	// 1GB is a multiple of every cluster size ReFS has, and the last one can go past the end of the file as long as its rounded up to a whole cluster
+	const u64 chunkSize = 1ULL << 30;
+	const u64 clusterSize = integrity.ClusterSizeInBytes;
+
+	for ( u64 offset = 0; cloned && offset < fileSize; offset += chunkSize ) {
+		u64 byteCount = Min( chunkSize, fileSize - offset );
+		byteCount = ( ( byteCount + clusterSize - 1 ) / clusterSize ) * clusterSize;
+
+		DUPLICATE_EXTENTS_DATA extents = {};
+		extents.FileHandle = source;
+		extents.SourceFileOffset.QuadPart = Cast( LONGLONG, offset );
+		extents.TargetFileOffset.QuadPart = Cast( LONGLONG, offset );
+		extents.ByteCount.QuadPart = Cast( LONGLONG, byteCount );
+
+		cloned = Cast( bool8, DeviceIoControl( dest, FSCTL_DUPLICATE_EXTENTS_TO_FILE, &extents, sizeof( extents ), NULL, 0, &bytesReturned, NULL ) );
+	}
+
+	CloseHandle( dest );
+
+	// dont leave a half made file behind, the caller falls back to something else
+	if ( !cloned ) {
+		DeleteFileA( newFilename );
+	}
+
+	return cloned;
+}
+
+bool8 FS_HardLinkFile( const char *filename, const char *newFilename ) {
+	Assert( filename );
+	Assert( newFilename );
+
+	return Cast( bool8, CreateHardLinkA( newFilename, filename, NULL ) );
+}
+
+bool8 FS_CopyFile( const char *filename, const char *newFilename ) {
+	Assert( filename );
+	Assert( newFilename );
+
+	return Cast( bool8, CopyFileA( filename, newFilename, FALSE ) );
+}
+
+bool8 FS_TouchFile( const char *filename ) {
+	Assert( filename );
+
+	HANDLE file = CreateFileA( filename, FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( file == INVALID_HANDLE_VALUE ) {
+		return false;
+	}
+
+	FILETIME now;
+	GetSystemTimeAsFileTime( &now );
+
+	BOOL result = SetFileTime( file, NULL, &now, &now );
+
+	CloseHandle( file );
+
+	return Cast( bool8, result );
+}
+
+bool8 FS_MapFile( const char *filename, fileMapping_t *outMapping ) {
+	Assert( filename );
+	Assert( outMapping );
+
+	HANDLE file = CreateFileA( filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+	if ( file == INVALID_HANDLE_VALUE ) {
+		return false;
+	}
+
+	// the mapping keeps the file alive by itself
+	defer { CloseHandle( file ); };
+
+	LARGE_INTEGER fileSize = {};
+	if ( !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart == 0 ) {
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+	if ( !mapping ) {
+		return false;
+	}
+
+	void *data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+	if ( !data ) {
+		CloseHandle( mapping );
+		return false;
+	}
+
+	outMapping->data = data;
+	outMapping->sizeBytes = Cast( u64, fileSize.QuadPart );
+	outMapping->handle = Cast( u64, mapping );
+
+	return true;
+}
+
+void FS_UnmapFile( fileMapping_t *mapping ) {
+	Assert( mapping );
+
+	if ( mapping->data ) {
+		UnmapViewOfFile( mapping->data );
+		CloseHandle( Cast( HANDLE, mapping->handle ) );
+	}
+
+	*mapping = {};
+}
+
 bool8 FS_GetFileSize( const char *filename, u64 *outSize ) {
 	Assert( filename );
 	Assert( outSize );
@@ -224,6 +384,43 @@ bool8 FS_GetFileLastWriteTime( const char *filename, u64 *outLastWriteTime ) {
 	return true;
 }
 
+u64 FS_GetCurrentFileTime() {
+	FILETIME now = {};
+	GetSystemTimeAsFileTime( &now );
+
+	return ( Cast( u64, now.dwHighDateTime ) << 32 ) | now.dwLowDateTime;
+}
+
+bool8 FS_GetFileStat( const char *filename, fileStat_t *outStat ) {
+	Assert( filename );
+	Assert( outStat );
+
+	file_t file = FS_OpenFileInternal( filename, 0, OPEN_EXISTING );
+
+	if ( file.handle == INVALID_FILE_HANDLE ) {
+		return false;
+	}
+
+	defer { FS_CloseFile( &file ); };
+
+	BY_HANDLE_FILE_INFORMATION fileInfo = {};
+
+	if ( !GetFileInformationByHandle( Cast( HANDLE, file.handle ), &fileInfo ) ) {
+		return false;
+	}
+
+	outStat->fileID = ( Cast( u64, fileInfo.nFileIndexHigh ) << 32 ) | fileInfo.nFileIndexLow;
+	outStat->sizeBytes = ( Cast( u64, fileInfo.nFileSizeHigh ) << 32 ) | fileInfo.nFileSizeLow;
+	outStat->lastWriteTime = ( Cast( u64, fileInfo.ftLastWriteTime.dwHighDateTime ) << 32 ) | fileInfo.ftLastWriteTime.dwLowDateTime;
+
+	return true;
+}
+
+void FS_GetFileStats( const char * const *filenames, const u32 numFiles, fileStat_t *outStats, bool8 *outExists ) {
+	// windows has no way of batching these up (short of walking whole folders with FindFirstFile), so just spread them across threads
+	FS_GetFileStatsThreaded( filenames, numFiles, outStats, outExists );
+}
+
 bool8 FS_GetAllFilesInFolder( const char *path, const fileVisitFlags_t visitFlags, fileVisitCallback_t visitCallback, void *userData ) {
 	Assert( path );
 	Assert( visitCallback );
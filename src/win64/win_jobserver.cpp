@@ -0,0 +1,108 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#ifdef _WIN32
+
+#include "../jobserver.h"
+
+#include "../debug.h"
+#include "../typecast.h"
+
+#include <Windows.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// make on Windows uses a named semaphore instead of a pipe, every token is one count of the semaphore
+static HANDLE g_jobserverSemaphore = NULL;
+
+bool8 Jobserver_PlatformConnect( const jobserverAuth_t *auth ) {
+	Assert( auth );
+	Assert( g_jobserverSemaphore == NULL );
+
+	if ( auth->type != JOBSERVER_AUTH_TYPE_SEMAPHORE ) {
+		return false;
+	}
+
+	g_jobserverSemaphore = OpenSemaphoreA( SYNCHRONIZE | SEMAPHORE_MODIFY_STATE, FALSE, auth->name );
+
+	return g_jobserverSemaphore != NULL;
+}
+
+bool8 Jobserver_PlatformCreate( const u32 numTokens, char *outAuthArg, const u64 authArgSize ) {
+	Assert( outAuthArg );
+	Assert( g_jobserverSemaphore == NULL );
+
+	snprintf( outAuthArg, authArgSize, "builder_jobserver_%lu", GetCurrentProcessId() );
+
+	// the maximum count has to be at least 1 even if we dont have any tokens to give out
+	LONG maxCount = Cast( LONG, numTokens > 0 ? numTokens : 1 );
+
+	g_jobserverSemaphore = CreateSemaphoreA( NULL, Cast( LONG, numTokens ), maxCount, outAuthArg );
+
+	return g_jobserverSemaphore != NULL;
+}
+
+void Jobserver_PlatformDisconnect() {
+	if ( g_jobserverSemaphore ) {
+		CloseHandle( g_jobserverSemaphore );
+		g_jobserverSemaphore = NULL;
+	}
+}
+
+bool8 Jobserver_PlatformTakeToken( const u32 timeoutMS, char *outValue ) {
+	Assert( outValue );
+	Assert( g_jobserverSemaphore );
+
+	if ( WaitForSingleObject( g_jobserverSemaphore, timeoutMS ) != WAIT_OBJECT_0 ) {
+		return false;
+	}
+
+	// semaphores dont carry a value, but keep it the same as a pipe token anyway
+	*outValue = '+';
+
+	return true;
+}
+
+void Jobserver_PlatformGiveToken( const char value ) {
+	Assert( g_jobserverSemaphore );
+
+	UNUSED( value );
+
+	if ( !ReleaseSemaphore( g_jobserverSemaphore, 1, NULL ) ) {
+		Error( "Failed to give a token back to the jobserver.  Error code: " ERROR_CODE_FORMAT "\n", GetLastErrorCode() );
+	}
+}
+
+void Jobserver_PlatformSetMakeflags( const char *makeflags ) {
+	// setting it to an empty string removes it
+	// this also updates the environment that CreateProcess passes on, not just the CRT's copy
+	_putenv_s( "MAKEFLAGS", makeflags ? makeflags : "" );
+}
+
+#endif // _WIN32
@@ -29,6 +29,7 @@ SOFTWARE.
 #ifdef _WIN32
 
 #include "../os.h"
+#include "../typecast.h"
 
 #include <Windows.h>
 
@@ -56,4 +57,32 @@ u32 OS_GetNumCpuCores() {
 	return sysInfo.dwNumberOfProcessors;
 }
 
+float64 OS_GetProcessCPUTimeMS() {
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if ( !GetProcessTimes( GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime ) ) {
+		return 0.0;
+	}
+
+	u64 kernel100ns = ( Cast( u64, kernelTime.dwHighDateTime ) << 32 ) | kernelTime.dwLowDateTime;
+	u64 user100ns = ( Cast( u64, userTime.dwHighDateTime ) << 32 ) | userTime.dwLowDateTime;
+
+	return Cast( float64, kernel100ns + user100ns ) / 10000.0;
+}
+
+bool8 OS_GetMemoryStatus( memoryStatus_t *outStatus ) {
+	MEMORYSTATUSEX memoryStatus = { .dwLength = sizeof( MEMORYSTATUSEX ) };
+
+	if ( !GlobalMemoryStatusEx( &memoryStatus ) ) {
+		return false;
+	}
+
+	outStatus->totalBytes = memoryStatus.ullTotalPhys;
+	outStatus->availableBytes = memoryStatus.ullAvailPhys;
+
+	// windows doesnt have an equivalent of PSI that we can cheaply poll
+	outStatus->pressure = 0.0f;
+
+	return true;
+}
+
 #endif // _WIN32
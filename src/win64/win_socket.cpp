@@ -0,0 +1,355 @@
+/*
+===========================================================================
+
+Builder
+
+Copyright (c) 2025 Dan Moody
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===========================================================================
+*/
+
+#ifdef _WIN32
+
+#include "../socket.h"
+
+#include "../debug.h"
+#include "../typecast.h"
+#include "../thread.h"
+
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+
+#include <stdio.h>
+
+// 0 = not started, 1 = starting, 2 = started
+static atomic32_t g_winsockState;
+
+// winsock has to be started before anything else can use it, and it only needs doing once
+static bool8 Socket_InitWinsock() {
+	if ( Thread_AtomicLoad( &g_winsockState ) == 2 ) {
+		return true;
+	}
+
+	if ( Thread_AtomicCompareExchange( &g_winsockState, 0, 1 ) == 0 ) {
+		WSADATA wsaData;
+		if ( WSAStartup( MAKEWORD( 2, 2 ), &wsaData ) != 0 ) {
+			Thread_AtomicStore( &g_winsockState, 0 );
+			return false;
+		}
+
+		Thread_AtomicStore( &g_winsockState, 2 );
+	}
+
+	// someone else is starting it
+	while ( Thread_AtomicLoad( &g_winsockState ) == 1 ) {
+		Thread_Sleep( 0 );
+	}
+
+	return Thread_AtomicLoad( &g_winsockState ) == 2;
+}
+
+static void Socket_SetTimeout( const SOCKET s, const u32 timeoutMS ) {
+	DWORD timeout = timeoutMS;
+
+	setsockopt( s, SOL_SOCKET, SO_RCVTIMEO, Cast( const char *, &timeout ), sizeof( timeout ) );
+	setsockopt( s, SOL_SOCKET, SO_SNDTIMEO, Cast( const char *, &timeout ), sizeof( timeout ) );
+}
+
+// SO_SNDTIMEO doesnt apply to connect() on windows like it does on linux
+// so connect without blocking and wait for it with select() instead, then put the socket back to blocking since thats what everything else expects
+static bool8 Socket_ConnectWithTimeout( const SOCKET s, const sockaddr *address, const int addressLength, const u32 timeoutMS ) {
+	if ( timeoutMS == 0 ) {
+		return connect( s, address, addressLength ) == 0;
+	}
+
+	u_long nonBlocking = 1;
+	if ( ioctlsocket( s, FIONBIO, &nonBlocking ) != 0 ) {
+		return false;
+	}
+
+	bool8 connected = connect( s, address, addressLength ) == 0;
+
+	if ( !connected && WSAGetLastError() == WSAEWOULDBLOCK ) {
+		fd_set writeSet;
+		FD_ZERO( &writeSet );
+		FD_SET( s, &writeSet );
+
+		// windows says a connect failed through the except set, not the write set like linux
+		fd_set exceptSet;
+		FD_ZERO( &exceptSet );
+		FD_SET( s, &exceptSet );
+
+		TIMEVAL timeout = {};
+		timeout.tv_sec = Cast( long, timeoutMS / 1000 );
+		timeout.tv_usec = Cast( long, ( timeoutMS % 1000 ) * 1000 );
+
+		connected = select( 0, NULL, &writeSet, &exceptSet, &timeout ) > 0 && FD_ISSET( s, &writeSet ) && !FD_ISSET( s, &exceptSet );
+	}
+
+	nonBlocking = 0;
+	if ( ioctlsocket( s, FIONBIO, &nonBlocking ) != 0 ) {
+		return false;
+	}
+
+	return connected;
+}
+
+bool8 Socket_Connect( const char *host, const u16 port, const u32 timeoutMS, socket_t *outSocket ) {
+	Assert( host );
+	Assert( outSocket );
+
+	outSocket->handle = -1;
+
+	if ( !Socket_InitWinsock() ) {
+		return false;
+	}
+
+	char portString[8];
+	snprintf( portString, sizeof( portString ), "%u", port );
+
+	ADDRINFOA hints = {};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_protocol = IPPROTO_TCP;
+
+	ADDRINFOA *addresses = NULL;
+	if ( getaddrinfo( host, portString, &hints, &addresses ) != 0 ) {
+		return false;
+	}
+
+	for ( ADDRINFOA *address = addresses; address != NULL; address = address->ai_next ) {
+		// the compilers we run shouldnt inherit this
+		SOCKET s = WSASocketW( address->ai_family, address->ai_socktype, address->ai_protocol, NULL, 0, WSA_FLAG_OVERLAPPED | WSA_FLAG_NO_HANDLE_INHERIT );
+		if ( s == INVALID_SOCKET ) {
+			continue;
+		}
+
+		if ( timeoutMS > 0 ) {
+			Socket_SetTimeout( s, timeoutMS );
+		}
+
+		if ( !Socket_ConnectWithTimeout( s, address->ai_addr, TruncCast( int, address->ai_addrlen ), timeoutMS ) ) {
+			closesocket( s );
+			continue;
+		}
+
+		// requests are small and we want them out straight away, not sat waiting for the rest of a packet that isnt coming
+		BOOL noDelay = TRUE;
+		setsockopt( s, IPPROTO_TCP, TCP_NODELAY, Cast( const char *, &noDelay ), sizeof( noDelay ) );
+
+		outSocket->handle = Cast( s64, s );
+		break;
+	}
+
+	freeaddrinfo( addresses );
+
+	return outSocket->handle != -1;
+}
+
+// returns INVALID_SOCKET if it couldnt bind to the address
+static SOCKET Socket_BindIPv6( const u16 port, const IN6_ADDR *ipAddress ) {
+	SOCKET s = WSASocketW( AF_INET6, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED | WSA_FLAG_NO_HANDLE_INHERIT );
+
+	if ( s == INVALID_SOCKET ) {
+		return INVALID_SOCKET;
+	}
+
+	// let IPv4 connections come in through it too
+	DWORD off = 0;
+	setsockopt( s, IPPROTO_IPV6, IPV6_V6ONLY, Cast( const char *, &off ), sizeof( off ) );
+
+	sockaddr_in6 address = {};
+	address.sin6_family = AF_INET6;
+	address.sin6_port = htons( port );
+	address.sin6_addr = *ipAddress;
+
+	if ( bind( s, Cast( sockaddr *, &address ), sizeof( address ) ) != 0 ) {
+		closesocket( s );
+		return INVALID_SOCKET;
+	}
+
+	return s;
+}
+
+// returns INVALID_SOCKET if it couldnt bind to the address
+static SOCKET Socket_BindIPv4( const u16 port, const u32 ipAddress ) {
+	SOCKET s = WSASocketW( AF_INET, SOCK_STREAM, IPPROTO_TCP, NULL, 0, WSA_FLAG_OVERLAPPED | WSA_FLAG_NO_HANDLE_INHERIT );
+
+	if ( s == INVALID_SOCKET ) {
+		return INVALID_SOCKET;
+	}
+
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons( port );
+	address.sin_addr.s_addr = htonl( ipAddress );
+
+	if ( bind( s, Cast( sockaddr *, &address ), sizeof( address ) ) != 0 ) {
+		closesocket( s );
+		return INVALID_SOCKET;
+	}
+
+	return s;
+}
+
+bool8 Socket_Listen( const u16 port, const bool8 allInterfaces, socket_t *outSocket ) {
+	Assert( outSocket );
+
+	outSocket->handle = -1;
+
+	if ( !Socket_InitWinsock() ) {
+		return false;
+	}
+
+	SOCKET s = INVALID_SOCKET;
+
+	if ( allInterfaces ) {
+		// try IPv6 first, with IPv4 connections coming in through it too, otherwise just IPv4
+		s = Socket_BindIPv6( port, &in6addr_any );
+
+		if ( s == INVALID_SOCKET ) {
+			s = Socket_BindIPv4( port, INADDR_ANY );
+		}
+	} else {
+		// the IPv6 loopback address doesnt take IPv4 connections, and most things still connect to localhost over IPv4 first
+		s = Socket_BindIPv4( port, INADDR_LOOPBACK );
+
+		if ( s == INVALID_SOCKET ) {
+			s = Socket_BindIPv6( port, &in6addr_loopback );
+		}
+	}
+
+	if ( s == INVALID_SOCKET ) {
+		return false;
+	}
+
+	if ( listen( s, SOMAXCONN ) != 0 ) {
+		closesocket( s );
+		return false;
+	}
+
+	outSocket->handle = Cast( s64, s );
+
+	return true;
+}
+
+bool8 Socket_Accept( socket_t *listenSocket, socket_t *outSocket ) {
+	Assert( listenSocket );
+	Assert( outSocket );
+
+	outSocket->handle = -1;
+
+	while ( 1 ) {
+		SOCKET s = accept( Cast( SOCKET, listenSocket->handle ), NULL, NULL );
+
+		if ( s != INVALID_SOCKET ) {
+			SetHandleInformation( Cast( HANDLE, s ), HANDLE_FLAG_INHERIT, 0 );
+
+			BOOL noDelay = TRUE;
+			setsockopt( s, IPPROTO_TCP, TCP_NODELAY, Cast( const char *, &noDelay ), sizeof( noDelay ) );
+
+			outSocket->handle = Cast( s64, s );
+
+			return true;
+		}
+
+		// the client gave up before we got to it, thats not our problem
+		if ( WSAGetLastError() == WSAECONNRESET ) {
+			continue;
+		}
+
+		return false;
+	}
+}
+
+u16 Socket_GetPort( const socket_t *socket ) {
+	Assert( socket );
+
+	sockaddr_storage address = {};
+	int addressLength = sizeof( address );
+
+	if ( getsockname( Cast( SOCKET, socket->handle ), Cast( sockaddr *, &address ), &addressLength ) != 0 ) {
+		return 0;
+	}
+
+	if ( address.ss_family == AF_INET6 ) {
+		return ntohs( ( Cast( sockaddr_in6 *, &address ) )->sin6_port );
+	}
+
+	return ntohs( ( Cast( sockaddr_in *, &address ) )->sin_port );
+}
+
+bool8 Socket_Send( socket_t *socket, const void *data, const u64 size ) {
+	Assert( socket );
+	Assert( data || size == 0 );
+
+	const char *current = Cast( const char *, data );
+	u64 bytesLeft = size;
+
+	while ( bytesLeft > 0 ) {
+		int chunkSize = ( bytesLeft > INT_MAX ) ? INT_MAX : Cast( int, bytesLeft );
+
+		int bytesSent = send( Cast( SOCKET, socket->handle ), current, chunkSize, 0 );
+
+		if ( bytesSent == SOCKET_ERROR ) {
+			return false;
+		}
+
+		current += bytesSent;
+		bytesLeft -= Cast( u64, bytesSent );
+	}
+
+	return true;
+}
+
+s64 Socket_Receive( socket_t *socket, void *outBuffer, const u64 size ) {
+	Assert( socket );
+	Assert( outBuffer );
+
+	int chunkSize = ( size > INT_MAX ) ? INT_MAX : Cast( int, size );
+
+	int bytesReceived = recv( Cast( SOCKET, socket->handle ), Cast( char *, outBuffer ), chunkSize, 0 );
+
+	if ( bytesReceived == SOCKET_ERROR ) {
+		return -1;
+	}
+
+	return bytesReceived;
+}
+
+void Socket_Shutdown( socket_t *socket ) {
+	Assert( socket );
+
+	if ( socket->handle != -1 ) {
+		shutdown( Cast( SOCKET, socket->handle ), SD_BOTH );
+	}
+}
+
+void Socket_Close( socket_t *socket ) {
+	Assert( socket );
+
+	if ( socket->handle != -1 ) {
+		closesocket( Cast( SOCKET, socket->handle ) );
+		socket->handle = -1;
+	}
+}
+
+#endif // _WIN32
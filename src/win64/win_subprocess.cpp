@@ -38,6 +38,7 @@ SOFTWARE.
 #include "../defer.h"
 
 #include <Windows.h>
+#include <Psapi.h>
 
 /*
 ================================================================================================
@@ -71,7 +72,7 @@ static bool8 Proc_CloseHandleInternal( HANDLE *handle, const char *description )
 	return true;
 }
 
-process_t* Proc_Create( linearAllocator_t *allocator, array_t<const char *> *args, array_t<const char *> *environmentVariables, const processFlags_t flags ) {
+process_t* Proc_Create( linearAllocator_t *allocator, array_t<const char *> *args, array_t<const char *> *environmentVariables, const processFlags_t flags, const char *workingDirectory ) {
 	Assert( allocator );
 	Assert( args );
 	Assert( args->count > 0 );
@@ -198,7 +199,7 @@ process_t* Proc_Create( linearAllocator_t *allocator, array_t<const char *> *arg
 		true,
 		CREATE_NO_WINDOW,
 		combinedEnvVars,
-		NULL,
+		workingDirectory,
 		&startInfo,
 		&process->processInfo
 	) ) {
@@ -254,7 +255,7 @@ bool8 Proc_Destroy( process_t* process ) {
 	return true;
 }
 
-s32 Proc_Join( process_t* process ) {
+s32 Proc_Join( process_t* process, u64 *outPeakMemoryBytes, float64 *outCPUTimeMS ) {
 	Assert( process );
 
 	if ( !Proc_CloseHandleInternal( &process->stdoutRead, "subprocess stdout read" ) ) {
@@ -277,6 +278,27 @@ s32 Proc_Join( process_t* process ) {
 		return -1;
 	}
 
+	if ( outPeakMemoryBytes ) {
+		PROCESS_MEMORY_COUNTERS memoryCounters = {};
+		if ( GetProcessMemoryInfo( process->processInfo.hProcess, &memoryCounters, sizeof( memoryCounters ) ) ) {
+			*outPeakMemoryBytes = memoryCounters.PeakWorkingSetSize;
+		} else {
+			*outPeakMemoryBytes = 0;
+		}
+	}
+
+	if ( outCPUTimeMS ) {
+		FILETIME creationTime, exitTime, kernelTime, userTime;
+		if ( GetProcessTimes( process->processInfo.hProcess, &creationTime, &exitTime, &kernelTime, &userTime ) ) {
+			u64 kernel100ns = ( Cast( u64, kernelTime.dwHighDateTime ) << 32 ) | kernelTime.dwLowDateTime;
+			u64 user100ns = ( Cast( u64, userTime.dwHighDateTime ) << 32 ) | userTime.dwLowDateTime;
+
+			*outCPUTimeMS = Cast( float64, kernel100ns + user100ns ) / 10000.0;
+		} else {
+			*outCPUTimeMS = 0.0;
+		}
+	}
+
 	return TruncCast( s32, exitCode );
 }
 
@@ -111,8 +111,114 @@ s32 Thread_Wait( thread_t *thread ) {
 	return TruncCast( s32, exitCode );
 }
 
+void Thread_Sleep( const u32 milliseconds ) {
+	Sleep( milliseconds );
+}
+
+mutex_t Mutex_Create() {
+	SRWLOCK *lock = Cast( SRWLOCK *, malloc( sizeof( SRWLOCK ) ) );
+	InitializeSRWLock( lock );
+
+	return { lock };
+}
+
+void Mutex_Destroy( mutex_t *mutex ) {
+	Assert( mutex );
+
+	// SRW locks dont need destroying, just the memory
+	free( mutex->ptr );
+	mutex->ptr = NULL;
+}
+
+void Mutex_Lock( mutex_t *mutex ) {
+	Assert( mutex );
+	Assert( mutex->ptr );
+
+	AcquireSRWLockExclusive( Cast( SRWLOCK *, mutex->ptr ) );
+}
+
+void Mutex_Unlock( mutex_t *mutex ) {
+	Assert( mutex );
+	Assert( mutex->ptr );
+
+	ReleaseSRWLockExclusive( Cast( SRWLOCK *, mutex->ptr ) );
+}
+
+semaphore_t Semaphore_Create( const u32 initialCount ) {
+	HANDLE handle = CreateSemaphoreA( NULL, Cast( LONG, initialCount ), LONG_MAX, NULL );
+
+	if ( !handle ) {
+		s32 errorCode = GetLastErrorCode();
+		FatalError( "Failed to create semaphore.  Error code: " ERROR_CODE_FORMAT "\n", errorCode );
+	}
+
+	return { handle };
+}
+
+void Semaphore_Destroy( semaphore_t *semaphore ) {
+	Assert( semaphore );
+
+	if ( semaphore->ptr ) {
+		CloseHandle( Cast( HANDLE, semaphore->ptr ) );
+		semaphore->ptr = NULL;
+	}
+}
+
+void Semaphore_Signal( semaphore_t *semaphore, const u32 count ) {
+	Assert( semaphore );
+	Assert( semaphore->ptr );
+
+	ReleaseSemaphore( Cast( HANDLE, semaphore->ptr ), Cast( LONG, count ), NULL );
+}
+
+void Semaphore_Wait( semaphore_t *semaphore ) {
+	Assert( semaphore );
+	Assert( semaphore->ptr );
+
+	DWORD result = WaitForSingleObject( Cast( HANDLE, semaphore->ptr ), INFINITE );
+
+	Assert( result != WAIT_FAILED );
+	UNUSED( result );
+}
+
+bool8 Semaphore_TryWait( semaphore_t *semaphore ) {
+	Assert( semaphore );
+	Assert( semaphore->ptr );
+
+	return WaitForSingleObject( Cast( HANDLE, semaphore->ptr ), 0 ) == WAIT_OBJECT_0;
+}
+
 u32	Thread_AtomicIncrement( atomic32_t *atomic ) {
 	return InterlockedIncrement( &atomic->value );
 }
 
+u32 Thread_AtomicAdd( atomic32_t *atomic, const u32 value ) {
+	return InterlockedAdd( Cast( volatile LONG *, &atomic->value ), Cast( LONG, value ) );
+}
+
+u32 Thread_AtomicCompareExchange( atomic32_t *atomic, const u32 expected, const u32 desired ) {
+	return InterlockedCompareExchange( Cast( volatile LONG *, &atomic->value ), Cast( LONG, desired ), Cast( LONG, expected ) );
+}
+
+u64 Thread_AtomicCompareExchange( atomic64_t *atomic, const u64 expected, const u64 desired ) {
+	return InterlockedCompareExchange64( Cast( volatile LONG64 *, &atomic->value ), Cast( LONG64, desired ), Cast( LONG64, expected ) );
+}
+
+// interlocked functions are full memory barriers, which is stronger than we need here but keeps this simple
+u32 Thread_AtomicLoad( const atomic32_t *atomic ) {
+	return InterlockedCompareExchange( Cast( volatile LONG *, &atomic->value ), 0, 0 );
+}
+
+u64 Thread_AtomicLoad( const atomic64_t *atomic ) {
+	return InterlockedCompareExchange64( Cast( volatile LONG64 *, &atomic->value ), 0, 0 );
+}
+
+void Thread_AtomicStore( atomic32_t *atomic, const u32 value ) {
+	InterlockedExchange( Cast( volatile LONG *, &atomic->value ), Cast( LONG, value ) );
+}
+
+void Thread_AtomicStore( atomic64_t *atomic, const u64 value ) {
+	InterlockedExchange64( Cast( volatile LONG64 *, &atomic->value ), Cast( LONG64, value ) );
+}
+
 #endif // _WIN32
@@ -0,0 +1,16 @@
+#include <builder.h>
+
+#include "../test_compiler_override.h"
+
+BUILDER_CALLBACK void SetBuilderOptions( BuilderOptions* options, CommandLineArgs* args ) {
+	ApplyCompilerOverride( options, args );
+
+	BuildConfig config = {
+		.sourceFiles			= { "src/*.c" },
+		.binaryName				= "test_batch_small_source_files_program",
+		.binaryFolder			= "bin",
+		.batchSmallSourceFiles	= true,
+	};
+
+	AddBuildConfig( options, &config );
+}
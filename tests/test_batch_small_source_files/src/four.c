@@ -0,0 +1,5 @@
+#include "numbers.h"
+
+int Four( void ) {
+	return 4;
+}
@@ -0,0 +1,17 @@
+// every one of these source files only takes a moment to compile, so they should all get compiled in one or two runs of the compiler
+#include "numbers.h"
+
+#include <stdio.h>
+
+int main( int argc, char** argv ) {
+	( (void) argc );
+	( (void) argv );
+
+	if ( One() + Two() + Three() + Four() != 10 ) {
+		return 1;
+	}
+
+	printf( "Batching small source files works!\n" );
+
+	return 0;
+}
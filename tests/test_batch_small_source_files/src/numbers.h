@@ -0,0 +1,6 @@
+#pragma once
+
+int One( void );
+int Two( void );
+int Three( void );
+int Four( void );
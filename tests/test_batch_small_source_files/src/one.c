@@ -0,0 +1,5 @@
+#include "numbers.h"
+
+int One( void ) {
+	return 1;
+}
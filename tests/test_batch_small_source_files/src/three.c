@@ -0,0 +1,5 @@
+#include "numbers.h"
+
+int Three( void ) {
+	return 3;
+}
@@ -0,0 +1,5 @@
+#include "numbers.h"
+
+int Two( void ) {
+	return 2;
+}
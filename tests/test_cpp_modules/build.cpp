@@ -0,0 +1,17 @@
+#include <builder.h>
+
+#include "../test_compiler_override.h"
+
+BUILDER_CALLBACK void SetBuilderOptions( BuilderOptions* options, CommandLineArgs* args ) {
+	ApplyCompilerOverride( options, args );
+
+	BuildConfig config = {
+		.sourceFiles		= { "src/*.cppm", "src/*.cpp" },
+		.binaryName			= "test_cpp_modules_program",
+		.binaryFolder		= "bin",
+		.languageVersion	= LANGUAGE_VERSION_CPP20,
+		.cppModules			= true,
+	};
+
+	AddBuildConfig( options, &config );
+}
@@ -0,0 +1,14 @@
+module;
+
+#include <stdio.h>
+
+export module greeting;
+
+// this only imports numbers, but main.cpp still needs to know where numbers' partition is
+import numbers;
+
+export void Greet() {
+	if ( Four() + Six() == 10 ) {
+		printf( "C++20 modules work!\n" );
+	}
+}
@@ -0,0 +1,16 @@
+// this has to compile last, after every module it imports (directly or not)
+import greeting;
+import numbers;
+
+int main( int argc, char** argv ) {
+	( (void) argc );
+	( (void) argv );
+
+	if ( Four() + Six() != 10 ) {
+		return 1;
+	}
+
+	Greet();
+
+	return 0;
+}
@@ -0,0 +1,10 @@
+// this has to compile after its partition, and before anything that imports it
+export module numbers;
+
+export import :detail;
+
+export int Four() {
+	return Double( 2 );
+}
+
+export int Six();
@@ -0,0 +1,6 @@
+// a partition of the numbers module, only numbers.cppm imports this
+export module numbers:detail;
+
+export int Double( int x ) {
+	return x * 2;
+}
@@ -0,0 +1,6 @@
+// a module implementation unit, this needs the compiled interface of the module its implementing
+module numbers;
+
+int Six() {
+	return Double( 3 );
+}
@@ -0,0 +1,16 @@
+#include <builder.h>
+
+#include "../test_compiler_override.h"
+
+BUILDER_CALLBACK void SetBuilderOptions( BuilderOptions* options, CommandLineArgs* args ) {
+	ApplyCompilerOverride( options, args );
+
+	BuildConfig config = {
+		.sourceFiles		= { "src/*.cpp" },
+		.precompiledHeader	= "src/pch.h",
+		.binaryName			= "test_precompiled_header_program",
+		.binaryFolder		= "bin",
+	};
+
+	AddBuildConfig( options, &config );
+}
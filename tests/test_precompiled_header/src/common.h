@@ -0,0 +1,5 @@
+#pragma once
+
+static int Common_Answer() {
+	return 42;
+}
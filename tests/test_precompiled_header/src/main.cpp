@@ -0,0 +1,18 @@
+// the precompiled header gets included before this file automatically
+// but still include it here so the program builds the same without it
+#include "pch.h"
+
+int Other();
+
+int main( int argc, char** argv ) {
+	( (void) argc );
+	( (void) argv );
+
+	if ( Common_Answer() + Other() != 84 ) {
+		return 1;
+	}
+
+	printf( "Precompiled header works!\n" );
+
+	return 0;
+}
@@ -0,0 +1,5 @@
+#include "pch.h"
+
+int Other() {
+	return Common_Answer() + (int) strlen( "" );
+}
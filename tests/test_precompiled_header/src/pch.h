@@ -0,0 +1,6 @@
+#pragma once
+
+#include "common.h"
+
+#include <stdio.h>
+#include <string.h>
@@ -0,0 +1,40 @@
+#include <builder.h>
+
+#include "../test_compiler_override.h"
+
+BUILDER_CALLBACK void SetBuilderOptions( BuilderOptions* options, CommandLineArgs* args ) {
+	ApplyCompilerOverride( options, args );
+
+	// only one link at a time, and heavy.cpp never compiles alongside another heavy file
+	options->resourcePools = {
+		{ .name = "link",  .depth = 1 },
+		{ .name = "heavy", .depth = 1 },
+	};
+
+	BuildConfig staticLib = {
+		.sourceFiles	= { "lib/lib.cpp" },
+		.binaryName		= "test_resource_pools_lib",
+		.binaryFolder	= "bin",
+		.name			= "library",
+		.linkPool		= "link",
+		.binaryType		= BINARY_TYPE_STATIC_LIBRARY,
+	};
+
+	BuildConfig program = {
+		.dependsOn			= { staticLib },
+		.sourceFiles		= { "program/*.cpp" },
+		.additionalLibPaths	= { "bin" },
+#ifdef _WIN32
+		.additionalLibs		= { "test_resource_pools_lib" },
+#else
+		.additionalLibs		= { ":test_resource_pools_lib.a" },
+#endif
+		.sourceFilePools	= { { .pool = "heavy", .sourceFiles = { "program/heavy*.cpp" } } },
+		.binaryName			= "test_resource_pools_program",
+		.binaryFolder		= "bin",
+		.name				= "program",
+		.linkPool			= "link",
+	};
+
+	AddBuildConfig( options, &program );
+}
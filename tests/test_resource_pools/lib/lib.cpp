@@ -0,0 +1,5 @@
+#include "lib.h"
+
+int GetMagicNumber() {
+	return 40;
+}
\ No newline at end of file
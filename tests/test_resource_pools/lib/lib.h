@@ -0,0 +1,3 @@
+#pragma once
+
+int	GetMagicNumber();
\ No newline at end of file
@@ -0,0 +1,3 @@
+int GetHeavyNumber() {
+	return 2;
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#include "../lib/lib.h"
+
+int GetHeavyNumber();
+
+int main( int argc, char** argv ) {
+	( (void) argc );
+	( (void) argv );
+
+	return GetMagicNumber() + GetHeavyNumber() == 42 ? 0 : 1;
+}
\ No newline at end of file
@@ -7,6 +7,28 @@
 #include "../src/string_builder.h"
 #include "../src/defer.h"
 #include "../src/temp_storage.h"
+#include "../src/linear_allocator.h"
+#include "../src/file_hash_cache.h"
+#include "../src/file_stat_memo.h"
+#include "../src/include_dependency_db.h"
+#include "../src/pch_advisor.h"
+#include "../src/header_impact.h"
+#include "../src/hashmap.h"
+#include "../src/unity_build.h"
+#include "../src/module_scanner.h"
+#include "../src/time_trace.h"
+#include "../src/build_history.h"
+#include "../src/build_trace.h"
+#include "../src/critical_path.h"
+#include "../src/thread.h"
+#include "../src/job_pool.h"
+#include "../src/jobserver.h"
+#include "../src/memory_throttle.h"
+#include "../src/compile_cache.h"
+#include "../src/compression.h"
+#include "../src/remote_cache.h"
+#include "../src/cache_server.h"
+#include "../src/os.h"
 
 #define TEMPERDEV_ASSERT Assert
 #define TEMPER_IMPLEMENTATION
@@ -16,6 +38,8 @@
 
 #include <string>
 
+#include <inttypes.h>
+
 
 static void InitTestThread() {
 	Mem_InitTempStorage( MEM_KILOBYTES( 64 ) );
@@ -232,6 +256,1818 @@ TEMPER_INVOKE_PARAMETRIC_TEST( Test_GetSourceFilesMatchingPattern, {
 } );
 
 
+TEST( Test_FileHashCache, TEMPER_FLAG_SHOULD_RUN ) {
+	// the memo is sized for tens of thousands of files up front
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 16 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	const char *filename = "test_file_hash_cache.txt";
+	const char *contents = "int main() { return 0; }\n";
+	const char *otherContents = "int main() { return 10; }\n";
+
+	defer { FS_DeleteFile( filename ); };
+
+	fileStatMemo_t *memo = FileStatMemo_Create( testScratch, NULL, 0 );
+
+	u64 originalHash = 0;
+	TEMPER_CHECK_TRUE( !FileStatMemo_GetFileHash( memo, "this_file_does_not_exist.txt", &originalHash ) );
+
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( filename, contents, strlen( contents ) ) );
+	TEMPER_CHECK_TRUE( FileStatMemo_GetFileHash( memo, filename, &originalHash ) );
+	TEMPER_CHECK_TRUE( memo->numFilesHashed.value == 1 );
+
+	// asking again in the same build must not even stat the file again
+	u32 numStatCalls = memo->numStatCalls.value;
+	u64 memoHash = 0;
+	TEMPER_CHECK_TRUE( FileStatMemo_GetFileHash( memo, filename, &memoHash ) );
+	TEMPER_CHECK_TRUE( memoHash == originalHash );
+	TEMPER_CHECK_TRUE( memo->numHashesSaved.value == 1 );
+	TEMPER_CHECK_TRUE( memo->numStatCalls.value == numStatCalls );
+
+	// writing the same bytes again must give the same hash, regardless of what happened to the timestamp
+	u64 rewrittenHash = 0;
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( filename, contents, strlen( contents ) ) );
+	FileStatMemo_Invalidate( memo );
+	TEMPER_CHECK_TRUE( FileStatMemo_GetFileHash( memo, filename, &rewrittenHash ) );
+	TEMPER_CHECK_TRUE( rewrittenHash == originalHash );
+
+	// different bytes
+	// this needs a different size too, because two writes can land in the same timestamp tick and nothing has a way of seeing those
+	u64 changedHash = 0;
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( filename, otherContents, strlen( otherContents ) ) );
+	FileStatMemo_Invalidate( memo );
+	TEMPER_CHECK_TRUE( FileStatMemo_GetFileHash( memo, filename, &changedHash ) );
+	TEMPER_CHECK_TRUE( changedHash != originalHash );
+
+	// next build: the file didnt change, so its hash must come from the file hash cache without reading the file
+	fileHashCache_t cache = {};
+	FileHashCache_Init( &cache, testScratch );
+	FileStatMemo_UpdateFileHashCache( memo, &cache );
+	TEMPER_CHECK_TRUE( cache.entries.count == 1 );
+
+	fileStatMemo_t *nextBuildMemo = FileStatMemo_Create( testScratch, &cache, 0 );
+
+	u64 cachedHash = 0;
+	TEMPER_CHECK_TRUE( FileStatMemo_GetFileHash( nextBuildMemo, filename, &cachedHash ) );
+	TEMPER_CHECK_TRUE( cachedHash == changedHash );
+	TEMPER_CHECK_TRUE( nextBuildMemo->numHashesFromCache.value == 1 );
+	TEMPER_CHECK_TRUE( nextBuildMemo->numFilesHashed.value == 0 );
+}
+
+
+TEST( Test_GetFileStats, TEMPER_FLAG_SHOULD_RUN ) {
+	const char *files[] = {
+		"tests_main.cpp",
+		"../src/builder.cpp",
+		"this_file_does_not_exist.txt",
+		"../include/builder.h",
+	};
+
+	// enough files that the batch actually gets split up rather than going down the small batch path
+	const u32 numFiles = 300;
+
+	const char *filenames[numFiles];
+	fileStat_t stats[numFiles];
+	bool8 exists[numFiles];
+
+	For ( u32, fileIndex, 0, numFiles ) {
+		filenames[fileIndex] = files[fileIndex % ( sizeof( files ) / sizeof( files[0] ) )];
+	}
+
+	FS_GetFileStats( filenames, numFiles, stats, exists );
+
+	For ( u32, fileIndex, 0, numFiles ) {
+		fileStat_t expectedStat = {};
+		bool8 expectedExists = FS_GetFileStat( filenames[fileIndex], &expectedStat );
+
+		TEMPER_CHECK_TRUE( exists[fileIndex] == expectedExists );
+
+		if ( expectedExists ) {
+			TEMPER_CHECK_TRUE( memcmp( &stats[fileIndex], &expectedStat, sizeof( fileStat_t ) ) == 0 );
+		}
+	}
+}
+
+
+struct threadQueueTest_t {
+	mutex_t		mutex;
+	semaphore_t	itemsQueued;
+	semaphore_t	itemsDone;
+	u32			numItemsQueued;
+	u32			numItemsTaken;
+	u32			total;
+};
+
+static s32 ThreadQueueTestThread( void *data ) {
+	threadQueueTest_t *test = Cast( threadQueueTest_t *, data );
+
+	while ( 1 ) {
+		Semaphore_Wait( &test->itemsQueued );
+
+		Mutex_Lock( &test->mutex );
+
+		// more signals than items means were being told to stop
+		if ( test->numItemsTaken == test->numItemsQueued ) {
+			Mutex_Unlock( &test->mutex );
+			break;
+		}
+
+		test->numItemsTaken++;
+		test->total += test->numItemsTaken;
+
+		Mutex_Unlock( &test->mutex );
+
+		Semaphore_Signal( &test->itemsDone );
+	}
+
+	return 0;
+}
+
+TEST( Test_MutexAndSemaphore, TEMPER_FLAG_SHOULD_RUN ) {
+	const u32 numThreads = 4;
+	const u32 numItems = 1000;
+
+	threadQueueTest_t test = {
+		.mutex			= Mutex_Create(),
+		.itemsQueued	= Semaphore_Create( 0 ),
+		.itemsDone		= Semaphore_Create( 0 ),
+	};
+
+	thread_t threads[numThreads];
+	For ( u32, threadIndex, 0, numThreads ) {
+		threads[threadIndex] = Thread_Create( ThreadQueueTestThread, &test );
+	}
+
+	For ( u32, itemIndex, 0, numItems ) {
+		Mutex_Lock( &test.mutex );
+		test.numItemsQueued++;
+		Mutex_Unlock( &test.mutex );
+
+		Semaphore_Signal( &test.itemsQueued );
+	}
+
+	For ( u32, itemIndex, 0, numItems ) {
+		Semaphore_Wait( &test.itemsDone );
+	}
+
+	Semaphore_Signal( &test.itemsQueued, numThreads );
+
+	For ( u32, threadIndex, 0, numThreads ) {
+		Thread_Wait( &threads[threadIndex] );
+		Thread_Destroy( &threads[threadIndex] );
+	}
+
+	TEMPER_CHECK_TRUE( test.numItemsTaken == numItems );
+	TEMPER_CHECK_TRUE( test.total == ( numItems * ( numItems + 1 ) ) / 2 );
+
+	Semaphore_Destroy( &test.itemsDone );
+	Semaphore_Destroy( &test.itemsQueued );
+	Mutex_Destroy( &test.mutex );
+}
+
+
+struct jobPoolTest_t {
+	jobCounter_t	*counter;
+	atomic32_t		total;
+	u32				value;
+	bool8			submitChild;
+	jobPoolTest_t	*child;
+};
+
+static void JobPoolTestJob( void *data ) {
+	jobPoolTest_t *job = Cast( jobPoolTest_t *, data );
+
+	// make sure jobs can use temp storage
+	u32 *value = Cast( u32 *, Mem_TempAlloc( sizeof( u32 ) ) );
+	*value = job->value;
+
+	Thread_AtomicAdd( &job->total, *value );
+
+	// jobs submitted from inside a job go on that worker's own deque
+	if ( job->submitChild ) {
+		JobPool_Submit( JobPoolTestJob, job->child, job->counter );
+	}
+}
+
+static u32 JobPoolTest_Run( const u32 numJobs ) {
+	std::vector<jobPoolTest_t> jobs( numJobs * 2 );
+
+	jobCounter_t counter;
+	JobCounter_Init( &counter );
+
+	For ( u32, jobIndex, 0, numJobs ) {
+		jobPoolTest_t *parent = &jobs[jobIndex * 2 + 0];
+		jobPoolTest_t *child = &jobs[jobIndex * 2 + 1];
+
+		*child = { .counter = &counter, .value = jobIndex + 1 };
+		*parent = { .counter = &counter, .value = jobIndex + 1, .submitChild = true, .child = child };
+	}
+
+	For ( u32, jobIndex, 0, numJobs ) {
+		JobPool_Submit( JobPoolTestJob, &jobs[jobIndex * 2], &counter, ( jobIndex % 2 ) ? JOB_PRIORITY_HIGH : JOB_PRIORITY_NORMAL );
+	}
+
+	JobPool_Wait( &counter );
+
+	JobCounter_Destroy( &counter );
+
+	u32 total = 0;
+	For ( u64, jobIndex, 0, jobs.size() ) {
+		total += Thread_AtomicLoad( &jobs[jobIndex].total );
+	}
+
+	return total;
+}
+
+TEST( Test_JobPool, TEMPER_FLAG_SHOULD_RUN ) {
+	const u32 numJobs = 1000;
+	const u32 expectedTotal = numJobs * ( numJobs + 1 );	// every value gets added by a parent and its child
+
+	// without the pool running, jobs just run straight away
+	TEMPER_CHECK_TRUE( !JobPool_IsRunning() );
+	TEMPER_CHECK_TRUE( JobPoolTest_Run( numJobs ) == expectedTotal );
+
+	JobPool_Init( 4 );
+	TEMPER_CHECK_TRUE( JobPool_IsRunning() );
+
+	// run it more than once to make sure the workers carry on working after the first batch of jobs
+	TEMPER_CHECK_TRUE( JobPoolTest_Run( numJobs ) == expectedTotal );
+	TEMPER_CHECK_TRUE( JobPoolTest_Run( numJobs ) == expectedTotal );
+
+	JobPool_Shutdown();
+	TEMPER_CHECK_TRUE( !JobPool_IsRunning() );
+}
+
+TEST( Test_JobserverParseMakeflags, TEMPER_FLAG_SHOULD_RUN ) {
+	jobserverAuth_t auth;
+
+	TEMPER_CHECK_TRUE( !Jobserver_ParseMakeflags( NULL, &auth ) );
+	TEMPER_CHECK_TRUE( !Jobserver_ParseMakeflags( "", &auth ) );
+	TEMPER_CHECK_TRUE( !Jobserver_ParseMakeflags( "ks -j8", &auth ) );
+	TEMPER_CHECK_TRUE( auth.type == JOBSERVER_AUTH_TYPE_NONE );
+
+	TEMPER_CHECK_TRUE( Jobserver_ParseMakeflags( " -j8 --jobserver-auth=3,4", &auth ) );
+	TEMPER_CHECK_TRUE( auth.type == JOBSERVER_AUTH_TYPE_PIPE );
+	TEMPER_CHECK_TRUE( auth.readFD == 3 );
+	TEMPER_CHECK_TRUE( auth.writeFD == 4 );
+
+	// older versions of make
+	TEMPER_CHECK_TRUE( Jobserver_ParseMakeflags( "k -j --jobserver-fds=5,6 -l4", &auth ) );
+	TEMPER_CHECK_TRUE( auth.type == JOBSERVER_AUTH_TYPE_PIPE );
+	TEMPER_CHECK_TRUE( auth.readFD == 5 );
+	TEMPER_CHECK_TRUE( auth.writeFD == 6 );
+
+	TEMPER_CHECK_TRUE( Jobserver_ParseMakeflags( "-j8 --jobserver-auth=fifo:/tmp/GMfifo1234 -Otarget", &auth ) );
+	TEMPER_CHECK_TRUE( auth.type == JOBSERVER_AUTH_TYPE_FIFO );
+	TEMPER_CHECK_TRUE( strcmp( auth.name, "/tmp/GMfifo1234" ) == 0 );
+
+	TEMPER_CHECK_TRUE( Jobserver_ParseMakeflags( "-j8 --jobserver-auth=gmake_semaphore_1234", &auth ) );
+	TEMPER_CHECK_TRUE( auth.type == JOBSERVER_AUTH_TYPE_SEMAPHORE );
+	TEMPER_CHECK_TRUE( strcmp( auth.name, "gmake_semaphore_1234" ) == 0 );
+
+	// the last one wins, same as make
+	TEMPER_CHECK_TRUE( Jobserver_ParseMakeflags( "-j8 --jobserver-auth=3,4 -j2 --jobserver-fds=7,8", &auth ) );
+	TEMPER_CHECK_TRUE( auth.readFD == 7 );
+	TEMPER_CHECK_TRUE( auth.writeFD == 8 );
+
+	// make tells sub-makes it can't use the jobserver like this
+	TEMPER_CHECK_TRUE( !Jobserver_ParseMakeflags( "-j8 --jobserver-auth=-2,-2", &auth ) );
+}
+
+TEST( Test_Jobserver, TEMPER_FLAG_SHOULD_RUN ) {
+	const u32 numJobs = 3;
+
+	const char *oldMakeflags = getenv( "MAKEFLAGS" );
+	std::string oldMakeflagsCopy = oldMakeflags ? oldMakeflags : "";
+
+	// the test runner itself could be getting run by make, in which case we'd be a client instead
+	jobserverMode_t mode = Jobserver_Init( numJobs );
+	TEMPER_CHECK_TRUE( mode != JOBSERVER_MODE_NONE );
+
+	if ( mode == JOBSERVER_MODE_SERVER ) {
+		// anything we run has to be able to find our jobserver
+		jobserverAuth_t auth;
+		TEMPER_CHECK_TRUE( Jobserver_ParseMakeflags( getenv( "MAKEFLAGS" ), &auth ) );
+		TEMPER_CHECK_TRUE( auth.type != JOBSERVER_AUTH_TYPE_NONE );
+
+		// one implicit slot, and a token for every other one
+		jobserverToken_t tokens[numJobs];
+		For ( u32, tokenIndex, 0, numJobs ) {
+			tokens[tokenIndex] = Jobserver_AcquireToken();
+		}
+
+		TEMPER_CHECK_TRUE( tokens[0].isImplicit );
+		TEMPER_CHECK_TRUE( !tokens[1].isImplicit );
+		TEMPER_CHECK_TRUE( !tokens[2].isImplicit );
+
+		// every slot is taken now, so theres nothing left
+		char value;
+		TEMPER_CHECK_TRUE( !Jobserver_PlatformTakeToken( 0, &value ) );
+
+		For ( u32, tokenIndex, 0, numJobs ) {
+			Jobserver_ReleaseToken( tokens[tokenIndex] );
+		}
+
+		// and they all went back
+		For ( u32, tokenIndex, 0, numJobs ) {
+			tokens[tokenIndex] = Jobserver_AcquireToken();
+		}
+
+		For ( u32, tokenIndex, 0, numJobs ) {
+			Jobserver_ReleaseToken( tokens[tokenIndex] );
+		}
+	}
+
+	Jobserver_Shutdown();
+
+	// MAKEFLAGS gets put back how it was
+	const char *makeflags = getenv( "MAKEFLAGS" );
+	TEMPER_CHECK_TRUE( ( makeflags ? makeflags : "" ) == oldMakeflagsCopy );
+}
+
+TEST( Test_MemoryThrottle, TEMPER_FLAG_SHOULD_RUN ) {
+	const u64 megabyte = 1024 * 1024;
+
+	// 10 GB machine with 9 GB free, so we can use 8 GB and anything over 2 GB is a hog
+	memoryStatus_t status = {
+		.totalBytes		= 10240 * megabyte,
+		.availableBytes	= 9216 * megabyte,
+		.pressure		= 0.0f,
+	};
+
+	memoryThrottle_t throttle;
+	MemoryThrottle_Init( &throttle, &status );
+	defer { MemoryThrottle_Shutdown( &throttle ); };
+
+	TEMPER_CHECK_TRUE( throttle.budgetBytes == 8192 * megabyte );
+	TEMPER_CHECK_TRUE( !MemoryThrottle_IsHog( &throttle, 2048 * megabyte ) );
+	TEMPER_CHECK_TRUE( MemoryThrottle_IsHog( &throttle, 3072 * megabyte ) );
+
+	// the first job always gets in, even if it wants more than everything we have
+	TEMPER_CHECK_TRUE( MemoryThrottle_TryAdmit( &throttle, 16384 * megabyte, &status ) );
+	TEMPER_CHECK_TRUE( !MemoryThrottle_TryAdmit( &throttle, 256 * megabyte, &status ) );
+	MemoryThrottle_Release( &throttle, 16384 * megabyte );
+
+	// two hogs never run together, but a hog and a small job can
+	TEMPER_CHECK_TRUE( MemoryThrottle_TryAdmit( &throttle, 3072 * megabyte, &status ) );
+	TEMPER_CHECK_TRUE( !MemoryThrottle_TryAdmit( &throttle, 3072 * megabyte, &status ) );
+	TEMPER_CHECK_TRUE( MemoryThrottle_TryAdmit( &throttle, 256 * megabyte, &status ) );
+
+	// under pressure nothing else starts until it goes away again
+	status.pressure = 0.25f;
+	TEMPER_CHECK_TRUE( !MemoryThrottle_TryAdmit( &throttle, 256 * megabyte, &status ) );
+	status.pressure = 0.0f;
+
+	// same if the machine is nearly out of memory, even though our own reservations would still fit
+	status.availableBytes = 512 * megabyte;
+	TEMPER_CHECK_TRUE( !MemoryThrottle_TryAdmit( &throttle, 256 * megabyte, &status ) );
+	status.availableBytes = 9216 * megabyte;
+
+	MemoryThrottle_Release( &throttle, 3072 * megabyte );
+	TEMPER_CHECK_TRUE( MemoryThrottle_TryAdmit( &throttle, 3072 * megabyte, &status ) );
+
+	MemoryThrottle_Release( &throttle, 3072 * megabyte );
+	MemoryThrottle_Release( &throttle, 256 * megabyte );
+
+	TEMPER_CHECK_TRUE( throttle.reservedBytes == 0 );
+	TEMPER_CHECK_TRUE( throttle.numRunningHogs == 0 );
+
+	// a disabled throttle lets everything through
+	memoryThrottle_t disabledThrottle;
+	MemoryThrottle_Init( &disabledThrottle, NULL );
+	defer { MemoryThrottle_Shutdown( &disabledThrottle ); };
+
+	TEMPER_CHECK_TRUE( MemoryThrottle_TryAdmit( &disabledThrottle, 16384 * megabyte, &status ) );
+	TEMPER_CHECK_TRUE( MemoryThrottle_TryAdmit( &disabledThrottle, 16384 * megabyte, &status ) );
+	MemoryThrottle_Admit( &disabledThrottle, 16384 * megabyte );
+}
+
+TEST( Test_IncludeDependencyDB, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 1 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	const char *filename = "test_include_dependency_db.include_dependencies";
+
+	defer { FS_DeleteFile( filename ); };
+
+	const char *mainDependencies[] = { "src/shared.h", "src/main.h" };
+	const char *otherDependencies[] = { "src/shared.h" };
+
+	{
+		includeDependencyDB_t db;
+		IncludeDependencyDB_Init( &db, testScratch );
+		TEMPER_CHECK_TRUE( !IncludeDependencyDB_Load( &db, "this_file_does_not_exist.include_dependencies" ) );
+
+		u32 mainIndex = IncludeDependencyDB_AddRecord( &db, "src/main.cpp", ".builder/main.o" );
+		u32 otherIndex = IncludeDependencyDB_AddRecord( &db, "src/other.cpp", ".builder/other.o" );
+		u32 failedIndex = IncludeDependencyDB_AddRecord( &db, "src/failed.cpp", ".builder/failed.o" );
+
+		IncludeDependencyDB_SetRecord( &db, mainIndex, "src/main.cpp", mainDependencies, 2, 1, 2, 40000, 1800 );
+		IncludeDependencyDB_SetRecord( &db, otherIndex, "src/other.cpp", otherDependencies, 1, 3, 4, 250, 90 );
+		IncludeDependencyDB_InvalidateRecord( &db, failedIndex );
+		IncludeDependencyDB_SetLinkHash( &db, "bin/test.exe", 5 );
+
+		TEMPER_CHECK_TRUE( IncludeDependencyDB_Save( &db, filename ) );
+	}
+
+	includeDependencyDB_t db;
+	IncludeDependencyDB_Init( &db, testScratch );
+	TEMPER_CHECK_TRUE( IncludeDependencyDB_Load( &db, filename ) );
+	defer { IncludeDependencyDB_Save( &db, filename ); };
+
+	// every path only gets stored once, even though both files include shared.h
+	TEMPER_CHECK_TRUE( db.numFileStrings == 9 );
+	TEMPER_CHECK_TRUE( db.numFileRecords == 3 );
+	TEMPER_CHECK_TRUE( db.numFileDependencies == 3 );
+
+	u32 mainIndex = IncludeDependencyDB_FindRecord( &db, ".builder/main.o" );
+	TEMPER_CHECK_TRUE( mainIndex != INCLUDE_DEPENDENCY_DB_INVALID_INDEX );
+
+	const includeDependencyRecord_t *mainRecord = IncludeDependencyDB_GetRecord( &db, mainIndex );
+	TEMPER_CHECK_TRUE( strcmp( IncludeDependencyDB_GetString( &db, mainRecord->filenameID ), "src/main.cpp" ) == 0 );
+	TEMPER_CHECK_TRUE( mainRecord->inputsHash == 1 );
+	TEMPER_CHECK_TRUE( mainRecord->commandHash == 2 );
+	TEMPER_CHECK_TRUE( mainRecord->numDependencies == 2 );
+	TEMPER_CHECK_TRUE( mainRecord->compileTimeMS == 40000 );
+	TEMPER_CHECK_TRUE( mainRecord->peakMemoryMB == 1800 );
+
+	For ( u32, dependencyIndex, 0, mainRecord->numDependencies ) {
+		const char *dependency = IncludeDependencyDB_GetString( &db, IncludeDependencyDB_GetDependency( &db, mainRecord, dependencyIndex ) );
+		TEMPER_CHECK_TRUE( strcmp( dependency, mainDependencies[dependencyIndex] ) == 0 );
+	}
+
+	const includeDependencyRecord_t *otherRecord = IncludeDependencyDB_GetRecord( &db, IncludeDependencyDB_FindRecord( &db, ".builder/other.o" ) );
+	TEMPER_CHECK_TRUE( IncludeDependencyDB_GetDependency( &db, otherRecord, 0 ) == IncludeDependencyDB_GetDependency( &db, mainRecord, 0 ) );
+
+	const includeDependencyRecord_t *failedRecord = IncludeDependencyDB_GetRecord( &db, IncludeDependencyDB_FindRecord( &db, ".builder/failed.o" ) );
+	TEMPER_CHECK_TRUE( failedRecord->inputsHash == 0 );
+	TEMPER_CHECK_TRUE( failedRecord->compileTimeMS == 0 );
+	TEMPER_CHECK_TRUE( failedRecord->peakMemoryMB == 0 );
+
+	TEMPER_CHECK_TRUE( IncludeDependencyDB_FindRecord( &db, ".builder/never_built.o" ) == INCLUDE_DEPENDENCY_DB_INVALID_INDEX );
+
+	TEMPER_CHECK_TRUE( IncludeDependencyDB_GetLinkHash( &db, "bin/test.exe" ) == 5 );
+	TEMPER_CHECK_TRUE( IncludeDependencyDB_GetLinkHash( &db, "bin/never_linked.exe" ) == 0 );
+
+	// setting exactly what's already there is not a change, so theres nothing to write back
+	IncludeDependencyDB_SetRecord( &db, mainIndex, "src/main.cpp", mainDependencies, 2, 1, 2, 40000, 1800 );
+	IncludeDependencyDB_SetLinkHash( &db, "bin/test.exe", 5 );
+	TEMPER_CHECK_TRUE( !db.dirty );
+}
+
+TEST( Test_IncludeDependencyDB_Corrupt, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 1 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	const char *filename = "test_include_dependency_db_corrupt.include_dependencies";
+	const char *corruptFilename = "test_include_dependency_db_corrupt2.include_dependencies";
+
+	defer { FS_DeleteFile( filename ); };
+	defer { FS_DeleteFile( corruptFilename ); };
+
+	{
+		const char *dependencies[] = { "src/shared.h", "src/main.h" };
+
+		includeDependencyDB_t db;
+		IncludeDependencyDB_Init( &db, testScratch );
+
+		u32 recordIndex = IncludeDependencyDB_AddRecord( &db, "src/main.cpp", ".builder/main.o" );
+		IncludeDependencyDB_SetRecord( &db, recordIndex, "src/main.cpp", dependencies, 2, 1, 2, 100, 10 );
+		IncludeDependencyDB_SetLinkHash( &db, "bin/test.exe", 5 );
+
+		TEMPER_CHECK_TRUE( IncludeDependencyDB_Save( &db, filename ) );
+	}
+
+	string_t contents = {};
+	TEMPER_CHECK_TRUE( FS_ReadEntireFile( filename, &contents ) );
+	defer { FS_FreeFileBuffer( &contents ); };
+
+	// where everything is, going by the header at the start of the file:
+	// magic, version, numStrings, stringTableCapacity, numRecords, recordTableCapacity, numDependencies, numLinkRecords, then the u64 string data size
+	const u32 *header = Cast( const u32 *, Cast( const void *, contents.data ) );
+	const u64 numStrings = header[2];
+	const u64 stringTableCapacity = header[3];
+	const u64 numRecords = header[4];
+	const u64 recordTableCapacity = header[5];
+	const u64 numLinkRecords = header[7];
+
+	auto AlignUp8 = []( const u64 x ) -> u64 { return ( x + 7 ) & ~Cast( u64, 7 ); };
+
+	const u64 recordsOffset = 40 + numStrings * sizeof( u64 );
+	const u64 linkRecordsOffset = recordsOffset + numRecords * sizeof( includeDependencyRecord_t );
+	const u64 stringOffsetsOffset = linkRecordsOffset + numLinkRecords * sizeof( includeDependencyLinkRecord_t );
+	const u64 stringTableOffset = AlignUp8( stringOffsetsOffset + numStrings * sizeof( u32 ) );
+	const u64 recordTableOffset = AlignUp8( stringTableOffset + stringTableCapacity * sizeof( u32 ) );
+	const u64 dependenciesOffset = AlignUp8( recordTableOffset + recordTableCapacity * sizeof( u32 ) );
+
+	// the file is fine as it is
+	{
+		includeDependencyDB_t db;
+		IncludeDependencyDB_Init( &db, testScratch );
+		TEMPER_CHECK_TRUE( IncludeDependencyDB_Load( &db, filename ) );
+		IncludeDependencyDB_Save( &db, filename );
+	}
+
+	// each of these points somewhere that doesnt exist, which must get the whole file thrown away when its loaded instead of read later on
+	struct corruption_t {
+		u64	offset;
+		u32	value;
+	};
+
+	corruption_t corruptions[] = {
+		{ recordsOffset + offsetof( includeDependencyRecord_t, filenameID ),				TruncCast( u32, numStrings ) },
+		{ recordsOffset + offsetof( includeDependencyRecord_t, intermediateFilenameID ),	0xFFFFFFFF },
+		{ recordsOffset + offsetof( includeDependencyRecord_t, firstDependency ),			1 },
+		{ recordsOffset + offsetof( includeDependencyRecord_t, numDependencies ),			0xFFFFFFFF },
+		{ linkRecordsOffset + offsetof( includeDependencyLinkRecord_t, binaryFilenameID ),	TruncCast( u32, numStrings ) },
+		{ stringOffsetsOffset,																0x7FFFFFFF },
+		{ dependenciesOffset,																TruncCast( u32, numStrings ) },
+	};
+
+	For ( u64, corruptionIndex, 0, COUNT_OF( corruptions ) ) {
+		std::string corruptContents( contents.data, contents.count );
+		memcpy( &corruptContents[corruptions[corruptionIndex].offset], &corruptions[corruptionIndex].value, sizeof( u32 ) );
+
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( corruptFilename, corruptContents.data(), corruptContents.size() ) );
+
+		includeDependencyDB_t db;
+		IncludeDependencyDB_Init( &db, testScratch );
+		TEMPER_CHECK_TRUE_M( !IncludeDependencyDB_Load( &db, corruptFilename ), "Corruption %u got loaded.\n", TruncCast( u32, corruptionIndex ) );
+		TEMPER_CHECK_TRUE( db.numFileRecords == 0 );
+	}
+}
+
+TEST( Test_PCHAdvisor, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 1 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	const char *folder = "test_pch_advisor";
+
+	TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( folder ) );
+	TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( "test_pch_advisor/bits" ) );
+	defer { NukeFolder( folder, true, false ); };
+
+	const char *sharedHeader = "test_pch_advisor/shared.h";
+	const char *internalHeader = "test_pch_advisor/bits/shared_impl.h";
+	const char *rareHeader = "test_pch_advisor/rare.h";
+	const char *ignoredHeader = "test_pch_advisor/pch.h";
+	const char *deletedHeader = "test_pch_advisor/deleted.h";
+
+	std::string bigContents( 8192, ' ' );
+
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( sharedHeader, bigContents.c_str(), bigContents.size() ) );
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( internalHeader, bigContents.c_str(), bigContents.size() ) );
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( rareHeader, bigContents.c_str(), bigContents.size() ) );
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( ignoredHeader, bigContents.c_str(), bigContents.size() ) );
+
+	const u32 numSourceFiles = 16;
+
+	const char *sourceFilenames[numSourceFiles];
+	const char *intermediateFilenames[numSourceFiles];
+
+	includeDependencyDB_t db;
+	IncludeDependencyDB_Init( &db, testScratch );
+
+	For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+		sourceFilenames[sourceFileIndex] = TempPrintf( "test_pch_advisor/file%u.cpp", sourceFileIndex );
+		intermediateFilenames[sourceFileIndex] = TempPrintf( "test_pch_advisor/file%u.o", sourceFileIndex );
+
+		// only the first two include rare.h, which isnt enough to be worth making the rest load it
+		const char *dependencies[] = { ignoredHeader, sharedHeader, internalHeader, deletedHeader, rareHeader };
+		u32 numDependencies = ( sourceFileIndex < 2 ) ? 5 : 4;
+
+		u32 recordIndex = IncludeDependencyDB_AddRecord( &db, sourceFilenames[sourceFileIndex], intermediateFilenames[sourceFileIndex] );
+		IncludeDependencyDB_SetRecord( &db, recordIndex, sourceFilenames[sourceFileIndex], dependencies, numDependencies, 1, 2, 1000, 100 );
+	}
+
+	// the last one failed to compile, so it doesnt count
+	IncludeDependencyDB_InvalidateRecord( &db, IncludeDependencyDB_FindRecord( &db, intermediateFilenames[numSourceFiles - 1] ) );
+
+	pchAdvice_t advice;
+	PCHAdvisor_Analyse( &db, intermediateFilenames, numSourceFiles, &ignoredHeader, 1, NULL, testScratch, &advice );
+
+	TEMPER_CHECK_TRUE( advice.numSourceFiles == numSourceFiles );
+	TEMPER_CHECK_TRUE( advice.numSourceFilesCompiled == numSourceFiles - 1 );
+	TEMPER_CHECK_TRUE( advice.compileTimeMS == 1000.0 * ( numSourceFiles - 1 ) );
+	TEMPER_CHECK_TRUE( advice.headers.count == 4 );
+
+	const pchHeader_t *shared = NULL;
+	const pchHeader_t *internal = NULL;
+	const pchHeader_t *rare = NULL;
+	const pchHeader_t *deleted = NULL;
+
+	For ( u64, headerIndex, 0, advice.headers.count ) {
+		const pchHeader_t *header = &advice.headers[headerIndex];
+
+		// the precompiled header the config already has is never a candidate for going in itself
+		TEMPER_CHECK_TRUE( strcmp( header->filename, ignoredHeader ) != 0 );
+
+		if ( strcmp( header->filename, sharedHeader ) == 0 )	shared = header;
+		if ( strcmp( header->filename, internalHeader ) == 0 )	internal = header;
+		if ( strcmp( header->filename, rareHeader ) == 0 )		rare = header;
+		if ( strcmp( header->filename, deletedHeader ) == 0 )	deleted = header;
+	}
+
+	TEMPER_CHECK_TRUE( shared && internal && rare && deleted );
+	if ( !shared || !internal || !rare || !deleted ) {
+		return;
+	}
+
+	TEMPER_CHECK_TRUE( shared->numSourceFiles == numSourceFiles - 1 );
+	TEMPER_CHECK_TRUE( shared->sizeBytes == bigContents.size() );
+	TEMPER_CHECK_TRUE( shared->selected );
+	TEMPER_CHECK_TRUE( shared->savingsMS > 0.0 );
+	TEMPER_CHECK_TRUE( !shared->internal );
+
+	TEMPER_CHECK_TRUE( internal->selected );
+	TEMPER_CHECK_TRUE( internal->internal );
+
+	TEMPER_CHECK_TRUE( rare->numSourceFiles == 2 );
+	TEMPER_CHECK_TRUE( !rare->worthPrecompiling );
+	TEMPER_CHECK_TRUE( !rare->selected );
+
+	// a header we cant find anymore is obviously being worked on
+	TEMPER_CHECK_TRUE( deleted->worthPrecompiling );
+	TEMPER_CHECK_TRUE( deleted->recentlyChanged );
+	TEMPER_CHECK_TRUE( !deleted->selected );
+
+	TEMPER_CHECK_TRUE( advice.numSelected == 2 );
+	TEMPER_CHECK_TRUE( advice.headers[0].selected );
+
+	// bits/ headers come along with the header that includes them, so only shared.h gets included
+	const char *contents = PCHAdvisor_GetHeaderContents( &advice, testScratch );
+	TEMPER_CHECK_TRUE( contents != NULL );
+	if ( contents ) {
+		TEMPER_CHECK_TRUE( strstr( contents, "#include \"test_pch_advisor/shared.h\"" ) != NULL );
+		TEMPER_CHECK_TRUE( strstr( contents, "shared_impl.h" ) == NULL );
+		TEMPER_CHECK_TRUE( strstr( contents, "rare.h" ) == NULL );
+		TEMPER_CHECK_TRUE( strstr( contents, "deleted.h" ) == NULL );
+	}
+
+	// nothing to put in a precompiled header means theres no header at all
+	pchAdvice_t singleFileAdvice;
+	PCHAdvisor_Analyse( &db, intermediateFilenames, 1, NULL, 0, NULL, testScratch, &singleFileAdvice );
+	TEMPER_CHECK_TRUE( singleFileAdvice.numSelected == 0 );
+	TEMPER_CHECK_TRUE( PCHAdvisor_GetHeaderContents( &singleFileAdvice, testScratch ) == NULL );
+
+	// the selection survives being saved and read back in
+	char *selection = Cast( char *, Mem_Alloc( testScratch, 1024 ) );
+	snprintf( selection, 1024, "%s", PCHAdvisor_GetSelection( &advice, testScratch ) );
+
+	array_t<const char *> previousSelection;
+	previousSelection.Init( testScratch );
+	PCHAdvisor_ParseSelection( selection, &previousSelection );
+
+	TEMPER_CHECK_TRUE( previousSelection.count == 2 );
+
+	// a header that went in last time stays in, unless it doesnt exist anymore or it started changing too often
+	const char *previouslySelectedHeaders[] = { sharedHeader, internalHeader, deletedHeader };
+
+	hashmap_t *commitCounts = HM_Create( testScratch, 64 );
+	string_t internalHeaderPath = Path_AbsolutePath( testScratch, internalHeader );
+	HM_SetValue( commitCounts, HeaderImpact_HashPath( internalHeaderPath.data ), 20 );
+
+	pchHistory_t history = {
+		.previousSelection		= previouslySelectedHeaders,
+		.numPreviousSelection	= COUNT_OF( previouslySelectedHeaders ),
+		.commitCounts			= commitCounts,
+		.maxCommits				= 12,
+		.recentlyChangedTime	= 0,
+	};
+
+	pchAdvice_t stickyAdvice;
+	PCHAdvisor_Analyse( &db, intermediateFilenames, numSourceFiles, &ignoredHeader, 1, &history, testScratch, &stickyAdvice );
+
+	For ( u64, headerIndex, 0, stickyAdvice.headers.count ) {
+		const pchHeader_t *header = &stickyAdvice.headers[headerIndex];
+
+		if ( strcmp( header->filename, sharedHeader ) == 0 ) {
+			TEMPER_CHECK_TRUE( header->previouslySelected );
+			TEMPER_CHECK_TRUE( header->selected );
+			TEMPER_CHECK_TRUE( header->numCommits == 0 );
+		} else if ( strcmp( header->filename, internalHeader ) == 0 ) {
+			TEMPER_CHECK_TRUE( header->previouslySelected );
+			TEMPER_CHECK_TRUE( header->numCommits == 20 );
+			TEMPER_CHECK_TRUE( header->changesOften );
+			TEMPER_CHECK_TRUE( !header->selected );
+		} else if ( strcmp( header->filename, deletedHeader ) == 0 ) {
+			TEMPER_CHECK_TRUE( header->previouslySelected );
+			TEMPER_CHECK_TRUE( !header->selected );
+		} else {
+			TEMPER_CHECK_TRUE( !header->previouslySelected );
+		}
+	}
+
+	TEMPER_CHECK_TRUE( stickyAdvice.numSelected == 1 );
+}
+
+TEST( Test_HeaderImpact, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 1 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	const char *folder = "test_header_impact";
+
+	TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( folder ) );
+	defer { NukeFolder( folder, true, false ); };
+
+	const char *commonHeader = "test_header_impact/common.h";
+	const char *mathHeader = "test_header_impact/math_utils.h";
+	const char *umbrellaHeader = "test_header_impact/everything.h";
+
+	const char *commonContents =
+		"#ifndef COMMON_H\n"
+		"#define COMMON_H\n"
+		"#include \"math_utils.h\"\n"
+		"namespace engine {\n"
+		"	enum class logLevel_t : int { LOG_LEVEL_INFO, LOG_LEVEL_ERROR = 2 };\n"
+		"	void Log( logLevel_t level, const char *message );\n"
+		"}\n"
+		"#endif\n";
+
+	const char *mathContents =
+		"#pragma once\n"
+		"// Clamp() has a comment, which doesnt declare anything\n"
+		"template<typename T> struct vec2_t { T x, y; };\n"
+		"extern \"C\" {\n"
+		"	float Lerp( float a, float b, float t );\n"
+		"}\n"
+		"#define PI 3.14159f\n";
+
+	// only includes other headers, so theres no telling whether anyone needs it
+	const char *umbrellaContents =
+		"#pragma once\n"
+		"#include \"common.h\"\n";
+
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( commonHeader, commonContents, strlen( commonContents ) ) );
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( mathHeader, mathContents, strlen( mathContents ) ) );
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( umbrellaHeader, umbrellaContents, strlen( umbrellaContents ) ) );
+
+	const char *sourceContents[] = {
+		// uses both
+		"#include \"common.h\"\n"
+		"#include \"../test_header_impact/math_utils.h\"\n"
+		"void Foo() { engine::Log( engine::logLevel_t::LOG_LEVEL_INFO, \"\" ); float f = PI; }\n",
+
+		// uses common.h, but only mentions anything from math_utils.h in a comment and a string
+		"#include \"common.h\"\n"
+		"#include \"math_utils.h\"\n"
+		"// Lerp() would be nice here\n"
+		"void Bar() { engine::Log( engine::logLevel_t::LOG_LEVEL_ERROR, \"vec2_t\" ); }\n",
+
+		// only uses what the umbrella header brings in
+		"#include \"everything.h\"\n"
+		"void Baz() { engine::Log( engine::logLevel_t::LOG_LEVEL_INFO, \"\" ); }\n",
+	};
+
+	const u32 numSourceFiles = COUNT_OF( sourceContents );
+
+	const char *sourceFilenames[numSourceFiles];
+	const char *intermediateFilenames[numSourceFiles];
+
+	includeDependencyDB_t db;
+	IncludeDependencyDB_Init( &db, testScratch );
+
+	For ( u32, sourceFileIndex, 0, numSourceFiles ) {
+		sourceFilenames[sourceFileIndex] = TempPrintf( "test_header_impact/file%u.cpp", sourceFileIndex );
+		intermediateFilenames[sourceFileIndex] = TempPrintf( "test_header_impact/file%u.o", sourceFileIndex );
+
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( sourceFilenames[sourceFileIndex], sourceContents[sourceFileIndex], strlen( sourceContents[sourceFileIndex] ) ) );
+
+		const char *dependencies[] = { commonHeader, mathHeader, umbrellaHeader };
+		u32 numDependencies = ( sourceFileIndex == 2 ) ? 3 : 2;
+
+		u32 recordIndex = IncludeDependencyDB_AddRecord( &db, sourceFilenames[sourceFileIndex], intermediateFilenames[sourceFileIndex] );
+		IncludeDependencyDB_SetRecord( &db, recordIndex, sourceFilenames[sourceFileIndex], dependencies, numDependencies, 1, 2, ( sourceFileIndex + 1 ) * 100, 100 );
+	}
+
+	// common.h changes all the time, math_utils.h never does
+	string_t commonHeaderPath = Path_AbsolutePath( testScratch, commonHeader );
+	string_t umbrellaHeaderPath = Path_AbsolutePath( testScratch, umbrellaHeader );
+
+	hashmap_t *commitCounts = HM_Create( testScratch, 16 );
+	HM_SetValue( commitCounts, HeaderImpact_HashPath( String_Cstr( &commonHeaderPath ) ), 5 );
+	HM_SetValue( commitCounts, HeaderImpact_HashPath( String_Cstr( &umbrellaHeaderPath ) ), 1 );
+
+	headerImpactReport_t report;
+	HeaderImpact_Analyse( &db, intermediateFilenames, numSourceFiles, commitCounts, 30, testScratch, &report );
+
+	TEMPER_CHECK_TRUE( report.numSourceFiles == numSourceFiles );
+	TEMPER_CHECK_TRUE( report.numSourceFilesCompiled == numSourceFiles );
+	TEMPER_CHECK_TRUE( report.compileTimeMS == 600.0 );
+	TEMPER_CHECK_TRUE( report.knowsCommits );
+	TEMPER_CHECK_TRUE( report.headers.count == 3 );
+	TEMPER_CHECK_TRUE( report.numUnneededHeaders == 1 );
+
+	if ( report.headers.count != 3 ) {
+		return;
+	}
+
+	// most expensive first, and a header that never changes doesnt cost anything
+	const headerImpact_t *common = &report.headers[0];
+	const headerImpact_t *umbrella = &report.headers[1];
+	const headerImpact_t *math = &report.headers[2];
+
+	TEMPER_CHECK_TRUE( String_Equals( common->filename, commonHeader ) );
+	TEMPER_CHECK_TRUE( common->numSourceFiles == 3 );
+	TEMPER_CHECK_TRUE( common->rebuildTimeMS == 600.0 );
+	TEMPER_CHECK_TRUE( common->numCommits == 5 );
+	TEMPER_CHECK_TRUE( common->churnTimeMS == 3000.0 );
+	TEMPER_CHECK_TRUE( common->numDirectIncludes == 2 );
+	TEMPER_CHECK_TRUE( common->unusedBy.count == 0 );
+
+	TEMPER_CHECK_TRUE( String_Equals( umbrella->filename, umbrellaHeader ) );
+	TEMPER_CHECK_TRUE( umbrella->rebuildTimeMS == 300.0 );
+	TEMPER_CHECK_TRUE( umbrella->numDirectIncludes == 1 );
+	TEMPER_CHECK_TRUE( umbrella->unusedBy.count == 0 );
+
+	TEMPER_CHECK_TRUE( String_Equals( math->filename, mathHeader ) );
+	TEMPER_CHECK_TRUE( math->numSourceFiles == 3 );
+	TEMPER_CHECK_TRUE( math->numCommits == 0 );
+	TEMPER_CHECK_TRUE( math->churnTimeMS == 0.0 );
+	TEMPER_CHECK_TRUE( math->numDirectIncludes == 2 );
+	TEMPER_CHECK_TRUE( math->unusedBy.count == 1 );
+	TEMPER_CHECK_TRUE( math->unusedBy.count == 1 && String_Equals( math->unusedBy[0], sourceFilenames[1] ) );
+
+	// without any commit counts its only what one edit costs
+	HeaderImpact_Analyse( &db, intermediateFilenames, numSourceFiles, NULL, 30, testScratch, &report );
+
+	TEMPER_CHECK_TRUE( !report.knowsCommits );
+	TEMPER_CHECK_TRUE( report.headers.count == 3 && report.headers[2].rebuildTimeMS == 300.0 );
+}
+
+TEST( Test_UnityBuild, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 1 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	const char *folder = "test_unity_build";
+
+	TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( folder ) );
+	defer { NukeFolder( folder, true, false ); };
+
+	// sorted by path these alternate between including a.h and b.h, so the batches have to come from what they include and not just their order
+	const char *sourceFiles[] = {
+		"test_unity_build/x0.cpp",
+		"test_unity_build/x1.cpp",
+		"test_unity_build/x2.cpp",
+		"test_unity_build/x3.cpp",
+		"test_unity_build/y0.c",
+		"test_unity_build/y1.c",
+	};
+
+	const char *contents[] = {
+		"#include \"a.h\"\nint x0() { return 0; }\n",
+		"#include \"b.h\"\nint x1() { return 1; }\n",
+		"#include \"a.h\"\nint x2() { return 2; }\n",
+		"#include \"b.h\"\nint x3() { return 3; }\n",
+		"int y0( void ) { return 0; }\n",
+		"int y1( void ) { return 1; }\n",
+	};
+
+	For ( u32, sourceFileIndex, 0, COUNT_OF( sourceFiles ) ) {
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( sourceFiles[sourceFileIndex], contents[sourceFileIndex], strlen( contents[sourceFileIndex] ) ) );
+	}
+
+	const char *x4 = "test_unity_build/x4.cpp";
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( x4, contents[0], strlen( contents[0] ) ) );
+
+	unityBuild_t unity;
+	UnityBuild_Init( &unity, testScratch );
+	UnityBuild_AssignBatches( &unity, sourceFiles, COUNT_OF( sourceFiles ), 2 );
+
+	TEMPER_CHECK_TRUE( unity.dirty );
+	TEMPER_CHECK_TRUE( unity.numBatches == 3 );
+	TEMPER_CHECK_TRUE( unity.sourceFiles.count == COUNT_OF( sourceFiles ) );
+
+	// source files that include the same things go together, and C source files never go in with C++ ones
+	TEMPER_CHECK_TRUE( unity.sourceFiles[0].batchIndex == unity.sourceFiles[2].batchIndex );
+	TEMPER_CHECK_TRUE( unity.sourceFiles[1].batchIndex == unity.sourceFiles[3].batchIndex );
+	TEMPER_CHECK_TRUE( unity.sourceFiles[4].batchIndex == unity.sourceFiles[5].batchIndex );
+	TEMPER_CHECK_TRUE( unity.sourceFiles[0].batchIndex != unity.sourceFiles[1].batchIndex );
+	TEMPER_CHECK_TRUE( unity.sourceFiles[0].batchIndex != unity.sourceFiles[4].batchIndex );
+	TEMPER_CHECK_TRUE( unity.sourceFiles[1].batchIndex != unity.sourceFiles[4].batchIndex );
+
+	// round trip
+	const char *batchesFilename = "test_unity_build/batches.txt";
+
+	unity.sourceFiles[1].collides = true;
+	TEMPER_CHECK_TRUE( UnityBuild_Save( &unity, batchesFilename ) );
+	TEMPER_CHECK_TRUE( !unity.dirty );
+
+	unityBuild_t loaded;
+	UnityBuild_Init( &loaded, testScratch );
+	TEMPER_CHECK_TRUE( UnityBuild_Load( &loaded, batchesFilename ) );
+	TEMPER_CHECK_TRUE( loaded.batchSize == 2 );
+	TEMPER_CHECK_TRUE( loaded.numBatches == 3 );
+	TEMPER_CHECK_TRUE( loaded.sourceFiles.count == COUNT_OF( sourceFiles ) );
+
+	// same source files again is not a change
+	UnityBuild_AssignBatches( &loaded, sourceFiles, COUNT_OF( sourceFiles ), 2 );
+	TEMPER_CHECK_TRUE( !loaded.dirty );
+
+	For ( u32, sourceFileIndex, 0, COUNT_OF( sourceFiles ) ) {
+		TEMPER_CHECK_TRUE( strcmp( loaded.sourceFiles[sourceFileIndex].filename, sourceFiles[sourceFileIndex] ) == 0 );
+		TEMPER_CHECK_TRUE( loaded.sourceFiles[sourceFileIndex].collides == ( sourceFileIndex == 1 ) );
+
+		if ( !loaded.sourceFiles[sourceFileIndex].collides ) {
+			TEMPER_CHECK_TRUE( loaded.sourceFiles[sourceFileIndex].batchIndex == unity.sourceFiles[sourceFileIndex].batchIndex );
+		}
+	}
+
+	// x2 going away leaves a gap in x0s batch, which x4 fills because they include the same things
+	// everything else stays where it was
+	const char *changedSourceFiles[] = { sourceFiles[0], sourceFiles[1], sourceFiles[3], sourceFiles[4], sourceFiles[5], x4 };
+	UnityBuild_AssignBatches( &loaded, changedSourceFiles, COUNT_OF( changedSourceFiles ), 2 );
+
+	TEMPER_CHECK_TRUE( loaded.dirty );
+	TEMPER_CHECK_TRUE( loaded.numBatches == 3 );
+	TEMPER_CHECK_TRUE( loaded.sourceFiles.count == COUNT_OF( changedSourceFiles ) );
+	TEMPER_CHECK_TRUE( loaded.sourceFiles[0].batchIndex == unity.sourceFiles[0].batchIndex );
+	TEMPER_CHECK_TRUE( loaded.sourceFiles[2].batchIndex == unity.sourceFiles[3].batchIndex );
+	TEMPER_CHECK_TRUE( loaded.sourceFiles[3].batchIndex == unity.sourceFiles[4].batchIndex );
+	TEMPER_CHECK_TRUE( loaded.sourceFiles[5].batchIndex == unity.sourceFiles[0].batchIndex );
+
+	// source files that collide never go in a batch again
+	TEMPER_CHECK_TRUE( loaded.sourceFiles[1].collides );
+	TEMPER_CHECK_TRUE( loaded.sourceFiles[1].batchIndex == UNITY_BATCH_NONE );
+
+	// a different batch size puts everything in a batch again from scratch
+	UnityBuild_AssignBatches( &loaded, changedSourceFiles, COUNT_OF( changedSourceFiles ), 8 );
+	TEMPER_CHECK_TRUE( loaded.batchSize == 8 );
+	TEMPER_CHECK_TRUE( loaded.numBatches == 2 );
+	TEMPER_CHECK_TRUE( loaded.sourceFiles[0].batchIndex == loaded.sourceFiles[2].batchIndex );
+	TEMPER_CHECK_TRUE( loaded.sourceFiles[0].batchIndex == loaded.sourceFiles[5].batchIndex );
+	TEMPER_CHECK_TRUE( loaded.sourceFiles[0].batchIndex != loaded.sourceFiles[3].batchIndex );
+
+	// not one of ours
+	TEMPER_CHECK_TRUE( !UnityBuild_Load( &loaded, sourceFiles[0] ) );
+
+	// every source file was just written at the same time, which isnt anyone working on them
+	bool8 recentlyEdited[COUNT_OF( sourceFiles )];
+	UnityBuild_FindRecentlyEditedFiles( sourceFiles, COUNT_OF( sourceFiles ), 0, recentlyEdited );
+	For ( u32, sourceFileIndex, 0, COUNT_OF( sourceFiles ) ) {
+		TEMPER_CHECK_TRUE( !recentlyEdited[sourceFileIndex] );
+	}
+
+	const char *batchContents = UnityBuild_GetSourceFileContents( sourceFiles, 2, testScratch );
+	TEMPER_CHECK_TRUE( batchContents != NULL );
+	if ( batchContents ) {
+		const char *first = strstr( batchContents, "#include \"test_unity_build/x0.cpp\"" );
+		const char *second = strstr( batchContents, "#include \"test_unity_build/x1.cpp\"" );
+
+		TEMPER_CHECK_TRUE( first && second && first < second );
+		TEMPER_CHECK_TRUE( strstr( batchContents, "x2.cpp" ) == NULL );
+	}
+}
+
+TEST( Test_ModuleScanner, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 1 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	moduleScan_t scan;
+
+	// an interface unit, with a global module fragment and one of its own partitions
+	{
+		const char *code =
+			"module;\n"
+			"#include <stdio.h>\n"
+			"export module engine.render;\n"
+			"import core;\n"
+			"export import :shaders;\n"
+			"import <vector>;\n"
+			"import core;\n";
+
+		ModuleScanner_Scan( code, strlen( code ), testScratch, &scan );
+
+		TEMPER_CHECK_TRUE( scan.exportedModule && String_Equals( scan.exportedModule, "engine.render" ) );
+		TEMPER_CHECK_TRUE( scan.importedModules.count == 2 );
+		TEMPER_CHECK_TRUE( String_Equals( scan.importedModules[0], "core" ) );
+		TEMPER_CHECK_TRUE( String_Equals( scan.importedModules[1], "engine.render:shaders" ) );
+	}
+
+	// partitions export their full name, and an implementation unit imports the module its implementing
+	{
+		const char *partition = "export module engine.render:shaders;\n";
+
+		ModuleScanner_Scan( partition, strlen( partition ), testScratch, &scan );
+
+		TEMPER_CHECK_TRUE( scan.exportedModule && String_Equals( scan.exportedModule, "engine.render:shaders" ) );
+		TEMPER_CHECK_TRUE( scan.importedModules.count == 0 );
+
+		const char *implementation = "module engine.render;\nimport :shaders;\n\nvoid Render() {}\nmodule :private;\n";
+
+		ModuleScanner_Scan( implementation, strlen( implementation ), testScratch, &scan );
+
+		TEMPER_CHECK_TRUE( scan.exportedModule == NULL );
+		TEMPER_CHECK_TRUE( scan.importedModules.count == 2 );
+		TEMPER_CHECK_TRUE( String_Equals( scan.importedModules[0], "engine.render" ) );
+		TEMPER_CHECK_TRUE( String_Equals( scan.importedModules[1], "engine.render:shaders" ) );
+	}
+
+	// none of these are module declarations or imports
+	{
+		const char *code =
+			"// import commented;\n"
+			"/* export module\n"
+			"import also_commented; */\n"
+			"#define X import not_a_directive;\n"
+			"const char *s = R\"(\n"
+			"import raw_string;\n"
+			")\";\n"
+			"int module = 3;\n"
+			"void f() { import_thing(); }\n"
+			"int x; import not_at_line_start;\n"
+			"    import indented;\n";
+
+		ModuleScanner_Scan( code, strlen( code ), testScratch, &scan );
+
+		TEMPER_CHECK_TRUE( scan.exportedModule == NULL );
+		TEMPER_CHECK_TRUE( scan.importedModules.count == 1 );
+		TEMPER_CHECK_TRUE( String_Equals( scan.importedModules[0], "indented" ) );
+	}
+
+	TEMPER_CHECK_FALSE( ModuleScanner_ScanFile( "this_file_doesnt_exist.cppm", testScratch, &scan ) );
+}
+
+TEST( Test_TimeTrace, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 1 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	timeTraceReport_t report;
+	TimeTrace_Init( &report, testScratch );
+
+	// cut down versions of what clang writes, one header gets included by both and includes another header
+	const char *traces[] = {
+		"{\"traceEvents\":[\n"
+		"{\"pid\":1,\"tid\":1,\"ph\":\"X\",\"ts\":0,\"dur\":9000,\"name\":\"Source\",\"args\":{\"detail\":\"C:\\\\src\\\\common.h\"}},\n"
+		"{\"pid\":1,\"tid\":1,\"ph\":\"X\",\"ts\":0,\"dur\":4000,\"name\":\"Source\",\"args\":{\"detail\":\"/usr/include/vector\"}},\n"
+		"{\"pid\":1,\"tid\":1,\"ph\":\"X\",\"ts\":0,\"dur\":2500,\"name\":\"InstantiateClass\",\"args\":{\"detail\":\"std::vector<int>\"}},\n"
+		"{\"pid\":1,\"tid\":1,\"ph\":\"X\",\"ts\":0,\"dur\":12000,\"name\":\"Frontend\"},\n"
+		"{\"pid\":1,\"tid\":1,\"ph\":\"X\",\"ts\":0,\"dur\":3000,\"name\":\"InstCombinePass\",\"args\":{\"detail\":\"main\"}},\n"
+		"{\"pid\":1,\"tid\":1,\"ph\":\"X\",\"ts\":0,\"dur\":1000,\"name\":\"RunPass\",\"args\":{\"detail\":\"X86 DAG->DAG Instruction Selection\"}},\n"
+		"{\"pid\":1,\"tid\":1,\"ph\":\"X\",\"ts\":0,\"dur\":5000,\"name\":\"Backend\"},\n"
+		"{\"pid\":1,\"tid\":1,\"ph\":\"X\",\"ts\":0,\"dur\":13000,\"name\":\"Total Source\",\"args\":{\"count\":2,\"avg ms\":6.5}},\n"
+		"{\"cat\":\"\",\"pid\":1,\"tid\":1,\"ts\":0,\"ph\":\"M\",\"name\":\"process_name\",\"args\":{\"name\":\"clang\"}}\n"
+		"],\"beginningOfTime\":1700000000000000}",
+
+		"{ \"traceEvents\": [ { \"ph\": \"X\", \"dur\": 1.5e3, \"name\": \"Source\", \"args\": { \"detail\": \"C:\\\\src\\\\common.h\" } },"
+		" { \"ph\": \"X\", \"dur\": 500, \"name\": \"InstantiateFunction\", \"args\": { \"detail\": \"max<\\u00e9>\" } },"
+		" { \"ph\": \"X\", \"dur\": 100, \"name\": \"Source\", \"args\": { \"detail\": \"\" }, \"extra\": [ true, false, null, { \"a\": [] } ] } ] }",
+	};
+
+	For ( u32, traceIndex, 0, COUNT_OF( traces ) ) {
+		std::string trace = traces[traceIndex];
+		TEMPER_CHECK_TRUE( TimeTrace_AddTrace( &report, trace.data(), trace.size() ) );
+	}
+
+	// broken traces dont count for anything
+	const char *brokenTraces[] = {
+		"",
+		"[]",
+		"{\"beginningOfTime\":0}",
+		"{\"traceEvents\":[{\"ph\":\"X\",\"dur\":1000,\"name\":\"Source\",\"args\":{\"detail\":\"broken.h\"}}",
+		"{\"traceEvents\":[{\"ph\":\"X\",\"dur\":1000,\"name\":\"Source\",\"args\":{\"detail\":\"broken.h\\q\"}}]}",
+	};
+
+	For ( u32, traceIndex, 0, COUNT_OF( brokenTraces ) ) {
+		std::string trace = brokenTraces[traceIndex];
+		TEMPER_CHECK_FALSE( TimeTrace_AddTrace( &report, trace.data(), trace.size() ) );
+	}
+
+	TimeTrace_Sort( &report );
+
+	TEMPER_CHECK_TRUE( report.numTraces == 2 );
+	TEMPER_CHECK_TRUE( Float64Equals( report.frontendMS, 12.0 ) );
+	TEMPER_CHECK_TRUE( Float64Equals( report.backendMS, 5.0 ) );
+
+	const array_t<timeTraceEntry_t> *headers = &report.entries[TIME_TRACE_CATEGORY_HEADERS];
+	TEMPER_CHECK_TRUE( headers->count == 2 );
+	TEMPER_CHECK_TRUE( String_Equals( ( *headers )[0].name, "C:\\src\\common.h" ) );
+	TEMPER_CHECK_TRUE( Float64Equals( ( *headers )[0].totalMS, 10.5 ) );
+	TEMPER_CHECK_TRUE( ( *headers )[0].count == 2 );
+	TEMPER_CHECK_TRUE( String_Equals( ( *headers )[1].name, "/usr/include/vector" ) );
+
+	const array_t<timeTraceEntry_t> *templates = &report.entries[TIME_TRACE_CATEGORY_TEMPLATES];
+	TEMPER_CHECK_TRUE( templates->count == 2 );
+	TEMPER_CHECK_TRUE( String_Equals( ( *templates )[0].name, "std::vector<int>" ) );
+	TEMPER_CHECK_TRUE( String_Equals( ( *templates )[1].name, "max<\xC3\xA9>" ) );
+
+	const array_t<timeTraceEntry_t> *passes = &report.entries[TIME_TRACE_CATEGORY_BACKEND_PASSES];
+	TEMPER_CHECK_TRUE( passes->count == 2 );
+	TEMPER_CHECK_TRUE( String_Equals( ( *passes )[0].name, "InstCombinePass" ) );
+	TEMPER_CHECK_TRUE( String_Equals( ( *passes )[1].name, "X86 DAG->DAG Instruction Selection" ) );
+
+	// the names get escaped again on the way out
+	stringBuilder_t json = SB_Create( testScratch );
+	TimeTrace_WriteJSONReport( &report, "debug", &json );
+
+	const char *jsonReport = SB_ToString( &json );
+	TEMPER_CHECK_TRUE( String_Contains( jsonReport, "\"name\": \"C:\\\\src\\\\common.h\", \"totalMS\": 10.500, \"count\": 2" ) );
+
+	stringBuilder_t text = SB_Create( testScratch );
+	TimeTrace_WriteTextReport( &report, "debug", 1, &text );
+
+	const char *textReport = SB_ToString( &text );
+	TEMPER_CHECK_TRUE( String_Contains( textReport, "C:\\src\\common.h" ) );
+	TEMPER_CHECK_TRUE( !String_Contains( textReport, "/usr/include/vector" ) );
+	TEMPER_CHECK_TRUE( String_Contains( textReport, "... and 1 more." ) );
+}
+
+TEST( Test_BuildTrace, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 1 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	// nothing gets recorded until the trace starts
+	TEMPER_CHECK_FALSE( BuildTrace_IsRunning() );
+
+	buildTraceSpan_t notRecorded = BuildTrace_BeginSpan( "test", "Source" );
+	TEMPER_CHECK_TRUE( notRecorded.category == NULL );
+	BuildTrace_EndSpan( &notRecorded, "not_recorded.h" );
+
+	BuildTrace_Init();
+	defer { BuildTrace_Shutdown(); };
+
+	TEMPER_CHECK_TRUE( BuildTrace_IsRunning() );
+
+	// name the spans like clang does so the time trace reader can tell us what it made of them
+	buildTraceSpan_t outer = BuildTrace_BeginSpan( "test", "Source" );
+	{
+		buildTraceSpan_t inner = BuildTrace_BeginSpan( "test", "Source" );
+		Thread_Sleep( 5 );
+		BuildTrace_EndSpan( &inner, "C:\\src\\\"quoted\".h" );
+	}
+	BuildTrace_EndSpan( &outer, "outer.h" );
+
+	stringBuilder_t sb = SB_Create( testScratch );
+	BuildTrace_WriteJSON( &sb );
+
+	const char *json = SB_ToString( &sb );
+
+	TEMPER_CHECK_TRUE( strstr( json, "\"name\": \"Main thread\"" ) != NULL );
+	TEMPER_CHECK_TRUE( strstr( json, "\"ph\": \"C\"" ) != NULL );
+	TEMPER_CHECK_TRUE( strstr( json, "not_recorded.h" ) == NULL );
+
+	// the outer span has to come first, otherwise the spans wont nest
+	const char *outerPos = strstr( json, "outer.h" );
+	const char *innerPos = strstr( json, "quoted" );
+	TEMPER_CHECK_TRUE( outerPos != NULL );
+	TEMPER_CHECK_TRUE( innerPos != NULL );
+	TEMPER_CHECK_TRUE( outerPos < innerPos );
+
+	// and it has to be a trace that something else can actually read
+	std::string trace = json;
+
+	timeTraceReport_t report;
+	TimeTrace_Init( &report, testScratch );
+
+	TEMPER_CHECK_TRUE( TimeTrace_AddTrace( &report, trace.data(), trace.size() ) );
+
+	TimeTrace_Sort( &report );
+
+	const array_t<timeTraceEntry_t> *headers = &report.entries[TIME_TRACE_CATEGORY_HEADERS];
+	TEMPER_CHECK_TRUE( headers->count == 2 );
+
+	if ( headers->count == 2 ) {
+		TEMPER_CHECK_TRUE( String_Equals( ( *headers )[0].name, "outer.h" ) );
+		TEMPER_CHECK_TRUE( String_Equals( ( *headers )[1].name, "C:\\src\\\"quoted\".h" ) );
+		TEMPER_CHECK_TRUE( ( *headers )[1].totalMS >= 5.0 );
+		TEMPER_CHECK_TRUE( ( *headers )[0].totalMS >= ( *headers )[1].totalMS );
+	}
+}
+
+TEST( Test_BuildHistory, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 16 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	const char *filename = "test_build_history.build_history";
+	defer { FS_DeleteFile( filename ); };
+
+	// nothing there yet
+	{
+		buildHistory_t history;
+		BuildHistory_Init( &history, testScratch );
+
+		TEMPER_CHECK_FALSE( BuildHistory_Load( &history, filename ) );
+		TEMPER_CHECK_TRUE( history.builds.count == 0 );
+	}
+
+	// b.cpp takes 100 ms every time until the last build, where it takes 300 ms
+	// c.cpp is a cache hit in the last build, which shouldnt count for anything
+	const u32 numBuilds = 6;
+
+	// save the first few builds, then load them back in and add the rest to the end of the file
+	For ( u32, buildIndex, 0, numBuilds ) {
+		buildHistory_t history;
+		BuildHistory_Init( &history, testScratch );
+		BuildHistory_Load( &history, filename );
+
+		TEMPER_CHECK_TRUE( history.builds.count == buildIndex );
+
+		buildHistoryBuild_t build = {
+			.timestamp				= 1700000000 + buildIndex,
+			.wallTimeMS				= 1000.0 + buildIndex,
+			.cpuTimeMS				= 3000.0,
+			.peakMemoryBytes		= 256 * 1024 * 1024,
+			.numSourceFilesCompiled	= 2,
+			.succeeded				= true,
+		};
+
+		BuildHistory_AddBuild( &history, &build );
+
+		bool8 lastBuild = buildIndex == numBuilds - 1;
+
+		BuildHistory_AddSourceFile( &history, "app: a.cpp", 50.0, 45.0, 100, false );
+		BuildHistory_AddSourceFile( &history, "app: b.cpp", lastBuild ? 300.0 : 100.0, 90.0, 200, false );
+
+		if ( buildIndex >= 2 ) {
+			BuildHistory_AddSourceFile( &history, "app: c.cpp", lastBuild ? 5000.0 : 100.0, 90.0, 200, lastBuild );
+		}
+
+		TEMPER_CHECK_TRUE( BuildHistory_Save( &history, filename ) );
+	}
+
+	buildHistory_t history;
+	BuildHistory_Init( &history, testScratch );
+
+	TEMPER_CHECK_TRUE( BuildHistory_Load( &history, filename ) );
+	TEMPER_CHECK_FALSE( history.rewrite );
+	TEMPER_CHECK_TRUE( history.builds.count == numBuilds );
+	TEMPER_CHECK_TRUE( history.names.count == 3 );
+	TEMPER_CHECK_TRUE( history.sourceFiles.count == numBuilds * 2 + ( numBuilds - 2 ) );
+
+	if ( history.builds.count == numBuilds ) {
+		const buildHistoryBuild_t *build = &history.builds[numBuilds - 1];
+
+		TEMPER_CHECK_TRUE( build->timestamp == 1700000000 + numBuilds - 1 );
+		TEMPER_CHECK_TRUE( build->wallTimeMS == 1000.0 + numBuilds - 1 );
+		TEMPER_CHECK_TRUE( build->peakMemoryBytes == 256 * 1024 * 1024 );
+		TEMPER_CHECK_TRUE( build->succeeded );
+		TEMPER_CHECK_TRUE( build->numSourceFiles == 3 );
+
+		if ( build->numSourceFiles == 3 ) {
+			const buildHistorySourceFile_t *sourceFile = &history.sourceFiles[build->firstSourceFile + 2];
+
+			TEMPER_CHECK_TRUE( String_Equals( history.names[sourceFile->nameIndex], "app: c.cpp" ) );
+			TEMPER_CHECK_TRUE( sourceFile->cacheHit );
+		}
+	}
+
+	array_t<buildHistoryRegression_t> regressions;
+	regressions.Init( testScratch );
+
+	BuildHistory_FindRegressions( &history, 25.0, &regressions );
+
+	TEMPER_CHECK_TRUE( regressions.count == 1 );
+
+	if ( regressions.count == 1 ) {
+		TEMPER_CHECK_TRUE( String_Equals( history.names[regressions[0].nameIndex], "app: b.cpp" ) );
+		TEMPER_CHECK_TRUE( regressions[0].compileTimeMS == 300.0 );
+		TEMPER_CHECK_TRUE( regressions[0].medianMS == 100.0 );
+		TEMPER_CHECK_TRUE( regressions[0].numSamples == numBuilds - 1 );
+	}
+
+	// 200% slower isnt enough if the threshold is higher than that
+	regressions.count = 0;
+	BuildHistory_FindRegressions( &history, 250.0, &regressions );
+
+	TEMPER_CHECK_TRUE( regressions.count == 0 );
+
+	// once there are too many builds the oldest ones get dropped, along with any names only they used
+	For ( u32, buildIndex, 0, BUILD_HISTORY_MAX_BUILDS ) {
+		buildHistoryBuild_t build = {
+			.timestamp	= 1800000000 + buildIndex,
+			.succeeded	= true,
+		};
+
+		BuildHistory_AddBuild( &history, &build );
+
+		BuildHistory_AddSourceFile( &history, "app: a.cpp", 50.0, 45.0, 100, false );
+	}
+
+	TEMPER_CHECK_TRUE( BuildHistory_Save( &history, filename ) );
+
+	buildHistory_t compacted;
+	BuildHistory_Init( &compacted, testScratch );
+
+	TEMPER_CHECK_TRUE( BuildHistory_Load( &compacted, filename ) );
+	TEMPER_CHECK_FALSE( compacted.rewrite );
+	TEMPER_CHECK_TRUE( compacted.builds.count == BUILD_HISTORY_KEEP_BUILDS );
+	TEMPER_CHECK_TRUE( compacted.names.count == 1 );
+
+	if ( compacted.builds.count == BUILD_HISTORY_KEEP_BUILDS ) {
+		TEMPER_CHECK_TRUE( compacted.builds[0].timestamp == 1800000000 + BUILD_HISTORY_MAX_BUILDS - BUILD_HISTORY_KEEP_BUILDS );
+		TEMPER_CHECK_TRUE( compacted.sourceFiles.count == BUILD_HISTORY_KEEP_BUILDS );
+	}
+}
+
+TEST( Test_CriticalPath, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 1 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	criticalPath_t criticalPath;
+	CriticalPath_Init( &criticalPath, testScratch );
+
+	// a.cpp and b.cpp compile at the same time, then the link needs both of them
+	// c.cpp doesnt need anything and nothing needs it
+	// d.cpp needs b.cpp, but didnt get a core until well after b.cpp was done
+	u32 a = CriticalPath_AddNode( &criticalPath, "a.cpp", 1000.0, 1100.0 );
+	u32 b = CriticalPath_AddNode( &criticalPath, "b.cpp", 1000.0, 1030.0 );
+	u32 link = CriticalPath_AddNode( &criticalPath, "link", 1100.0, 1150.0 );
+	u32 c = CriticalPath_AddNode( &criticalPath, "c.cpp", 1000.0, 1020.0 );
+	u32 d = CriticalPath_AddNode( &criticalPath, "d.cpp", 1200.0, 1210.0 );
+
+	CriticalPath_AddDependency( &criticalPath, link, a );
+	CriticalPath_AddDependency( &criticalPath, link, b );
+	CriticalPath_AddDependency( &criticalPath, d, b );
+
+	TEMPER_CHECK_TRUE( CriticalPath_Compute( &criticalPath ) );
+
+	TEMPER_CHECK_TRUE( criticalPath.minimumTimeMS == 150.0 );
+	TEMPER_CHECK_TRUE( criticalPath.actualTimeMS == 210.0 );
+
+	TEMPER_CHECK_TRUE( criticalPath.path.count == 2 );
+
+	if ( criticalPath.path.count == 2 ) {
+		TEMPER_CHECK_TRUE( criticalPath.path[0] == a );
+		TEMPER_CHECK_TRUE( criticalPath.path[1] == link );
+	}
+
+	TEMPER_CHECK_TRUE( criticalPath.nodes[a].slackMS == 0.0 );
+	TEMPER_CHECK_TRUE( criticalPath.nodes[link].slackMS == 0.0 );
+	TEMPER_CHECK_TRUE( criticalPath.nodes[b].slackMS == 70.0 );
+	TEMPER_CHECK_TRUE( criticalPath.nodes[c].slackMS == 130.0 );
+	TEMPER_CHECK_TRUE( criticalPath.nodes[d].slackMS == 110.0 );
+
+	TEMPER_CHECK_TRUE( criticalPath.nodes[link].waitMS == 0.0 );
+	TEMPER_CHECK_TRUE( criticalPath.nodes[d].waitMS == 170.0 );
+
+	// jobs that depend on each other in a circle cant have a critical path
+	criticalPath_t circle;
+	CriticalPath_Init( &circle, testScratch );
+
+	u32 first = CriticalPath_AddNode( &circle, "first", 0.0, 10.0 );
+	u32 second = CriticalPath_AddNode( &circle, "second", 10.0, 20.0 );
+
+	CriticalPath_AddDependency( &circle, second, first );
+	CriticalPath_AddDependency( &circle, first, second );
+
+	TEMPER_CHECK_FALSE( CriticalPath_Compute( &circle ) );
+}
+
+TEST( Test_CompileCache, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 16 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	const char *folder = "test_compile_cache";
+	const char *sourceFile = "test_compile_cache/main.cpp";
+	const char *headerFile = "test_compile_cache/main.h";
+	const char *objectFile = "test_compile_cache/main.o";
+	const char *depFile = "test_compile_cache/main.cpp.d";
+
+	const char *objectContents = "pretend this is an object file";
+	const char *depContents = "test_compile_cache/main.o: test_compile_cache/main.cpp test_compile_cache/main.h\n";
+
+	TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( folder ) );
+	defer { NukeFolder( folder, true, false ); };
+
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( sourceFile, "#include \"main.h\"\n", strlen( "#include \"main.h\"\n" ) ) );
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( headerFile, "int x;\n", strlen( "int x;\n" ) ) );
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( objectFile, objectContents, strlen( objectContents ) ) );
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( depFile, depContents, strlen( depContents ) ) );
+
+	fileStatMemo_t *memo = FileStatMemo_Create( testScratch, NULL, 0 );
+
+	compileCache_t cache;
+	TEMPER_CHECK_TRUE( CompileCache_Init( &cache, "test_compile_cache/cache", NULL, false, memo ) );
+
+	array_t<const char *> args;
+	args.Init( testScratch );
+	args.Add( "this_compiler_does_not_exist" );
+	args.Add( "-c" );
+	args.Add( sourceFile );
+
+	u64 commandHash = CompileCache_HashCommand( &cache, &args );
+
+	const char *includeDependencies[] = { headerFile };
+	string_t compilerOutput = String_Set( "main.cpp: warning: this is a test\n" );
+
+	string_t restoredOutput = {};
+	TEMPER_CHECK_TRUE( !CompileCache_Restore( &cache, commandHash, sourceFile, objectFile, depFile, &restoredOutput ) );
+	TEMPER_CHECK_TRUE( cache.numMisses.value == 1 );
+
+	TEMPER_CHECK_TRUE( CompileCache_Store( &cache, commandHash, sourceFile, includeDependencies, 1, objectFile, depFile, &compilerOutput ) );
+
+	// the outputs come back exactly as they were, along with what the compiler printed
+	TEMPER_CHECK_TRUE( FS_DeleteFile( objectFile ) );
+	TEMPER_CHECK_TRUE( FS_DeleteFile( depFile ) );
+	TEMPER_CHECK_TRUE( CompileCache_Restore( &cache, commandHash, sourceFile, objectFile, depFile, &restoredOutput ) );
+	TEMPER_CHECK_TRUE( cache.numHits.value == 1 );
+	TEMPER_CHECK_TRUE( String_Equals( &restoredOutput, &compilerOutput ) );
+
+	string_t restoredObject = {};
+	TEMPER_CHECK_TRUE( FS_ReadEntireFile( objectFile, &restoredObject ) );
+	TEMPER_CHECK_TRUE( restoredObject.count == strlen( objectContents ) && memcmp( restoredObject.data, objectContents, restoredObject.count ) == 0 );
+	FS_FreeFileBuffer( &restoredObject );
+	TEMPER_CHECK_TRUE( FS_FileExists( depFile ) );
+
+	// compiling any other way is a different entry
+	args.Add( "-O2" );
+	TEMPER_CHECK_TRUE( CompileCache_HashCommand( &cache, &args ) != commandHash );
+	TEMPER_CHECK_TRUE( !CompileCache_Restore( &cache, CompileCache_HashCommand( &cache, &args ), sourceFile, objectFile, depFile, &restoredOutput ) );
+
+	// so is changing a header
+	// this needs a different size too, because two writes can land in the same timestamp tick and nothing has a way of seeing those
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( headerFile, "int x = 1;\n", strlen( "int x = 1;\n" ) ) );
+	FileStatMemo_Invalidate( memo );
+	TEMPER_CHECK_TRUE( !CompileCache_Restore( &cache, commandHash, sourceFile, objectFile, depFile, &restoredOutput ) );
+	TEMPER_CHECK_TRUE( CompileCache_Store( &cache, commandHash, sourceFile, includeDependencies, 1, objectFile, depFile, NULL ) );
+
+	// but changing it back (like switching back to the branch you were on) finds the first entry again
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( headerFile, "int x;\n", strlen( "int x;\n" ) ) );
+	FileStatMemo_Invalidate( memo );
+	TEMPER_CHECK_TRUE( CompileCache_Restore( &cache, commandHash, sourceFile, objectFile, depFile, &restoredOutput ) );
+	TEMPER_CHECK_TRUE( String_Equals( &restoredOutput, &compilerOutput ) );
+	TEMPER_CHECK_TRUE( cache.numHits.value == 2 );
+	TEMPER_CHECK_TRUE( cache.numStores.value == 2 );
+}
+
+TEST( Test_Compression, TEMPER_FLAG_SHOULD_RUN ) {
+	// something that compresses well, with a bit of noise in it so its not all one long match
+	const u64 size = 64 * 1024;
+	u8 *data = Cast( u8 *, malloc( size ) );
+	defer { free( data ); };
+
+	u32 noise = 12345;
+	For ( u64, i, 0, size ) {
+		noise = noise * 1103515245 + 12345;
+		data[i] = ( i % 7 == 0 ) ? Cast( u8, noise >> 24 ) : Cast( u8, i % 64 );
+	}
+
+	u8 *compressed = Cast( u8 *, malloc( Compression_GetMaxCompressedSize( size ) ) );
+	defer { free( compressed ); };
+
+	u8 *decompressed = Cast( u8 *, malloc( size ) );
+	defer { free( decompressed ); };
+
+	u64 compressedSize = Compression_Compress( data, size, compressed );
+	TEMPER_CHECK_TRUE( compressedSize > 0 && compressedSize < size );
+
+	TEMPER_CHECK_TRUE( Compression_Decompress( compressed, compressedSize, decompressed, size ) );
+	TEMPER_CHECK_TRUE( memcmp( data, decompressed, size ) == 0 );
+
+	// asking for the wrong size back, or getting cut short, fails instead of going out of bounds
+	TEMPER_CHECK_TRUE( !Compression_Decompress( compressed, compressedSize, decompressed, size - 1 ) );
+	TEMPER_CHECK_TRUE( !Compression_Decompress( compressed, compressedSize / 2, decompressed, size ) );
+
+	// tiny inputs are all literals
+	const char *small = "abc";
+	compressedSize = Compression_Compress( small, 3, compressed );
+	TEMPER_CHECK_TRUE( Compression_Decompress( compressed, compressedSize, decompressed, 3 ) );
+	TEMPER_CHECK_TRUE( memcmp( small, decompressed, 3 ) == 0 );
+}
+
+TEST( Test_CompileCache_Shared, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 16 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	// two checkouts of the same code that share one compressed cache
+	const char *folder = "test_compile_cache_shared";
+	const char *cacheFolder = "test_compile_cache_shared/cache";
+	const char *roots[] = { "test_compile_cache_shared/checkout_a", "test_compile_cache_shared/checkout_b" };
+
+	TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( folder ) );
+	defer { NukeFolder( folder, true, false ); };
+
+	const char *objectContents = "pretend this is an object file, pretend this is an object file, pretend this is an object file";
+
+	fileStatMemo_t *memo = FileStatMemo_Create( testScratch, NULL, 0 );
+
+	compileCache_t caches[2];
+	u64 commandHashes[2];
+
+	For ( u32, rootIndex, 0, 2 ) {
+		const char *root = roots[rootIndex];
+
+		TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( root ) );
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( TempPrintf( "%s/main.cpp", root ), "#include \"main.h\"\n", strlen( "#include \"main.h\"\n" ) ) );
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( TempPrintf( "%s/main.h", root ), "int x;\n", strlen( "int x;\n" ) ) );
+
+		TEMPER_CHECK_TRUE( CompileCache_Init( &caches[rootIndex], cacheFolder, root, true, memo ) );
+
+		array_t<const char *> args;
+		args.Init( testScratch );
+		args.Add( "this_compiler_does_not_exist" );
+		args.Add( "-c" );
+		args.Add( TempPrintf( "-I%s/include", root ) );
+		args.Add( TempPrintf( "%s/main.cpp", root ) );
+
+		commandHashes[rootIndex] = CompileCache_HashCommand( &caches[rootIndex], &args );
+	}
+
+	// the same command in a different checkout is the same command
+	TEMPER_CHECK_TRUE( commandHashes[0] == commandHashes[1] );
+
+	// checkout a builds it
+	{
+		const char *root = roots[0];
+		const char *sourceFile = TempPrintf( "%s/main.cpp", root );
+		const char *objectFile = TempPrintf( "%s/main.o", root );
+		const char *depFile = TempPrintf( "%s/main.cpp.d", root );
+		const char *includeDependencies[] = { TempPrintf( "%s/main.h", root ) };
+		const char *depContents = TempPrintf( "%s: %s %s\n", objectFile, sourceFile, includeDependencies[0] );
+		string_t compilerOutput = String_Set( TempPrintf( "%s: warning: this is a test\n", sourceFile ) );
+
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( objectFile, objectContents, strlen( objectContents ) ) );
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( depFile, depContents, strlen( depContents ) ) );
+
+		TEMPER_CHECK_TRUE( CompileCache_Store( &caches[0], commandHashes[0], sourceFile, includeDependencies, 1, objectFile, depFile, &compilerOutput ) );
+	}
+
+	// checkout b gets it back, with its own paths in everything
+	{
+		const char *root = roots[1];
+		const char *sourceFile = TempPrintf( "%s/main.cpp", root );
+		const char *objectFile = TempPrintf( "%s/main.o", root );
+		const char *depFile = TempPrintf( "%s/main.cpp.d", root );
+
+		string_t restoredOutput = {};
+		TEMPER_CHECK_TRUE( CompileCache_Restore( &caches[1], commandHashes[1], sourceFile, objectFile, depFile, &restoredOutput ) );
+		TEMPER_CHECK_TRUE( String_Equals( restoredOutput.data, TempPrintf( "%s: warning: this is a test\n", sourceFile ) ) );
+
+		string_t restoredObject = {};
+		TEMPER_CHECK_TRUE( FS_ReadEntireFile( objectFile, &restoredObject ) );
+		TEMPER_CHECK_TRUE( restoredObject.count == strlen( objectContents ) && memcmp( restoredObject.data, objectContents, restoredObject.count ) == 0 );
+		FS_FreeFileBuffer( &restoredObject );
+
+		string_t restoredDepFile = {};
+		TEMPER_CHECK_TRUE( FS_ReadEntireFile( depFile, &restoredDepFile ) );
+		TEMPER_CHECK_TRUE( restoredDepFile.count == strlen( TempPrintf( "%s: %s %s/main.h\n", objectFile, sourceFile, root ) ) );
+		TEMPER_CHECK_TRUE( memcmp( restoredDepFile.data, TempPrintf( "%s: %s %s/main.h\n", objectFile, sourceFile, root ), restoredDepFile.count ) == 0 );
+		FS_FreeFileBuffer( &restoredDepFile );
+	}
+
+	// but not if checkout b's header is different
+	{
+		const char *root = roots[1];
+
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( TempPrintf( "%s/main.h", root ), "int x = 1;\n", strlen( "int x = 1;\n" ) ) );
+		FileStatMemo_Invalidate( memo );
+
+		string_t restoredOutput = {};
+		TEMPER_CHECK_TRUE( !CompileCache_Restore( &caches[1], commandHashes[1], TempPrintf( "%s/main.cpp", root ), TempPrintf( "%s/main.o", root ), TempPrintf( "%s/main.cpp.d", root ), &restoredOutput ) );
+	}
+
+	// trimming to 0 bytes deletes everything, trimming to more than it has deletes nothing
+	compileCacheTrimResult_t trimResult = {};
+	TEMPER_CHECK_TRUE( CompileCache_Trim( cacheFolder, MEM_MEGABYTES( 1 ), &trimResult ) );
+	TEMPER_CHECK_TRUE( trimResult.sizeBytesBefore > 0 );
+	TEMPER_CHECK_TRUE( trimResult.sizeBytesAfter == trimResult.sizeBytesBefore );
+	TEMPER_CHECK_TRUE( trimResult.numFilesDeleted == 0 );
+
+	TEMPER_CHECK_TRUE( CompileCache_Trim( cacheFolder, 0, &trimResult ) );
+	TEMPER_CHECK_TRUE( trimResult.sizeBytesAfter == 0 );
+	TEMPER_CHECK_TRUE( trimResult.numFilesDeleted == 4 );	// the manifest, the object file, the dependency file, and the compiler output
+
+	string_t restoredOutput = {};
+	TEMPER_CHECK_TRUE( !CompileCache_Restore( &caches[0], commandHashes[0], TempPrintf( "%s/main.cpp", roots[0] ), TempPrintf( "%s/main.o", roots[0] ), TempPrintf( "%s/main.cpp.d", roots[0] ), &restoredOutput ) );
+}
+
+TEST( Test_CompileCache_Config, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 16 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	const char *folder = "test_compile_cache_config";
+
+	TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( folder ) );
+	defer { NukeFolder( folder, true, false ); };
+
+	const char *binaryContents = "pretend this is a static library, pretend this is a static library, pretend this is a static library";
+	const char *binaryFile = "test_compile_cache_config/lib.a";
+	const u64 configKey = 0x1234567812345678ULL;
+
+	// the same headers in a different order, and some more than once, is still the same set of headers
+	const char *headers[] = { "test_compile_cache_config/b.h", "test_compile_cache_config/a.h" };
+	const char *includeDependencies[] = { headers[0], headers[1], headers[0] };
+	const char *reorderedIncludeDependencies[] = { headers[1], headers[0] };
+
+	For ( u32, compress, 0, 2 ) {
+		const char *cacheFolder = TempPrintf( "%s/cache_%u", folder, compress );
+
+		For ( u64, headerIndex, 0, COUNT_OF( headers ) ) {
+			TEMPER_CHECK_TRUE( FS_WriteEntireFile( headers[headerIndex], "int x;\n", strlen( "int x;\n" ) ) );
+		}
+
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( binaryFile, binaryContents, strlen( binaryContents ) ) );
+
+		fileStatMemo_t *memo = FileStatMemo_Create( testScratch, NULL, 0 );
+
+		compileCache_t cache;
+		TEMPER_CHECK_TRUE( CompileCache_Init( &cache, cacheFolder, NULL, compress, memo ) );
+
+		TEMPER_CHECK_TRUE( CompileCache_FindConfig( &cache, configKey ) == 0 );
+
+		u64 entryHash = CompileCache_StoreConfig( &cache, configKey, includeDependencies, COUNT_OF( includeDependencies ), binaryFile );
+		TEMPER_CHECK_TRUE( entryHash != 0 );
+		TEMPER_CHECK_TRUE( cache.numConfigStores.value == 1 );
+
+		TEMPER_CHECK_TRUE( CompileCache_FindConfig( &cache, configKey ) == entryHash );
+		TEMPER_CHECK_TRUE( CompileCache_FindConfig( &cache, configKey + 1 ) == 0 );
+
+		// storing it again (E.G. from another checkout) finds the same entry
+		TEMPER_CHECK_TRUE( CompileCache_StoreConfig( &cache, configKey, reorderedIncludeDependencies, COUNT_OF( reorderedIncludeDependencies ), binaryFile ) == entryHash );
+
+		// the linker writing over the binary must never change the entry
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( binaryFile, "relinked", strlen( "relinked" ) ) );
+
+		TEMPER_CHECK_TRUE( CompileCache_RestoreConfig( &cache, configKey, entryHash, binaryFile ) );
+		TEMPER_CHECK_TRUE( cache.numConfigHits.value == 1 );
+
+		string_t restoredBinary = {};
+		TEMPER_CHECK_TRUE( FS_ReadEntireFile( binaryFile, &restoredBinary ) );
+		TEMPER_CHECK_TRUE( restoredBinary.count == strlen( binaryContents ) && memcmp( restoredBinary.data, binaryContents, restoredBinary.count ) == 0 );
+		FS_FreeFileBuffer( &restoredBinary );
+
+		// changing a header means its a different entry
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( headers[1], "int x = 1;\n", strlen( "int x = 1;\n" ) ) );
+		FileStatMemo_Invalidate( memo );
+
+		TEMPER_CHECK_TRUE( CompileCache_FindConfig( &cache, configKey ) == 0 );
+	}
+}
+
+TEST( Test_RemoteCache, TEMPER_FLAG_SHOULD_RUN ) {
+	const char *folder = "test_remote_cache";
+
+	TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( folder ) );
+	defer { NukeFolder( folder, true, false ); };
+
+	// port 0 so this never fights with anything else on the machine
+	cacheServer_t server = {};
+	TEMPER_CHECK_TRUE( CacheServer_Start( &server, "test_remote_cache/served", 0, false ) );
+	defer { CacheServer_Stop( &server ); };
+
+	remoteCacheBackend_t backends[2];
+	TEMPER_CHECK_TRUE( RemoteCache_CreateBackend( TempPrintf( "http://127.0.0.1:%u/prefix", server.port ), &backends[0] ) );
+	TEMPER_CHECK_TRUE( RemoteCache_CreateBackend( "test_remote_cache/folder", &backends[1] ) );
+
+	// anything that could get outside the cache folder isnt a key
+	TEMPER_CHECK_TRUE( RemoteCache_IsValidKey( "ab/abcdef0123456789.lz" ) );
+	TEMPER_CHECK_TRUE( !RemoteCache_IsValidKey( "../ab/abcdef0123456789.lz" ) );
+	TEMPER_CHECK_TRUE( !RemoteCache_IsValidKey( "/ab/abcdef0123456789.lz" ) );
+	TEMPER_CHECK_TRUE( !RemoteCache_IsValidKey( "ab/abc def.lz" ) );
+
+	// nor is anything we cant reach
+	remoteCacheBackend_t unusable = {};
+	TEMPER_CHECK_TRUE( !RemoteCache_CreateBackend( "https://127.0.0.1/prefix", &unusable ) );
+
+	For ( u32, backendIndex, 0, COUNT_OF( backends ) ) {
+		remoteCacheBackend_t *backend = &backends[backendIndex];
+		defer { backend->Shutdown( backend ); };
+
+		const char *blob = "this is a blob";
+
+		TEMPER_CHECK_TRUE( backend->Put( backend, "ab/0000000000000001.o", blob, strlen( blob ) ) );
+		TEMPER_CHECK_TRUE( backend->Put( backend, "cd/0000000000000002.d", "", 0 ) );
+
+		const char *keys[] = { "ab/0000000000000001.o", "ef/0000000000000003.o", "cd/0000000000000002.d" };
+
+		bool8 contains[COUNT_OF( keys )] = {};
+		TEMPER_CHECK_TRUE( backend->Contains( backend, keys, COUNT_OF( keys ), contains ) );
+		TEMPER_CHECK_TRUE( contains[0] );
+		TEMPER_CHECK_TRUE( !contains[1] );
+		TEMPER_CHECK_TRUE( contains[2] );
+
+		remoteCacheBlob_t blobs[COUNT_OF( keys )] = {};
+		TEMPER_CHECK_TRUE( backend->Get( backend, keys, COUNT_OF( keys ), blobs ) );
+		TEMPER_CHECK_TRUE( blobs[0].found && blobs[0].size == strlen( blob ) && memcmp( blobs[0].data, blob, blobs[0].size ) == 0 );
+		TEMPER_CHECK_TRUE( !blobs[1].found );
+		TEMPER_CHECK_TRUE( blobs[2].found && blobs[2].size == 0 );
+
+		For ( u32, blobIndex, 0, COUNT_OF( blobs ) ) {
+			RemoteCache_FreeBlob( &blobs[blobIndex] );
+		}
+
+		// putting it again replaces it
+		TEMPER_CHECK_TRUE( backend->Put( backend, "ab/0000000000000001.o", "replaced", strlen( "replaced" ) ) );
+
+		remoteCacheBlob_t replaced = {};
+		TEMPER_CHECK_TRUE( backend->Get( backend, keys, 1, &replaced ) );
+		TEMPER_CHECK_TRUE( replaced.found && String_Equals( Cast( const char *, replaced.data ), "replaced" ) );
+		RemoteCache_FreeBlob( &replaced );
+	}
+
+	// the server keeps everything in the same layout as the file system backend
+	TEMPER_CHECK_TRUE( FS_FileExists( "test_remote_cache/served/prefix/ab/0000000000000001.o" ) );
+}
+
+TEST( Test_CompileCache_Remote, TEMPER_FLAG_SHOULD_RUN ) {
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_MEGABYTES( 16 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	// two machines with their own local caches that share a remote one
+	const char *folder = "test_compile_cache_remote";
+	const char *roots[] = { "test_compile_cache_remote/machine_a", "test_compile_cache_remote/machine_b" };
+	const char *cacheFolders[] = { "test_compile_cache_remote/machine_a_cache", "test_compile_cache_remote/machine_b_cache" };
+
+	TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( folder ) );
+	defer { NukeFolder( folder, true, false ); };
+
+	cacheServer_t server = {};
+	TEMPER_CHECK_TRUE( CacheServer_Start( &server, "test_compile_cache_remote/remote", 0, false ) );
+	defer { CacheServer_Stop( &server ); };
+
+	const char *remoteLocation = TempPrintf( "http://127.0.0.1:%u", server.port );
+
+	const char *objectContents = "pretend this is an object file, pretend this is an object file, pretend this is an object file";
+
+	fileStatMemo_t *memo = FileStatMemo_Create( testScratch, NULL, 0 );
+
+	compileCache_t caches[2];
+	u64 commandHashes[2];
+
+	For ( u32, rootIndex, 0, 2 ) {
+		const char *root = roots[rootIndex];
+
+		TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( root ) );
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( TempPrintf( "%s/main.cpp", root ), "#include \"main.h\"\n", strlen( "#include \"main.h\"\n" ) ) );
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( TempPrintf( "%s/main.h", root ), "int x;\n", strlen( "int x;\n" ) ) );
+
+		// uncompressed local caches, the remote one is always compressed
+		TEMPER_CHECK_TRUE( CompileCache_Init( &caches[rootIndex], cacheFolders[rootIndex], root, false, memo ) );
+		TEMPER_CHECK_TRUE( CompileCache_ConnectRemote( &caches[rootIndex], remoteLocation ) );
+
+		array_t<const char *> args;
+		args.Init( testScratch );
+		args.Add( "this_compiler_does_not_exist" );
+		args.Add( "-c" );
+		args.Add( TempPrintf( "%s/main.cpp", root ) );
+
+		commandHashes[rootIndex] = CompileCache_HashCommand( &caches[rootIndex], &args );
+	}
+
+	// machine a builds it, and uploads it once its done
+	{
+		const char *root = roots[0];
+		const char *sourceFile = TempPrintf( "%s/main.cpp", root );
+		const char *objectFile = TempPrintf( "%s/main.o", root );
+		const char *depFile = TempPrintf( "%s/main.cpp.d", root );
+		const char *includeDependencies[] = { TempPrintf( "%s/main.h", root ) };
+		const char *depContents = TempPrintf( "%s: %s %s\n", objectFile, sourceFile, includeDependencies[0] );
+
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( objectFile, objectContents, strlen( objectContents ) ) );
+		TEMPER_CHECK_TRUE( FS_WriteEntireFile( depFile, depContents, strlen( depContents ) ) );
+
+		TEMPER_CHECK_TRUE( CompileCache_Store( &caches[0], commandHashes[0], sourceFile, includeDependencies, 1, objectFile, depFile, NULL ) );
+
+		CompileCache_DisconnectRemote( &caches[0] );
+
+		TEMPER_CHECK_TRUE( caches[0].numRemoteUploads.value == 1 );
+	}
+
+	// machine b never built it, but gets it from the remote cache
+	{
+		const char *root = roots[1];
+		const char *sourceFile = TempPrintf( "%s/main.cpp", root );
+		const char *objectFile = TempPrintf( "%s/main.o", root );
+		const char *depFile = TempPrintf( "%s/main.cpp.d", root );
+
+		CompileCache_Prefetch( &caches[1], commandHashes[1], sourceFile );
+
+		// a real build would just compile it if the lookup wasnt done yet, but here we want to know the lookup works
+		// the manifest is the last thing a lookup puts in the local cache
+		const char *localManifest = TempPrintf( "%s/%02" PRIx64 "/%016" PRIx64 ".manifest", cacheFolders[1], commandHashes[1] >> 56, commandHashes[1] );
+
+		For ( u32, attempt, 0, 500 ) {
+			if ( FS_FileExists( localManifest ) ) {
+				break;
+			}
+
+			Thread_Sleep( 10 );
+		}
+
+		string_t restoredOutput = {};
+		TEMPER_CHECK_TRUE( CompileCache_Restore( &caches[1], commandHashes[1], sourceFile, objectFile, depFile, &restoredOutput ) );
+		TEMPER_CHECK_TRUE( caches[1].numRemoteHits.value == 1 );
+
+		string_t restoredObject = {};
+		TEMPER_CHECK_TRUE( FS_ReadEntireFile( objectFile, &restoredObject ) );
+		TEMPER_CHECK_TRUE( restoredObject.count == strlen( objectContents ) && memcmp( restoredObject.data, objectContents, restoredObject.count ) == 0 );
+		FS_FreeFileBuffer( &restoredObject );
+
+		string_t restoredDepFile = {};
+		TEMPER_CHECK_TRUE( FS_ReadEntireFile( depFile, &restoredDepFile ) );
+		TEMPER_CHECK_TRUE( String_Equals( restoredDepFile.data, TempPrintf( "%s: %s %s/main.h\n", objectFile, sourceFile, root ) ) );
+		FS_FreeFileBuffer( &restoredDepFile );
+
+		// it was already uploaded, so theres nothing for b to upload
+		const char *includeDependencies[] = { TempPrintf( "%s/main.h", root ) };
+		TEMPER_CHECK_TRUE( CompileCache_Store( &caches[1], commandHashes[1], sourceFile, includeDependencies, 1, objectFile, depFile, NULL ) );
+
+		CompileCache_DisconnectRemote( &caches[1] );
+
+		TEMPER_CHECK_TRUE( caches[1].numRemoteUploads.value == 0 );
+	}
+}
+
 TEST_PARAMETRIC( TestBuild, TEMPER_FLAG_SHOULD_RUN, buildTest_t test ) {
 	printf( "Running test %s\n", test.rootDir );
 
@@ -266,12 +2102,16 @@ TEST_PARAMETRIC( TestBuild, TEMPER_FLAG_SHOULD_RUN, buildTest_t test ) {
 	generatedFiles.fileExtensionsToDelete.Add( GetFileExtensionFromBinaryType( BINARY_TYPE_DYNAMIC_LIBRARY ) );
 	generatedFiles.fileExtensionsToDelete.Add( GetFileExtensionFromBinaryType( BINARY_TYPE_STATIC_LIBRARY ) );
 	generatedFiles.fileExtensionsToDelete.Add( ".include_dependencies" );
+	generatedFiles.fileExtensionsToDelete.Add( ".file_hashes" );
 	generatedFiles.fileExtensionsToDelete.Add( ".pdb" );
 	generatedFiles.fileExtensionsToDelete.Add( ".exp" );
 	generatedFiles.fileExtensionsToDelete.Add( ".ilk" );
 	generatedFiles.fileExtensionsToDelete.Add( ".o" );
 	generatedFiles.fileExtensionsToDelete.Add( ".d" );
 	generatedFiles.fileExtensionsToDelete.Add( ".json" );
+	generatedFiles.fileExtensionsToDelete.Add( ".pcm" );
+	generatedFiles.fileExtensionsToDelete.Add( ".gcm" );
+	generatedFiles.fileExtensionsToDelete.Add( ".map" );
 
 	// @Aiden - We really need some Core strings sprinked throughout this whole file and the rest of the program
 	//			it feels cumbersome to work around the mismatches.
@@ -345,7 +2185,6 @@ TEST_PARAMETRIC( TestBuild, TEMPER_FLAG_SHOULD_RUN, buildTest_t test ) {
 		generatedFiles.files.Reset();
 		generatedFiles.folders.Reset();
 
-		TEMPER_CHECK_TRUE( FS_GetAllFilesInFolder( dotBuilderFolder, FILE_VISIT_RECURSIVE | FILE_VISIT_FILES | FILE_VISIT_FOLDERS, GetAllGeneratedFiles, &generatedFiles ) );
 		if ( test.binaryFolder ) {
 			TEMPER_CHECK_TRUE( FS_GetAllFilesInFolder( test.binaryFolder, FILE_VISIT_RECURSIVE | FILE_VISIT_FILES | FILE_VISIT_FOLDERS, GetAllGeneratedFiles, &generatedFiles ) );
 		} else {
@@ -360,6 +2199,10 @@ TEST_PARAMETRIC( TestBuild, TEMPER_FLAG_SHOULD_RUN, buildTest_t test ) {
 
 			string_t userConfigBuildDLLFilename = String_Printf( testScratch, "%s%c%s%s", dotBuilderFolder, PATH_SEPARATOR, buildSourceFileWithoutExtension.data, GetFileExtensionFromBinaryType( BINARY_TYPE_DYNAMIC_LIBRARY ) );
 			TEMPER_CHECK_TRUE( FS_FileExists( userConfigBuildDLLFilename.data ) );
+
+			// this has to get cleaned up too, otherwise the next build test starts with a history it didnt make
+			string_t buildHistoryFilename = String_Printf( testScratch, "%s%c%s.build_history", dotBuilderFolder, PATH_SEPARATOR, buildSourceFileWithoutExtension.data );
+			TEMPER_CHECK_TRUE( FS_FileExists( buildHistoryFilename.data ) );
 		}
 
 		// now run the program we just built
@@ -386,15 +2229,21 @@ TEST_PARAMETRIC( TestBuild, TEMPER_FLAG_SHOULD_RUN, buildTest_t test ) {
 				LogVerbose( "Done\n" );
 			}
 
-			For ( u32, folderIndex, 0, generatedFiles.folders.count ) {
-				const char *generatedFolder = generatedFiles.folders[folderIndex];
-
-				LogVerbose( "Deleting folder %s ... ", generatedFolder );
+			// exes dont have a file extension on linux, so the binary doesnt get picked up by the extensions above
+			if ( FS_FileExists( fullBinaryName.data ) ) {
+				TEMPER_CHECK_TRUE_M( FS_DeleteFile( fullBinaryName.data ), "Couldn't delete file \"%s\".\n", fullBinaryName.data );
+			}
 
-				TEMPER_CHECK_TRUE_M( FS_DeleteFolder( generatedFolder ), "Couldn't delete folder \"%s\".\n", generatedFolder );
-				TEMPER_CHECK_TRUE_M( !FS_FolderExists( generatedFolder ), "We deleted the folder \"%s\" just now, but the OS tells us it still exists?\n", generatedFolder );
+			// everything in the binary folder came from the build, including things like the precompiled header's wrapper header that we cant tell apart from source files by their extension
+			if ( test.binaryFolder && FS_FolderExists( test.binaryFolder ) ) {
+				TEMPER_CHECK_TRUE_M( NukeFolder( test.binaryFolder, true, false ), "Couldn't delete folder \"%s\".\n", test.binaryFolder );
+				TEMPER_CHECK_TRUE_M( !FS_FolderExists( test.binaryFolder ), "We deleted the folder \"%s\" just now, but the OS tells us it still exists?\n", test.binaryFolder );
+			}
 
-				LogVerbose( "Done\n" );
+			// the compile cache and the build history go in .builder too, so theres more in there than just the files we know the extensions of
+			if ( FS_FolderExists( dotBuilderFolder ) ) {
+				TEMPER_CHECK_TRUE_M( NukeFolder( dotBuilderFolder, true, false ), "Couldn't delete folder \"%s\".\n", dotBuilderFolder );
+				TEMPER_CHECK_TRUE_M( !FS_FolderExists( dotBuilderFolder ), "We deleted the folder \"%s\" just now, but the OS tells us it still exists?\n", dotBuilderFolder );
 			}
 		}
 
@@ -456,6 +2305,37 @@ TEMPER_INVOKE_PARAMETRIC_TEST( TestBuild, {
 	.binaryName			= "test_static_library_program",
 } );
 
+TEMPER_INVOKE_PARAMETRIC_TEST( TestBuild, {
+	.rootDir			= "test_resource_pools",
+	.buildSourceFile	= "build.cpp",
+	.config				= "program",
+	.binaryFolder		= "bin",
+	.binaryName			= "test_resource_pools_program",
+} );
+
+TEMPER_INVOKE_PARAMETRIC_TEST( TestBuild, {
+	.rootDir			= "test_precompiled_header",
+	.buildSourceFile	= "build.cpp",
+	.binaryFolder		= "bin",
+	.binaryName			= "test_precompiled_header_program",
+} );
+
+TEMPER_INVOKE_PARAMETRIC_TEST( TestBuild, {
+	.rootDir			= "test_batch_small_source_files",
+	.buildSourceFile	= "build.cpp",
+	.binaryFolder		= "bin",
+	.binaryName			= "test_batch_small_source_files_program",
+} );
+
+// MSVC cant do modules with Builder yet
+TEMPER_INVOKE_PARAMETRIC_TEST( TestBuild, {
+	.rootDir			= "test_cpp_modules",
+	.buildSourceFile	= "build.cpp",
+	.binaryFolder		= "bin",
+	.binaryName			= "test_cpp_modules_program",
+	.compilers			= COMPILER_DEFAULT | COMPILER_CLANG | COMPILER_GCC,
+} );
+
 TEMPER_INVOKE_PARAMETRIC_TEST( TestBuild, {
 	.rootDir			= "test_dynamic_lib",
 	.buildSourceFile	= "build.cpp",
@@ -471,6 +2351,115 @@ TEMPER_INVOKE_PARAMETRIC_TEST( TestBuild, {
 	.binaryName			= "test_compilation_database_program",
 } );
 
+// the build source file for TestBuild_ConfigChange
+// 'answer' goes in a define that only the program config has
+static const char *GetConfigChangeBuildSourceFile( const u32 answer ) {
+	return TempPrintf(
+		"#include <builder.h>\n"
+		"\n"
+		"BUILDER_CALLBACK void SetBuilderOptions( BuilderOptions *options, CommandLineArgs *args ) {\n"
+		"\tBuildConfig library = {\n"
+		"\t\t.sourceFiles\t= { \"lib.cpp\" },\n"
+		"\t\t.binaryName\t\t= \"library\",\n"
+		"\t\t.binaryFolder\t= \"bin\",\n"
+		"\t\t.name\t\t\t= \"library\",\n"
+		"\t\t.binaryType\t\t= BINARY_TYPE_STATIC_LIBRARY,\n"
+		"\t};\n"
+		"\n"
+		"\tBuildConfig program = {\n"
+		"\t\t.dependsOn\t\t\t= { library },\n"
+		"\t\t.sourceFiles\t\t= { \"program.cpp\" },\n"
+		"\t\t.defines\t\t\t= { \"ANSWER=%u\" },\n"
+		"\t\t.additionalLibPaths\t= { \"bin\" },\n"
+		"#ifdef _WIN32\n"
+		"\t\t.additionalLibs\t\t= { \"library\" },\n"
+		"#else\n"
+		"\t\t.additionalLibs\t\t= { \":library.a\" },\n"
+		"#endif\n"
+		"\t\t.binaryName\t\t\t= \"program\",\n"
+		"\t\t.binaryFolder\t\t= \"bin\",\n"
+		"\t\t.name\t\t\t\t= \"program\",\n"
+		"\t};\n"
+		"\n"
+		"\tAddBuildConfig( options, &program );\n"
+		"}\n",
+		answer
+	);
+}
+
+// changing a config must only recompile the source files in that config, and not force a rebuild of everything else like it used to
+TEST( TestBuild_ConfigChange, TEMPER_FLAG_SHOULD_RUN ) {
+	const char *folder = "test_config_change";
+
+	TEMPER_CHECK_TRUE( FS_CreateFolderIfItDoesntExist( folder ) );
+	defer { NukeFolder( folder, true, false ); };
+
+	linearAllocator_t *testScratch = Mem_CreateAllocator( MEM_KILOBYTES( 64 ) );
+	defer { Mem_DestroyAllocator( testScratch ); };
+
+	string_t oldCWD = Path_GetCwd( testScratch );
+
+	TEMPER_CHECK_TRUE_M( Path_SetCwd( folder ), "Failed to cd into the test folder \"%s\": %s.\n", folder, strerror( errno ) );
+	defer { TEMPER_CHECK_TRUE_M( Path_SetCwd( String_Cstr( &oldCWD ) ), "Failed to cd back out of the test folder: %s.\n", strerror( errno ) ); };
+
+	// --verbose sticks around after BuilderMain() returns
+	defer { g_verbose = false; };
+
+	const char *libSource = "int Lib() { return 1; }\n";
+	const char *programSource = "int Lib();\nint main() { return Lib() + ANSWER; }\n";
+
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( "lib.cpp", libSource, strlen( libSource ) ) );
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( "program.cpp", programSource, strlen( programSource ) ) );
+
+	const char *buildSourceFile = GetConfigChangeBuildSourceFile( 41 );
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( "build.cpp", buildSourceFile, strlen( buildSourceFile ) ) );
+
+	// BuilderMain() uses temp storage too, so these cant live there
+	const char *libObject = String_Printf( testScratch, "bin%clib.o", PATH_SEPARATOR ).data;
+	const char *programObject = String_Printf( testScratch, "bin%cprogram.o", PATH_SEPARATOR ).data;
+	const char *programBinary = String_Printf( testScratch, ".%cbin%cprogram%s", PATH_SEPARATOR, PATH_SEPARATOR, GetFileExtensionFromBinaryType( BINARY_TYPE_EXE ) ).data;
+
+	// the compile cache would hand the old object files back instead of compiling them
+	const char *buildArgs[] = { "build.cpp", "--config=program", "--no-cache" };
+	const char *verboseBuildArgs[] = { "build.cpp", "--config=program", "--no-cache", ARG_VERBOSE_SHORT };
+
+	array_t<const char *> runArgs;
+	runArgs.Init( testScratch );
+	runArgs.Add( programBinary );
+
+	TEMPER_CHECK_TRUE( BuilderMain( 0, TruncCast( int, COUNT_OF( buildArgs ) ), buildArgs ) == 0 );
+	TEMPER_CHECK_TRUE( RunProc( &runArgs, NULL ) == 42 );
+
+	u64 libObjectTime = 0;
+	u64 programObjectTime = 0;
+	TEMPER_CHECK_TRUE( FS_GetFileLastWriteTime( libObject, &libObjectTime ) );
+	TEMPER_CHECK_TRUE( FS_GetFileLastWriteTime( programObject, &programObjectTime ) );
+
+	// only the program config has the define, so only its source files compile again
+	buildSourceFile = GetConfigChangeBuildSourceFile( 42 );
+	TEMPER_CHECK_TRUE( FS_WriteEntireFile( "build.cpp", buildSourceFile, strlen( buildSourceFile ) ) );
+
+	TEMPER_CHECK_TRUE( BuilderMain( 0, TruncCast( int, COUNT_OF( buildArgs ) ), buildArgs ) == 0 );
+	TEMPER_CHECK_TRUE( RunProc( &runArgs, NULL ) == 43 );
+
+	u64 newTime = 0;
+	TEMPER_CHECK_TRUE( FS_GetFileLastWriteTime( libObject, &newTime ) );
+	TEMPER_CHECK_TRUE_M( newTime == libObjectTime, "\"%s\" compiled again, but nothing about the library config changed.\n", libObject );
+
+	TEMPER_CHECK_TRUE( FS_GetFileLastWriteTime( programObject, &newTime ) );
+	TEMPER_CHECK_TRUE_M( newTime != programObjectTime, "\"%s\" didn't compile again, even though the program config's defines changed.\n", programObject );
+	programObjectTime = newTime;
+
+	// verbose logging passes -v to the compiler, but that doesnt change what it outputs so nothing needs to compile again
+	TEMPER_CHECK_TRUE( BuilderMain( 0, TruncCast( int, COUNT_OF( verboseBuildArgs ) ), verboseBuildArgs ) == 0 );
+
+	TEMPER_CHECK_TRUE( FS_GetFileLastWriteTime( libObject, &newTime ) );
+	TEMPER_CHECK_TRUE_M( newTime == libObjectTime, "\"%s\" compiled again just because of %s.\n", libObject, ARG_VERBOSE_SHORT );
+
+	TEMPER_CHECK_TRUE( FS_GetFileLastWriteTime( programObject, &newTime ) );
+	TEMPER_CHECK_TRUE_M( newTime == programObjectTime, "\"%s\" compiled again just because of %s.\n", programObject, ARG_VERBOSE_SHORT );
+}
+
 TEST( GenerateVisualStudioSolution, TEMPER_FLAG_SHOULD_RUN ) {
 	s32 exitCode = -1;
 
@@ -668,20 +2657,21 @@ TEST( GenerateVSCodeJSONFiles, TEMPER_FLAG_SHOULD_RUN ) {
 		generatedFiles.fileExtensionsToDelete.Add( ".d" );
 		generatedFiles.fileExtensionsToDelete.Add( ".o" );
 		generatedFiles.fileExtensionsToDelete.Add( ".include_dependencies" );
+		generatedFiles.fileExtensionsToDelete.Add( ".file_hashes" );
 		generatedFiles.fileExtensionsToDelete.Add( ".lib" );
 		generatedFiles.fileExtensionsToDelete.Add( ".exp" );
 		generatedFiles.fileExtensionsToDelete.Add( ".pdb" );
 		generatedFiles.fileExtensionsToDelete.Add( ".ilk" );
 		generatedFiles.fileExtensionsToDelete.Add( ".json" );
 
-		TEMPER_CHECK_TRUE( FS_GetAllFilesInFolder( dotBuilderFolder, FILE_VISIT_RECURSIVE | FILE_VISIT_FILES | FILE_VISIT_FOLDERS, GetAllGeneratedFiles, &generatedFiles ) );
 		TEMPER_CHECK_TRUE( FS_GetAllFilesInFolder( vsCodeFolder, FILE_VISIT_RECURSIVE | FILE_VISIT_FILES | FILE_VISIT_FOLDERS, GetAllGeneratedFiles, &generatedFiles ) );
 
 		For ( u32, fileIndex, 0, generatedFiles.files.count ) {
 			TEMPER_CHECK_TRUE_M( FS_DeleteFile( generatedFiles.files[fileIndex] ), "Failed to delete \"%s\".\n", generatedFiles.files[fileIndex] );
 		}
 
-		TEMPER_CHECK_TRUE_M( FS_DeleteFolder( dotBuilderFolder ), "Failed to delete \"%s\".\n", dotBuilderFolder );
+		// the compile cache and the build history go in .builder too, so theres more in there than just what this test knows about
+		TEMPER_CHECK_TRUE_M( NukeFolder( dotBuilderFolder, true, false ), "Failed to delete \"%s\".\n", dotBuilderFolder );
 		TEMPER_CHECK_TRUE_M( FS_DeleteFolder( vsCodeFolder ), "Failed to delete .vscode folder.\n" );
 	}
 }
@@ -746,30 +2736,8 @@ TEST( GenerateZedJSONFiles, TEMPER_FLAG_SHOULD_RUN ) {
 
 	// cleanup
 	{
-		// delete all files in .builder before removing the folder
-		// (rmdir requires an empty directory)
-		{
-			buildTestGeneratedFiles_t generatedFiles = {};
-			generatedFiles.fileExtensionsToDelete.Init( testScratch );
-			generatedFiles.files.Init( testScratch );
-			generatedFiles.folders.Init( testScratch );
-			generatedFiles.fileExtensionsToDelete.Add( GetFileExtensionFromBinaryType( BINARY_TYPE_DYNAMIC_LIBRARY ) );
-			generatedFiles.fileExtensionsToDelete.Add( ".d" );
-			generatedFiles.fileExtensionsToDelete.Add( ".o" );
-			generatedFiles.fileExtensionsToDelete.Add( ".include_dependencies" );
-			generatedFiles.fileExtensionsToDelete.Add( ".lib" );
-			generatedFiles.fileExtensionsToDelete.Add( ".exp" );
-			generatedFiles.fileExtensionsToDelete.Add( ".pdb" );
-			generatedFiles.fileExtensionsToDelete.Add( ".ilk" );
-
-			TEMPER_CHECK_TRUE( FS_GetAllFilesInFolder( dotBuilderFolder, FILE_VISIT_RECURSIVE | FILE_VISIT_FILES | FILE_VISIT_FOLDERS, GetAllGeneratedFiles, &generatedFiles ) );
-
-			For ( u32, fileIndex, 0, generatedFiles.files.count ) {
-				TEMPER_CHECK_TRUE_M( FS_DeleteFile( generatedFiles.files[fileIndex] ), "Failed to delete \"%s\".\n", generatedFiles.files[fileIndex] );
-			}
-
-			TEMPER_CHECK_TRUE_M( FS_DeleteFolder( dotBuilderFolder ), "Failed to delete \"%s\".\n", dotBuilderFolder );
-		}
+		// the compile cache and the build history go in .builder too, so theres more in there than just what this test knows about
+		TEMPER_CHECK_TRUE_M( NukeFolder( dotBuilderFolder, true, false ), "Failed to delete \"%s\".\n", dotBuilderFolder );
 
 		// delete .zed contents then the folder
 		if ( FS_FileExists( tasksJSONPath ) ) {